@@ -0,0 +1,786 @@
+/**
+ * @file host_perf.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホストPCで計算カーネルを計測し、ベースラインと比べる(性能の回帰チェック)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "app_main.h"
+#include "dbg_args.h"
+#include "fft.h"
+#include "pi_chud.h"
+#include "mem_ops.h"
+#include "crc.h"
+#include "gpio_bench.h"
+#include "mem_pool.h"
+#include "mem_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// 【使い方】
+// host_perf                           ... 計測してベースラインと比べる(遅くなっても表示だけ)
+// host_perf --strict                  ... 遅くなったら終了コード1(比べるマシンで作ったベースラインで使う)
+// host_perf --update                  ... 計測結果をベースラインに書く
+// host_perf --baseline FILE           ... ベースラインのファイル(デフォルトはperf_baseline.txt)
+// host_perf --tolerance PCT           ... 許容する遅延(%、デフォルト25)
+// host_perf --filter NAME             ... 名前にNAMEを含むケースだけ
+// ※時間はホストの速さで変わるので、基準ループとの比で比べる(ベースラインも比を持つ)
+
+#define PERF_SAMPLE_NUM         11          // 1ケースのサンプル数(最小値を採る)
+#define PERF_SAMPLE_MIN_NS      5000000     // 1サンプルの最短時間(回数をこれに合わせて増やす)
+#define PERF_TOLERANCE_PCT      25.0
+#define PERF_RETRY_NUM          2           // 遅かったケース(--updateなら全ケース)を測り直す周回数
+#define PERF_BASELINE_FILE      "perf_baseline.txt"
+#define PERF_NAME_MAX           32
+#define PERF_CASE_MAX           64
+
+#define DUMP_SIZE               256
+#define FFT_LOG2N               10
+#define FFT_N                   (1UL << FFT_LOG2N)
+#define FFT_TONE_BIN            37
+#define PI_CHUD_DIGITS          1000
+#define MEM_OPS_SIZE            (64 * 1024)
+#define GPIO_BENCH_MASK         0x3CUL      // GPIO2-5(side-setは4bit)
+#define GPIO_BENCH_SYS_HZ       150000000UL
+#define ALLOC_NUM               48          // 1回で確保する数(プールのS/M/Lがちょうど埋まる)
+#define ALLOC_ARENA_SIZE        (16 * 1024)
+
+// 計測ケース
+typedef struct {
+    const char *p_name;
+    void (*run)(void);          // 1回分
+    bool (*check)(void);        // 結果の確認(runの後に1回、NULLなら確認しない)
+    bool is_quiet;              // 計測中はstdoutを/dev/nullに向ける
+} perf_case_t;
+
+// ベースラインの1行
+typedef struct {
+    char name[PERF_NAME_MAX];
+    double ratio;
+} perf_base_t;
+
+// 計測結果
+typedef struct {
+    const perf_case_t *p_case;
+    const perf_base_t *p_base;  // ベースラインに無ければNULL
+    double ns;
+    double ratio;
+} perf_result_t;
+
+static volatile uint32_t s_sink;
+
+// dbg_args_split
+static const char s_args_line[] = "reg 32 w #40014000 #12345678 extra words";
+static char s_args_buf[sizeof(s_args_line)];
+static dbg_cmd_args_t s_args;
+
+// sha256_padding
+static uint8_t s_sha_src[1000];
+static uint8_t s_sha_dst[sizeof(s_sha_src) + 72];
+static size_t s_sha_len;
+
+// show_mem_dump(アドレスが32bitなので下位4GBに置く)
+static uint8_t *s_p_dump;
+
+// calculate_pi_gauss_legendre
+static volatile double s_pi_gl;
+
+// FFT
+static fft_cpx_f32_t s_fft_f32_in[FFT_N];
+static fft_cpx_f32_t s_fft_f32[FFT_N];
+static fft_cpx_q15_t s_fft_q15_in[FFT_N];
+static fft_cpx_q15_t s_fft_q15[FFT_N];
+
+// Chudnovsky
+static char s_pi_digits[PI_CHUD_DIGITS + 3];
+static bool s_is_pi_chud_ok;
+
+// mem_ops(パターンは末尾にだけ置く、比較は末尾の1バイトだけ違う)
+static uint32_t s_mem_a[MEM_OPS_SIZE / 4];
+static uint32_t s_mem_b[MEM_OPS_SIZE / 4];
+static const uint8_t s_mem_pat[] = "rp2350_magic";
+static mem_find_t s_find_bmh;
+static mem_find_t s_find_word;
+static uint32_t s_mem_hit;
+static mem_cmp_result_t s_mem_cmp;
+
+// CRC(mem_opsの領域を1バイトずらして計算、期待値はビット演算で求める)
+static uint32_t s_crc[CRC_TYPE_NUM];
+static uint32_t s_crc_expect[CRC_TYPE_NUM];
+static gpio_bench_prog_t s_gpio_prog;
+
+// アロケータの比較(プール、アリーナ、libcのmalloc)
+static size_t s_alloc_size[ALLOC_NUM];
+static void *s_p_alloc[ALLOC_NUM];
+static uint32_t s_alloc_fails;
+static uint64_t s_arena_buf[ALLOC_ARENA_SIZE / 8];
+static mem_arena_t s_arena;
+
+// スレッドのCPU時間(他のプロセスに取られた時間を数えない)
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// 基準ループ(比の分母、整数演算だけでメモリもほぼ触らない)
+static void ref_loop(void)
+{
+    uint32_t x = s_sink | 1;
+
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        x = x * 1664525u + 1013904223u;
+        x ^= x >> 13;
+    }
+    s_sink = x;
+}
+
+static void run_args_split(void)
+{
+    memcpy(s_args_buf, s_args_line, sizeof(s_args_line));
+    dbg_args_split(s_args_buf, &s_args);
+}
+
+static bool check_args_split(void)
+{
+    return s_args.argc == 7 && strcmp(s_args.p_argv[3], "#40014000") == 0;
+}
+
+static void run_sha_pad_55(void)
+{
+    sha256_padding(s_sha_src, 55, s_sha_dst, &s_sha_len);
+}
+
+static bool check_sha_pad_55(void)
+{
+    return s_sha_len == 64 && s_sha_dst[55] == 0x80 && s_sha_dst[63] == (55 * 8) % 256;
+}
+
+static void run_sha_pad_1000(void)
+{
+    sha256_padding(s_sha_src, sizeof(s_sha_src), s_sha_dst, &s_sha_len);
+}
+
+static bool check_sha_pad_1000(void)
+{
+    return s_sha_len == 1024 && s_sha_dst[1000] == 0x80 && s_sha_dst[1022] == 0x1F && s_sha_dst[1023] == 0x40;
+}
+
+static void run_mem_dump(void)
+{
+    show_mem_dump((uint32_t)(uintptr_t)s_p_dump, DUMP_SIZE);
+}
+
+static void run_pi_gl(void)
+{
+    s_pi_gl = calculate_pi_gauss_legendre(3);
+}
+
+static bool check_pi_gl(void)
+{
+    return fabs(s_pi_gl - M_PI) < 1e-12;
+}
+
+static void run_fft_f32(void)
+{
+    memcpy(s_fft_f32, s_fft_f32_in, sizeof(s_fft_f32));
+    fft_f32(s_fft_f32, FFT_LOG2N, FFT_RADIX_4);
+}
+
+static bool check_fft_f32(void)
+{
+    uint32_t peak = 0;
+    float peak_mag = 0.0f;
+
+    for (uint32_t i = 0; i < FFT_N / 2; i++)
+    {
+        float mag = s_fft_f32[i].re * s_fft_f32[i].re + s_fft_f32[i].im * s_fft_f32[i].im;
+        if (mag > peak_mag) {
+            peak_mag = mag;
+            peak = i;
+        }
+    }
+    return peak == FFT_TONE_BIN;
+}
+
+static void run_fft_q15(void)
+{
+    memcpy(s_fft_q15, s_fft_q15_in, sizeof(s_fft_q15));
+    fft_q15(s_fft_q15, FFT_LOG2N, FFT_RADIX_4);
+}
+
+static bool check_fft_q15(void)
+{
+    uint32_t peak = 0;
+    int32_t peak_mag = 0;
+
+    for (uint32_t i = 0; i < FFT_N / 2; i++)
+    {
+        int32_t mag = s_fft_q15[i].re * s_fft_q15[i].re + s_fft_q15[i].im * s_fft_q15[i].im;
+        if (mag > peak_mag) {
+            peak_mag = mag;
+            peak = i;
+        }
+    }
+    return peak == FFT_TONE_BIN;
+}
+
+static void run_pi_chud(void)
+{
+    pi_chud_pqt_t pqt;
+
+    pi_chud_pqt_init(&pqt);
+    s_is_pi_chud_ok = pi_chud_bs(0, pi_chud_terms(PI_CHUD_DIGITS), &pqt)
+                      && pi_chud_finish(&pqt, PI_CHUD_DIGITS, s_pi_digits);
+    pi_chud_pqt_free(&pqt);
+}
+
+static bool check_pi_chud(void)
+{
+    return s_is_pi_chud_ok && pi_chud_verify(s_pi_digits, PI_CHUD_DIGITS) == PI_CHUD_DIGITS;
+}
+
+static void run_mem_find_bmh(void)
+{
+    s_mem_hit = mem_find_next(&s_find_bmh, (const uint8_t *)s_mem_a, MEM_OPS_SIZE, 0);
+}
+
+static bool check_mem_find_bmh(void)
+{
+    return s_mem_hit == MEM_OPS_SIZE - 16;
+}
+
+static void run_mem_find_word(void)
+{
+    s_mem_hit = mem_find_next(&s_find_word, (const uint8_t *)s_mem_a, MEM_OPS_SIZE, 0);
+}
+
+static void run_mem_cmp(void)
+{
+    mem_cmp((const uint8_t *)s_mem_a, (const uint8_t *)s_mem_b, MEM_OPS_SIZE, &s_mem_cmp);
+}
+
+static bool check_mem_cmp(void)
+{
+    return s_mem_cmp.first == MEM_OPS_SIZE - 1 && s_mem_cmp.count == 1;
+}
+
+static void run_mem_fill32(void)
+{
+    mem_fill32((uint8_t *)s_mem_b + 1, MEM_OPS_SIZE - 2, 0xA5A5A5A5u);
+}
+
+static void run_crc32(void)
+{
+    s_crc[CRC_TYPE_32] = crc_sw_update(CRC_TYPE_32, crc_start(CRC_TYPE_32), (const uint8_t *)s_mem_a + 1, MEM_OPS_SIZE - 1);
+}
+
+static bool check_crc32(void)
+{
+    return s_crc[CRC_TYPE_32] == s_crc_expect[CRC_TYPE_32];
+}
+
+static void run_crc16(void)
+{
+    s_crc[CRC_TYPE_16] = crc_sw_update(CRC_TYPE_16, crc_start(CRC_TYPE_16), (const uint8_t *)s_mem_a + 1, MEM_OPS_SIZE - 1);
+}
+
+static bool check_crc16(void)
+{
+    return s_crc[CRC_TYPE_16] == s_crc_expect[CRC_TYPE_16];
+}
+
+// gpio benchの表(実機の計測結果の代わりに決まった値を入れる)
+static void run_gpio_bench_rpt(void)
+{
+    gpio_bench_result_t result = {true, NULL, GPIO_BENCH_WRITES_DEF, 0};
+
+    gpio_bench_build_pio(GPIO_BENCH_MASK, &s_gpio_prog);
+    gpio_bench_report_header(GPIO_BENCH_MASK, GPIO_BENCH_WRITES_DEF, GPIO_BENCH_SYS_HZ);
+    for (uint32_t m = 0; m < GPIO_BENCH_METHOD_NUM; m++)
+    {
+        result.cycles = GPIO_BENCH_WRITES_DEF * (m + 1) + 7;
+        gpio_bench_report_row((gpio_bench_method_t)m, &result, GPIO_BENCH_SYS_HZ);
+    }
+}
+
+// pioasmの「nop side 0b1111」(.side_set 4)と同じ命令か
+static bool check_gpio_bench_rpt(void)
+{
+    return s_gpio_prog.length == 5 && s_gpio_prog.side_base == 2 && s_gpio_prog.insn[2] == 0xBE42;
+}
+
+// 確保して先頭に書き、逆順に解放(pool/arena/mallocで同じ並び)
+static void alloc_touch(uint32_t i, void *p)
+{
+    s_p_alloc[i] = p;
+    if (p == NULL) {
+        s_alloc_fails++;
+    } else {
+        *(volatile uint8_t *)p = (uint8_t)i;
+    }
+}
+
+static void run_pool_alloc(void)
+{
+    for (uint32_t i = 0; i < ALLOC_NUM; i++)
+    {
+        alloc_touch(i, mem_pool_alloc(s_alloc_size[i]));
+    }
+    for (uint32_t i = ALLOC_NUM; i > 0; i--)
+    {
+        mem_pool_free(s_p_alloc[i - 1]);
+    }
+}
+
+static void run_arena_alloc(void)
+{
+    size_t mark = mem_arena_mark(&s_arena);
+
+    for (uint32_t i = 0; i < ALLOC_NUM; i++)
+    {
+        alloc_touch(i, mem_arena_alloc(&s_arena, s_alloc_size[i]));
+    }
+    mem_arena_release(&s_arena, mark);
+}
+
+static void run_malloc_free(void)
+{
+    for (uint32_t i = 0; i < ALLOC_NUM; i++)
+    {
+        alloc_touch(i, malloc(s_alloc_size[i]));
+    }
+    for (uint32_t i = ALLOC_NUM; i > 0; i--)
+    {
+        free(s_p_alloc[i - 1]);
+    }
+}
+
+static bool check_alloc(void)
+{
+    return s_alloc_fails == 0;
+}
+
+static const perf_case_t s_case_tbl[] = {
+    {"args_split",      run_args_split,     check_args_split,   false},
+    {"sha256_pad_55",   run_sha_pad_55,     check_sha_pad_55,   false},
+    {"sha256_pad_1000", run_sha_pad_1000,   check_sha_pad_1000, false},
+    {"mem_dump_256",    run_mem_dump,       NULL,               true},
+    {"pi_gl_3",         run_pi_gl,          check_pi_gl,        false},
+    {"int_add",         int_add_test,       NULL,               false},
+    {"int_sub",         int_sub_test,       NULL,               false},
+    {"int_mul",         int_mul_test,       NULL,               false},
+    {"int_div",         int_div_test,       NULL,               false},
+    {"float_add",       float_add_test,     NULL,               false},
+    {"float_sub",       float_sub_test,     NULL,               false},
+    {"float_mul",       float_mul_test,     NULL,               false},
+    {"float_div",       float_div_test,     NULL,               false},
+    {"double_add",      double_add_test,    NULL,               false},
+    {"double_sub",      double_sub_test,    NULL,               false},
+    {"double_mul",      double_mul_test,    NULL,               false},
+    {"double_div",      double_div_test,    NULL,               false},
+    {"trig",            trig_functions_test, NULL,              false},
+    {"atan2",           atan2_test,         NULL,               false},
+    {"tan355",          tan_355_226_test,   NULL,               false},
+    {"isqrt",           inverse_sqrt_test,  NULL,               false},
+    {"fft_f32_1024",    run_fft_f32,        check_fft_f32,      false},
+    {"fft_q15_1024",    run_fft_q15,        check_fft_q15,      false},
+    {"pi_chud_1000",    run_pi_chud,        check_pi_chud,      false},
+    {"find_bmh_64k",    run_mem_find_bmh,   check_mem_find_bmh, false},
+    {"find_word_64k",   run_mem_find_word,  check_mem_find_bmh, false},
+    {"cmp_64k",         run_mem_cmp,        check_mem_cmp,      false},
+    {"fill32_64k",      run_mem_fill32,     NULL,               false},
+    {"crc32_64k",       run_crc32,          check_crc32,        false},
+    {"crc16_64k",       run_crc16,          check_crc16,        false},
+    {"gpio_bench_rpt",  run_gpio_bench_rpt, check_gpio_bench_rpt, true},
+    {"pool_alloc_48",   run_pool_alloc,     check_alloc,        false},
+    {"arena_alloc_48",  run_arena_alloc,    check_alloc,        false},
+    {"malloc_free_48",  run_malloc_free,    check_alloc,        false},
+};
+#define PERF_CASE_NUM   (sizeof(s_case_tbl) / sizeof(s_case_tbl[0]))
+
+static void case_setup(void)
+{
+    for (uint32_t i = 0; i < sizeof(s_sha_src); i++)
+    {
+        s_sha_src[i] = (uint8_t)(i * 7);
+    }
+
+    // 検索の対象は0～63の繰り返し(パターンの文字はほぼ出てこない)、比較は末尾の1バイトだけ違う
+    for (uint32_t i = 0; i < MEM_OPS_SIZE; i++)
+    {
+        ((uint8_t *)s_mem_a)[i] = (uint8_t)(i & 0x3F);
+    }
+    memcpy((uint8_t *)s_mem_a + MEM_OPS_SIZE - 16, s_mem_pat, sizeof(s_mem_pat) - 1);
+    memcpy(s_mem_b, s_mem_a, MEM_OPS_SIZE);
+    ((uint8_t *)s_mem_b)[MEM_OPS_SIZE - 1] ^= 0xFF;
+    mem_find_init(&s_find_bmh, s_mem_pat, sizeof(s_mem_pat) - 1, false);
+    mem_find_init(&s_find_word, s_mem_pat, sizeof(s_mem_pat) - 1, true);
+
+    // 32byte:128byte:512byte = 3:2:1(プールのブロック数の比)
+    for (uint32_t i = 0; i < ALLOC_NUM; i++)
+    {
+        uint32_t k = i % 6;
+        s_alloc_size[i] = (k < 3) ? 24 : ((k < 5) ? 100 : 400);
+    }
+    mem_pool_sys_init(NULL);
+    mem_arena_init(&s_arena, s_arena_buf, sizeof(s_arena_buf));
+
+    crc_init();
+    for (uint32_t t = 0; t < CRC_TYPE_NUM; t++)
+    {
+        s_crc_expect[t] = crc_bitwise_update((crc_type_t)t, crc_start((crc_type_t)t),
+                                             (const uint8_t *)s_mem_a + 1, MEM_OPS_SIZE - 1);
+    }
+
+    fft_init();
+    for (uint32_t i = 0; i < FFT_N; i++)
+    {
+        double ang = 2.0 * M_PI * FFT_TONE_BIN * i / FFT_N;
+        s_fft_f32_in[i].re = (float)(0.5 * cos(ang));
+        s_fft_f32_in[i].im = 0.0f;
+        s_fft_q15_in[i].re = (int16_t)lround(0.5 * 32767.0 * cos(ang));
+        s_fft_q15_in[i].im = 0;
+    }
+
+#ifdef MAP_32BIT
+    s_p_dump = mmap(NULL, DUMP_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+#else
+    s_p_dump = mmap((void *)0x10000000, DUMP_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#endif
+    if (s_p_dump == MAP_FAILED || (uintptr_t)s_p_dump > UINT32_MAX) {
+        s_p_dump = NULL;
+        return;
+    }
+    for (uint32_t i = 0; i < DUMP_SIZE; i++)
+    {
+        s_p_dump[i] = (uint8_t)i;
+    }
+}
+
+// stdoutを/dev/nullに向ける(戻すときは返り値を渡す)
+static int quiet_begin(void)
+{
+    int null_fd = open("/dev/null", O_WRONLY);
+    int saved_fd;
+
+    fflush(stdout);
+    saved_fd = dup(STDOUT_FILENO);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+
+    return saved_fd;
+}
+
+static void quiet_end(int saved_fd)
+{
+    fflush(stdout);
+    dup2(saved_fd, STDOUT_FILENO);
+    close(saved_fd);
+}
+
+// 1サンプルがPERF_SAMPLE_MIN_NS以上になる回数(ウォームアップを兼ねる)
+static uint64_t calib_reps(void (*run)(void))
+{
+    uint64_t reps = 1;
+
+    for (;;)
+    {
+        uint64_t start = now_ns();
+        for (uint64_t i = 0; i < reps; i++)
+        {
+            run();
+        }
+        uint64_t elapsed = now_ns() - start;
+        if (elapsed >= PERF_SAMPLE_MIN_NS) {
+            return reps;
+        }
+        reps = (elapsed == 0) ? reps * 16 : reps * 2;
+    }
+}
+
+// 1サンプル(1回あたりのns)
+static double sample_ns(void (*run)(void), uint64_t reps)
+{
+    uint64_t start = now_ns();
+
+    for (uint64_t i = 0; i < reps; i++)
+    {
+        run();
+    }
+
+    return (double)(now_ns() - start) / (double)reps;
+}
+
+/**
+ * @brief 1ケースを計測する
+ * @note 基準ループとケースを交互にサンプルして、それぞれの最小値の比を採る
+ * @note (同じ時間帯の基準と比べるので、途中でホストのクロックや負荷が変わっても比が崩れにくい)
+ *
+ * @param run 1回分の関数
+ * @param p_ns 1回あたりのns
+ * @return double 基準ループとの比
+ */
+static double measure_ratio(void (*run)(void), double *p_ns)
+{
+    uint64_t ref_reps = calib_reps(ref_loop);
+    uint64_t reps = calib_reps(run);
+    double ref_best = 0.0;
+    double best = 0.0;
+
+    for (int32_t s = 0; s < PERF_SAMPLE_NUM; s++)
+    {
+        double ref_ns = sample_ns(ref_loop, ref_reps);
+        double ns = sample_ns(run, reps);
+        if (s == 0 || ref_ns < ref_best) {
+            ref_best = ref_ns;
+        }
+        if (s == 0 || ns < best) {
+            best = ns;
+        }
+    }
+
+    *p_ns = best;
+    return best / ref_best;
+}
+
+// stdoutの向き先を変えて計測
+static double measure_case(const perf_case_t *p_case, double *p_ns)
+{
+    double ratio;
+
+    if (p_case->is_quiet) {
+        int saved_fd = quiet_begin();
+        ratio = measure_ratio(p_case->run, p_ns);
+        quiet_end(saved_fd);
+    } else {
+        ratio = measure_ratio(p_case->run, p_ns);
+    }
+
+    return ratio;
+}
+
+static int32_t baseline_load(const char *p_path, perf_base_t *p_base, int32_t max)
+{
+    FILE *p_fp = fopen(p_path, "r");
+    char line[128];
+    int32_t num = 0;
+
+    if (p_fp == NULL) {
+        return -1;
+    }
+    while (num < max && fgets(line, sizeof(line), p_fp) != NULL)
+    {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        if (sscanf(line, "%31s %lf", p_base[num].name, &p_base[num].ratio) == 2) {
+            num++;
+        }
+    }
+    fclose(p_fp);
+
+    return num;
+}
+
+static const perf_base_t *baseline_find(const perf_base_t *p_base, int32_t num, const char *p_name)
+{
+    for (int32_t i = 0; i < num; i++)
+    {
+        if (strcmp(p_base[i].name, p_name) == 0) {
+            return &p_base[i];
+        }
+    }
+    return NULL;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: host_perf [--update] [--strict] [--baseline FILE] [--tolerance PCT] [--filter NAME]\n");
+}
+
+// ベースラインより許容範囲を超えて遅いか
+static bool result_is_slow(const perf_result_t *p_result, double tolerance)
+{
+    if (p_result->p_base == NULL) {
+        return false;
+    }
+    return (p_result->ratio / p_result->p_base->ratio - 1.0) * 100.0 > tolerance;
+}
+
+static const perf_result_t *result_find(const perf_result_t *p_result, int32_t num, const char *p_name)
+{
+    for (int32_t i = 0; i < num; i++)
+    {
+        if (strcmp(p_result[i].p_case->p_name, p_name) == 0) {
+            return &p_result[i];
+        }
+    }
+    return NULL;
+}
+
+// ケース表の順に書く(--filterで測らなかったケースは元の値を残す、表に無いケースは消す)
+static bool baseline_write(const char *p_path, const perf_result_t *p_result, int32_t result_num,
+                           const perf_base_t *p_base, int32_t base_num)
+{
+    FILE *p_fp = fopen(p_path, "w");
+
+    if (p_fp == NULL) {
+        return false;
+    }
+    fprintf(p_fp, "# host_perf baseline: case  ns/op / reference loop ns\n");
+    fprintf(p_fp, "# regenerate with: cmake --build <dir> --target update_perf_baseline\n");
+    for (uint32_t i = 0; i < PERF_CASE_NUM; i++)
+    {
+        const char *p_name = s_case_tbl[i].p_name;
+        const perf_result_t *p_res = result_find(p_result, result_num, p_name);
+        const perf_base_t *p_old = baseline_find(p_base, base_num, p_name);
+        if (p_res != NULL) {
+            fprintf(p_fp, "%-16s %.6g\n", p_name, p_res->ratio);
+        } else if (p_old != NULL) {
+            fprintf(p_fp, "%-16s %.6g\n", p_name, p_old->ratio);
+        }
+    }
+    fclose(p_fp);
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *p_path = PERF_BASELINE_FILE;
+    const char *p_filter = NULL;
+    double tolerance = PERF_TOLERANCE_PCT;
+    bool is_update = false;
+    bool is_strict = false;
+    static perf_base_t s_base[PERF_CASE_MAX];
+    static perf_result_t s_result[PERF_CASE_MAX];
+    int32_t base_num;
+    int32_t result_num = 0;
+    int32_t slow_num = 0;
+    int32_t fail_num = 0;
+
+    for (int32_t i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--update") == 0) {
+            is_update = true;
+        } else if (strcmp(argv[i], "--strict") == 0) {
+            is_strict = true;
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            p_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            p_filter = argv[++i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    base_num = baseline_load(p_path, s_base, PERF_CASE_MAX);
+    if (base_num < 0 && !is_update) {
+        fprintf(stderr, "Error: no baseline %s (run with --update first)\n", p_path);
+        return 2;
+    }
+
+    case_setup();
+
+    // 1周目は全ケースを測って結果を確かめる
+    for (uint32_t i = 0; i < PERF_CASE_NUM; i++)
+    {
+        const perf_case_t *p_case = &s_case_tbl[i];
+        perf_result_t *p_result = &s_result[result_num];
+
+        if (p_filter != NULL && strstr(p_case->p_name, p_filter) == NULL) {
+            continue;
+        }
+        if (p_case->run == run_mem_dump && s_p_dump == NULL) {
+            printf("%-16s %12s\n", p_case->p_name, "skip");
+            continue;
+        }
+
+        p_result->p_case = p_case;
+        p_result->ratio = measure_case(p_case, &p_result->ns);
+        if (p_case->check != NULL && !p_case->check()) {
+            printf("%-16s %12s\n", p_case->p_name, "FAIL(result)");
+            fail_num++;
+            continue;
+        }
+        p_result->p_base = (base_num > 0) ? baseline_find(s_base, base_num, p_case->p_name) : NULL;
+        result_num++;
+    }
+    if (fail_num > 0) {
+        printf("Error: %d case(s) returned a wrong result\n", fail_num);
+        return 2;
+    }
+
+    // 2周目からは遅かったケース(--updateなら全ケース)を測り直して速い方を採る
+    // (すぐに測り直すと同じ混雑に当たるので、1周した後にまとめて測り直す)
+    for (int32_t retry = 0; retry < PERF_RETRY_NUM; retry++)
+    {
+        for (int32_t i = 0; i < result_num; i++)
+        {
+            perf_result_t *p_result = &s_result[i];
+            if (!is_update && !result_is_slow(p_result, tolerance)) {
+                continue;
+            }
+            double ns;
+            double ratio = measure_case(p_result->p_case, &ns);
+            if (ratio < p_result->ratio) {
+                p_result->ratio = ratio;
+                p_result->ns = ns;
+            }
+        }
+    }
+
+    printf("%-16s %12s %10s %10s %8s\n", "case", "ns/op", "ratio", "baseline", "delta");
+    for (int32_t i = 0; i < result_num; i++)
+    {
+        const perf_result_t *p_result = &s_result[i];
+        const char *p_name = p_result->p_case->p_name;
+
+        if (p_result->p_base == NULL) {
+            printf("%-16s %12.1f %10.4g %10s %8s\n", p_name, p_result->ns, p_result->ratio, "-", "new");
+            continue;
+        }
+        double delta = (p_result->ratio / p_result->p_base->ratio - 1.0) * 100.0;
+        bool is_slow = !is_update && result_is_slow(p_result, tolerance);
+        printf("%-16s %12.1f %10.4g %10.4g %+7.1f%%%s\n", p_name, p_result->ns, p_result->ratio,
+                p_result->p_base->ratio, delta, is_slow ? "  SLOW" : "");
+        if (is_slow) {
+            slow_num++;
+        }
+    }
+    printf("tolerance %.0f%%\n", tolerance);
+
+    if (is_update) {
+        if (!baseline_write(p_path, s_result, result_num, s_base, (base_num > 0) ? base_num : 0)) {
+            fprintf(stderr, "Error: cannot write %s\n", p_path);
+            return 2;
+        }
+        printf("wrote %d cases to %s\n", result_num, p_path);
+        return 0;
+    }
+
+    if (slow_num > 0) {
+        printf("REGRESSION: %d case(s) slower than baseline by more than %.0f%%\n", slow_num, tolerance);
+        // 時間はホストの混み具合で揺れるので、--strictの時だけ失敗にする(結果の誤りは常に失敗)
+        return is_strict ? 1 : 0;
+    }
+    printf("OK\n");
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file pico_stub.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホストPC用のPico SDKの代用品(host_perfのビルド専用)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pico_stub.h"
+#include <string.h>
+#include <time.h>
+
+// インスタンスはアドレスだけあればよい
+static uint8_t s_inst[6];
+i2c_inst_t *const g_stub_i2c[2] = {(i2c_inst_t *)&s_inst[0], (i2c_inst_t *)&s_inst[1]};
+spi_inst_t *const g_stub_spi[2] = {(spi_inst_t *)&s_inst[2], (spi_inst_t *)&s_inst[3]};
+uart_inst_t *const g_stub_uart[2] = {(uart_inst_t *)&s_inst[4], (uart_inst_t *)&s_inst[5]};
+
+static uint32_t s_rand_state = 0x2350u;
+static uint32_t s_sha256_sink;
+
+uint64_t time_us_64(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+uint32_t get_rand_32(void)
+{
+    s_rand_state ^= s_rand_state << 13;
+    s_rand_state ^= s_rand_state >> 17;
+    s_rand_state ^= s_rand_state << 5;
+    return s_rand_state;
+}
+
+int i2c_write_blocking(i2c_inst_t *p_i2c, uint8_t addr, const uint8_t *p_src, size_t len, bool nostop)
+{
+    (void)p_i2c;
+    (void)addr;
+    (void)p_src;
+    (void)len;
+    (void)nostop;
+    return -1;  // PICO_ERROR_GENERIC(ACKが返らない)
+}
+
+void sha256_set_dma_size(uint size_in_bytes)
+{
+    (void)size_in_bytes;
+}
+
+void sha256_set_bswap(bool swap)
+{
+    (void)swap;
+}
+
+void sha256_start(void)
+{
+}
+
+void sha256_wait_ready_blocking(void)
+{
+}
+
+void sha256_wait_valid_blocking(void)
+{
+}
+
+void *sha256_get_write_addr(void)
+{
+    return &s_sha256_sink;
+}
+
+void sha256_get_result(sha256_result_t *p_out, sha256_endianness_t endianness)
+{
+    (void)endianness;
+    memset(p_out, 0, sizeof(sha256_result_t));
+}
+
+void watchdog_update(void)
+{
+}
+
+// app_main.cのcore_x_main()が呼ぶ(host_perfでは呼ばない)
+void app_core_0_main(void)
+{
+}
+
+void app_core_1_main(void)
+{
+}
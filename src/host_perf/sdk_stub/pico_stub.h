@@ -0,0 +1,72 @@
+/**
+ * @file pico_stub.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホストPC用のPico SDKの代用品(host_perfのビルド専用)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PICO_STUB_H
+#define PICO_STUB_H
+
+// ※pico/stdlib.h、hardware/sha256.h等はCMakeがこのファイルを読むだけのヘッダとして生成する
+// ※ベンチマークするカーネルのビルドに要る型と関数だけ(H/Wを触る関数は何もしないか失敗を返す)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PICO_SDK_VERSION_MAJOR      2
+#define PICO_SDK_VERSION_MINOR      1
+#define PICO_SDK_VERSION_REVISION   1
+
+typedef unsigned int uint;
+
+// ペリフェラルのインスタンス(ポインタを比べるだけ)
+typedef struct i2c_inst i2c_inst_t;
+typedef struct spi_inst spi_inst_t;
+typedef struct uart_inst uart_inst_t;
+extern i2c_inst_t *const g_stub_i2c[2];
+extern spi_inst_t *const g_stub_spi[2];
+extern uart_inst_t *const g_stub_uart[2];
+#define i2c0    (g_stub_i2c[0])
+#define i2c1    (g_stub_i2c[1])
+#define spi0    (g_stub_spi[0])
+#define spi1    (g_stub_spi[1])
+#define uart0   (g_stub_uart[0])
+#define uart1   (g_stub_uart[1])
+
+// 時刻(CLOCK_MONOTONICのus)
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+
+// 乱数(TRNGの代わりにxorshift、再現できるように種は固定)
+uint32_t get_rand_32(void);
+
+// I2C(スレーブはいない)
+int i2c_write_blocking(i2c_inst_t *p_i2c, uint8_t addr, const uint8_t *p_src, size_t len, bool nostop);
+
+// SHA-256アクセラレータ(何もしない)
+typedef enum {
+    SHA256_LITTLE_ENDIAN = 0,
+    SHA256_BIG_ENDIAN
+} sha256_endianness_t;
+
+typedef union {
+    uint32_t words[8];
+    uint8_t bytes[32];
+} sha256_result_t;
+
+void sha256_set_dma_size(uint size_in_bytes);
+void sha256_set_bswap(bool swap);
+void sha256_start(void);
+void sha256_wait_ready_blocking(void);
+void sha256_wait_valid_blocking(void);
+void *sha256_get_write_addr(void);
+void sha256_get_result(sha256_result_t *p_out, sha256_endianness_t endianness);
+
+void watchdog_update(void);
+
+#endif // PICO_STUB_H
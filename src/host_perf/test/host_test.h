@@ -0,0 +1,79 @@
+/**
+ * @file host_test.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホストPC用のユニットテストの共通マクロ(ctestで実行、1テスト = 1ファイル)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 【使い方】
+// HT_CHECK(cond)       ... 偽なら場所を表示して失敗を数える(テストは続ける)
+// HT_EQ(a, b)          ... 整数の一致(違えば両方の値を表示)
+// HT_RUN(func)         ... テスト関数を1つ実行(失敗が増えたらFAILを表示)
+// return HT_RESULT();  ... main()の最後(失敗が無ければ0)
+
+static int32_t s_ht_fail_num;
+static int32_t s_ht_check_num;
+
+#define HT_CHECK(cond) \
+    do { \
+        s_ht_check_num++; \
+        if (!(cond)) { \
+            s_ht_fail_num++; \
+            printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+#define HT_EQ(a, b) \
+    do { \
+        unsigned long long ht_a = (unsigned long long)(a); \
+        unsigned long long ht_b = (unsigned long long)(b); \
+        s_ht_check_num++; \
+        if (ht_a != ht_b) { \
+            s_ht_fail_num++; \
+            printf("  %s:%d: %s == %s failed (0x%llX != 0x%llX)\n", __FILE__, __LINE__, #a, #b, ht_a, ht_b); \
+        } \
+    } while (0)
+
+#define HT_RUN(func) \
+    do { \
+        int32_t ht_before = s_ht_fail_num; \
+        func(); \
+        printf("%-40s %s\n", #func, (s_ht_fail_num == ht_before) ? "ok" : "FAIL"); \
+    } while (0)
+
+#define HT_RESULT() \
+    (printf("%d checks, %d failed\n", s_ht_check_num, s_ht_fail_num), (s_ht_fail_num == 0) ? 0 : 1)
+
+// 再現できる乱数(xorshift32、種は各テストで決める)
+static uint32_t s_ht_rand_state = 0x2350u;
+
+static inline void ht_srand(uint32_t seed)
+{
+    s_ht_rand_state = (seed != 0) ? seed : 0x2350u;
+}
+
+static inline uint32_t ht_rand(void)
+{
+    s_ht_rand_state ^= s_ht_rand_state << 13;
+    s_ht_rand_state ^= s_ht_rand_state >> 17;
+    s_ht_rand_state ^= s_ht_rand_state << 5;
+    return s_ht_rand_state;
+}
+
+// 0～max-1
+static inline uint32_t ht_rand_below(uint32_t max)
+{
+    return (max == 0) ? 0 : ht_rand() % max;
+}
+
+#endif // HOST_TEST_H
@@ -0,0 +1,402 @@
+/**
+ * @file test_clk_reg.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief clk_reg.cのテスト(種類ごとの分周比の計算、登録と上書き、clk_sysを変えた後の再計算)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "clk_reg.h"
+#include <string.h>
+
+#define MHZ(n)          ((uint32_t)(n) * 1000000UL)
+#define REF_HZ          MHZ(12)     // clk_ref(XOSC)
+#define TICK_HZ         1000000     // clk_hw.hのCLK_HW_TICK_HZ
+
+// 【種類ごとの分周比】
+// 期待値はSDKの各xxx_set_baudrate()の式で計算した値
+
+static void test_div_pio(void)
+{
+    clk_div_t div;
+
+    HT_CHECK(clk_div_calc(CLK_USER_PIO, MHZ(150), MHZ(1), &div));
+    HT_EQ(div.div_int, 150);
+    HT_EQ(div.div_frac, 0);
+    HT_EQ(div.actual_hz, MHZ(1));
+
+    // 133MHz / 3MHz = 44.333 → 44 + 85/256
+    HT_CHECK(clk_div_calc(CLK_USER_PIO, MHZ(133), MHZ(3), &div));
+    HT_EQ(div.div_int, 44);
+    HT_EQ(div.div_frac, 85);
+    HT_EQ(div.actual_hz, 3000088);
+
+    // 分周比は1.0～65535 + 255/256
+    HT_CHECK(clk_div_calc(CLK_USER_PIO, MHZ(150), MHZ(150), &div));
+    HT_EQ(div.div_int, 1);
+    HT_CHECK(!clk_div_calc(CLK_USER_PIO, MHZ(48), MHZ(60), &div));
+    HT_CHECK(clk_div_calc(CLK_USER_PIO, MHZ(150), 2289, &div));
+    HT_EQ(div.div_int, 65530);
+    HT_CHECK(!clk_div_calc(CLK_USER_PIO, MHZ(150), 2288, &div));
+    HT_CHECK(!clk_div_calc(CLK_USER_PIO, 0, MHZ(1), &div));
+    HT_CHECK(!clk_div_calc(CLK_USER_PIO, MHZ(150), 0, &div));
+}
+
+static void test_div_uart(void)
+{
+    clk_div_t div;
+
+    // div = 8 * 150MHz / 921600 + 1 = 1303 → IBRD 10、FBRD (1303 & 0x7F) >> 1 = 11
+    HT_CHECK(clk_div_calc(CLK_USER_UART, MHZ(150), 921600, &div));
+    HT_EQ(div.div_int, 10);
+    HT_EQ(div.div_frac, 11);
+    HT_EQ(div.actual_hz, 921658);
+    HT_EQ(clk_div_err_ppm(921600, div.actual_hz), 62);
+
+    HT_CHECK(clk_div_calc(CLK_USER_UART, MHZ(150), 115200, &div));
+    HT_EQ(div.div_int, 81);
+    HT_EQ(div.div_frac, 24);
+    HT_EQ(div.actual_hz, 115207);
+
+    HT_CHECK(clk_div_calc(CLK_USER_UART, MHZ(48), 921600, &div));
+    HT_EQ(div.div_int, 3);
+    HT_EQ(div.div_frac, 16);
+
+    // IBRDは1～65534(SDKは端に丸めるが、ここでは作れないとする)
+    HT_CHECK(clk_div_calc(CLK_USER_UART, MHZ(150), 150, &div));
+    HT_EQ(div.div_int, 62500);
+    HT_CHECK(!clk_div_calc(CLK_USER_UART, MHZ(300), 150, &div));
+    HT_CHECK(!clk_div_calc(CLK_USER_UART, MHZ(1), MHZ(1), &div));
+}
+
+static void test_div_spi(void)
+{
+    clk_div_t div;
+    char buf[32];
+
+    // プリスケーラ2、ポストディバイダは75MHz / (n - 1) > 1MHzになる最大のn
+    HT_CHECK(clk_div_calc(CLK_USER_SPI, MHZ(150), MHZ(1), &div));
+    HT_EQ(div.div_int, 2);
+    HT_EQ(div.div_frac, 75);
+    HT_EQ(div.actual_hz, MHZ(1));
+    clk_div_format(buf, sizeof(buf), CLK_USER_SPI, &div);
+    HT_CHECK(strcmp(buf, "cpsr 2 scr 74") == 0);
+
+    HT_CHECK(clk_div_calc(CLK_USER_SPI, MHZ(150), MHZ(50), &div));
+    HT_EQ(div.div_int, 2);
+    HT_EQ(div.div_frac, 2);
+    HT_EQ(div.actual_hz, 37500000);
+
+    // 150MHz / (254 * 256)より遅いレートは作れない
+    HT_CHECK(clk_div_calc(CLK_USER_SPI, MHZ(150), 2400, &div));
+    HT_EQ(div.div_int, 246);
+    HT_CHECK(!clk_div_calc(CLK_USER_SPI, MHZ(150), 2000, &div));
+}
+
+static void test_div_i2c(void)
+{
+    clk_div_t div;
+    char buf[32];
+
+    // 周期1500 = L 900 : H 600、SDAのホールドは300ns
+    HT_CHECK(clk_div_calc(CLK_USER_I2C, MHZ(150), 100000, &div));
+    HT_EQ(div.div_int, 600);
+    HT_EQ(div.div_frac, 900);
+    HT_EQ(div.spklen, 56);
+    HT_EQ(div.sda_hold, 46);
+    HT_EQ(div.actual_hz, 100000);
+    clk_div_format(buf, sizeof(buf), CLK_USER_I2C, &div);
+    HT_CHECK(strcmp(buf, "hcnt 600 lcnt 900") == 0);
+
+    HT_CHECK(clk_div_calc(CLK_USER_I2C, MHZ(150), 400000, &div));
+    HT_EQ(div.div_int, 150);
+    HT_EQ(div.div_frac, 225);
+    HT_EQ(div.spklen, 14);
+
+    // Fast Mode PlusはSDAのホールドが120ns
+    HT_CHECK(clk_div_calc(CLK_USER_I2C, MHZ(150), MHZ(1), &div));
+    HT_EQ(div.div_int, 60);
+    HT_EQ(div.div_frac, 90);
+    HT_EQ(div.sda_hold, 19);
+
+    // HCNT/LCNTは8～0xFFFF
+    HT_CHECK(!clk_div_calc(CLK_USER_I2C, MHZ(12), MHZ(1), &div));
+    HT_CHECK(!clk_div_calc(CLK_USER_I2C, MHZ(150), 1000, &div));
+}
+
+static void test_div_tick(void)
+{
+    clk_div_t div;
+    char buf[32];
+
+    HT_CHECK(clk_div_calc(CLK_USER_TICK, REF_HZ, TICK_HZ, &div));
+    HT_EQ(div.div_int, 12);
+    HT_EQ(div.actual_hz, TICK_HZ);
+    clk_div_format(buf, sizeof(buf), CLK_USER_TICK, &div);
+    HT_CHECK(strcmp(buf, "cycles 12") == 0);
+
+    // CYCLESは1～511
+    HT_CHECK(!clk_div_calc(CLK_USER_TICK, 500000, TICK_HZ, &div));
+    HT_CHECK(clk_div_calc(CLK_USER_TICK, 511000000UL, TICK_HZ, &div));
+    HT_CHECK(!clk_div_calc(CLK_USER_TICK, REF_HZ, 1000, &div));
+    HT_CHECK(!clk_div_calc(CLK_USER_TYPE_NUM, REF_HZ, TICK_HZ, &div));
+}
+
+static void test_names(void)
+{
+    char buf[32];
+    clk_div_t div = {.div_int = 150, .div_frac = 7};
+
+    HT_EQ(clk_user_src(CLK_USER_PIO), CLK_SRC_SYS);
+    HT_EQ(clk_user_src(CLK_USER_UART), CLK_SRC_PERI);
+    HT_EQ(clk_user_src(CLK_USER_SPI), CLK_SRC_PERI);
+    HT_EQ(clk_user_src(CLK_USER_I2C), CLK_SRC_SYS);
+    HT_EQ(clk_user_src(CLK_USER_TICK), CLK_SRC_REF);
+    HT_CHECK(strcmp(clk_user_type_name(CLK_USER_TICK), "tick") == 0);
+    HT_CHECK(strcmp(clk_user_type_name(CLK_USER_TYPE_NUM), "?") == 0);
+    HT_CHECK(strcmp(clk_src_name(CLK_SRC_PERI), "peri") == 0);
+    HT_CHECK(strcmp(clk_src_name(CLK_SRC_NUM), "?") == 0);
+
+    clk_div_format(buf, sizeof(buf), CLK_USER_PIO, &div);
+    HT_CHECK(strcmp(buf, "div 150+7/256") == 0);
+    clk_div_format(buf, sizeof(buf), CLK_USER_UART, &div);
+    HT_CHECK(strcmp(buf, "ibrd 150 fbrd 7") == 0);
+
+    HT_EQ(clk_div_err_ppm(MHZ(1), 999000), -1000);
+    HT_EQ(clk_div_err_ppm(115200, 115207), 60);
+    HT_EQ(clk_div_err_ppm(0, 1), 0);
+}
+
+// 【コア電圧とフラッシュのタイミング】
+static void test_vreg_qmi(void)
+{
+    const clk_qmi_t boot = {.clkdiv = 3, .rxdelay = 2};
+    const clk_qmi_t boot_slow = {.clkdiv = 200, .rxdelay = 5};
+    clk_qmi_t qmi;
+
+    HT_EQ(clk_vreg_mv(MHZ(CLK_SYS_MHZ_MIN)), 1100);
+    HT_EQ(clk_vreg_mv(MHZ(150)), 1100);
+    HT_EQ(clk_vreg_mv(MHZ(150) + 1), 1150);
+    HT_EQ(clk_vreg_mv(MHZ(200)), 1150);
+    HT_EQ(clk_vreg_mv(MHZ(250)), 1200);
+    HT_EQ(clk_vreg_mv(MHZ(CLK_SYS_MHZ_MAX)), 1300);
+    HT_EQ(clk_vreg_mv(MHZ(CLK_SYS_MHZ_MAX) + 1), 0);
+
+    // SCKは起動時より速くせず、RXDELAYの時間は起動時以上(どちらも切り上げ)
+    clk_qmi_calc(MHZ(150), MHZ(150), &boot, &qmi);
+    HT_EQ(qmi.clkdiv, 3);
+    HT_EQ(qmi.rxdelay, 2);
+    clk_qmi_calc(MHZ(CLK_SYS_MHZ_MAX), MHZ(150), &boot, &qmi);
+    HT_EQ(qmi.clkdiv, 6);
+    HT_EQ(qmi.rxdelay, 4);
+    clk_qmi_calc(MHZ(200), MHZ(150), &boot, &qmi);
+    HT_EQ(qmi.clkdiv, 4);
+    HT_EQ(qmi.rxdelay, 3);
+    clk_qmi_calc(MHZ(CLK_SYS_MHZ_MIN), MHZ(150), &boot, &qmi);
+    HT_EQ(qmi.clkdiv, CLK_QMI_DIV_MIN);
+    HT_EQ(qmi.rxdelay, 1);
+    clk_qmi_calc(MHZ(CLK_SYS_MHZ_MAX), MHZ(150), &boot_slow, &qmi);
+    HT_EQ(qmi.clkdiv, CLK_QMI_DIV_MAX);
+    HT_EQ(qmi.rxdelay, CLK_QMI_RXDELAY_MAX);
+}
+
+// 【登録と再計算】
+// p_hwはapplyを呼んだ回数のカウンタ(利用者ごとに別のアドレスになる)
+static uint32_t s_apply_num[CLK_REG_USER_MAX + 1];
+
+static void fake_apply(const clk_user_t *p_user)
+{
+    (*(uint32_t *)p_user->p_hw)++;
+}
+
+// clk_periはclk_sysと同じ(SDKのset_sys_clock_khz()がそう設定する)
+static void src_set(uint32_t *p_src_hz, uint32_t sys_hz)
+{
+    p_src_hz[CLK_SRC_SYS] = sys_hz;
+    p_src_hz[CLK_SRC_PERI] = sys_hz;
+    p_src_hz[CLK_SRC_REF] = REF_HZ;
+}
+
+static uint32_t apply_total(void)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i <= CLK_REG_USER_MAX; i++)
+    {
+        total += s_apply_num[i];
+    }
+
+    return total;
+}
+
+static void test_reg_add(void)
+{
+    uint32_t src_hz[CLK_SRC_NUM];
+    const clk_user_t *p_user;
+
+    clk_reg_clear();
+    memset(s_apply_num, 0, sizeof(s_apply_num));
+    src_set(src_hz, MHZ(150));
+    HT_EQ(clk_reg_num(), 0);
+    HT_CHECK(clk_reg_get(0) == NULL);
+
+    // is_applyがfalse、または作れなければapplyは呼ばない
+    p_user = clk_reg_add("uart0", CLK_USER_UART, 921600, &s_apply_num[0], 0, fake_apply, src_hz, false);
+    HT_CHECK(p_user != NULL && p_user->is_valid);
+    HT_EQ(s_apply_num[0], 0);
+    p_user = clk_reg_add("pio", CLK_USER_PIO, MHZ(1), &s_apply_num[1], 0, fake_apply, src_hz, true);
+    HT_EQ(s_apply_num[1], 1);
+    HT_EQ(p_user->div.div_int, 150);
+    p_user = clk_reg_add("pio_fast", CLK_USER_PIO, MHZ(200), &s_apply_num[1], 1, fake_apply, src_hz, true);
+    HT_CHECK(!p_user->is_valid);
+    HT_EQ(s_apply_num[1], 1);
+    HT_EQ(clk_reg_num(), 3);
+
+    // 同じ種類、H/W、indexなら上書き
+    p_user = clk_reg_add("pio2", CLK_USER_PIO, MHZ(2), &s_apply_num[1], 0, fake_apply, src_hz, true);
+    HT_CHECK(p_user == clk_reg_get(1));
+    HT_CHECK(strcmp(p_user->p_name, "pio2") == 0);
+    HT_EQ(p_user->div.div_int, 75);
+    HT_EQ(s_apply_num[1], 2);
+    HT_EQ(clk_reg_num(), 3);
+
+    // 満杯なら新しい利用者はNULL、上書きはできる
+    for (uint32_t i = 3; i < CLK_REG_USER_MAX; i++)
+    {
+        HT_CHECK(clk_reg_add("tick", CLK_USER_TICK, TICK_HZ, &s_apply_num[i], i, fake_apply, src_hz, false) != NULL);
+    }
+    HT_EQ(clk_reg_num(), CLK_REG_USER_MAX);
+    HT_CHECK(clk_reg_add("over", CLK_USER_TICK, TICK_HZ, &s_apply_num[CLK_REG_USER_MAX], 0,
+                         fake_apply, src_hz, true) == NULL);
+    HT_CHECK(clk_reg_add("uart0", CLK_USER_UART, 115200, &s_apply_num[0], 0, fake_apply, src_hz, false) != NULL);
+    HT_EQ(clk_reg_get(0)->div.div_int, 81);
+    HT_EQ(clk_reg_num(), CLK_REG_USER_MAX);
+    HT_CHECK(clk_reg_get(CLK_REG_USER_MAX) == NULL);
+    HT_EQ(s_apply_num[CLK_REG_USER_MAX], 0);
+
+    clk_reg_clear();
+    HT_EQ(clk_reg_num(), 0);
+}
+
+// 起動時のファームと同じ利用者に、clk_sysの下限と上限で作れなくなる利用者を足して
+// 150MHz → 48MHz → 300MHz → 150MHzと変える
+enum {
+    U_TIMER0 = 0, U_TIMER1, U_WDT,
+    U_BLINK, U_PIO_FAST, U_PIO_SLOW,
+    U_UART0, U_UART1, U_UART_SLOW,
+    U_SPI0, U_SPI1, U_I2C0, U_I2C1,
+    U_NUM
+};
+
+static void test_retune(void)
+{
+    static const struct {
+        const char *p_name;
+        clk_user_type_t type;
+        uint32_t target_hz;
+        bool is_apply;
+    } s_user[U_NUM] = {
+        {"timer0", CLK_USER_TICK, TICK_HZ, true},
+        {"timer1", CLK_USER_TICK, TICK_HZ, true},
+        {"wdt", CLK_USER_TICK, TICK_HZ, true},
+        {"blink", CLK_USER_PIO, MHZ(1), true},
+        {"pio_fast", CLK_USER_PIO, MHZ(60), true},      // 48MHzでは作れない
+        {"pio_slow", CLK_USER_PIO, 2500, true},         // 300MHzでは作れない
+        {"uart0", CLK_USER_UART, 921600, false},
+        {"uart1", CLK_USER_UART, 921600, false},
+        {"uart_slow", CLK_USER_UART, 150, false},       // 300MHzでは作れない
+        {"spi0", CLK_USER_SPI, MHZ(1), false},
+        {"spi1", CLK_USER_SPI, MHZ(1), false},
+        {"i2c0", CLK_USER_I2C, 100000, false},
+        {"i2c1", CLK_USER_I2C, 100000, false},
+    };
+    uint32_t src_hz[CLK_SRC_NUM];
+    uint32_t invalid = 0xFFFF;
+    uint32_t before;
+
+    clk_reg_clear();
+    memset(s_apply_num, 0, sizeof(s_apply_num));
+    src_set(src_hz, MHZ(150));
+    for (uint32_t i = 0; i < U_NUM; i++)
+    {
+        HT_CHECK(clk_reg_add(s_user[i].p_name, s_user[i].type, s_user[i].target_hz, &s_apply_num[i], 0,
+                             fake_apply, src_hz, s_user[i].is_apply) != NULL);
+        HT_CHECK(clk_reg_get(i)->is_valid);
+    }
+    HT_EQ(apply_total(), 6);
+
+    // 同じクロックなら何も書かない
+    HT_EQ(clk_reg_retune(src_hz, &invalid), 0);
+    HT_EQ(invalid, 0);
+    HT_EQ(apply_total(), 6);
+
+    // 下限: tickはclk_refなのでそのまま、pio_fastだけ作れない
+    memset(s_apply_num, 0, sizeof(s_apply_num));
+    src_set(src_hz, MHZ(CLK_SYS_MHZ_MIN));
+    HT_EQ(clk_reg_retune(src_hz, &invalid), 9);
+    HT_EQ(invalid, 1);
+    HT_EQ(s_apply_num[U_TIMER0] + s_apply_num[U_TIMER1] + s_apply_num[U_WDT], 0);
+    HT_EQ(s_apply_num[U_PIO_FAST], 0);
+    HT_CHECK(!clk_reg_get(U_PIO_FAST)->is_valid);
+    HT_EQ(clk_reg_get(U_PIO_FAST)->div.div_int, 2);     // 150MHzの値のまま
+    HT_EQ(clk_reg_get(U_PIO_FAST)->div.div_frac, 128);
+    HT_EQ(clk_reg_get(U_BLINK)->div.div_int, 48);
+    HT_EQ(clk_reg_get(U_UART0)->div.div_int, 3);
+    HT_EQ(clk_reg_get(U_SPI0)->div.div_frac, 24);
+    HT_EQ(clk_reg_get(U_I2C0)->div.div_frac, 288);
+
+    // 上限: pio_fastは作れるようになって書き、pio_slowとuart_slowは前の値のまま
+    memset(s_apply_num, 0, sizeof(s_apply_num));
+    src_set(src_hz, MHZ(CLK_SYS_MHZ_MAX));
+    HT_EQ(clk_reg_retune(src_hz, &invalid), 8);
+    HT_EQ(invalid, 2);
+    HT_EQ(s_apply_num[U_PIO_FAST], 1);
+    HT_CHECK(clk_reg_get(U_PIO_FAST)->is_valid);
+    HT_EQ(s_apply_num[U_PIO_SLOW] + s_apply_num[U_UART_SLOW], 0);
+    HT_CHECK(!clk_reg_get(U_PIO_SLOW)->is_valid);
+    HT_CHECK(!clk_reg_get(U_UART_SLOW)->is_valid);
+    HT_EQ(clk_reg_get(U_PIO_SLOW)->div.div_int, 19200);
+    HT_EQ(clk_reg_get(U_UART_SLOW)->div.div_int, 20000);
+    HT_EQ(clk_reg_get(U_UART1)->div.div_int, 20);
+    HT_EQ(clk_reg_get(U_UART1)->div.div_frac, 22);
+    HT_EQ(clk_reg_get(U_SPI1)->div.div_frac, 150);
+
+    // 戻すと作れなかった利用者も書き直す。NULLのp_invalidも受け付ける
+    memset(s_apply_num, 0, sizeof(s_apply_num));
+    src_set(src_hz, MHZ(150));
+    HT_EQ(clk_reg_retune(src_hz, NULL), 10);
+    HT_EQ(s_apply_num[U_PIO_SLOW], 1);
+    HT_EQ(s_apply_num[U_UART_SLOW], 1);
+    for (uint32_t i = 0; i < U_NUM; i++)
+    {
+        HT_CHECK(clk_reg_get(i)->is_valid);
+    }
+    before = apply_total();
+    HT_EQ(clk_reg_retune(src_hz, &invalid), 0);
+    HT_EQ(invalid, 0);
+    HT_EQ(apply_total(), before);
+
+    // clk_refが変わればtickだけ書く
+    src_hz[CLK_SRC_REF] = MHZ(24);
+    HT_EQ(clk_reg_retune(src_hz, &invalid), 3);
+    HT_EQ(clk_reg_get(U_WDT)->div.div_int, 24);
+    clk_reg_clear();
+}
+
+int main(void)
+{
+    HT_RUN(test_div_pio);
+    HT_RUN(test_div_uart);
+    HT_RUN(test_div_spi);
+    HT_RUN(test_div_i2c);
+    HT_RUN(test_div_tick);
+    HT_RUN(test_names);
+    HT_RUN(test_vreg_qmi);
+    HT_RUN(test_reg_add);
+    HT_RUN(test_retune);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_crc.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief crc.cのテスト(既知の値、スライス8とビット演算、続きの計算、DMAスニッファのモデルとの一致)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "crc.h"
+#include <string.h>
+
+#define BUF_SIZE        4096
+#define RAND_ROUNDS     2000
+
+static uint32_t s_buf[(BUF_SIZE + 8) / 4];
+
+static void fill_rand(uint8_t *p_buf, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        p_buf[i] = (uint8_t)ht_rand();
+    }
+}
+
+static uint32_t crc_of(crc_type_t type, const void *p_data, uint32_t len)
+{
+    return crc_sw_update(type, crc_start(type), (const uint8_t *)p_data, len);
+}
+
+// 【既知の値】CRC-32(zlib)とCRC-16-CCITT(初期値0xFFFF、反射なし、最終XORなし)
+static void test_check_value(void)
+{
+    static const char s_check[] = "123456789";
+    static const char s_fox[] = "The quick brown fox jumps over the lazy dog";
+    const uint8_t *p_check = (const uint8_t *)s_check;
+
+    HT_EQ(crc_start(CRC_TYPE_32), 0);
+    HT_EQ(crc_start(CRC_TYPE_16), 0xFFFF);
+    HT_EQ(crc_of(CRC_TYPE_32, s_check, 0), 0);
+    HT_EQ(crc_of(CRC_TYPE_16, s_check, 0), 0xFFFF);
+
+    HT_EQ(crc_of(CRC_TYPE_32, s_check, 9), 0xCBF43926u);
+    HT_EQ(crc_of(CRC_TYPE_16, s_check, 9), 0x29B1);
+    HT_EQ(crc_bitwise_update(CRC_TYPE_32, 0, p_check, 9), 0xCBF43926u);
+    HT_EQ(crc_bitwise_update(CRC_TYPE_16, 0xFFFF, p_check, 9), 0x29B1);
+    HT_EQ(crc_of(CRC_TYPE_32, s_fox, sizeof(s_fox) - 1), 0x414FA339u);
+    HT_EQ(crc_of(CRC_TYPE_16, "A", 1), 0xB915);
+
+    // 前のCRCを渡せば続きになる
+    HT_EQ(crc_sw_update(CRC_TYPE_32, crc_of(CRC_TYPE_32, s_check, 4), &p_check[4], 5), 0xCBF43926u);
+    HT_EQ(crc_sw_update(CRC_TYPE_16, crc_of(CRC_TYPE_16, s_check, 3), &p_check[3], 6), 0x29B1);
+}
+
+// 【スライス8とビット演算】長さ0～、先頭のずれ0～7(8バイトのブロックと端数)、途中で分けても同じ
+static void test_sw_bitwise(void)
+{
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = (r < 64) ? r : ht_rand_below(BUF_SIZE);
+        uint8_t *p = (uint8_t *)s_buf + ht_rand_below(8);
+        uint32_t split = (len > 0) ? ht_rand_below(len + 1) : 0;
+
+        fill_rand(p, len);
+        for (uint32_t t = 0; t < CRC_TYPE_NUM; t++)
+        {
+            crc_type_t type = (crc_type_t)t;
+            uint32_t crc = crc_of(type, p, len);
+
+            HT_EQ(crc, crc_bitwise_update(type, crc_start(type), p, len));
+            HT_EQ(crc, crc_sw_update(type, crc_of(type, p, split), &p[split], len - split));
+        }
+    }
+}
+
+// 【DMAスニッファ】
+// crc_hw_start()と同じく、アラインまでをソフトウェア、間をスニッファ、末尾をソフトウェアで計算して
+// 全体をスライス8で計算した値と比べる(転送幅1/2/4バイト、前のCRCからの続き)
+static uint32_t sniff_calc(crc_type_t type, uint32_t crc, const uint8_t *p, uint32_t len, uint32_t xfer_size)
+{
+    uint32_t head = (uint32_t)(-(uintptr_t)p) & (xfer_size - 1);
+    crc_sniff_cfg_t cfg;
+
+    if (head > len) {
+        head = len;
+    }
+    uint32_t body = (len - head) / xfer_size * xfer_size;
+
+    crc = crc_sw_update(type, crc, p, head);
+    if (body > 0) {
+        crc_sniff_get_cfg(type, &cfg);
+        uint32_t acc = crc_sniff_model(&cfg, crc_sniff_seed(type, crc), &p[head], body, xfer_size);
+        crc = crc_sniff_result(type, acc);
+    }
+
+    return crc_sw_update(type, crc, &p[head + body], len - head - body);
+}
+
+static void test_sniff_model(void)
+{
+    static const uint32_t s_xfer[] = {1, 2, 4};
+    crc_sniff_cfg_t cfg;
+
+    crc_sniff_get_cfg(CRC_TYPE_32, &cfg);
+    HT_EQ(cfg.calc, CRC_SNIFF_CALC_CRC32R);
+    HT_CHECK(!cfg.is_bswap);
+    crc_sniff_get_cfg(CRC_TYPE_16, &cfg);
+    HT_EQ(cfg.calc, CRC_SNIFF_CALC_CRC16);
+    HT_CHECK(cfg.is_bswap);
+
+    HT_EQ(sniff_calc(CRC_TYPE_32, 0, (const uint8_t *)"12345678", 8, 4), crc_of(CRC_TYPE_32, "12345678", 8));
+    HT_EQ(sniff_calc(CRC_TYPE_32, 0, (const uint8_t *)"123456789", 9, 4), 0xCBF43926u);
+    HT_EQ(sniff_calc(CRC_TYPE_16, 0xFFFF, (const uint8_t *)"123456789", 9, 4), 0x29B1);
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = (r < 64) ? r : ht_rand_below(BUF_SIZE / 4);
+        uint8_t *p = (uint8_t *)s_buf + ht_rand_below(8);
+        uint32_t xfer_size = s_xfer[ht_rand_below(3)];
+
+        fill_rand(p, len);
+        for (uint32_t t = 0; t < CRC_TYPE_NUM; t++)
+        {
+            crc_type_t type = (crc_type_t)t;
+            uint32_t crc = (ht_rand_below(2) == 0) ? crc_start(type) : (ht_rand() & ((t == CRC_TYPE_16) ? 0xFFFF : ~0u));
+
+            HT_EQ(sniff_calc(type, crc, p, len, xfer_size), crc_sw_update(type, crc, p, len));
+        }
+    }
+}
+
+// 規約を間違えた設定では合わない(モデルがビット順とバイト順を区別している)
+static void test_sniff_wrong_cfg(void)
+{
+    const uint8_t *p = (const uint8_t *)"123456789abcdef0";
+    crc_sniff_cfg_t cfg;
+    uint32_t acc;
+
+    cfg.calc = CRC_SNIFF_CALC_CRC32;
+    cfg.is_bswap = false;
+    acc = crc_sniff_model(&cfg, crc_sniff_seed(CRC_TYPE_32, 0), p, 16, 4);
+    HT_CHECK(crc_sniff_result(CRC_TYPE_32, acc) != crc_of(CRC_TYPE_32, p, 16));
+
+    cfg.calc = CRC_SNIFF_CALC_CRC16;
+    cfg.is_bswap = false;
+    acc = crc_sniff_model(&cfg, crc_sniff_seed(CRC_TYPE_16, 0xFFFF), p, 16, 4);
+    HT_CHECK(crc_sniff_result(CRC_TYPE_16, acc) != crc_of(CRC_TYPE_16, p, 16));
+
+    // 1バイト転送ならBSWAPは関係ない
+    cfg.is_bswap = true;
+    HT_EQ(crc_sniff_model(&cfg, crc_sniff_seed(CRC_TYPE_16, 0xFFFF), p, 16, 1), crc_of(CRC_TYPE_16, p, 16));
+    cfg.is_bswap = false;
+    HT_EQ(crc_sniff_model(&cfg, crc_sniff_seed(CRC_TYPE_16, 0xFFFF), p, 16, 1), crc_of(CRC_TYPE_16, p, 16));
+}
+
+int main(void)
+{
+    ht_srand(0xC3C3u);
+    crc_init();
+
+    HT_RUN(test_check_value);
+    HT_RUN(test_sw_bitwise);
+    HT_RUN(test_sniff_model);
+    HT_RUN(test_sniff_wrong_cfg);
+
+    return HT_RESULT();
+}
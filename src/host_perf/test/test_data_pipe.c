@@ -0,0 +1,440 @@
+/**
+ * @file test_data_pipe.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief data_pipe.cのテスト(ヘッダ、分割とENDフラグ、背圧、リンクが一杯の時、ループバックで送った通りに届く)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※リンクはリングバッファで模擬する(USBのFIFOのように空きが少しずつしか無い)
+ */
+#include "host_test.h"
+#include "data_pipe.h"
+#include <string.h>
+
+#define LINK_SIZE       1024            // リンクのFIFO
+#define MSG_MAX         10000           // 1メッセージの上限(3フレームに分かれる)
+#define MSG_BUF_NUM     (DP_QUEUE_DEPTH + 1)
+#define RAND_MSGS       600
+
+// 【リンク(リングバッファ)】
+typedef struct {
+    uint8_t buf[LINK_SIZE];
+    uint32_t rd;
+    uint32_t num;
+    uint32_t size;          // 使う大きさ(LINK_SIZE以下)
+    uint32_t avail_max;     // write_availが返す上限(0なら一杯)
+    uint32_t write_max;     // 1回のwriteで受け取る上限
+    uint32_t flushes;
+} link_t;
+
+static link_t s_link;
+
+static uint32_t link_write_avail(void *p_ctx)
+{
+    link_t *p_link = (link_t *)p_ctx;
+    uint32_t free = p_link->size - p_link->num;
+
+    return (free < p_link->avail_max) ? free : p_link->avail_max;
+}
+
+static uint32_t link_write(void *p_ctx, const uint8_t *p_data, uint32_t len)
+{
+    link_t *p_link = (link_t *)p_ctx;
+    uint32_t n = (len < p_link->write_max) ? len : p_link->write_max;
+
+    HT_CHECK(n <= p_link->size - p_link->num);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        p_link->buf[(p_link->rd + p_link->num + i) % LINK_SIZE] = p_data[i];
+    }
+    p_link->num += n;
+
+    return n;
+}
+
+static void link_flush(void *p_ctx)
+{
+    ((link_t *)p_ctx)->flushes++;
+}
+
+static const dp_link_t s_dp_link = {
+    .write_avail = link_write_avail,
+    .write = link_write,
+    .flush = link_flush,
+    .p_ctx = &s_link,
+};
+
+static void link_reset(void)
+{
+    memset(&s_link, 0, sizeof(s_link));
+    s_link.size = LINK_SIZE;
+    s_link.avail_max = LINK_SIZE;
+    s_link.write_max = LINK_SIZE;
+}
+
+// リンクから最大max_lenバイト取り出す
+static uint32_t link_read(uint8_t *p_buf, uint32_t max_len)
+{
+    uint32_t n = (s_link.num < max_len) ? s_link.num : max_len;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        p_buf[i] = s_link.buf[(s_link.rd + i) % LINK_SIZE];
+    }
+    s_link.rd = (s_link.rd + n) % LINK_SIZE;
+    s_link.num -= n;
+
+    return n;
+}
+
+// 【受信側】フレームの断片をつなげてメッセージに戻す
+typedef struct {
+    uint8_t msg[MSG_MAX];
+    uint32_t len;           // 今のメッセージで受け取ったバイト数
+    uint32_t frame_off;     // 今のフレームで受け取ったバイト数
+    uint32_t msgs;          // 受け取ったメッセージ数
+    uint32_t frames;
+    uint8_t type;
+    bool is_err;            // 断片の順序が合わない
+} rx_t;
+
+static rx_t s_rx;
+
+// メッセージiの中身(送信側のバッファは使い回すので、受信側は式で確かめる)
+static uint8_t msg_byte(uint32_t msg, uint32_t offset)
+{
+    return (uint8_t)(msg * 131 + offset * 7 + (offset >> 9));
+}
+
+static uint32_t s_msg_len[RAND_MSGS];
+
+static void on_rx(void *p_ctx, const dp_hdr_t *p_hdr, uint32_t offset, const uint8_t *p_data, uint32_t len)
+{
+    rx_t *p_rx = (rx_t *)p_ctx;
+
+    if (offset != p_rx->frame_off || p_rx->len + len > MSG_MAX) {
+        p_rx->is_err = true;
+        return;
+    }
+    if (p_rx->len == 0 && offset == 0) {
+        p_rx->type = p_hdr->type;
+    }
+    if (p_hdr->type != p_rx->type) {
+        p_rx->is_err = true;
+    }
+    if (len > 0) {
+        memcpy(&p_rx->msg[p_rx->len], p_data, len);     // 空のフレームはp_dataがNULL
+    }
+    p_rx->len += len;
+    p_rx->frame_off += len;
+    if (p_rx->frame_off < p_hdr->len) {
+        return;
+    }
+
+    // フレームの最後
+    p_rx->frame_off = 0;
+    p_rx->frames++;
+    if ((p_hdr->flags & DP_FLAG_END) == 0) {
+        return;
+    }
+    if (p_rx->msgs < RAND_MSGS) {
+        uint32_t msg = p_rx->msgs;
+        HT_EQ(p_rx->len, s_msg_len[msg]);
+        HT_EQ(p_rx->type, msg % DP_TYPE_NUM);
+        for (uint32_t i = 0; i < p_rx->len; i++)
+        {
+            if (p_rx->msg[i] != msg_byte(msg, i)) {
+                HT_CHECK(p_rx->msg[i] == msg_byte(msg, i));
+                break;
+            }
+        }
+    }
+    p_rx->msgs++;
+    p_rx->len = 0;
+}
+
+// 【送信の完了】
+// 終わったバッファは壊す(完了が早すぎれば受信側の中身が合わなくなる)
+typedef struct {
+    uint32_t num;
+    const uint8_t *p_first;
+    const uint8_t *p_last;
+    uint32_t last_len;
+} done_t;
+
+static void on_done(void *p_ctx, const uint8_t *p_data, uint32_t len)
+{
+    done_t *p_done = (done_t *)p_ctx;
+
+    if (p_done->num == 0) {
+        p_done->p_first = p_data;
+    }
+    p_done->num++;
+    p_done->p_last = p_data;
+    p_done->last_len = len;
+    if (len > 0) {
+        memset((void *)p_data, 0xEE, len);
+    }
+}
+
+static void test_hdr(void)
+{
+    const dp_hdr_t hdr = {.magic = DP_MAGIC, .type = DP_TYPE_BENCH, .flags = DP_FLAG_END, .seq = 0xBEEF, .len = 0x1234};
+    const uint8_t expect[DP_HDR_SIZE] = {'D', 'P', 0x01, 0x01, 0xEF, 0xBE, 0x34, 0x12};
+    uint8_t buf[DP_HDR_SIZE];
+    dp_hdr_t out;
+
+    dp_hdr_pack(buf, &hdr);
+    HT_CHECK(memcmp(buf, expect, DP_HDR_SIZE) == 0);
+    dp_hdr_unpack(buf, &out);
+    HT_EQ(out.magic, DP_MAGIC);
+    HT_EQ(out.type, DP_TYPE_BENCH);
+    HT_EQ(out.flags, DP_FLAG_END);
+    HT_EQ(out.seq, 0xBEEF);
+    HT_EQ(out.len, 0x1234);
+
+    // tools/pipe_bench.pyのdp_pattern()と同じ値
+    HT_EQ(dp_pattern(0), 0);
+    HT_EQ(dp_pattern(1), 31);
+    HT_EQ(dp_pattern(255), (255 * 31) & 0xFF);
+    HT_EQ(dp_pattern(256), 1);
+}
+
+// 大きい送信は4096バイトずつに分け、最後のフレームだけEND。0バイトは空のフレームを1つ
+static void test_split(void)
+{
+    static uint8_t s_buf[DP_FRAME_PAYLOAD_MAX * 2 + 100];
+    uint8_t wire[DP_HDR_SIZE];
+    dp_hdr_t hdr;
+    dp_t dp;
+    done_t done = {0};
+
+    dp_init(&dp);
+    link_reset();
+    s_link.avail_max = 0;
+    HT_CHECK(dp_submit(&dp, DP_TYPE_RAW, s_buf, sizeof(s_buf), on_done, &done));
+    HT_CHECK(dp_submit(&dp, DP_TYPE_BENCH, NULL, 0, on_done, &done));
+    HT_EQ(dp_tx_queued(&dp), 2);
+
+    // リンクが一杯なら何も書かない
+    HT_EQ(dp_tx_pump(&dp, &s_dp_link), 0);
+    HT_EQ(dp.stat.tx_stall, 1);
+    HT_EQ(s_link.flushes, 0);
+
+    // 1フレームずつ取り出してヘッダを確かめる
+    static const uint16_t s_len[] = {DP_FRAME_PAYLOAD_MAX, DP_FRAME_PAYLOAD_MAX, 100, 0};
+    static const uint8_t s_flags[] = {0, 0, DP_FLAG_END, DP_FLAG_END};
+    s_link.avail_max = LINK_SIZE;
+    for (uint32_t f = 0; f < 4; f++)
+    {
+        uint32_t got = 0;
+        while (got < DP_HDR_SIZE)
+        {
+            dp_tx_pump(&dp, &s_dp_link);
+            got += link_read(&wire[got], DP_HDR_SIZE - got);
+        }
+        dp_hdr_unpack(wire, &hdr);
+        HT_EQ(hdr.magic, DP_MAGIC);
+        HT_EQ(hdr.type, (f < 3) ? DP_TYPE_RAW : DP_TYPE_BENCH);
+        HT_EQ(hdr.seq, f);
+        HT_EQ(hdr.len, s_len[f]);
+        HT_EQ(hdr.flags, s_flags[f]);
+        for (uint32_t left = hdr.len; left > 0;)
+        {
+            uint8_t tmp[256];
+            dp_tx_pump(&dp, &s_dp_link);
+            left -= link_read(tmp, (left < sizeof(tmp)) ? left : sizeof(tmp));
+        }
+    }
+    dp_tx_pump(&dp, &s_dp_link);
+    HT_EQ(done.num, 2);
+    HT_CHECK(done.p_first == s_buf);
+    HT_CHECK(done.p_last == NULL);
+    HT_EQ(done.last_len, 0);
+    HT_EQ(dp_tx_queued(&dp), 0);
+    HT_EQ(dp.stat.tx_frames, 4);
+    HT_EQ(dp.stat.tx_msgs, 2);
+    HT_EQ(dp.stat.tx_bytes, sizeof(s_buf) + 4 * DP_HDR_SIZE);
+    HT_EQ(s_link.num, 0);
+}
+
+// キューが満杯ならsubmitはfalse(背圧)、pumpで空けば受け付ける。完了は予約した順
+static void test_backpressure(void)
+{
+    static uint8_t s_buf[DP_QUEUE_DEPTH + 1][16];
+    dp_t dp;
+    done_t done = {0};
+
+    dp_init(&dp);
+    link_reset();
+    for (uint32_t i = 0; i < DP_QUEUE_DEPTH; i++)
+    {
+        HT_CHECK(dp_submit(&dp, DP_TYPE_RAW, s_buf[i], 16, on_done, &done));
+    }
+    HT_CHECK(!dp_submit(&dp, DP_TYPE_RAW, s_buf[DP_QUEUE_DEPTH], 16, on_done, &done));
+    HT_EQ(dp.stat.tx_full, 1);
+
+    // リンクに1件分しか空きが無ければそこで止まり、先頭の1件が終わって1段空く
+    // (1回のwriteは1バイトずつ)
+    s_link.size = DP_HDR_SIZE + 16;
+    s_link.write_max = 1;
+    HT_EQ(dp_tx_pump(&dp, &s_dp_link), DP_HDR_SIZE + 16);
+    HT_EQ(done.num, 1);
+    HT_CHECK(done.p_last == s_buf[0]);
+    HT_EQ(dp.stat.tx_stall, 1);
+    HT_EQ(s_link.flushes, 1);
+    HT_CHECK(dp_submit(&dp, DP_TYPE_RAW, s_buf[DP_QUEUE_DEPTH], 16, on_done, &done));
+
+    // 空けば続きから
+    s_link.size = LINK_SIZE;
+    dp_tx_pump(&dp, &s_dp_link);
+    HT_EQ(done.num, DP_QUEUE_DEPTH + 1);
+    HT_CHECK(done.p_last == s_buf[DP_QUEUE_DEPTH]);
+    HT_EQ(s_link.num, (DP_QUEUE_DEPTH + 1) * (DP_HDR_SIZE + 16));
+
+    // writeが0を返してもstallとして抜ける
+    HT_CHECK(dp_submit(&dp, DP_TYPE_RAW, s_buf[0], 16, on_done, &done));
+    s_link.write_max = 0;
+    uint32_t stall = dp.stat.tx_stall;
+    HT_EQ(dp_tx_pump(&dp, &s_dp_link), 0);
+    HT_EQ(dp.stat.tx_stall, stall + 1);
+    HT_EQ(dp_tx_queued(&dp), 1);
+}
+
+// 【受信の同期とseq】
+static void test_rx_resync(void)
+{
+    uint8_t wire[64];
+    dp_hdr_t hdr = {.magic = DP_MAGIC, .type = DP_TYPE_RAW, .flags = DP_FLAG_END, .seq = 0, .len = 4};
+    dp_t dp;
+
+    dp_init(&dp);
+    memset(&s_rx, 0, sizeof(s_rx));
+    s_msg_len[0] = 4;
+    s_msg_len[1] = 4;
+    dp_set_rx_handler(&dp, on_rx, &s_rx);
+
+    // 'D'を含むごみ5バイトの後にフレーム
+    wire[0] = 0x00;
+    wire[1] = 'D';
+    wire[2] = 'D';
+    wire[3] = 'x';
+    wire[4] = 'P';
+    dp_hdr_pack(&wire[5], &hdr);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        wire[5 + DP_HDR_SIZE + i] = msg_byte(0, i);
+    }
+    dp_rx_feed(&dp, wire, 5 + DP_HDR_SIZE + 4);
+    HT_EQ(dp.stat.rx_resync, 5);
+    HT_EQ(dp.stat.rx_frames, 1);
+    HT_EQ(s_rx.msgs, 1);
+
+    // seqが1つ飛んだ(1バイトずつ流しても同じ)
+    hdr.seq = 2;
+    hdr.type = DP_TYPE_BENCH;
+    dp_hdr_pack(wire, &hdr);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        wire[DP_HDR_SIZE + i] = msg_byte(1, i);
+    }
+    for (uint32_t i = 0; i < DP_HDR_SIZE + 4; i++)
+    {
+        dp_rx_feed(&dp, &wire[i], 1);
+    }
+    HT_EQ(dp.stat.rx_seq_err, 1);
+    HT_EQ(dp.stat.rx_frames, 2);
+    HT_EQ(dp.stat.rx_payload, 8);
+    HT_EQ(dp.stat.rx_bytes, 5 + 2 * (DP_HDR_SIZE + 4));
+    HT_EQ(s_rx.msgs, 2);
+    HT_CHECK(!s_rx.is_err);
+
+    // 統計を消すとseqは次のフレームから数え直す
+    dp_clear_stat(&dp);
+    s_msg_len[2] = 0;
+    hdr.seq = 100;
+    hdr.type = DP_TYPE_RAW;
+    hdr.len = 0;
+    dp_hdr_pack(wire, &hdr);
+    dp_rx_feed(&dp, wire, DP_HDR_SIZE);
+    HT_EQ(dp.stat.rx_seq_err, 0);
+    HT_EQ(dp.stat.rx_frames, 1);
+}
+
+// 【ループバック】
+// 乱数の長さと種類のメッセージを送り、リンクの空きと受信の区切りも乱数にして
+// 受信側で組み立て直したものが送った通りか確かめる
+static void test_loopback(void)
+{
+    static uint8_t s_buf[MSG_BUF_NUM][MSG_MAX];
+    static uint8_t s_chunk[LINK_SIZE];
+    dp_t tx;
+    dp_t rx;
+    done_t done = {0};
+    uint32_t sent = 0;
+    uint64_t payload = 0;
+
+    dp_init(&tx);
+    dp_init(&rx);
+    link_reset();
+    memset(&s_rx, 0, sizeof(s_rx));
+    dp_set_rx_handler(&rx, on_rx, &s_rx);
+
+    while (s_rx.msgs < RAND_MSGS)
+    {
+        // 送れるだけ予約する(送信中のバッファは完了まで使い回さない)
+        while (sent < RAND_MSGS && ht_rand_below(3) != 0)
+        {
+            uint32_t len = (ht_rand_below(8) == 0) ? 0 : ht_rand_below(MSG_MAX + 1);
+            uint8_t *p_buf = s_buf[sent % MSG_BUF_NUM];
+
+            for (uint32_t i = 0; i < len; i++)
+            {
+                p_buf[i] = msg_byte(sent, i);
+            }
+            if (!dp_submit(&tx, (uint8_t)(sent % DP_TYPE_NUM), p_buf, len, on_done, &done)) {
+                break;
+            }
+            s_msg_len[sent] = len;
+            payload += len;
+            sent++;
+        }
+
+        s_link.avail_max = ht_rand_below(700);
+        s_link.write_max = 1 + ht_rand_below(LINK_SIZE);
+        dp_tx_pump(&tx, &s_dp_link);
+
+        uint32_t n = link_read(s_chunk, 1 + ht_rand_below(LINK_SIZE));
+        dp_rx_feed(&rx, s_chunk, n);
+    }
+
+    HT_CHECK(!s_rx.is_err);
+    HT_EQ(sent, RAND_MSGS);
+    HT_EQ(done.num, RAND_MSGS);
+    HT_EQ(tx.stat.tx_msgs, RAND_MSGS);
+    HT_EQ(tx.stat.tx_frames, rx.stat.rx_frames);
+    HT_EQ(s_rx.frames, rx.stat.rx_frames);
+    HT_EQ(tx.stat.tx_bytes, rx.stat.rx_bytes);
+    HT_EQ(rx.stat.rx_payload, payload);
+    HT_EQ(tx.stat.tx_bytes, payload + (uint64_t)tx.stat.tx_frames * DP_HDR_SIZE);
+    HT_EQ(rx.stat.rx_resync, 0);
+    HT_EQ(rx.stat.rx_seq_err, 0);
+    HT_CHECK(tx.stat.tx_full > 0);
+    HT_CHECK(tx.stat.tx_stall > 0);
+    HT_EQ(dp_tx_queued(&tx), 0);
+}
+
+int main(void)
+{
+    ht_srand(0xD4A7u);
+
+    HT_RUN(test_hdr);
+    HT_RUN(test_split);
+    HT_RUN(test_backpressure);
+    HT_RUN(test_rx_resync);
+    HT_RUN(test_loopback);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,472 @@
+/**
+ * @file test_dma_service.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief dma_service.cのテスト(DMAコントローラのシミュレータをH/W層として注入)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "dma_service.h"
+#include <string.h>
+
+// 【シミュレータ】
+// start()は転送内容のポインタを覚えるだけで、sim_complete()を呼んだときに転送して完了を通知する
+// (実機と同じく開始から完了までの間も転送内容を読むので、呼び出し元の配列を指していれば壊れる)
+
+#define SIM_CH_NUM      8
+#define BUF_SIZE        4096
+
+typedef struct {
+    bool is_claimed;
+    const dma_svc_xfer_t *p_xfer;   // 実行中の転送(NULLなら空き)
+    uint32_t start_num;
+} sim_ch_t;
+
+static sim_ch_t s_sim_ch[SIM_CH_NUM];
+static uint32_t s_sim_ch_limit;     // 確保できるチャネル数
+static uint32_t s_sim_now_us;
+static int32_t s_sim_lock_depth;
+static uint32_t s_sim_abort_num;
+
+static uint8_t s_src[BUF_SIZE];
+static uint8_t s_dst[BUF_SIZE];
+
+// コールバックの記録
+static uint32_t s_cb_ok;
+static uint32_t s_cb_aborted;
+static uint32_t s_cb_order[DMA_SVC_JOB_NUM * 2];
+static uint32_t s_cb_num;
+
+static bool sim_ch_claim(uint32_t *p_ch)
+{
+    for (uint32_t ch = 0; ch < s_sim_ch_limit; ch++)
+    {
+        if (!s_sim_ch[ch].is_claimed) {
+            s_sim_ch[ch].is_claimed = true;
+            *p_ch = ch;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void sim_ch_unclaim(uint32_t ch)
+{
+    s_sim_ch[ch].is_claimed = false;
+}
+
+static void sim_start(uint32_t ch, const dma_svc_xfer_t *p_xfer)
+{
+    HT_CHECK(s_sim_lock_depth == 1);
+    HT_CHECK(s_sim_ch[ch].p_xfer == NULL);
+    s_sim_ch[ch].p_xfer = p_xfer;
+    s_sim_ch[ch].start_num++;
+}
+
+static void sim_abort(uint32_t ch)
+{
+    s_sim_ch[ch].p_xfer = NULL;
+    s_sim_abort_num++;
+}
+
+static uint32_t sim_now_us(void)
+{
+    return s_sim_now_us;
+}
+
+static uint32_t sim_lock(void)
+{
+    s_sim_lock_depth++;
+    return 0x5A;
+}
+
+static void sim_unlock(uint32_t save)
+{
+    HT_EQ(save, 0x5A);
+    s_sim_lock_depth--;
+}
+
+static const dma_svc_hw_ops_t s_sim_ops = {
+    .ch_claim = sim_ch_claim,
+    .ch_unclaim = sim_ch_unclaim,
+    .start = sim_start,
+    .abort = sim_abort,
+    .now_us = sim_now_us,
+    .lock = sim_lock,
+    .unlock = sim_unlock,
+};
+
+// 単発転送(転送サイズ、インクリメント、リングを実機と同じに解釈)
+static void sim_xfer_single(const dma_svc_xfer_t *p_xfer)
+{
+    uint32_t size = 1UL << p_xfer->size;
+    uint32_t ring_mask = (p_xfer->ring_bits != 0) ? ((1UL << p_xfer->ring_bits) - 1) : 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0; i < p_xfer->count; i++)
+    {
+        uint32_t r_off = p_xfer->is_read_incr ? i * size : 0;
+        uint32_t w_off = p_xfer->is_write_incr ? i * size : 0;
+        if (p_xfer->ring_bits != 0) {
+            if (p_xfer->is_ring_write) {
+                w_off &= ring_mask;
+            } else {
+                r_off &= ring_mask;
+            }
+        }
+        memcpy((uint8_t *)p_xfer->p_dst + w_off, (const uint8_t *)p_xfer->p_src + r_off, size);
+    }
+}
+
+// 転送して完了を通知(DMA割り込みの代わり)
+static void sim_complete(uint32_t ch)
+{
+    const dma_svc_xfer_t *p_xfer = s_sim_ch[ch].p_xfer;
+
+    if (p_xfer == NULL) {
+        return;
+    }
+    if (p_xfer->p_sg != NULL) {
+        for (uint32_t i = 0; i < p_xfer->sg_num; i++)
+        {
+            memcpy(p_xfer->p_sg[i].p_dst, p_xfer->p_sg[i].p_src, p_xfer->p_sg[i].len);
+        }
+    } else {
+        sim_xfer_single(p_xfer);
+    }
+    s_sim_ch[ch].p_xfer = NULL;
+    dma_svc_on_complete(ch);
+}
+
+// 実行中の転送がなくなるまで完了させる
+static void sim_drain(void)
+{
+    bool is_busy = true;
+
+    while (is_busy)
+    {
+        is_busy = false;
+        for (uint32_t ch = 0; ch < SIM_CH_NUM; ch++)
+        {
+            if (s_sim_ch[ch].p_xfer != NULL) {
+                s_sim_now_us += 10;
+                sim_complete(ch);
+                is_busy = true;
+            }
+        }
+    }
+}
+
+static uint32_t sim_busy_num(void)
+{
+    uint32_t num = 0;
+
+    for (uint32_t ch = 0; ch < SIM_CH_NUM; ch++)
+    {
+        num += (s_sim_ch[ch].p_xfer != NULL) ? 1 : 0;
+    }
+    return num;
+}
+
+static void test_callback(dma_svc_status_t status, void *p_arg)
+{
+    HT_CHECK(s_sim_lock_depth == 0);
+    if (status == DMA_SVC_OK) {
+        s_cb_ok++;
+    } else {
+        s_cb_aborted++;
+    }
+    if (s_cb_num < sizeof(s_cb_order) / sizeof(s_cb_order[0])) {
+        s_cb_order[s_cb_num++] = (uint32_t)(uintptr_t)p_arg;
+    }
+}
+
+static void sim_reset(uint32_t ch_limit)
+{
+    memset(s_sim_ch, 0, sizeof(s_sim_ch));
+    s_sim_ch_limit = ch_limit;
+    s_sim_now_us = 1000;
+    s_sim_lock_depth = 0;
+    s_sim_abort_num = 0;
+    s_cb_ok = 0;
+    s_cb_aborted = 0;
+    s_cb_num = 0;
+    for (uint32_t i = 0; i < BUF_SIZE; i++)
+    {
+        s_src[i] = (uint8_t)(i * 13 + 7);
+    }
+    memset(s_dst, 0, sizeof(s_dst));
+    HT_CHECK(dma_svc_init(&s_sim_ops));
+}
+
+static void test_size_for(void)
+{
+    HT_EQ(dma_svc_size_for((void *)0x1000, (void *)0x2000, 64), DMA_SVC_SIZE_32);
+    HT_EQ(dma_svc_size_for((void *)0x1002, (void *)0x2000, 64), DMA_SVC_SIZE_16);
+    HT_EQ(dma_svc_size_for((void *)0x1000, (void *)0x2000, 62), DMA_SVC_SIZE_16);
+    HT_EQ(dma_svc_size_for((void *)0x1000, (void *)0x2001, 64), DMA_SVC_SIZE_8);
+    HT_EQ(dma_svc_size_for((void *)0x1000, NULL, 3), DMA_SVC_SIZE_8);
+}
+
+// アライメント違いのmemcpy/memset/fill32が正しく転送され、バイト数が統計に載る
+static void test_copy_fill(void)
+{
+    static const uint32_t s_case_tbl[][3] = {
+        {0, 0, 256}, {2, 0, 254}, {1, 3, 255}, {0, 0, 0}, {4, 8, 4000},
+    };
+    dma_svc_stats_t stats;
+    uint64_t bytes = 0;
+
+    sim_reset(DMA_SVC_CH_NUM);
+    for (uint32_t i = 0; i < sizeof(s_case_tbl) / sizeof(s_case_tbl[0]); i++)
+    {
+        uint32_t d_off = s_case_tbl[i][0];
+        uint32_t s_off = s_case_tbl[i][1];
+        uint32_t len = s_case_tbl[i][2];
+        memset(s_dst, 0, sizeof(s_dst));
+        dma_svc_handle_t handle = dma_svc_memcpy_async(&s_dst[d_off], &s_src[s_off], len, NULL, NULL);
+        HT_CHECK(handle != DMA_SVC_HANDLE_INVALID);
+        HT_CHECK(!dma_svc_is_done(handle) || len == 0);
+        sim_drain();
+        HT_CHECK(dma_svc_is_done(handle));
+        HT_CHECK(memcmp(&s_dst[d_off], &s_src[s_off], len) == 0);
+        HT_EQ(s_dst[d_off + len], 0);
+        bytes += len;
+    }
+
+    memset(s_dst, 0, sizeof(s_dst));
+    HT_CHECK(dma_svc_memset_async(&s_dst[1], 0xA5, 101, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    sim_drain();
+    HT_EQ(s_dst[0], 0);
+    HT_EQ(s_dst[1], 0xA5);
+    HT_EQ(s_dst[101], 0xA5);
+    HT_EQ(s_dst[102], 0);
+    bytes += 101;
+
+    HT_CHECK(dma_svc_fill32_async(&s_dst[2], 0x12345678, 64, NULL, NULL) == DMA_SVC_HANDLE_INVALID);
+    HT_CHECK(dma_svc_fill32_async(&s_dst[0], 0x12345678, 62, NULL, NULL) == DMA_SVC_HANDLE_INVALID);
+    HT_CHECK(dma_svc_fill32_async(&s_dst[0], 0x12345678, 64, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    sim_drain();
+    uint32_t word;
+    memcpy(&word, &s_dst[60], 4);
+    HT_EQ(word, 0x12345678);
+    bytes += 64;
+
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.bytes, bytes);
+    HT_EQ(stats.jobs_done, 7);
+    HT_EQ(stats.ch_busy, 0);
+}
+
+// チャネルより多いジョブはFIFOで待ち、空いたチャネルで順に始まる
+static void test_queue(void)
+{
+    dma_svc_handle_t handle[10];
+    dma_svc_stats_t stats;
+
+    sim_reset(2);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        handle[i] = dma_svc_memcpy_async(&s_dst[i * 100], &s_src[i * 100], 100, test_callback, (void *)(uintptr_t)i);
+        HT_CHECK(handle[i] != DMA_SVC_HANDLE_INVALID);
+    }
+    HT_EQ(sim_busy_num(), 2);
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.queue_depth, 8);
+    HT_EQ(stats.queue_depth_max, 8);
+
+    // チャネル0だけを完了させ続ける(キューの先頭から順にチャネル0で始まる)
+    s_sim_now_us += 100;
+    for (uint32_t i = 0; i < 9; i++)
+    {
+        sim_complete(0);
+    }
+    HT_EQ(s_cb_ok, 9);
+    HT_EQ(s_cb_order[0], 0);
+    HT_EQ(s_cb_order[1], 2);
+    HT_EQ(s_cb_order[8], 9);
+    HT_CHECK(!dma_svc_is_done(handle[1]));
+    sim_complete(1);
+    HT_EQ(s_cb_ok, 10);
+    HT_CHECK(memcmp(s_dst, s_src, 1000) == 0);
+
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.queue_depth, 0);
+    HT_EQ(stats.jobs_done, 10);
+    HT_EQ(stats.wait_us_max, 100);
+    HT_EQ(stats.bytes, 1000);
+}
+
+// キュー待ちの間に呼び出し元のスキャッタギャザーの配列が壊れても、転送と統計は投入時の内容どおり
+static dma_svc_handle_t submit_sg_from_stack(uint32_t *p_total)
+{
+    dma_svc_sg_t sg[DMA_SVC_SG_MAX];
+    uint32_t pos = 0;
+
+    *p_total = 0;
+    for (uint32_t i = 0; i < DMA_SVC_SG_MAX; i++)
+    {
+        uint32_t len = 3 + i * 17;
+        sg[i].p_dst = &s_dst[pos];
+        sg[i].p_src = &s_src[(i * 211) % 2048];
+        sg[i].len = len;
+        pos += len;
+        *p_total += len;
+    }
+    dma_svc_handle_t handle = dma_svc_sg_async(sg, DMA_SVC_SG_MAX, NULL, NULL);
+
+    // 戻る前に配列を壊す(スタックの再利用の代わり)
+    memset(sg, 0xEE, sizeof(sg));
+    return handle;
+}
+
+static void test_sg_copied(void)
+{
+    dma_svc_stats_t stats;
+    uint32_t total;
+
+    sim_reset(1);
+    HT_CHECK(dma_svc_memcpy_async(&s_dst[3000], s_src, 64, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    dma_svc_handle_t handle = submit_sg_from_stack(&total);
+    HT_CHECK(handle != DMA_SVC_HANDLE_INVALID);
+    HT_EQ(sim_busy_num(), 1);
+    sim_drain();
+    HT_CHECK(dma_svc_is_done(handle));
+
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < DMA_SVC_SG_MAX; i++)
+    {
+        uint32_t len = 3 + i * 17;
+        HT_CHECK(memcmp(&s_dst[pos], &s_src[(i * 211) % 2048], len) == 0);
+        pos += len;
+    }
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.bytes, total + 64);
+
+    dma_svc_sg_t sg[1] = {{s_dst, s_src, 4}};
+    HT_CHECK(dma_svc_sg_async(sg, 0, NULL, NULL) == DMA_SVC_HANDLE_INVALID);
+    HT_CHECK(dma_svc_sg_async(sg, DMA_SVC_SG_MAX + 1, NULL, NULL) == DMA_SVC_HANDLE_INVALID);
+}
+
+// 読み出し側16byteのリングでパターンを敷き詰める
+static void test_ring(void)
+{
+    dma_svc_xfer_t xfer = {0};
+
+    sim_reset(1);
+    xfer.p_dst = s_dst;
+    xfer.p_src = s_src;
+    xfer.size = DMA_SVC_SIZE_32;
+    xfer.count = 64;
+    xfer.is_read_incr = true;
+    xfer.is_write_incr = true;
+    xfer.dreq = DMA_SVC_DREQ_NONE;
+    xfer.ring_bits = 4;
+    HT_CHECK(dma_svc_submit(&xfer, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    sim_drain();
+    for (uint32_t i = 0; i < 256; i += 16)
+    {
+        HT_CHECK(memcmp(&s_dst[i], s_src, 16) == 0);
+    }
+}
+
+// キャンセル(キュー待ちは取り除く、転送中は中断)と古いハンドル
+static void test_cancel(void)
+{
+    dma_svc_handle_t handle[4];
+    dma_svc_stats_t stats;
+
+    sim_reset(1);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        handle[i] = dma_svc_memcpy_async(&s_dst[i * 16], &s_src[i * 16], 16, test_callback, (void *)(uintptr_t)i);
+    }
+    HT_CHECK(dma_svc_cancel(handle[2]));
+    HT_CHECK(dma_svc_is_done(handle[2]));
+    HT_CHECK(!dma_svc_cancel(handle[2]));
+    HT_CHECK(dma_svc_cancel(handle[0]));
+    HT_EQ(s_sim_abort_num, 1);
+    HT_EQ(s_cb_aborted, 2);
+
+    // 中断したチャネルでキューの次(1)が始まっている、3はその後
+    HT_EQ(sim_busy_num(), 1);
+    sim_drain();
+    HT_EQ(s_cb_ok, 2);
+    HT_EQ(s_cb_order[2], 1);
+    HT_EQ(s_cb_order[3], 3);
+    HT_EQ(s_dst[2 * 16], 0);
+
+    // スロットが再利用されても古いハンドルは完了扱い
+    dma_svc_handle_t reuse = dma_svc_memcpy_async(s_dst, s_src, 4, NULL, NULL);
+    HT_CHECK((reuse & 0xFF) == (handle[0] & 0xFF) && reuse != handle[0]);
+    HT_CHECK(dma_svc_is_done(handle[0]));
+    HT_CHECK(!dma_svc_is_done(reuse));
+    HT_CHECK(!dma_svc_cancel(handle[0]));
+    sim_drain();
+
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.jobs_aborted, 2);
+    HT_EQ(stats.jobs_done, 3);
+    HT_EQ(stats.queue_depth, 0);
+}
+
+// ジョブ枠を使い切ったら受け付けない
+static void test_job_full(void)
+{
+    dma_svc_stats_t stats;
+
+    sim_reset(1);
+    for (uint32_t i = 0; i < DMA_SVC_JOB_NUM; i++)
+    {
+        HT_CHECK(dma_svc_memcpy_async(s_dst, s_src, 4, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    }
+    HT_CHECK(dma_svc_memcpy_async(s_dst, s_src, 4, NULL, NULL) == DMA_SVC_HANDLE_INVALID);
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.submit_rejects, 1);
+    sim_drain();
+    HT_CHECK(dma_svc_memcpy_async(s_dst, s_src, 4, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    sim_drain();
+}
+
+// 専用に借りる(最後の1チャネルはジョブ用に残す、返したらキュー待ちが始まる)
+static void test_acquire(void)
+{
+    uint32_t ch[DMA_SVC_CH_NUM];
+    dma_svc_stats_t stats;
+
+    sim_reset(3);
+    HT_CHECK(dma_svc_ch_acquire(&ch[0]));
+    HT_CHECK(dma_svc_ch_acquire(&ch[1]));
+    HT_CHECK(!dma_svc_ch_acquire(&ch[2]));
+    HT_CHECK(ch[0] != ch[1]);
+
+    HT_CHECK(dma_svc_memcpy_async(s_dst, s_src, 8, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    HT_CHECK(dma_svc_memcpy_async(&s_dst[8], &s_src[8], 8, NULL, NULL) != DMA_SVC_HANDLE_INVALID);
+    HT_EQ(sim_busy_num(), 1);
+    HT_CHECK(s_sim_ch[ch[0]].p_xfer == NULL && s_sim_ch[ch[1]].p_xfer == NULL);
+
+    dma_svc_ch_release(ch[0]);
+    HT_EQ(sim_busy_num(), 2);
+    HT_CHECK(s_sim_ch[ch[0]].p_xfer != NULL);
+    sim_drain();
+    dma_svc_get_stats(&stats);
+    HT_EQ(stats.ch_reserved, 1);
+    HT_EQ(stats.jobs_done, 2);
+    dma_svc_ch_release(ch[1]);
+}
+
+int main(void)
+{
+    HT_RUN(test_size_for);
+    HT_RUN(test_copy_fill);
+    HT_RUN(test_queue);
+    HT_RUN(test_sg_copied);
+    HT_RUN(test_ring);
+    HT_RUN(test_cancel);
+    HT_RUN(test_job_full);
+    HT_RUN(test_acquire);
+
+    return HT_RESULT();
+}
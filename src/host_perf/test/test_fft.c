@@ -0,0 +1,157 @@
+/**
+ * @file test_fft.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief fft.cのテスト(倍精度の参照FFTに対するSNR、全サイズ・全基数)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "fft.h"
+#include <math.h>
+#include <string.h>
+
+// SNRの下限(dB、実測はf32が約140dB、Q15は各段の1/2スケーリングで1段ごとに約3dB下がり64点で約64dB)
+#define SNR_MIN_F32             120.0
+#define SNR_MIN_F32_REAL        120.0
+#define SNR_MIN_Q15(log2n)      (75.0 - 3.0 * (double)(log2n))
+
+static float s_sig[FFT_MAX_N];
+static double s_ref_re[FFT_MAX_N];
+static double s_ref_im[FFT_MAX_N];
+static fft_cpx_f32_t s_f32[FFT_MAX_N];
+static fft_cpx_q15_t s_q15[FFT_MAX_N];
+
+// 振動解析を想定した入力(トーン3本+小さなノイズ、|x| < 0.9)
+static void make_signal(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double t = (double)i / (double)n;
+        double noise = ((double)ht_rand_below(2001) - 1000.0) / 1000.0;
+        s_sig[i] = (float)(0.4 * sin(2.0 * M_PI * 5.0 * t) + 0.25 * cos(2.0 * M_PI * (n / 8) * t)
+                           + 0.15 * sin(2.0 * M_PI * (n / 2 - 3) * t) + 0.05 * noise);
+    }
+}
+
+static void make_ref(uint32_t log2n)
+{
+    uint32_t n = 1UL << log2n;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        s_ref_re[i] = s_sig[i];
+        s_ref_im[i] = 0.0;
+    }
+    fft_f64_ref(s_ref_re, s_ref_im, log2n);
+}
+
+static void test_snr_f32(void)
+{
+    for (uint32_t log2n = FFT_MIN_LOG2N; log2n <= FFT_MAX_LOG2N; log2n++)
+    {
+        uint32_t n = 1UL << log2n;
+        make_signal(n);
+        make_ref(log2n);
+        for (int32_t radix = FFT_RADIX_2; radix <= FFT_RADIX_4; radix++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                s_f32[i].re = s_sig[i];
+                s_f32[i].im = 0.0f;
+            }
+            fft_f32(s_f32, log2n, (fft_radix_t)radix);
+            double snr = fft_snr_db_f32(s_ref_re, s_ref_im, s_f32, n);
+            if (snr < SNR_MIN_F32) {
+                printf("  f32 n=%u radix=%d SNR %.1f dB\n", n, radix, snr);
+            }
+            HT_CHECK(snr >= SNR_MIN_F32);
+        }
+    }
+}
+
+static void test_snr_q15(void)
+{
+    for (uint32_t log2n = FFT_MIN_LOG2N; log2n <= FFT_MAX_LOG2N; log2n++)
+    {
+        uint32_t n = 1UL << log2n;
+        make_signal(n);
+        make_ref(log2n);
+        for (int32_t radix = FFT_RADIX_2; radix <= FFT_RADIX_4; radix++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                s_q15[i].re = (int16_t)lroundf(s_sig[i] * 32767.0f);
+                s_q15[i].im = 0;
+            }
+            fft_q15(s_q15, log2n, (fft_radix_t)radix);
+            // 出力はX[k]/N(dbg_comのfftと同じ換算)
+            double snr = fft_snr_db_q15(s_ref_re, s_ref_im, s_q15, n, (double)n / 32767.0);
+            if (snr < SNR_MIN_Q15(log2n)) {
+                printf("  q15 n=%u radix=%d SNR %.1f dB\n", n, radix, snr);
+            }
+            HT_CHECK(snr >= SNR_MIN_Q15(log2n));
+        }
+    }
+}
+
+static void test_snr_f32_real(void)
+{
+    for (uint32_t log2n = FFT_MIN_LOG2N; log2n <= FFT_MAX_LOG2N; log2n++)
+    {
+        uint32_t n = 1UL << log2n;
+        make_signal(n);
+        make_ref(log2n);
+        fft_f32_real(s_sig, s_f32, log2n);
+        double snr = fft_snr_db_f32(s_ref_re, s_ref_im, s_f32, n / 2 + 1);
+        if (snr < SNR_MIN_F32_REAL) {
+            printf("  f32 real n=%u SNR %.1f dB\n", n, snr);
+        }
+        HT_CHECK(snr >= SNR_MIN_F32_REAL);
+    }
+}
+
+// インパルスは全ビンが1、基数2と基数4は同じ結果
+static void test_impulse(void)
+{
+    uint32_t log2n = 9;
+    uint32_t n = 1UL << log2n;
+    static fft_cpx_f32_t s_r2[FFT_MAX_N];
+
+    memset(s_f32, 0, sizeof(s_f32));
+    s_f32[0].re = 1.0f;
+    fft_f32(s_f32, log2n, FFT_RADIX_4);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        HT_CHECK(fabsf(s_f32[i].re - 1.0f) < 1e-6f && fabsf(s_f32[i].im) < 1e-6f);
+    }
+
+    make_signal(n);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        s_f32[i].re = s_sig[i];
+        s_f32[i].im = s_sig[n - 1 - i];
+        s_r2[i] = s_f32[i];
+    }
+    fft_f32(s_f32, log2n, FFT_RADIX_4);
+    fft_f32(s_r2, log2n, FFT_RADIX_2);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        HT_CHECK(fabsf(s_f32[i].re - s_r2[i].re) < 1e-4f && fabsf(s_f32[i].im - s_r2[i].im) < 1e-4f);
+    }
+}
+
+int main(void)
+{
+    fft_init();
+    ht_srand(0xF0F7u);
+
+    HT_RUN(test_snr_f32);
+    HT_RUN(test_snr_q15);
+    HT_RUN(test_snr_f32_real);
+    HT_RUN(test_impulse);
+
+    return HT_RESULT();
+}
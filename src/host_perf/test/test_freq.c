@@ -0,0 +1,185 @@
+/**
+ * @file test_freq.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief freq.cのテスト(Welford法の統計、エッジ数の集計と折り返し、パルス幅の集計)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "freq.h"
+#include <math.h>
+
+#define SNAP_NUM        1001
+#define RAW_NUM         512
+#define SM_HZ           150000000.0
+
+static uint32_t s_snap[SNAP_NUM];
+static uint32_t s_raw[RAW_NUM];
+
+static bool is_near(double a, double b, double tol)
+{
+    return fabs(a - b) <= tol * fmax(1.0, fabs(b));
+}
+
+// 大きな値に小さなばらつきが乗っても、2パスで求めた値と合う
+static void test_stat(void)
+{
+    static double s_value[2000];
+    freq_stat_t stat;
+    double sum = 0.0;
+    double sq = 0.0;
+
+    freq_stat_clear(&stat);
+    HT_CHECK(freq_stat_std(&stat) == 0.0);
+    freq_stat_add(&stat, 7.0);
+    HT_CHECK(freq_stat_std(&stat) == 0.0);
+    HT_CHECK(stat.min == 7.0 && stat.max == 7.0 && stat.mean == 7.0);
+
+    freq_stat_clear(&stat);
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        s_value[i] = 1.0e9 + (double)ht_rand_below(1000) * 0.001;
+        freq_stat_add(&stat, s_value[i]);
+        sum += s_value[i];
+    }
+    double mean = sum / 2000;
+    double min = s_value[0];
+    double max = s_value[0];
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        sq += (s_value[i] - mean) * (s_value[i] - mean);
+        min = fmin(min, s_value[i]);
+        max = fmax(max, s_value[i]);
+    }
+    HT_EQ(stat.num, 2000);
+    HT_CHECK(is_near(stat.mean, mean, 1e-12));
+    HT_CHECK(fabs(freq_stat_std(&stat) - sqrt(sq / 2000)) < 1e-6);
+    HT_CHECK(stat.min == min && stat.max == max);
+
+    // 負の値も最小と最大に入る
+    freq_stat_clear(&stat);
+    freq_stat_add(&stat, -3.0);
+    freq_stat_add(&stat, 5.0);
+    HT_CHECK(stat.min == -3.0 && stat.max == 5.0 && stat.mean == 1.0);
+    HT_CHECK(freq_stat_std(&stat) == 4.0);
+}
+
+// xは立ち上がりごとに減り、途中で32bitの0をまたぐ
+static void test_count(void)
+{
+    static uint32_t s_edges[SNAP_NUM];
+    const double tick_s = 0.001;
+    const uint32_t ticks_per_gate = 100;
+    freq_count_result_t result;
+    uint64_t total = 0;
+    uint32_t x = 250000;
+
+    s_snap[0] = x;
+    for (uint32_t i = 1; i < SNAP_NUM; i++)
+    {
+        // 1MHz前後(1msに1000±3エッジ)
+        s_edges[i] = 997 + ht_rand_below(7);
+        x -= s_edges[i];
+        s_snap[i] = x;
+        total += s_edges[i];
+    }
+    HT_CHECK(s_snap[SNAP_NUM - 1] > s_snap[0]);         // 折り返している
+
+    freq_count_analyze(s_snap, SNAP_NUM, ticks_per_gate, tick_s, &result);
+    HT_EQ(result.edges, total);
+    HT_CHECK(is_near(result.window_s, 1.0, 1e-12));
+    HT_CHECK(is_near(result.gate_s, 0.1, 1e-12));
+    HT_CHECK(is_near(result.freq_hz, (double)total, 1e-12));
+    HT_EQ(result.gates, 10);
+    HT_EQ(result.gate_hz.num, 10);
+
+    // ゲートごとの周波数(最後の余りは使わない)
+    double min = 1e30;
+    double max = 0.0;
+    double sum = 0.0;
+    for (uint32_t g = 0; g < 10; g++)
+    {
+        uint32_t edges = 0;
+        for (uint32_t i = g * ticks_per_gate + 1; i <= (g + 1) * ticks_per_gate; i++)
+        {
+            edges += s_edges[i];
+        }
+        double hz = edges / 0.1;
+        min = fmin(min, hz);
+        max = fmax(max, hz);
+        sum += hz;
+    }
+    HT_CHECK(is_near(result.gate_hz.mean, sum / 10, 1e-12));
+    HT_CHECK(is_near(result.gate_hz.min, min, 1e-12));
+    HT_CHECK(is_near(result.gate_hz.max, max, 1e-12));
+
+    // 余りが出るゲート数、1ゲートより短いとゲートは0
+    freq_count_analyze(s_snap, 350, ticks_per_gate, tick_s, &result);
+    HT_EQ(result.gates, 3);
+    freq_count_analyze(s_snap, 50, ticks_per_gate, tick_s, &result);
+    HT_EQ(result.gates, 0);
+    HT_CHECK(result.freq_hz > 0.0);
+
+    freq_count_analyze(s_snap, 1, ticks_per_gate, tick_s, &result);
+    HT_EQ(result.edges, 0);
+    HT_CHECK(result.freq_hz == 0.0);
+    freq_count_analyze(s_snap, SNAP_NUM, 0, tick_s, &result);
+    HT_EQ(result.edges, 0);
+}
+
+static void test_pulse_cycles(void)
+{
+    // 1周期の命令数 = 2*(H回数+L回数)+5
+    HT_EQ(freq_pulse_cycles(~0u, true), FREQ_PULSE_HIGH_OFFSET);
+    HT_EQ(freq_pulse_cycles(~0u, false), FREQ_PULSE_LOW_OFFSET);
+    HT_EQ(freq_pulse_cycles(~10u, true) + freq_pulse_cycles(~20u, false), 2 * (10 + 20) + 5);
+}
+
+// ループ回数から作った生データで、周波数とデューティと周期ごとのばらつき
+static void test_pulse(void)
+{
+    const double cycle_s = 1.0 / SM_HZ;
+    freq_pulse_result_t result;
+
+    // 1kHz、デューティ25%(H 37500、L 112500サイクル)
+    s_raw[0] = ~123u;       // 途中から始まったH
+    s_raw[1] = ~999u;       // Hと組にならないL
+    for (uint32_t i = 2; i < RAW_NUM; i += 2)
+    {
+        s_raw[i] = ~((37500u - FREQ_PULSE_HIGH_OFFSET) / 2);
+        s_raw[i + 1] = ~((112500u - FREQ_PULSE_LOW_OFFSET) / 2 + (i / 2) % 2);
+    }
+    freq_pulse_analyze(s_raw, RAW_NUM, cycle_s, &result);
+    HT_EQ(result.periods, RAW_NUM / 2 - 1);
+    HT_CHECK(is_near(result.resolution_s, 2.0 / SM_HZ, 1e-12));
+    HT_CHECK(is_near(result.freq_hz, 1000.0, 1e-5));
+    HT_CHECK(is_near(result.duty, 0.25, 1e-5));
+    HT_CHECK(is_near(result.high.mean, 37500 / SM_HZ, 1e-12));
+    HT_CHECK(freq_stat_std(&result.high) == 0.0);
+    // Lは1ループずつ交互にずらした(112499と112501サイクル)
+    HT_CHECK(is_near(result.low.min, 112499 / SM_HZ, 1e-12));
+    HT_CHECK(is_near(result.low.max, 112501 / SM_HZ, 1e-12));
+    HT_CHECK(is_near(freq_stat_std(&result.period), 1.0 / SM_HZ, 1e-3));
+
+    // 奇数個なら最後のHは捨てる、組が無ければ0
+    freq_pulse_analyze(s_raw, 7, cycle_s, &result);
+    HT_EQ(result.periods, 2);
+    freq_pulse_analyze(s_raw, 3, cycle_s, &result);
+    HT_EQ(result.periods, 0);
+    HT_CHECK(result.freq_hz == 0.0 && result.duty == 0.0);
+}
+
+int main(void)
+{
+    ht_srand(0xF4E9u);
+
+    HT_RUN(test_stat);
+    HT_RUN(test_count);
+    HT_RUN(test_pulse_cycles);
+    HT_RUN(test_pulse);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_gpio_bench.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief gpio_bench.cのテスト(ピンの指定の解釈、書き込み回数の丸め、結果の表の固定小数点の表示)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※表の1行はstdoutを一時ファイルに向けて取り出し、文字列で比べる
+ */
+#include "host_test.h"
+#include "gpio_bench.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ROW_BUF_SIZE        256
+#define ROW_PREFIX_LEN      (2 + 10 + 1 + 30 + 1)   // "  %-10s %-30s "
+#define SYS_HZ              150000000UL
+
+static bool parse_ok(const char *p_str, uint32_t mask)
+{
+    uint32_t got = 0;
+
+    return gpio_bench_parse_pins(p_str, &got) && got == mask;
+}
+
+static bool parse_ng(const char *p_str)
+{
+    uint32_t got = 0;
+
+    return !gpio_bench_parse_pins(p_str, &got);
+}
+
+// 【ピンの指定】1ピン、範囲、#HEXのマスク、不正な指定
+static void test_parse_pins(void)
+{
+    HT_CHECK(parse_ok("0", 0x00000001UL));
+    HT_CHECK(parse_ok("31", 0x80000000UL));
+    HT_CHECK(parse_ok("0-31", 0xFFFFFFFFUL));
+    HT_CHECK(parse_ok("3-5", 0x00000038UL));
+    HT_CHECK(parse_ok("7-7", 0x00000080UL));
+    HT_CHECK(parse_ok("#1F", 0x0000001FUL));
+    HT_CHECK(parse_ok("#ffffffff", 0xFFFFFFFFUL));
+
+    HT_CHECK(parse_ng("5-3"));      // 逆順
+    HT_CHECK(parse_ng("#0"));       // ピンが無い
+    HT_CHECK(parse_ng("#"));
+    HT_CHECK(parse_ng("32"));       // GPIO_BENCH_PIN_MAXを超える
+    HT_CHECK(parse_ng("0-32"));
+    HT_CHECK(parse_ng(""));
+    HT_CHECK(parse_ng("-1"));
+    HT_CHECK(parse_ng("3-"));
+    // 後ろにゴミ
+    HT_CHECK(parse_ng("3x"));
+    HT_CHECK(parse_ng("3 "));
+    HT_CHECK(parse_ng("3-5x"));
+    HT_CHECK(parse_ng("3-5-7"));
+    HT_CHECK(parse_ng("#1Fz"));
+}
+
+// 【書き込み回数の丸め】GPIO_BENCH_UNROLLの倍数、1～GPIO_BENCH_WRITES_MAX
+static void test_round_writes(void)
+{
+    HT_EQ(gpio_bench_round_writes(0), GPIO_BENCH_UNROLL);
+    HT_EQ(gpio_bench_round_writes(1), GPIO_BENCH_UNROLL);
+    HT_EQ(gpio_bench_round_writes(GPIO_BENCH_UNROLL - 1), GPIO_BENCH_UNROLL);
+    HT_EQ(gpio_bench_round_writes(GPIO_BENCH_UNROLL), GPIO_BENCH_UNROLL);
+    HT_EQ(gpio_bench_round_writes(GPIO_BENCH_UNROLL * 2 - 1), GPIO_BENCH_UNROLL);
+    HT_EQ(gpio_bench_round_writes(GPIO_BENCH_WRITES_DEF + 1), GPIO_BENCH_WRITES_DEF);
+    HT_EQ(gpio_bench_round_writes(GPIO_BENCH_WRITES_MAX), GPIO_BENCH_WRITES_MAX);
+    HT_EQ(gpio_bench_round_writes(GPIO_BENCH_WRITES_MAX + 1), GPIO_BENCH_WRITES_MAX);
+    HT_EQ(gpio_bench_round_writes(UINT32_MAX), GPIO_BENCH_WRITES_MAX);
+    HT_EQ(GPIO_BENCH_WRITES_MAX % GPIO_BENCH_UNROLL, 0);
+}
+
+// 表の1行をstdoutから取り出す(方式名と説明の列は除く)
+static const char *capture_row(gpio_bench_method_t method, const gpio_bench_result_t *p_result, uint32_t sys_hz)
+{
+    static char s_buf[ROW_BUF_SIZE];
+    FILE *p_fp = tmpfile();
+    size_t len = 0;
+
+    s_buf[0] = '\0';
+    if (p_fp == NULL) {
+        return s_buf;
+    }
+
+    fflush(stdout);
+    int saved_fd = dup(STDOUT_FILENO);
+    dup2(fileno(p_fp), STDOUT_FILENO);
+    gpio_bench_report_row(method, p_result, sys_hz);
+    fflush(stdout);
+    dup2(saved_fd, STDOUT_FILENO);
+    close(saved_fd);
+
+    rewind(p_fp);
+    len = fread(s_buf, 1, sizeof(s_buf) - 1, p_fp);
+    s_buf[len] = '\0';
+    fclose(p_fp);
+
+    return (len > ROW_PREFIX_LEN) ? &s_buf[ROW_PREFIX_LEN] : s_buf;
+}
+
+static bool row_is(gpio_bench_method_t method, bool is_valid, const char *p_note, uint32_t writes,
+                   uint32_t cycles, uint32_t sys_hz, const char *p_expect)
+{
+    gpio_bench_result_t result = {is_valid, p_note, writes, cycles};
+    const char *p_row = capture_row(method, &result, sys_hz);
+
+    if (strcmp(p_row, p_expect) != 0) {
+        printf("    row: \"%s\" expect \"%s\"\n", p_row, p_expect);
+        return false;
+    }
+    return true;
+}
+
+// 【結果の表】cyc/writeは小数2桁(四捨五入)、ns/writeは1桁と、トグル周波数は3桁(切り捨て)
+static void test_report_row(void)
+{
+    // 2サイクル/回 @150MHz = 13.3ns、37.5MHz
+    HT_CHECK(row_is(GPIO_BENCH_SIO_SC, true, NULL, 8192, 16384, SYS_HZ,
+                    "     16384       2.00      13.3       37.500\n"));
+    // 1サイクル/回(PIOのside-set) = 6.7ns、75MHz
+    HT_CHECK(row_is(GPIO_BENCH_PIO_SIDE, true, NULL, 8192, 8192, SYS_HZ,
+                    "      8192       1.00       6.7       75.000\n"));
+    // 0.375 → 0.38、2.5ns、200MHz
+    HT_CHECK(row_is(GPIO_BENCH_GPIOC_XOR, true, NULL, 8, 3, SYS_HZ,
+                    "         3       0.38       2.5      200.000\n"));
+    // 端数のある値(10.50サイクル/回 = 70.0ns、7.142MHz)
+    HT_CHECK(row_is(GPIO_BENCH_PUT, true, NULL, 8, 84, SYS_HZ,
+                    "        84      10.50      70.0        7.142\n"));
+    // 最大のサイクル数でも溢れない
+    HT_CHECK(row_is(GPIO_BENCH_SIO_XOR, true, NULL, GPIO_BENCH_UNROLL, UINT32_MAX, SYS_HZ,
+                    "4294967295 536870911.88 3579139412.5        0.000\n"));
+
+    // 計測できなかった方式
+    HT_CHECK(row_is(GPIO_BENCH_GPIOC_SC, false, "no GPIO coprocessor", 0, 0, SYS_HZ,
+                    "n/a (no GPIO coprocessor)\n"));
+    HT_CHECK(row_is(GPIO_BENCH_GPIOC_SC, false, NULL, 8192, 100, SYS_HZ, "n/a (not measured)\n"));
+    HT_CHECK(row_is(GPIO_BENCH_PUT, true, NULL, 8192, 0, SYS_HZ, "n/a (not measured)\n"));
+    HT_CHECK(row_is(GPIO_BENCH_PUT, true, NULL, 0, 100, SYS_HZ, "n/a (not measured)\n"));
+    HT_CHECK(row_is(GPIO_BENCH_PUT, true, NULL, 8192, 100, 0, "n/a (not measured)\n"));
+}
+
+int main(void)
+{
+    HT_RUN(test_parse_pins);
+    HT_RUN(test_round_writes);
+    HT_RUN(test_report_row);
+
+    return HT_RESULT();
+}
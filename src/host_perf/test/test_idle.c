@@ -0,0 +1,200 @@
+/**
+ * @file test_idle.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief idle.cのテスト(滞在時間、寝ている最中の集計、起床レイテンシとimmediate、乱数の比較)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "idle.h"
+#include <math.h>
+#include <string.h>
+
+#define RAND_ROUNDS     5000
+
+static idle_core_t s_core;
+
+static void test_sleep(void)
+{
+    idle_report_t report;
+
+    idle_core_clear(&s_core, 1000);
+    idle_report(&s_core, 1000, &report);
+    HT_EQ(report.elapsed, 0);
+    HT_CHECK(report.residency == 0.0);
+    HT_CHECK(report.avg_sleep == 0.0);
+
+    // 1000～1100動き、1100～1400寝る、1400～1500動き、1500～1600寝る
+    idle_enter(&s_core, 1100);
+    idle_exit(&s_core, 1400, IDLE_WAKE_UART, 0);
+    idle_enter(&s_core, 1500);
+    idle_exit(&s_core, 1600, IDLE_WAKE_TIMER, 0);
+    idle_report(&s_core, 2000, &report);
+    HT_EQ(report.elapsed, 1000);
+    HT_EQ(report.sleep, 400);
+    HT_EQ(report.active, 600);
+    HT_CHECK(report.residency == 0.4);
+    HT_CHECK(report.avg_sleep == 200.0);
+    HT_EQ(s_core.sleeps, 2);
+    HT_EQ(s_core.max_sleep, 300);
+    HT_EQ(s_core.wakes[IDLE_WAKE_UART], 1);
+    HT_EQ(s_core.wakes[IDLE_WAKE_TIMER], 1);
+    HT_EQ(s_core.wake_lat.total, 0);
+
+    // 寝ている最中に読めば今までの分を足す(回数と平均はまだ変えない)
+    idle_enter(&s_core, 2000);
+    idle_report(&s_core, 2500, &report);
+    HT_EQ(report.sleep, 900);
+    HT_EQ(report.active, 600);
+    HT_CHECK(report.avg_sleep == 200.0);
+    HT_CHECK(s_core.is_sleeping);
+
+    // 起きていないのにidle_exit()は数えない、範囲外の理由はother
+    idle_exit(&s_core, 2600, IDLE_WAKE_NUM, 0);
+    HT_EQ(s_core.wakes[IDLE_WAKE_OTHER], 1);
+    idle_exit(&s_core, 2700, IDLE_WAKE_FIFO, 0);
+    HT_EQ(s_core.sleeps, 3);
+    HT_EQ(s_core.wakes[IDLE_WAKE_FIFO], 0);
+    HT_EQ(s_core.sleep_ticks, 1000);
+
+    // クリアすれば記録も開始時刻も新しくなる
+    idle_core_clear(&s_core, 5000);
+    idle_report(&s_core, 5100, &report);
+    HT_EQ(report.elapsed, 100);
+    HT_EQ(report.sleep, 0);
+    HT_EQ(s_core.sleeps, 0);
+    HT_CHECK(!s_core.is_sleeping);
+}
+
+// 【起床レイテンシ】
+// 寝た後の通知は通知から再開までをヒストグラムに、寝る前の通知はimmediateに数える
+static void test_wake_lat(void)
+{
+    idle_core_clear(&s_core, 0);
+
+    idle_enter(&s_core, 100);
+    idle_exit(&s_core, 250, IDLE_WAKE_FIFO, 230);
+    HT_EQ(s_core.wake_lat.total, 1);
+    HT_EQ(s_core.wake_lat.min, 20);
+
+    // 寝る前の通知(WFEがすぐ戻った)
+    idle_enter(&s_core, 300);
+    idle_exit(&s_core, 302, IDLE_WAKE_USB, 299);
+    HT_EQ(s_core.immediate, 1);
+    HT_EQ(s_core.wake_lat.total, 1);
+
+    // 寝た時刻ちょうどの通知はレイテンシに入れる
+    idle_enter(&s_core, 400);
+    idle_exit(&s_core, 410, IDLE_WAKE_USB, 400);
+    HT_EQ(s_core.wake_lat.total, 2);
+    HT_EQ(s_core.wake_lat.min, 10);
+
+    // 未来の通知(読む順がずれた)と通知無しは数えない
+    idle_enter(&s_core, 500);
+    idle_exit(&s_core, 510, IDLE_WAKE_TIMER, 520);
+    idle_enter(&s_core, 600);
+    idle_exit(&s_core, 610, IDLE_WAKE_OTHER, 0);
+    HT_EQ(s_core.wake_lat.total, 2);
+    HT_EQ(s_core.immediate, 1);
+    HT_EQ(s_core.sleeps, 5);
+
+    // 32bitを越えるレイテンシは上限に張り付く
+    idle_enter(&s_core, 1000);
+    idle_exit(&s_core, 0x200000000ULL, IDLE_WAKE_TIMER, 1000);
+    HT_EQ(s_core.wake_lat.max, UINT32_MAX);
+    HT_EQ(s_core.max_sleep, 0x200000000ULL - 1000);
+}
+
+static void test_names(void)
+{
+    HT_CHECK(strcmp(idle_wake_name(IDLE_WAKE_FIFO), "fifo") == 0);
+    HT_CHECK(strcmp(idle_wake_name(IDLE_WAKE_OTHER), "other") == 0);
+    HT_CHECK(strcmp(idle_wake_name(IDLE_WAKE_NUM), "?") == 0);
+}
+
+// 【乱数の比較】
+// 動く、寝る、通知を乱数の長さで繰り返し、別に数えた合計と比べる
+static void test_random(void)
+{
+    idle_report_t report;
+    uint64_t now = 0x123456789ULL;
+    uint64_t sleep = 0;
+    uint64_t max_sleep = 0;
+    uint32_t immediate = 0;
+    uint32_t lat_num = 0;
+    uint64_t lat_sum = 0;
+    uint32_t wakes[IDLE_WAKE_NUM] = {0};
+    uint64_t since = now;
+
+    idle_core_clear(&s_core, now);
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint64_t notify_at = 0;
+        idle_wake_t reason = (idle_wake_t)ht_rand_below(IDLE_WAKE_NUM);
+
+        now += ht_rand_below(1000);
+        if (ht_rand_below(8) == 0) {
+            notify_at = now - ht_rand_below(50);
+        }
+        uint64_t enter_at = now;
+        idle_enter(&s_core, now);
+
+        // 寝ている最中に他のコアから読む
+        if (ht_rand_below(4) == 0) {
+            uint64_t peek = now + ht_rand_below(100);
+            idle_report(&s_core, peek, &report);
+            HT_EQ(report.sleep, sleep + (peek - enter_at));
+        }
+
+        now += 1 + ht_rand_below(5000);
+        if (notify_at == 0 && reason != IDLE_WAKE_OTHER) {
+            notify_at = now - ht_rand_below((uint32_t)(now - enter_at) + 1);
+        }
+        idle_exit(&s_core, now, reason, notify_at);
+
+        uint64_t slept = now - enter_at;
+        sleep += slept;
+        if (slept > max_sleep) {
+            max_sleep = slept;
+        }
+        wakes[reason]++;
+        if (notify_at != 0 && notify_at < enter_at) {
+            immediate++;
+        } else if (notify_at != 0) {
+            lat_num++;
+            lat_sum += now - notify_at;
+        }
+    }
+
+    now += 777;
+    idle_report(&s_core, now, &report);
+    HT_EQ(report.elapsed, now - since);
+    HT_EQ(report.sleep, sleep);
+    HT_EQ(report.active, now - since - sleep);
+    HT_CHECK(fabs(report.residency - (double)sleep / (double)(now - since)) < 1e-12);
+    HT_CHECK(fabs(report.avg_sleep - (double)sleep / RAND_ROUNDS) < 1e-9);
+    HT_EQ(s_core.sleeps, RAND_ROUNDS);
+    HT_EQ(s_core.max_sleep, max_sleep);
+    HT_EQ(s_core.immediate, immediate);
+    HT_EQ(s_core.wake_lat.total, lat_num);
+    HT_EQ(s_core.wake_lat.sum, lat_sum);
+    for (uint32_t i = 0; i < IDLE_WAKE_NUM; i++)
+    {
+        HT_EQ(s_core.wakes[i], wakes[i]);
+    }
+}
+
+int main(void)
+{
+    ht_srand(0x1D1Eu);
+
+    HT_RUN(test_sleep);
+    HT_RUN(test_wake_lat);
+    HT_RUN(test_names);
+    HT_RUN(test_random);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,417 @@
+/**
+ * @file test_init_graph.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief init_graph.cのテスト(表の検査、依存の順、コアの指定、遅延初期化、2スレッドで乱数の表)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※2つのコアはpthreadのスレッドで模擬する(test_init_graph_tsanはThreadSanitizerで実行)
+ * ※タスクは依存先が書いた初期化の結果を普通の変数で読む(ロックで順序が付いていなければTSanが見つける)
+ */
+#include "host_test.h"
+#include "init_graph.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define THREAD_ROUNDS   200
+#define REQUIRE_NUM     8
+
+static init_task_t s_tbl[INIT_GRAPH_TASK_MAX];
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t s_now;                      // ロックの中で進める時刻
+static __thread uint32_t s_core;            // タスクを実行しているコア(スレッド)
+
+// タスクの記録(実行回数と順番はアトミック、初期化の結果は普通の変数)
+static uint32_t s_exec[INIT_GRAPH_TASK_MAX];
+static uint32_t s_order[INIT_GRAPH_TASK_MAX];
+static uint32_t s_order_num;
+static uint32_t s_result[INIT_GRAPH_TASK_MAX];
+static uint32_t s_bad;                      // タスクの中で見つけた不一致
+
+static uint32_t test_lock(void)
+{
+    pthread_mutex_lock(&s_mutex);
+    return 0;
+}
+
+static void test_unlock(uint32_t save)
+{
+    (void)save;
+    pthread_mutex_unlock(&s_mutex);
+}
+
+static uint32_t test_now_us(void)
+{
+    return ++s_now;
+}
+
+static void test_wait(void)
+{
+    sched_yield();      // 他のコアのタスクを待つ(CPUが1つでも回す)
+}
+
+static const init_graph_ops_t s_ops = {test_lock, test_unlock, test_now_us, test_wait};
+
+// タスクの本体: 依存先の結果が見えているか、実行してよいコアかを確かめて結果を書く
+static void task_body(uint32_t id)
+{
+    uint32_t deps = s_tbl[id].deps;
+
+    for (uint32_t dep = 0; deps != 0; dep++, deps >>= 1)
+    {
+        if ((deps & 1) != 0 && s_result[dep] != dep + 1) {
+            __atomic_fetch_add(&s_bad, 1, __ATOMIC_RELAXED);
+        }
+    }
+    if ((s_tbl[id].core_mask & (1U << s_core)) == 0) {
+        __atomic_fetch_add(&s_bad, 1, __ATOMIC_RELAXED);
+    }
+
+    uint32_t n = __atomic_fetch_add(&s_order_num, 1, __ATOMIC_RELAXED);
+    if (n < INIT_GRAPH_TASK_MAX) {
+        s_order[n] = id;
+    }
+    __atomic_fetch_add(&s_exec[id], 1, __ATOMIC_RELAXED);
+    s_result[id] = id + 1;
+}
+
+#define TASK_FUNC(n)    static void task_##n(void) { task_body(n); }
+TASK_FUNC(0)  TASK_FUNC(1)  TASK_FUNC(2)  TASK_FUNC(3)  TASK_FUNC(4)  TASK_FUNC(5)  TASK_FUNC(6)  TASK_FUNC(7)
+TASK_FUNC(8)  TASK_FUNC(9)  TASK_FUNC(10) TASK_FUNC(11) TASK_FUNC(12) TASK_FUNC(13) TASK_FUNC(14) TASK_FUNC(15)
+TASK_FUNC(16) TASK_FUNC(17) TASK_FUNC(18) TASK_FUNC(19) TASK_FUNC(20) TASK_FUNC(21) TASK_FUNC(22) TASK_FUNC(23)
+TASK_FUNC(24) TASK_FUNC(25) TASK_FUNC(26) TASK_FUNC(27) TASK_FUNC(28) TASK_FUNC(29) TASK_FUNC(30) TASK_FUNC(31)
+
+static void (*const s_task_func[INIT_GRAPH_TASK_MAX])(void) = {
+    task_0,  task_1,  task_2,  task_3,  task_4,  task_5,  task_6,  task_7,
+    task_8,  task_9,  task_10, task_11, task_12, task_13, task_14, task_15,
+    task_16, task_17, task_18, task_19, task_20, task_21, task_22, task_23,
+    task_24, task_25, task_26, task_27, task_28, task_29, task_30, task_31,
+};
+
+static const char *const s_task_name[INIT_GRAPH_TASK_MAX] = {
+    "t0",  "t1",  "t2",  "t3",  "t4",  "t5",  "t6",  "t7",
+    "t8",  "t9",  "t10", "t11", "t12", "t13", "t14", "t15",
+    "t16", "t17", "t18", "t19", "t20", "t21", "t22", "t23",
+    "t24", "t25", "t26", "t27", "t28", "t29", "t30", "t31",
+};
+
+static void tbl_set(uint32_t id, uint32_t deps, uint8_t core_mask, bool is_deferred)
+{
+    s_tbl[id].p_name = s_task_name[id];
+    s_tbl[id].p_func = s_task_func[id];
+    s_tbl[id].deps = deps;
+    s_tbl[id].core_mask = core_mask;
+    s_tbl[id].is_deferred = is_deferred;
+}
+
+static void record_clear(void)
+{
+    memset(s_exec, 0, sizeof(s_exec));
+    memset(s_order, 0, sizeof(s_order));
+    memset(s_result, 0, sizeof(s_result));
+    s_order_num = 0;
+    s_bad = 0;
+    s_now = 0;
+    s_core = 0;
+}
+
+// 【表の検査】範囲外、自分自身、循環、起動時のタスクが遅延タスクに依存、関数無し、コア無し
+static void test_invalid(void)
+{
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        tbl_set(i, 0, INIT_GRAPH_CORE_ANY, false);
+    }
+    HT_CHECK(init_graph_init(s_tbl, 4, &s_ops));
+    HT_CHECK(init_graph_init(s_tbl, 0, &s_ops));
+    HT_CHECK(!init_graph_init(s_tbl, INIT_GRAPH_TASK_MAX + 1, &s_ops));
+
+    s_tbl[1].deps = INIT_GRAPH_DEP(4);
+    HT_CHECK(!init_graph_init(s_tbl, 4, &s_ops));
+    s_tbl[1].deps = INIT_GRAPH_DEP(1);
+    HT_CHECK(!init_graph_init(s_tbl, 4, &s_ops));
+
+    // 0→1→2→0
+    s_tbl[0].deps = INIT_GRAPH_DEP(2);
+    s_tbl[1].deps = INIT_GRAPH_DEP(0);
+    s_tbl[2].deps = INIT_GRAPH_DEP(1);
+    HT_CHECK(!init_graph_init(s_tbl, 4, &s_ops));
+    s_tbl[0].deps = 0;
+    HT_CHECK(init_graph_init(s_tbl, 4, &s_ops));
+
+    s_tbl[3].deps = INIT_GRAPH_DEP(2);
+    s_tbl[2].is_deferred = true;
+    HT_CHECK(!init_graph_init(s_tbl, 4, &s_ops));
+    s_tbl[3].is_deferred = true;
+    HT_CHECK(init_graph_init(s_tbl, 4, &s_ops));
+
+    s_tbl[3].p_func = NULL;
+    HT_CHECK(!init_graph_init(s_tbl, 4, &s_ops));
+    s_tbl[3].p_func = task_3;
+    s_tbl[3].core_mask = 0;
+    HT_CHECK(!init_graph_init(s_tbl, 4, &s_ops));
+
+    // 32個全部(依存のマスクが全ビット)
+    for (uint32_t i = 0; i < INIT_GRAPH_TASK_MAX; i++)
+    {
+        tbl_set(i, (i > 0) ? INIT_GRAPH_DEP(i - 1) : 0, INIT_GRAPH_CORE_ANY, false);
+    }
+    HT_CHECK(init_graph_init(s_tbl, INIT_GRAPH_TASK_MAX, &s_ops));
+    s_tbl[0].deps = INIT_GRAPH_DEP(INIT_GRAPH_TASK_MAX - 1);
+    HT_CHECK(!init_graph_init(s_tbl, INIT_GRAPH_TASK_MAX, &s_ops));
+}
+
+// 【依存の順と遅延初期化】
+// 0 ← 1,2 ← 3(ひし形)を起動時、3 ← 4 ← 5を遅延にして1コアで実行する
+static void test_order(void)
+{
+    init_task_stat_t st;
+
+    record_clear();
+    tbl_set(3, INIT_GRAPH_DEP(1) | INIT_GRAPH_DEP(2), INIT_GRAPH_CORE_ANY, false);
+    tbl_set(2, INIT_GRAPH_DEP(0), INIT_GRAPH_CORE_ANY, false);
+    tbl_set(1, INIT_GRAPH_DEP(0), INIT_GRAPH_CORE_ANY, false);
+    tbl_set(0, 0, INIT_GRAPH_CORE_ANY, false);
+    tbl_set(4, INIT_GRAPH_DEP(3), INIT_GRAPH_CORE_ANY, true);
+    tbl_set(5, INIT_GRAPH_DEP(4), INIT_GRAPH_CORE_ANY, true);
+    HT_CHECK(init_graph_init(s_tbl, 6, &s_ops));
+    HT_EQ(init_graph_num(), 6);
+    HT_CHECK(!init_graph_is_boot_done());
+
+    init_graph_run(0);
+    HT_CHECK(init_graph_is_boot_done());
+    HT_EQ(s_order_num, 4);
+    HT_EQ(s_order[0], 0);
+    HT_EQ(s_order[3], 3);
+    HT_CHECK(!init_graph_is_done(4));
+    HT_CHECK(!init_graph_is_done(5));
+    init_graph_get_stat(4, &st);
+    HT_EQ(st.state, INIT_TASK_PENDING);
+
+    // 遅延タスクは依存先から実行し、2回目は実行しない
+    HT_CHECK(init_graph_require(5, 0));
+    HT_EQ(s_order_num, 6);
+    HT_EQ(s_order[4], 4);
+    HT_EQ(s_order[5], 5);
+    HT_CHECK(init_graph_require(5, 1));
+    HT_CHECK(init_graph_require(0, 0));
+    HT_EQ(s_order_num, 6);
+    HT_CHECK(!init_graph_require(6, 0));
+    HT_CHECK(!init_graph_is_done(6));
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        HT_EQ(s_exec[i], 1);
+        init_graph_get_stat(i, &st);
+        HT_EQ(st.state, INIT_TASK_DONE);
+        HT_EQ(st.core, 0);
+        HT_CHECK(st.start_us < st.end_us);
+    }
+    HT_EQ(s_bad, 0);
+
+    HT_EQ(init_graph_find("t4"), 4);
+    HT_EQ(init_graph_find("t6"), -1);
+    HT_CHECK(init_graph_task(5) == &s_tbl[5]);
+    HT_CHECK(init_graph_task(6) == NULL);
+}
+
+// 【コアの指定】
+// 他のコアのタスクはinit_graph_run()で飛ばし、init_graph_require()はfalseで状態を変えない
+static void test_core_mask(void)
+{
+    init_task_stat_t st;
+
+    record_clear();
+    tbl_set(0, 0, INIT_GRAPH_CORE(1), false);
+    tbl_set(1, 0, INIT_GRAPH_CORE(0), false);
+    tbl_set(2, INIT_GRAPH_DEP(1), INIT_GRAPH_CORE(1), true);
+    tbl_set(3, INIT_GRAPH_DEP(2), INIT_GRAPH_CORE_ANY, true);
+    HT_CHECK(init_graph_init(s_tbl, 4, &s_ops));
+
+    init_graph_run(0);
+    HT_EQ(s_exec[0], 0);
+    HT_EQ(s_exec[1], 1);
+    HT_CHECK(!init_graph_is_boot_done());
+
+    // 依存先(2)がこのコアで実行できなければ、3も実行しない
+    HT_CHECK(!init_graph_require(3, 0));
+    HT_CHECK(!init_graph_require(2, 0));
+    init_graph_get_stat(2, &st);
+    HT_EQ(st.state, INIT_TASK_PENDING);
+    HT_EQ(s_exec[3], 0);
+
+    s_core = 1;
+    init_graph_run(1);
+    HT_CHECK(init_graph_is_boot_done());
+    HT_CHECK(init_graph_require(3, 1));
+    init_graph_get_stat(3, &st);
+    HT_EQ(st.core, 1);
+    HT_EQ(s_exec[2] + s_exec[3], 2);
+    HT_EQ(s_bad, 0);
+}
+
+// 【2スレッドで乱数の表】
+// 依存、コア、遅延を乱数で決めた表を両方のスレッドで実行し、遅延タスクも両方から要求する
+typedef struct {
+    uint32_t core;
+    uint32_t rand;          // スレッドごとの乱数(xorshift32)
+    uint32_t bad;           // init_graph_require()の戻り値が合わなかった数
+} core_ctx_t;
+
+static uint32_t core_rand(core_ctx_t *p_ctx, uint32_t n)
+{
+    p_ctx->rand ^= p_ctx->rand << 13;
+    p_ctx->rand ^= p_ctx->rand >> 17;
+    p_ctx->rand ^= p_ctx->rand << 5;
+
+    return p_ctx->rand % n;
+}
+
+// 依存先を含めて全部このコアで実行できるか
+static bool is_runnable(uint32_t id, uint32_t core)
+{
+    uint32_t deps = s_tbl[id].deps;
+
+    if ((s_tbl[id].core_mask & (1U << core)) == 0) {
+        return false;
+    }
+    for (uint32_t dep = 0; deps != 0; dep++, deps >>= 1)
+    {
+        if ((deps & 1) != 0 && !is_runnable(dep, core)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void *core_main(void *p_arg)
+{
+    core_ctx_t *p_ctx = (core_ctx_t *)p_arg;
+
+    s_core = p_ctx->core;
+    init_graph_run(p_ctx->core);
+    for (uint32_t i = 0; i < REQUIRE_NUM; i++)
+    {
+        uint32_t id = core_rand(p_ctx, INIT_GRAPH_TASK_MAX);
+        bool is_done = init_graph_is_done(id);
+        bool is_ok = init_graph_require(id, p_ctx->core);
+
+        // 終わっていたか、依存先も全部このコアで実行できるならtrue(falseでも他のコアが実行していればtrue)
+        if (!is_ok && (is_done || is_runnable(id, p_ctx->core))) {
+            p_ctx->bad++;
+        }
+        if (is_ok && (!init_graph_is_done(id) || s_result[id] != id + 1)) {
+            p_ctx->bad++;
+        }
+    }
+
+    return NULL;
+}
+
+// 乱数の表(論理的な順に作って、表の中の並びは乱数で入れ替える)
+static void random_graph(void)
+{
+    uint32_t perm[INIT_GRAPH_TASK_MAX];
+    uint32_t deferred = 0;
+
+    for (uint32_t i = 0; i < INIT_GRAPH_TASK_MAX; i++)
+    {
+        perm[i] = i;
+    }
+    for (uint32_t i = INIT_GRAPH_TASK_MAX - 1; i > 0; i--)
+    {
+        uint32_t j = ht_rand_below(i + 1);
+        uint32_t tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+
+    for (uint32_t i = 0; i < INIT_GRAPH_TASK_MAX; i++)
+    {
+        bool is_deferred = (ht_rand_below(3) == 0);
+        uint32_t deps = 0;
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+            // 起動時のタスクは遅延タスクに依存できない
+            if (ht_rand_below(6) == 0 && (is_deferred || (deferred & INIT_GRAPH_DEP(perm[j])) == 0)) {
+                deps |= INIT_GRAPH_DEP(perm[j]);
+            }
+        }
+        tbl_set(perm[i], deps, (uint8_t)(1 + ht_rand_below(3)), is_deferred);
+        if (is_deferred) {
+            deferred |= INIT_GRAPH_DEP(perm[i]);
+        }
+    }
+}
+
+static void test_threads(void)
+{
+    pthread_t thread[INIT_GRAPH_CORE_NUM];
+    core_ctx_t ctx[INIT_GRAPH_CORE_NUM];
+    init_task_stat_t st;
+    init_task_stat_t dep_st;
+
+    for (uint32_t r = 0; r < THREAD_ROUNDS; r++)
+    {
+        record_clear();
+        random_graph();
+        HT_CHECK(init_graph_init(s_tbl, INIT_GRAPH_TASK_MAX, &s_ops));
+
+        for (uint32_t c = 0; c < INIT_GRAPH_CORE_NUM; c++)
+        {
+            ctx[c].core = c;
+            ctx[c].rand = ht_rand() | 1;
+            ctx[c].bad = 0;
+            HT_CHECK(pthread_create(&thread[c], NULL, core_main, &ctx[c]) == 0);
+        }
+        for (uint32_t c = 0; c < INIT_GRAPH_CORE_NUM; c++)
+        {
+            pthread_join(thread[c], NULL);
+            HT_EQ(ctx[c].bad, 0);
+        }
+
+        HT_CHECK(init_graph_is_boot_done());
+        HT_EQ(s_bad, 0);
+        for (uint32_t i = 0; i < INIT_GRAPH_TASK_MAX; i++)
+        {
+            uint32_t deps = s_tbl[i].deps;
+
+            // 起動時のタスクは1回、遅延タスクは要求されたものだけ1回
+            init_graph_get_stat(i, &st);
+            HT_EQ(s_exec[i], (s_tbl[i].is_deferred && st.state == INIT_TASK_PENDING) ? 0 : 1);
+            if (st.state == INIT_TASK_PENDING) {
+                HT_CHECK(s_tbl[i].is_deferred);
+                continue;
+            }
+            HT_EQ(st.state, INIT_TASK_DONE);
+            HT_CHECK((s_tbl[i].core_mask & (1U << st.core)) != 0);
+
+            // 依存先は始める前に終わっている
+            for (uint32_t dep = 0; deps != 0; dep++, deps >>= 1)
+            {
+                if ((deps & 1) != 0) {
+                    init_graph_get_stat(dep, &dep_st);
+                    HT_EQ(dep_st.state, INIT_TASK_DONE);
+                    HT_CHECK(dep_st.end_us < st.start_us);
+                }
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    ht_srand(0x16A4u);
+
+    HT_RUN(test_invalid);
+    HT_RUN(test_order);
+    HT_RUN(test_core_mask);
+    HT_RUN(test_threads);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_irq_lat.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief irq_lat.cとpio_insn.hのテスト(命令のエンコードをpioasmの出力と比較、校正と記録)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "irq_lat.h"
+#include "pio_insn.h"
+
+// 【pioasmの出力】
+// Pico SDKのblink.pio(side-setなし)とws2812.pio(.side_set 1)をpioasmで組んだ値
+static void test_insn_pioasm(void)
+{
+    // blink
+    HT_EQ(pio_insn_pull(false, true), 0x80A0);                  // pull block
+    HT_EQ(pio_insn_out(PIO_INSN_Y, 32), 0x6040);                // out y, 32
+    HT_EQ(pio_insn_mov(PIO_INSN_X, PIO_INSN_Y), 0xA022);        // mov x, y
+    HT_EQ(pio_insn_set(PIO_INSN_PINS, 1), 0xE001);              // set pins, 1
+    HT_EQ(pio_insn_jmp(PIO_INSN_JMP_X_DEC, 4), 0x0044);         // jmp x-- lp1
+    HT_EQ(pio_insn_set(PIO_INSN_PINS, 0), 0xE000);              // set pins, 0
+
+    // ws2812(side-setは1bit、ディレイは残りの4bit)
+    HT_EQ(pio_insn_side(pio_insn_delay(pio_insn_out(PIO_INSN_X, 1), 2), 1, 0), 0x6221);
+    HT_EQ(pio_insn_side(pio_insn_delay(pio_insn_jmp(PIO_INSN_JMP_NOT_X, 3), 1), 1, 1), 0x1123);
+    HT_EQ(pio_insn_side(pio_insn_delay(pio_insn_jmp(PIO_INSN_JMP_ALWAYS, 0), 4), 1, 1), 0x1400);
+    HT_EQ(pio_insn_side(pio_insn_delay(pio_insn_nop(), 4), 1, 0), 0xA442);
+}
+
+// 命令ごとのフィールド(RP2350データシートの命令表)
+static void test_insn_fields(void)
+{
+    HT_EQ(pio_insn_jmp(PIO_INSN_JMP_PIN, 7), 0x00C7);
+    HT_EQ(pio_insn_jmp(PIO_INSN_JMP_NOT_OSRE, 31), 0x00FF);
+    HT_EQ(pio_insn_jmp(PIO_INSN_JMP_ALWAYS, 32), 0x0000);       // アドレスは5bit
+    HT_EQ(pio_insn_wait_pin(false, 0), 0x2020);                 // wait 0 pin 0
+    HT_EQ(pio_insn_wait_pin(true, 0), 0x20A0);                  // wait 1 pin 0
+    HT_EQ(pio_insn_wait_gpio(true, 5), 0x2085);                 // wait 1 gpio 5
+    HT_EQ(pio_insn_in(PIO_INSN_X, 32), 0x4020);                 // in x, 32
+    HT_EQ(pio_insn_in(PIO_INSN_PINS, 1), 0x4001);
+    HT_EQ(pio_insn_out(PIO_INSN_PC, 5), 0x60A5);
+    HT_EQ(pio_insn_push(false, true), 0x8020);                  // push block
+    HT_EQ(pio_insn_push(true, true), 0x8060);                   // push iffull block
+    HT_EQ(pio_insn_pull(true, false), 0x80C0);                  // pull ifempty noblock
+    HT_EQ(pio_insn_nop(), 0xA042);
+    HT_EQ(pio_insn_mov_not(PIO_INSN_X, PIO_INSN_NULL), 0xA02B); // mov x, ~null
+    HT_EQ(pio_insn_mov(PIO_INSN_OSR, PIO_INSN_NULL), 0xA0E3);
+    HT_EQ(pio_insn_mov(PIO_INSN_X, PIO_INSN_STATUS), 0xA025);
+    HT_EQ(pio_insn_irq_set(0), 0xC000);
+    HT_EQ(pio_insn_irq_wait(3), 0xC023);
+    HT_EQ(pio_insn_irq_clear(7), 0xC047);
+    HT_EQ(pio_insn_irq_set(8), 0xC000);                         // 番号は3bit
+    HT_EQ(pio_insn_set(PIO_INSN_PINDIRS, 1), 0xE081);
+    HT_EQ(pio_insn_delay(pio_insn_nop(), PIO_INSN_DELAY_MAX), 0xBF42);
+    HT_EQ(pio_insn_delay(pio_insn_nop(), PIO_INSN_DELAY_MAX + 1), 0xA042);
+
+    // side-set 2bit(opt無し)は上位2bit、ディレイは3bitに減る
+    HT_EQ(pio_insn_side(pio_insn_nop(), 2, 3), 0xB842);
+    HT_EQ(pio_insn_side(pio_insn_nop(), 2, 4), 0xA042);
+}
+
+// どちらもpull / mov x, osr / jmp x-- (自分)で待ってからフラグかピン
+static void test_build_program(void)
+{
+    irq_lat_prog_t prog;
+
+    HT_CHECK(irq_lat_build_program(IRQ_LAT_SRC_PIO, &prog));
+    HT_EQ(prog.length, 4);
+    HT_EQ(prog.insn[0], 0x80A0);
+    HT_EQ(prog.insn[1], 0xA027);        // mov x, osr
+    HT_EQ(prog.insn[2], 0x0042);        // jmp x-- 2
+    HT_EQ(prog.insn[3], 0xC000);        // irq set 0
+    HT_EQ(prog.wrap_target, 0);
+    HT_EQ(prog.wrap, 3);
+
+    HT_CHECK(irq_lat_build_program(IRQ_LAT_SRC_GPIO, &prog));
+    HT_EQ(prog.length, 5);
+    HT_EQ(prog.insn[2], 0x0042);
+    HT_EQ(prog.insn[3], 0xFF01);        // set pins, 1 [31]
+    HT_EQ(prog.insn[4], 0xE000);
+    HT_EQ(prog.wrap, 4);
+    HT_CHECK(prog.length <= IRQ_LAT_PROG_MAX);
+
+    HT_CHECK(!irq_lat_build_program(IRQ_LAT_SRC_NUM, &prog));
+    HT_EQ(prog.length, 0);
+
+    HT_CHECK(irq_lat_src_name(IRQ_LAT_SRC_PIO)[0] == 'p');
+    HT_CHECK(irq_lat_src_name(IRQ_LAT_SRC_NUM)[0] == '?');
+}
+
+// ディレイは範囲内で、並びは毎回同じ、範囲の値はすべて出てくる
+static void test_delay(void)
+{
+    static uint8_t s_seen[IRQ_LAT_DELAY_SPAN];
+    uint32_t kinds = 0;
+
+    for (uint32_t seq = 0; seq < 4096; seq++)
+    {
+        uint32_t delay = irq_lat_delay(seq);
+        HT_CHECK(delay >= IRQ_LAT_DELAY_MIN && delay < IRQ_LAT_DELAY_MIN + IRQ_LAT_DELAY_SPAN);
+        HT_EQ(delay, irq_lat_delay(seq));
+        if (s_seen[delay - IRQ_LAT_DELAY_MIN]++ == 0) {
+            kinds++;
+        }
+    }
+    HT_EQ(kinds, IRQ_LAT_DELAY_SPAN);
+}
+
+// オフセットは校正の最小値、応答時間はそれを引いた値(CYCCNTの折り返しをまたいでもよい)
+static void test_calib_record(void)
+{
+    irq_lat_stats_t stats;
+
+    irq_lat_reset(&stats);
+    HT_EQ(stats.offset, UINT32_MAX);
+    HT_EQ(stats.hist.total, 0);
+
+    irq_lat_calib_add(&stats, 1000, 1000 + 100 + 9, 100);
+    irq_lat_calib_add(&stats, 0xFFFFFFF0u, 0xFFFFFFF0u + 80 + 7, 80);   // 折り返し
+    irq_lat_calib_add(&stats, 5000, 5000 + 64 + 12, 64);
+    HT_EQ(stats.offset, 7);
+    HT_EQ(stats.calib_num, 3);
+
+    HT_EQ(irq_lat_record(&stats, 2000, 2000 + 100 + 7 + 25, 100), 25);
+    HT_EQ(irq_lat_record(&stats, 0xFFFFFF00u, 0xFFFFFF00u + 70 + 7 + 40, 70), 40);
+    HT_EQ(irq_lat_record(&stats, 3000, 3000 + 100 + 7, 100), 0);
+    HT_EQ(stats.early, 0);
+
+    // 予測より早ければ0として記録して数える
+    HT_EQ(irq_lat_record(&stats, 4000, 4000 + 100 + 3, 100), 0);
+    HT_EQ(stats.early, 1);
+    HT_EQ(stats.hist.total, 4);
+    HT_EQ(stats.hist.max, 40);
+    HT_EQ(stats.hist.sum, 25 + 40);
+    HT_EQ(stats.timeouts, 0);
+}
+
+int main(void)
+{
+    HT_RUN(test_insn_pioasm);
+    HT_RUN(test_insn_fields);
+    HT_RUN(test_build_program);
+    HT_RUN(test_delay);
+    HT_RUN(test_calib_record);
+
+    return HT_RESULT();
+}
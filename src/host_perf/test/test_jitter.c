@@ -0,0 +1,105 @@
+/**
+ * @file test_jitter.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief jitter.cのテスト(遅れの記録、周期の飛ばし方、負荷名)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "jitter.h"
+
+#define SIM_SAMPLES     20000
+
+static jitter_result_t s_result;
+
+static void test_load_name(void)
+{
+    jitter_load_t load = JITTER_LOAD_NUM;
+
+    for (uint32_t i = 0; i < JITTER_LOAD_NUM; i++)
+    {
+        HT_CHECK(jitter_parse_load(jitter_load_name((jitter_load_t)i), &load));
+        HT_EQ(load, i);
+    }
+    HT_CHECK(!jitter_parse_load("cpu", &load));
+    HT_EQ(load, JITTER_LOAD_NUM - 1);
+    HT_CHECK(jitter_load_name(JITTER_LOAD_NUM)[0] == '?');
+}
+
+// 1周期未満の遅れはそのまま次の周期、1周期以上は過ぎた周期を飛ばす
+static void test_record(void)
+{
+    jitter_reset(&s_result, 10000);
+    HT_EQ(s_result.period_us, 100);
+    HT_EQ(s_result.hist.total, 0);
+
+    HT_EQ(jitter_record(&s_result, 1000, 1000), 1100);
+    HT_EQ(jitter_record(&s_result, 1100, 1095), 1200);     // 早い分は0
+    HT_EQ(jitter_record(&s_result, 1200, 1299), 1300);
+    HT_EQ(s_result.overruns, 0);
+
+    HT_EQ(jitter_record(&s_result, 1300, 1400), 1500);     // ちょうど1周期遅れ
+    HT_EQ(s_result.overruns, 1);
+    HT_EQ(s_result.skipped, 1);
+    HT_EQ(jitter_record(&s_result, 1500, 1850), 1900);
+    HT_EQ(s_result.overruns, 2);
+    HT_EQ(s_result.skipped, 1 + 3);
+
+    HT_EQ(s_result.hist.total, 5);
+    HT_EQ(s_result.hist.min, 0);
+    HT_EQ(s_result.hist.max, 350);
+    HT_EQ(s_result.hist.sum, 0 + 0 + 99 + 100 + 350);
+
+    jitter_reset(&s_result, 3);
+    HT_EQ(s_result.period_us, 333333);
+    HT_EQ(s_result.overruns + s_result.skipped + s_result.hist.total, 0);
+}
+
+// 【仮想時計】
+// 乱数の遅れで発火させ続け、予定時刻が周期の格子に乗ったまま必ず先に進むことと、
+// 飛ばした周期の数が経過時間と合うことを確かめる
+static void test_sim(void)
+{
+    const uint64_t start_us = 5000000;
+
+    jitter_reset(&s_result, 2000);
+    uint64_t due_us = start_us;
+    uint64_t now_us = start_us;
+    uint32_t late_max = 0;
+
+    for (uint32_t i = 0; i < SIM_SAMPLES; i++)
+    {
+        uint32_t late = (ht_rand_below(50) == 0) ? ht_rand_below(5000) : ht_rand_below(40);
+        now_us = due_us + late;
+        if (late > late_max) {
+            late_max = late;
+        }
+
+        uint64_t next_us = jitter_record(&s_result, due_us, now_us);
+        HT_CHECK(next_us > now_us);
+        HT_CHECK(next_us - now_us <= s_result.period_us);
+        HT_EQ((next_us - start_us) % s_result.period_us, 0);
+        due_us = next_us;
+    }
+
+    // 周期の格子の数 = 発火した回数 + 飛ばした数
+    HT_EQ((due_us - start_us) / s_result.period_us, SIM_SAMPLES + s_result.skipped);
+    HT_EQ(s_result.hist.total, SIM_SAMPLES);
+    HT_EQ(s_result.hist.max, late_max);
+    HT_CHECK(s_result.overruns > 0 && s_result.overruns <= s_result.skipped);
+    HT_CHECK(lh_percentile(&s_result.hist, 50.0) < 40);
+}
+
+int main(void)
+{
+    ht_srand(0x317Eu);
+
+    HT_RUN(test_load_name);
+    HT_RUN(test_record);
+    HT_RUN(test_sim);
+
+    return HT_RESULT();
+}
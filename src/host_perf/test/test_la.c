@@ -0,0 +1,404 @@
+/**
+ * @file test_la.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief la.cのテスト(リングからの読み出し、トリガ判定、RLE)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※環境変数LA_DUMP_LOGがあれば、そこへlaコマンドと同じ形式のダンプを書く
+ *   (test_la2vcd.pyがtools/la2vcd.pyで読み戻して確かめる)
+ */
+#include "host_test.h"
+#include "la.h"
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RING_WORDS          256
+#define RAND_WORDS          20000
+#define DUMP_BYTES_PER_LINE 32      // dbg_com.hのLA_DUMP_BYTES_PER_LINEと同じ
+#define DUMP_SAMPLES        2000
+#define DUMP_PIN_BASE       2
+#define DUMP_PIN_NUM        3
+#define DUMP_RATE_HZ        1000000
+#define DUMP_TRIGGER        120
+
+static uint32_t s_ring[RING_WORDS];
+static uint32_t s_sample[RING_WORDS * 32];
+static uint8_t s_rle[RING_WORDS * 32 * LA_RLE_RUN_BYTES_MAX];
+
+// 通し番号posのサンプルをリングに書く(PIOの自動PUSHと同じ並び)
+static void ring_put(uint32_t width, uint32_t pos, uint32_t sample)
+{
+    uint32_t per_word = 32 / width;
+    uint32_t *p_word = &s_ring[(pos / per_word) & (RING_WORDS - 1)];
+    uint32_t shift = (pos % per_word) * width;
+
+    *p_word = (*p_word & ~(la_pin_mask(width) << shift)) | ((sample & la_pin_mask(width)) << shift);
+}
+
+// キャプチャを作る(使わないビットは1で埋めて、読み出しでマスクされることを確かめる)
+static void capture_make(la_capture_t *p_cap, uint32_t pin_num, uint32_t first, uint32_t samples)
+{
+    memset(s_ring, 0xFF, sizeof(s_ring));
+    memset(p_cap, 0, sizeof(*p_cap));
+    p_cap->p_buf = s_ring;
+    p_cap->buf_words = RING_WORDS;
+    p_cap->pin_num = pin_num;
+    p_cap->width = la_sample_width(pin_num);
+    p_cap->first = first;
+    p_cap->samples = samples;
+    p_cap->trigger = LA_TRIG_POS_NONE;
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        ring_put(p_cap->width, first + i, s_sample[i] | ~la_pin_mask(pin_num));
+    }
+}
+
+static void test_width(void)
+{
+    static const uint32_t s_width[LA_PIN_MAX + 1] = {
+        1, 1, 2, 4, 4, 8, 8, 8, 8, 16, 16, 16, 16, 16, 16, 16, 16,
+        32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32,
+    };
+
+    for (uint32_t pins = 0; pins <= LA_PIN_MAX; pins++)
+    {
+        HT_EQ(la_sample_width(pins), s_width[pins]);
+    }
+    HT_EQ(la_pin_mask(1), 0x1);
+    HT_EQ(la_pin_mask(9), 0x1FF);
+    HT_EQ(la_pin_mask(32), 0xFFFFFFFFu);
+}
+
+// リングの折り返しと通し番号の32bitの折り返しをまたいで読める
+static void test_capture_sample(void)
+{
+    static const uint32_t s_pins[] = {1, 2, 3, 5, 9, 17, 32};
+    la_capture_t cap;
+
+    for (uint32_t p = 0; p < sizeof(s_pins) / sizeof(s_pins[0]); p++)
+    {
+        uint32_t width = la_sample_width(s_pins[p]);
+        uint32_t ring_samples = RING_WORDS * (32 / width);
+        uint32_t first = 0u - ring_samples / 3;
+
+        for (uint32_t i = 0; i < ring_samples; i++)
+        {
+            s_sample[i] = ht_rand() & la_pin_mask(s_pins[p]);
+        }
+        capture_make(&cap, s_pins[p], first, ring_samples);
+        for (uint32_t i = 0; i < ring_samples; i++)
+        {
+            HT_EQ(la_capture_sample(&cap, i), s_sample[i]);
+        }
+    }
+}
+
+static void test_trig_parse(void)
+{
+    la_trig_t trig;
+
+    HT_CHECK(la_trig_parse("none", 2, 4, &trig));
+    HT_EQ(trig.type, LA_TRIG_NONE);
+    HT_CHECK(la_trig_parse("rise:3", 2, 4, &trig));
+    HT_EQ(trig.type, LA_TRIG_RISE);
+    HT_EQ(trig.mask, 0x2);
+    HT_CHECK(la_trig_parse("fall:5", 2, 4, &trig));
+    HT_EQ(trig.mask, 0x8);
+    HT_CHECK(la_trig_parse("edge:2", 2, 4, &trig));
+    HT_EQ(trig.type, LA_TRIG_EDGE);
+    HT_CHECK(la_trig_parse("pat:0xC:0x4", 2, 4, &trig));
+    HT_EQ(trig.type, LA_TRIG_PATTERN);
+    HT_EQ(trig.mask, 0xC);
+    HT_EQ(trig.value, 0x4);
+
+    HT_CHECK(!la_trig_parse("rise:6", 2, 4, &trig));       // 範囲外のピン
+    HT_CHECK(!la_trig_parse("rise:1", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("rise:", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("rise:3x", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("pat:0x10:0", 2, 4, &trig));   // マスクがピンの外
+    HT_CHECK(!la_trig_parse("pat:0x3:0x4", 2, 4, &trig));  // 値がマスクの外
+    HT_CHECK(!la_trig_parse("pat:0:0", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("pat:0x3", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("risen:3", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("nonex", 2, 4, &trig));
+    HT_CHECK(!la_trig_parse("", 2, 4, &trig));
+    HT_CHECK(la_trig_name(LA_TRIG_PATTERN)[0] == 'p');
+    HT_CHECK(la_trig_name(LA_TRIG_TYPE_NUM)[0] == '?');
+}
+
+// サンプルごとに判定する素直な実装(la_trig_feed_word()の語単位の近道と比べる)
+static int32_t ref_feed_word(la_trig_t *p_trig, uint32_t word, uint32_t width)
+{
+    for (uint32_t k = 0; k < 32 / width; k++)
+    {
+        uint32_t sample = (word >> (k * width)) & la_pin_mask(width);
+        bool is_prev_on = (p_trig->prev & p_trig->mask) != 0;
+        bool is_on = (sample & p_trig->mask) != 0;
+        bool is_hit;
+
+        switch (p_trig->type)
+        {
+            case LA_TRIG_RISE:
+                is_hit = p_trig->is_primed && !is_prev_on && is_on;
+                break;
+            case LA_TRIG_FALL:
+                is_hit = p_trig->is_primed && is_prev_on && !is_on;
+                break;
+            case LA_TRIG_EDGE:
+                is_hit = p_trig->is_primed && is_prev_on != is_on;
+                break;
+            case LA_TRIG_PATTERN:
+                is_hit = (sample & p_trig->mask) == p_trig->value;
+                break;
+            default:
+                is_hit = true;
+                break;
+        }
+        p_trig->prev = sample;
+        p_trig->is_primed = true;
+        if (is_hit) {
+            return (int32_t)k;
+        }
+    }
+
+    return -1;
+}
+
+// 【乱数の比較】
+// 止まった信号(同じサンプルが並んだ語)を多めに混ぜて、近道の判定も通す
+static void test_trig_feed(void)
+{
+    static const char *const s_cond[] = {"none", "rise:3", "fall:3", "edge:4", "pat:0x5:0x4"};
+    static const uint32_t s_width[] = {4, 8};
+
+    for (uint32_t w = 0; w < sizeof(s_width) / sizeof(s_width[0]); w++)
+    {
+        for (uint32_t c = 0; c < sizeof(s_cond) / sizeof(s_cond[0]); c++)
+        {
+            la_trig_t trig;
+            la_trig_t ref;
+            uint32_t hits = 0;
+            uint32_t sample = 0;
+
+            HT_CHECK(la_trig_parse(s_cond[c], 2, 3, &trig));
+            la_trig_reset(&trig);
+            ref = trig;
+            for (uint32_t i = 0; i < RAND_WORDS; i++)
+            {
+                uint32_t word = 0;
+                for (uint32_t k = 0; k < 32 / s_width[w]; k++)
+                {
+                    if (ht_rand_below(16) == 0) {
+                        sample = ht_rand() & la_pin_mask(3);
+                    }
+                    word |= sample << (k * s_width[w]);
+                }
+
+                int32_t pos = la_trig_feed_word(&trig, word, s_width[w]);
+                HT_EQ(pos, ref_feed_word(&ref, word, s_width[w]));
+                HT_EQ(trig.prev & la_pin_mask(3), ref.prev & la_pin_mask(3));
+                if (pos >= 0) {
+                    hits++;
+                }
+            }
+            HT_CHECK(hits > 0);
+        }
+    }
+}
+
+// RLEを展開する(tools/la2vcd.pyのdecode_rle()と同じ)
+static uint32_t rle_decode(const uint8_t *p_data, uint32_t len, uint32_t pin_num, uint32_t *p_out, uint32_t max)
+{
+    uint32_t value_bytes = (pin_num + 7) / 8;
+    uint32_t pos = 0;
+    uint32_t num = 0;
+
+    while (pos < len)
+    {
+        uint32_t value = 0;
+        uint32_t rest = 0;
+        uint32_t shift = 0;
+
+        for (uint32_t i = 0; i < value_bytes; i++)
+        {
+            value |= (uint32_t)p_data[pos++] << (i * 8);
+        }
+        do
+        {
+            rest |= (uint32_t)(p_data[pos] & 0x7F) << shift;
+            shift += 7;
+        } while ((p_data[pos++] & 0x80) != 0);
+        for (uint32_t i = 0; i <= rest && num < max; i++)
+        {
+            p_out[num++] = value;
+        }
+    }
+
+    return num;
+}
+
+static void test_rle_put(void)
+{
+    static const uint8_t s_expect[] = {0x05, 0x00, 0x02, 0x7F, 0x01, 0x80, 0x01, 0x02, 0x01, 0x00};
+    uint8_t out[sizeof(s_expect)];
+    uint32_t len = 0;
+    la_rle_t rle;
+
+    // 5が1個、2が128個、1が129個、0x102(9ピンなので2バイト)が1個
+    la_rle_init(&rle, 3);
+    HT_EQ(rle.value_bytes, 1);
+    len += la_rle_put(&rle, 5, &out[len]);
+    for (uint32_t i = 0; i < 128; i++)
+    {
+        len += la_rle_put(&rle, 2, &out[len]);
+    }
+    for (uint32_t i = 0; i < 129; i++)
+    {
+        len += la_rle_put(&rle, 1, &out[len]);
+    }
+    len += la_rle_flush(&rle, &out[len]);
+    HT_EQ(la_rle_flush(&rle, &out[len]), 0);
+    HT_EQ(len, 7);
+    HT_CHECK(memcmp(out, s_expect, 7) == 0);
+    HT_EQ(rle.runs, 3);
+
+    la_rle_init(&rle, 9);
+    HT_EQ(rle.value_bytes, 2);
+    HT_EQ(la_rle_put(&rle, 0x102, out), 0);
+    HT_EQ(la_rle_flush(&rle, out), 3);
+    HT_CHECK(memcmp(out, &s_expect[7], 3) == 0);
+}
+
+// 小さい出力先で少しずつ出しても、一度に出しても同じバイト列で、展開すると元に戻る
+static void test_rle_encode(void)
+{
+    static const uint32_t s_pins[] = {1, 3, 8, 9, 24, 32};
+    static uint32_t s_back[RING_WORDS * 32];
+    la_capture_t cap;
+
+    for (uint32_t p = 0; p < sizeof(s_pins) / sizeof(s_pins[0]); p++)
+    {
+        uint32_t width = la_sample_width(s_pins[p]);
+        uint32_t samples = RING_WORDS * (32 / width) - ht_rand_below(100);
+        uint32_t run_left = 0;
+        uint32_t value = 0;
+
+        for (uint32_t i = 0; i < samples; i++)
+        {
+            if (run_left == 0) {
+                value = ht_rand() & la_pin_mask(s_pins[p]);
+                run_left = 1 + ((ht_rand_below(8) == 0) ? ht_rand_below(1000) : ht_rand_below(4));
+            }
+            s_sample[i] = value;
+            run_left--;
+        }
+        capture_make(&cap, s_pins[p], 0u - 77, samples);
+
+        la_rle_t rle;
+        uint32_t pos = 0;
+        uint32_t total = 0;
+        la_rle_init(&rle, s_pins[p]);
+        total = la_rle_encode(&cap, &pos, &rle, s_rle, sizeof(s_rle));
+        HT_EQ(la_rle_encode(&cap, &pos, &rle, s_rle, sizeof(s_rle)), 0);
+        uint32_t runs = rle.runs;
+
+        uint8_t chunk[LA_RLE_RUN_BYTES_MAX * 2];
+        uint32_t len;
+        uint32_t chunk_total = 0;
+        bool is_same = true;
+        pos = 0;
+        la_rle_init(&rle, s_pins[p]);
+        while ((len = la_rle_encode(&cap, &pos, &rle, chunk, sizeof(chunk))) > 0)
+        {
+            is_same = is_same && (chunk_total + len <= total) && memcmp(chunk, &s_rle[chunk_total], len) == 0;
+            chunk_total += len;
+        }
+        HT_CHECK(is_same);
+        HT_EQ(chunk_total, total);
+        HT_EQ(rle.runs, runs);
+
+        HT_EQ(rle_decode(s_rle, total, s_pins[p], s_back, samples + 1), samples);
+        HT_CHECK(memcmp(s_back, s_sample, samples * sizeof(uint32_t)) == 0);
+    }
+}
+
+// 【ダンプの中身】(test_la2vcd.pyの期待値と対応)
+// GPIO2: 5サンプルごとに反転、GPIO3: 100～349でH、GPIO4: 37サンプルごとに3回に1回H
+// 1000以降は5のまま(長さ1000のラン)。通し番号は32bitの折り返しをまたぐ
+static uint32_t dump_sample(uint32_t i)
+{
+    if (i >= 1000) {
+        return 5;
+    }
+
+    return ((i / 5) & 1) | ((i >= 100 && i < 350) ? 2 : 0) | ((((i / 37) % 3) == 0) ? 4 : 0);
+}
+
+static void write_dump(FILE *p_file, const la_capture_t *p_cap)
+{
+    uint8_t bin[DUMP_BYTES_PER_LINE];
+    char hex[sizeof(bin) * 2 + 1];
+    la_rle_t rle;
+    uint32_t pos = 0;
+    uint32_t total = 0;
+    uint32_t len;
+
+    fprintf(p_file, "[LA] captured (this line is not part of the dump)\n");
+    fprintf(p_file, "%s ver=1 base=%u pins=%u rate=%u samples=%u trigger=%d\n", LA_DUMP_BEGIN,
+            p_cap->pin_base, p_cap->pin_num, p_cap->rate_hz, p_cap->samples, p_cap->trigger);
+    la_rle_init(&rle, p_cap->pin_num);
+    while ((len = la_rle_encode(p_cap, &pos, &rle, bin, sizeof(bin))) > 0)
+    {
+        trace_format_hex(hex, sizeof(hex), bin, len);
+        fprintf(p_file, "%s\n", hex);
+        total += len;
+    }
+    fprintf(p_file, "%s bytes=%u runs=%u\n", LA_DUMP_END, total, rle.runs);
+}
+
+static void test_dump(void)
+{
+    const char *p_path = getenv("LA_DUMP_LOG");
+    la_capture_t cap;
+
+    for (uint32_t i = 0; i < DUMP_SAMPLES; i++)
+    {
+        s_sample[i] = dump_sample(i);
+    }
+    capture_make(&cap, DUMP_PIN_NUM, 0u - 300, DUMP_SAMPLES);
+    cap.pin_base = DUMP_PIN_BASE;
+    cap.rate_hz = DUMP_RATE_HZ;
+    cap.trigger = DUMP_TRIGGER;
+    HT_EQ(la_capture_sample(&cap, 999), dump_sample(999));
+    HT_EQ(la_capture_sample(&cap, 1000), 5);
+
+    if (p_path == NULL) {
+        return;
+    }
+    FILE *p_file = fopen(p_path, "w");
+    HT_CHECK(p_file != NULL);
+    if (p_file != NULL) {
+        write_dump(p_file, &cap);
+        HT_CHECK(fclose(p_file) == 0);
+    }
+}
+
+int main(void)
+{
+    ht_srand(0x1A2Bu);
+
+    HT_RUN(test_width);
+    HT_RUN(test_capture_sample);
+    HT_RUN(test_trig_parse);
+    HT_RUN(test_trig_feed);
+    HT_RUN(test_rle_put);
+    HT_RUN(test_rle_encode);
+    HT_RUN(test_dump);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file test_la2vcd.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief tools/la2vcd.pyのテスト(test_laが書いたダンプを読み戻す往復 + 単体)
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+※ctestから実行する(test_laが環境変数LA_DUMP_LOGのファイルにダンプを書いてから)
+"""
+import contextlib
+import io
+import os
+import sys
+import tempfile
+import unittest
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(TEST_DIR, "..", "..", "..", "tools"))
+
+import la2vcd  # noqa: E402
+
+DUMP_LOG = os.environ.get("LA_DUMP_LOG")
+DUMP_SAMPLES = 2000
+DUMP_TRIGGER = 120
+PS_PER_SAMPLE = 10 ** 6     # 1MHz
+
+
+def dump_sample(i):
+    """test_la.cのdump_sample()と同じ"""
+    if i >= 1000:
+        return 5
+    return ((i // 5) & 1) | (2 if 100 <= i < 350 else 0) | (4 if (i // 37) % 3 == 0 else 0)
+
+
+def expand(runs):
+    samples = []
+    for value, length in runs:
+        samples.extend([value] * length)
+    return samples
+
+
+def read_vcd(text):
+    """VCD → ({名前: id}, {id: [(時刻, 値)]}, 最後の時刻)"""
+    names = {}
+    changes = {}
+    now = None
+    for line in text.splitlines():
+        if line.startswith("$var"):
+            _, _, _, vid, name, _ = line.split()
+            names[name] = vid
+            changes[vid] = []
+        elif line.startswith("#"):
+            now = int(line[1:])
+        elif line and line[0] in "01" and now is not None:
+            changes[line[1:]].append((now, int(line[0])))
+    return names, changes, now
+
+
+def level_at(changes, t):
+    level = None
+    for ts, value in changes:
+        if ts > t:
+            break
+        level = value
+    return level
+
+
+@unittest.skipUnless(DUMP_LOG, "LA_DUMP_LOG is not set (run from ctest)")
+class RoundTripTest(unittest.TestCase):
+    """la.c → ダンプ → la2vcd.py の往復(test_la.cのtest_dump()と対応)"""
+
+    @classmethod
+    def setUpClass(cls):
+        with open(DUMP_LOG, "r") as f:
+            cls.dumps = la2vcd.read_dumps(f.readlines())
+
+    def test_decode(self):
+        self.assertEqual(len(self.dumps), 1)
+        dump = self.dumps[0]
+        self.assertEqual(dump.info["base"], "2")
+        self.assertEqual(dump.info["trigger"], str(DUMP_TRIGGER))
+        runs = la2vcd.decode_rle(dump.data, int(dump.info["pins"]))
+        la2vcd.check_dump(dump, runs)
+        self.assertEqual(int(dump.end_info["runs"]), len(runs))
+        self.assertEqual(runs[-1], (5, 1001))     # 999も5なので1000以降とつながる
+        self.assertEqual(expand(runs), [dump_sample(i) for i in range(DUMP_SAMPLES)])
+
+    def test_vcd(self):
+        out = io.StringIO()
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "la.vcd")
+            with contextlib.redirect_stderr(out):
+                self.assertEqual(la2vcd.main([DUMP_LOG, "-o", path, "--names", "3=SDA,0x4=SCL"]), 0)
+            with open(path, "r") as f:
+                names, changes, end = read_vcd(f.read())
+        self.assertIn("%d samples" % DUMP_SAMPLES, out.getvalue())
+
+        self.assertEqual(sorted(names), ["SCL", "SDA", "gpio2", "trigger"])
+        self.assertEqual(end, DUMP_SAMPLES * PS_PER_SAMPLE)
+        for i in range(0, DUMP_SAMPLES, 7):
+            t = i * PS_PER_SAMPLE
+            self.assertEqual(level_at(changes[names["gpio2"]], t), dump_sample(i) & 1, i)
+            self.assertEqual(level_at(changes[names["SDA"]], t), (dump_sample(i) >> 1) & 1, i)
+            self.assertEqual(level_at(changes[names["SCL"]], t), (dump_sample(i) >> 2) & 1, i)
+        self.assertEqual(changes[names["trigger"]], [
+            (0, 0),
+            (DUMP_TRIGGER * PS_PER_SAMPLE, 1),
+            ((DUMP_TRIGGER + 1) * PS_PER_SAMPLE, 0),
+        ])
+
+
+class UnitTest(unittest.TestCase):
+
+    def test_decode_leb128(self):
+        # 9ピン(値2バイト): 0x102が1個、0x001が129個(長さ-1 = 128 = 0x80 0x01)
+        runs = la2vcd.decode_rle(bytes([0x02, 0x01, 0x00, 0x01, 0x00, 0x80, 0x01]), 9)
+        self.assertEqual(runs, [(0x102, 1), (0x001, 129)])
+
+    def test_truncated(self):
+        with self.assertRaises(ValueError):
+            la2vcd.decode_rle(bytes([0x01]), 9)
+        with self.assertRaises(ValueError):
+            la2vcd.decode_rle(bytes([0x01, 0x80]), 3)
+
+    def test_incomplete_log(self):
+        lines = ["# la begin ver=1 base=0 pins=1 rate=1000 samples=10 trigger=-1", "0104", "# la end bytes=2 runs=1"]
+        dump = la2vcd.read_dumps(lines)[0]
+        with self.assertRaises(ValueError):
+            la2vcd.check_dump(dump, la2vcd.decode_rle(dump.data, 1))
+
+        lines[0] = lines[0].replace("ver=1", "ver=2")
+        dump = la2vcd.read_dumps(lines)[0]
+        with self.assertRaises(ValueError):
+            la2vcd.check_dump(dump, [(1, 10)])
+
+    def test_vcd_id(self):
+        ids = [la2vcd.vcd_id(i) for i in range(94 * 2)]
+        self.assertEqual(ids[0], "!")
+        self.assertEqual(ids[93], "~")
+        self.assertEqual(ids[94], "!!")
+        self.assertEqual(len(set(ids)), len(ids))
+
+    def test_parse_names(self):
+        self.assertEqual(la2vcd.parse_names("2=SCL, 0x3= SDA"), {2: "SCL", 3: "SDA"})
+        self.assertEqual(la2vcd.parse_names(None), {})
+
+    def test_no_dump(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "empty.log")
+            with open(path, "w") as f:
+                f.write("> la 2 2 1000\n")
+            with contextlib.redirect_stderr(io.StringIO()):
+                self.assertEqual(la2vcd.main([path]), 1)
+
+
+if __name__ == "__main__":
+    unittest.main()
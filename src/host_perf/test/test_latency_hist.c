@@ -0,0 +1,153 @@
+/**
+ * @file test_latency_hist.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief latency_hist.cのテスト(バケットの境界と誤差、パーセンタイルをソートした値と比較)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "latency_hist.h"
+#include <stdlib.h>
+
+#define RAND_SAMPLES    5000
+#define RAND_ROUNDS     20
+
+static latency_hist_t s_hist;
+static uint32_t s_sample[RAND_SAMPLES];
+
+// バケットは0～UINT32_MAXを隙間なく覆い、幅は下端の1/16以下
+static void test_bucket(void)
+{
+    HT_EQ(lh_bucket_low(0), 0);
+    HT_EQ(lh_bucket_high(LH_BUCKET_NUM - 1), UINT32_MAX);
+    HT_EQ(lh_bucket_index(UINT32_MAX), LH_BUCKET_NUM - 1);
+    for (uint32_t i = 0; i < LH_BUCKET_NUM; i++)
+    {
+        uint32_t low = lh_bucket_low(i);
+        uint32_t high = lh_bucket_high(i);
+
+        HT_CHECK(low <= high);
+        HT_EQ(lh_bucket_index(low), i);
+        HT_EQ(lh_bucket_index(high), i);
+        if (i + 1 < LH_BUCKET_NUM) {
+            HT_EQ(lh_bucket_low(i + 1), high + 1);
+        }
+        if (i < LH_SUB_NUM) {
+            HT_EQ(low, i);
+        } else {
+            HT_CHECK(high - low + 1 <= low / LH_HALF_NUM);
+        }
+    }
+
+    for (uint32_t r = 0; r < 100000; r++)
+    {
+        uint32_t value = ht_rand() >> ht_rand_below(32);
+        uint32_t idx = lh_bucket_index(value);
+        HT_CHECK(idx < LH_BUCKET_NUM);
+        HT_CHECK(lh_bucket_low(idx) <= value && value <= lh_bucket_high(idx));
+    }
+}
+
+static void test_empty(void)
+{
+    lh_clear(&s_hist);
+    HT_EQ(lh_percentile(&s_hist, 50.0), 0);
+    HT_CHECK(lh_mean(&s_hist) == 0.0);
+    HT_EQ(lh_count_range(&s_hist, 0, UINT32_MAX), 0);
+    HT_EQ(s_hist.min, UINT32_MAX);
+
+    lh_record(&s_hist, 1234);
+    HT_EQ(lh_percentile(&s_hist, 0.0), 1234);
+    HT_EQ(lh_percentile(&s_hist, 50.0), 1234);     // バケットの上端でなくmaxに収める
+    HT_EQ(lh_percentile(&s_hist, 100.0), 1234);
+    HT_CHECK(lh_mean(&s_hist) == 1234.0);
+}
+
+static int cmp_u32(const void *p_a, const void *p_b)
+{
+    uint32_t a = *(const uint32_t *)p_a;
+    uint32_t b = *(const uint32_t *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+// ソートした値でのパーセンタイルの順位(切り上げ、最低1)
+static uint32_t percentile_rank(uint32_t num, double percent)
+{
+    uint32_t rank = (uint32_t)((percent * num) / 100.0);
+
+    if ((double)rank * 100.0 < percent * num) {
+        rank++;
+    }
+
+    return (rank == 0) ? 1 : rank;
+}
+
+// 【乱数の比較】
+// 指数的な裾のある分布(大半は小さく、まれに大きい)で、ソートした値と比べる
+static void test_percentile(void)
+{
+    static const double s_percent[] = {0.1, 1.0, 25.0, 50.0, 90.0, 99.0, 99.9, 99.99};
+
+    for (uint32_t round = 0; round < RAND_ROUNDS; round++)
+    {
+        uint32_t num = 1 + ht_rand_below(RAND_SAMPLES);
+        uint64_t sum = 0;
+
+        lh_clear(&s_hist);
+        for (uint32_t i = 0; i < num; i++)
+        {
+            s_sample[i] = 3 + (ht_rand() >> (8 + ht_rand_below(24)));
+            sum += s_sample[i];
+            lh_record(&s_hist, s_sample[i]);
+        }
+        qsort(s_sample, num, sizeof(s_sample[0]), cmp_u32);
+
+        HT_EQ(s_hist.total, num);
+        HT_EQ(s_hist.sum, sum);
+        HT_EQ(s_hist.min, s_sample[0]);
+        HT_EQ(s_hist.max, s_sample[num - 1]);
+        HT_CHECK(lh_mean(&s_hist) == (double)sum / num);
+        HT_EQ(lh_percentile(&s_hist, 0.0), s_sample[0]);
+        HT_EQ(lh_percentile(&s_hist, 100.0), s_sample[num - 1]);
+        for (uint32_t i = 0; i < sizeof(s_percent) / sizeof(s_percent[0]); i++)
+        {
+            uint32_t exact = s_sample[percentile_rank(num, s_percent[i]) - 1];
+            uint32_t value = lh_percentile(&s_hist, s_percent[i]);
+            uint32_t expect = lh_bucket_high(lh_bucket_index(exact));
+
+            // バケットの上端(maxを越えない)、実際より小さくは出ず誤差は1/16まで
+            HT_EQ(value, (expect > s_hist.max) ? s_hist.max : expect);
+            HT_CHECK(value >= exact);
+            HT_CHECK(value - exact <= exact / LH_HALF_NUM);
+        }
+
+        uint32_t low = s_sample[num / 4];
+        uint32_t high = s_sample[num * 3 / 4];
+        uint32_t in_range = 0;
+        for (uint32_t i = 0; i < num; i++)
+        {
+            if (s_sample[i] >= lh_bucket_low(lh_bucket_index(low)) &&
+                s_sample[i] <= lh_bucket_high(lh_bucket_index(high))) {
+                in_range++;
+            }
+        }
+        HT_EQ(lh_count_range(&s_hist, low, high), in_range);
+        HT_EQ(lh_count_range(&s_hist, high + 1, low), 0);
+        HT_EQ(lh_count_range(&s_hist, 0, UINT32_MAX), num);
+    }
+}
+
+int main(void)
+{
+    ht_srand(0x1A7Eu);
+
+    HT_RUN(test_bucket);
+    HT_RUN(test_empty);
+    HT_RUN(test_percentile);
+
+    return HT_RESULT();
+}
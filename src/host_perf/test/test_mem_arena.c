@@ -0,0 +1,196 @@
+/**
+ * @file test_mem_arena.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief mem_arena.cのテスト(範囲とアライメント、mark/release、calloc、失敗の数)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "mem_arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_SIZE      1024
+#define RAND_ROUNDS     2000
+
+static bool is_aligned(const void *p)
+{
+    return ((uintptr_t)p % MEM_ARENA_ALIGN) == 0;
+}
+
+// 先頭がずれたバッファでも確保はアライン済み、末尾を越えない
+static void test_bounds_align(void)
+{
+    static uint64_t s_buf[ARENA_SIZE / 8 + 1];
+    mem_arena_t arena;
+
+    for (uint32_t ofs = 0; ofs < MEM_ARENA_ALIGN; ofs++)
+    {
+        uint8_t *p_buf = (uint8_t *)s_buf + ofs;
+        size_t size = ARENA_SIZE;
+
+        mem_arena_init(&arena, p_buf, size);
+        HT_CHECK(is_aligned(arena.p_base));
+        HT_CHECK(arena.p_base >= p_buf);
+        HT_CHECK(arena.p_base + arena.size <= p_buf + size);
+        HT_EQ(arena.size, (ofs == 0) ? size : size - (MEM_ARENA_ALIGN - ofs));
+
+        // 乱数のサイズで埋めていき、どれもアライン済みで重ならず範囲内
+        uint8_t *p_prev_end = arena.p_base;
+        for (;;)
+        {
+            size_t len = 1 + ht_rand_below(40);
+            uint8_t *p = mem_arena_alloc(&arena, len);
+            if (p == NULL) {
+                break;
+            }
+            HT_CHECK(is_aligned(p));
+            HT_CHECK(p >= p_prev_end);
+            HT_CHECK(p + len <= p_buf + size);
+            memset(p, 0x5A, len);
+            p_prev_end = p + len;
+        }
+        HT_EQ(arena.fails, 1);
+        HT_CHECK(arena.size - arena.used < 40 + MEM_ARENA_ALIGN);
+        HT_EQ(arena.peak, arena.used);
+    }
+}
+
+// 容量ぴったりは確保でき、1バイトでも越えれば失敗
+static void test_exact_fit(void)
+{
+    static uint64_t s_buf[ARENA_SIZE / 8];
+    mem_arena_t arena;
+
+    mem_arena_init(&arena, s_buf, sizeof(s_buf));
+    HT_CHECK(mem_arena_alloc(&arena, ARENA_SIZE + 1) == NULL);
+    HT_CHECK(mem_arena_alloc(&arena, ARENA_SIZE) == (void *)s_buf);
+    HT_CHECK(mem_arena_alloc(&arena, 1) == NULL);
+    HT_EQ(arena.fails, 2);
+
+    mem_arena_reset(&arena);
+    HT_CHECK(mem_arena_alloc(&arena, ARENA_SIZE - 7) != NULL);
+    HT_EQ(arena.used, ARENA_SIZE);
+    HT_CHECK(mem_arena_alloc(&arena, 1) == NULL);
+
+    // 0バイトと、切り上げで桁あふれするサイズは失敗
+    mem_arena_reset(&arena);
+    HT_CHECK(mem_arena_alloc(&arena, 0) == NULL);
+    HT_CHECK(mem_arena_alloc(&arena, SIZE_MAX) == NULL);
+    HT_CHECK(mem_arena_alloc(&arena, SIZE_MAX - MEM_ARENA_ALIGN + 2) == NULL);
+    HT_EQ(arena.used, 0);
+
+    // バッファがアラインの端数より小さい
+    mem_arena_init(&arena, (uint8_t *)s_buf + 1, MEM_ARENA_ALIGN - 2);
+    HT_EQ(arena.size, 0);
+    HT_CHECK(mem_arena_alloc(&arena, 1) == NULL);
+}
+
+// markまで戻すと同じアドレスから確保し直す、先のmarkは無視、peakは残る
+static void test_mark_release(void)
+{
+    static uint64_t s_buf[ARENA_SIZE / 8];
+    mem_arena_t arena;
+
+    mem_arena_init(&arena, s_buf, sizeof(s_buf));
+    void *p_a = mem_arena_alloc(&arena, 100);
+    size_t mark = mem_arena_mark(&arena);
+    HT_EQ(mark, 104);
+    void *p_b = mem_arena_alloc(&arena, 300);
+    size_t inner = mem_arena_mark(&arena);
+    HT_CHECK(mem_arena_alloc(&arena, 50) != NULL);
+    mem_arena_release(&arena, inner);
+    HT_EQ(arena.used, 408);
+
+    mem_arena_release(&arena, mark);
+    HT_EQ(arena.used, mark);
+    HT_CHECK(mem_arena_alloc(&arena, 8) == p_b);
+    mem_arena_release(&arena, ARENA_SIZE);
+    HT_EQ(arena.used, mark + 8);
+    HT_EQ(arena.peak, 464);
+
+    mem_arena_reset(&arena);
+    HT_CHECK(mem_arena_alloc(&arena, 1) == p_a);
+    HT_EQ(arena.peak, 464);
+}
+
+static void test_calloc(void)
+{
+    static uint64_t s_buf[ARENA_SIZE / 8];
+    mem_arena_t arena;
+
+    memset(s_buf, 0xFF, sizeof(s_buf));
+    mem_arena_init(&arena, s_buf, sizeof(s_buf));
+    uint32_t *p = mem_arena_calloc(&arena, 10, sizeof(uint32_t));
+    HT_CHECK(p != NULL);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        HT_EQ(p[i], 0);
+    }
+    HT_CHECK(mem_arena_calloc(&arena, SIZE_MAX / 2, 4) == NULL);
+    HT_CHECK(mem_arena_calloc(&arena, 0, 4) == NULL);
+    HT_EQ(arena.fails, 2);
+    HT_EQ(arena.used, 40);
+}
+
+// 確保とmark/releaseを乱数で繰り返し、libcのmallocで持った写しと比べる(重なれば壊れる)
+static void test_random(void)
+{
+    static uint64_t s_buf[ARENA_SIZE / 8];
+    static uint8_t *s_p[64];
+    static uint8_t *s_copy[64];
+    static size_t s_len[64];
+    mem_arena_t arena;
+    uint32_t num = 0;
+
+    mem_arena_init(&arena, s_buf, sizeof(s_buf));
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        if (num > 0 && ht_rand_below(4) == 0) {
+            // 途中の確保まで戻す
+            uint32_t keep = ht_rand_below(num);
+            mem_arena_release(&arena, (size_t)(s_p[keep] - arena.p_base));
+            while (num > keep)
+            {
+                free(s_copy[--num]);
+            }
+        } else if (num < 64) {
+            size_t len = 1 + ht_rand_below(100);
+            uint8_t *p = mem_arena_alloc(&arena, len);
+            if (p != NULL) {
+                s_p[num] = p;
+                s_len[num] = len;
+                s_copy[num] = malloc(len);
+                for (size_t i = 0; i < len; i++)
+                {
+                    p[i] = s_copy[num][i] = (uint8_t)ht_rand();
+                }
+                num++;
+            }
+        }
+        for (uint32_t i = 0; i < num; i++)
+        {
+            HT_CHECK(memcmp(s_p[i], s_copy[i], s_len[i]) == 0);
+        }
+    }
+    while (num > 0)
+    {
+        free(s_copy[--num]);
+    }
+}
+
+int main(void)
+{
+    ht_srand(0xA7E4u);
+
+    HT_RUN(test_bounds_align);
+    HT_RUN(test_exact_fit);
+    HT_RUN(test_mark_release);
+    HT_RUN(test_calloc);
+    HT_RUN(test_random);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,280 @@
+/**
+ * @file test_mem_ops.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief mem_ops.cのテスト(検索/比較/フィルをlibcのmemchr/memmem/memcmpと乱数で比べる)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※長さ0～、先頭のずれ0～7で、アラインまでの端数、ワードの間、末尾の端数を全部通す
+ * ※mem_cpyが使うfast_memcpyはtest_membenchでmemcpyと比べている
+ */
+#define _GNU_SOURCE         // memmem
+#include "host_test.h"
+#include "mem_ops.h"
+#include <string.h>
+
+#define BUF_SIZE        2048
+#define GUARD           16
+#define RAND_ROUNDS     3000
+
+static uint32_t s_buf_a[(BUF_SIZE + 2 * GUARD) / 4];
+static uint32_t s_buf_b[(BUF_SIZE + 2 * GUARD) / 4];
+static uint8_t s_ref[BUF_SIZE + 2 * GUARD];
+
+// 乱数の長さ(短いものを多めに、たまに長いもの)
+static uint32_t rand_len(uint32_t r)
+{
+    if (r < 64) {
+        return r;
+    }
+
+    return (ht_rand_below(4) == 0) ? ht_rand_below(BUF_SIZE - 8) : ht_rand_below(200);
+}
+
+// 少ない種類のバイトで埋める(一致がたくさん出るように)
+static void fill_alpha(uint8_t *p_buf, uint32_t len, uint32_t alpha)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        p_buf[i] = (uint8_t)('a' + ht_rand_below(alpha));
+    }
+}
+
+static void test_invalid(void)
+{
+    mem_find_t find;
+    uint8_t pat[MEM_FIND_PAT_MAX + 1] = {0};
+    mem_cmp_result_t res;
+
+    HT_CHECK(!mem_find_init(&find, pat, 0, false));
+    HT_CHECK(!mem_find_init(&find, pat, MEM_FIND_PAT_MAX + 1, false));
+    HT_CHECK(mem_find_init(&find, pat, MEM_FIND_PAT_MAX, true));
+
+    // 長さ0、startが範囲外
+    HT_CHECK(mem_find_init(&find, pat, 1, false));
+    HT_EQ(mem_find_next(&find, pat, 0, 0), MEM_OPS_NONE);
+    HT_EQ(mem_find_next(&find, pat, 4, 4), MEM_OPS_NONE);
+    HT_EQ(mem_find_next(&find, pat, 4, 100), MEM_OPS_NONE);
+
+    mem_cmp(pat, pat, 0, &res);
+    HT_EQ(res.first, MEM_OPS_NONE);
+    HT_EQ(res.count + res.runs, 0);
+}
+
+// 【検索】startを前に見つけた所+1にして全部数え、libcで数えたものと一つずつ比べる
+static void check_find(const mem_find_t *p_find, const uint8_t *p_buf, uint32_t len, uint32_t start, bool is_aligned)
+{
+    const uint8_t *p_pat = p_find->pat;
+    uint32_t m = p_find->pat_len;
+    uint32_t pos = start;
+
+    for (;;)
+    {
+        const uint8_t *p_hit = NULL;
+        uint32_t expect = MEM_OPS_NONE;
+
+        // 参照: 1バイトはmemchr、それ以外はmemmem(アラインだけならずれた一致を飛ばす)
+        for (uint32_t from = pos; from < len; from = (uint32_t)(p_hit - p_buf) + 1)
+        {
+            p_hit = (m == 1) ? memchr(&p_buf[from], p_pat[0], len - from)
+                             : memmem(&p_buf[from], len - from, p_pat, m);
+            if (p_hit == NULL) {
+                break;
+            }
+            if (!is_aligned || ((uintptr_t)p_hit & 3) == 0) {
+                expect = (uint32_t)(p_hit - p_buf);
+                break;
+            }
+        }
+
+        uint32_t got = mem_find_next(p_find, p_buf, len, pos);
+        HT_EQ(got, expect);
+        if (got != expect || got == MEM_OPS_NONE) {
+            break;
+        }
+        pos = got + 1;
+    }
+}
+
+static void test_find_byte(void)
+{
+    uint8_t *p_base = (uint8_t *)s_buf_a + GUARD;
+    mem_find_t find;
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = rand_len(r);
+        uint8_t *p_buf = p_base + ht_rand_below(8);
+        uint8_t c = (uint8_t)('a' + ht_rand_below(20));
+
+        // 一致がまれなものと多いものの両方
+        fill_alpha(p_buf, len, (r & 1) ? 20 : 200);
+        HT_CHECK(mem_find_init(&find, &c, 1, false));
+        HT_EQ(find.mode, MEM_FIND_BYTE);
+        check_find(&find, p_buf, len, (len > 0) ? ht_rand_below(len) : 0, false);
+    }
+
+    // 0x80以上と0のバイト(SWARの境界)
+    p_base[0] = 0x00;
+    p_base[1] = 0x80;
+    p_base[2] = 0xFF;
+    p_base[3] = 0x7F;
+    for (uint32_t i = 4; i < 64; i++)
+    {
+        p_base[i] = 0x01;
+    }
+    p_base[61] = 0x00;
+    for (uint32_t c = 0; c < 256; c++)
+    {
+        uint8_t pat = (uint8_t)c;
+        mem_find_init(&find, &pat, 1, false);
+        check_find(&find, p_base, 64, 0, false);
+    }
+}
+
+// パターンの長さ2～32、半分はバッファから切り出して必ず一致させる
+static void test_find_bmh(void)
+{
+    uint8_t *p_base = (uint8_t *)s_buf_a + GUARD;
+    uint8_t pat[MEM_FIND_PAT_MAX];
+    mem_find_t find;
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = rand_len(r);
+        uint8_t *p_buf = p_base + ht_rand_below(8);
+        uint32_t m = 2 + ht_rand_below(MEM_FIND_PAT_MAX - 1);
+        uint32_t alpha = 2 + ht_rand_below(4);
+
+        fill_alpha(p_buf, len, alpha);
+        if (len >= m && ht_rand_below(2) == 0) {
+            memcpy(pat, &p_buf[ht_rand_below(len - m + 1)], m);
+        } else {
+            m = 2 + ht_rand_below(6);
+            fill_alpha(pat, m, alpha);
+        }
+        HT_CHECK(mem_find_init(&find, pat, m, false));
+        HT_EQ(find.mode, MEM_FIND_BMH);
+        check_find(&find, p_buf, len, 0, false);
+    }
+}
+
+// アラインしたアドレスだけ(パターンが4バイト未満、ちょうど、より長いもの)
+static void test_find_word(void)
+{
+    uint8_t *p_base = (uint8_t *)s_buf_a + GUARD;
+    uint8_t pat[MEM_FIND_PAT_MAX];
+    mem_find_t find;
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = rand_len(r);
+        uint8_t *p_buf = p_base + ht_rand_below(8);
+        uint32_t m = 1 + ht_rand_below((r & 1) ? 4 : MEM_FIND_PAT_MAX);
+        uint32_t alpha = 2 + ht_rand_below(3);
+
+        fill_alpha(p_buf, len, alpha);
+        if (len >= m && ht_rand_below(2) == 0) {
+            memcpy(pat, &p_buf[ht_rand_below(len - m + 1)], m);
+        } else {
+            fill_alpha(pat, m, alpha);
+        }
+        HT_CHECK(mem_find_init(&find, pat, m, true));
+        HT_EQ(find.mode, MEM_FIND_WORD);
+        check_find(&find, p_buf, len, (len > 0) ? ht_rand_below(len) : 0, true);
+    }
+}
+
+// 【比較】一致していればmemcmpも0、最初の不一致の前はmemcmpで一致、数と区間はバイトごとに数えた値
+static void test_cmp(void)
+{
+    uint8_t *p_base_a = (uint8_t *)s_buf_a + GUARD;
+    uint8_t *p_base_b = (uint8_t *)s_buf_b + GUARD;
+    mem_cmp_result_t res;
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = rand_len(r);
+        uint8_t *p_a = p_base_a + ht_rand_below(8);
+        uint8_t *p_b = p_base_b + ht_rand_below(8);
+        uint32_t diffs = (r % 3 == 0) ? 0 : 1 + ht_rand_below(1 + len / 8);
+
+        fill_alpha(p_a, len, 256);
+        memcpy(p_b, p_a, len);
+        for (uint32_t d = 0; d < diffs && len > 0; d++)
+        {
+            // 1～5バイトの違う区間
+            uint32_t at = ht_rand_below(len);
+            uint32_t n = 1 + ht_rand_below(5);
+            for (uint32_t i = at; i < at + n && i < len; i++)
+            {
+                p_b[i] = (uint8_t)(p_a[i] ^ (1 + ht_rand_below(255)));
+            }
+        }
+
+        uint32_t count = 0;
+        uint32_t runs = 0;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            if (p_a[i] != p_b[i]) {
+                count++;
+                if (i == 0 || p_a[i - 1] == p_b[i - 1]) {
+                    runs++;
+                }
+            }
+        }
+
+        mem_cmp(p_a, p_b, len, &res);
+        HT_EQ(res.count, count);
+        HT_EQ(res.runs, runs);
+        if (memcmp(p_a, p_b, len) == 0) {
+            HT_EQ(res.first, MEM_OPS_NONE);
+        } else {
+            HT_CHECK(res.first < len);
+            HT_CHECK(memcmp(p_a, p_b, res.first) == 0);
+            HT_CHECK(p_a[res.first] != p_b[res.first]);
+        }
+    }
+}
+
+// 【フィル】アドレスの下位2bitのレーンのバイト、前後は壊さない
+static void test_fill(void)
+{
+    uint8_t *p_all = (uint8_t *)s_buf_a;
+    uint32_t all = sizeof(s_buf_a);
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t len = rand_len(r);
+        uint32_t off = GUARD + ht_rand_below(8);
+        uint32_t val = ht_rand();
+        uint8_t lane[4];
+
+        fill_alpha(p_all, all, 256);
+        memcpy(s_ref, p_all, all);
+        memcpy(lane, &val, sizeof(lane));      // リトルエンディアン
+        for (uint32_t i = off; i < off + len; i++)
+        {
+            s_ref[i] = lane[(uintptr_t)&p_all[i] & 3];
+        }
+
+        mem_fill32(&p_all[off], len, val);
+        HT_CHECK(memcmp(p_all, s_ref, all) == 0);
+    }
+}
+
+int main(void)
+{
+    ht_srand(0x3E30u);
+
+    HT_RUN(test_invalid);
+    HT_RUN(test_find_byte);
+    HT_RUN(test_find_bmh);
+    HT_RUN(test_find_word);
+    HT_RUN(test_cmp);
+    HT_RUN(test_fill);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,248 @@
+/**
+ * @file test_mem_pool.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief mem_pool.cのテスト(枯渇、所有判定、サイズの振り分け、他コアからの解放と引き取り)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※コアはpthreadのスレッドで模擬する(コア番号はスレッドごとの変数)
+ */
+#include "host_test.h"
+#include "mem_pool.h"
+#include <pthread.h>
+#include <string.h>
+
+#define TEST_BLOCK_SIZE     32
+#define TEST_BLOCK_NUM      64
+#define REMOTE_THREADS      2       // 同時に解放する「他コア」の数
+#define REMOTE_ROUNDS       300
+
+static __thread uint32_t s_core;
+static uint32_t s_irq_depth;
+static uint32_t s_irq_saves;
+
+static uint32_t fake_core_num(void)
+{
+    return s_core;
+}
+
+// 所有コアだけが呼ぶ(他コアからの解放は割り込みを禁止しない)
+static uint32_t fake_irq_save(void)
+{
+    s_irq_saves++;
+    return s_irq_depth++;
+}
+
+static void fake_irq_restore(uint32_t save)
+{
+    s_irq_depth = save;
+}
+
+static const mem_pool_ops_t s_fake_ops = {
+    .core_num = fake_core_num,
+    .irq_save = fake_irq_save,
+    .irq_restore = fake_irq_restore,
+};
+
+static uint64_t s_mem[TEST_BLOCK_SIZE * TEST_BLOCK_NUM / 8];
+static mem_pool_t s_pool;
+
+static void test_init(void)
+{
+    HT_CHECK(!mem_pool_init(&s_pool, s_mem, 2, 4, 0));
+    HT_CHECK(!mem_pool_init(&s_pool, s_mem, sizeof(void *) + 1, 4, 0));
+    HT_CHECK(mem_pool_init(&s_pool, s_mem, TEST_BLOCK_SIZE, TEST_BLOCK_NUM, 0));
+    HT_EQ(s_pool.used + s_pool.peak + s_pool.fails + s_pool.remote_frees, 0);
+}
+
+// 先頭から順に確保し、全部使ったらNULLで失敗を数える。解放すればまた使える
+static void test_exhaust(void)
+{
+    static void *s_p[TEST_BLOCK_NUM];
+
+    mem_pool_sys_init(&s_fake_ops);
+    s_core = 0;
+    mem_pool_init(&s_pool, s_mem, TEST_BLOCK_SIZE, TEST_BLOCK_NUM, 0);
+    for (uint32_t i = 0; i < TEST_BLOCK_NUM; i++)
+    {
+        s_p[i] = mem_pool_get(&s_pool);
+        HT_CHECK(s_p[i] == (uint8_t *)s_mem + i * TEST_BLOCK_SIZE);
+        memset(s_p[i], (int)i, TEST_BLOCK_SIZE);
+    }
+    HT_EQ(s_pool.used, TEST_BLOCK_NUM);
+    HT_CHECK(mem_pool_get(&s_pool) == NULL);
+    HT_CHECK(mem_pool_get(&s_pool) == NULL);
+    HT_EQ(s_pool.fails, 2);
+    HT_EQ(s_pool.peak, TEST_BLOCK_NUM);
+
+    // 最後に解放したものから再利用(LIFO)
+    mem_pool_put(&s_pool, s_p[5]);
+    mem_pool_put(&s_pool, s_p[9]);
+    HT_EQ(s_pool.used, TEST_BLOCK_NUM - 2);
+    HT_CHECK(mem_pool_get(&s_pool) == s_p[9]);
+    HT_CHECK(mem_pool_get(&s_pool) == s_p[5]);
+    HT_CHECK(mem_pool_get(&s_pool) == NULL);
+    HT_EQ(s_pool.remote_frees, 0);
+
+    // 割り込み禁止は対になっている
+    HT_EQ(s_irq_depth, 0);
+    HT_CHECK(s_irq_saves >= TEST_BLOCK_NUM);
+}
+
+static void test_owns(void)
+{
+    uint8_t *p_mem = (uint8_t *)s_mem;
+
+    mem_pool_init(&s_pool, s_mem, TEST_BLOCK_SIZE, TEST_BLOCK_NUM, 0);
+    HT_CHECK(mem_pool_owns(&s_pool, p_mem));
+    HT_CHECK(mem_pool_owns(&s_pool, p_mem + TEST_BLOCK_SIZE * (TEST_BLOCK_NUM - 1)));
+    HT_CHECK(!mem_pool_owns(&s_pool, p_mem + TEST_BLOCK_SIZE * TEST_BLOCK_NUM));
+    HT_CHECK(!mem_pool_owns(&s_pool, p_mem + 8));
+    HT_CHECK(!mem_pool_owns(&s_pool, p_mem - TEST_BLOCK_SIZE));
+    HT_CHECK(!mem_pool_owns(&s_pool, NULL));
+}
+
+// 合うサイズから取り、空なら1つ大きいサイズ、大きすぎればNULL
+static void test_sys_alloc(void)
+{
+    static void *s_p[MEM_POOL_S_NUM + MEM_POOL_M_NUM + MEM_POOL_L_NUM + 1];
+    uint32_t num = 0;
+
+    mem_pool_sys_init(&s_fake_ops);
+    s_core = 1;
+    HT_CHECK(mem_pool_alloc(MEM_POOL_L_SIZE + 1) == NULL);
+    for (uint32_t i = 0; i < MEM_POOL_S_NUM; i++)
+    {
+        s_p[num] = mem_pool_alloc(1 + (i % MEM_POOL_S_SIZE));
+        HT_CHECK(mem_pool_owns(mem_pool_sys_get(1, 0), s_p[num]));
+        num++;
+    }
+    s_p[num] = mem_pool_alloc(MEM_POOL_S_SIZE);
+    HT_CHECK(mem_pool_owns(mem_pool_sys_get(1, 1), s_p[num]));
+    num++;
+    while ((s_p[num] = mem_pool_alloc(MEM_POOL_S_SIZE)) != NULL)
+    {
+        num++;
+    }
+    HT_EQ(num, MEM_POOL_S_NUM + MEM_POOL_M_NUM + MEM_POOL_L_NUM);
+    HT_EQ(mem_pool_sys_get(1, 2)->used, MEM_POOL_L_NUM);
+    HT_EQ(mem_pool_sys_get(0, 0)->used, 0);
+    HT_EQ(mem_pool_sys_get(1, 0)->fails, num - MEM_POOL_S_NUM + 1);
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        mem_pool_free(s_p[i]);
+    }
+    mem_pool_free(NULL);
+    mem_pool_free(s_mem);       // どのプールのものでもなければ何もしない
+    for (uint32_t i = 0; i < MEM_POOL_CLASS_NUM; i++)
+    {
+        HT_EQ(mem_pool_sys_get(1, i)->used, 0);
+    }
+    HT_CHECK(mem_pool_sys_get(MEM_POOL_CORE_NUM, 0) == NULL);
+    HT_CHECK(mem_pool_sys_get(0, MEM_POOL_CLASS_NUM) == NULL);
+
+    s_core = MEM_POOL_CORE_NUM;
+    HT_CHECK(mem_pool_alloc(8) == NULL);
+}
+
+// 【他コアからの解放】
+// 所有コア(core0)が全ブロックを確保して他コアのスレッドに渡し、他コアは中身を書いて
+// 同時に解放する。所有コアはその間も確保を続け、p_remoteから引き取って全部取り戻す
+typedef struct {
+    void **pp_block;
+    uint32_t num;
+    uint32_t tag;
+} remote_job_t;
+
+static void *remote_free_thread(void *p_arg)
+{
+    const remote_job_t *p_job = (const remote_job_t *)p_arg;
+
+    s_core = 1;
+    for (uint32_t i = 0; i < p_job->num; i++)
+    {
+        memset(p_job->pp_block[i], (int)p_job->tag, TEST_BLOCK_SIZE);
+        mem_pool_put(&s_pool, p_job->pp_block[i]);
+    }
+
+    return NULL;
+}
+
+static void test_remote_free_drain(void)
+{
+    static void *s_p[TEST_BLOCK_NUM];
+    static uint8_t s_seen[TEST_BLOCK_NUM];
+    static uint8_t s_tag[TEST_BLOCK_NUM];      // ブロックを解放するスレッドが書く値
+    pthread_t thread[REMOTE_THREADS];
+    remote_job_t job[REMOTE_THREADS];
+    uint32_t per_thread = TEST_BLOCK_NUM / REMOTE_THREADS;
+
+    mem_pool_sys_init(&s_fake_ops);
+    s_core = 0;
+    mem_pool_init(&s_pool, s_mem, TEST_BLOCK_SIZE, TEST_BLOCK_NUM, 0);
+    for (uint32_t round = 0; round < REMOTE_ROUNDS; round++)
+    {
+        for (uint32_t i = 0; i < TEST_BLOCK_NUM; i++)
+        {
+            s_p[i] = mem_pool_get(&s_pool);
+            s_tag[((uint8_t *)s_p[i] - (uint8_t *)s_mem) / TEST_BLOCK_SIZE] = (uint8_t)(0xA0 + i / per_thread);
+        }
+        HT_CHECK(mem_pool_get(&s_pool) == NULL);
+
+        for (uint32_t t = 0; t < REMOTE_THREADS; t++)
+        {
+            job[t].pp_block = &s_p[t * per_thread];
+            job[t].num = per_thread;
+            job[t].tag = 0xA0 + t;
+            HT_CHECK(pthread_create(&thread[t], NULL, remote_free_thread, &job[t]) == 0);
+        }
+
+        // 解放されるそばから引き取る(空いていなければNULLが返るだけ)
+        memset(s_seen, 0, sizeof(s_seen));
+        uint32_t got = 0;
+        while (got < TEST_BLOCK_NUM)
+        {
+            uint8_t *p = mem_pool_get(&s_pool);
+            if (p == NULL) {
+                continue;
+            }
+            uint32_t idx = (uint32_t)((p - (uint8_t *)s_mem) / TEST_BLOCK_SIZE);
+            HT_CHECK(mem_pool_owns(&s_pool, p));
+            HT_CHECK(s_seen[idx] == 0);
+            HT_CHECK(p[TEST_BLOCK_SIZE - 1] == s_tag[idx]);
+            s_seen[idx] = 1;
+            got++;
+        }
+        for (uint32_t t = 0; t < REMOTE_THREADS; t++)
+        {
+            pthread_join(thread[t], NULL);
+        }
+
+        HT_EQ(s_pool.used, TEST_BLOCK_NUM);
+        HT_CHECK(s_pool.p_free == NULL && s_pool.p_remote == NULL);
+
+        // 所有コアから全部返す
+        for (uint32_t i = 0; i < TEST_BLOCK_NUM; i++)
+        {
+            mem_pool_put(&s_pool, &((uint8_t *)s_mem)[i * TEST_BLOCK_SIZE]);
+        }
+        HT_EQ(s_pool.used, 0);
+    }
+    HT_EQ(s_pool.remote_frees, REMOTE_ROUNDS * TEST_BLOCK_NUM);
+    HT_EQ(s_pool.peak, TEST_BLOCK_NUM);
+    HT_EQ(s_irq_depth, 0);
+}
+
+int main(void)
+{
+    HT_RUN(test_init);
+    HT_RUN(test_exhaust);
+    HT_RUN(test_owns);
+    HT_RUN(test_sys_alloc);
+    HT_RUN(test_remote_free_drain);
+
+    return HT_RESULT();
+}
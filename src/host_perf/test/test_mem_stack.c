@@ -0,0 +1,52 @@
+/**
+ * @file test_mem_stack.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief mem_stack.cのテスト(塗りつぶしと最大使用量)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "mem_stack.h"
+
+#define STACK_WORDS     256
+
+static uint32_t s_stack[STACK_WORDS + 2];   // 前後1ワードは番兵
+
+// 上端から下に向かって使った分だけ数える(途中に塗った値と同じ値があっても最深部まで)
+static void test_used(void)
+{
+    uint32_t *p_lo = &s_stack[1];
+    uint32_t *p_hi = &s_stack[1 + STACK_WORDS];
+
+    s_stack[0] = 0x11111111u;
+    s_stack[STACK_WORDS + 1] = 0x22222222u;
+    mem_stack_paint(p_lo, p_hi);
+    HT_EQ(s_stack[0], 0x11111111u);
+    HT_EQ(s_stack[STACK_WORDS + 1], 0x22222222u);
+    HT_EQ(mem_stack_used(p_lo, p_hi), 0);
+
+    p_hi[-1] = 0;
+    HT_EQ(mem_stack_used(p_lo, p_hi), 4);
+
+    p_hi[-100] = 0x12345678u;
+    p_hi[-50] = MEM_STACK_PAINT;
+    HT_EQ(mem_stack_used(p_lo, p_hi), 400);
+
+    p_lo[0] = 0;
+    HT_EQ(mem_stack_used(p_lo, p_hi), STACK_WORDS * 4);
+
+    // 塗り直せば0に戻る
+    mem_stack_paint(p_lo, p_hi);
+    HT_EQ(mem_stack_used(p_lo, p_hi), 0);
+    HT_EQ(mem_stack_used(p_lo, p_lo), 0);
+}
+
+int main(void)
+{
+    HT_RUN(test_used);
+
+    return HT_RESULT();
+}
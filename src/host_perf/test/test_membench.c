@@ -0,0 +1,124 @@
+/**
+ * @file test_membench.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief fast_mem.c/membench.cのテスト(libcとの一致、前後を壊さない、STREAMの期待値)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "fast_mem.h"
+#include "membench.h"
+#include <string.h>
+
+#define BUF_SIZE        1024
+#define GUARD           16      // 前後に置く番兵のバイト数
+#define RAND_ROUNDS     3000
+#define STREAM_N        1000
+#define STREAM_ROUNDS   5
+
+static uint8_t s_src[BUF_SIZE + 2 * GUARD];
+static uint8_t s_dst[BUF_SIZE + 2 * GUARD];
+static uint8_t s_ref[BUF_SIZE + 2 * GUARD];
+
+static void fill_rand(uint8_t *p_buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        p_buf[i] = (uint8_t)ht_rand();
+    }
+}
+
+// 長さ0～、転送先/転送元の境界のずれ0～7(先頭と末尾の端数、ブロックの境目を全部通る)
+static void test_fast_memcpy(void)
+{
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        size_t len = (r < 200) ? r : ht_rand_below(BUF_SIZE - 8);
+        size_t d_off = GUARD + ht_rand_below(8);
+        size_t s_off = GUARD + ht_rand_below(8);
+
+        fill_rand(s_src, sizeof(s_src));
+        fill_rand(s_dst, sizeof(s_dst));
+        memcpy(s_ref, s_dst, sizeof(s_dst));
+        memcpy(&s_ref[d_off], &s_src[s_off], len);
+
+        void *p_ret = fast_memcpy(&s_dst[d_off], &s_src[s_off], len);
+        HT_CHECK(p_ret == &s_dst[d_off]);
+        HT_CHECK(memcmp(s_dst, s_ref, sizeof(s_dst)) == 0);
+    }
+}
+
+static void test_fast_memset(void)
+{
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        size_t len = (r < 200) ? r : ht_rand_below(BUF_SIZE - 8);
+        size_t d_off = GUARD + ht_rand_below(8);
+        int val = (r & 1) ? 0 : (int)ht_rand_below(256);
+
+        fill_rand(s_dst, sizeof(s_dst));
+        memcpy(s_ref, s_dst, sizeof(s_dst));
+        memset(&s_ref[d_off], val, len);
+
+        void *p_ret = fast_memset(&s_dst[d_off], val, len);
+        HT_CHECK(p_ret == &s_dst[d_off]);
+        HT_CHECK(memcmp(s_dst, s_ref, sizeof(s_dst)) == 0);
+    }
+}
+
+// STREAMの4カーネルをSTREAM_ROUNDS周回した結果が期待値と一致
+static void test_stream(void)
+{
+    static float s_a[STREAM_N], s_b[STREAM_N], s_c[STREAM_N];
+    membench_stream_t stream = {s_a, s_b, s_c, STREAM_N};
+
+    membench_stream_init(&stream);
+    for (uint32_t r = 0; r < STREAM_ROUNDS; r++)
+    {
+        membench_stream_run(&stream, MEMBENCH_COPY);
+        membench_stream_run(&stream, MEMBENCH_SCALE);
+        membench_stream_run(&stream, MEMBENCH_ADD);
+        membench_stream_run(&stream, MEMBENCH_TRIAD);
+    }
+    HT_CHECK(membench_stream_check(&stream, STREAM_ROUNDS));
+    HT_CHECK(!membench_stream_check(&stream, STREAM_ROUNDS + 1));
+
+    s_b[STREAM_N / 2] += 1.0f;
+    HT_CHECK(!membench_stream_check(&stream, STREAM_ROUNDS));
+
+    // memcpy/memsetのカーネルはc[]だけを書く
+    membench_stream_init(&stream);
+    membench_stream_run(&stream, MEMBENCH_MEMCPY);
+    HT_CHECK(s_c[0] == 1.0f && s_c[STREAM_N - 1] == 1.0f && s_b[0] == 2.0f);
+    membench_stream_run(&stream, MEMBENCH_MEMSET);
+    HT_CHECK(s_c[0] == 0.0f && s_c[STREAM_N - 1] == 0.0f && s_a[0] == 1.0f);
+}
+
+// 帯域の計算に使うバイト数(STREAMの数え方)
+static void test_kernel_bytes(void)
+{
+    HT_EQ(membench_kernel_bytes(MEMBENCH_COPY, 100), 800);
+    HT_EQ(membench_kernel_bytes(MEMBENCH_SCALE, 100), 800);
+    HT_EQ(membench_kernel_bytes(MEMBENCH_ADD, 100), 1200);
+    HT_EQ(membench_kernel_bytes(MEMBENCH_TRIAD, 100), 1200);
+    HT_EQ(membench_kernel_bytes(MEMBENCH_MEMCPY, 100), 800);
+    HT_EQ(membench_kernel_bytes(MEMBENCH_MEMSET, 100), 400);
+    HT_CHECK(membench_mbps(1000000, 1000) == 1000.0f);
+    HT_CHECK(membench_mbps(1000000, 0) == 0.0f);
+    HT_CHECK(strcmp(membench_kernel_name(MEMBENCH_TRIAD), "triad") == 0);
+}
+
+int main(void)
+{
+    ht_srand(0x3E3Bu);
+
+    HT_RUN(test_fast_memcpy);
+    HT_RUN(test_fast_memset);
+    HT_RUN(test_stream);
+    HT_RUN(test_kernel_bytes);
+
+    return HT_RESULT();
+}
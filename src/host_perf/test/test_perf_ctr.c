@@ -0,0 +1,194 @@
+/**
+ * @file test_perf_ctr.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief perf_ctr.cのテスト(perf_ctr_stub.cで模擬したカウンタの差分、折り返し、累計)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "perf_ctr.h"
+#include <string.h>
+
+#define CPU_HZ  150000000u
+
+static void measure(uint32_t us, uint32_t active_pct, uint32_t xip_acc, uint32_t xip_miss,
+                    perf_delta_t *p_delta)
+{
+    perf_snap_t before, after;
+
+    perf_snapshot(&before);
+    perf_stub_advance(us, active_pct, xip_acc, xip_miss);
+    perf_snapshot(&after);
+    perf_delta(&before, &after, p_delta);
+}
+
+static void test_not_ready(void)
+{
+    perf_snap_t snap;
+    perf_delta_t delta;
+
+    perf_init(NULL);
+    HT_CHECK(!perf_is_ready());
+    memset(&snap, 0xA5, sizeof(snap));
+    perf_snapshot(&snap);
+    HT_EQ(snap.cyc + snap.us + snap.xip_acc, 0);
+    perf_delta(&snap, &snap, &delta);
+    HT_EQ(delta.cpu_hz, 0);
+    HT_CHECK(perf_active_rate(&delta) == 0.0f);
+}
+
+// 短い区間は8bitのイベントカウンタも使える、長い区間は使えない
+static void test_delta(void)
+{
+    perf_delta_t delta;
+
+    perf_init(&g_perf_stub_ops);
+    perf_stub_reset(100000000u);
+    HT_CHECK(perf_is_ready());
+
+    measure(2, 50, 0, 0, &delta);
+    HT_EQ(delta.us, 2);
+    HT_EQ(delta.cyc, 100);
+    HT_CHECK(delta.is_evt_valid);
+    HT_EQ(delta.sleep, 100);
+    HT_EQ(delta.cpi, 12);
+    HT_EQ(delta.lsu, 25);
+    HT_CHECK(perf_active_rate(&delta) == 0.5f);
+
+    perf_stub_reset(CPU_HZ);
+    measure(1000, 100, 5000, 250, &delta);
+    HT_EQ(delta.cpu_hz, CPU_HZ);
+    HT_EQ(delta.cyc, 150000);
+    HT_CHECK(!delta.is_evt_valid);
+    HT_EQ(delta.xip_acc, 5000);
+    HT_EQ(delta.xip_miss, 250);
+    HT_CHECK(perf_active_rate(&delta) == 1.0f);
+    HT_CHECK(perf_xip_miss_per_kcycle(delta.xip_miss, delta.cyc) == 250.0f * 1000.0f / 150000.0f);
+    HT_CHECK(perf_xip_miss_per_kcycle(10, 0) == 0.0f);
+}
+
+// CYCCNT(32bit)が何周しても経過時間から戻せる(150MHzで約28.6秒で1周)
+static void test_cyc_wrap(void)
+{
+    perf_delta_t delta;
+
+    perf_init(&g_perf_stub_ops);
+    perf_stub_reset(CPU_HZ);
+    perf_stub_advance(4000000u, 100, 0, 0);     // 読み出し開始時点で周回の途中
+
+    measure(60000000u, 100, 0, 0, &delta);
+    HT_EQ(delta.cyc, 60ULL * CPU_HZ);
+    HT_CHECK(perf_active_rate(&delta) == 1.0f);
+
+    measure(28000000u, 100, 0, 0, &delta);
+    HT_EQ(delta.cyc, 28ULL * CPU_HZ);
+
+    // 周回時間より短いスリープなら補正しすぎない
+    measure(20000000u, 50, 0, 0, &delta);
+    HT_EQ(delta.cyc, 10ULL * CPU_HZ);
+    HT_CHECK(perf_active_rate(&delta) == 0.5f);
+}
+
+// XIPのヒットがアクセスを追い越して見えても負にならない
+static void test_xip_miss(void)
+{
+    perf_snap_t before = {0};
+    perf_snap_t after = {0};
+    perf_delta_t delta;
+
+    perf_init(&g_perf_stub_ops);
+    before.xip_acc = 0xFFFFFFF0u;
+    before.xip_hit = 0xFFFFFFF0u;
+    after.xip_acc = 0x10;
+    after.xip_hit = 0x12;
+    perf_delta(&before, &after, &delta);
+    HT_EQ(delta.xip_acc, 0x20);
+    HT_EQ(delta.xip_miss, 0);
+}
+
+static void test_format(void)
+{
+    perf_delta_t delta;
+    char buf[512];
+
+    perf_init(&g_perf_stub_ops);
+    perf_stub_reset(CPU_HZ);
+    measure(1000, 100, 5000, 250, &delta);
+    int32_t len = perf_format_delta(buf, sizeof(buf), &delta);
+    HT_EQ(len, (int32_t)strlen(buf));
+    HT_CHECK(strstr(buf, "  wall time  : 1000 us\n") != NULL);
+    HT_CHECK(strstr(buf, "  cycles     : 150000 (150.0 MHz, 100.0 % active)\n") != NULL);
+    HT_CHECK(strstr(buf, "acc 5000, miss 250 (1.667 miss/kcycle)") != NULL);
+    HT_CHECK(strstr(buf, "n/a (8-bit counters wrap after 256 cycles)") != NULL);
+
+    perf_stub_reset(100000000u);
+    measure(1, 100, 0, 0, &delta);
+    HT_CHECK(perf_format_delta(buf, sizeof(buf), &delta) > 0);
+    HT_CHECK(strstr(buf, "  DWT events : cpi 12, exc 0, sleep 0, lsu 25, fold 0\n") != NULL);
+
+    // 入りきらなければsnprintfと同じく必要な長さを返す
+    len = perf_format_delta(buf, 16, &delta);
+    HT_CHECK(len >= 16 && strlen(buf) == 15);
+}
+
+// 累計はコマンドごと、取り出しはサイクル数の多い順、表が埋まったら新しいものは数えない
+static void test_total(void)
+{
+    static char s_name[PERF_TOTAL_MAX + 1][8];
+    const perf_total_t *p_out[PERF_TOTAL_MAX];
+    perf_delta_t delta = {0};
+
+    perf_total_clear();
+    HT_EQ(perf_total_sorted(p_out, PERF_TOTAL_MAX), 0);
+    for (uint32_t i = 0; i <= PERF_TOTAL_MAX; i++)
+    {
+        s_name[i][0] = (char)('A' + (i % 26));
+        delta.cyc = 1000 + (uint64_t)ht_rand_below(100000);
+        delta.us = i;
+        delta.xip_acc = 10;
+        delta.xip_miss = 1;
+        perf_total_add(i, s_name[i], &delta);
+    }
+    delta.cyc = 1ULL << 40;
+    delta.us = 7;
+    perf_total_add(3, s_name[3], &delta);
+    delta.us = 1;
+    perf_total_add(3, s_name[3], &delta);
+
+    HT_EQ(perf_total_sorted(p_out, PERF_TOTAL_MAX), PERF_TOTAL_MAX);
+    HT_EQ(p_out[0]->key, 3);
+    HT_EQ(p_out[0]->calls, 3);
+    HT_EQ(p_out[0]->us, 3 + 7 + 1);
+    HT_EQ(p_out[0]->max_us, 7);
+    HT_EQ(p_out[0]->xip_acc, 30);
+    HT_EQ(p_out[0]->xip_miss, 3);
+    HT_CHECK(p_out[0]->p_name == s_name[3]);
+    for (uint32_t i = 1; i < PERF_TOTAL_MAX; i++)
+    {
+        HT_CHECK(p_out[i - 1]->cyc >= p_out[i]->cyc);
+        HT_CHECK(p_out[i]->key != PERF_TOTAL_MAX);
+    }
+
+    HT_EQ(perf_total_sorted(p_out, 1), 1);
+    HT_EQ(p_out[0]->key, 3);
+    HT_EQ(perf_total_sorted(p_out, 0), 0);
+    perf_total_clear();
+    HT_EQ(perf_total_sorted(p_out, PERF_TOTAL_MAX), 0);
+}
+
+int main(void)
+{
+    ht_srand(0x9E2Fu);
+
+    HT_RUN(test_not_ready);
+    HT_RUN(test_delta);
+    HT_RUN(test_cyc_wrap);
+    HT_RUN(test_xip_miss);
+    HT_RUN(test_format);
+    HT_RUN(test_total);
+
+    return HT_RESULT();
+}
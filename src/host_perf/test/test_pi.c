@@ -0,0 +1,211 @@
+/**
+ * @file test_pi.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief pi_chud.c/bignum.cのテスト(既知の桁との照合、区間の分割と結合、多倍長演算)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "pi_chud.h"
+#include "bignum.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PI_TEST_DIGITS_MAX  PI_CHUD_VERIFY_DIGITS
+
+// 円周率の小数点以下100桁(pi_chud.cの表とは別に持つ)
+static const char s_pi_100[] =
+    "3."
+    "1415926535" "8979323846" "2643383279" "5028841971" "6939937510"
+    "5820974944" "5923078164" "0628620899" "8628034825" "3421170679";
+
+static char s_out[PI_TEST_DIGITS_MAX + 3];
+static char s_out2[PI_TEST_DIGITS_MAX + 3];
+
+static bool pi_calc(uint32_t digits, uint32_t split, char *p_out)
+{
+    uint32_t terms = pi_chud_terms(digits);
+    pi_chud_pqt_t pqt;
+    bool is_ok;
+
+    pi_chud_pqt_init(&pqt);
+    if (split == 0) {
+        is_ok = pi_chud_bs(0, terms, &pqt);
+    } else {
+        // dbg_comのデュアルコア版と同じ(前半と後半を別に計算して結合)
+        pi_chud_pqt_t right;
+        pi_chud_pqt_init(&right);
+        is_ok = pi_chud_bs(0, split, &pqt) && pi_chud_bs(split, terms, &right);
+        is_ok = is_ok && pi_chud_merge(&pqt, &right);
+        if (!is_ok) {
+            pi_chud_pqt_free(&right);
+        }
+    }
+    is_ok = is_ok && pi_chud_finish(&pqt, digits, p_out);
+    pi_chud_pqt_free(&pqt);
+
+    return is_ok;
+}
+
+static void test_pi_short(void)
+{
+    static const uint32_t s_digits_tbl[] = {1, 2, 9, 10, 14, 15, 50, 99, 100};
+
+    for (uint32_t i = 0; i < sizeof(s_digits_tbl) / sizeof(s_digits_tbl[0]); i++)
+    {
+        uint32_t digits = s_digits_tbl[i];
+        HT_CHECK(pi_calc(digits, 0, s_out));
+        HT_EQ(strlen(s_out), digits + 2);
+        HT_CHECK(strncmp(s_out, s_pi_100, digits + 2) == 0);
+        HT_EQ(pi_chud_verify(s_out, digits), digits);
+    }
+}
+
+// 1000桁ごとのチェックポイントまで全部照合できる
+static void test_pi_long(void)
+{
+    static const uint32_t s_digits_tbl[] = {1000, 1001, 2500, PI_TEST_DIGITS_MAX};
+
+    for (uint32_t i = 0; i < sizeof(s_digits_tbl) / sizeof(s_digits_tbl[0]); i++)
+    {
+        uint32_t digits = s_digits_tbl[i];
+        HT_CHECK(pi_calc(digits, 0, s_out));
+        HT_CHECK(strncmp(s_out, s_pi_100, sizeof(s_pi_100) - 1) == 0);
+        HT_EQ(pi_chud_verify(s_out, digits), (digits / 1000) * 1000);
+    }
+}
+
+// 区間をどこで分けても結果は同じ
+static void test_pi_split(void)
+{
+    uint32_t digits = 3000;
+    uint32_t terms = pi_chud_terms(digits);
+    uint32_t split_tbl[] = {1, pi_chud_split_point(terms), terms / 2, terms - 1};
+
+    HT_CHECK(pi_calc(digits, 0, s_out));
+    for (uint32_t i = 0; i < sizeof(split_tbl) / sizeof(split_tbl[0]); i++)
+    {
+        HT_CHECK(pi_calc(digits, split_tbl[i], s_out2));
+        HT_CHECK(strcmp(s_out, s_out2) == 0);
+    }
+    HT_CHECK(pi_chud_split_point(terms) > 0 && pi_chud_split_point(terms) < terms);
+}
+
+// 間違った桁は検出する
+static void test_pi_verify_reject(void)
+{
+    uint32_t digits = 2000;
+
+    HT_CHECK(pi_calc(digits, 0, s_out));
+    memcpy(s_out2, s_out, digits + 3);
+    s_out2[2 + 49] = (s_out2[2 + 49] == '0') ? '1' : '0';
+    HT_EQ(pi_chud_verify(s_out2, digits), 0);
+
+    memcpy(s_out2, s_out, digits + 3);
+    s_out2[1 + 1995] ^= 0x01;
+    HT_EQ(pi_chud_verify(s_out2, digits), 0);
+
+    memcpy(s_out2, s_out, digits + 3);
+    s_out2[0] = '4';
+    HT_EQ(pi_chud_verify(s_out2, digits), 0);
+}
+
+// 乱数でnリムの多倍長整数を作る
+static void bn_rand(bignum_t *p_bn, uint32_t limbs)
+{
+    bignum_t limb;
+
+    bn_init(&limb);
+    bn_set_u64(p_bn, 0);
+    for (uint32_t i = 0; i < limbs; i++)
+    {
+        bn_shl(p_bn, p_bn, 32);
+        bn_set_u64(&limb, ht_rand() | ((i == 0) ? 1u : 0u));
+        bn_add(p_bn, p_bn, &limb);
+    }
+    bn_free(&limb);
+}
+
+// Karatsubaは筆算と同じ結果(閾値の前後と長さが大きく違う場合)
+static void test_bn_karatsuba(void)
+{
+    static const uint32_t s_len_tbl[][2] = {
+        {1, 1}, {23, 23}, {24, 24}, {25, 24}, {47, 30}, {64, 64}, {100, 25}, {200, 13}, {131, 97},
+    };
+    static uint32_t s_a[256], s_b[256], s_r1[512], s_r2[512];
+
+    for (uint32_t i = 0; i < sizeof(s_len_tbl) / sizeof(s_len_tbl[0]); i++)
+    {
+        uint32_t na = s_len_tbl[i][0];
+        uint32_t nb = s_len_tbl[i][1];
+        for (uint32_t j = 0; j < na; j++)
+        {
+            s_a[j] = (j == 0) ? 0xFFFFFFFFu : ht_rand();
+        }
+        for (uint32_t j = 0; j < nb; j++)
+        {
+            s_b[j] = (j == nb - 1) ? 0xFFFFFFFFu : ht_rand();
+        }
+        bn_mul_school(s_r1, s_a, na, s_b, nb);
+        HT_CHECK(bn_mul_karatsuba(s_r2, s_a, na, s_b, nb));
+        HT_CHECK(memcmp(s_r1, s_r2, (na + nb) * sizeof(uint32_t)) == 0);
+    }
+}
+
+// q = a / b なら q*b <= a < (q+1)*b、r = isqrt(a)なら r^2 <= a < (r+1)^2
+static void test_bn_div_isqrt(void)
+{
+    bignum_t a, b, q, t, one;
+
+    bn_init(&a);
+    bn_init(&b);
+    bn_init(&q);
+    bn_init(&t);
+    bn_init(&one);
+    bn_set_u64(&one, 1);
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        uint32_t na = 1 + ht_rand_below(60);
+        uint32_t nb = 1 + ht_rand_below(na);
+        bn_rand(&a, na);
+        bn_rand(&b, nb);
+
+        HT_CHECK(bn_div(&q, &a, &b));
+        HT_CHECK(bn_mul(&t, &q, &b));
+        HT_CHECK(bn_cmp_abs(&t, &a) <= 0);
+        HT_CHECK(bn_add(&t, &t, &b));
+        HT_CHECK(bn_cmp_abs(&t, &a) > 0);
+
+        HT_CHECK(bn_isqrt(&q, &a));
+        HT_CHECK(bn_mul(&t, &q, &q));
+        HT_CHECK(bn_cmp_abs(&t, &a) <= 0);
+        HT_CHECK(bn_add(&q, &q, &one));
+        HT_CHECK(bn_mul(&t, &q, &q));
+        HT_CHECK(bn_cmp_abs(&t, &a) > 0);
+    }
+    bn_set_u64(&t, 0);
+    HT_CHECK(!bn_div(&q, &a, &t));
+
+    bn_free(&a);
+    bn_free(&b);
+    bn_free(&q);
+    bn_free(&t);
+    bn_free(&one);
+}
+
+int main(void)
+{
+    ht_srand(0x314159u);
+
+    HT_RUN(test_pi_short);
+    HT_RUN(test_pi_long);
+    HT_RUN(test_pi_split);
+    HT_RUN(test_pi_verify_reject);
+    HT_RUN(test_bn_karatsuba);
+    HT_RUN(test_bn_div_isqrt);
+
+    return HT_RESULT();
+}
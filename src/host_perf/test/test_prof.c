@@ -0,0 +1,210 @@
+/**
+ * @file test_prof.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief prof.cのテスト(集計、衝突と取りこぼし、上位の取り出し、ダンプ形式の往復)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "prof.h"
+#include <stdio.h>
+#include <string.h>
+
+// 記録済みのダンプ(引数で渡す、tools/prof_symbolize.pyのテストと共用)
+static const char *s_p_log_path = "data/prof_sample.log";
+
+// prof.cと同じハッシュ(衝突するPCを作るのに使う)
+static uint32_t hash_of(uint32_t pc, uint32_t lr)
+{
+    uint32_t h = (pc >> 1) ^ ((lr >> 1) * 0x9E3779B1UL);
+    return (h ^ (h >> 13)) & (PROF_HIST_SIZE - 1);
+}
+
+static uint32_t find_count(uint32_t pc, uint32_t lr)
+{
+    uint32_t pos = 0;
+    prof_entry_t entry;
+
+    while (prof_next_entry(&pos, &entry))
+    {
+        if (entry.pc == pc && entry.lr == lr) {
+            return entry.count;
+        }
+    }
+    return 0;
+}
+
+// 同じ(PC,LR)はまとめ、LRが違えば別のエントリ
+static void test_record(void)
+{
+    prof_stats_t stats;
+
+    prof_clear();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        prof_record(0x10000200u + (i % 4) * 2, 0x10000121u);
+    }
+    prof_record(0x10000200u, 0x10000131u);
+    prof_add(0x20000010u, 0, 7);
+
+    prof_get_stats(&stats);
+    HT_EQ(stats.samples, 108);
+    HT_EQ(stats.used, 6);
+    HT_EQ(stats.dropped, 0);
+    HT_EQ(find_count(0x10000200u, 0x10000121u), 25);
+    HT_EQ(find_count(0x10000206u, 0x10000121u), 25);
+    HT_EQ(find_count(0x10000200u, 0x10000131u), 1);
+    HT_EQ(find_count(0x20000010u, 0), 7);
+
+    prof_clear();
+    prof_get_stats(&stats);
+    HT_EQ(stats.samples + stats.used + stats.dropped, 0);
+    uint32_t pos = 0;
+    prof_entry_t entry;
+    HT_CHECK(!prof_next_entry(&pos, &entry));
+}
+
+// 同じハッシュがPROF_PROBE_MAXを超えたら捨てて数える(表の末尾からの折り返しも通る)
+static void test_collision_drop(void)
+{
+    uint32_t pcs[PROF_PROBE_MAX + 2];
+    uint32_t num = 0;
+    prof_stats_t stats;
+
+    for (uint32_t pc = 0; num < PROF_PROBE_MAX + 2; pc += 2)
+    {
+        if (hash_of(pc, 0) == PROF_HIST_SIZE - 2) {
+            pcs[num++] = pc;
+        }
+    }
+
+    prof_clear();
+    for (uint32_t i = 0; i < num; i++)
+    {
+        prof_add(pcs[i], 0, i + 1);
+    }
+    prof_get_stats(&stats);
+    HT_EQ(stats.used, PROF_PROBE_MAX);
+    HT_EQ(stats.dropped, (PROF_PROBE_MAX + 1) + (PROF_PROBE_MAX + 2));
+    HT_EQ(stats.samples, num * (num + 1) / 2);
+    HT_EQ(find_count(pcs[PROF_PROBE_MAX - 1], 0), PROF_PROBE_MAX);
+    HT_EQ(find_count(pcs[PROF_PROBE_MAX], 0), 0);
+
+    // 既に入っているものには加算できる
+    prof_add(pcs[PROF_PROBE_MAX - 1], 0, 1);
+    HT_EQ(find_count(pcs[PROF_PROBE_MAX - 1], 0), PROF_PROBE_MAX + 1);
+}
+
+// 上位はサンプル数の多い順、数が足りなければある分だけ
+static void test_top(void)
+{
+    prof_entry_t top[8];
+
+    prof_clear();
+    HT_EQ(prof_top(top, 8), 0);
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        prof_add(0x10000000u + i * 4, 0, 1 + ht_rand_below(1000));
+    }
+    prof_add(0x10001000u, 0, 5000);
+
+    HT_EQ(prof_top(top, 8), 8);
+    HT_EQ(top[0].pc, 0x10001000u);
+    for (uint32_t i = 1; i < 8; i++)
+    {
+        HT_CHECK(top[i - 1].count >= top[i].count);
+    }
+    // 8番目より多いエントリは上位の外に無い
+    uint32_t pos = 0;
+    uint32_t over = 0;
+    prof_entry_t entry;
+    while (prof_next_entry(&pos, &entry))
+    {
+        over += (entry.count > top[7].count) ? 1 : 0;
+    }
+    HT_CHECK(over <= 7);
+    HT_EQ(prof_top(top, 0), 0);
+
+    prof_clear();
+    prof_add(0x100u, 0, 3);
+    prof_add(0x200u, 0, 9);
+    HT_EQ(prof_top(top, 8), 2);
+    HT_EQ(top[0].pc, 0x200u);
+    HT_EQ(top[1].pc, 0x100u);
+}
+
+static void test_format_parse(void)
+{
+    prof_entry_t entry = {0x1000ABCEu, 0x20000041u, 123456};
+    prof_entry_t parsed;
+    char buf[48];
+
+    int32_t len = prof_format_entry(buf, sizeof(buf), &entry);
+    HT_EQ(len, (int32_t)strlen(buf));
+    HT_CHECK(strcmp(buf, "0x1000ABCE 0x20000041 123456") == 0);
+    HT_CHECK(prof_parse_entry(buf, &parsed));
+    HT_CHECK(memcmp(&parsed, &entry, sizeof(entry)) == 0);
+
+    HT_CHECK(prof_parse_entry("  0x10 0 5\r\n", &parsed));
+    HT_EQ(parsed.pc, 0x10);
+    HT_EQ(parsed.count, 5);
+    HT_CHECK(!prof_parse_entry("# prof begin core=1", &parsed));
+    HT_CHECK(!prof_parse_entry("", &parsed));
+    HT_CHECK(!prof_parse_entry("0x10 0x20", &parsed));
+    HT_CHECK(!prof_parse_entry("[PROF] stopped for dump", &parsed));
+    HT_CHECK(!prof_parse_entry("0x10 0x20 0", &parsed));
+}
+
+// 記録済みのダンプを読み直して集計(prof_symbolize.pyと同じ数になる)
+static void test_sample_log(void)
+{
+    FILE *p_file = fopen(s_p_log_path, "r");
+    char line[128];
+    bool is_in_dump = false;
+    prof_entry_t entry;
+    prof_stats_t stats;
+
+    HT_CHECK(p_file != NULL);
+    if (p_file == NULL) {
+        return;
+    }
+
+    prof_clear();
+    while (fgets(line, sizeof(line), p_file) != NULL)
+    {
+        if (strncmp(line, PROF_DUMP_BEGIN, strlen(PROF_DUMP_BEGIN)) == 0) {
+            is_in_dump = true;
+        } else if (strncmp(line, PROF_DUMP_END, strlen(PROF_DUMP_END)) == 0) {
+            is_in_dump = false;
+        } else if (is_in_dump) {
+            HT_CHECK(prof_parse_entry(line, &entry));
+            prof_add(entry.pc, entry.lr, entry.count);
+        }
+    }
+    fclose(p_file);
+
+    prof_get_stats(&stats);
+    HT_EQ(stats.samples, 115);
+    HT_EQ(stats.used, 7);
+    HT_EQ(find_count(0x10000210u, 0x10000121u), 50);
+    HT_EQ(find_count(0x10000210u, 0x20000041u), 10);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        s_p_log_path = argv[1];
+    }
+    ht_srand(0x9F0Fu);
+
+    HT_RUN(test_record);
+    HT_RUN(test_collision_drop);
+    HT_RUN(test_top);
+    HT_RUN(test_format_parse);
+    HT_RUN(test_sample_log);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file test_prof_symbolize.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief tools/prof_symbolize.pyのテスト(記録済みのダンプ + テスト用に組み立てたELF32)
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+※ctestから実行する(python3 test/test_prof_symbolize.py でも可)
+"""
+import contextlib
+import io
+import os
+import struct
+import sys
+import tempfile
+import unittest
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(TEST_DIR, "..", "..", "..", "tools"))
+
+import prof_symbolize  # noqa: E402
+
+SAMPLE_LOG = os.path.join(TEST_DIR, "data", "prof_sample.log")
+
+STT_OBJECT = 1
+STT_FUNC = 2
+
+# (名前, 値, サイズ, 種類) ※Thumbの関数は値のbit0が1
+SYMBOLS = [
+    ("reset_handler", 0x10000001, 0, STT_FUNC),         # サイズ無し→次の関数まで
+    ("main", 0x10000101, 0x40, STT_FUNC),
+    ("fft", 0x10000201, 0, STT_FUNC),                   # 別名(サイズのある方を使う)
+    ("fft_radix2", 0x10000201, 0x100, STT_FUNC),
+    ("crc_sw_update", 0x20000001, 0x80, STT_FUNC),      # SRAMに置いた関数
+    ("s_buf", 0x20000040, 0x100, STT_OBJECT),           # 関数ではない
+]
+
+
+def build_elf32(symbols):
+    """セクションヘッダとシンボル表だけのELF32(リトルエンディアン)を組み立てる"""
+    strtab = b"\0"
+    symtab = b"\0" * 16
+    for name, value, size, kind in symbols:
+        symtab += struct.pack("<IIIBBH", len(strtab), value, size, kind, 0, 1)
+        strtab += name.encode() + b"\0"
+
+    ehsize = 52
+    str_off = ehsize
+    sym_off = str_off + len(strtab)
+    sh_off = sym_off + len(symtab)
+    header = b"\x7fELF" + bytes([1, 1, 1]) + b"\0" * 9
+    header += struct.pack("<HHIIIIIHHHHHH", 2, 40, 1, 0, 0, sh_off, 0, ehsize, 0, 0, 40, 3, 0)
+    sections = b"\0" * 40
+    sections += struct.pack("<IIIIIIIIII", 0, 3, 0, 0, str_off, len(strtab), 0, 0, 1, 0)
+    sections += struct.pack("<IIIIIIIIII", 0, 2, 0, 0, sym_off, len(symtab), 1, 1, 4, 16)
+
+    return header + strtab + symtab + sections
+
+
+class ProfSymbolizeTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.TemporaryDirectory()
+        cls.elf = os.path.join(cls.tmp.name, "rp2350_dev.elf")
+        with open(cls.elf, "wb") as f:
+            f.write(build_elf32(SYMBOLS))
+        with open(SAMPLE_LOG, "r") as f:
+            cls.lines = f.readlines()
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.tmp.cleanup()
+
+    def test_read_elf_funcs(self):
+        funcs = prof_symbolize.read_elf_funcs(self.elf)
+        self.assertEqual(funcs, [
+            (0x10000000, 0, "reset_handler"),
+            (0x10000100, 0x40, "main"),
+            (0x10000200, 0x100, "fft_radix2"),
+            (0x20000000, 0x80, "crc_sw_update"),
+        ])
+
+    def test_lookup(self):
+        sym = prof_symbolize.Symbolizer(prof_symbolize.read_elf_funcs(self.elf))
+        self.assertEqual(sym.lookup(0x10000008), "reset_handler")
+        self.assertEqual(sym.lookup(0x100000FF), "reset_handler")
+        self.assertEqual(sym.lookup(0x10000121), "main")
+        self.assertIsNone(sym.lookup(0x10000140))
+        self.assertEqual(sym.lookup(0x100002FE), "fft_radix2")
+        self.assertIsNone(sym.lookup(0x0FFFFFFE))
+        self.assertIsNone(sym.lookup(0x30000000))
+
+    def test_read_dumps(self):
+        hist, info = prof_symbolize.read_dumps(self.lines)
+        # 2回のダンプを合計し、ダンプの外の行は読まない
+        self.assertEqual(sum(hist.values()), 115)
+        self.assertEqual(len(hist), 7)
+        self.assertEqual(hist[(0x10000210, 0x10000121)], 50)
+        self.assertEqual(info, {"core": "1", "period_us": "100", "lr": "1",
+                                "samples": "15", "dropped": "2"})
+
+    def test_profiles(self):
+        sym = prof_symbolize.Symbolizer(prof_symbolize.read_elf_funcs(self.elf))
+        hist, _ = prof_symbolize.read_dumps(self.lines)
+        self.assertEqual(prof_symbolize.flat_profile(hist, sym), [
+            ("fft_radix2", 90),
+            ("crc_sw_update", 15),
+            ("reset_handler", 5),
+            ("main", 4),
+            ("?? (0x30000000)", 1),
+        ])
+        callers = prof_symbolize.caller_profile(hist, sym)
+        self.assertEqual(dict(callers["fft_radix2"]), {"main": 80, "crc_sw_update": 10})
+        self.assertEqual(dict(callers["crc_sw_update"]), {"main": 15})
+        self.assertNotIn("main", callers)
+
+    def test_main_output(self):
+        out = io.StringIO()
+        with contextlib.redirect_stdout(out):
+            ret = prof_symbolize.main([self.elf, SAMPLE_LOG, "-n", "2", "--callers"])
+        self.assertEqual(ret, 0)
+        lines = out.getvalue().splitlines()
+        self.assertEqual(lines[0], "samples 115, core1, period 100 us, dropped 2")
+        self.assertEqual(lines[3].split(), ["90", "78.26", "78.26", "fft_radix2"])
+        self.assertEqual(lines[4].split(), ["15", "13.04", "91.30", "crc_sw_update"])
+        self.assertEqual([l.split() for l in lines[6:]], [
+            ["callers", "(from", "LR):"],
+            ["fft_radix2"], ["80", "<-", "main"], ["10", "<-", "crc_sw_update"],
+            ["crc_sw_update"], ["15", "<-", "main"],
+        ])
+
+    def test_no_samples(self):
+        empty = os.path.join(self.tmp.name, "empty.log")
+        with open(empty, "w") as f:
+            f.write("> prof dump\n# prof begin core=1\n# prof end\n")
+        with contextlib.redirect_stderr(io.StringIO()):
+            self.assertEqual(prof_symbolize.main([self.elf, empty]), 1)
+
+
+if __name__ == "__main__":
+    unittest.main()
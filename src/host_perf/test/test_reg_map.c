@@ -0,0 +1,580 @@
+/**
+ * @file test_reg_map.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief reg_map.c/reg_ops.cのテスト(表の並び、名前⇔アドレス、引数の解釈、マスク付きRMW、ポーリング、スナップショットの差分)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※レジスタは関数で作った値を返す偽物、時刻は読むたびに進む偽物の時計
+ */
+#include "host_test.h"
+#include "reg_map.h"
+#include "reg_ops.h"
+#include <string.h>
+
+#define RAND_ROUNDS     5000
+#define ARGV_MAX        8
+
+// 【偽物のレジスタと時計】
+static uint32_t s_reg;                  // RMWの対象(アドレスはREG_ADDR)
+static uint32_t s_lock_depth;
+static uint32_t s_bad;                  // ロックの外で読み書きした数
+static uint32_t s_now;                  // now_us()を呼ぶたびにs_stepずつ進む
+static uint32_t s_step;
+static uint32_t s_reads;
+static uint32_t s_match_at;             // この回数目の読み出しからs_match_valを返す(前は~s_match_val、0ならs_reg)
+static uint32_t s_match_val;
+static uint32_t s_kicks;
+static uint32_t s_seed;                 // スナップショット用の値の種
+static uint32_t s_touch_addr;           // このアドレスだけ値を変える
+static uint32_t s_touch_xor;
+
+#define REG_ADDR        0x40090000u
+
+static uint32_t fake_val(uint32_t addr)
+{
+    uint32_t v = (addr ^ s_seed) * 2654435761u;
+
+    return (addr == s_touch_addr) ? (v ^ s_touch_xor) : v;
+}
+
+static uint32_t fake_read(uint32_t addr)
+{
+    s_reads++;
+    if (addr == REG_ADDR) {
+        if (s_lock_depth == 0 && s_match_at == 0) {
+            s_bad++;
+        }
+        if (s_match_at != 0) {
+            return (s_reads >= s_match_at) ? s_match_val : ~s_match_val;
+        }
+        return s_reg;
+    }
+
+    return fake_val(addr);
+}
+
+static void fake_write(uint32_t addr, uint32_t val)
+{
+    if (addr != REG_ADDR || s_lock_depth == 0) {
+        s_bad++;
+    }
+    s_reg = val;
+}
+
+static uint32_t fake_lock(void)
+{
+    s_lock_depth++;
+    return 0x5A;
+}
+
+static void fake_unlock(uint32_t save)
+{
+    if (save != 0x5A || s_lock_depth == 0) {
+        s_bad++;
+    }
+    s_lock_depth--;
+}
+
+static uint32_t fake_now_us(void)
+{
+    s_now += s_step;
+    return s_now;
+}
+
+// 150MHz相当(時刻の150倍)
+static uint32_t fake_cycles(void)
+{
+    return s_now * 150;
+}
+
+static void fake_kick(void)
+{
+    s_kicks++;
+}
+
+static const reg_ops_t s_ops = {
+    fake_read, fake_write, fake_lock, fake_unlock, fake_now_us, fake_cycles, fake_kick,
+};
+
+static void fake_clear(void)
+{
+    s_reg = 0;
+    s_lock_depth = 0;
+    s_bad = 0;
+    s_now = 0;
+    s_step = 1;
+    s_reads = 0;
+    s_match_at = 0;
+    s_match_val = 0;
+    s_kicks = 0;
+    s_touch_addr = 0;
+    s_touch_xor = 0;
+}
+
+// 【表の並び】ブロック名とレジスタ名は大文字で昇順(二分探索の前提)、配列は添字の間隔がある
+static bool is_upper_name(const char *p_name)
+{
+    for (const char *p = p_name; *p != '\0'; p++)
+    {
+        if (*p >= 'a' && *p <= 'z') {
+            return false;
+        }
+    }
+
+    return (p_name[0] != '\0');
+}
+
+static void test_sorted(void)
+{
+    for (uint32_t b = 0; b < reg_map_block_num(); b++)
+    {
+        const reg_block_t *p_block = reg_map_block(b);
+
+        HT_CHECK(is_upper_name(p_block->p_name));
+        HT_CHECK(p_block->reg_num > 0);
+        if (b > 0) {
+            HT_CHECK(strcmp(reg_map_block(b - 1)->p_name, p_block->p_name) < 0);
+        }
+        for (uint32_t i = 0; i < p_block->reg_num; i++)
+        {
+            const reg_def_t *p_reg = &p_block->p_regs[i];
+
+            HT_CHECK(is_upper_name(p_reg->p_name));
+            HT_CHECK(p_reg->num >= 1);
+            HT_CHECK((p_reg->offset & 3) == 0);
+            HT_CHECK(p_reg->num == 1 || (p_reg->stride >= 4 && (p_reg->stride & 3) == 0));
+            if (i > 0) {
+                HT_CHECK(strcmp(p_block->p_regs[i - 1].p_name, p_reg->p_name) < 0);
+            }
+        }
+    }
+    HT_CHECK(reg_map_block(reg_map_block_num()) == NULL);
+}
+
+// 【名前⇔アドレス】
+// 全ブロックの全レジスタの全添字で、名前→アドレス→名前が元に戻る(小文字でも引ける)
+static void test_lookup_all(void)
+{
+    char name[REG_MAP_NAME_MAX];
+    char lower[REG_MAP_NAME_MAX];
+    reg_ref_t ref;
+
+    for (uint32_t b = 0; b < reg_map_block_num(); b++)
+    {
+        const reg_block_t *p_block = reg_map_block(b);
+
+        HT_CHECK(reg_map_lookup(p_block->p_name, &ref));
+        HT_CHECK(ref.p_block == p_block && ref.p_reg == NULL);
+        HT_EQ(ref.addr, p_block->base);
+        HT_CHECK(reg_map_block_of(p_block->base) == p_block);
+        HT_CHECK(reg_map_block_of(p_block->base + reg_map_block_span(p_block)) != p_block);
+
+        for (uint32_t i = 0; i < p_block->reg_num; i++)
+        {
+            const reg_def_t *p_reg = &p_block->p_regs[i];
+            for (uint32_t n = 0; n < p_reg->num; n++)
+            {
+                uint32_t addr = reg_def_addr(p_block, p_reg, n);
+                const reg_block_t *p_of;
+                uint32_t index = 0xFFFF;
+
+                // アドレス→レジスタ(重なっていれば別のレジスタが返る)
+                HT_CHECK(reg_map_def_of(addr, &p_of, &index) == p_reg);
+                HT_CHECK(p_of == p_block);
+                HT_EQ(index, (p_reg->num > 1) ? n : 0);
+
+                HT_CHECK(reg_map_name_of(addr, name, sizeof(name)));
+                HT_CHECK(strlen(name) < sizeof(name) - 1);
+                HT_CHECK(reg_map_lookup(name, &ref));
+                HT_EQ(ref.addr, addr);
+                HT_CHECK(ref.p_reg == p_reg);
+                HT_EQ(ref.index, n);
+
+                for (uint32_t c = 0; c <= strlen(name); c++)
+                {
+                    lower[c] = (name[c] >= 'A' && name[c] <= 'Z') ? (char)(name[c] - 'A' + 'a') : name[c];
+                }
+                HT_CHECK(reg_map_lookup(lower, &ref));
+                HT_EQ(ref.addr, addr);
+            }
+        }
+    }
+}
+
+static void test_lookup(void)
+{
+    char name[REG_MAP_NAME_MAX];
+    reg_ref_t ref;
+    uint32_t addr;
+
+    HT_CHECK(reg_map_lookup("I2C0.IC_CON", &ref));
+    HT_EQ(ref.addr, 0x40090000u);
+    HT_CHECK(reg_map_lookup("dma.ch_ctrl_trig[3]", &ref));
+    HT_EQ(ref.addr, 0x50000000u + 0x0C + 3 * 0x40);
+    HT_EQ(ref.index, 3);
+    HT_CHECK(reg_map_lookup("DMA.CH_CTRL_TRIG", &ref));
+    HT_EQ(ref.addr, 0x5000000Cu);
+    HT_EQ(ref.index, 0);
+    HT_CHECK(reg_map_lookup("Uart1.UARTLCR_H", &ref));
+    HT_EQ(ref.addr, 0x4007802Cu);
+
+    // 無い名前、前だけ一致、添字の範囲外と書き方の間違い
+    HT_CHECK(!reg_map_lookup("NOPE", &ref));
+    HT_CHECK(!reg_map_lookup("I2C", &ref));
+    HT_CHECK(!reg_map_lookup("I2C00", &ref));
+    HT_CHECK(!reg_map_lookup("", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG_X", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG[16]", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG[", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG[3", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG[3]x", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG[-1]", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.CH_CTRL_TRIG[]", &ref));
+    HT_CHECK(!reg_map_lookup("DMA.INTR[1]", &ref));
+    HT_CHECK(reg_map_lookup("DMA.INTR[0]", &ref));
+
+    // 表に無いオフセットと範囲外
+    HT_CHECK(reg_map_name_of(0x5000045Cu, name, sizeof(name)));
+    HT_CHECK(strcmp(name, "DMA+0x45C") == 0);
+    HT_CHECK(reg_map_def_of(0x5000045Cu, NULL, NULL) == NULL);
+    HT_CHECK(reg_map_name_of(0x50000004u + 5 * 0x40, name, sizeof(name)));
+    HT_CHECK(strcmp(name, "DMA.CH_WRITE_ADDR[5]") == 0);
+    HT_CHECK(!reg_map_name_of(0x20000000u, name, sizeof(name)));
+    HT_CHECK(reg_map_block_of(0x20000000u) == NULL);
+    HT_CHECK(reg_map_find_block("SPI1xx", 4) == reg_map_block_of(0x40088000u));
+    HT_CHECK(reg_map_find_block("SPI1xx", 6) == NULL);
+
+    // アドレスの引数(#HEXか名前)
+    HT_CHECK(reg_parse_addr("#400B0028", &addr));
+    HT_EQ(addr, 0x400B0028u);
+    HT_CHECK(reg_parse_addr("timer0.timerawl", &addr));
+    HT_EQ(addr, 0x400B0028u);
+    HT_CHECK(!reg_parse_addr("#", &addr));
+    HT_CHECK(!reg_parse_addr("#12G", &addr));
+    HT_CHECK(!reg_parse_addr("400B0028", &addr));
+}
+
+// 【引数の解釈】p_argv[0]はコマンド名
+static const char *parse(reg_cmd_t *p_cmd, const char *p_line)
+{
+    static char s_line[128];
+    char *p_argv[ARGV_MAX];
+    int32_t argc = 0;
+
+    strncpy(s_line, p_line, sizeof(s_line) - 1);
+    for (char *p_tok = strtok(s_line, " "); p_tok != NULL && argc < ARGV_MAX; p_tok = strtok(NULL, " "))
+    {
+        p_argv[argc++] = p_tok;
+    }
+
+    return reg_cmd_parse(argc, p_argv, p_cmd);
+}
+
+static void test_parse(void)
+{
+    reg_cmd_t cmd;
+
+    HT_CHECK(parse(&cmd, "reg") != NULL);
+    HT_CHECK(parse(&cmd, "reg I2C0.IC_CON") != NULL);
+    HT_CHECK(parse(&cmd, "reg NOPE r") != NULL);
+    HT_CHECK(parse(&cmd, "reg #40090000 x") != NULL);
+
+    // r
+    HT_CHECK(parse(&cmd, "reg I2C0.IC_CON r") == NULL);
+    HT_EQ(cmd.op, REG_OP_READ);
+    HT_EQ(cmd.addr, 0x40090000u);
+    HT_EQ(cmd.bits, 32);
+    HT_CHECK(parse(&cmd, "reg #40090001 r 8") == NULL);
+    HT_EQ(cmd.bits, 8);
+    HT_CHECK(parse(&cmd, "reg #40090001 r 16") != NULL);
+    HT_CHECK(parse(&cmd, "reg #40090002 r 16") == NULL);
+    HT_CHECK(parse(&cmd, "reg #40090002 r") != NULL);
+    HT_CHECK(parse(&cmd, "reg #40090000 r 12") != NULL);
+    HT_CHECK(parse(&cmd, "reg #40090000 r 8 9") != NULL);
+
+    // w
+    HT_CHECK(parse(&cmd, "reg #20000000 w #DEADBEEF") == NULL);
+    HT_EQ(cmd.op, REG_OP_WRITE);
+    HT_EQ(cmd.val, 0xDEADBEEFu);
+    HT_CHECK(parse(&cmd, "reg #20000002 w 16 #FFFF") == NULL);
+    HT_EQ(cmd.bits, 16);
+    HT_CHECK(parse(&cmd, "reg #20000002 w 16 #10000") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 w 12") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 w") != NULL);
+
+    // rmw
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #F #5 4") == NULL);
+    HT_EQ(cmd.op, REG_OP_RMW);
+    HT_EQ(cmd.mask, 0xF);
+    HT_EQ(cmd.val, 5);
+    HT_EQ(cmd.shift, 4);
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #F #5") == NULL);
+    HT_EQ(cmd.shift, 0);
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #F #15") != NULL);     // マスクの外
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #0 #0") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #F #5 32") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #FF #5 28") != NULL);   // 32bitからはみ出す
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #F #5 28") == NULL);
+    HT_CHECK(parse(&cmd, "reg #20000002 rmw #F #5") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 rmw #F") != NULL);
+
+    // poll
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #1") == NULL);
+    HT_EQ(cmd.op, REG_OP_POLL);
+    HT_EQ(cmd.timeout_ms, REG_POLL_TIMEOUT_DEF_MS);
+    HT_CHECK(!cmd.is_ne);
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #0 50 ne") == NULL);
+    HT_EQ(cmd.timeout_ms, 50);
+    HT_CHECK(cmd.is_ne);
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #0 ne 7") == NULL);
+    HT_EQ(cmd.timeout_ms, 7);
+    HT_CHECK(cmd.is_ne);
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #0 0") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #0 10001") != NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #0 10000") == NULL);
+    HT_CHECK(parse(&cmd, "reg #20000000 poll #1 #2") != NULL);
+
+    // snap/dump/diff/list
+    HT_CHECK(parse(&cmd, "reg snap uart0") == NULL);
+    HT_EQ(cmd.op, REG_OP_SNAP);
+    HT_CHECK(cmd.p_block != NULL && strcmp(cmd.p_block->p_name, "UART0") == 0);
+    HT_CHECK(parse(&cmd, "reg dump #40070000 #40") == NULL);
+    HT_EQ(cmd.op, REG_OP_DUMP);
+    HT_EQ(cmd.addr, 0x40070000u);
+    HT_EQ(cmd.len, 0x40);
+    HT_CHECK(cmd.p_block == NULL);
+    HT_CHECK(parse(&cmd, "reg snap NOPE") != NULL);
+    HT_CHECK(parse(&cmd, "reg snap #40070000 #3") != NULL);
+    HT_CHECK(parse(&cmd, "reg snap #40070002 #4") != NULL);
+    HT_CHECK(parse(&cmd, "reg snap #40070000 #0") != NULL);
+    HT_CHECK(parse(&cmd, "reg snap #40070000 #400") == NULL);
+    HT_CHECK(parse(&cmd, "reg snap #40070000 #404") != NULL);
+    HT_CHECK(parse(&cmd, "reg snap #FFFFFFFC #8") != NULL);
+    HT_CHECK(parse(&cmd, "reg snap") != NULL);
+    HT_CHECK(parse(&cmd, "reg diff") == NULL);
+    HT_EQ(cmd.op, REG_OP_DIFF);
+    HT_CHECK(parse(&cmd, "reg diff x") != NULL);
+    HT_CHECK(parse(&cmd, "reg list") == NULL);
+    HT_EQ(cmd.op, REG_OP_LIST);
+    HT_CHECK(cmd.p_block == NULL);
+    HT_CHECK(parse(&cmd, "reg list pio1") == NULL);
+    HT_EQ(cmd.p_block->base, 0x50300000u);
+    HT_CHECK(parse(&cmd, "reg list NOPE") != NULL);
+}
+
+// 【マスク付きRMW】フィールドの外は元の値のまま、読み書きはロックの中
+static void test_rmw(void)
+{
+    uint32_t old_val;
+
+    fake_clear();
+    s_reg = 0xFFFF0000u;
+    HT_EQ(reg_rmw(&s_ops, REG_ADDR, 0xF, 0x5, 4, &old_val), 0xFFFF0050u);
+    HT_EQ(old_val, 0xFFFF0000u);
+    HT_EQ(s_reg, 0xFFFF0050u);
+    HT_EQ(reg_rmw(&s_ops, REG_ADDR, 0xFF, 0x00, 16, NULL), 0xFF000050u);
+    HT_EQ(reg_rmw(&s_ops, REG_ADDR, 0x1, 0x1, 31, NULL), 0xFF000050u);
+    HT_EQ(reg_rmw(&s_ops, REG_ADDR, 0x1, 0x0, 31, NULL), 0x7F000050u);
+    HT_EQ(s_lock_depth, 0);
+    HT_EQ(s_bad, 0);
+
+    // マスクの外の値のビットは書かない
+    HT_EQ(reg_rmw_value(0, 0x3, 0xFF, 8), 0x300);
+
+    for (uint32_t r = 0; r < RAND_ROUNDS; r++)
+    {
+        uint32_t old = ht_rand();
+        uint32_t shift = ht_rand_below(32);
+        uint32_t mask = ht_rand() >> shift;
+        uint32_t val = ht_rand();
+        uint32_t field = mask << shift;
+        uint32_t res = reg_rmw_value(old, mask, val, shift);
+
+        HT_EQ(res & ~field, old & ~field);
+        HT_EQ(res & field, (val << shift) & field);
+    }
+}
+
+// 【ポーリング】偽物の時計で、一致、ne、タイムアウト、kick、時刻の一周
+static void poll_run(const char *p_line, uint32_t match_at, uint32_t match_val, reg_poll_result_t *p_result)
+{
+    reg_cmd_t cmd;
+
+    s_reads = 0;
+    s_kicks = 0;
+    s_match_at = match_at;
+    s_match_val = match_val;
+    HT_CHECK(parse(&cmd, p_line) == NULL);
+    reg_poll(&s_ops, &cmd, p_result);
+}
+
+static void test_poll(void)
+{
+    reg_poll_result_t res;
+
+    fake_clear();
+    s_step = 2;
+
+    // 最初の読み出しで一致(時計は始めに1回、一致した後に1回読む)
+    poll_run("reg #40090000 poll #3 #1", 1, 0x1, &res);
+    HT_CHECK(res.is_match);
+    HT_EQ(res.reads, 1);
+    HT_EQ(res.val, 0x1);
+    HT_EQ(res.cycles, 0);
+    HT_EQ(res.us, 2);
+
+    // 10回目で一致(一致しなかった読み出しごとに時計を1回読む)
+    poll_run("reg #40090000 poll #F0 #A0", 10, 0x12345AA0, &res);
+    HT_CHECK(res.is_match);
+    HT_EQ(res.reads, 10);
+    HT_EQ(res.val, 0x12345AA0);
+    HT_EQ(res.cycles, 9 * 2 * 150);
+    HT_EQ(res.us, 10 * 2);
+
+    // タイムアウト(1ms、1回2us)
+    poll_run("reg #40090000 poll #1 #0 1", UINT32_MAX, 0, &res);
+    HT_CHECK(!res.is_match);
+    HT_EQ(res.reads, 500);
+    HT_EQ(res.val, 0xFFFFFFFFu);
+    HT_EQ(res.cycles, 1000 * 150);
+    HT_EQ(res.us, 1002);
+    HT_EQ(s_kicks, 0);
+
+    // ne: マスクの中が0の間は待ち、7回目で変わったら終わり
+    poll_run("reg #40090000 poll #80 #0 5 ne", 7, 0x80, &res);
+    HT_CHECK(res.is_match);
+    HT_EQ(res.reads, 7);
+    HT_CHECK(reg_poll_is_match(0x7F, 0x80, 0x80, true));
+    HT_CHECK(!reg_poll_is_match(0xFF, 0x80, 0x80, true));
+    HT_CHECK(reg_poll_is_match(0xFF, 0x80, 0x80, false));
+
+    // 長いタイムアウトではREG_POLL_KICK_READS回ごとにkick
+    s_step = 1;
+    poll_run("reg #40090000 poll #1 #0 10", UINT32_MAX, 0, &res);
+    HT_CHECK(!res.is_match);
+    HT_EQ(res.reads, 10000);
+    HT_EQ(s_kicks, 10000 / REG_POLL_KICK_READS);
+
+    // 時刻が途中で一周しても同じ長さで終わる
+    s_now = 0xFFFFFF00u;
+    s_step = 2;
+    poll_run("reg #40090000 poll #1 #0 1", UINT32_MAX, 0, &res);
+    HT_CHECK(!res.is_match);
+    HT_EQ(res.reads, 500);
+    HT_EQ(res.us, 1002);
+    HT_EQ(s_bad, 0);
+}
+
+// 【スナップショットと差分】
+static void test_snap(void)
+{
+    static reg_snap_t s_old;
+    static reg_snap_t s_new;
+    reg_diff_t diff[4];
+    reg_ref_t ref;
+    uint32_t expect = 0;
+    uint32_t expect_vol = 0;
+
+    fake_clear();
+    s_seed = 0x1234u;
+
+    // ブロック: 読むと副作用のあるもの(UARTDR/UARTICR)は除き、アドレスの昇順
+    HT_CHECK(reg_map_lookup("UART0", &ref));
+    for (uint32_t i = 0; i < ref.p_block->reg_num; i++)
+    {
+        if ((ref.p_block->p_regs[i].flags & REG_F_NO_SNAP) == 0) {
+            expect += ref.p_block->p_regs[i].num;
+        }
+        if ((ref.p_block->p_regs[i].flags & REG_F_VOLATILE) != 0) {
+            expect_vol += ref.p_block->p_regs[i].num;
+        }
+    }
+    HT_CHECK(reg_snap_plan_block(&s_old, ref.p_block));
+    HT_EQ(s_old.num, expect);
+    for (uint32_t i = 0; i < s_old.num; i++)
+    {
+        HT_CHECK(i == 0 || s_old.addr[i - 1] < s_old.addr[i]);
+        HT_CHECK(s_old.addr[i] != 0x40070000u && s_old.addr[i] != 0x40070044u);
+    }
+
+    // 変えていなければ差分無し
+    reg_snap_take(&s_old, &s_ops);
+    s_new = s_old;
+    reg_snap_take(&s_new, &s_ops);
+    HT_EQ(reg_snap_diff(&s_old, &s_new, diff, 4), 0);
+
+    // 普通のレジスタは差分に出て、勝手に変わるもの(UARTFR)は出ない
+    s_touch_addr = 0x40070024u;     // UARTIBRD
+    s_touch_xor = 0x10;
+    reg_snap_take(&s_new, &s_ops);
+    HT_EQ(reg_snap_diff(&s_old, &s_new, diff, 4), 1);
+    HT_EQ(diff[0].addr, 0x40070024u);
+    HT_EQ(diff[0].old_val ^ diff[0].new_val, 0x10);
+    HT_EQ(diff[0].new_val, fake_val(0x40070024u));
+    s_touch_addr = 0x40070018u;     // UARTFR
+    reg_snap_take(&s_new, &s_ops);
+    HT_EQ(reg_snap_diff(&s_old, &s_new, diff, 4), 0);
+
+    // 全部変えると数はmaxを越えても数え、書くのはmax個まで
+    s_touch_addr = 0;
+    s_seed = 0x5678u;
+    reg_snap_take(&s_new, &s_ops);
+    diff[1].addr = 0xA5A5A5A5u;
+    HT_EQ(reg_snap_diff(&s_old, &s_new, diff, 1), expect - expect_vol);
+    HT_EQ(diff[1].addr, 0xA5A5A5A5u);
+    HT_EQ(reg_snap_diff(&s_old, &s_new, NULL, 0), expect - expect_vol);
+
+    // 範囲: 表に無いオフセットも読み、読むと副作用のあるものは除く
+    HT_CHECK(reg_snap_plan_range(&s_new, 0x40070000u, 0x50));
+    HT_EQ(s_new.num, 0x50 / 4 - 2);
+    HT_EQ(s_new.addr[0], 0x40070004u);
+    HT_CHECK(!reg_snap_plan_range(&s_new, 0x40070002u, 0x10));
+    HT_CHECK(!reg_snap_plan_range(&s_new, 0x40070000u, 0x12));
+    HT_CHECK(!reg_snap_plan_range(&s_new, 0x40070000u, (REG_SNAP_MAX + 1) * 4));
+    HT_CHECK(reg_snap_plan_range(&s_new, 0x20000000u, REG_SNAP_MAX * 4));
+    HT_EQ(s_new.num, REG_SNAP_MAX);
+
+    // ブロックと範囲の差分は両方にあるアドレスだけ
+    HT_CHECK(reg_snap_plan_range(&s_new, 0x40070020u, 0x10));
+    s_seed = 0x9ABCu;
+    reg_snap_take(&s_new, &s_ops);
+    HT_EQ(reg_snap_diff(&s_old, &s_new, diff, 4), 4);
+    HT_EQ(diff[0].addr, 0x40070020u);
+    HT_EQ(diff[3].addr, 0x4007002Cu);
+}
+
+// REG_SNAP_MAXを越えるブロックは計画できない
+static void test_snap_full(void)
+{
+    static const reg_def_t s_regs[] = {
+        {"A", 0x000, 200, 4, 0},
+        {"B", 0x400, 200, 4, 0},
+    };
+    static const reg_block_t s_block = {"BIG", 0x10000000u, s_regs, 2, REG_MAP_NO_RESET};
+    static reg_snap_t s_snap;
+
+    HT_CHECK(!reg_snap_plan_block(&s_snap, &s_block));
+    HT_EQ(s_snap.num, REG_SNAP_MAX);
+    HT_EQ(reg_map_block_span(&s_block), 0x400 + 199 * 4 + 4);
+}
+
+int main(void)
+{
+    ht_srand(0x4E6Au);
+
+    HT_RUN(test_sorted);
+    HT_RUN(test_lookup_all);
+    HT_RUN(test_lookup);
+    HT_RUN(test_parse);
+    HT_RUN(test_rmw);
+    HT_RUN(test_poll);
+    HT_RUN(test_snap);
+    HT_RUN(test_snap_full);
+
+    return HT_RESULT();
+}
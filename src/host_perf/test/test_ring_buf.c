@@ -0,0 +1,349 @@
+/**
+ * @file test_ring_buf.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ring_buf.cのテスト(満杯と空、折り返し、head/tailの32bitの折り返し、書き手と読み手のスレッド)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※書き手と読み手のコアはpthreadのスレッドで模擬する(test_ring_buf_tsanはThreadSanitizerで実行)
+ */
+#include "host_test.h"
+#include "ring_buf.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define RB_SIZE         16
+#define RAND_OPS        20000
+#define SPSC_SIZE       64
+#define SPSC_BYTES      (1UL << 21)
+
+static uint8_t s_buf[RB_SIZE];
+static ring_buf_t s_rb;
+
+static void test_init(void)
+{
+    HT_CHECK(!rb_init(&s_rb, s_buf, 0));
+    HT_CHECK(!rb_init(&s_rb, s_buf, 12));
+    HT_CHECK(rb_init(&s_rb, s_buf, 1));
+    HT_CHECK(rb_init(&s_rb, s_buf, RB_SIZE));
+    HT_EQ(rb_used(&s_rb), 0);
+    HT_EQ(rb_free(&s_rb), RB_SIZE);
+}
+
+// 満杯ならputは捨ててoverrunに数え、writeは入る分だけ書く。空なら読めない
+static void test_full_empty(void)
+{
+    const uint8_t *p_rd;
+    uint8_t *p_wr;
+    uint8_t out[RB_SIZE + 4];
+
+    rb_init(&s_rb, s_buf, RB_SIZE);
+    HT_EQ(rb_peek(&s_rb, &p_rd), 0);
+    HT_EQ(rb_read(&s_rb, out, sizeof(out)), 0);
+
+    for (uint32_t i = 0; i < RB_SIZE; i++)
+    {
+        HT_CHECK(rb_put(&s_rb, (uint8_t)i));
+    }
+    HT_EQ(rb_used(&s_rb), RB_SIZE);
+    HT_EQ(rb_free(&s_rb), 0);
+    HT_CHECK(!rb_put(&s_rb, 0xFF));
+    HT_EQ(s_rb.overrun, 1);
+    HT_EQ(rb_write(&s_rb, out, 4), 0);
+    HT_EQ(s_rb.overrun, 1);
+    HT_EQ(rb_reserve(&s_rb, &p_wr), 0);
+
+    HT_EQ(rb_read(&s_rb, out, sizeof(out)), RB_SIZE);
+    for (uint32_t i = 0; i < RB_SIZE; i++)
+    {
+        HT_EQ(out[i], i);
+    }
+    HT_EQ(rb_used(&s_rb), 0);
+    HT_EQ(s_rb.peak, RB_SIZE);
+
+    // 入らない分は書かない
+    memset(out, 0xA5, sizeof(out));
+    HT_EQ(rb_write(&s_rb, out, sizeof(out)), RB_SIZE);
+    HT_EQ(rb_free(&s_rb), 0);
+
+    rb_reset(&s_rb);
+    HT_EQ(rb_used(&s_rb), 0);
+    HT_EQ(s_rb.overrun + s_rb.peak, 0);
+}
+
+// peek/reserveは折り返しの手前までを返し、残りは2回目で返す
+static void test_wrap(void)
+{
+    const uint8_t *p_rd;
+    uint8_t *p_wr;
+    uint8_t data[RB_SIZE];
+    uint8_t out[RB_SIZE];
+
+    for (uint32_t i = 0; i < RB_SIZE; i++)
+    {
+        data[i] = (uint8_t)(0x40 + i);
+    }
+    rb_init(&s_rb, s_buf, RB_SIZE);
+    rb_write(&s_rb, data, 10);
+    rb_read(&s_rb, out, 10);
+
+    HT_EQ(rb_reserve(&s_rb, &p_wr), RB_SIZE - 10);
+    HT_CHECK(p_wr == &s_buf[10]);
+    HT_EQ(rb_write(&s_rb, data, 12), 12);
+    HT_EQ(rb_reserve(&s_rb, &p_wr), 4);
+    HT_CHECK(p_wr == &s_buf[6]);
+
+    HT_EQ(rb_peek(&s_rb, &p_rd), 6);
+    HT_CHECK(p_rd == &s_buf[10]);
+    HT_CHECK(memcmp(p_rd, data, 6) == 0);
+    rb_consume(&s_rb, 6);
+    HT_EQ(rb_peek(&s_rb, &p_rd), 6);
+    HT_CHECK(p_rd == &s_buf[0]);
+    HT_CHECK(memcmp(p_rd, &data[6], 6) == 0);
+
+    // 一部だけcommit/consumeしても続きから
+    HT_EQ(rb_reserve(&s_rb, &p_wr), RB_SIZE - 6);
+    p_wr[0] = 0x99;
+    rb_commit(&s_rb, 1);
+    rb_consume(&s_rb, 5);
+    HT_EQ(rb_read(&s_rb, out, sizeof(out)), 2);
+    HT_EQ(out[0], data[11]);
+    HT_EQ(out[1], 0x99);
+}
+
+// 【乱数の比較】
+// head/tailの32bitの折り返しの手前から始め、いろいろな書き方/読み方を混ぜて単純なFIFOと比べる
+static void test_random(void)
+{
+    static uint8_t s_ref[RB_SIZE];
+    uint32_t ref_head = 0;
+    uint32_t ref_num = 0;
+    uint32_t overrun = 0;
+    uint32_t peak = 0;
+    uint8_t tmp[RB_SIZE * 2];
+
+    rb_init(&s_rb, s_buf, RB_SIZE);
+    s_rb.head = 0xFFFFFFF0u - 5;
+    s_rb.tail = s_rb.head;
+
+    for (uint32_t op = 0; op < RAND_OPS; op++)
+    {
+        uint32_t kind = ht_rand_below(6);
+        uint32_t len = ht_rand_below(RB_SIZE + 4);
+
+        if (kind == 0) {
+            uint8_t data = (uint8_t)ht_rand();
+            bool is_ok = rb_put(&s_rb, data);
+            HT_CHECK(is_ok == (ref_num < RB_SIZE));
+            if (is_ok) {
+                s_ref[(ref_head + ref_num++) % RB_SIZE] = data;
+            } else {
+                overrun++;
+            }
+        } else if (kind == 1 || kind == 2) {
+            uint32_t free = RB_SIZE - ref_num;
+            uint32_t contig = RB_SIZE - (s_rb.head & (RB_SIZE - 1));
+            uint32_t n;
+            for (uint32_t i = 0; i < len; i++)
+            {
+                tmp[i] = (uint8_t)ht_rand();
+            }
+            if (kind == 1) {
+                n = rb_write(&s_rb, tmp, len);
+            } else {
+                uint8_t *p_wr;
+                n = rb_reserve(&s_rb, &p_wr);
+                n = (n < len) ? n : len;
+                memcpy(p_wr, tmp, n);
+                rb_commit(&s_rb, n);
+                free = (free < contig) ? free : contig;  // 折り返しの手前まで
+            }
+            HT_EQ(n, (len < free) ? len : free);
+            for (uint32_t i = 0; i < n; i++)
+            {
+                s_ref[(ref_head + ref_num++) % RB_SIZE] = tmp[i];
+            }
+        } else if (kind == 3 || kind == 4) {
+            uint32_t n;
+            if (kind == 3) {
+                n = rb_read(&s_rb, tmp, len);
+                HT_EQ(n, (len < ref_num) ? len : ref_num);
+            } else {
+                const uint8_t *p_rd;
+                uint32_t contig = RB_SIZE - (s_rb.tail & (RB_SIZE - 1));
+                n = rb_peek(&s_rb, &p_rd);
+                HT_EQ(n, (ref_num < contig) ? ref_num : contig);
+                n = (n < len) ? n : len;
+                memcpy(tmp, p_rd, n);
+                rb_consume(&s_rb, n);
+            }
+            for (uint32_t i = 0; i < n; i++)
+            {
+                HT_EQ(tmp[i], s_ref[ref_head]);
+                ref_head = (ref_head + 1) % RB_SIZE;
+                ref_num--;
+            }
+        } else {
+            HT_EQ(rb_used(&s_rb), ref_num);
+            HT_EQ(rb_free(&s_rb), RB_SIZE - ref_num);
+        }
+        if (ref_num > peak) {
+            peak = ref_num;
+        }
+        HT_EQ(rb_used(&s_rb), ref_num);
+    }
+    HT_EQ(s_rb.overrun, overrun);
+    HT_EQ(s_rb.peak, peak);
+    HT_CHECK(s_rb.head < 0x80000000u);     // 途中で折り返している
+}
+
+// 【書き手と読み手のスレッド】
+// 書き手は連番をput/write/reserveで、読み手はread/peekで、乱数の長さで同時に回す
+// 小さいバッファで満杯と空を何度も通り、読んだ連番に抜けも重複も無いか確かめる
+typedef struct {
+    uint32_t rand;          // スレッドごとの乱数(xorshift32)
+    uint32_t bad;           // 連番が合わなかった数
+} spsc_ctx_t;
+
+static uint8_t s_spsc_buf[SPSC_SIZE];
+static ring_buf_t s_spsc;
+
+static uint32_t spsc_rand(spsc_ctx_t *p_ctx, uint32_t n)
+{
+    p_ctx->rand ^= p_ctx->rand << 13;
+    p_ctx->rand ^= p_ctx->rand >> 17;
+    p_ctx->rand ^= p_ctx->rand << 5;
+
+    return p_ctx->rand % n;
+}
+
+static uint8_t spsc_byte(uint32_t seq)
+{
+    return (uint8_t)(seq ^ (seq >> 8) ^ (seq >> 16));
+}
+
+static void *spsc_writer(void *p_arg)
+{
+    spsc_ctx_t *p_ctx = (spsc_ctx_t *)p_arg;
+    uint8_t tmp[SPSC_SIZE];
+    uint32_t seq = 0;
+
+    while (seq < SPSC_BYTES)
+    {
+        uint32_t prev = seq;
+        uint32_t kind = spsc_rand(p_ctx, 3);
+        uint32_t len = 1 + spsc_rand(p_ctx, SPSC_SIZE);
+
+        if (len > SPSC_BYTES - seq) {
+            len = SPSC_BYTES - seq;
+        }
+        if (kind == 0) {
+            // 空きがある時だけ(読み手は空きを減らさないので失敗しない)
+            if (rb_free(&s_spsc) > 0) {
+                if (!rb_put(&s_spsc, spsc_byte(seq))) {
+                    p_ctx->bad++;
+                }
+                seq++;
+            }
+        } else if (kind == 1) {
+            for (uint32_t i = 0; i < len; i++)
+            {
+                tmp[i] = spsc_byte(seq + i);
+            }
+            seq += rb_write(&s_spsc, tmp, len);
+        } else {
+            uint8_t *p_wr;
+            uint32_t n = rb_reserve(&s_spsc, &p_wr);
+            n = (n < len) ? n : len;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_wr[i] = spsc_byte(seq + i);
+            }
+            rb_commit(&s_spsc, n);
+            seq += n;
+        }
+        if (seq == prev) {
+            sched_yield();      // 満杯(CPUが1つでも読み手に回す)
+        }
+    }
+
+    return NULL;
+}
+
+static void *spsc_reader(void *p_arg)
+{
+    spsc_ctx_t *p_ctx = (spsc_ctx_t *)p_arg;
+    uint8_t tmp[SPSC_SIZE];
+    uint32_t seq = 0;
+
+    while (seq < SPSC_BYTES)
+    {
+        uint32_t len = 1 + spsc_rand(p_ctx, SPSC_SIZE);
+        const uint8_t *p_data = tmp;
+        uint32_t n;
+
+        if (spsc_rand(p_ctx, 2) == 0) {
+            n = rb_read(&s_spsc, tmp, len);
+        } else {
+            n = rb_peek(&s_spsc, &p_data);
+            n = (n < len) ? n : len;
+        }
+        if (rb_used(&s_spsc) > SPSC_SIZE) {
+            p_ctx->bad++;
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (p_data[i] != spsc_byte(seq + i)) {
+                p_ctx->bad++;
+            }
+        }
+        if (p_data != tmp) {
+            rb_consume(&s_spsc, n);
+        }
+        if (n == 0) {
+            sched_yield();      // 空
+        }
+        seq += n;
+    }
+
+    return NULL;
+}
+
+static void test_spsc(void)
+{
+    spsc_ctx_t writer = {.rand = 0x12345678u};
+    spsc_ctx_t reader = {.rand = 0x9ABCDEF0u};
+    pthread_t thread[2];
+
+    rb_init(&s_spsc, s_spsc_buf, SPSC_SIZE);
+    s_spsc.head = (uint32_t)(0xFFFFFFFFu - SPSC_BYTES / 2);
+    s_spsc.tail = s_spsc.head;
+
+    HT_CHECK(pthread_create(&thread[0], NULL, spsc_writer, &writer) == 0);
+    HT_CHECK(pthread_create(&thread[1], NULL, spsc_reader, &reader) == 0);
+    pthread_join(thread[0], NULL);
+    pthread_join(thread[1], NULL);
+
+    HT_EQ(writer.bad, 0);
+    HT_EQ(reader.bad, 0);
+    HT_EQ(rb_used(&s_spsc), 0);
+    HT_EQ(s_spsc.head, (uint32_t)(0xFFFFFFFFu - SPSC_BYTES / 2 + SPSC_BYTES));
+    HT_EQ(s_spsc.overrun, 0);
+    HT_CHECK(s_spsc.peak <= SPSC_SIZE);
+}
+
+int main(void)
+{
+    ht_srand(0x5B5Cu);
+
+    HT_RUN(test_init);
+    HT_RUN(test_full_empty);
+    HT_RUN(test_wrap);
+    HT_RUN(test_random);
+    HT_RUN(test_spsc);
+
+    return HT_RESULT();
+}
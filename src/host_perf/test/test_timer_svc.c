@@ -0,0 +1,314 @@
+/**
+ * @file test_timer_svc.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief timer_svc.cのテスト(仮想時計とH/Wアラームで満了時刻、遅れ、ID、32bitのtickの折り返し)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "timer_svc.h"
+
+#define CB_LOG_MAX      512
+#define NO_ALARM        UINT64_MAX
+
+// 【仮想時計とH/Wアラーム】
+static uint64_t s_now_us;
+static uint64_t s_alarm_us = NO_ALARM;
+static uint32_t s_alarm_sets;
+
+static uint64_t fake_now_us(void)
+{
+    return s_now_us;
+}
+
+static void fake_set_alarm(uint64_t at_us)
+{
+    HT_CHECK(at_us > s_now_us);     // 過去のアラームは設定しない
+    s_alarm_us = at_us;
+    s_alarm_sets++;
+}
+
+static void fake_cancel_alarm(void)
+{
+    s_alarm_us = NO_ALARM;
+}
+
+static const timer_svc_ops_t s_fake_ops = {
+    .now_us = fake_now_us,
+    .set_alarm = fake_set_alarm,
+    .cancel_alarm = fake_cancel_alarm,
+};
+
+// コールバックを呼んだIDと時刻
+typedef struct {
+    int32_t id;
+    uint64_t us;
+} cb_log_t;
+
+static cb_log_t s_cb_log[CB_LOG_MAX];
+static uint32_t s_cb_num;
+
+static void on_timer(int32_t id, void *p_arg)
+{
+    (void)p_arg;
+    if (s_cb_num < CB_LOG_MAX) {
+        s_cb_log[s_cb_num].id = id;
+        s_cb_log[s_cb_num].us = s_now_us;
+    }
+    s_cb_num++;
+}
+
+static void svc_start(uint64_t now_us)
+{
+    s_now_us = now_us;
+    s_alarm_us = NO_ALARM;
+    s_alarm_sets = 0;
+    s_cb_num = 0;
+    timer_svc_init(&s_fake_ops);
+}
+
+// target_usまで時計を進める(途中のアラームはその時刻に割り込みとして届ける)
+static void run_until(uint64_t target_us)
+{
+    while (s_alarm_us <= target_us)
+    {
+        s_now_us = s_alarm_us;
+        s_alarm_us = NO_ALARM;
+        timer_svc_notify();
+        timer_svc_poll();
+    }
+    s_now_us = target_us;
+    timer_svc_poll();
+}
+
+static void test_add_invalid(void)
+{
+    HT_EQ(timer_svc_add(10, 0, on_timer, NULL), -1);    // 初期化前
+    HT_EQ(timer_svc_poll(), 0);
+
+    svc_start(1000000);
+    HT_EQ(timer_svc_add(10, 0, NULL, NULL), -1);
+    HT_EQ(timer_svc_add(TIMER_SVC_MAX_MS, 0, on_timer, NULL), -1);
+    HT_EQ(timer_svc_add(10, TIMER_SVC_MAX_MS + 1, on_timer, NULL), -1);
+    HT_EQ(s_alarm_sets, 0);
+    HT_CHECK(!timer_svc_cancel(0));
+    HT_CHECK(!timer_svc_cancel(1));
+    HT_CHECK(!timer_svc_cancel(TIMER_SVC_MAX + 1));
+}
+
+// 満了はtickに切り上げ、早くは呼ばない。アラームが無くても時刻で追いつく
+static void test_one_shot(void)
+{
+    timer_svc_stats_t stats;
+
+    svc_start(5000250);
+    int32_t id = timer_svc_add(10, 0, on_timer, NULL);
+    HT_EQ(id, 1);
+    HT_EQ(s_alarm_us, 5011000);
+
+    s_now_us = 5010999;
+    HT_EQ(timer_svc_poll(), 0);
+    run_until(5020000);
+    HT_EQ(s_cb_num, 1);
+    HT_EQ(s_cb_log[0].id, id);
+    HT_EQ(s_cb_log[0].us, 5011000);
+    HT_EQ(s_alarm_us, NO_ALARM);
+    HT_CHECK(!timer_svc_cancel(id));
+
+    // 割り込みを取りこぼして3ms遅れた
+    id = timer_svc_add(5, 0, on_timer, NULL);
+    HT_EQ(s_alarm_us, 5025000);
+    s_now_us = 5028000;
+    HT_EQ(timer_svc_poll(), 1);
+    timer_svc_get_stats(&stats);
+    HT_EQ(stats.fired, 2);
+    HT_EQ(stats.late_max_us, 3000);
+    HT_EQ(stats.late_sum_us, 3000);
+    HT_EQ(stats.active, 0);
+    HT_EQ(stats.peak, 1);
+    HT_EQ(stats.irqs, 1);
+}
+
+// 周期は満了時刻から足すのでずれず、遅れも無い
+static void test_periodic(void)
+{
+    timer_svc_stats_t stats;
+
+    svc_start(1000000);
+    int32_t id_a = timer_svc_add(5, 5, on_timer, NULL);
+    int32_t id_b = timer_svc_add(300, 0, on_timer, NULL);
+    run_until(2000000);
+
+    HT_EQ(s_cb_num, 200 + 1);
+    uint32_t num_a = 0;
+    for (uint32_t i = 0; i < s_cb_num; i++)
+    {
+        if (s_cb_log[i].id == id_a) {
+            num_a++;
+            HT_EQ(s_cb_log[i].us, 1000000 + num_a * 5000);
+        } else {
+            HT_EQ(s_cb_log[i].id, id_b);
+            HT_EQ(s_cb_log[i].us, 1300000);
+        }
+    }
+    HT_EQ(num_a, 200);
+    timer_svc_get_stats(&stats);
+    HT_EQ(stats.late_max_us, 0);
+    HT_EQ(stats.overruns, 0);
+    HT_EQ(stats.active, 1);
+    HT_CHECK(stats.irqs >= 200);
+
+    timer_svc_clear_stats();
+    timer_svc_get_stats(&stats);
+    HT_EQ(stats.fired, 0);
+    HT_EQ(stats.peak, 1);
+    HT_EQ(timer_svc_cancel_all(), 1);
+    HT_EQ(s_alarm_us, NO_ALARM);
+}
+
+// 【コールバックの中での操作】
+// id 1: 3回目で自分を取り消す、id 2: ワンショットで登録し直す(同じIDが返る)
+static int32_t s_readd_id;
+
+static void on_timer_edit(int32_t id, void *p_arg)
+{
+    uint32_t *p_count = (uint32_t *)p_arg;
+
+    on_timer(id, NULL);
+    (*p_count)++;
+    if (id == 1 && *p_count == 3) {
+        HT_CHECK(timer_svc_cancel(id));
+    }
+    if (id == 2 && *p_count < 4) {
+        s_readd_id = timer_svc_add(7, 0, on_timer_edit, p_arg);
+        HT_EQ(s_readd_id, id);
+    }
+}
+
+static void test_cb_edit(void)
+{
+    uint32_t count_1 = 0;
+    uint32_t count_2 = 0;
+
+    svc_start(0);
+    HT_EQ(timer_svc_add(10, 10, on_timer_edit, &count_1), 1);
+    HT_EQ(timer_svc_add(7, 0, on_timer_edit, &count_2), 2);
+    run_until(1000000);
+    HT_EQ(count_1, 3);
+    HT_EQ(count_2, 4);
+    HT_EQ(s_cb_log[s_cb_num - 1].us, 30000);
+    HT_EQ(s_alarm_us, NO_ALARM);
+    HT_EQ(timer_svc_cancel_all(), 0);
+}
+
+// IDは1～TIMER_SVC_MAX、埋まったら-1。取り消せばそのIDが空く
+static void test_id_full(void)
+{
+    timer_svc_stats_t stats;
+    uint32_t pos = 0;
+    timer_svc_info_t info;
+
+    svc_start(0);
+    for (int32_t i = 1; i <= TIMER_SVC_MAX; i++)
+    {
+        HT_EQ(timer_svc_add((uint32_t)i, 0, on_timer, NULL), i);
+    }
+    HT_EQ(timer_svc_add(1, 0, on_timer, NULL), -1);
+    HT_CHECK(timer_svc_cancel(100));
+    HT_EQ(timer_svc_add(1, 0, on_timer, NULL), 100);
+
+    uint32_t num = 0;
+    while (timer_svc_next(&pos, &info))
+    {
+        num++;
+    }
+    HT_EQ(num, TIMER_SVC_MAX);
+    timer_svc_get_stats(&stats);
+    HT_EQ(stats.peak, TIMER_SVC_MAX);
+    HT_EQ(timer_svc_cancel_all(), TIMER_SVC_MAX);
+    HT_EQ(s_alarm_us, NO_ALARM);
+}
+
+static void test_next(void)
+{
+    uint32_t pos = 0;
+    timer_svc_info_t info;
+
+    svc_start(3000000);
+    timer_svc_add(50, 0, on_timer, NULL);
+    timer_svc_add(20, 20, on_timer, NULL);
+    run_until(3030500);
+
+    HT_CHECK(timer_svc_next(&pos, &info));
+    HT_EQ(info.id, 1);
+    HT_EQ(info.remain_us, 19500);
+    HT_EQ(info.period_us, 0);
+    HT_EQ(info.fired, 0);
+    HT_CHECK(timer_svc_next(&pos, &info));
+    HT_EQ(info.id, 2);
+    HT_EQ(info.remain_us, 9500);
+    HT_EQ(info.period_us, 20000);
+    HT_EQ(info.fired, 1);
+    HT_CHECK(!timer_svc_next(&pos, &info));
+    HT_CHECK(!timer_svc_next(&pos, &info));
+}
+
+// 【32bitのtickの折り返し】
+// tickはms単位の32bitなので約49.7日で0に戻る。μsの時刻はそのまま進み続ける
+static void test_tick_wrap(void)
+{
+    const uint64_t wrap_us = (1ULL << 32) * TIMER_SVC_TICK_US;
+    uint32_t pos = 0;
+    timer_svc_info_t info;
+
+    svc_start(wrap_us - 50000 + 400);
+    int32_t id_a = timer_svc_add(20, 20, on_timer, NULL);
+    int32_t id_b = timer_svc_add(100, 0, on_timer, NULL);
+    HT_EQ(s_alarm_us, wrap_us - 30000 + 1000);
+
+    run_until(wrap_us - 1000);
+    HT_CHECK(timer_svc_next(&pos, &info));
+    HT_EQ(info.remain_us, 12000);               // 折り返しの後
+    HT_CHECK(timer_svc_next(&pos, &info));
+    HT_EQ(info.remain_us, 52000);
+    HT_CHECK(s_alarm_us >= wrap_us);
+
+    run_until(wrap_us + 200000);
+    uint64_t prev_us = 0;
+    uint32_t num_a = 0;
+    for (uint32_t i = 0; i < s_cb_num; i++)
+    {
+        HT_CHECK(s_cb_log[i].us >= prev_us);
+        prev_us = s_cb_log[i].us;
+        if (s_cb_log[i].id == id_a) {
+            num_a++;
+            HT_EQ(s_cb_log[i].us, wrap_us - 49000 + num_a * 20000);
+        } else {
+            HT_EQ(s_cb_log[i].id, id_b);
+            HT_EQ(s_cb_log[i].us, wrap_us + 51000);
+        }
+    }
+    HT_EQ(num_a, 12);
+    HT_EQ(s_cb_num, 12 + 1);
+
+    timer_svc_stats_t stats;
+    timer_svc_get_stats(&stats);
+    HT_EQ(stats.late_max_us, 0);
+    HT_EQ(timer_svc_cancel_all(), 1);
+}
+
+int main(void)
+{
+    HT_RUN(test_add_invalid);
+    HT_RUN(test_one_shot);
+    HT_RUN(test_periodic);
+    HT_RUN(test_cb_edit);
+    HT_RUN(test_id_full);
+    HT_RUN(test_next);
+    HT_RUN(test_tick_wrap);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,281 @@
+/**
+ * @file test_timer_wheel.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief timer_wheel.cのテスト(仮想のtickで満了時刻、カスケード、32bitの折り返し)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "timer_wheel.h"
+
+#define RAND_TIMERS     200
+#define RAND_STEPS      4000
+
+// テスト用のタイマー(満了すべきtickを別に持って比べる)
+typedef struct {
+    tw_timer_t tw;
+    uint32_t expect;        // 次に満了すべきtick
+    uint32_t fired;
+    uint32_t late;          // expect以外のtickで満了した回数
+    bool is_active;
+} test_timer_t;
+
+static tw_wheel_t s_wheel;
+static test_timer_t s_timer[RAND_TIMERS];
+
+static test_timer_t *test_timer_of(tw_timer_t *p_tw)
+{
+    return (test_timer_t *)((uint8_t *)p_tw - offsetof(test_timer_t, tw));
+}
+
+static void on_expire(tw_timer_t *p_tw, void *p_ctx)
+{
+    test_timer_t *p_timer = test_timer_of(p_tw);
+    const tw_wheel_t *p_wheel = (const tw_wheel_t *)p_ctx;
+
+    if (p_wheel->now != p_timer->expect) {
+        p_timer->late++;
+    }
+    p_timer->fired++;
+    if (p_tw->period != 0) {
+        p_timer->expect += p_tw->period;
+    } else {
+        p_timer->is_active = false;
+    }
+}
+
+static void timer_reset(void)
+{
+    for (uint32_t i = 0; i < RAND_TIMERS; i++)
+    {
+        tw_timer_init(&s_timer[i].tw);
+        s_timer[i].expect = 0;
+        s_timer[i].fired = 0;
+        s_timer[i].late = 0;
+        s_timer[i].is_active = false;
+    }
+}
+
+static void timer_start(test_timer_t *p_timer, uint32_t delay, uint32_t period)
+{
+    HT_CHECK(tw_add(&s_wheel, &p_timer->tw, delay, period));
+    p_timer->expect = s_wheel.now + ((delay == 0) ? 1 : delay);
+    p_timer->is_active = true;
+}
+
+static uint32_t advance(uint32_t step)
+{
+    return tw_advance(&s_wheel, s_wheel.now + step, on_expire, &s_wheel);
+}
+
+// 乱数の遅延(1段目に入るものから4段目に入るものまで同じ割合で)
+static uint32_t rand_delay(void)
+{
+    uint32_t bits = ht_rand_below(TW_SLOT_BITS * TW_LEVEL_NUM + 1);
+
+    return (bits == 0) ? 0 : (ht_rand() & (uint32_t)((1UL << bits) - 1));
+}
+
+// どのタイマーも満了すべきtickちょうどに満了し、進めた時点で満了済みのものは残らない
+// tw_next_expiry()はどの満了よりも後にならない
+static void check_timers(void)
+{
+    uint32_t active = 0;
+    uint32_t first = TW_NO_EXPIRY;
+
+    for (uint32_t i = 0; i < RAND_TIMERS; i++)
+    {
+        const test_timer_t *p_timer = &s_timer[i];
+
+        HT_EQ(p_timer->late, 0);
+        HT_CHECK(p_timer->is_active == p_timer->tw.is_active);
+        if (p_timer->is_active) {
+            uint32_t delta = p_timer->expect - s_wheel.now;
+            HT_CHECK((int32_t)delta > 0);
+            if (delta < first) {
+                first = delta;
+            }
+            active++;
+        }
+    }
+    HT_EQ(s_wheel.active, active);
+    HT_CHECK(tw_next_expiry(&s_wheel) <= first);
+    if (active == 0) {
+        HT_EQ(tw_next_expiry(&s_wheel), TW_NO_EXPIRY);
+    }
+}
+
+static void test_add_cancel(void)
+{
+    tw_init(&s_wheel, 100);
+    timer_reset();
+    HT_EQ(tw_next_expiry(&s_wheel), TW_NO_EXPIRY);
+    HT_CHECK(!tw_add(&s_wheel, &s_timer[0].tw, TW_MAX_TICKS + 1, 0));
+    HT_CHECK(!tw_add(&s_wheel, &s_timer[0].tw, 1, TW_MAX_TICKS + 1));
+    HT_CHECK(!tw_cancel(&s_wheel, &s_timer[0].tw));
+    HT_EQ(s_wheel.active, 0);
+
+    // 遅延0は1tick後(処理済みのtickには入れない)
+    timer_start(&s_timer[0], 0, 0);
+    HT_EQ(s_timer[0].tw.expires, 101);
+    HT_EQ(tw_next_expiry(&s_wheel), 1);
+
+    // 動いているタイマーを設定し直すと入れ替わる(2段目以上は並べ直しのtickまで)
+    timer_start(&s_timer[0], 5000, 0);
+    HT_EQ(s_wheel.active, 1);
+    HT_EQ(s_timer[0].tw.level, 2);
+    HT_CHECK(tw_next_expiry(&s_wheel) <= 5000);
+    HT_EQ(advance(4999), 0);
+    HT_CHECK(s_timer[0].tw.is_active);
+    HT_EQ(advance(1), 1);
+    HT_EQ(s_timer[0].fired, 1);
+    HT_CHECK(s_wheel.cascades >= 2);
+    check_timers();
+
+    // 最大のtick数は4段目に入って満了する
+    timer_start(&s_timer[1], TW_MAX_TICKS, 0);
+    HT_EQ(s_timer[1].tw.level, TW_LEVEL_NUM - 1);
+    HT_EQ(advance(TW_MAX_TICKS - 1), 0);
+    HT_EQ(advance(1), 1);
+    check_timers();
+
+    timer_start(&s_timer[2], 10, 0);
+    HT_CHECK(tw_cancel(&s_wheel, &s_timer[2].tw));
+    s_timer[2].is_active = false;
+    HT_CHECK(!tw_cancel(&s_wheel, &s_timer[2].tw));
+    HT_EQ(advance(1000), 0);
+    HT_EQ(s_timer[2].fired, 0);
+    check_timers();
+}
+
+// 周期は満了tickから足すので、まとめて進めても間隔がずれない
+static void test_periodic(void)
+{
+    tw_init(&s_wheel, 0);
+    timer_reset();
+    timer_start(&s_timer[0], 3, 7);
+    timer_start(&s_timer[1], 100, 100);
+    timer_start(&s_timer[2], 1, 1);
+
+    HT_EQ(advance(2), 2);
+    HT_EQ(advance(998), 143 + 10 + 998);
+    HT_EQ(s_timer[0].fired, 143);       // 3, 10, ... 997
+    HT_EQ(s_timer[1].fired, 10);
+    HT_EQ(s_timer[2].fired, 1000);
+    HT_EQ(s_wheel.overruns, 0);
+    check_timers();
+
+    HT_CHECK(tw_cancel(&s_wheel, &s_timer[2].tw));
+    s_timer[2].is_active = false;
+    HT_EQ(advance(100000), 14286 + 1000);
+    HT_EQ(s_timer[0].fired, 143 + 14286);
+    HT_EQ(s_timer[1].fired, 10 + 1000);
+    check_timers();
+}
+
+// 【コールバックの中での操作】
+// 同じtickの他のタイマーを取り消す、自分を設定し直す
+static void on_expire_edit(tw_timer_t *p_tw, void *p_ctx)
+{
+    test_timer_t *p_timer = test_timer_of(p_tw);
+
+    (void)p_ctx;
+    p_timer->fired++;
+    if (p_timer == &s_timer[0]) {
+        tw_cancel(&s_wheel, &s_timer[1].tw);
+        tw_add(&s_wheel, p_tw, 5, 0);
+    }
+}
+
+static void test_expire_edit(void)
+{
+    tw_init(&s_wheel, 0);
+    timer_reset();
+    tw_add(&s_wheel, &s_timer[0].tw, 10, 0);
+    tw_add(&s_wheel, &s_timer[1].tw, 10, 0);
+    HT_EQ(tw_advance(&s_wheel, 10, on_expire_edit, NULL), 1);
+    HT_EQ(s_timer[1].fired, 0);
+    HT_CHECK(!s_timer[1].tw.is_active);
+    HT_CHECK(s_timer[0].tw.is_active);
+    HT_EQ(s_timer[0].tw.expires, 15);
+    HT_EQ(tw_advance(&s_wheel, 20, on_expire_edit, NULL), 2);   // 15と20
+    HT_EQ(s_timer[0].fired, 3);
+    HT_EQ(s_wheel.active, 1);
+}
+
+// 32bitのtickの折り返しをまたいでも順序と間隔が保たれる
+static void test_wrap(void)
+{
+    tw_init(&s_wheel, 0xFFFFFFF0u);
+    timer_reset();
+    timer_start(&s_timer[0], 0x20, 0);      // 0x10で満了
+    timer_start(&s_timer[1], 7, 7);         // 0xFFFFFFF7, 0xFFFFFFFE, 0x5, ...
+    timer_start(&s_timer[2], 0x1000, 0);    // 0xFF0で満了(2段目から降りてくる)
+
+    HT_EQ(advance(0x0F), 2);
+    HT_EQ(s_wheel.now, 0xFFFFFFFFu);
+    HT_EQ(advance(0x11), 1 + 2);
+    HT_EQ(s_wheel.now, 0x10);
+    HT_EQ(s_timer[0].fired, 1);
+    HT_EQ(s_timer[1].expect, 0x13);
+    check_timers();
+
+    HT_EQ(advance(0xFE0), 1 + 581);     // 周期は0x13から0xFEFまで
+    HT_EQ(s_timer[2].fired, 1);
+    check_timers();
+}
+
+// 【乱数の比較】
+// 追加、取り消し、大小の前進を乱数で繰り返し、毎回満了すべきtickと比べる
+static void rand_run(uint32_t start)
+{
+    tw_init(&s_wheel, start);
+    timer_reset();
+    for (uint32_t step = 0; step < RAND_STEPS; step++)
+    {
+        test_timer_t *p_timer = &s_timer[ht_rand_below(RAND_TIMERS)];
+        uint32_t op = ht_rand_below(8);
+
+        if (op < 3) {
+            uint32_t period = (ht_rand_below(2) == 0) ? 0 : 256 + (rand_delay() >> 1);
+            timer_start(p_timer, rand_delay(), period);
+        } else if (op == 3) {
+            HT_CHECK(tw_cancel(&s_wheel, &p_timer->tw) == p_timer->is_active);
+            p_timer->is_active = false;
+        } else if (ht_rand_below(128) == 0) {
+            advance(ht_rand_below(1UL << 20));
+        } else {
+            advance(ht_rand_below(op == 4 ? 64 : 5000));
+        }
+        check_timers();
+    }
+    HT_EQ(s_wheel.overruns, 0);
+}
+
+static void test_random(void)
+{
+    rand_run(0);
+}
+
+static void test_random_wrap(void)
+{
+    rand_run(0xFFFFFFFFu - 3000000u);
+    HT_CHECK(s_wheel.now < 0x80000000u);    // 途中で折り返している
+}
+
+int main(void)
+{
+    ht_srand(0x7137u);
+
+    HT_RUN(test_add_cancel);
+    HT_RUN(test_periodic);
+    HT_RUN(test_expire_edit);
+    HT_RUN(test_wrap);
+    HT_RUN(test_random);
+    HT_RUN(test_random_wrap);
+
+    return HT_RESULT();
+}
@@ -0,0 +1,213 @@
+/**
+ * @file test_trace.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief trace.cのテスト(書き込みと読み出し、上書き、16進ダンプ)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * ※環境変数TRACE_DUMP_LOGがあれば、そこへtraceコマンドと同じ形式のダンプを書く
+ *   (test_trace2json.pyがtools/trace2json.pyで読み戻して確かめる)
+ */
+#include "host_test.h"
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DUMP_EVENTS_PER_LINE    4   // dbg_com.hのTRACE_DUMP_EVENTS_PER_LINEと同じ
+
+static uint32_t s_now_us;
+static uint32_t s_core;
+
+static uint32_t fake_now_us(void)
+{
+    return s_now_us;
+}
+
+static uint32_t fake_core_num(void)
+{
+    return s_core;
+}
+
+static const trace_ops_t s_fake_ops = {
+    .now_us = fake_now_us,
+    .core_num = fake_core_num,
+};
+
+static void emit_at(uint32_t core, uint32_t ts, trace_type_t type, trace_id_t id, int32_t arg)
+{
+    s_core = core;
+    s_now_us = ts;
+    TRACE_EMIT(type, id, arg);
+}
+
+// 初期化直後と時刻の関数が無いときは記録しない
+static void test_enable(void)
+{
+    trace_init(NULL);
+    trace_set_enabled(true);
+    HT_CHECK(!g_is_trace_enabled);
+
+    trace_init(&s_fake_ops);
+    HT_CHECK(!g_is_trace_enabled);
+    emit_at(0, 100, TRACE_TYPE_INSTANT, TRACE_ID_USER, 1);
+    HT_EQ(trace_count(0, NULL), 0);
+
+    trace_set_enabled(true);
+    emit_at(0, 100, TRACE_TYPE_INSTANT, TRACE_ID_USER, 1);
+    HT_EQ(trace_count(0, NULL), 1);
+    trace_set_enabled(false);
+    emit_at(0, 101, TRACE_TYPE_INSTANT, TRACE_ID_USER, 2);
+    HT_EQ(trace_count(0, NULL), 1);
+}
+
+// コアごとのリングに書いた順に読める、範囲外のコアは捨てる
+static void test_emit_read(void)
+{
+    trace_event_t ev;
+    uint32_t lost;
+
+    trace_init(&s_fake_ops);
+    trace_set_enabled(true);
+    emit_at(0, 10, TRACE_TYPE_BEGIN, TRACE_ID_CMD, 3);
+    emit_at(1, 11, TRACE_TYPE_COUNTER, TRACE_ID_USER, -5);
+    emit_at(0, 12, TRACE_TYPE_END, TRACE_ID_CMD, 3);
+    emit_at(TRACE_CORE_NUM, 13, TRACE_TYPE_INSTANT, TRACE_ID_USER, 0);
+
+    HT_EQ(trace_count(0, &lost), 2);
+    HT_EQ(lost, 0);
+    HT_EQ(trace_count(1, NULL), 1);
+    HT_EQ(trace_count(TRACE_CORE_NUM, &lost), 0);
+
+    HT_CHECK(trace_read(0, 1, &ev));
+    HT_EQ(ev.ts, 12);
+    HT_EQ(ev.id, TRACE_ID_CMD);
+    HT_EQ(ev.type, TRACE_TYPE_END);
+    HT_EQ(ev.arg, 3);
+    HT_CHECK(trace_read(1, 0, &ev));
+    HT_CHECK(ev.arg == -5 && ev.type == TRACE_TYPE_COUNTER);
+    HT_CHECK(!trace_read(0, 2, &ev));
+    HT_CHECK(!trace_read(TRACE_CORE_NUM, 0, &ev));
+
+    trace_clear();
+    HT_EQ(trace_count(0, NULL) + trace_count(1, NULL), 0);
+    HT_CHECK(strcmp(trace_id_name(TRACE_ID_TIMER_CB), "timer_callback") == 0);
+    HT_CHECK(strcmp(trace_id_name(TRACE_ID_NUM), "?") == 0);
+}
+
+// 埋まったら古いものから上書きし、失った数を数える
+static void test_overwrite(void)
+{
+    trace_event_t ev;
+    uint32_t lost;
+
+    trace_init(&s_fake_ops);
+    trace_set_enabled(true);
+    for (uint32_t i = 0; i < TRACE_RING_SIZE * 3 + 5; i++)
+    {
+        emit_at(1, i, TRACE_TYPE_COUNTER, TRACE_ID_USER, (int32_t)i);
+    }
+    HT_EQ(trace_count(1, &lost), TRACE_RING_SIZE);
+    HT_EQ(lost, TRACE_RING_SIZE * 2 + 5);
+    for (uint32_t idx = 0; idx < TRACE_RING_SIZE; idx++)
+    {
+        HT_CHECK(trace_read(1, idx, &ev));
+        HT_EQ(ev.arg, lost + idx);
+    }
+    HT_CHECK(!trace_read(1, TRACE_RING_SIZE, &ev));
+}
+
+static void test_format_hex(void)
+{
+    trace_event_t ev = {0x12345678u, TRACE_ID_USER, TRACE_TYPE_INSTANT, 0, -2};
+    char buf[sizeof(ev) * 2 + 1];
+
+    HT_EQ(trace_format_hex(buf, sizeof(buf), &ev, sizeof(ev)), 24);
+    HT_CHECK(strcmp(buf, "7856341205000200feffffff") == 0);
+    HT_EQ(trace_format_hex(buf, sizeof(buf) - 1, &ev, sizeof(ev)), -1);
+    HT_EQ(trace_format_hex(buf, 1, &ev, 0), 0);
+    HT_EQ(buf[0], '\0');
+}
+
+// dbg_com.cのtrace_dump()と同じ形式で書く
+static void write_dump(FILE *p_file)
+{
+    static const char *const s_cmd_tbl[] = {"help", "ver", "system", "rnd"};
+    trace_event_t ev[DUMP_EVENTS_PER_LINE];
+    char buf[sizeof(ev) * 2 + 1];
+
+    fprintf(p_file, "> trace dump\n");
+    fprintf(p_file, "%s magic=0x%08X rec=%u ts_hz=1000000 cores=%u\n", TRACE_DUMP_BEGIN,
+            (unsigned)TRACE_MAGIC, (unsigned)sizeof(trace_event_t), TRACE_CORE_NUM);
+    for (uint32_t id = 0; id < TRACE_ID_NUM; id++)
+    {
+        fprintf(p_file, "# trace id %u %s\n", id, trace_id_name(id));
+    }
+    for (uint32_t i = 0; i < sizeof(s_cmd_tbl) / sizeof(s_cmd_tbl[0]); i++)
+    {
+        fprintf(p_file, "# trace cmd %u %s\n", i, s_cmd_tbl[i]);
+    }
+    for (uint32_t core = 0; core < TRACE_CORE_NUM; core++)
+    {
+        uint32_t lost;
+        uint32_t num = trace_count(core, &lost);
+
+        fprintf(p_file, "# trace core %u events=%u lost=%u\n", core, num, lost);
+        for (uint32_t idx = 0; idx < num; idx += DUMP_EVENTS_PER_LINE)
+        {
+            uint32_t n = 0;
+            while (n < DUMP_EVENTS_PER_LINE && trace_read(core, idx + n, &ev[n]))
+            {
+                n++;
+            }
+            trace_format_hex(buf, sizeof(buf), ev, n * sizeof(trace_event_t));
+            fprintf(p_file, "%s\n", buf);
+        }
+    }
+    fprintf(p_file, "%s\n", TRACE_DUMP_END);
+}
+
+// 【ダンプの中身】(test_trace2json.pyの期待値と対応)
+// core0: 32bitの時刻の折り返しをまたぐcmd:rndの区間と、時刻が前後した瞬間イベント2つ
+// core1: 折り返しをまたいでリング+10個のカウンタ(先頭の10個は上書きで消える)
+static void test_dump(void)
+{
+    const char *p_path = getenv("TRACE_DUMP_LOG");
+
+    trace_init(&s_fake_ops);
+    trace_set_enabled(true);
+    emit_at(0, 0xFFFFFF00u, TRACE_TYPE_BEGIN, TRACE_ID_CMD, 3);
+    emit_at(0, 0x00000010u, TRACE_TYPE_INSTANT, TRACE_ID_USER, 9);
+    emit_at(0, 0xFFFFFFF0u, TRACE_TYPE_INSTANT, TRACE_ID_USER, 8);
+    emit_at(0, 0x00000100u, TRACE_TYPE_END, TRACE_ID_CMD, 3);
+    for (uint32_t i = 0; i < TRACE_RING_SIZE + 10; i++)
+    {
+        emit_at(1, 0xFFFFFC00u + i, TRACE_TYPE_COUNTER, TRACE_ID_USER, (int32_t)i);
+    }
+    trace_set_enabled(false);
+    HT_EQ(trace_count(0, NULL), 4);
+    HT_EQ(trace_count(1, NULL), TRACE_RING_SIZE);
+
+    if (p_path == NULL) {
+        return;
+    }
+    FILE *p_file = fopen(p_path, "w");
+    HT_CHECK(p_file != NULL);
+    if (p_file != NULL) {
+        write_dump(p_file);
+        HT_CHECK(fclose(p_file) == 0);
+    }
+}
+
+int main(void)
+{
+    HT_RUN(test_enable);
+    HT_RUN(test_emit_read);
+    HT_RUN(test_overwrite);
+    HT_RUN(test_format_hex);
+    HT_RUN(test_dump);
+
+    return HT_RESULT();
+}
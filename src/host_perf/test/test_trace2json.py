@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file test_trace2json.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief tools/trace2json.pyのテスト(test_traceが書いたダンプを読み戻す往復 + 単体)
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+※ctestから実行する(test_traceが環境変数TRACE_DUMP_LOGのファイルにダンプを書いてから)
+"""
+import contextlib
+import io
+import json
+import os
+import struct
+import sys
+import tempfile
+import unittest
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(TEST_DIR, "..", "..", "..", "tools"))
+
+import trace2json  # noqa: E402
+
+DUMP_LOG = os.environ.get("TRACE_DUMP_LOG")
+RING_SIZE = 1024    # trace.hのTRACE_RING_SIZE
+
+ID_CMD = 0
+ID_USER = 5
+
+
+def dump_lines(cores, magic=trace2json.TRACE_MAGIC):
+    """(core -> [(ts, id, type, arg)])からtrace dumpの行を作る"""
+    lines = ["# trace begin magic=0x%08X rec=12 ts_hz=1000000 cores=%d" % (magic, len(cores)),
+             "# trace id 0 cmd", "# trace id 5 user", "# trace cmd 3 rnd"]
+    for core, events in sorted(cores.items()):
+        lines.append("# trace core %d events=%d lost=0" % (core, len(events)))
+        for ts, ev_id, ev_type, arg in events:
+            lines.append(struct.pack(trace2json.EVENT_FMT, ts, ev_id, ev_type, 0, arg).hex())
+    lines.append("# trace end")
+    return lines
+
+
+@unittest.skipUnless(DUMP_LOG, "TRACE_DUMP_LOG is not set (run from ctest)")
+class RoundTripTest(unittest.TestCase):
+    """trace.c → ダンプ → trace2json.py の往復(test_trace.cのtest_dump()と対応)"""
+
+    @classmethod
+    def setUpClass(cls):
+        with open(DUMP_LOG, "r") as f:
+            cls.dumps = trace2json.read_dumps(f.readlines())
+
+    def test_header(self):
+        self.assertEqual(len(self.dumps), 1)
+        dump = self.dumps[0]
+        trace2json.check_header(dump)
+        self.assertEqual(dump.id_names[ID_CMD], "cmd")
+        self.assertEqual(dump.cmd_names[3], "rnd")
+        self.assertEqual(dump.lost, {0: 0, 1: 10})
+        self.assertEqual(len(dump.cores[1]), RING_SIZE * trace2json.EVENT_SIZE)
+
+    def test_core0_wrap_and_reorder(self):
+        cores = trace2json.align_cores(self.dumps[0])
+        self.assertEqual(cores[0], [
+            (0xFFFFFF00, ID_CMD, trace2json.TYPE_BEGIN, 3),
+            (0xFFFFFFF0, ID_USER, trace2json.TYPE_INSTANT, 8),
+            (0x100000010, ID_USER, trace2json.TYPE_INSTANT, 9),
+            (0x100000100, ID_CMD, trace2json.TYPE_END, 3),
+        ])
+
+    def test_core1_overwritten(self):
+        events = trace2json.align_cores(self.dumps[0])[1]
+        self.assertEqual(len(events), RING_SIZE)
+        self.assertEqual(events[0], (0xFFFFFC0A, ID_USER, trace2json.TYPE_COUNTER, 10))
+        self.assertEqual(events[-1], (0x100000009, ID_USER, trace2json.TYPE_COUNTER, RING_SIZE + 9))
+        self.assertEqual([ev[3] for ev in events], list(range(10, RING_SIZE + 10)))
+
+    def test_chrome_json(self):
+        out = io.StringIO()
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "trace.json")
+            with contextlib.redirect_stderr(out):
+                self.assertEqual(trace2json.main([DUMP_LOG, "-o", path]), 0)
+            with open(path, "r") as f:
+                events = json.load(f)["traceEvents"]
+
+        core0 = [(ev["name"], ev["ph"], ev["ts"]) for ev in events
+                 if ev.get("tid") == 0 and ev["ph"] != "M"]
+        self.assertEqual(core0, [
+            ("cmd:rnd", "B", 0xFFFFFF00),
+            ("user", "i", 0xFFFFFFF0),
+            ("user", "i", 0x100000010),
+            ("cmd:rnd", "E", 0x100000100),
+        ])
+        overwritten = [ev for ev in events if ev["name"] == "overwritten"]
+        self.assertEqual(len(overwritten), 1)
+        self.assertEqual(overwritten[0]["tid"], 1)
+        self.assertEqual(overwritten[0]["args"], {"events": 10})
+        counters = [ev for ev in events if ev["ph"] == "C"]
+        self.assertEqual(len(counters), RING_SIZE)
+        self.assertEqual(counters[-1]["args"], {"user": RING_SIZE + 9})
+
+
+class UnitTest(unittest.TestCase):
+
+    def test_bad_header(self):
+        dumps = trace2json.read_dumps(dump_lines({0: []}, magic=0x12345678))
+        with self.assertRaises(ValueError):
+            trace2json.check_header(dumps[0])
+
+    def test_align_cores_across_wrap(self):
+        # core1は折り返した後、core0はまだ折り返す前にダンプした
+        lines = dump_lines({
+            0: [(0xFFFFFFF0, ID_USER, trace2json.TYPE_INSTANT, 0)],
+            1: [(0x00000010, ID_USER, trace2json.TYPE_INSTANT, 1)],
+        })
+        cores = trace2json.align_cores(trace2json.read_dumps(lines)[0])
+        self.assertEqual(cores[0][0][0], 0xFFFFFFF0)
+        self.assertEqual(cores[1][0][0], 0x100000010)
+
+    def test_unmatched_end(self):
+        # 開始が上書きで消えた終了は捨て、閉じ忘れた内側の区間は外側の終了で閉じる
+        lines = dump_lines({0: [
+            (100, ID_USER, trace2json.TYPE_END, 0),
+            (200, ID_CMD, trace2json.TYPE_BEGIN, 3),
+            (300, ID_USER, trace2json.TYPE_BEGIN, 0),
+            (400, ID_CMD, trace2json.TYPE_END, 3),
+        ]})
+        events = trace2json.to_chrome(trace2json.read_dumps(lines)[0])
+        self.assertEqual([(ev["name"], ev["ph"], ev["ts"]) for ev in events if ev["ph"] != "M"], [
+            ("cmd:rnd", "B", 200),
+            ("user", "B", 300),
+            ("user", "E", 400),
+            ("cmd:rnd", "E", 400),
+        ])
+
+    def test_last_dump_only(self):
+        first = dump_lines({0: [(1, ID_USER, trace2json.TYPE_INSTANT, 1)]})
+        second = dump_lines({0: [(2, ID_USER, trace2json.TYPE_INSTANT, 2)]})
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "trace.log")
+            with open(path, "w") as f:
+                f.write("\n".join(first + ["> trace dump"] + second) + "\n")
+            out = io.StringIO()
+            with contextlib.redirect_stdout(out):
+                self.assertEqual(trace2json.main([path]), 0)
+            events = json.loads(out.getvalue())["traceEvents"]
+            self.assertEqual([ev["ts"] for ev in events if ev["ph"] == "i"], [2])
+
+            out = io.StringIO()
+            with contextlib.redirect_stdout(out):
+                self.assertEqual(trace2json.main([path, "--all"]), 0)
+            events = json.loads(out.getvalue())["traceEvents"]
+            self.assertEqual([(ev["pid"], ev["ts"]) for ev in events if ev["ph"] == "i"], [(0, 1), (1, 2)])
+
+    def test_no_dump(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "empty.log")
+            with open(path, "w") as f:
+                f.write("> trace stat\n")
+            with contextlib.redirect_stderr(io.StringIO()):
+                self.assertEqual(trace2json.main([path]), 1)
+
+
+if __name__ == "__main__":
+    unittest.main()
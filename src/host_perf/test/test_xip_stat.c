@@ -0,0 +1,203 @@
+/**
+ * @file test_xip_stat.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief xip_stat.cのテスト(偽のカウンタとキャッシュのモデルを注入)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "host_test.h"
+#include "xip_stat.h"
+#include <string.h>
+
+// 【偽のXIPキャッシュ】
+// ダイレクトマップ(8byteライン)で、読むたびにCTR_ACCを1、キャッシュに居ればCTR_HITも1増やす
+// 時刻は1回の読み出しで(ヒット1us、ミス10us)進める
+
+#define FAKE_LINE_SIZE      8
+#define FAKE_LINE_NUM       512         // 4KB
+#define FLASH_SIZE          (64 * 1024)
+
+static uint32_t s_ctr_hit;
+static uint32_t s_ctr_acc;
+static uint32_t s_now_us;
+static uint32_t s_clear_num;
+static uintptr_t s_tag[FAKE_LINE_NUM];
+static uint32_t s_flash[FLASH_SIZE / 4];
+
+static uint32_t fake_read_hit(void)
+{
+    return s_ctr_hit;
+}
+
+static uint32_t fake_read_acc(void)
+{
+    return s_ctr_acc;
+}
+
+static void fake_clear(void)
+{
+    s_ctr_hit = 0;
+    s_ctr_acc = 0;
+    s_clear_num++;
+}
+
+static uint32_t fake_now_us(void)
+{
+    return s_now_us;
+}
+
+static const xip_stat_ops_t s_fake_ops = {
+    .read_hit = fake_read_hit,
+    .read_acc = fake_read_acc,
+    .clear = fake_clear,
+    .now_us = fake_now_us,
+};
+
+static void fake_cache_flush(void)
+{
+    for (uint32_t i = 0; i < FAKE_LINE_NUM; i++)
+    {
+        s_tag[i] = UINTPTR_MAX;
+    }
+}
+
+static uint32_t fake_cache_read(uintptr_t addr)
+{
+    uintptr_t line = addr / FAKE_LINE_SIZE;
+    uint32_t idx = (uint32_t)(line % FAKE_LINE_NUM);
+
+    s_ctr_acc++;
+    if (s_tag[idx] == line) {
+        s_ctr_hit++;
+        s_now_us += 1;
+    } else {
+        s_tag[idx] = line;
+        s_now_us += 10;
+    }
+    return *(const uint32_t *)addr;
+}
+
+// xip_read_seq()と同じ順に偽のキャッシュを通して読む
+static uint32_t fake_read_seq(uintptr_t base, uint32_t span, uint32_t reads)
+{
+    uint32_t mask = (span / 4) - 1;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < reads; i++)
+    {
+        sum += fake_cache_read(base + (i & mask) * 4);
+    }
+    return sum;
+}
+
+static void test_delta_wrap(void)
+{
+    xip_ctr_t before = {0xFFFFFFF0u, 0xFFFFFFFEu};
+    xip_ctr_t after = {0x00000010u, 0x00000020u};
+    xip_ctr_t delta;
+
+    xip_stat_delta(&before, &after, &delta);
+    HT_EQ(delta.hit, 0x20);
+    HT_EQ(delta.acc, 0x22);
+    HT_EQ(xip_stat_miss(&delta), 2);
+
+    // 読み出しの間にヒットが進んでアクセスを追い越しても負にならない
+    xip_ctr_t odd = {10, 9};
+    HT_EQ(xip_stat_miss(&odd), 0);
+}
+
+static void test_hit_rate_format(void)
+{
+    xip_ctr_t ctr = {750, 1000};
+    xip_ctr_t none = {0, 0};
+    char buf[128];
+
+    HT_CHECK(xip_stat_hit_rate(&ctr) == 75.0f);
+    HT_CHECK(xip_stat_hit_rate(&none) == 100.0f);
+    int32_t len = xip_stat_format(buf, sizeof(buf), &ctr, 1234);
+    HT_EQ(len, (int32_t)strlen(buf));
+    HT_CHECK(strcmp(buf, "acc 1000, hit 750, miss 250, hit rate 75.00 %, 1234 us") == 0);
+
+    // バッファが短くても終端する
+    len = xip_stat_format(buf, 8, &ctr, 1234);
+    HT_CHECK(len > 8 && strlen(buf) == 7);
+}
+
+// 読み出し関数のチェックサムと折り返し(ホストのバッファで確かめる)
+static void test_read_funcs(void)
+{
+    uint32_t expect = 0;
+
+    for (uint32_t i = 0; i < FLASH_SIZE / 4; i++)
+    {
+        s_flash[i] = ht_rand();
+    }
+    for (uint32_t i = 0; i < 3000; i++)
+    {
+        expect += s_flash[i & (4096 / 4 - 1)];
+    }
+    HT_EQ(xip_read_seq((uintptr_t)s_flash, 4096, 3000), expect);
+
+    // ランダムは同じ種なら同じ列、範囲の外は読まない(ASanで確かめる)
+    uint32_t sum1 = xip_read_random((uintptr_t)s_flash, FLASH_SIZE, 10000);
+    uint32_t sum2 = xip_read_random((uintptr_t)s_flash, FLASH_SIZE, 10000);
+    HT_EQ(sum1, sum2);
+    HT_CHECK(xip_read_random((uintptr_t)s_flash, 64, 10000) != 0);
+    HT_EQ(xip_read_seq((uintptr_t)s_flash, 4, 0), 0);
+}
+
+// キャッシュに収まる範囲は2周目から全部ヒット、収まらない範囲は全部ミス
+static void test_bench_run(void)
+{
+    xip_bench_result_t result;
+
+    xip_stat_init(&s_fake_ops);
+    xip_stat_clear();
+    HT_EQ(s_clear_num, 1);
+
+    fake_cache_flush();
+    s_now_us = 0x7FFFFFF0u;
+    uint32_t lines = 2048 / FAKE_LINE_SIZE;
+    xip_bench_run(fake_read_seq, (uintptr_t)s_flash, 2048, 2048, &result);
+    HT_EQ(result.bytes, 2048 * 4);
+    HT_EQ(result.ctr.acc, 2048);
+    HT_EQ(xip_stat_miss(&result.ctr), lines);
+    HT_EQ(result.us, lines * 10 + (2048 - lines));
+    HT_EQ(result.sum, xip_read_seq((uintptr_t)s_flash, 2048, 2048));
+
+    // 時刻とカウンタが周回しても差分は正しい
+    s_now_us = 0xFFFFFF00u;
+    s_ctr_acc = 0xFFFFFF00u;
+    s_ctr_hit = 0xFFFFFF00u;
+    xip_bench_run(fake_read_seq, (uintptr_t)s_flash, 2048, 1024, &result);
+    HT_EQ(result.ctr.acc, 1024);
+    HT_EQ(result.ctr.hit, 1024);
+    HT_EQ(result.us, 1024);
+    HT_CHECK(xip_stat_hit_rate(&result.ctr) == 100.0f);
+    HT_CHECK(xip_bench_mbps(&result) == 4.0f);
+    HT_CHECK(xip_bench_ns_per_read(&result, 1024) == 1000.0f);
+
+    fake_cache_flush();
+    xip_bench_run(fake_read_seq, (uintptr_t)s_flash, FLASH_SIZE, FLASH_SIZE / 4, &result);
+    HT_EQ(xip_stat_miss(&result.ctr), FLASH_SIZE / FAKE_LINE_SIZE);
+    HT_CHECK(xip_stat_hit_rate(&result.ctr) == 50.0f);
+
+    result.us = 0;
+    HT_CHECK(xip_bench_mbps(&result) == 0.0f);
+    HT_CHECK(xip_bench_ns_per_read(&result, 0) == 0.0f);
+}
+
+int main(void)
+{
+    ht_srand(0xC0DEu);
+
+    HT_RUN(test_delta_wrap);
+    HT_RUN(test_hit_rate_format);
+    HT_RUN(test_read_funcs);
+    HT_RUN(test_bench_run);
+
+    return HT_RESULT();
+}
@@ -9,24 +9,89 @@
  * 
  */
 #include "app_cpu_core_0.h"
+#include "hot_path.h"
+#include "trace.h"
+#include "idle_hw.h"
+
+// Core1側から見たジョブ実行中フラグ
+static volatile bool s_is_job_busy = false;
+
+/**
+ * @brief Core0にジョブを依頼する(Core1から呼ぶ)
+ * @note 関数ポインタと引数をマルチコアFIFOで渡す
+ *
+ * @param func ジョブ関数
+ * @param p_arg ジョブ関数の引数
+ * @return true 依頼成功
+ * @return false 既にジョブ実行中
+ */
+bool app_core_0_job_start(app_core_0_job_func_t func, void *p_arg)
+{
+    if (s_is_job_busy) {
+        return false;
+    }
+
+    s_is_job_busy = true;
+    // FIFOへのpushもSEVを出すが、起床レイテンシを測るため先に通知の時刻を残す
+    idle_hw_notify(0, IDLE_WAKE_FIFO);
+    multicore_fifo_push_blocking((uint32_t)func);
+    multicore_fifo_push_blocking((uint32_t)p_arg);
+
+    return true;
+}
+
+/**
+ * @brief Core0のジョブ完了を待つ(Core1から呼ぶ)
+ */
+void app_core_0_job_wait(void)
+{
+    if (!s_is_job_busy) {
+        return;
+    }
+
+    while (multicore_fifo_pop_blocking() != APP_CORE_0_JOB_DONE)
+    {
+        NOP();
+    }
+    s_is_job_busy = false;
+}
+
+/**
+ * @brief Core0がジョブ実行中か
+ */
+bool app_core_0_job_is_busy(void)
+{
+    return s_is_job_busy;
+}
 
 
 /**
  * @brief CPU Core0のアプリメイン関数
  * 
  */
-void app_core_0_main(void)
+void HOT_FUNC(app_core_0_main)(void)
 {
     uint32_t core_num = get_core_num();
 
     while(1)
     {
+        // Core1からのジョブ依頼を処理
+        if (multicore_fifo_rvalid()) {
+            app_core_0_job_func_t func = (app_core_0_job_func_t)multicore_fifo_pop_blocking();
+            void *p_arg = (void *)multicore_fifo_pop_blocking();
+            TRACE_BEGIN(TRACE_ID_CORE0_JOB, 0);
+            func(p_arg);
+            TRACE_END(TRACE_ID_CORE0_JOB, 0);
+            multicore_fifo_push_blocking(APP_CORE_0_JOB_DONE);
+        } else {
+            // 依頼が来るまで寝る(バスを空けてCore1に譲る)
+            idle_hw_sleep();
+        }
 #if 0
         printf("CPU Core: %d\n", core_num);
         sleep_ms(1000);
-#else
-        NOP();NOP();NOP();
 #endif
         WDT_RST;
     }
-}
\ No newline at end of file
+}
+HOT_PATH_REGISTER(app_core_0_main);
\ No newline at end of file
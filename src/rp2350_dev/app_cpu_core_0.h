@@ -14,6 +14,14 @@
 #include "mcu_util.h"
 #include "pico/multicore.h"
 
+// Core0で実行するジョブ関数
+typedef void (*app_core_0_job_func_t)(void *p_arg);
+
+#define APP_CORE_0_JOB_DONE     0xD0E0D0E0  // ジョブ完了通知の値
+
 void app_core_0_main(void);
+bool app_core_0_job_start(app_core_0_job_func_t func, void *p_arg);
+void app_core_0_job_wait(void);
+bool app_core_0_job_is_busy(void);
 
 #endif // APP_CPU_CORE_0_H
\ No newline at end of file
@@ -11,13 +11,20 @@
 #include "app_cpu_core_1.h"
 #include "app_main.h"
 #include "dbg_com.h"
+#include "hot_path.h"
+#include "timer_svc_hw.h"
+#include "idle_hw.h"
+#include "data_pipe_hw.h"
+#include "uart_hw.h"
+#include "boot_hw.h"
 
 /**
  * @brief CPU Core1のアプリメイン関数
  * 
  */
-void app_core_1_main(void)
+void HOT_FUNC(app_core_1_main)(void)
 {
+    boot_hw_mark(BOOT_STAGE_CORE1_MAIN);
     pico_sdk_version_print();
 
 #if defined(PICO_RP2040) && !defined(PICO_RP2350)
@@ -29,17 +36,28 @@ void app_core_1_main(void)
     printf("System Clock:\t%d MHz\n", clock_get_hz(clk_sys) / 1000000);
     printf("USB Clock:\t%d MHz\n", clock_get_hz(clk_usb) / 1000000);
 
-    dbg_com_init();
+    // Core1の分の初期化タスク(ソフトウェアタイマーとデバッグモニタ、H/Wアラームの割り込みはこのコアに入る)
+    boot_hw_run();
 
     // uint32_t core_num = get_core_num();
 
     while(1)
     {
-        dbg_com_process();
+        // 満了したタイマーのコールバック(割り込みではなくここで呼ぶ)
+        timer_svc_poll();
+        // データパイプ(CDC1)の送受信、送信が残っている間は寝ない
+        bool is_pipe_busy = data_pipe_hw_poll();
+        // UARTの送信DMAの完了を見て次を出す、送信が残っている間は寝ない
+        bool is_uart_busy = uart_hw_poll();
+        // 入力が無ければ、受信かタイマーかCore0から起こされるまで寝る
+        if (!dbg_com_process() && !is_pipe_busy && !is_uart_busy) {
+            idle_hw_sleep();
+        }
 #if 0
         printf("CPU Core: %d\n", core_num);
         sleep_ms(2000);
 #endif
         WDT_RST();
     }
-}
\ No newline at end of file
+}
+HOT_PATH_REGISTER(app_core_1_main);
\ No newline at end of file
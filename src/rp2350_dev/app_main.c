@@ -13,6 +13,10 @@
 #include "app_cpu_core_1.h"
 #include "dbg_com.h"
 #include "mcu_util.h"
+#include "hot_path.h"
+
+// 数学関数のテストの結果の捨て先(volatileなので計算を消されない)
+static volatile double s_math_sink;
 
 /**
  * @brief メモリダンプ(16進HEX & Ascii)
@@ -47,7 +51,7 @@ void show_mem_dump(uint32_t dump_addr, uint32_t dump_size)
         for (int i = 0; i < 16; i++)
         {
             if (offset + i < dump_size) {
-                uint8_t data = *((volatile uint8_t*)(dump_addr + offset + i));
+                uint8_t data = *((volatile uint8_t*)(uintptr_t)(dump_addr + offset + i));
                 printf("%02X ", data);
             } else {
                 printf("   ");
@@ -59,7 +63,7 @@ void show_mem_dump(uint32_t dump_addr, uint32_t dump_size)
         for (int i = 0; i < 16; i++)
         {
             if (offset + i < dump_size) {
-                uint8_t data = *((volatile uint8_t*)(dump_addr + offset + i));
+                uint8_t data = *((volatile uint8_t*)(uintptr_t)(dump_addr + offset + i));
                 // 表示可能なASCII文字のみ表示
                 printf("%c", (data >= 32 && data <= 126) ? data : '.');
             } else {
@@ -78,7 +82,7 @@ void pico_sdk_version_print(void)
     PICO_SDK_VERSION_REVISION);
 }
 
-void int_add_test(void)
+void HOT_FUNC(int_add_test)(void)
 {
     volatile uint32_t val, i = 0;
 
@@ -87,8 +91,9 @@ void int_add_test(void)
         val += 1;
     }
 }
+HOT_PATH_REGISTER(int_add_test);
 
-void int_sub_test(void)
+void HOT_FUNC(int_sub_test)(void)
 {
     volatile uint32_t i = 0;
     volatile uint32_t val = TEST_LOOP_CNT;
@@ -98,8 +103,9 @@ void int_sub_test(void)
         val -= 1;
     }
 }
+HOT_PATH_REGISTER(int_sub_test);
 
-void int_mul_test(void)
+void HOT_FUNC(int_mul_test)(void)
 {
     volatile uint32_t i = 0;
     volatile uint32_t val = 1;
@@ -109,8 +115,9 @@ void int_mul_test(void)
         val = val * 1;
     }
 }
+HOT_PATH_REGISTER(int_mul_test);
 
-void int_div_test(void)
+void HOT_FUNC(int_div_test)(void)
 {
     volatile uint32_t i = 0;
     volatile uint32_t val = 1;
@@ -120,8 +127,9 @@ void int_div_test(void)
         val = val / 1;
     }
 }
+HOT_PATH_REGISTER(int_div_test);
 
-void float_add_test(void)
+void HOT_FUNC(float_add_test)(void)
 {
     volatile float val = 0.0f;
     volatile float inc = 1.0f;
@@ -132,8 +140,9 @@ void float_add_test(void)
         val = val + inc;
     }
 }
+HOT_PATH_REGISTER(float_add_test);
 
-void float_sub_test(void)
+void HOT_FUNC(float_sub_test)(void)
 {
     volatile float val = TEST_LOOP_CNT;
     volatile float dec = 1.0f;
@@ -144,8 +153,9 @@ void float_sub_test(void)
         val = val - dec;
     }
 }
+HOT_PATH_REGISTER(float_sub_test);
 
-void float_mul_test(void)
+void HOT_FUNC(float_mul_test)(void)
 {
     volatile float val = 1.0f;
     volatile float mul = 1.0f;
@@ -156,8 +166,9 @@ void float_mul_test(void)
         val = val * mul;
     }
 }
+HOT_PATH_REGISTER(float_mul_test);
 
-void float_div_test(void)
+void HOT_FUNC(float_div_test)(void)
 {
     volatile float val = 1.0f;
     volatile float div = 1.0f;
@@ -168,8 +179,9 @@ void float_div_test(void)
         val = val / div;
     }
 }
+HOT_PATH_REGISTER(float_div_test);
 
-void double_add_test(void)
+void HOT_FUNC(double_add_test)(void)
 {
     volatile double val = 0.0;
     volatile double inc = 1.0;
@@ -180,8 +192,9 @@ void double_add_test(void)
         val = val + inc;
     }
 }
+HOT_PATH_REGISTER(double_add_test);
 
-void double_sub_test(void)
+void HOT_FUNC(double_sub_test)(void)
 {
     volatile double val = TEST_LOOP_CNT;
     volatile double dec = 1.0;
@@ -192,8 +205,9 @@ void double_sub_test(void)
         val = val - dec;
     }
 }
+HOT_PATH_REGISTER(double_sub_test);
 
-void double_mul_test(void)
+void HOT_FUNC(double_mul_test)(void)
 {
     volatile double val = 1.0;
     volatile double mul = 1.0;
@@ -204,8 +218,9 @@ void double_mul_test(void)
         val = val * mul;
     }
 }
+HOT_PATH_REGISTER(double_mul_test);
 
-void double_div_test(void)
+void HOT_FUNC(double_div_test)(void)
 {
     volatile double val = 1.0;
     volatile double div = 1.0;
@@ -216,64 +231,93 @@ void double_div_test(void)
         val = val / div;
     }
 }
+HOT_PATH_REGISTER(double_div_test);
 
-void trig_functions_test(void)
+void HOT_FUNC(trig_functions_test)(void)
 {
     volatile double angle = 45.0;  // 45 degrees
     volatile double rad = angle * M_PI / 180.0;  // convert to radians
-    volatile double sin_val, cos_val, tan_val;
 
-    sin_val = sin(rad);
-    cos_val = cos(rad);
-    tan_val = tan(rad);
+    s_math_sink = sin(rad);
+    s_math_sink = cos(rad);
+    s_math_sink = tan(rad);
 }
+HOT_PATH_REGISTER(trig_functions_test);
 
-void atan2_test(void)
+void HOT_FUNC(atan2_test)(void)
 {
     volatile double x = 1.0;
     volatile double y = 1.0;
-    volatile double result;
 
-    result = atan2(y, x);
+    s_math_sink = atan2(y, x);
 }
+HOT_PATH_REGISTER(atan2_test);
 
-void tan_355_226_test(void)
+void HOT_FUNC(tan_355_226_test)(void)
 {
-    volatile double result;
-    result = tan(355.0 / 226.0);
+    s_math_sink = tan(355.0 / 226.0);
 }
+HOT_PATH_REGISTER(tan_355_226_test);
 
-void inverse_sqrt_test(void)
+void HOT_FUNC(inverse_sqrt_test)(void)
 {
     volatile double numbers[] = {2.0, 3.0, 4.0, 5.0};
     volatile int count = sizeof(numbers) / sizeof(numbers[0]);
-    volatile double result;
 
     for (int i = 0; i < count; i++) {
-        result = 1.0 / sqrt(numbers[i]);
+        s_math_sink = 1.0 / sqrt(numbers[i]);
     }
 }
+HOT_PATH_REGISTER(inverse_sqrt_test);
+
+/**
+ * @brief Gauss-Legendre法の初期状態を設定
+ *
+ * @param p_state 途中状態
+ */
+void pi_gauss_legendre_init(pi_gl_state_t *p_state)
+{
+    p_state->a = 1.0;
+    p_state->b = 1.0 / sqrt(2.0);
+    p_state->t = 0.25;
+    p_state->p = 1.0;
+}
+
+/**
+ * @brief Gauss-Legendre法を1回反復して円周率の近似値を返す
+ *
+ * @param p_state 途中状態
+ * @return double 反復後の円周率の近似値
+ */
+double HOT_FUNC(pi_gauss_legendre_step)(pi_gl_state_t *p_state)
+{
+    volatile double a = p_state->a;
+    volatile double b = p_state->b;
+    double a_next = (a + b) / 2.0;
+    double b_next = sqrt(a * b);
+    double t_next = p_state->t - p_state->p * (a - a_next) * (a - a_next);
+
+    p_state->a = a_next;
+    p_state->b = b_next;
+    p_state->t = t_next;
+    p_state->p = 2.0 * p_state->p;
+
+    return (p_state->a + p_state->b) * (p_state->a + p_state->b) / (4.0 * p_state->t);
+}
+HOT_PATH_REGISTER(pi_gauss_legendre_step);
 
 double calculate_pi_gauss_legendre(int iterations)
 {
-    volatile double a = 1.0;
-    volatile double b = 1.0 / sqrt(2.0);
-    volatile double t = 0.25;
-    volatile double p = 1.0;
+    pi_gl_state_t state;
+    double pi;
 
+    pi_gauss_legendre_init(&state);
+    pi = (state.a + state.b) * (state.a + state.b) / (4.0 * state.t);
     for (int i = 0; i < iterations; i++) {
-        double a_next = (a + b) / 2.0;
-        double b_next = sqrt(a * b);
-        double t_next = t - p * (a - a_next) * (a - a_next);
-        double p_next = 2.0 * p;
-
-        a = a_next;
-        b = b_next;
-        t = t_next;
-        p = p_next;
+        pi = pi_gauss_legendre_step(&state);
     }
 
-    return (a + b) * (a + b) / (4.0 * t);
+    return pi;
 }
 
 /**
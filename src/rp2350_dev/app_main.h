@@ -28,6 +28,14 @@
 // 四則演算の回数（整数、float,double）100万回
 #define TEST_LOOP_CNT 1000000
 
+// Gauss-Legendre法の途中状態
+typedef struct {
+    double a;
+    double b;
+    double t;
+    double p;
+} pi_gl_state_t;
+
 void show_mem_dump(uint32_t dump_addr, uint32_t dump_size);
 void core_0_main(void);
 void core_1_main(void);
@@ -35,6 +43,8 @@ void pico_sdk_version_print(void);
 void i2c_slave_scan(uint8_t i2c_port);
 void measure_execution_time(void (*p_func)(void), const char* p_func_name, ...);
 double calculate_pi_gauss_legendre(int iterations);
+void pi_gauss_legendre_init(pi_gl_state_t *p_state);
+double pi_gauss_legendre_step(pi_gl_state_t *p_state);
 void trig_functions_test(void);
 void atan2_test(void);
 void tan_355_226_test(void);
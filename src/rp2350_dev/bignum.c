@@ -0,0 +1,682 @@
+/**
+ * @file bignum.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 多倍長整数(32bitリム)の実装
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "bignum.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// 先頭の0リムを取り除く
+static void bn_normalize(bignum_t *p_bn)
+{
+    while (p_bn->len > 0 && p_bn->p_limb[p_bn->len - 1] == 0)
+    {
+        p_bn->len--;
+    }
+    if (p_bn->len == 0) {
+        p_bn->sign = 1;
+    }
+}
+
+// リム配列を最低cap個確保(内容は保持)
+static bool bn_reserve(bignum_t *p_bn, uint32_t cap)
+{
+    if (cap <= p_bn->cap) {
+        return true;
+    }
+
+    uint32_t *p_new = realloc(p_bn->p_limb, cap * sizeof(uint32_t));
+    if (p_new == NULL) {
+        return false;
+    }
+    p_bn->p_limb = p_new;
+    p_bn->cap = cap;
+
+    return true;
+}
+
+// 2つの値を入れ替える(出力先が入力と重なる場合の作業用)
+static void bn_swap(bignum_t *p_a, bignum_t *p_b)
+{
+    bignum_t tmp = *p_a;
+    *p_a = *p_b;
+    *p_b = tmp;
+}
+
+// r[0..na) = a[0..na) + b[0..nb) (na >= nb)、キャリーを返す
+static uint32_t mpn_add(uint32_t *p_r, const uint32_t *p_a, uint32_t na, const uint32_t *p_b, uint32_t nb)
+{
+    uint64_t c = 0;
+    uint32_t i;
+
+    for (i = 0; i < nb; i++)
+    {
+        c += (uint64_t)p_a[i] + p_b[i];
+        p_r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    for (; i < na; i++)
+    {
+        c += p_a[i];
+        p_r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+
+    return (uint32_t)c;
+}
+
+// r[0..na) = a[0..na) - b[0..nb) (na >= nb)、ボローを返す
+static uint32_t mpn_sub(uint32_t *p_r, const uint32_t *p_a, uint32_t na, const uint32_t *p_b, uint32_t nb)
+{
+    uint32_t borrow = 0;
+    uint32_t i;
+
+    for (i = 0; i < nb; i++)
+    {
+        uint64_t d = (uint64_t)p_a[i] - p_b[i] - borrow;
+        p_r[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 32) & 1;
+    }
+    for (; i < na; i++)
+    {
+        uint64_t d = (uint64_t)p_a[i] - borrow;
+        p_r[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 32) & 1;
+    }
+
+    return borrow;
+}
+
+/**
+ * @brief 筆算(schoolbook)乗算 r[0..na+nb) = a * b
+ *
+ * @param p_r 結果(na+nb リム、a/bと重ならないこと)
+ * @param p_a 被乗数
+ * @param na 被乗数のリム数
+ * @param p_b 乗数
+ * @param nb 乗数のリム数
+ */
+void bn_mul_school(uint32_t *p_r, const uint32_t *p_a, uint32_t na, const uint32_t *p_b, uint32_t nb)
+{
+    memset(p_r, 0, (na + nb) * sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < nb; i++)
+    {
+        uint64_t c = 0;
+        uint32_t bi = p_b[i];
+        if (bi == 0) {
+            continue;
+        }
+        for (uint32_t j = 0; j < na; j++)
+        {
+            c += (uint64_t)p_a[j] * bi + p_r[i + j];
+            p_r[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        p_r[i + na] = (uint32_t)c;
+    }
+}
+
+/**
+ * @brief Karatsuba乗算 r[0..na+nb) = a * b (閾値未満は筆算)
+ *
+ * @param p_r 結果(na+nb リム、a/bと重ならないこと)
+ * @param p_a 被乗数
+ * @param na 被乗数のリム数
+ * @param p_b 乗数
+ * @param nb 乗数のリム数
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_mul_karatsuba(uint32_t *p_r, const uint32_t *p_a, uint32_t na, const uint32_t *p_b, uint32_t nb)
+{
+    if (na < nb) {
+        const uint32_t *p_tmp = p_a;
+        p_a = p_b;
+        p_b = p_tmp;
+        uint32_t n_tmp = na;
+        na = nb;
+        nb = n_tmp;
+    }
+
+    if (nb < BN_KARATSUBA_THRESHOLD) {
+        bn_mul_school(p_r, p_a, na, p_b, nb);
+        return true;
+    }
+
+    uint32_t h = (na + 1) / 2;
+
+    if (nb <= h) {
+        // 長さが大きく違う場合は r = a0*b + (a1*b << h) に分割
+        uint32_t *p_t = malloc((na - h + nb) * sizeof(uint32_t));
+        if (p_t == NULL) {
+            return false;
+        }
+        bool is_ok = bn_mul_karatsuba(p_r, p_a, h, p_b, nb)
+                  && bn_mul_karatsuba(p_t, p_a + h, na - h, p_b, nb);
+        if (is_ok) {
+            memset(p_r + h + nb, 0, (na - h) * sizeof(uint32_t));
+            mpn_add(p_r + h, p_r + h, na + nb - h, p_t, na - h + nb);
+        }
+        free(p_t);
+        return is_ok;
+    }
+
+    // a = a1*B^h + a0, b = b1*B^h + b0
+    // z0 = a0*b0 → r[0..2h), z2 = a1*b1 → r[2h..na+nb)
+    // z1 = (a0+a1)(b0+b1) - z0 - z2 を r[h..] に加算
+    uint32_t na1 = na - h;
+    uint32_t nb1 = nb - h;
+    uint32_t *p_sa = malloc((h + 1) * sizeof(uint32_t));
+    uint32_t *p_sb = malloc((h + 1) * sizeof(uint32_t));
+    uint32_t *p_z1 = malloc((2 * h + 2) * sizeof(uint32_t));
+    bool is_ok = (p_sa != NULL) && (p_sb != NULL) && (p_z1 != NULL);
+
+    if (is_ok) {
+        is_ok = bn_mul_karatsuba(p_r, p_a, h, p_b, h)
+             && bn_mul_karatsuba(p_r + 2 * h, p_a + h, na1, p_b + h, nb1);
+    }
+    if (is_ok) {
+        p_sa[h] = mpn_add(p_sa, p_a, h, p_a + h, na1);
+        p_sb[h] = mpn_add(p_sb, p_b, h, p_b + h, nb1);
+        is_ok = bn_mul_karatsuba(p_z1, p_sa, h + 1, p_sb, h + 1);
+    }
+    if (is_ok) {
+        uint32_t z1_len = 2 * h + 2;
+        mpn_sub(p_z1, p_z1, z1_len, p_r, 2 * h);
+        mpn_sub(p_z1, p_z1, z1_len, p_r + 2 * h, na + nb - 2 * h);
+        while (z1_len > 0 && p_z1[z1_len - 1] == 0)
+        {
+            z1_len--;
+        }
+        mpn_add(p_r + h, p_r + h, na + nb - h, p_z1, z1_len);
+    }
+
+    free(p_sa);
+    free(p_sb);
+    free(p_z1);
+
+    return is_ok;
+}
+
+/**
+ * @brief 多倍長整数を0で初期化
+ *
+ * @param p_bn 多倍長整数
+ * @return true 成功
+ */
+bool bn_init(bignum_t *p_bn)
+{
+    p_bn->p_limb = NULL;
+    p_bn->len = 0;
+    p_bn->cap = 0;
+    p_bn->sign = 1;
+
+    return true;
+}
+
+/**
+ * @brief 多倍長整数のメモリを解放
+ *
+ * @param p_bn 多倍長整数
+ */
+void bn_free(bignum_t *p_bn)
+{
+    free(p_bn->p_limb);
+    bn_init(p_bn);
+}
+
+/**
+ * @brief 64bit値を設定
+ *
+ * @param p_bn 多倍長整数
+ * @param val 値
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_set_u64(bignum_t *p_bn, uint64_t val)
+{
+    if (!bn_reserve(p_bn, 2)) {
+        return false;
+    }
+    p_bn->p_limb[0] = (uint32_t)val;
+    p_bn->p_limb[1] = (uint32_t)(val >> 32);
+    p_bn->len = 2;
+    p_bn->sign = 1;
+    bn_normalize(p_bn);
+
+    return true;
+}
+
+/**
+ * @brief 値をコピー
+ *
+ * @param p_dst コピー先
+ * @param p_src コピー元
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_copy(bignum_t *p_dst, const bignum_t *p_src)
+{
+    if (p_dst == p_src) {
+        return true;
+    }
+    if (!bn_reserve(p_dst, p_src->len)) {
+        return false;
+    }
+    if (p_src->len > 0) {
+        memcpy(p_dst->p_limb, p_src->p_limb, p_src->len * sizeof(uint32_t));
+    }
+    p_dst->len = p_src->len;
+    p_dst->sign = p_src->sign;
+
+    return true;
+}
+
+/**
+ * @brief 絶対値を比較
+ *
+ * @return int32_t |a| > |b| なら1、等しければ0、小さければ-1
+ */
+int32_t bn_cmp_abs(const bignum_t *p_a, const bignum_t *p_b)
+{
+    if (p_a->len != p_b->len) {
+        return (p_a->len > p_b->len) ? 1 : -1;
+    }
+    for (uint32_t i = p_a->len; i > 0; i--)
+    {
+        if (p_a->p_limb[i - 1] != p_b->p_limb[i - 1]) {
+            return (p_a->p_limb[i - 1] > p_b->p_limb[i - 1]) ? 1 : -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 絶対値のビット長
+ */
+uint32_t bn_bit_len(const bignum_t *p_bn)
+{
+    if (p_bn->len == 0) {
+        return 0;
+    }
+
+    return (p_bn->len - 1) * 32 + (32 - (uint32_t)__builtin_clz(p_bn->p_limb[p_bn->len - 1]));
+}
+
+/**
+ * @brief 符号付き加算 r = a + b
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_add(bignum_t *p_r, const bignum_t *p_a, const bignum_t *p_b)
+{
+    bignum_t r;
+    const bignum_t *p_big = p_a;
+    const bignum_t *p_small = p_b;
+
+    if (bn_cmp_abs(p_a, p_b) < 0) {
+        p_big = p_b;
+        p_small = p_a;
+    }
+
+    bn_init(&r);
+    if (!bn_reserve(&r, p_big->len + 1)) {
+        return false;
+    }
+
+    if (p_a->sign == p_b->sign) {
+        r.p_limb[p_big->len] = mpn_add(r.p_limb, p_big->p_limb, p_big->len,
+                                       p_small->p_limb, p_small->len);
+        r.len = p_big->len + 1;
+    } else {
+        mpn_sub(r.p_limb, p_big->p_limb, p_big->len, p_small->p_limb, p_small->len);
+        r.len = p_big->len;
+    }
+    r.sign = p_big->sign;
+    bn_normalize(&r);
+
+    bn_swap(p_r, &r);
+    bn_free(&r);
+
+    return true;
+}
+
+/**
+ * @brief 乗算 r = a * b
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_mul(bignum_t *p_r, const bignum_t *p_a, const bignum_t *p_b)
+{
+    bignum_t r;
+
+    bn_init(&r);
+    if (p_a->len == 0 || p_b->len == 0) {
+        bn_swap(p_r, &r);
+        bn_free(&r);
+        return true;
+    }
+
+    if (!bn_reserve(&r, p_a->len + p_b->len)) {
+        return false;
+    }
+    if (!bn_mul_karatsuba(r.p_limb, p_a->p_limb, p_a->len, p_b->p_limb, p_b->len)) {
+        bn_free(&r);
+        return false;
+    }
+    r.len = p_a->len + p_b->len;
+    r.sign = p_a->sign * p_b->sign;
+    bn_normalize(&r);
+
+    bn_swap(p_r, &r);
+    bn_free(&r);
+
+    return true;
+}
+
+/**
+ * @brief 32bit値との乗算 r = a * val
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_mul_u32(bignum_t *p_r, const bignum_t *p_a, uint32_t val)
+{
+    uint64_t c = 0;
+
+    if (!bn_copy(p_r, p_a) || !bn_reserve(p_r, p_a->len + 1)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < p_r->len; i++)
+    {
+        c += (uint64_t)p_r->p_limb[i] * val;
+        p_r->p_limb[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    p_r->p_limb[p_r->len++] = (uint32_t)c;
+    bn_normalize(p_r);
+
+    return true;
+}
+
+/**
+ * @brief 左シフト r = a << bits
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_shl(bignum_t *p_r, const bignum_t *p_a, uint32_t bits)
+{
+    bignum_t r;
+    uint32_t limbs = bits / 32;
+    uint32_t sh = bits % 32;
+
+    bn_init(&r);
+    if (p_a->len == 0) {
+        bn_swap(p_r, &r);
+        bn_free(&r);
+        return true;
+    }
+    if (!bn_reserve(&r, p_a->len + limbs + 1)) {
+        return false;
+    }
+
+    memset(r.p_limb, 0, limbs * sizeof(uint32_t));
+    r.p_limb[p_a->len + limbs] = 0;
+    for (uint32_t i = p_a->len; i > 0; i--)
+    {
+        uint32_t v = p_a->p_limb[i - 1];
+        if (sh == 0) {
+            r.p_limb[i - 1 + limbs] = v;
+        } else {
+            r.p_limb[i + limbs] |= v >> (32 - sh);
+            r.p_limb[i - 1 + limbs] = v << sh;
+        }
+    }
+    r.len = p_a->len + limbs + 1;
+    r.sign = p_a->sign;
+    bn_normalize(&r);
+
+    bn_swap(p_r, &r);
+    bn_free(&r);
+
+    return true;
+}
+
+/**
+ * @brief 右シフト r = a >> bits (絶対値を切り捨て)
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_shr(bignum_t *p_r, const bignum_t *p_a, uint32_t bits)
+{
+    bignum_t r;
+    uint32_t limbs = bits / 32;
+    uint32_t sh = bits % 32;
+
+    bn_init(&r);
+    if (p_a->len <= limbs) {
+        bn_swap(p_r, &r);
+        bn_free(&r);
+        return true;
+    }
+    if (!bn_reserve(&r, p_a->len - limbs)) {
+        return false;
+    }
+
+    r.len = p_a->len - limbs;
+    for (uint32_t i = 0; i < r.len; i++)
+    {
+        uint32_t v = p_a->p_limb[i + limbs] >> sh;
+        if (sh != 0 && i + limbs + 1 < p_a->len) {
+            v |= p_a->p_limb[i + limbs + 1] << (32 - sh);
+        }
+        r.p_limb[i] = v;
+    }
+    r.sign = p_a->sign;
+    bn_normalize(&r);
+
+    bn_swap(p_r, &r);
+    bn_free(&r);
+
+    return true;
+}
+
+/**
+ * @brief 除算 q = |a| / |b| (Knuth Algorithm D、商は切り捨て)
+ *
+ * @return true 成功
+ * @return false メモリ不足 or ゼロ除算
+ */
+bool bn_div(bignum_t *p_q, const bignum_t *p_a, const bignum_t *p_b)
+{
+    bignum_t q;
+    uint32_t m = p_a->len;
+    uint32_t n = p_b->len;
+
+    if (n == 0) {
+        return false;
+    }
+
+    bn_init(&q);
+    if (bn_cmp_abs(p_a, p_b) < 0) {
+        bn_swap(p_q, &q);
+        bn_free(&q);
+        return true;
+    }
+    if (!bn_reserve(&q, m - n + 1)) {
+        return false;
+    }
+    q.len = m - n + 1;
+
+    if (n == 1) {
+        // 1リムの除数は短除算
+        uint64_t rem = 0;
+        uint32_t v = p_b->p_limb[0];
+        for (uint32_t j = m; j > 0; j--)
+        {
+            uint64_t num = (rem << 32) | p_a->p_limb[j - 1];
+            if (j - 1 < q.len) {
+                q.p_limb[j - 1] = (uint32_t)(num / v);
+            }
+            rem = num % v;
+        }
+    } else {
+        uint32_t s = (uint32_t)__builtin_clz(p_b->p_limb[n - 1]);
+        uint32_t *p_vn = malloc(n * sizeof(uint32_t));
+        uint32_t *p_un = malloc((m + 1) * sizeof(uint32_t));
+        if (p_vn == NULL || p_un == NULL) {
+            free(p_vn);
+            free(p_un);
+            bn_free(&q);
+            return false;
+        }
+
+        // 除数の最上位ビットが立つように正規化
+        for (uint32_t i = n - 1; i > 0; i--)
+        {
+            p_vn[i] = (p_b->p_limb[i] << s) | (s ? (p_b->p_limb[i - 1] >> (32 - s)) : 0);
+        }
+        p_vn[0] = p_b->p_limb[0] << s;
+        p_un[m] = s ? (p_a->p_limb[m - 1] >> (32 - s)) : 0;
+        for (uint32_t i = m - 1; i > 0; i--)
+        {
+            p_un[i] = (p_a->p_limb[i] << s) | (s ? (p_a->p_limb[i - 1] >> (32 - s)) : 0);
+        }
+        p_un[0] = p_a->p_limb[0] << s;
+
+        for (uint32_t j = m - n + 1; j > 0; j--)
+        {
+            uint32_t jj = j - 1;
+            uint64_t num = ((uint64_t)p_un[jj + n] << 32) | p_un[jj + n - 1];
+            uint64_t qhat = num / p_vn[n - 1];
+            uint64_t rhat = num - qhat * p_vn[n - 1];
+
+            while (qhat > 0xFFFFFFFFULL ||
+                   qhat * p_vn[n - 2] > ((rhat << 32) | p_un[jj + n - 2]))
+            {
+                qhat--;
+                rhat += p_vn[n - 1];
+                if (rhat > 0xFFFFFFFFULL) {
+                    break;
+                }
+            }
+
+            // un[jj..jj+n] -= qhat * vn
+            int64_t k = 0;
+            int64_t t;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                uint64_t p = qhat * p_vn[i];
+                t = (int64_t)p_un[i + jj] - k - (int64_t)(p & 0xFFFFFFFFULL);
+                p_un[i + jj] = (uint32_t)t;
+                k = (int64_t)(p >> 32) - (t >> 32);
+            }
+            t = (int64_t)p_un[jj + n] - k;
+            p_un[jj + n] = (uint32_t)t;
+
+            q.p_limb[jj] = (uint32_t)qhat;
+            if (t < 0) {
+                // 引きすぎたので1回足し戻す
+                q.p_limb[jj]--;
+                uint64_t c = 0;
+                for (uint32_t i = 0; i < n; i++)
+                {
+                    c += (uint64_t)p_un[i + jj] + p_vn[i];
+                    p_un[i + jj] = (uint32_t)c;
+                    c >>= 32;
+                }
+                p_un[jj + n] += (uint32_t)c;
+            }
+        }
+
+        free(p_vn);
+        free(p_un);
+    }
+
+    q.sign = 1;
+    bn_normalize(&q);
+    bn_swap(p_q, &q);
+    bn_free(&q);
+
+    return true;
+}
+
+/**
+ * @brief 整数平方根 r = floor(sqrt(|a|))
+ * @note 上位半分の平方根を再帰で求めて初期値にし、Newton法で仕上げる
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool bn_isqrt(bignum_t *p_r, const bignum_t *p_a)
+{
+    uint32_t bits = bn_bit_len(p_a);
+
+    if (bits <= 52) {
+        uint64_t v = 0;
+        for (uint32_t i = p_a->len; i > 0; i--)
+        {
+            v = (v << 32) | p_a->p_limb[i - 1];
+        }
+        uint64_t x = (uint64_t)sqrt((double)v);
+        while (x * x > v)
+        {
+            x--;
+        }
+        while ((x + 1) * (x + 1) <= v)
+        {
+            x++;
+        }
+        return bn_set_u64(p_r, x);
+    }
+
+    bignum_t hi, x, y;
+    uint32_t k = bits / 4;
+    bool is_ok;
+
+    bn_init(&hi);
+    bn_init(&x);
+    bn_init(&y);
+
+    // x0 = (isqrt(a >> 2k) + 1) << k は sqrt(a) 以上
+    is_ok = bn_shr(&hi, p_a, 2 * k) && bn_isqrt(&x, &hi);
+    if (is_ok) {
+        bignum_t one;
+        bn_init(&one);
+        is_ok = bn_set_u64(&one, 1) && bn_add(&x, &x, &one) && bn_shl(&x, &x, k);
+        bn_free(&one);
+    }
+
+    // 上から単調減少するNewton法: y = (x + a/x) / 2、y >= x で収束
+    while (is_ok)
+    {
+        is_ok = bn_div(&y, p_a, &x) && bn_add(&y, &y, &x) && bn_shr(&y, &y, 1);
+        if (!is_ok || bn_cmp_abs(&y, &x) >= 0) {
+            break;
+        }
+        bn_swap(&x, &y);
+    }
+
+    if (is_ok) {
+        bn_swap(p_r, &x);
+    }
+
+    bn_free(&hi);
+    bn_free(&x);
+    bn_free(&y);
+
+    return is_ok;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file bignum.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 多倍長整数(32bitリム)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+// この長さ(リム数)以上でKaratsuba乗算に切り替える
+#define BN_KARATSUBA_THRESHOLD  24
+
+// 多倍長整数(符号+絶対値、リムはリトルエンディアン)
+typedef struct {
+    uint32_t *p_limb;   // リム配列(ヒープ)
+    uint32_t len;       // 使用リム数(0なら値は0)
+    uint32_t cap;       // 確保済みリム数
+    int32_t sign;       // 符号(+1 or -1)
+} bignum_t;
+
+bool bn_init(bignum_t *p_bn);
+void bn_free(bignum_t *p_bn);
+bool bn_set_u64(bignum_t *p_bn, uint64_t val);
+bool bn_copy(bignum_t *p_dst, const bignum_t *p_src);
+bool bn_add(bignum_t *p_r, const bignum_t *p_a, const bignum_t *p_b);
+bool bn_mul(bignum_t *p_r, const bignum_t *p_a, const bignum_t *p_b);
+bool bn_mul_u32(bignum_t *p_r, const bignum_t *p_a, uint32_t val);
+bool bn_shl(bignum_t *p_r, const bignum_t *p_a, uint32_t bits);
+bool bn_shr(bignum_t *p_r, const bignum_t *p_a, uint32_t bits);
+bool bn_div(bignum_t *p_q, const bignum_t *p_a, const bignum_t *p_b);
+bool bn_isqrt(bignum_t *p_r, const bignum_t *p_a);
+int32_t bn_cmp_abs(const bignum_t *p_a, const bignum_t *p_b);
+uint32_t bn_bit_len(const bignum_t *p_bn);
+void bn_mul_school(uint32_t *p_r, const uint32_t *p_a, uint32_t na, const uint32_t *p_b, uint32_t nb);
+bool bn_mul_karatsuba(uint32_t *p_r, const uint32_t *p_a, uint32_t na, const uint32_t *p_b, uint32_t nb);
+
+#endif // BIGNUM_H
@@ -0,0 +1,153 @@
+/**
+ * @file boot_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 起動の段階の時刻と初期化タスクの実行(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "boot_hw.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+// 段階の記録
+typedef struct {
+    uint32_t us;
+    uint8_t core;
+    bool is_marked;
+} boot_hw_stage_t;
+
+static const char *const s_stage_name_tbl[BOOT_STAGE_NUM] = {
+    "main",
+    "stdio",
+    "core1_launch",
+    "core1_main",
+    "shell",
+    "core0_main",
+    "init_done",
+};
+
+static boot_hw_stage_t s_stage[BOOT_STAGE_NUM];
+static spin_lock_t *s_p_boot_lock = NULL;
+
+static uint32_t boot_hw_lock(void)
+{
+    return spin_lock_blocking(s_p_boot_lock);
+}
+
+static void boot_hw_unlock(uint32_t save)
+{
+    spin_unlock(s_p_boot_lock, save);
+}
+
+static uint32_t boot_hw_now_us(void)
+{
+    return time_us_32();
+}
+
+static void boot_hw_wait(void)
+{
+    tight_loop_contents();
+}
+
+static const init_graph_ops_t s_boot_ops = {
+    .lock = boot_hw_lock,
+    .unlock = boot_hw_unlock,
+    .now_us = boot_hw_now_us,
+    .wait = boot_hw_wait,
+};
+
+/**
+ * @brief 起動の段階の時刻を記録する(最初の1回だけ)
+ * @note Core1の起動前はロックを使わない
+ */
+void boot_hw_mark(boot_stage_t stage)
+{
+    uint32_t save = 0;
+
+    if (s_p_boot_lock != NULL) {
+        save = boot_hw_lock();
+    }
+    if (!s_stage[stage].is_marked) {
+        s_stage[stage].us = time_us_32();
+        s_stage[stage].core = (uint8_t)get_core_num();
+        s_stage[stage].is_marked = true;
+    }
+    if (s_p_boot_lock != NULL) {
+        boot_hw_unlock(save);
+    }
+}
+
+/**
+ * @brief 記録した段階の時刻
+ *
+ * @param stage 段階
+ * @param p_us 時刻(us)
+ * @param p_core 記録したコア
+ * @return true 記録済み
+ * @return false まだ通っていない
+ */
+bool boot_hw_get_stage(boot_stage_t stage, uint32_t *p_us, uint32_t *p_core)
+{
+    *p_us = s_stage[stage].us;
+    *p_core = s_stage[stage].core;
+
+    return s_stage[stage].is_marked;
+}
+
+/**
+ * @brief 段階の名前
+ */
+const char *boot_hw_stage_name(boot_stage_t stage)
+{
+    return s_stage_name_tbl[stage];
+}
+
+/**
+ * @brief 初期化タスクの表を登録する
+ * @note Core1を起動する前に呼ぶ
+ *
+ * @param p_tbl タスクの表(BOOT_TASK_*の順)
+ * @param num タスク数
+ * @return true 成功
+ * @return false 表が不正(循環等)
+ */
+bool boot_hw_init(const init_task_t *p_tbl, uint32_t num)
+{
+    s_p_boot_lock = spin_lock_init(spin_lock_claim_unused(true));
+
+    return init_graph_init(p_tbl, num, &s_boot_ops);
+}
+
+/**
+ * @brief このコアで実行できる起動時の初期化タスクを全部実行する(両方のコアから呼ぶ)
+ */
+void boot_hw_run(void)
+{
+    init_graph_run(get_core_num());
+    if (init_graph_is_boot_done()) {
+        boot_hw_mark(BOOT_STAGE_INIT_DONE);
+    }
+}
+
+/**
+ * @brief 初期化タスクが終わっていなければ、このコアで実行する(遅延初期化の最初の利用時に呼ぶ)
+ *
+ * @param task タスク
+ * @return true 初期化済み
+ * @return false このコアでは実行できない
+ */
+bool boot_hw_require(boot_task_t task)
+{
+    bool is_done = init_graph_require(task, get_core_num());
+
+    // 起動時のタスクの最後をここで実行した場合
+    if (is_done && init_graph_is_boot_done()) {
+        boot_hw_mark(BOOT_STAGE_INIT_DONE);
+    }
+
+    return is_done;
+}
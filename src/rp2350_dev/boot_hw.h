@@ -0,0 +1,57 @@
+/**
+ * @file boot_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 起動の段階の時刻と初期化タスクの実行(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef BOOT_HW_H
+#define BOOT_HW_H
+
+#include "init_graph.h"
+
+// ※時刻はTIMER0(time_us_32())の値。タイマーはブートROMの後、ランタイムの初期化で動き出すのでリセット直後の数msは含まない
+
+// 起動の段階
+typedef enum {
+    BOOT_STAGE_MAIN = 0,    // main()に入った
+    BOOT_STAGE_STDIO,       // USB/stdioの初期化完了
+    BOOT_STAGE_CORE1_LAUNCH,// Core1を起動した
+    BOOT_STAGE_CORE1_MAIN,  // Core1のアプリに入った
+    BOOT_STAGE_SHELL,       // シェルの初期化完了(ヘルプとプロンプトを出した)
+    BOOT_STAGE_CORE0_MAIN,  // Core0が自分の分の初期化タスクを終えてアプリに入った
+    BOOT_STAGE_INIT_DONE,   // 起動時の初期化タスクが全部終わった
+    BOOT_STAGE_NUM,
+} boot_stage_t;
+
+// 初期化タスクの番号(rp2350_dev.cの表の順)
+typedef enum {
+    BOOT_TASK_DMA_SVC = 0,  // DMAサービス(割り込みはCore0)
+    BOOT_TASK_DMA_DEMO,     // DMAでの転送デモ
+    BOOT_TASK_PIO_BLINK,    // PIOでLED点滅
+    BOOT_TASK_INTERP,       // 補間器(コアごと)
+    BOOT_TASK_ALARM,        // タイマー割り込み @2000ms
+    BOOT_TASK_WDT,          // ウォッチドッグ
+    BOOT_TASK_UART0,        // UART0(割り込みはCore0)
+    BOOT_TASK_UART1,        // UART1(割り込みはCore0)
+    BOOT_TASK_UART_SHELL,   // シェルをUARTにも出す
+    BOOT_TASK_TIMER_SVC,    // ソフトウェアタイマー(割り込みはCore1)
+    BOOT_TASK_DBG_COM,      // デバッグモニタ(Core1)
+    BOOT_TASK_SPI0,         // SPI0
+    BOOT_TASK_SPI1,         // SPI1
+    BOOT_TASK_I2C0,         // I2C0(遅延、i2cコマンドで初期化)
+    BOOT_TASK_I2C1,         // I2C1(遅延、i2cコマンドで初期化)
+    BOOT_TASK_NUM,
+} boot_task_t;
+
+void boot_hw_mark(boot_stage_t stage);
+bool boot_hw_get_stage(boot_stage_t stage, uint32_t *p_us, uint32_t *p_core);
+const char *boot_hw_stage_name(boot_stage_t stage);
+bool boot_hw_init(const init_task_t *p_tbl, uint32_t num);
+void boot_hw_run(void);
+bool boot_hw_require(boot_task_t task);
+
+#endif // BOOT_HW_H
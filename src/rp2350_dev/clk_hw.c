@@ -0,0 +1,332 @@
+/**
+ * @file clk_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief クロック変更と周辺の分周比の追従のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "clk_hw.h"
+#include "app_cpu_core_0.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+#include "hardware/ticks.h"
+#include "hardware/sync.h"
+#include "hardware/structs/qmi.h"
+#include "pico/time.h"
+
+// Core0をSRAMで待たせる状態
+#define CLK_HW_PARK_IDLE        0
+#define CLK_HW_PARK_WAIT        1           // Core0が待ちに入った
+#define CLK_HW_PARK_RELEASE     2           // Core1が書き終わった
+
+// コア電圧(mV)とSDKの設定値
+static const struct {
+    uint32_t mv;
+    enum vreg_voltage voltage;
+} s_vreg_sel_tbl[] = {
+    {1100, VREG_VOLTAGE_1_10},
+    {1150, VREG_VOLTAGE_1_15},
+    {1200, VREG_VOLTAGE_1_20},
+    {1300, VREG_VOLTAGE_1_30},
+};
+
+// 周波数カウンタ(FC0)で測るクロック
+static const struct {
+    const char *p_name;
+    uint32_t fc0_src;
+    int32_t clk;            // clock_get_hz()の番号(無ければ-1)
+} s_domain_tbl[] = {
+    {"pll_sys",  CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY, -1},
+    {"pll_usb",  CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY, -1},
+    {"xosc",     CLOCKS_FC0_SRC_VALUE_XOSC_CLKSRC,            -1},
+    {"rosc",     CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC,            -1},
+    {"lposc",    CLOCKS_FC0_SRC_VALUE_LPOSC_CLKSRC,           -1},
+    {"clk_ref",  CLOCKS_FC0_SRC_VALUE_CLK_REF,                clk_ref},
+    {"clk_sys",  CLOCKS_FC0_SRC_VALUE_CLK_SYS,                clk_sys},
+    {"clk_peri", CLOCKS_FC0_SRC_VALUE_CLK_PERI,               clk_peri},
+    {"clk_usb",  CLOCKS_FC0_SRC_VALUE_CLK_USB,                clk_usb},
+    {"clk_adc",  CLOCKS_FC0_SRC_VALUE_CLK_ADC,                clk_adc},
+    {"clk_hstx", CLOCKS_FC0_SRC_VALUE_CLK_HSTX,               clk_hstx},
+};
+
+static uint32_t s_boot_sys_hz;
+static clk_qmi_t s_qmi_boot;
+static uint32_t s_vreg_mv;
+static volatile uint32_t s_park_state = CLK_HW_PARK_IDLE;
+
+// 今の分周元のクロック
+static void clk_hw_src_hz(uint32_t *p_src_hz)
+{
+    p_src_hz[CLK_SRC_SYS] = clock_get_hz(clk_sys);
+    p_src_hz[CLK_SRC_PERI] = clock_get_hz(clk_peri);
+    p_src_hz[CLK_SRC_REF] = clock_get_hz(clk_ref);
+}
+
+static void clk_hw_apply_pio(const clk_user_t *p_user)
+{
+    pio_sm_set_clkdiv_int_frac8((PIO)p_user->p_hw, p_user->index, p_user->div.div_int, (uint8_t)p_user->div.div_frac);
+}
+
+static void clk_hw_apply_uart(const clk_user_t *p_user)
+{
+    uart_hw_t *p_hw = uart_get_hw((uart_inst_t *)p_user->p_hw);
+
+    p_hw->ibrd = p_user->div.div_int;
+    p_hw->fbrd = p_user->div.div_frac;
+    // PL011はLCR_Hに書いた時点で分周比を取り込む
+    hw_set_bits(&p_hw->lcr_h, 0);
+}
+
+static void clk_hw_apply_spi(const clk_user_t *p_user)
+{
+    spi_hw_t *p_hw = spi_get_hw((spi_inst_t *)p_user->p_hw);
+
+    p_hw->cpsr = p_user->div.div_int;
+    hw_write_masked(&p_hw->cr0, (p_user->div.div_frac - 1) << SPI_SSPCR0_SCR_LSB, SPI_SSPCR0_SCR_BITS);
+}
+
+static void clk_hw_apply_i2c(const clk_user_t *p_user)
+{
+    i2c_hw_t *p_hw = i2c_get_hw((i2c_inst_t *)p_user->p_hw);
+
+    // SCLのカウントは無効の間しか書けない
+    p_hw->enable = 0;
+    p_hw->fs_scl_hcnt = p_user->div.div_int;
+    p_hw->fs_scl_lcnt = p_user->div.div_frac;
+    p_hw->fs_spklen = p_user->div.spklen;
+    hw_write_masked(&p_hw->sda_hold, p_user->div.sda_hold << I2C_IC_SDA_HOLD_IC_SDA_TX_HOLD_LSB,
+                    I2C_IC_SDA_HOLD_IC_SDA_TX_HOLD_BITS);
+    p_hw->enable = 1;
+}
+
+static void clk_hw_apply_tick(const clk_user_t *p_user)
+{
+    tick_gen_num_t tick = (tick_gen_num_t)p_user->index;
+
+    // 止まっているtickは使う側(prof_hw等)が動かす時に計算する
+    if (tick_is_running(tick)) {
+        tick_start(tick, p_user->div.div_int);
+    }
+}
+
+// 今のフラッシュのタイミングを読む
+static void clk_hw_qmi_read(clk_qmi_t *p_qmi)
+{
+    uint32_t timing = qmi_hw->m[0].timing;
+
+    p_qmi->clkdiv = (timing & QMI_M0_TIMING_CLKDIV_BITS) >> QMI_M0_TIMING_CLKDIV_LSB;
+    p_qmi->rxdelay = (timing & QMI_M0_TIMING_RXDELAY_BITS) >> QMI_M0_TIMING_RXDELAY_LSB;
+    if (p_qmi->clkdiv == 0) {
+        p_qmi->clkdiv = 256;
+    }
+}
+
+// Core0: 割り込みを止めてSRAMの中で待つ(フラッシュから命令を読まない)
+static void __not_in_flash_func(clk_hw_park)(void *p_arg)
+{
+    (void)p_arg;
+    uint32_t irq = save_and_disable_interrupts();
+
+    s_park_state = CLK_HW_PARK_WAIT;
+    while (s_park_state != CLK_HW_PARK_RELEASE)
+    {
+        tight_loop_contents();
+    }
+    restore_interrupts(irq);
+}
+
+// Core1: QMIのタイミングを書く(書き終わるまでXIPに触らない)
+static void __not_in_flash_func(clk_hw_qmi_write)(uint32_t timing)
+{
+    uint32_t irq = save_and_disable_interrupts();
+
+    qmi_hw->m[0].timing = timing;
+    (void)qmi_hw->m[0].timing;
+    restore_interrupts(irq);
+}
+
+// フラッシュのタイミングを変える(Core1から呼ぶ)
+static void clk_hw_set_qmi(const clk_qmi_t *p_qmi)
+{
+    uint32_t timing = qmi_hw->m[0].timing & ~(QMI_M0_TIMING_CLKDIV_BITS | QMI_M0_TIMING_RXDELAY_BITS);
+
+    timing |= ((p_qmi->clkdiv & 0xFF) << QMI_M0_TIMING_CLKDIV_LSB) | (p_qmi->rxdelay << QMI_M0_TIMING_RXDELAY_LSB);
+
+    s_park_state = CLK_HW_PARK_IDLE;
+    app_core_0_job_start(clk_hw_park, NULL);
+    while (s_park_state != CLK_HW_PARK_WAIT)
+    {
+        tight_loop_contents();
+    }
+    clk_hw_qmi_write(timing);
+    s_park_state = CLK_HW_PARK_RELEASE;
+    app_core_0_job_wait();
+}
+
+// コア電圧を変えて落ち着くまで待つ
+static void clk_hw_set_vreg(uint32_t mv)
+{
+    for (uint32_t i = 0; i < count_of(s_vreg_sel_tbl); i++)
+    {
+        if (s_vreg_sel_tbl[i].mv == mv) {
+            vreg_set_voltage(s_vreg_sel_tbl[i].voltage);
+            busy_wait_us(CLK_HW_VREG_SETTLE_US);
+            s_vreg_mv = mv;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 初期化(起動時のクロックとフラッシュのタイミングを覚え、tickを登録)
+ * @note 周辺の初期化より前に呼ぶ
+ */
+void clk_hw_init(void)
+{
+    uint32_t src_hz[CLK_SRC_NUM];
+
+    s_boot_sys_hz = clock_get_hz(clk_sys);
+    s_vreg_mv = clk_vreg_mv(s_boot_sys_hz);
+    clk_hw_qmi_read(&s_qmi_boot);
+
+    clk_reg_clear();
+    clk_hw_src_hz(src_hz);
+    clk_reg_add("timer0", CLK_USER_TICK, CLK_HW_TICK_HZ, NULL, TICK_TIMER0, clk_hw_apply_tick, src_hz, false);
+    clk_reg_add("timer1", CLK_USER_TICK, CLK_HW_TICK_HZ, NULL, TICK_TIMER1, clk_hw_apply_tick, src_hz, false);
+    clk_reg_add("wdt", CLK_USER_TICK, CLK_HW_TICK_HZ, NULL, TICK_WATCHDOG, clk_hw_apply_tick, src_hz, false);
+}
+
+/**
+ * @brief PIOのSMを登録し、SMのクロックをsm_hzにする
+ * @note pio_sm_init()は分周比を既定(1)に戻すので、その後に呼ぶ
+ */
+void clk_hw_add_pio(const char *p_name, PIO pio, uint32_t sm, uint32_t sm_hz)
+{
+    uint32_t src_hz[CLK_SRC_NUM];
+
+    clk_hw_src_hz(src_hz);
+    clk_reg_add(p_name, CLK_USER_PIO, sm_hz, pio, sm, clk_hw_apply_pio, src_hz, true);
+}
+
+/**
+ * @brief uart_init()済みのUARTを登録
+ */
+void clk_hw_add_uart(const char *p_name, uart_inst_t *p_uart, uint32_t baud)
+{
+    uint32_t src_hz[CLK_SRC_NUM];
+
+    clk_hw_src_hz(src_hz);
+    clk_reg_add(p_name, CLK_USER_UART, baud, p_uart, 0, clk_hw_apply_uart, src_hz, false);
+}
+
+/**
+ * @brief spi_init()済みのSPIを登録
+ */
+void clk_hw_add_spi(const char *p_name, spi_inst_t *p_spi, uint32_t baud)
+{
+    uint32_t src_hz[CLK_SRC_NUM];
+
+    clk_hw_src_hz(src_hz);
+    clk_reg_add(p_name, CLK_USER_SPI, baud, p_spi, 0, clk_hw_apply_spi, src_hz, false);
+}
+
+/**
+ * @brief i2c_init()済みのI2Cを登録
+ */
+void clk_hw_add_i2c(const char *p_name, i2c_inst_t *p_i2c, uint32_t baud)
+{
+    uint32_t src_hz[CLK_SRC_NUM];
+
+    clk_hw_src_hz(src_hz);
+    clk_reg_add(p_name, CLK_USER_I2C, baud, p_i2c, 0, clk_hw_apply_i2c, src_hz, false);
+}
+
+/**
+ * @brief clk_sysを変えて、登録済みの周辺の分周比を追従させる(Core1から呼ぶ)
+ * @note 上げる時は電圧→フラッシュのSCK→clk_sysの順、下げる時は逆順
+ *       (どの時点でもコア電圧とフラッシュのSCKが足りている)
+ *       フラッシュのタイミングを書く間はCore0をSRAMで待たせる
+ *
+ * @param mhz 新しいclk_sys(MHz)
+ * @param p_applied 分周比を書き直した利用者の数
+ * @param p_invalid 新しいクロックで作れなかった利用者の数
+ * @return clk_hw_result_t 結果
+ */
+clk_hw_result_t clk_hw_set_sys_mhz(uint32_t mhz, uint32_t *p_applied, uint32_t *p_invalid)
+{
+    uint vco_hz, postdiv1, postdiv2;
+    uint32_t src_hz[CLK_SRC_NUM];
+    uint32_t sys_hz = mhz * 1000000;
+    clk_qmi_t qmi_now, qmi_new;
+
+    if (mhz < CLK_SYS_MHZ_MIN || mhz > CLK_SYS_MHZ_MAX
+        || !check_sys_clock_khz(mhz * 1000, &vco_hz, &postdiv1, &postdiv2)) {
+        return CLK_HW_BAD_FREQ;
+    }
+    if (app_core_0_job_is_busy()) {
+        return CLK_HW_BUSY;
+    }
+
+    uint32_t mv = clk_vreg_mv(sys_hz);
+    bool is_qmi_first;
+    clk_hw_qmi_read(&qmi_now);
+    clk_qmi_calc(sys_hz, s_boot_sys_hz, &s_qmi_boot, &qmi_new);
+    is_qmi_first = (qmi_new.clkdiv > qmi_now.clkdiv);
+
+    if (mv > s_vreg_mv) {
+        clk_hw_set_vreg(mv);
+    }
+    if (is_qmi_first) {
+        clk_hw_set_qmi(&qmi_new);
+    }
+    set_sys_clock_pll(vco_hz, postdiv1, postdiv2);
+    if (!is_qmi_first && (qmi_new.clkdiv != qmi_now.clkdiv || qmi_new.rxdelay != qmi_now.rxdelay)) {
+        clk_hw_set_qmi(&qmi_new);
+    }
+    if (mv < s_vreg_mv) {
+        clk_hw_set_vreg(mv);
+    }
+
+    clk_hw_src_hz(src_hz);
+    *p_applied = clk_reg_retune(src_hz, p_invalid);
+
+    return CLK_HW_OK;
+}
+
+/**
+ * @brief 今のクロック、コア電圧、フラッシュのタイミング
+ */
+void clk_hw_get_status(clk_hw_status_t *p_status)
+{
+    p_status->sys_hz = clock_get_hz(clk_sys);
+    p_status->peri_hz = clock_get_hz(clk_peri);
+    p_status->ref_hz = clock_get_hz(clk_ref);
+    p_status->vreg_mv = s_vreg_mv;
+    clk_hw_qmi_read(&p_status->qmi);
+    p_status->flash_sck_hz = p_status->sys_hz / p_status->qmi.clkdiv;
+}
+
+/**
+ * @brief 全クロックを周波数カウンタ(FC0、clk_ref基準)で測る
+ *
+ * @param p_tbl 結果
+ * @param max p_tblの要素数
+ * @return uint32_t 測った数
+ */
+uint32_t clk_hw_measure(clk_hw_domain_t *p_tbl, uint32_t max)
+{
+    uint32_t num = 0;
+
+    for (uint32_t i = 0; i < count_of(s_domain_tbl) && num < max; i++)
+    {
+        p_tbl[num].p_name = s_domain_tbl[i].p_name;
+        p_tbl[num].measured_khz = frequency_count_khz(s_domain_tbl[i].fc0_src);
+        p_tbl[num].expected_hz = (s_domain_tbl[i].clk >= 0) ? clock_get_hz((enum clock_index)s_domain_tbl[i].clk) : 0;
+        num++;
+    }
+
+    return num;
+}
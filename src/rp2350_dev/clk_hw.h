@@ -0,0 +1,57 @@
+/**
+ * @file clk_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief クロック変更と周辺の分周比の追従のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef CLK_HW_H
+#define CLK_HW_H
+
+#include "clk_reg.h"
+#include "hardware/pio.h"
+#include "hardware/uart.h"
+#include "hardware/spi.h"
+#include "hardware/i2c.h"
+
+#define CLK_HW_DOMAIN_MAX       12          // 周波数カウンタで測るクロックの数
+#define CLK_HW_TICK_HZ          1000000     // TIMER0/1、WDTのtick(1μs)
+#define CLK_HW_VREG_SETTLE_US   10000       // コア電圧を変えた後の待ち
+
+// クロック変更の結果
+typedef enum {
+    CLK_HW_OK = 0,
+    CLK_HW_BAD_FREQ,        // 範囲外かPLLで作れない
+    CLK_HW_BUSY,            // Core0がジョブ実行中(フラッシュのタイミングを安全に変えられない)
+} clk_hw_result_t;
+
+// 周波数カウンタ(FC0)で測ったクロック
+typedef struct {
+    const char *p_name;
+    uint32_t measured_khz;
+    uint32_t expected_hz;   // SDKが把握している値(PLL、発振器は0)
+} clk_hw_domain_t;
+
+// 今の状態
+typedef struct {
+    uint32_t sys_hz;
+    uint32_t peri_hz;
+    uint32_t ref_hz;
+    uint32_t vreg_mv;       // このモジュールが設定したコア電圧(起動時は既定値)
+    clk_qmi_t qmi;          // フラッシュのタイミング
+    uint32_t flash_sck_hz;
+} clk_hw_status_t;
+
+void clk_hw_init(void);
+void clk_hw_add_pio(const char *p_name, PIO pio, uint32_t sm, uint32_t sm_hz);
+void clk_hw_add_uart(const char *p_name, uart_inst_t *p_uart, uint32_t baud);
+void clk_hw_add_spi(const char *p_name, spi_inst_t *p_spi, uint32_t baud);
+void clk_hw_add_i2c(const char *p_name, i2c_inst_t *p_i2c, uint32_t baud);
+clk_hw_result_t clk_hw_set_sys_mhz(uint32_t mhz, uint32_t *p_applied, uint32_t *p_invalid);
+void clk_hw_get_status(clk_hw_status_t *p_status);
+uint32_t clk_hw_measure(clk_hw_domain_t *p_tbl, uint32_t max);
+
+#endif // CLK_HW_H
@@ -0,0 +1,403 @@
+/**
+ * @file clk_reg.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief クロックの利用者レジストリと分周比の計算
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "clk_reg.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CLK_TICK_CYCLES_MAX     511         // TICKSのCYCLES(9bit)
+#define CLK_I2C_CNT_MIN         8           // HCNT/LCNTの下限
+#define CLK_I2C_CNT_MAX         0xFFFF
+
+// clk_sysの上限ごとのコア電圧(既定の1.10Vより下げない)
+static const struct {
+    uint32_t sys_hz_max;
+    uint32_t mv;
+} s_vreg_tbl[] = {
+    {150000000UL, 1100},
+    {200000000UL, 1150},
+    {250000000UL, 1200},
+    {300000000UL, 1300},
+};
+
+static clk_user_t s_clk_users[CLK_REG_USER_MAX];
+static uint32_t s_clk_user_num = 0;
+
+// PIO: SM = src / (int + frac/256)
+static bool clk_div_calc_pio(uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div)
+{
+    uint64_t div_256 = ((uint64_t)src_hz * 256 + target_hz / 2) / target_hz;
+
+    if (div_256 < 256 || div_256 > 0xFFFFFFULL) {
+        return false;
+    }
+    p_div->div_int = (uint32_t)(div_256 >> 8);
+    p_div->div_frac = (uint32_t)(div_256 & 0xFF);
+    p_div->actual_hz = (uint32_t)((uint64_t)src_hz * 256 / div_256);
+
+    return true;
+}
+
+// UART: uart_set_baudrate()と同じ(IBRD + FBRD/64、1/128で丸め)
+static bool clk_div_calc_uart(uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div)
+{
+    uint32_t div = (uint32_t)((8ULL * src_hz) / target_hz) + 1;
+    uint32_t ibrd = div >> 7;
+
+    if (ibrd == 0 || ibrd >= 65535) {
+        return false;
+    }
+    p_div->div_int = ibrd;
+    p_div->div_frac = (div & 0x7F) >> 1;
+    p_div->actual_hz = (uint32_t)((4ULL * src_hz) / (64 * ibrd + p_div->div_frac));
+
+    return true;
+}
+
+// SPI: spi_set_baudrate()と同じ(偶数のプリスケーラを小さい順、次にポストディバイダを大きい順)
+static bool clk_div_calc_spi(uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div)
+{
+    uint32_t prescale;
+    uint32_t postdiv;
+
+    for (prescale = 2; prescale <= 254; prescale += 2)
+    {
+        if (src_hz < (uint64_t)prescale * 256 * target_hz) {
+            break;
+        }
+    }
+    if (prescale > 254) {
+        return false;
+    }
+    for (postdiv = 256; postdiv > 1; --postdiv)
+    {
+        if (src_hz / (prescale * (postdiv - 1)) > target_hz) {
+            break;
+        }
+    }
+    p_div->div_int = prescale;
+    p_div->div_frac = postdiv;
+    p_div->actual_hz = src_hz / (prescale * postdiv);
+
+    return true;
+}
+
+// I2C: i2c_set_baudrate()と同じ(L:H = 3:2)
+static bool clk_div_calc_i2c(uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div)
+{
+    uint32_t period = (src_hz + target_hz / 2) / target_hz;
+    uint32_t lcnt = period * 3 / 5;
+    uint32_t hcnt = period - lcnt;
+    uint32_t sda_hold;
+
+    if (hcnt < CLK_I2C_CNT_MIN || lcnt < CLK_I2C_CNT_MIN || hcnt > CLK_I2C_CNT_MAX || lcnt > CLK_I2C_CNT_MAX) {
+        return false;
+    }
+    if (target_hz < 1000000) {
+        sda_hold = (uint32_t)((3ULL * src_hz) / 10000000) + 1;
+    } else {
+        sda_hold = (uint32_t)((3ULL * src_hz) / 25000000) + 1;
+    }
+    if (sda_hold > lcnt - 2) {
+        return false;
+    }
+    p_div->div_int = hcnt;
+    p_div->div_frac = lcnt;
+    p_div->spklen = (lcnt < 16) ? 1 : lcnt / 16;
+    p_div->sda_hold = sda_hold;
+    p_div->actual_hz = src_hz / period;
+
+    return true;
+}
+
+// TICK: 1tick = cyclesサイクル
+static bool clk_div_calc_tick(uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div)
+{
+    uint32_t cycles = src_hz / target_hz;
+
+    if (cycles == 0 || cycles > CLK_TICK_CYCLES_MAX) {
+        return false;
+    }
+    p_div->div_int = cycles;
+    p_div->actual_hz = src_hz / cycles;
+
+    return true;
+}
+
+/**
+ * @brief 分周元のクロックから分周の設定値を計算
+ *
+ * @param type 利用者の種類
+ * @param src_hz 分周元のクロック(Hz)
+ * @param target_hz 欲しいレート(Hz)
+ * @param p_div 設定値(戻り値がfalseなら不定)
+ * @return true 作れる
+ * @return false 分周比の範囲外
+ */
+bool clk_div_calc(clk_user_type_t type, uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div)
+{
+    memset(p_div, 0, sizeof(clk_div_t));
+    if (src_hz == 0 || target_hz == 0) {
+        return false;
+    }
+
+    switch (type)
+    {
+        case CLK_USER_PIO:
+            return clk_div_calc_pio(src_hz, target_hz, p_div);
+
+        case CLK_USER_UART:
+            return clk_div_calc_uart(src_hz, target_hz, p_div);
+
+        case CLK_USER_SPI:
+            return clk_div_calc_spi(src_hz, target_hz, p_div);
+
+        case CLK_USER_I2C:
+            return clk_div_calc_i2c(src_hz, target_hz, p_div);
+
+        case CLK_USER_TICK:
+            return clk_div_calc_tick(src_hz, target_hz, p_div);
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 実際のレートの誤差(ppm)
+ */
+int32_t clk_div_err_ppm(uint32_t target_hz, uint32_t actual_hz)
+{
+    if (target_hz == 0) {
+        return 0;
+    }
+
+    return (int32_t)(((int64_t)actual_hz - (int64_t)target_hz) * 1000000 / (int64_t)target_hz);
+}
+
+/**
+ * @brief 設定値を種類ごとのレジスタ名で文字列にする
+ */
+void clk_div_format(char *p_buf, size_t size, clk_user_type_t type, const clk_div_t *p_div)
+{
+    switch (type)
+    {
+        case CLK_USER_PIO:
+            snprintf(p_buf, size, "div %u+%u/256", p_div->div_int, p_div->div_frac);
+            break;
+
+        case CLK_USER_UART:
+            snprintf(p_buf, size, "ibrd %u fbrd %u", p_div->div_int, p_div->div_frac);
+            break;
+
+        case CLK_USER_SPI:
+            snprintf(p_buf, size, "cpsr %u scr %u", p_div->div_int, p_div->div_frac - 1);
+            break;
+
+        case CLK_USER_I2C:
+            snprintf(p_buf, size, "hcnt %u lcnt %u", p_div->div_int, p_div->div_frac);
+            break;
+
+        case CLK_USER_TICK:
+            snprintf(p_buf, size, "cycles %u", p_div->div_int);
+            break;
+
+        default:
+            snprintf(p_buf, size, "-");
+            break;
+    }
+}
+
+/**
+ * @brief 種類ごとの分周元
+ */
+clk_src_t clk_user_src(clk_user_type_t type)
+{
+    switch (type)
+    {
+        case CLK_USER_UART:
+        case CLK_USER_SPI:
+            return CLK_SRC_PERI;
+
+        case CLK_USER_TICK:
+            return CLK_SRC_REF;
+
+        default:
+            return CLK_SRC_SYS;
+    }
+}
+
+const char *clk_user_type_name(clk_user_type_t type)
+{
+    static const char *const s_name[CLK_USER_TYPE_NUM] = {"pio", "uart", "spi", "i2c", "tick"};
+
+    return (type < CLK_USER_TYPE_NUM) ? s_name[type] : "?";
+}
+
+const char *clk_src_name(clk_src_t src)
+{
+    static const char *const s_name[CLK_SRC_NUM] = {"sys", "peri", "ref"};
+
+    return (src < CLK_SRC_NUM) ? s_name[src] : "?";
+}
+
+/**
+ * @brief clk_sysに必要なコア電圧(mV)
+ *
+ * @param sys_hz clk_sys(Hz)
+ * @return uint32_t コア電圧(mV)、上限を超えるなら0
+ */
+uint32_t clk_vreg_mv(uint32_t sys_hz)
+{
+    for (uint32_t i = 0; i < sizeof(s_vreg_tbl) / sizeof(s_vreg_tbl[0]); i++)
+    {
+        if (sys_hz <= s_vreg_tbl[i].sys_hz_max) {
+            return s_vreg_tbl[i].mv;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief clk_sysを変えた後のフラッシュのタイミング
+ * @note SCKは起動時(ブートROM/boot2が決めた値)より速くしない
+ *       RXDELAYはclk_sysの半周期単位なので、時間が起動時以上になるよう比例させる
+ *
+ * @param sys_hz 変えた後のclk_sys
+ * @param boot_sys_hz 起動時のclk_sys
+ * @param p_boot 起動時のタイミング
+ * @param p_qmi 変えた後のタイミング
+ */
+void clk_qmi_calc(uint32_t sys_hz, uint32_t boot_sys_hz, const clk_qmi_t *p_boot, clk_qmi_t *p_qmi)
+{
+    uint64_t clkdiv = ((uint64_t)sys_hz * p_boot->clkdiv + boot_sys_hz - 1) / boot_sys_hz;
+    uint64_t rxdelay = ((uint64_t)sys_hz * p_boot->rxdelay + boot_sys_hz - 1) / boot_sys_hz;
+
+    if (clkdiv < CLK_QMI_DIV_MIN) {
+        clkdiv = CLK_QMI_DIV_MIN;
+    }
+    if (clkdiv > CLK_QMI_DIV_MAX) {
+        clkdiv = CLK_QMI_DIV_MAX;
+    }
+    if (rxdelay > CLK_QMI_RXDELAY_MAX) {
+        rxdelay = CLK_QMI_RXDELAY_MAX;
+    }
+    p_qmi->clkdiv = (uint32_t)clkdiv;
+    p_qmi->rxdelay = (uint32_t)rxdelay;
+}
+
+/**
+ * @brief レジストリを空にする
+ */
+void clk_reg_clear(void)
+{
+    memset(s_clk_users, 0, sizeof(s_clk_users));
+    s_clk_user_num = 0;
+}
+
+/**
+ * @brief 利用者を登録(同じ種類、H/W、indexなら上書き)
+ *
+ * @param p_name 表示名
+ * @param type 種類
+ * @param target_hz 欲しいレート
+ * @param p_hw 対象のH/W
+ * @param index SM番号等
+ * @param apply divをレジスタに書く関数
+ * @param p_src_hz 今の分周元のクロック(CLK_SRC_NUM個)
+ * @param is_apply 登録時にapplyを呼ぶ(初期化関数が同じ値を設定済みならfalse)
+ * @return const clk_user_t* 登録した利用者、満杯ならNULL
+ */
+const clk_user_t *clk_reg_add(const char *p_name, clk_user_type_t type, uint32_t target_hz, void *p_hw,
+                              uint32_t index, clk_apply_t apply, const uint32_t *p_src_hz, bool is_apply)
+{
+    clk_user_t *p_user = NULL;
+
+    for (uint32_t i = 0; i < s_clk_user_num; i++)
+    {
+        if (s_clk_users[i].type == type && s_clk_users[i].p_hw == p_hw && s_clk_users[i].index == index) {
+            p_user = &s_clk_users[i];
+            break;
+        }
+    }
+    if (p_user == NULL) {
+        if (s_clk_user_num >= CLK_REG_USER_MAX) {
+            return NULL;
+        }
+        p_user = &s_clk_users[s_clk_user_num++];
+    }
+
+    p_user->p_name = p_name;
+    p_user->type = type;
+    p_user->target_hz = target_hz;
+    p_user->p_hw = p_hw;
+    p_user->index = index;
+    p_user->apply = apply;
+    p_user->is_valid = clk_div_calc(type, p_src_hz[clk_user_src(type)], target_hz, &p_user->div);
+    if (p_user->is_valid && is_apply && apply != NULL) {
+        apply(p_user);
+    }
+
+    return p_user;
+}
+
+/**
+ * @brief 分周元のクロックが変わった後に全員の設定値を計算し直して書く
+ * @note 設定値が変わった利用者だけapplyを呼ぶ(tick等を無駄に止めない)
+ *       作れないレートの利用者はレジスタを前のままにしてis_validをfalseにする
+ *
+ * @param p_src_hz 新しい分周元のクロック(CLK_SRC_NUM個)
+ * @param p_invalid 作れなかった利用者の数(NULL可)
+ * @return uint32_t applyを呼んだ数
+ */
+uint32_t clk_reg_retune(const uint32_t *p_src_hz, uint32_t *p_invalid)
+{
+    uint32_t applied = 0;
+    uint32_t invalid = 0;
+
+    for (uint32_t i = 0; i < s_clk_user_num; i++)
+    {
+        clk_user_t *p_user = &s_clk_users[i];
+        clk_div_t div;
+
+        if (!clk_div_calc(p_user->type, p_src_hz[clk_user_src(p_user->type)], p_user->target_hz, &div)) {
+            p_user->is_valid = false;
+            invalid++;
+            continue;
+        }
+
+        bool is_changed = !p_user->is_valid
+                       || div.div_int != p_user->div.div_int || div.div_frac != p_user->div.div_frac
+                       || div.spklen != p_user->div.spklen || div.sda_hold != p_user->div.sda_hold;
+        p_user->div = div;
+        p_user->is_valid = true;
+        if (is_changed && p_user->apply != NULL) {
+            p_user->apply(p_user);
+            applied++;
+        }
+    }
+
+    if (p_invalid != NULL) {
+        *p_invalid = invalid;
+    }
+
+    return applied;
+}
+
+uint32_t clk_reg_num(void)
+{
+    return s_clk_user_num;
+}
+
+const clk_user_t *clk_reg_get(uint32_t index)
+{
+    return (index < s_clk_user_num) ? &s_clk_users[index] : NULL;
+}
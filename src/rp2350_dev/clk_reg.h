@@ -0,0 +1,93 @@
+/**
+ * @file clk_reg.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief クロックの利用者レジストリと分周比の計算のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef CLK_REG_H
+#define CLK_REG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(分周比の計算はSDKの各set_baudrateと同じ式、ホストで確認できる)
+// ※レジスタへの書き込みは利用者ごとのapply関数(clk_hw.c)が行う
+
+#define CLK_REG_USER_MAX        16          // 登録できる利用者の数
+#define CLK_SYS_MHZ_MIN         48          // clk_sysの下限(USBがclk_sys >= 48MHzを要求する)
+#define CLK_SYS_MHZ_MAX         300         // clk_sysの上限(コア電圧1.30Vまで)
+#define CLK_QMI_DIV_MIN         2           // フラッシュSCKの分周比の下限
+#define CLK_QMI_DIV_MAX         255
+#define CLK_QMI_RXDELAY_MAX     7
+
+// 分周元のクロック
+typedef enum {
+    CLK_SRC_SYS = 0,    // clk_sys(PIO、I2C)
+    CLK_SRC_PERI,       // clk_peri(UART、SPI)
+    CLK_SRC_REF,        // clk_ref(TIMER0/1、WDTのtick)
+    CLK_SRC_NUM
+} clk_src_t;
+
+// 利用者の種類
+typedef enum {
+    CLK_USER_PIO = 0,   // SMのクロック(16.8の分数分周)
+    CLK_USER_UART,      // ボーレート(IBRD/FBRD)
+    CLK_USER_SPI,       // ビットレート(CPSR、SCR)
+    CLK_USER_I2C,       // SCL(HCNT/LCNT)
+    CLK_USER_TICK,      // 1μsのtick(サイクル数)
+    CLK_USER_TYPE_NUM
+} clk_user_type_t;
+
+// 分周の設定値(意味は種類ごと)
+typedef struct {
+    uint32_t div_int;       // PIO:整数部(1～65535) UART:IBRD SPI:CPSR I2C:HCNT TICK:サイクル数
+    uint32_t div_frac;      // PIO:小数部(1/256)   UART:FBRD SPI:SCR+1 I2C:LCNT
+    uint32_t spklen;        // I2C:スパイク除去の幅
+    uint32_t sda_hold;      // I2C:SDAのホールド
+    uint32_t actual_hz;     // 実際のレート
+} clk_div_t;
+
+typedef struct clk_user clk_user_t;
+typedef void (*clk_apply_t)(const clk_user_t *p_user);
+
+// クロックの利用者
+struct clk_user {
+    const char *p_name;
+    clk_user_type_t type;
+    uint32_t target_hz;     // 欲しいレート
+    void *p_hw;             // 対象のH/W(uart_inst_t*、PIO等、apply関数が解釈する)
+    uint32_t index;         // SM番号、tick番号等
+    clk_apply_t apply;      // divをレジスタに書く
+    clk_div_t div;          // 今の設定値
+    bool is_valid;          // 今のクロックで作れる(falseならレジスタは前のまま)
+};
+
+// フラッシュ(QMI M0)のタイミング
+typedef struct {
+    uint32_t clkdiv;        // SCK = clk_sys / clkdiv
+    uint32_t rxdelay;       // 読み込みのサンプル遅延(clk_sysの半周期単位)
+} clk_qmi_t;
+
+bool clk_div_calc(clk_user_type_t type, uint32_t src_hz, uint32_t target_hz, clk_div_t *p_div);
+int32_t clk_div_err_ppm(uint32_t target_hz, uint32_t actual_hz);
+void clk_div_format(char *p_buf, size_t size, clk_user_type_t type, const clk_div_t *p_div);
+clk_src_t clk_user_src(clk_user_type_t type);
+const char *clk_user_type_name(clk_user_type_t type);
+const char *clk_src_name(clk_src_t src);
+
+uint32_t clk_vreg_mv(uint32_t sys_hz);
+void clk_qmi_calc(uint32_t sys_hz, uint32_t boot_sys_hz, const clk_qmi_t *p_boot, clk_qmi_t *p_qmi);
+
+void clk_reg_clear(void);
+const clk_user_t *clk_reg_add(const char *p_name, clk_user_type_t type, uint32_t target_hz, void *p_hw,
+                              uint32_t index, clk_apply_t apply, const uint32_t *p_src_hz, bool is_apply);
+uint32_t clk_reg_retune(const uint32_t *p_src_hz, uint32_t *p_invalid);
+uint32_t clk_reg_num(void);
+const clk_user_t *clk_reg_get(uint32_t index);
+
+#endif // CLK_REG_H
@@ -0,0 +1,285 @@
+/**
+ * @file crc.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief CRC32/CRC16-CCITT(スライス8のソフトウェア実装とDMAスニッファの規約)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "crc.h"
+#include "hot_path.h"
+#include <string.h>
+
+#define CRC32_POLY_REF      0xEDB88320UL    // 0x04C11DB7のビット反転(LSBから処理する形)
+#define CRC32_POLY          0x04C11DB7UL
+#define CRC16_POLY          0x1021UL
+#define CRC16_INIT          0xFFFFUL
+
+// スライス8の表(k番目はバイトの後ろに0がkバイト続くときの寄与)
+// ※constを付けずにcrc_init()で生成するので.bss(SRAM)に置かれる
+static uint32_t s_crc32_tbl[8][256];
+static uint16_t s_crc16_tbl[8][256];
+
+static bool s_is_init = false;
+
+// アラインしていないかもしれない32bitの読み出し(リトルエンディアン)
+static inline uint32_t load32(const uint8_t *p)
+{
+    uint32_t word;
+
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+static uint32_t bit_reverse(uint32_t val, uint32_t bits)
+{
+    uint32_t rev = 0;
+
+    for (uint32_t i = 0; i < bits; i++)
+    {
+        rev = (rev << 1) | ((val >> i) & 1);
+    }
+
+    return rev;
+}
+
+/**
+ * @brief スライス8の表を生成
+ */
+void crc_init(void)
+{
+    if (s_is_init) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c32 = i;
+        uint32_t c16 = i << 8;
+        for (uint32_t b = 0; b < 8; b++)
+        {
+            c32 = ((c32 & 1) != 0) ? ((c32 >> 1) ^ CRC32_POLY_REF) : (c32 >> 1);
+            c16 = ((c16 & 0x8000) != 0) ? ((c16 << 1) ^ CRC16_POLY) : (c16 << 1);
+        }
+        s_crc32_tbl[0][i] = c32;
+        s_crc16_tbl[0][i] = (uint16_t)c16;
+    }
+    for (uint32_t k = 1; k < 8; k++)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c32 = s_crc32_tbl[k - 1][i];
+            uint32_t c16 = s_crc16_tbl[k - 1][i];
+            s_crc32_tbl[k][i] = (c32 >> 8) ^ s_crc32_tbl[0][c32 & 0xFF];
+            s_crc16_tbl[k][i] = (uint16_t)((c16 << 8) ^ s_crc16_tbl[0][c16 >> 8]);
+        }
+    }
+
+    s_is_init = true;
+}
+
+/**
+ * @brief 空のデータのCRC(計算を始めるときの値)
+ *
+ * @param type CRCの種類
+ * @return uint32_t CRC
+ */
+uint32_t crc_start(crc_type_t type)
+{
+    return (type == CRC_TYPE_32) ? 0 : CRC16_INIT;
+}
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t *p, uint32_t len)
+{
+    uint32_t reg = ~crc;
+
+    for (; len >= 8; p += 8, len -= 8)
+    {
+        uint32_t lo = load32(p) ^ reg;
+        uint32_t hi = load32(p + 4);
+        reg = s_crc32_tbl[7][lo & 0xFF] ^ s_crc32_tbl[6][(lo >> 8) & 0xFF]
+            ^ s_crc32_tbl[5][(lo >> 16) & 0xFF] ^ s_crc32_tbl[4][lo >> 24]
+            ^ s_crc32_tbl[3][hi & 0xFF] ^ s_crc32_tbl[2][(hi >> 8) & 0xFF]
+            ^ s_crc32_tbl[1][(hi >> 16) & 0xFF] ^ s_crc32_tbl[0][hi >> 24];
+    }
+    for (; len > 0; p++, len--)
+    {
+        reg = (reg >> 8) ^ s_crc32_tbl[0][(reg ^ *p) & 0xFF];
+    }
+
+    return ~reg;
+}
+
+// 反射なしなので先頭の2バイトにレジスタを重ねる
+static uint32_t crc16_update(uint32_t crc, const uint8_t *p, uint32_t len)
+{
+    uint32_t reg = crc & 0xFFFF;
+
+    for (; len >= 8; p += 8, len -= 8)
+    {
+        uint32_t lo = load32(p) ^ (reg >> 8) ^ ((reg & 0xFF) << 8);
+        uint32_t hi = load32(p + 4);
+        reg = s_crc16_tbl[7][lo & 0xFF] ^ s_crc16_tbl[6][(lo >> 8) & 0xFF]
+            ^ s_crc16_tbl[5][(lo >> 16) & 0xFF] ^ s_crc16_tbl[4][lo >> 24]
+            ^ s_crc16_tbl[3][hi & 0xFF] ^ s_crc16_tbl[2][(hi >> 8) & 0xFF]
+            ^ s_crc16_tbl[1][(hi >> 16) & 0xFF] ^ s_crc16_tbl[0][hi >> 24];
+    }
+    for (; len > 0; p++, len--)
+    {
+        reg = ((reg << 8) ^ s_crc16_tbl[0][(reg >> 8) ^ *p]) & 0xFFFF;
+    }
+
+    return reg;
+}
+
+/**
+ * @brief CRCを計算する(スライス8、8バイトごとに表を8回引く)
+ * @note 先にcrc_init()を呼んでおくこと
+ *
+ * @param type CRCの種類
+ * @param crc それまでのCRC(最初はcrc_start()の値)
+ * @param p_data データ
+ * @param len バイト数
+ * @return uint32_t p_dataまでのCRC
+ */
+uint32_t HOT_FUNC(crc_sw_update)(crc_type_t type, uint32_t crc, const uint8_t *p_data, uint32_t len)
+{
+    if (type == CRC_TYPE_32) {
+        return crc32_update(crc, p_data, len);
+    }
+    return crc16_update(crc, p_data, len);
+}
+HOT_PATH_REGISTER(crc_sw_update);
+
+/**
+ * @brief CRCを1bitずつ計算する(表を使わない比較用)
+ *
+ * @param type CRCの種類
+ * @param crc それまでのCRC(最初はcrc_start()の値)
+ * @param p_data データ
+ * @param len バイト数
+ * @return uint32_t p_dataまでのCRC
+ */
+uint32_t crc_bitwise_update(crc_type_t type, uint32_t crc, const uint8_t *p_data, uint32_t len)
+{
+    if (type == CRC_TYPE_32) {
+        uint32_t reg = ~crc;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            reg ^= p_data[i];
+            for (uint32_t b = 0; b < 8; b++)
+            {
+                reg = ((reg & 1) != 0) ? ((reg >> 1) ^ CRC32_POLY_REF) : (reg >> 1);
+            }
+        }
+        return ~reg;
+    }
+
+    uint32_t reg = crc & 0xFFFF;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        reg ^= (uint32_t)p_data[i] << 8;
+        for (uint32_t b = 0; b < 8; b++)
+        {
+            reg = ((reg & 0x8000) != 0) ? ((reg << 1) ^ CRC16_POLY) : (reg << 1);
+        }
+        reg &= 0xFFFF;
+    }
+    return reg;
+}
+
+/**
+ * @brief CRCの種類に合うDMAスニッファの設定
+ * @note CRC-32はデータをビット反転して流すモードにする(32bit転送でもワードごと反転されてメモリの順になる)
+ *       CRC-16はMSBから流すのでBSWAPでワードのバイトをメモリの順に並べ替える
+ *       出力の反転(OUT_REV/OUT_INV)は使わず、crc_sniff_result()で合わせる
+ *
+ * @param type CRCの種類
+ * @param p_cfg 設定
+ */
+void crc_sniff_get_cfg(crc_type_t type, crc_sniff_cfg_t *p_cfg)
+{
+    if (type == CRC_TYPE_32) {
+        p_cfg->calc = CRC_SNIFF_CALC_CRC32R;
+        p_cfg->is_bswap = false;
+    } else {
+        p_cfg->calc = CRC_SNIFF_CALC_CRC16;
+        p_cfg->is_bswap = true;
+    }
+}
+
+/**
+ * @brief SNIFF_DATAに書く初期値
+ *
+ * @param type CRCの種類
+ * @param crc それまでのCRC(最初はcrc_start()の値)
+ * @return uint32_t SNIFF_DATAの値
+ */
+uint32_t crc_sniff_seed(crc_type_t type, uint32_t crc)
+{
+    if (type == CRC_TYPE_32) {
+        return bit_reverse(~crc, 32);
+    }
+    return crc & 0xFFFF;
+}
+
+/**
+ * @brief SNIFF_DATAの値をCRCにする
+ *
+ * @param type CRCの種類
+ * @param acc 転送後のSNIFF_DATA
+ * @return uint32_t CRC(crc_sw_update()と同じ値)
+ */
+uint32_t crc_sniff_result(crc_type_t type, uint32_t acc)
+{
+    if (type == CRC_TYPE_32) {
+        return ~bit_reverse(acc, 32);
+    }
+    return acc & 0xFFFF;
+}
+
+/**
+ * @brief DMAスニッファの計算を1bitずつ再現する(規約の確認用)
+ * @note 転送の値(リトルエンディアン)をBSWAPで並べ替え、ビット反転モードなら転送幅で反転してMSBから流す
+ *
+ * @param p_cfg スニッファの設定
+ * @param acc 転送前のSNIFF_DATA
+ * @param p_data 転送するデータ
+ * @param len バイト数(xfer_sizeの倍数)
+ * @param xfer_size 転送幅のバイト数(1/2/4)
+ * @return uint32_t 転送後のSNIFF_DATA
+ */
+uint32_t crc_sniff_model(const crc_sniff_cfg_t *p_cfg, uint32_t acc, const uint8_t *p_data,
+                         uint32_t len, uint32_t xfer_size)
+{
+    bool is_crc16 = (p_cfg->calc == CRC_SNIFF_CALC_CRC16 || p_cfg->calc == CRC_SNIFF_CALC_CRC16R);
+    bool is_rev = (p_cfg->calc == CRC_SNIFF_CALC_CRC32R || p_cfg->calc == CRC_SNIFF_CALC_CRC16R);
+    uint32_t width = is_crc16 ? 16 : 32;
+    uint32_t poly = is_crc16 ? CRC16_POLY : CRC32_POLY;
+    uint32_t mask = is_crc16 ? 0xFFFFUL : 0xFFFFFFFFUL;
+    uint32_t bits = xfer_size * 8;
+
+    acc &= mask;
+    for (uint32_t i = 0; i + xfer_size <= len; i += xfer_size)
+    {
+        uint32_t val = 0;
+        for (uint32_t b = 0; b < xfer_size; b++)
+        {
+            uint32_t pos = p_cfg->is_bswap ? (xfer_size - 1 - b) : b;
+            val |= (uint32_t)p_data[i + b] << (8 * pos);
+        }
+        if (is_rev) {
+            val = bit_reverse(val, bits);
+        }
+        for (uint32_t b = bits; b > 0; b--)
+        {
+            uint32_t in = (val >> (b - 1)) & 1;
+            uint32_t top = (acc >> (width - 1)) & 1;
+            acc = ((acc << 1) ^ (((in ^ top) != 0) ? poly : 0)) & mask;
+        }
+    }
+
+    return acc;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file crc.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief CRC32/CRC16-CCITT(スライス8のソフトウェア実装とDMAスニッファの規約)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストで確認できる)
+// ※CRCの値はzlibのcrc32()と同じく「それまでのデータのCRC」で、続きを計算するときは前の値を渡す
+
+// DMAスニッファの計算モード(SNIFF_CTRL.CALCの値)
+#define CRC_SNIFF_CALC_CRC32    0x0     // CRC-32(多項式0x04C11DB7、MSBから)
+#define CRC_SNIFF_CALC_CRC32R   0x1     // CRC-32(データをビット反転して流す)
+#define CRC_SNIFF_CALC_CRC16    0x2     // CRC-16-CCITT(多項式0x1021、MSBから)
+#define CRC_SNIFF_CALC_CRC16R   0x3     // CRC-16-CCITT(データをビット反転して流す)
+
+// CRCの種類
+typedef enum {
+    CRC_TYPE_32 = 0,    // CRC-32(IEEE 802.3/zlib、反射あり、初期値と最終XORが0xFFFFFFFF)
+    CRC_TYPE_16,        // CRC-16-CCITT(多項式0x1021、反射なし、初期値0xFFFF、最終XORなし)
+    CRC_TYPE_NUM,
+} crc_type_t;
+
+// DMAスニッファの設定
+typedef struct {
+    uint32_t calc;          // SNIFF_CTRL.CALC
+    bool is_bswap;          // SNIFF_CTRL.BSWAP(16/32bit転送のバイトをメモリの順に流す)
+} crc_sniff_cfg_t;
+
+void crc_init(void);
+uint32_t crc_start(crc_type_t type);
+uint32_t crc_sw_update(crc_type_t type, uint32_t crc, const uint8_t *p_data, uint32_t len);
+uint32_t crc_bitwise_update(crc_type_t type, uint32_t crc, const uint8_t *p_data, uint32_t len);
+
+void crc_sniff_get_cfg(crc_type_t type, crc_sniff_cfg_t *p_cfg);
+uint32_t crc_sniff_seed(crc_type_t type, uint32_t crc);
+uint32_t crc_sniff_result(crc_type_t type, uint32_t acc);
+uint32_t crc_sniff_model(const crc_sniff_cfg_t *p_cfg, uint32_t acc, const uint8_t *p_data,
+                         uint32_t len, uint32_t xfer_size);
+
+#endif // CRC_H
@@ -0,0 +1,162 @@
+/**
+ * @file crc_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief DMAスニッファでのCRC計算のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "crc_hw.h"
+#include "dma_service.h"
+#include "hardware/dma.h"
+
+// 計算中の状態
+typedef struct {
+    bool is_active;         // crc_hw_start()からcrc_hw_finish()/crc_hw_abort()まで
+    bool is_dma;            // DMAで転送中(間のワードが無ければCPUだけで済ませる)
+    crc_type_t type;
+    uint32_t ch;
+    uint32_t crc;           // DMAを使わないときの結果
+    const uint8_t *p_tail;  // 末尾の端数のバイト
+    uint32_t tail_len;
+} crc_hw_state_t;
+
+static crc_hw_state_t s_crc_hw;
+
+// 転送の書き込み先(読み捨て)
+static uint32_t s_crc_hw_sink;
+
+/**
+ * @brief CRCの計算を始める(DMAの転送中はCPUを使わない)
+ *
+ * @param type CRCの種類
+ * @param crc それまでのCRC(最初はcrc_start()の値)
+ * @param p_data データ
+ * @param len バイト数
+ * @return true 始めた
+ * @return false 計算中かDMAチャネルの空きが無い
+ */
+bool crc_hw_start(crc_type_t type, uint32_t crc, const void *p_data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)p_data;
+    uint32_t head = (uint32_t)(-(uintptr_t)p) & 3;
+    crc_sniff_cfg_t cfg;
+
+    if (s_crc_hw.is_active) {
+        return false;
+    }
+    crc_init();
+
+    if (head > len) {
+        head = len;
+    }
+    uint32_t words = (len - head) / 4;
+    if (words > CRC_HW_XFER_MAX) {
+        return false;
+    }
+
+    s_crc_hw.type = type;
+    s_crc_hw.p_tail = p + head + words * 4;
+    s_crc_hw.tail_len = len - head - words * 4;
+    s_crc_hw.crc = crc_sw_update(type, crc, p, head);
+    s_crc_hw.is_dma = false;
+    if (words != 0) {
+        if (!dma_svc_ch_acquire(&s_crc_hw.ch)) {
+            return false;
+        }
+        crc_sniff_get_cfg(type, &cfg);
+
+        dma_channel_config dc = dma_channel_get_default_config(s_crc_hw.ch);
+        channel_config_set_transfer_data_size(&dc, DMA_SIZE_32);
+        channel_config_set_read_increment(&dc, true);
+        channel_config_set_write_increment(&dc, false);
+        channel_config_set_sniff_enable(&dc, true);
+        // サービスの割り込みハンドラに完了を通知しない(借りたチャネルはこちらで待つ)
+        channel_config_set_irq_quiet(&dc, true);
+        dma_channel_configure(s_crc_hw.ch, &dc, &s_crc_hw_sink, p + head, words, false);
+
+        dma_sniffer_enable(s_crc_hw.ch, cfg.calc, true);
+        dma_sniffer_set_byte_swap_enabled(cfg.is_bswap);
+        dma_sniffer_set_output_reverse_enabled(false);
+        dma_sniffer_set_output_invert_enabled(false);
+        dma_sniffer_set_data_accumulator(crc_sniff_seed(type, s_crc_hw.crc));
+        dma_channel_start(s_crc_hw.ch);
+        s_crc_hw.is_dma = true;
+    }
+    s_crc_hw.is_active = true;
+
+    return true;
+}
+
+/**
+ * @brief DMAの転送中か
+ */
+bool crc_hw_is_busy(void)
+{
+    return s_crc_hw.is_active && s_crc_hw.is_dma && dma_channel_is_busy(s_crc_hw.ch);
+}
+
+// 転送を止めてチャネルとスニッファを返す
+static void crc_hw_release(void)
+{
+    if (s_crc_hw.is_dma) {
+        dma_sniffer_disable();
+        dma_svc_ch_release(s_crc_hw.ch);
+        s_crc_hw.is_dma = false;
+    }
+    s_crc_hw.is_active = false;
+}
+
+/**
+ * @brief 転送の完了を待ってCRCを返す
+ *
+ * @return uint32_t データ全体のCRC(crc_sw_update()と同じ値)
+ */
+uint32_t crc_hw_finish(void)
+{
+    uint32_t crc = s_crc_hw.crc;
+
+    if (!s_crc_hw.is_active) {
+        return crc;
+    }
+    if (s_crc_hw.is_dma) {
+        dma_channel_wait_for_finish_blocking(s_crc_hw.ch);
+        crc = crc_sniff_result(s_crc_hw.type, dma_sniffer_get_data_accumulator());
+    }
+    crc_hw_release();
+
+    return crc_sw_update(s_crc_hw.type, crc, s_crc_hw.p_tail, s_crc_hw.tail_len);
+}
+
+/**
+ * @brief 計算を中断する
+ */
+void crc_hw_abort(void)
+{
+    if (s_crc_hw.is_active && s_crc_hw.is_dma) {
+        dma_channel_abort(s_crc_hw.ch);
+    }
+    crc_hw_release();
+}
+
+/**
+ * @brief CRCを計算する(完了まで待つ)
+ *
+ * @param type CRCの種類
+ * @param p_crc 入力はそれまでのCRC(最初はcrc_start()の値)、出力はデータ全体のCRC
+ * @param p_data データ
+ * @param len バイト数
+ * @return true 計算した
+ * @return false 計算中かDMAチャネルの空きが無い
+ */
+bool crc_hw_calc(crc_type_t type, uint32_t *p_crc, const void *p_data, uint32_t len)
+{
+    if (!crc_hw_start(type, *p_crc, p_data, len)) {
+        return false;
+    }
+    *p_crc = crc_hw_finish();
+
+    return true;
+}
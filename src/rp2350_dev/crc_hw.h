@@ -0,0 +1,27 @@
+/**
+ * @file crc_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief DMAスニッファでのCRC計算のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef CRC_HW_H
+#define CRC_HW_H
+
+#include "crc.h"
+
+// ※アラインした間の部分をDMAの32bit転送で空読みしてスニッファに計算させ、端数のバイトはCPUで計算する
+// ※スニッファは1つしか無いので、同時に計算できるのは1つだけ
+
+#define CRC_HW_XFER_MAX     0x0FFFFFFFUL    // 1回の転送の最大語数(上位4bitはモード)
+
+bool crc_hw_start(crc_type_t type, uint32_t crc, const void *p_data, uint32_t len);
+bool crc_hw_is_busy(void);
+uint32_t crc_hw_finish(void);
+void crc_hw_abort(void);
+bool crc_hw_calc(crc_type_t type, uint32_t *p_crc, const void *p_data, uint32_t len);
+
+#endif // CRC_HW_H
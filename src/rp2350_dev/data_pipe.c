@@ -0,0 +1,245 @@
+/**
+ * @file data_pipe.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief バイナリのデータパイプ(フレーミング、送信キュー、背圧)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "data_pipe.h"
+#include <string.h>
+
+void dp_init(dp_t *p_dp)
+{
+    memset(p_dp, 0, sizeof(dp_t));
+    p_dp->rx_state = DP_RX_HDR;
+}
+
+void dp_clear_stat(dp_t *p_dp)
+{
+    memset(&p_dp->stat, 0, sizeof(dp_stat_t));
+    p_dp->is_rx_seq_valid = false;
+}
+
+void dp_set_rx_handler(dp_t *p_dp, dp_rx_handler_t handler, void *p_ctx)
+{
+    p_dp->rx_handler = handler;
+    p_dp->p_rx_ctx = p_ctx;
+}
+
+void dp_hdr_pack(uint8_t *p_buf, const dp_hdr_t *p_hdr)
+{
+    p_buf[0] = (uint8_t)(p_hdr->magic & 0xFF);
+    p_buf[1] = (uint8_t)(p_hdr->magic >> 8);
+    p_buf[2] = p_hdr->type;
+    p_buf[3] = p_hdr->flags;
+    p_buf[4] = (uint8_t)(p_hdr->seq & 0xFF);
+    p_buf[5] = (uint8_t)(p_hdr->seq >> 8);
+    p_buf[6] = (uint8_t)(p_hdr->len & 0xFF);
+    p_buf[7] = (uint8_t)(p_hdr->len >> 8);
+}
+
+void dp_hdr_unpack(const uint8_t *p_buf, dp_hdr_t *p_hdr)
+{
+    p_hdr->magic = (uint16_t)(p_buf[0] | (p_buf[1] << 8));
+    p_hdr->type = p_buf[2];
+    p_hdr->flags = p_buf[3];
+    p_hdr->seq = (uint16_t)(p_buf[4] | (p_buf[5] << 8));
+    p_hdr->len = (uint16_t)(p_buf[6] | (p_buf[7] << 8));
+}
+
+/**
+ * @brief ベンチマークのペイロード(フレーム内のoffsetだけで決まる、ホストのツールと同じ式)
+ */
+uint8_t dp_pattern(uint32_t offset)
+{
+    return (uint8_t)(offset * 31 + (offset >> 8));
+}
+
+/**
+ * @brief 送信を予約する(p_dataは指すだけ、doneが呼ばれるまで書き換えない)
+ *
+ * @param p_dp パイプ
+ * @param type フレームの種類
+ * @param p_data 送るバッファ
+ * @param len バイト数(0なら空のフレームを1つ送る)
+ * @param done 送り終わったら呼ぶ(NULL可)
+ * @param p_ctx doneに渡す
+ * @return true 予約した
+ * @return false キューが満杯(背圧、pumpしてからやり直す)
+ */
+bool dp_submit(dp_t *p_dp, uint8_t type, const void *p_data, uint32_t len, dp_done_t done, void *p_ctx)
+{
+    if (p_dp->q_num >= DP_QUEUE_DEPTH) {
+        p_dp->stat.tx_full++;
+        return false;
+    }
+
+    dp_req_t *p_req = &p_dp->queue[(p_dp->q_head + p_dp->q_num) % DP_QUEUE_DEPTH];
+    p_req->p_data = (const uint8_t *)p_data;
+    p_req->len = len;
+    p_req->off = 0;
+    p_req->type = type;
+    p_req->done = done;
+    p_req->p_ctx = p_ctx;
+    p_dp->q_num++;
+
+    return true;
+}
+
+uint32_t dp_tx_queued(const dp_t *p_dp)
+{
+    return p_dp->q_num;
+}
+
+// 先頭の要求から次のフレームのヘッダを作る
+static void dp_open_frame(dp_t *p_dp, const dp_req_t *p_req)
+{
+    uint32_t rest = p_req->len - p_req->off;
+    uint32_t len = (rest > DP_FRAME_PAYLOAD_MAX) ? DP_FRAME_PAYLOAD_MAX : rest;
+    dp_hdr_t hdr;
+
+    hdr.magic = DP_MAGIC;
+    hdr.type = p_req->type;
+    hdr.flags = (len == rest) ? DP_FLAG_END : 0;
+    hdr.seq = p_dp->tx_seq++;
+    hdr.len = (uint16_t)len;
+    dp_hdr_pack(p_dp->tx_hdr, &hdr);
+
+    p_dp->tx_hdr_off = 0;
+    p_dp->tx_left = len;
+    p_dp->is_frame_open = true;
+}
+
+/**
+ * @brief キューの中身をリンクが受け取れるだけ書く
+ * @note リンクが一杯ならそこでやめる(続きは次のpump)
+ *
+ * @return uint32_t 書いたバイト数
+ */
+uint32_t dp_tx_pump(dp_t *p_dp, const dp_link_t *p_link)
+{
+    uint32_t total = 0;
+
+    while (p_dp->q_num > 0)
+    {
+        dp_req_t *p_req = &p_dp->queue[p_dp->q_head];
+
+        if (!p_dp->is_frame_open) {
+            dp_open_frame(p_dp, p_req);
+        }
+
+        // ペイロードまで書き終わったらフレームを閉じる
+        if (p_dp->tx_hdr_off == DP_HDR_SIZE && p_dp->tx_left == 0) {
+            p_dp->is_frame_open = false;
+            p_dp->stat.tx_frames++;
+            if (p_req->off < p_req->len) {
+                continue;
+            }
+            p_dp->q_head = (p_dp->q_head + 1) % DP_QUEUE_DEPTH;
+            p_dp->q_num--;
+            p_dp->stat.tx_msgs++;
+            if (p_req->done != NULL) {
+                p_req->done(p_req->p_ctx, p_req->p_data, p_req->len);
+            }
+            continue;
+        }
+
+        uint32_t avail = p_link->write_avail(p_link->p_ctx);
+        if (avail == 0) {
+            p_dp->stat.tx_stall++;
+            break;
+        }
+
+        uint32_t n;
+        if (p_dp->tx_hdr_off < DP_HDR_SIZE) {
+            uint32_t want = DP_HDR_SIZE - p_dp->tx_hdr_off;
+            n = p_link->write(p_link->p_ctx, &p_dp->tx_hdr[p_dp->tx_hdr_off], (avail < want) ? avail : want);
+            p_dp->tx_hdr_off += n;
+        } else {
+            n = p_link->write(p_link->p_ctx, &p_req->p_data[p_req->off],
+                              (avail < p_dp->tx_left) ? avail : p_dp->tx_left);
+            p_req->off += n;
+            p_dp->tx_left -= n;
+        }
+        total += n;
+        if (n == 0) {
+            p_dp->stat.tx_stall++;
+            break;
+        }
+    }
+
+    if (total > 0 && p_link->flush != NULL) {
+        p_link->flush(p_link->p_ctx);
+    }
+    p_dp->stat.tx_bytes += total;
+
+    return total;
+}
+
+// ヘッダがそろった、magicが合わなければ1バイトずらして探し直す
+static void dp_rx_hdr_done(dp_t *p_dp)
+{
+    dp_hdr_unpack(p_dp->rx_hdr_buf, &p_dp->rx_hdr);
+    if (p_dp->rx_hdr.magic != DP_MAGIC) {
+        memmove(p_dp->rx_hdr_buf, &p_dp->rx_hdr_buf[1], DP_HDR_SIZE - 1);
+        p_dp->rx_hdr_off = DP_HDR_SIZE - 1;
+        p_dp->stat.rx_resync++;
+        return;
+    }
+
+    if (p_dp->is_rx_seq_valid && p_dp->rx_hdr.seq != p_dp->rx_seq) {
+        p_dp->stat.rx_seq_err++;
+    }
+    p_dp->rx_seq = (uint16_t)(p_dp->rx_hdr.seq + 1);
+    p_dp->is_rx_seq_valid = true;
+    p_dp->rx_hdr_off = 0;
+    p_dp->rx_off = 0;
+
+    if (p_dp->rx_hdr.len == 0) {
+        // 空のフレームは1回だけ通知する
+        if (p_dp->rx_handler != NULL) {
+            p_dp->rx_handler(p_dp->p_rx_ctx, &p_dp->rx_hdr, 0, NULL, 0);
+        }
+        p_dp->stat.rx_frames++;
+    } else {
+        p_dp->rx_state = DP_RX_PAYLOAD;
+    }
+}
+
+/**
+ * @brief 受け取ったバイト列を流し込む(区切りはどこでもよい)
+ * @note ペイロードはコピーせずにp_dataを指したままハンドラに渡す
+ */
+void dp_rx_feed(dp_t *p_dp, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t pos = 0;
+
+    p_dp->stat.rx_bytes += len;
+
+    while (pos < len)
+    {
+        if (p_dp->rx_state == DP_RX_HDR) {
+            p_dp->rx_hdr_buf[p_dp->rx_hdr_off++] = p_data[pos++];
+            if (p_dp->rx_hdr_off == DP_HDR_SIZE) {
+                dp_rx_hdr_done(p_dp);
+            }
+            continue;
+        }
+
+        uint32_t want = p_dp->rx_hdr.len - p_dp->rx_off;
+        uint32_t n = ((len - pos) < want) ? (len - pos) : want;
+        if (p_dp->rx_handler != NULL) {
+            p_dp->rx_handler(p_dp->p_rx_ctx, &p_dp->rx_hdr, p_dp->rx_off, &p_data[pos], n);
+        }
+        pos += n;
+        p_dp->rx_off += n;
+        p_dp->stat.rx_payload += n;
+        if (p_dp->rx_off == p_dp->rx_hdr.len) {
+            p_dp->stat.rx_frames++;
+            p_dp->rx_state = DP_RX_HDR;
+        }
+    }
+}
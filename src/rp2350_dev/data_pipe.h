@@ -0,0 +1,122 @@
+/**
+ * @file data_pipe.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief バイナリのデータパイプ(フレーミング、送信キュー、背圧)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DATA_PIPE_H
+#define DATA_PIPE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(下のリンクを差し替えればホストでループバックできる)
+// ※送信は呼び出し側のバッファを指すだけでコピーしない(完了コールバックまでバッファを触らないこと)
+// ※submitとpumpは同じコアから呼ぶ(キューはロックしない)
+
+#define DP_MAGIC                0x5044      // 'D','P'(LE)
+#define DP_HDR_SIZE             8
+#define DP_FRAME_PAYLOAD_MAX    4096        // 1フレームのペイロードの上限(大きいsubmitは分割する)
+#define DP_QUEUE_DEPTH          8           // 送信キューの段数(満杯ならsubmitがfalse=背圧)
+#define DP_FLAG_END             0x01        // submit 1回分(メッセージ)の最後のフレーム
+
+// フレームの種類(ホストのツールと合わせる)
+typedef enum {
+    DP_TYPE_RAW = 0,        // 生データ(メモリのダンプ等)
+    DP_TYPE_BENCH,          // ベンチマークのパターン
+    DP_TYPE_NUM
+} dp_type_t;
+
+// フレームのヘッダ(LEで8バイト: magic(2) type(1) flags(1) seq(2) len(2))
+typedef struct {
+    uint16_t magic;
+    uint8_t type;
+    uint8_t flags;
+    uint16_t seq;           // フレームごとに+1(受信側で抜けを数える)
+    uint16_t len;           // ペイロードのバイト数
+} dp_hdr_t;
+
+// 送信の完了(バッファを返す)
+typedef void (*dp_done_t)(void *p_ctx, const uint8_t *p_data, uint32_t len);
+// 受信したペイロードの断片(p_hdrのフレームのoffsetから、受信バッファを指したまま渡す)
+typedef void (*dp_rx_handler_t)(void *p_ctx, const dp_hdr_t *p_hdr, uint32_t offset,
+                                const uint8_t *p_data, uint32_t len);
+
+// 下のリンク(USB CDC、ホストのループバック等)
+typedef struct {
+    uint32_t (*write_avail)(void *p_ctx);                               // 今書けるバイト数
+    uint32_t (*write)(void *p_ctx, const uint8_t *p_data, uint32_t len); // 書けたバイト数
+    void (*flush)(void *p_ctx);
+    void *p_ctx;
+} dp_link_t;
+
+// 送信の要求
+typedef struct {
+    const uint8_t *p_data;
+    uint32_t len;
+    uint32_t off;           // 送ったバイト数
+    uint8_t type;
+    dp_done_t done;
+    void *p_ctx;
+} dp_req_t;
+
+// 統計
+typedef struct {
+    uint64_t tx_bytes;      // リンクに書いたバイト数(ヘッダ込み)
+    uint64_t rx_bytes;      // 受け取ったバイト数(ヘッダ込み)
+    uint64_t rx_payload;    // 受け取ったペイロードのバイト数
+    uint32_t tx_frames;
+    uint32_t tx_msgs;       // 完了したsubmit
+    uint32_t tx_full;       // キューが満杯でsubmitを断った回数
+    uint32_t tx_stall;      // リンクが一杯で送れなかった回数
+    uint32_t rx_frames;
+    uint32_t rx_resync;     // magicが合わずに捨てたバイト数
+    uint32_t rx_seq_err;    // seqが飛んだ回数
+} dp_stat_t;
+
+// 受信の状態
+typedef enum {
+    DP_RX_HDR = 0,
+    DP_RX_PAYLOAD,
+} dp_rx_state_t;
+
+// パイプ1本分
+typedef struct {
+    // 送信
+    dp_req_t queue[DP_QUEUE_DEPTH];
+    uint32_t q_head;
+    uint32_t q_num;
+    uint8_t tx_hdr[DP_HDR_SIZE];
+    uint32_t tx_hdr_off;    // 今のフレームのヘッダを書いたバイト数
+    uint32_t tx_left;       // 今のフレームのペイロードの残り
+    uint16_t tx_seq;
+    bool is_frame_open;
+    // 受信
+    dp_rx_state_t rx_state;
+    uint8_t rx_hdr_buf[DP_HDR_SIZE];
+    uint32_t rx_hdr_off;
+    dp_hdr_t rx_hdr;
+    uint32_t rx_off;        // 今のフレームで受け取ったペイロードのバイト数
+    uint16_t rx_seq;        // 次に来るはずのseq
+    bool is_rx_seq_valid;
+    dp_rx_handler_t rx_handler;
+    void *p_rx_ctx;
+    dp_stat_t stat;
+} dp_t;
+
+void dp_init(dp_t *p_dp);
+void dp_clear_stat(dp_t *p_dp);
+void dp_set_rx_handler(dp_t *p_dp, dp_rx_handler_t handler, void *p_ctx);
+bool dp_submit(dp_t *p_dp, uint8_t type, const void *p_data, uint32_t len, dp_done_t done, void *p_ctx);
+uint32_t dp_tx_pump(dp_t *p_dp, const dp_link_t *p_link);
+uint32_t dp_tx_queued(const dp_t *p_dp);
+void dp_rx_feed(dp_t *p_dp, const uint8_t *p_data, uint32_t len);
+void dp_hdr_pack(uint8_t *p_buf, const dp_hdr_t *p_hdr);
+void dp_hdr_unpack(const uint8_t *p_buf, dp_hdr_t *p_hdr);
+uint8_t dp_pattern(uint32_t offset);
+
+#endif // DATA_PIPE_H
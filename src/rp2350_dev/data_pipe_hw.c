@@ -0,0 +1,107 @@
+/**
+ * @file data_pipe_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief データパイプのH/W層(USB CDC1)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "data_pipe_hw.h"
+#include "tusb.h"
+
+static dp_t s_dp;
+static uint8_t s_rx_buf[DATA_PIPE_HW_RX_CHUNK];
+
+static uint32_t data_pipe_hw_write_avail(void *p_ctx)
+{
+    (void)p_ctx;
+    return tud_cdc_n_write_available(DATA_PIPE_HW_ITF);
+}
+
+static uint32_t data_pipe_hw_write(void *p_ctx, const uint8_t *p_data, uint32_t len)
+{
+    (void)p_ctx;
+    return tud_cdc_n_write(DATA_PIPE_HW_ITF, p_data, len);
+}
+
+static void data_pipe_hw_flush(void *p_ctx)
+{
+    (void)p_ctx;
+    tud_cdc_n_write_flush(DATA_PIPE_HW_ITF);
+}
+
+static const dp_link_t s_link = {
+    .write_avail = data_pipe_hw_write_avail,
+    .write = data_pipe_hw_write,
+    .flush = data_pipe_hw_flush,
+    .p_ctx = NULL,
+};
+
+/**
+ * @brief TinyUSBとパイプの初期化(stdio_init_all()より前に呼ぶ)
+ */
+void data_pipe_hw_init(void)
+{
+    dp_init(&s_dp);
+    tusb_init();
+}
+
+/**
+ * @brief ホストがデータ側のポートを開いている(DTR)
+ */
+bool data_pipe_hw_is_connected(void)
+{
+    return tud_cdc_n_connected(DATA_PIPE_HW_ITF);
+}
+
+/**
+ * @brief 送信を予約する(p_dataはdoneまで触らない、falseならキューが満杯)
+ */
+bool data_pipe_hw_submit(uint8_t type, const void *p_data, uint32_t len, dp_done_t done, void *p_ctx)
+{
+    return dp_submit(&s_dp, type, p_data, len, done, p_ctx);
+}
+
+/**
+ * @brief 送信キューをCDCのFIFOに流し、受信をパーサに流す
+ * @note シェルのループから呼ぶ
+ *
+ * @return true 送信がまだ残っている(寝ないで回す)
+ * @return false 送信の残りなし
+ */
+bool data_pipe_hw_poll(void)
+{
+    if (dp_tx_queued(&s_dp) > 0) {
+        dp_tx_pump(&s_dp, &s_link);
+    }
+
+    uint32_t budget = CFG_TUD_CDC_RX_BUFSIZE;
+    while (budget > 0 && tud_cdc_n_available(DATA_PIPE_HW_ITF) > 0)
+    {
+        uint32_t n = tud_cdc_n_read(DATA_PIPE_HW_ITF, s_rx_buf, sizeof(s_rx_buf));
+        if (n == 0) {
+            break;
+        }
+        dp_rx_feed(&s_dp, s_rx_buf, n);
+        budget = (n < budget) ? budget - n : 0;
+    }
+
+    return (dp_tx_queued(&s_dp) > 0);
+}
+
+void data_pipe_hw_set_rx_handler(dp_rx_handler_t handler, void *p_ctx)
+{
+    dp_set_rx_handler(&s_dp, handler, p_ctx);
+}
+
+void data_pipe_hw_clear_stat(void)
+{
+    dp_clear_stat(&s_dp);
+}
+
+const dp_t *data_pipe_hw_get(void)
+{
+    return &s_dp;
+}
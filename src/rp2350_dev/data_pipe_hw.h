@@ -0,0 +1,29 @@
+/**
+ * @file data_pipe_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief データパイプのH/W層(USB CDC1)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DATA_PIPE_HW_H
+#define DATA_PIPE_HW_H
+
+#include "data_pipe.h"
+
+#define DATA_PIPE_HW_ITF        1           // CDCの番号(0はstdio/シェル)
+#define DATA_PIPE_HW_RX_CHUNK   256         // 1回に読むバイト数
+
+// ※submit/pollはCore1(シェル)から呼ぶ、tud_task()はSDKのstdio_usbがCore0の低優先度IRQで回す
+
+void data_pipe_hw_init(void);
+bool data_pipe_hw_is_connected(void);
+bool data_pipe_hw_submit(uint8_t type, const void *p_data, uint32_t len, dp_done_t done, void *p_ctx);
+bool data_pipe_hw_poll(void);
+void data_pipe_hw_set_rx_handler(dp_rx_handler_t handler, void *p_ctx);
+void data_pipe_hw_clear_stat(void);
+const dp_t *data_pipe_hw_get(void);
+
+#endif // DATA_PIPE_HW_H
@@ -0,0 +1,65 @@
+/**
+ * @file dbg_args.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief デバッグモニタのコマンド行の分割
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "dbg_args.h"
+#include <stdio.h>
+#include <string.h>
+
+// コマンド引数を分割して解析
+int32_t dbg_args_split(char* p_str, dbg_cmd_args_t* p_args)
+{
+    char* p_token;
+    char* p_next = p_str;
+    char* p_end = p_str + strlen(p_str);
+
+    p_args->argc = 0;
+#ifdef DEBUG_DBG_COM
+    printf("[DEBUG] : Input string = '%s'\n", p_str);  // 入力文字列の確認
+#endif // DEBUG_DBG_COM
+
+    while (p_next < p_end && p_args->argc < DBG_CMD_MAX_ARGS)
+    {
+        // スペースをスキップ
+        while (*p_next == ' ' && p_next < p_end)
+        {
+            p_next++;
+        }
+        if (p_next >= p_end) break;
+
+        // トークンの開始位置を記録
+        p_token = p_next;
+
+        // 次のスペースまたは文字列末尾まで移動
+        while (*p_next != ' ' && p_next < p_end)
+        {
+            p_next++;
+        }
+
+        // 文字列を終端
+        if (*p_next == ' ') {
+            *p_next++ = '\0';
+        }
+
+#ifdef DEBUG_DBG_COM
+        printf("[DEBUG] : Next token = '%s'\n", p_token);
+#endif // DEBUG_DBG_COM
+        p_args->p_argv[p_args->argc++] = p_token;
+    }
+
+#ifdef DEBUG_DBG_COM
+    printf("[DEBUG] : argc = %d\n", p_args->argc);
+    for (int i = 0; i < p_args->argc; i++)
+    {
+        printf("[DEBUG] : argv[%d] = %s\n", i, p_args->p_argv[i]);
+    }
+#endif // DEBUG_DBG_COM
+
+    return p_args->argc;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file dbg_args.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief デバッグモニタのコマンド行の分割のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DBG_ARGS_H
+#define DBG_ARGS_H
+
+#include <stdint.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストの性能回帰チェックでもビルドする)
+// ※分割の途中の表示(DEBUG_DBG_COM)はdbg_com.hを読まないので、-DDEBUG_DBG_COMで有効にする
+
+#define DBG_CMD_MAX_ARGS 8 // コマンドの最大引数数
+
+// コマンド引数構造体
+typedef struct {
+    int32_t argc;                    // 引数の数
+    char* p_argv[DBG_CMD_MAX_ARGS]; // 引数の配列
+} dbg_cmd_args_t;
+
+int32_t dbg_args_split(char* p_str, dbg_cmd_args_t* p_args);
+
+#endif // DBG_ARGS_H
@@ -11,13 +11,41 @@
 #include "dbg_com.h"
 #include "app_main.h"
 #include "mcu_util.h"
+#include "fft.h"
+#include "pi_chud.h"
+#include "app_cpu_core_0.h"
+#include "fast_mem.h"
+#include "membench.h"
+#include "dma_service.h"
+#include "xip_stat.h"
+#include "hot_path.h"
+#include "prof_hw.h"
+#include "trace.h"
+#include "perf_ctr.h"
+#include "mem_arena.h"
+#include "mem_hw.h"
+#include "mem_ops.h"
+#include "crc_hw.h"
+#include "timer_svc.h"
+#include "jitter_hw.h"
+#include "irq_lat_hw.h"
+#include "la_hw.h"
+#include "freq_hw.h"
+#include "clk_hw.h"
+#include "idle_hw.h"
+#include "data_pipe_hw.h"
+#include "uart_hw.h"
+#include "boot_hw.h"
+#include "reg_ops.h"
+#include "gpio_bench_hw.h"
+#include "hardware/sync.h"
+#include "hardware/structs/resets.h"
 
 // コマンド履歴
 static char s_cmd_history[CMD_HISTORY_MAX][DBG_CMD_MAX_LEN];
 static uint8_t s_history_count = 0;  // コマンド履歴の数
 static int8_t s_history_pos = -1;    // 現在の履歴位置（-1は最新）
 
-static void sort_available_orders(void);
 static void dbg_com_init_msg(void);
 static void cmd_help(void);
 static void cmd_ver(void);
@@ -32,9 +60,35 @@ static void cmd_trig(void);
 static void cmd_atan2(void);
 static void cmd_tan355(void);
 static void cmd_isqrt(void);
+static void cmd_fft(const dbg_cmd_args_t* p_args);
+static void cmd_membench(const dbg_cmd_args_t* p_args);
+static void cmd_dma(const dbg_cmd_args_t* p_args);
+static void cmd_xip(const dbg_cmd_args_t* p_args);
+static void cmd_ram(void);
+static void cmd_prof(const dbg_cmd_args_t* p_args);
+static void cmd_trace(const dbg_cmd_args_t* p_args);
+static void cmd_perf(const dbg_cmd_args_t* p_args);
+static void cmd_mem(const dbg_cmd_args_t* p_args);
+static void cmd_jitter(const dbg_cmd_args_t* p_args);
+static void cmd_irqlat(const dbg_cmd_args_t* p_args);
+static void cmd_la(const dbg_cmd_args_t* p_args);
+static void cmd_freq(const dbg_cmd_args_t* p_args);
+static void cmd_clk(const dbg_cmd_args_t* p_args);
+static void cmd_idle(const dbg_cmd_args_t* p_args);
+static void cmd_pipe(const dbg_cmd_args_t* p_args);
+static void cmd_uart(const dbg_cmd_args_t* p_args);
+static void cmd_boot(const dbg_cmd_args_t* p_args);
+static dbg_cmd_t dbg_com_parse_cmd(const char* p_cmd_str, dbg_cmd_args_t* p_args);
+static dbg_cmd_t dbg_com_sub_args(const dbg_cmd_args_t* p_args, int32_t skip, dbg_cmd_args_t* p_sub);
+static void dbg_com_execute_cmd(dbg_cmd_t cmd, const dbg_cmd_args_t* p_args);
 static void cmd_timer(const dbg_cmd_args_t* p_args);
 static void cmd_gpio(const dbg_cmd_args_t* p_args);
 static void cmd_mem_dump(const dbg_cmd_args_t* p_args);
+static void cmd_mem_find(const dbg_cmd_args_t* p_args);
+static void cmd_mem_fill(const dbg_cmd_args_t* p_args);
+static void cmd_mem_cmp(const dbg_cmd_args_t* p_args);
+static void cmd_mem_cpy(const dbg_cmd_args_t* p_args);
+static void cmd_crc(const dbg_cmd_args_t* p_args);
 static void cmd_i2c(const dbg_cmd_args_t* p_args);
 static void cmd_reg(const dbg_cmd_args_t* p_args);
 
@@ -47,121 +101,68 @@ static const dbg_cmd_info_t s_cmd_table[] = {
     {"sha",     CMD_SHA,        "Calc SHA-256 Hash using H/W Accelerator", 0, 1},
     {"rst",     CMD_RST,        "Reboot", 0, 0},
     {"mem_dump", CMD_MEM_DUMP,  "Dump memory contents (address, length)", 2, 2},
-    {"reg",     CMD_REG,        "Register read/write: reg #addr r|w bits [#val]", 3, 4},
+    {"mem_find", CMD_MEM_FIND,  "Search memory: mem_find #addr #len <#hexbytes|w#word|text>", 3, 3},
+    {"mem_fill", CMD_MEM_FILL,  "Fill memory with a word: mem_fill #addr #len #val [dma]", 3, 4},
+    {"mem_cmp", CMD_MEM_CMP,    "Compare memory: mem_cmp #addr_a #addr_b #len", 3, 3},
+    {"mem_cpy", CMD_MEM_CPY,    "Copy memory: mem_cpy #dst #src #len [dma]", 3, 4},
+    {"crc",     CMD_CRC,        "CRC32/CRC16-CCITT: crc #addr #len [32|16] [sw|dma] | crc test | crc bench [KB]", 1, 4},
+    {"reg",     CMD_REG,        "Registers: reg <#addr|name> r [bits]|w [bits] #val|rmw #mask #val [shift]|poll #mask #val [ms] [ne] | reg snap|dump <block|#addr #len> | reg diff | reg list [block]", 1, 6},
     {"i2c",     CMD_I2C,        "I2C control (port, command)", 2, 2},
-    {"gpio",    CMD_GPIO,       "Control GPIO pin (pin, value)", 2, 2},
-    {"timer",   CMD_TIMER,      "Set timer alarm (seconds)", 0, 1},
+    {"gpio",    CMD_GPIO,       "GPIO: gpio <pin> <0|1> | gpio bench <pin|lo-hi|#mask> [writes] [method] | gpio free <pins>", 2, 4},
+    {"timer",   CMD_TIMER,      "Software timers: timer [<sec>|list|every <ms>|cancel <id|all>|load <n> <ms>|stat|clr]", 0, 3},
     {"at",      CMD_AT_TEST,    "int/float/double arithmetic test", 0, 0},
-    {"pi",      CMD_PI_CALC,    "Calculate pi using Gauss-Legendre", 0, 1},
+    {"pi",      CMD_PI_CALC,    "Calculate pi: pi [iterations] | pi chud <digits>", 0, 2},
     {"trig",    CMD_TRIG,       "Run sin,cos,tan functions test", 0, 0},
     {"atan2",   CMD_ATAN2,      "Run atan2 test", 0, 0},
     {"tan355",  CMD_TAN355,     "Run tan(355/226) test", 0, 0},
     {"isqrt",   CMD_ISQRT,      "Run 1/sqrt(x) test", 0, 0},
+    {"fft",     CMD_FFT,        "FFT benchmark (Q15/float32, 64-4096 points)", 0, 1},
+    {"membench", CMD_MEMBENCH,  "Memory bandwidth: membench [all|stream|copy|region] [n]", 0, 2},
+    {"dma",     CMD_DMA,        "DMA service: dma [stat|clr|test]", 0, 1},
+    {"xip",     CMD_XIP,        "XIP cache: xip [stat|clr|bench|run <cmd> [args...]]", 0, DBG_CMD_MAX_ARGS - 1},
+    {"idle",    CMD_IDLE,       "Idle residency and wake latency: idle [stat|clr|wfe|spin]", 0, 1},
+    {"pipe",    CMD_PIPE,       "USB data pipe (CDC1): pipe [stat|clr|send #addr #len|bench <tx|rx> [MB]]", 0, 3},
+    {"uart",    CMD_UART,       "UART rings and shell: uart [stat|clr|shell <0|1|off>|bench [0|1]]", 0, 2},
+    {"boot",    CMD_BOOT,       "Boot timeline and init tasks: boot [run <task>]", 0, 2},
+    {"ram",     CMD_RAM,        "List RAM-resident sections and HOT_FUNC functions", 0, 0},
+    {"prof",    CMD_PROF,       "PC sampling profiler: prof [start|stop|stat|dump|clr|run <cmd>]", 0, DBG_CMD_MAX_ARGS - 1},
+    {"trace",   CMD_TRACE,      "Event trace: trace [start|stop|clr|stat|dump]", 0, 1},
+    {"perf",    CMD_PERF,       "DWT/XIP counters: perf <cmd> [args...] | perf [top|clr|on|off]", 0, DBG_CMD_MAX_ARGS - 1},
+    {"mem",     CMD_MEM,        "Stack/arena/pool usage and alloc benchmark: mem [stat|bench]", 0, 1},
+    {"jitter",  CMD_JITTER,     "Alarm lateness histogram: jitter [hz] [sec] [idle|mem|flash]", 0, 3},
+    {"irqlat",  CMD_IRQLAT,     "IRQ entry latency: irqlat [pio|gpio <out_pin> <in_pin>] [samples]", 0, 4},
+    {"la",      CMD_LA,         "Logic analyzer: la <base> <num> <hz> [samples] [pre] [none|rise:<pin>|fall:<pin>|edge:<pin>|pat:<mask>:<val>] | la dump", 1, 6},
+    {"freq",    CMD_FREQ,       "Frequency/duty/jitter: freq <pin> [gate_ms] | freq <pin> pulse [periods]", 1, 3},
+    {"clk",     CMD_CLK,        "Clock scaling: clk [list|<mhz>|bench <mhz[,mhz...]> <cmd> [args...]]", 0, DBG_CMD_MAX_ARGS - 1},
     {NULL,      CMD_UNKNOWN, NULL, 0, 0}
 };
 
 // コマンドバッファ
 static char s_cmd_buffer[DBG_CMD_MAX_LEN];
-static int32_t s_cmd_index = 0;
-
-// タイマー状態
-static timer_state_t s_timer_state[TIMER_MAX_ALARMS] = {0};
-static uint8_t s_available_orders[TIMER_MAX_ALARMS] = {1, 2, 3, 4};  // 利用可能な登録順序
-static uint8_t s_available_count = TIMER_MAX_ALARMS;  // 利用可能な登録順序の数
-
-static int32_t split_str(char* p_str, dbg_cmd_args_t* p_args);
-
-// コマンド引数を分割して解析
-static int32_t split_str(char* p_str, dbg_cmd_args_t* p_args)
-{
-    char* p_token;
-    char* p_next = p_str;
-    char* p_end = p_str + strlen(p_str);
-
-    p_args->argc = 0;
-#ifdef DEBUG_DBG_COM
-    printf("[DEBUG] : Input string = '%s'\n", p_str);  // 入力文字列の確認
-#endif // DEBUG_DBG_COM
-
-    while (p_next < p_end && p_args->argc < DBG_CMD_MAX_ARGS)
-    {
-        // スペースをスキップ
-        while (*p_next == ' ' && p_next < p_end)
-        {
-            p_next++;
-        }
-        if (p_next >= p_end) break;
-
-        // トークンの開始位置を記録
-        p_token = p_next;
-
-        // 次のスペースまたは文字列末尾まで移動
-        while (*p_next != ' ' && p_next < p_end)
-        {
-            p_next++;
-        }
-
-        // 文字列を終端
-        if (*p_next == ' ') {
-            *p_next++ = '\0';
-        }
 
-#ifdef DEBUG_DBG_COM
-        printf("[DEBUG] : Next token = '%s'\n", p_token);
-#endif // DEBUG_DBG_COM
-        p_args->p_argv[p_args->argc++] = p_token;
-        WDT_RST();
-    }
-
-#ifdef DEBUG_DBG_COM
-    printf("[DEBUG] : argc = %d\n", p_args->argc);
-    for (int i = 0; i < p_args->argc; i++)
-    {
-        printf("[DEBUG] : argv[%d] = %s\n", i, p_args->p_argv[i]);
-    }
-#endif // DEBUG_DBG_COM
+// コマンド用アリーナ(dbg_com_execute_cmd()の終了時に解放)
+static uint8_t s_cmd_arena_buf[DBG_CMD_ARENA_SIZE] __attribute__((aligned(MEM_ARENA_ALIGN)));
+static mem_arena_t s_cmd_arena;
+_Static_assert(2 * DMA_TEST_SIZE <= DBG_CMD_ARENA_SIZE, "dma test buffers must fit in the command arena");
+_Static_assert(CRC_TEST_BYTES + 4 <= DBG_CMD_ARENA_SIZE, "crc test buffer must fit in the command arena");
+static int32_t s_cmd_index = 0;
 
-    return p_args->argc;
-}
+// timer loadのタイマーが満了した回数
+static uint32_t s_timer_load_fired = 0;
 
-// タイマーコールバック関数
-static int64_t timer_callback(alarm_id_t id, void *user_data)
+// タイマーコールバック関数(timer_svc_poll()から呼ばれるので割り込みではない)
+static void timer_callback(int32_t id, void *p_arg)
 {
-    // 対応するタイマーを探して状態を更新
-    for (int i = 0; i < TIMER_MAX_ALARMS; i++)
-    {
-        if (s_timer_state[i].alarm_id == id) {
-            printf("\nTimer #%d (alarm as #%d) alarm!\n", 
-                i + 1, s_timer_state[i].reg_order);
-            // 登録順序を再利用可能なリストに戻す
-            s_available_orders[s_available_count++] = s_timer_state[i].reg_order;
-            sort_available_orders();  // 利用可能な登録順序を昇順にソート
-            s_timer_state[i].is_running = false;
-            s_timer_state[i].alarm_id = 0;
-            s_timer_state[i].reg_order = 0;
-            break;
-        }
-    }
-
-    printf("> ");
-
-    return 0;  // 繰り返しなし
+    (void)p_arg;
+    printf("\nTimer #%d alarm!\n> ", id);
 }
 
-// 利用可能な登録順序を昇順にソート
-static void sort_available_orders(void)
+// timer loadのコールバック関数(回数を数えるだけ)
+static void timer_load_callback(int32_t id, void *p_arg)
 {
-    for (int i = 0; i < s_available_count - 1; i++)
-    {
-        for (int j = 0; j < s_available_count - i - 1; j++)
-        {
-            if (s_available_orders[j] > s_available_orders[j + 1]) {
-                uint8_t temp = s_available_orders[j];
-                s_available_orders[j] = s_available_orders[j + 1];
-                s_available_orders[j + 1] = temp;
-            }
-        }
-    }
+    (void)id;
+    (void)p_arg;
+    s_timer_load_fired++;
 }
 
 static void dbg_com_init_msg(void)
@@ -262,12 +263,159 @@ static void cmd_at_test(void)
     measure_execution_time(double_div_test, "double_div_test");
 }
 
+// Core0で計算するBinary Splittingの区間
+typedef struct {
+    uint32_t a;
+    uint32_t b;
+    pi_chud_pqt_t pqt;
+    bool is_ok;
+} pi_chud_job_t;
+
+// Core0側のジョブ関数
+static void pi_chud_core0_job(void *p_arg)
+{
+    pi_chud_job_t *p_job = (pi_chud_job_t *)p_arg;
+
+    p_job->is_ok = pi_chud_bs(p_job->a, p_job->b, &p_job->pqt);
+}
+
+/**
+ * @brief Chudnovsky法で円周率を計算
+ *
+ * @param digits 小数点以下の桁数
+ * @param is_dual_core trueならBinary Splittingの木をCore0とCore1で分担
+ * @param p_out 出力先(digits+3バイト以上)
+ * @param p_split_us Binary Splittingの処理時間(us)
+ * @param p_total_us 全体の処理時間(us)
+ * @return true 成功
+ * @return false メモリ不足
+ */
+static bool pi_chud_run(uint32_t digits, bool is_dual_core, char *p_out,
+                        uint32_t *p_split_us, uint32_t *p_total_us)
+{
+    uint32_t terms = pi_chud_terms(digits);
+    pi_chud_pqt_t pqt;
+    bool is_ok;
+
+    pi_chud_pqt_init(&pqt);
+    volatile uint32_t start_time = time_us_32();
+    if (is_dual_core) {
+        // 後半の区間をCore0、前半の区間をCore1で計算して結合
+        static pi_chud_job_t s_job;
+        s_job.a = pi_chud_split_point(terms);
+        s_job.b = terms;
+        s_job.is_ok = false;
+        pi_chud_pqt_init(&s_job.pqt);
+        app_core_0_job_start(pi_chud_core0_job, &s_job);
+        is_ok = pi_chud_bs(0, s_job.a, &pqt);
+        app_core_0_job_wait();
+        if (is_ok && s_job.is_ok) {
+            is_ok = pi_chud_merge(&pqt, &s_job.pqt);
+        } else {
+            is_ok = false;
+            pi_chud_pqt_free(&s_job.pqt);
+        }
+    } else {
+        is_ok = pi_chud_bs(0, terms, &pqt);
+    }
+    volatile uint32_t split_time = time_us_32();
+    is_ok = is_ok && pi_chud_finish(&pqt, digits, p_out);
+    volatile uint32_t end_time = time_us_32();
+    pi_chud_pqt_free(&pqt);
+
+    *p_split_us = split_time - start_time;
+    *p_total_us = end_time - start_time;
+
+    return is_ok;
+}
+
+/**
+ * @brief Chudnovsky法の円周率計算ベンチマーク(シングルコア vs デュアルコア)
+ *
+ * @param digits 小数点以下の桁数
+ */
+static void cmd_pi_chud(uint32_t digits)
+{
+    uint32_t split_us[2], total_us[2];
+    char *p_out[2];
+    bool is_ok = true;
+
+    if (app_core_0_job_is_busy()) {
+        printf("Error: CPU Core0 is busy.\n");
+        return;
+    }
+
+    // 最大(PI_CHUD_MAX_DIGITS)でコマンド用アリーナに入らない、計算途中の多倍長整数もヒープ
+    p_out[0] = malloc(digits + 3);
+    p_out[1] = malloc(digits + 3);
+    if (p_out[0] == NULL || p_out[1] == NULL) {
+        printf("Error: Out of memory.\n");
+        free(p_out[0]);
+        free(p_out[1]);
+        return;
+    }
+
+    printf("\nCalculating Pi using Chudnovsky binary splitting (%u digits, %u terms):\n",
+            digits, pi_chud_terms(digits));
+    for (int32_t i = 0; i < 2 && is_ok; i++)
+    {
+        is_ok = pi_chud_run(digits, (i == 1), p_out[i], &split_us[i], &total_us[i]);
+    }
+    if (!is_ok) {
+        printf("Error: Out of memory.\n");
+    } else {
+        uint32_t verified = pi_chud_verify(p_out[1], digits);
+        printf("%.52s", p_out[1]);
+        if (digits > 50) {
+            printf("...(last 10: %s)", &p_out[1][digits + 2 - 10]);
+        }
+        printf("\n");
+        for (int32_t i = 0; i < 2; i++)
+        {
+            printf("%s : split %u us, total %u us (%.1f digits/s)\n",
+                    (i == 0) ? "single core" : "dual core  ",
+                    split_us[i], total_us[i], (double)digits * 1000000.0 / (double)total_us[i]);
+        }
+        printf("speedup     : split x%.2f, total x%.2f\n",
+                (double)split_us[0] / (double)split_us[1],
+                (double)total_us[0] / (double)total_us[1]);
+        if (strcmp(p_out[0], p_out[1]) != 0) {
+            printf("verify      : NG (single/dual core results differ)\n");
+        } else if (verified == 0) {
+            printf("verify      : NG (mismatch with known digits)\n");
+        } else {
+            printf("verify      : OK (%u digits checked)\n", verified);
+        }
+    }
+
+    free(p_out[0]);
+    free(p_out[1]);
+}
+
 static void cmd_pi_calc(const dbg_cmd_args_t* p_args)
 {
     int32_t iterations = 3;
     volatile double pi;
+    double pi_prev = 0.0;
+    pi_gl_state_t state;
+
+    if (p_args->argc > 2) {
+        int32_t digits = atoi(p_args->p_argv[2]);
+        if (strcmp(p_args->p_argv[1], "chud") != 0) {
+            printf("Usage: pi [iterations] | pi chud <digits>\n");
+        } else if (digits <= 0 || digits > PI_CHUD_MAX_DIGITS) {
+            printf("Error: Invalid digits. Must be 1-%d.\n", PI_CHUD_MAX_DIGITS);
+        } else {
+            cmd_pi_chud((uint32_t)digits);
+        }
+        return;
+    }
 
     if (p_args->argc > 1) {
+        if (strcmp(p_args->p_argv[1], "chud") == 0) {
+            printf("Usage: pi chud <digits> (1-%d)\n", PI_CHUD_MAX_DIGITS);
+            return;
+        }
         iterations = atoi(p_args->p_argv[1]);
         if (iterations <= 0) {
             printf("Error: Invalid iteration count. Must be positive.\n");
@@ -275,18 +423,25 @@ static void cmd_pi_calc(const dbg_cmd_args_t* p_args)
         }
     }
     printf("\nCalculating Pi using Gauss-Legendre algorithm (%d iterations):\n", iterations);
+    // 反復を1回ずつ進めて各反復の処理時間を計測
+    pi_gauss_legendre_init(&state);
     for (int32_t i = 1; i <= iterations; i++) {
         volatile uint32_t start_time = time_us_32();
-        pi = calculate_pi_gauss_legendre(i);
+        pi = pi_gauss_legendre_step(&state);
         volatile uint32_t end_time = time_us_32();
         printf("Iteration %d: π ≈ %.15f (proc time: %u us)\n", i, pi, end_time - start_time);
+        if (pi == pi_prev) {
+            printf("Converged at double precision limit. Use 'pi chud <digits>' for more digits.\n");
+            break;
+        }
+        pi_prev = pi;
     }
 }
 
 static void cmd_sha(const dbg_cmd_args_t* p_args)
 {
-    uint8_t padding_buf[64 * 2];
-    uint8_t hash_buf[64 * 2];
+    uint8_t *padding_buf;
+    uint8_t *hash_buf;
     size_t padding_len;
 
     if (p_args->argc < 2 || p_args->argc > 2) {
@@ -294,9 +449,6 @@ static void cmd_sha(const dbg_cmd_args_t* p_args)
         return;
     }
 
-    memset(hash_buf, 0, sizeof(hash_buf));
-    memset(padding_buf, 0, sizeof(padding_buf));
-
 #if 1
     char *msg;
     msg = p_args->p_argv[1];
@@ -306,6 +458,14 @@ static void cmd_sha(const dbg_cmd_args_t* p_args)
     const char msg[] = "ABC";                        // SHA256期待値「B5D4045C3F466FA91FE2CC6ABE79232A1A57CDF104F7A26E716E0A1E2789DF78」
 #endif
 
+    // パディング後は最大で 元の長さ + 1 + 8 + 63 バイト(コマンド終了時に解放)
+    padding_buf = mem_arena_calloc(&s_cmd_arena, strlen(msg) + 72, 1);
+    hash_buf = mem_arena_calloc(&s_cmd_arena, 64, 1);
+    if (padding_buf == NULL || hash_buf == NULL) {
+        printf("Error: command arena is full\n");
+        return;
+    }
+
     printf("\nSHA-256 Hash Calc(H/W)\n");
     printf("\nCalc str : %s\n", msg);
     // SHA-256のパディング処理
@@ -333,13 +493,18 @@ static void cmd_rnd(const dbg_cmd_args_t* p_args)
     }
 
     count = atoi(p_args->p_argv[1]);
-    uint32_t rand_buf[count];
-    memset(rand_buf, 0, sizeof(rand_buf));
     if (count <= 0) {
         printf("Error: Invalid count. Must be positive.\n");
         return;
     }
 
+    // コマンド終了時に解放
+    uint32_t *rand_buf = mem_arena_calloc(&s_cmd_arena, (size_t)count, sizeof(uint32_t));
+    if (rand_buf == NULL) {
+        printf("Error: Count too large (max %u).\n", (uint32_t)(DBG_CMD_ARENA_SIZE / sizeof(uint32_t)));
+        return;
+    }
+
     // TRNGで真性乱数を生成
     printf("\nTRANG gen random num cnt:%d\n", count);
     trang_gen_rand_num_u32(rand_buf, count);
@@ -399,287 +564,3923 @@ static void cmd_isqrt(void)
 }
 
 /**
- * @brief タイマーコマンド関数
- * 
- * @param p_args コマンド引数の構造体ポインタ
+ * @brief FFTベンチマークの1サイズ分を実行して結果を表示
+ *
+ * @param log2n log2(N)
+ * @param p_sig 入力信号(実数N点)
+ * @param p_ref_re 参照FFTの実部(作業領域)
+ * @param p_ref_im 参照FFTの虚部(作業領域)
+ * @param p_f32 float32の作業領域
+ * @param p_q15 Q15の作業領域
  */
-static void cmd_timer(const dbg_cmd_args_t* p_args)
+static void fft_bench_size(uint32_t log2n, const float *p_sig, double *p_ref_re, double *p_ref_im,
+                           fft_cpx_f32_t *p_f32, fft_cpx_q15_t *p_q15)
 {
-    if (p_args->argc > 1) {
-        int32_t seconds = atoi(p_args->p_argv[1]);
-        if (seconds <= 0) {
-            printf("Error: Invalid timer duration. Must be positive.\n");
-            return;
-        }
-        if (seconds > TIMER_MAX_SECONDS) {
-            printf("Error: Timer duration exceeds maximum of %d seconds.\n", TIMER_MAX_SECONDS);
-            return;
-        }
+    uint32_t n = 1UL << log2n;
+    // 小さいサイズほど繰り返して計測誤差を減らす
+    uint32_t reps = (FFT_MAX_N * 4) / n;
+    uint32_t proc_us;
+    double snr;
 
-        // 空いているタイマースロットを探す
-        int free_slot = -1;
-        for (int i = 0; i < TIMER_MAX_ALARMS; i++) {
-            if (!s_timer_state[i].is_running) {
-                free_slot = i;
-                break;
-            }
-        }
-
-        if (free_slot == -1) {
-            printf("Error: All %d hardware timers are in use.\n", TIMER_MAX_ALARMS);
-            return;
-        }
+    // 倍精度の参照FFT
+    for (uint32_t i = 0; i < n; i++)
+    {
+        p_ref_re[i] = p_sig[i];
+        p_ref_im[i] = 0.0;
+    }
+    fft_f64_ref(p_ref_re, p_ref_im, log2n);
 
-        // H/Wでアラームを設定（us単位）
-        uint64_t delay_us = seconds * 1000000ULL;
-        alarm_id_t alarm_id = add_alarm_in_us(delay_us, timer_callback, NULL, true);
-        if (alarm_id > 0) {
-            s_timer_state[free_slot].is_running = true;
-            s_timer_state[free_slot].start_time = time_us_32();
-            s_timer_state[free_slot].duration = delay_us;
-            s_timer_state[free_slot].alarm_id = alarm_id;
-            // 利用可能な登録順序から最小のものを使用
-            s_timer_state[free_slot].reg_order = s_available_orders[0];
-            // 使用した登録順序を削除し、残りを前に詰める
-            for (int i = 0; i < s_available_count - 1; i++) {
-                s_available_orders[i] = s_available_orders[i + 1];
+    for (int32_t radix = FFT_RADIX_2; radix <= FFT_RADIX_4; radix++)
+    {
+        // float32
+        proc_us = 0;
+        for (uint32_t r = 0; r < reps; r++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_f32[i].re = p_sig[i];
+                p_f32[i].im = 0.0f;
             }
-            s_available_count--;
-            printf("Timer #%d (alarm as #%d) set for %d seconds.\n",
-                    free_slot + 1, s_timer_state[free_slot].reg_order, seconds);
-        } else {
-            printf("Error: Failed to set timer.\n");
+            volatile uint32_t start_time = time_us_32();
+            fft_f32(p_f32, log2n, (fft_radix_t)radix);
+            volatile uint32_t end_time = time_us_32();
+            proc_us += end_time - start_time;
+            WDT_RST();
         }
-    } else {
-        // 引数なしの場合は現在のタイマー状態を表示
-        bool any_running = false;
-        for (int i = 0; i < TIMER_MAX_ALARMS; i++) {
-            if (s_timer_state[i].is_running) {
-                uint32_t elapsed = time_us_32() - s_timer_state[i].start_time;
-                uint32_t remaining = (elapsed < s_timer_state[i].duration) ?
-                                    (s_timer_state[i].duration - elapsed) : 0;
-                printf("Timer #%d (alarm as #%d): %u seconds remaining.\n",
-                        i + 1, s_timer_state[i].reg_order,
-                       (remaining + 500000) / 1000000);  // 四捨五入
-                any_running = true;
+        snr = fft_snr_db_f32(p_ref_re, p_ref_im, p_f32, n);
+        printf("%4u  f32 radix-%d   %10.1f us  SNR %6.1f dB\n",
+                n, (radix == FFT_RADIX_2) ? 2 : 4, (double)proc_us / reps, snr);
+
+        // Q15(出力は1/Nスケール)
+        proc_us = 0;
+        for (uint32_t r = 0; r < reps; r++)
+        {
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_q15[i].re = (int16_t)lroundf(p_sig[i] * 32767.0f);
+                p_q15[i].im = 0;
             }
+            volatile uint32_t start_time = time_us_32();
+            fft_q15(p_q15, log2n, (fft_radix_t)radix);
+            volatile uint32_t end_time = time_us_32();
+            proc_us += end_time - start_time;
+            WDT_RST();
         }
-        if (!any_running) {
-            printf("No timers are running.\n");
-        }
+        snr = fft_snr_db_q15(p_ref_re, p_ref_im, p_q15, n, (double)n / 32767.0);
+        printf("%4u  q15 radix-%d   %10.1f us  SNR %6.1f dB\n",
+                n, (radix == FFT_RADIX_2) ? 2 : 4, (double)proc_us / reps, snr);
+    }
+
+    // 実数入力FFT(X[0]～X[N/2])
+    proc_us = 0;
+    for (uint32_t r = 0; r < reps; r++)
+    {
+        volatile uint32_t start_time = time_us_32();
+        fft_f32_real(p_sig, p_f32, log2n);
+        volatile uint32_t end_time = time_us_32();
+        proc_us += end_time - start_time;
+        WDT_RST();
     }
+    snr = fft_snr_db_f32(p_ref_re, p_ref_im, p_f32, n / 2 + 1);
+    printf("%4u  f32 real      %10.1f us  SNR %6.1f dB\n", n, (double)proc_us / reps, snr);
 }
 
 /**
- * @brief GPIO制御コマンド関数
- * 
+ * @brief FFTベンチマークコマンド関数
+ *
  * @param p_args コマンド引数の構造体ポインタ
  */
-static void cmd_gpio(const dbg_cmd_args_t* p_args)
+static void cmd_fft(const dbg_cmd_args_t* p_args)
 {
-    if (p_args->argc != 3) {
-        printf("Error: Invalid number of arguments. Usage: gpio <pin> <value>\n\n");
-        return;
+    uint32_t log2n_min = FFT_MIN_LOG2N;
+    uint32_t log2n_max = FFT_MAX_LOG2N;
+
+    if (p_args->argc > 1) {
+        int32_t n = atoi(p_args->p_argv[1]);
+        uint32_t log2n = 0;
+        // 範囲を先に確かめる(大きなnでシフトが溢れないように)
+        if (n <= 0 || (uint32_t)n > FFT_MAX_N) {
+            printf("Error: FFT size must be a power of 2 (%lu-%lu)\n", FFT_MIN_N, FFT_MAX_N);
+            return;
+        }
+        while ((1UL << log2n) < (uint32_t)n && log2n < FFT_MAX_LOG2N)
+        {
+            log2n++;
+        }
+        if ((1UL << log2n) != (uint32_t)n || log2n < FFT_MIN_LOG2N) {
+            printf("Error: FFT size must be a power of 2 (%lu-%lu)\n", FFT_MIN_N, FFT_MAX_N);
+            return;
+        }
+        log2n_min = log2n;
+        log2n_max = log2n;
     }
 
-    // コマンドからGPIOのピン番号とピンの値を取得
-    uint8_t pin = atoi(p_args->p_argv[1]);
-    uint8_t value = atoi(p_args->p_argv[2]);
+    // 4096点で128KBになり、コマンド用アリーナに入らないのでヒープから
+    uint32_t n_max = 1UL << log2n_max;
+    float *p_sig = malloc(n_max * sizeof(float));
+    double *p_ref_re = malloc(n_max * sizeof(double));
+    double *p_ref_im = malloc(n_max * sizeof(double));
+    fft_cpx_f32_t *p_f32 = malloc(n_max * sizeof(fft_cpx_f32_t));
+    fft_cpx_q15_t *p_q15 = malloc(n_max * sizeof(fft_cpx_q15_t));
 
-    // GPIOのピン番号チェック
-    if (pin < 0 || pin > GPIO_PIN_NUM_MAX) {
-        printf("Error: Invalid GPIO pin number. Must be between 0 and %d.\n\n", GPIO_PIN_NUM_MAX);
-        return;
+    if (p_sig == NULL || p_ref_re == NULL || p_ref_im == NULL || p_f32 == NULL || p_q15 == NULL) {
+        printf("Error: Out of memory.\n");
+    } else {
+        fft_init();
+        printf("\nFFT Benchmark (time per transform, SNR vs double reference):\n");
+        for (uint32_t log2n = log2n_min; log2n <= log2n_max; log2n++)
+        {
+            uint32_t n = 1UL << log2n;
+            // 振動解析を想定した2トーン+微小ノイズ(LCGで再現性あり)
+            uint32_t lcg = 12345;
+            for (uint32_t i = 0; i < n; i++)
+            {
+                lcg = lcg * 1664525UL + 1013904223UL;
+                float noise = ((float)(lcg >> 8) / 16777216.0f - 0.5f) * 0.01f;
+                p_sig[i] = 0.5f * sinf(2.0f * (float)M_PI * 5.3f * (float)i / (float)n)
+                         + 0.25f * cosf(2.0f * (float)M_PI * 17.0f * (float)i / (float)n)
+                         + noise;
+            }
+            fft_bench_size(log2n, p_sig, p_ref_re, p_ref_im, p_f32, p_q15);
+        }
     }
 
-    // Low/High以外は受け付けない
-    if (value != 0 && value != 1) {
-        printf("Error: Invalid GPIO value. Must be 0 or 1.\n\n");
-        return;
-    }
+    free(p_sig);
+    free(p_ref_re);
+    free(p_ref_im);
+    free(p_f32);
+    free(p_q15);
+}
 
-    // GPIOの初期化と設定
-    gpio_init(pin);
-    gpio_set_dir(pin, GPIO_OUT);
+// membench: 計測関数の型(memcpy/memset互換)
+typedef void *(*membench_copy_func_t)(void *p_dst, const void *p_src, size_t len);
+typedef void *(*membench_fill_func_t)(void *p_dst, int val, size_t len);
 
-    // GPIO操作の処理時間を計測
-    volatile uint32_t start_time = time_us_32();
-    gpio_put(pin, value);
-    volatile uint32_t end_time = time_us_32();
+// membench: Core0で実行するSTREAMジョブ
+typedef struct {
+    membench_stream_t stream;
+    membench_kernel_t kernel;
+    uint32_t reps;
+} membench_job_t;
+
+// membench: SCRATCH X/Y(4KB)はスタックと共用なので小さいバッファのみ置く
+static uint32_t __scratch_x("membench") s_membench_scratch_x[2][MEMBENCH_REGION_SIZE / 4];
+static uint32_t __scratch_y("membench") s_membench_scratch_y[2][MEMBENCH_REGION_SIZE / 4];
+static uint32_t s_membench_dma_ch;        // DMAサービスから借りたチャネル(計測中だけ)
+static uint32_t s_membench_fill_word;
 
-    printf("GPIO %d set to %d (proc time: %u us)\n\n", pin, value, end_time - start_time);
+// DMAでのmemcpy(32bit転送、ワードアライン前提)
+static void *membench_dma_memcpy(void *p_dst, const void *p_src, size_t len)
+{
+    dma_channel_config c = dma_channel_get_default_config(s_membench_dma_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(s_membench_dma_ch, &c, p_dst, p_src, len / 4, true);
+    dma_channel_wait_for_finish_blocking(s_membench_dma_ch);
+
+    return p_dst;
+}
+
+// DMAでのmemset(転送元アドレス固定)
+static void *membench_dma_memset(void *p_dst, int val, size_t len)
+{
+    s_membench_fill_word = (uint8_t)val * 0x01010101UL;
+    dma_channel_config c = dma_channel_get_default_config(s_membench_dma_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(s_membench_dma_ch, &c, p_dst, &s_membench_fill_word, len / 4, true);
+    dma_channel_wait_for_finish_blocking(s_membench_dma_ch);
+
+    return p_dst;
 }
 
 /**
- * @brief コマンドを履歴に追加する関数
- * 
- * @param p_cmd 追加するコマンド
+ * @brief コピー帯域を計測(1回あたりコピーしたバイト数で計算)
+ * @note 1回目はウォームアップ(XIPキャッシュのフィル等)で計測対象外
+ *
+ * @return float MB/s(コピー結果が一致しない場合は負値)
  */
-static void add_to_cmd_history(const char* p_cmd)
+static float membench_copy_mbps(membench_copy_func_t func, void *p_dst, const void *p_src, uint32_t len)
 {
-    // 履歴を1つずつ下にずらす
-    for (int32_t i = CMD_HISTORY_MAX - 1; i > 0; i--) {
-        strcpy(s_cmd_history[i], s_cmd_history[i - 1]);
-    }
+    uint32_t reps = (MEMBENCH_XFER_BYTES + len - 1) / len;
 
-    // 新しいコマンドを追加
-    strncpy(s_cmd_history[0], p_cmd, DBG_CMD_MAX_LEN - 1);
-    s_cmd_history[0][DBG_CMD_MAX_LEN - 1] = '\0';
+    func(p_dst, p_src, len);
+    volatile uint32_t start_time = time_us_32();
+    for (uint32_t r = 0; r < reps; r++)
+    {
+        func(p_dst, p_src, len);
+    }
+    volatile uint32_t end_time = time_us_32();
+    WDT_RST();
 
-    // 履歴数を更新（最大値で制限）
-    if (s_history_count < CMD_HISTORY_MAX) {
-        s_history_count++;
+    if (memcmp(p_dst, p_src, len) != 0) {
+        return -1.0f;
     }
 
-    // 履歴位置をリセット
-    s_history_pos = -1;
+    return membench_mbps((uint64_t)len * reps, end_time - start_time);
 }
 
 /**
- * @brief デバッグコマンドモニターの初期化
+ * @brief フィル帯域を計測
+ *
+ * @return float MB/s(書き込み結果が一致しない場合は負値)
  */
-void dbg_com_init(void)
+static float membench_fill_mbps(membench_fill_func_t func, void *p_dst, uint32_t len)
 {
-    cmd_help();
+    uint32_t reps = (MEMBENCH_XFER_BYTES + len - 1) / len;
+    const uint8_t *p_chk = (const uint8_t *)p_dst;
+
+    func(p_dst, 0, len);
+    volatile uint32_t start_time = time_us_32();
+    for (uint32_t r = 0; r < reps; r++)
+    {
+        func(p_dst, (int)(r & 0xFF), len);
+    }
+    volatile uint32_t end_time = time_us_32();
+    WDT_RST();
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (p_chk[i] != (uint8_t)((reps - 1) & 0xFF)) {
+            return -1.0f;
+        }
+    }
+
+    return membench_mbps((uint64_t)len * reps, end_time - start_time);
 }
 
-/**
- * @brief コマンド文字列を解析してコマンド種類を返す
- * 
- * @param p_cmd_str コマンド文字列
- * @param p_args 引数構造体
- * @return dbg_cmd_t コマンド種類
- */
-static dbg_cmd_t dbg_com_parse_cmd(const char* p_cmd_str, dbg_cmd_args_t* p_args)
+// MB/sを表示(負値は検証NG)
+static void membench_print_mbps(float mbps)
 {
-    for (int32_t i = 0; s_cmd_table[i].p_cmd_str != NULL; i++) {
-        if (strcmp(p_cmd_str, s_cmd_table[i].p_cmd_str) == 0) {
-            // 引数の数をチェック
-            if (p_args->argc - 1 < s_cmd_table[i].min_args || p_args->argc - 1 > s_cmd_table[i].max_args) {
-                printf("Error: Invalid number of arguments. Expected %d-%d, got %d\n",
-                    s_cmd_table[i].min_args, s_cmd_table[i].max_args, p_args->argc - 1);
-                return CMD_UNKNOWN;
-            }
-            return s_cmd_table[i].cmd_type;
-        }
+    if (mbps < 0.0f) {
+        printf("  %8s", "NG");
+    } else {
+        printf("  %8.1f", (double)mbps);
+    }
+}
+
+// Core0側のジョブ関数(Core1からも直接呼ぶ)
+static void membench_core0_job(void *p_arg)
+{
+    membench_job_t *p_job = (membench_job_t *)p_arg;
+
+    for (uint32_t r = 0; r < p_job->reps; r++)
+    {
+        membench_stream_run(&p_job->stream, p_job->kernel);
     }
-    return CMD_UNKNOWN;
 }
 
 /**
- * @brief コマンドを実行する
- * 
- * @param cmd コマンド種類
- * @param p_args 引数構造体
+ * @brief STREAMカーネルのシングルコア/デュアルコア帯域
+ * @note デュアルコアは各コアが別の配列(ヒープ=ストライプSRAM)で同じカーネルを同時実行
+ *
+ * @param n 1コアあたりの配列の要素数
  */
-static void dbg_com_execute_cmd(dbg_cmd_t cmd, const dbg_cmd_args_t* p_args)
+static void membench_stream(uint32_t n)
 {
-    switch (cmd) {
-        case CMD_HELP:
-            cmd_help();
-            break;
+    static membench_job_t s_job[2];
+    float *p_buf[2] = {NULL, NULL};
+    bool is_ok = true;
 
-        case CMD_VER:
-            cmd_ver();
-            break;
+    if (app_core_0_job_is_busy()) {
+        printf("Error: CPU Core0 is busy.\n");
+        return;
+    }
 
-        case CMD_SYSTEM:
-            cmd_system();
-            break;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        // 1コア48KB～(コマンド用アリーナに入らない)、ヒープ=ストライプSRAMを測る
+        p_buf[i] = malloc(3 * n * sizeof(float));
+        if (p_buf[i] == NULL) {
+            printf("Error: Out of memory.\n");
+            free(p_buf[0]);
+            return;
+        }
+        s_job[i].stream.p_a = &p_buf[i][0];
+        s_job[i].stream.p_b = &p_buf[i][n];
+        s_job[i].stream.p_c = &p_buf[i][2 * n];
+        s_job[i].stream.n = n;
+        s_job[i].reps = MEMBENCH_STREAM_REPS;
+        membench_stream_init(&s_job[i].stream);
+    }
 
-        case CMD_AT_TEST:
-            cmd_at_test();
-            break;
+    printf("\nSTREAM (SRAM heap, %u floats x 3 arrays per core, MB/s = bytes read + written):\n", n);
+    printf("kernel       1 core    2 cores  scaling\n");
+    for (uint32_t k = 0; k < MEMBENCH_KERNEL_NUM; k++)
+    {
+        uint64_t bytes = (uint64_t)membench_kernel_bytes((membench_kernel_t)k, n) * MEMBENCH_STREAM_REPS;
+        s_job[0].kernel = (membench_kernel_t)k;
+        s_job[1].kernel = (membench_kernel_t)k;
 
-        case CMD_PI_CALC:
-            cmd_pi_calc(p_args);
-            break;
+        // シングルコア
+        volatile uint32_t start_time = time_us_32();
+        membench_core0_job(&s_job[0]);
+        volatile uint32_t end_time = time_us_32();
+        float mbps_1 = membench_mbps(bytes, end_time - start_time);
 
-        case CMD_TRIG:
+        // デュアルコア(Core0: s_job[1], Core1: s_job[0])
+        start_time = time_us_32();
+        app_core_0_job_start(membench_core0_job, &s_job[1]);
+        membench_core0_job(&s_job[0]);
+        app_core_0_job_wait();
+        end_time = time_us_32();
+        float mbps_2 = membench_mbps(bytes * 2, end_time - start_time);
+        WDT_RST();
+
+        printf("%-8s  %9.1f  %9.1f    x%.2f\n", membench_kernel_name((membench_kernel_t)k),
+                (double)mbps_1, (double)mbps_2, (double)(mbps_2 / mbps_1));
+
+        // copy～triadの結果を検証(memcpy/memsetの前)
+        if (k == MEMBENCH_TRIAD) {
+            is_ok = membench_stream_check(&s_job[0].stream, 1)
+                 && membench_stream_check(&s_job[1].stream, 1);
+        }
+    }
+    printf("verify: %s\n", is_ok ? "OK" : "NG");
+
+    free(p_buf[0]);
+    free(p_buf[1]);
+}
+
+/**
+ * @brief memcpy/memsetのサイズ別・アライメント別帯域(libc vs fast_mem vs DMA)
+ */
+static void membench_copy(void)
+{
+    static const uint32_t s_size_tbl[] = {64, 256, 1024, 4096, MEMBENCH_COPY_MAX};
+    // 2×16KBはコマンド用アリーナに入らないのでヒープから
+    uint8_t *p_src = malloc(MEMBENCH_COPY_MAX + 4);
+    uint8_t *p_dst = malloc(MEMBENCH_COPY_MAX + 4);
+
+    if (p_src == NULL || p_dst == NULL) {
+        printf("Error: Out of memory.\n");
+        free(p_src);
+        free(p_dst);
+        return;
+    }
+    for (uint32_t i = 0; i < MEMBENCH_COPY_MAX + 4; i++)
+    {
+        p_src[i] = (uint8_t)(i * 7 + 1);
+    }
+
+#ifdef FAST_MEM_WRAP_LIBC
+    printf("\nNote: libc memcpy/memset are wrapped to fast_mem (FAST_MEM_WRAP_LIBC).\n");
+#endif
+    printf("\nmemcpy/memset (SRAM heap, MB/s = bytes copied or written):\n");
+    printf(" size  libc cpy  fast cpy   dma cpy  libc set  fast set   dma set\n");
+    for (uint32_t i = 0; i < sizeof(s_size_tbl) / sizeof(s_size_tbl[0]); i++)
+    {
+        uint32_t len = s_size_tbl[i];
+        printf("%5u", len);
+        membench_print_mbps(membench_copy_mbps(memcpy, p_dst, p_src, len));
+        membench_print_mbps(membench_copy_mbps(fast_memcpy, p_dst, p_src, len));
+        membench_print_mbps(membench_copy_mbps(membench_dma_memcpy, p_dst, p_src, len));
+        membench_print_mbps(membench_fill_mbps(memset, p_dst, len));
+        membench_print_mbps(membench_fill_mbps(fast_memset, p_dst, len));
+        membench_print_mbps(membench_fill_mbps(membench_dma_memset, p_dst, len));
+        printf("\n");
+    }
+
+    printf("\nalignment (%u bytes, MB/s):\n", MEMBENCH_ALIGN_SIZE);
+    printf("src dst  libc cpy  fast cpy  libc set  fast set\n");
+    for (uint32_t src_ofs = 0; src_ofs < 4; src_ofs += 2)
+    {
+        for (uint32_t dst_ofs = 0; dst_ofs < 4; dst_ofs++)
+        {
+            printf(" +%u  +%u", src_ofs, dst_ofs);
+            membench_print_mbps(membench_copy_mbps(memcpy, &p_dst[dst_ofs], &p_src[src_ofs], MEMBENCH_ALIGN_SIZE));
+            membench_print_mbps(membench_copy_mbps(fast_memcpy, &p_dst[dst_ofs], &p_src[src_ofs], MEMBENCH_ALIGN_SIZE));
+            membench_print_mbps(membench_fill_mbps(memset, &p_dst[dst_ofs], MEMBENCH_ALIGN_SIZE));
+            membench_print_mbps(membench_fill_mbps(fast_memset, &p_dst[dst_ofs], MEMBENCH_ALIGN_SIZE));
+            printf("\n");
+        }
+    }
+
+    free(p_src);
+    free(p_dst);
+}
+
+/**
+ * @brief メモリ領域別のコピー帯域(CPU vs DMA)
+ * @note XIPはフラッシュ先頭(F/Wイメージ)を読み出す
+ */
+static void membench_region(void)
+{
+    uint32_t *p_sram = mem_arena_alloc(&s_cmd_arena, 2 * MEMBENCH_REGION_SIZE);
+    const struct {
+        const char *p_name;
+        void *p_dst;
+        const void *p_src;
+    } region_tbl[] = {
+        {"SRAM       -> SRAM",      p_sram,                     (uint8_t *)p_sram + MEMBENCH_REGION_SIZE},
+        {"SCRATCH_X  -> SCRATCH_X", s_membench_scratch_x[0],    s_membench_scratch_x[1]},
+        {"SCRATCH_Y  -> SCRATCH_Y", s_membench_scratch_y[0],    s_membench_scratch_y[1]},
+        {"SCRATCH_X  -> SRAM",      p_sram,                     s_membench_scratch_x[1]},
+        {"SRAM       -> SCRATCH_Y", s_membench_scratch_y[0],    (uint8_t *)p_sram + MEMBENCH_REGION_SIZE},
+        {"XIP cached -> SRAM",      p_sram,                     (const void *)XIP_BASE},
+        {"XIP nocache-> SRAM",      p_sram,                     (const void *)XIP_NOCACHE_NOALLOC_BASE},
+    };
+
+    if (p_sram == NULL) {
+        printf("Error: Out of memory.\n");
+        return;
+    }
+    fast_memset(s_membench_scratch_x, 0x5A, sizeof(s_membench_scratch_x));
+    fast_memset(s_membench_scratch_y, 0xA5, sizeof(s_membench_scratch_y));
+    fast_memset(p_sram, 0x3C, 2 * MEMBENCH_REGION_SIZE);
+
+    printf("\nregion (%u bytes, MB/s = bytes copied):\n", MEMBENCH_REGION_SIZE);
+    printf("src -> dst                libc cpy  fast cpy   dma cpy\n");
+    for (uint32_t i = 0; i < sizeof(region_tbl) / sizeof(region_tbl[0]); i++)
+    {
+        printf("%-24s", region_tbl[i].p_name);
+        membench_print_mbps(membench_copy_mbps(memcpy, region_tbl[i].p_dst, region_tbl[i].p_src, MEMBENCH_REGION_SIZE));
+        membench_print_mbps(membench_copy_mbps(fast_memcpy, region_tbl[i].p_dst, region_tbl[i].p_src, MEMBENCH_REGION_SIZE));
+        membench_print_mbps(membench_copy_mbps(membench_dma_memcpy, region_tbl[i].p_dst, region_tbl[i].p_src, MEMBENCH_REGION_SIZE));
+        printf("\n");
+    }
+}
+
+/**
+ * @brief メモリ帯域ベンチマークコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_membench(const dbg_cmd_args_t* p_args)
+{
+    const char *p_mode = (p_args->argc > 1) ? p_args->p_argv[1] : "all";
+    uint32_t n = MEMBENCH_STREAM_N_DEF;
+    bool is_all = (strcmp(p_mode, "all") == 0);
+
+    if (p_args->argc > 2) {
+        int32_t val = atoi(p_args->p_argv[2]);
+        if (val < 64 || val > MEMBENCH_STREAM_N_MAX) {
+            printf("Error: Invalid array size. Must be 64-%d.\n", MEMBENCH_STREAM_N_MAX);
+            return;
+        }
+        n = (uint32_t)val;
+    }
+    if (!is_all && strcmp(p_mode, "stream") != 0 && strcmp(p_mode, "copy") != 0
+        && strcmp(p_mode, "region") != 0) {
+        printf("Usage: membench [all|stream|copy|region] [n]\n");
+        return;
+    }
+
+    // 1回ごとのジョブの受付を測らないよう、チャネルを借りて直接設定する
+    if (!dma_svc_ch_acquire(&s_membench_dma_ch)) {
+        printf("Error: No free DMA channel.\n");
+        return;
+    }
+
+    if (is_all || strcmp(p_mode, "stream") == 0) {
+        membench_stream(n);
+    }
+    if (is_all || strcmp(p_mode, "copy") == 0) {
+        membench_copy();
+    }
+    if (is_all || strcmp(p_mode, "region") == 0) {
+        membench_region();
+    }
+
+    dma_svc_ch_release(s_membench_dma_ch);
+}
+
+// dma test: 完了コールバックで記録する値
+static volatile uint32_t s_dma_test_cb_cnt;
+static volatile uint32_t s_dma_test_cb_us;
+
+static void dma_test_callback(dma_svc_status_t status, void *p_arg)
+{
+    (void)p_arg;
+    if (status == DMA_SVC_OK) {
+        s_dma_test_cb_us = time_us_32();
+        s_dma_test_cb_cnt++;
+    }
+}
+
+// dma test: 結果を1行表示
+static void dma_test_print(const char *p_name, bool is_ok, uint32_t proc_us)
+{
+    printf("  %-28s %s  (%u us)\n", p_name, is_ok ? "OK" : "NG", proc_us);
+}
+
+/**
+ * @brief DMAサービスの動作確認(memcpy/memset/スキャッタギャザー/リング/キューイング)
+ */
+static void dma_test(void)
+{
+    uint8_t *p_src = mem_arena_alloc(&s_cmd_arena, DMA_TEST_SIZE);
+    uint8_t *p_dst = mem_arena_alloc(&s_cmd_arena, DMA_TEST_SIZE);
+    dma_svc_handle_t handle;
+    bool is_ok;
+
+    if (p_src == NULL || p_dst == NULL) {
+        printf("Error: Out of memory.\n");
+        return;
+    }
+    for (uint32_t i = 0; i < DMA_TEST_SIZE; i++)
+    {
+        p_src[i] = (uint8_t)(i * 13 + 7);
+    }
+
+    printf("\nDMA service test (%u bytes):\n", DMA_TEST_SIZE);
+
+    // 非同期memcpy(完了コールバック)
+    memset(p_dst, 0, DMA_TEST_SIZE);
+    s_dma_test_cb_cnt = 0;
+    volatile uint32_t start_time = time_us_32();
+    handle = dma_svc_memcpy_async(p_dst, p_src, DMA_TEST_SIZE, dma_test_callback, NULL);
+    dma_svc_wait(handle);
+    while (s_dma_test_cb_cnt == 0 && handle != DMA_SVC_HANDLE_INVALID)
+    {
+        NOP();
+    }
+    is_ok = (handle != DMA_SVC_HANDLE_INVALID) && (memcmp(p_dst, p_src, DMA_TEST_SIZE) == 0);
+    dma_test_print("memcpy (callback)", is_ok, s_dma_test_cb_us - start_time);
+
+    // 非同期memset(ハンドルで完了待ち)
+    start_time = time_us_32();
+    handle = dma_svc_memset_async(p_dst, 0xA5, DMA_TEST_SIZE, NULL, NULL);
+    dma_svc_wait(handle);
+    volatile uint32_t end_time = time_us_32();
+    is_ok = (handle != DMA_SVC_HANDLE_INVALID);
+    for (uint32_t i = 0; i < DMA_TEST_SIZE && is_ok; i++)
+    {
+        is_ok = (p_dst[i] == 0xA5);
+    }
+    dma_test_print("memset (wait)", is_ok, end_time - start_time);
+
+    // スキャッタギャザー(4つの断片を連続領域に集める、アライメント混在)
+    static const uint32_t s_frag_tbl[][2] = {{0, 1000}, {2001, 501}, {1024, 27}, {3000, 544}};
+    dma_svc_sg_t sg[4];
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        sg[i].p_dst = &p_dst[pos];
+        sg[i].p_src = &p_src[s_frag_tbl[i][0]];
+        sg[i].len = s_frag_tbl[i][1];
+        pos += s_frag_tbl[i][1];
+    }
+    memset(p_dst, 0, DMA_TEST_SIZE);
+    start_time = time_us_32();
+    handle = dma_svc_sg_async(sg, 4, NULL, NULL);
+    dma_svc_wait(handle);
+    end_time = time_us_32();
+    is_ok = (handle != DMA_SVC_HANDLE_INVALID);
+    for (uint32_t i = 0; i < 4 && is_ok; i++)
+    {
+        is_ok = (memcmp(sg[i].p_dst, sg[i].p_src, sg[i].len) == 0);
+    }
+    dma_test_print("scatter-gather (4 blocks)", is_ok, end_time - start_time);
+
+    // リング(読み出し側16byteで折り返してパターンを敷き詰める)
+    dma_svc_xfer_t xfer = {0};
+    xfer.p_dst = p_dst;
+    xfer.p_src = p_src;
+    xfer.size = DMA_SVC_SIZE_32;
+    xfer.count = DMA_TEST_SIZE / 4;
+    xfer.is_read_incr = true;
+    xfer.is_write_incr = true;
+    xfer.dreq = DMA_SVC_DREQ_NONE;
+    xfer.ring_bits = 4;
+    xfer.is_ring_write = false;
+    start_time = time_us_32();
+    handle = dma_svc_submit(&xfer, NULL, NULL);
+    dma_svc_wait(handle);
+    end_time = time_us_32();
+    is_ok = (handle != DMA_SVC_HANDLE_INVALID);
+    for (uint32_t i = 0; i < DMA_TEST_SIZE && is_ok; i++)
+    {
+        is_ok = (p_dst[i] == p_src[i % 16]);
+    }
+    dma_test_print("ring (read, 16 bytes)", is_ok, end_time - start_time);
+
+    // キューイング(チャネル数より多いジョブを一度に投入)
+    dma_svc_handle_t handle_tbl[DMA_TEST_QUEUE_JOBS];
+    uint32_t chunk = DMA_TEST_SIZE / DMA_TEST_QUEUE_JOBS;
+    memset(p_dst, 0, DMA_TEST_SIZE);
+    s_dma_test_cb_cnt = 0;
+    start_time = time_us_32();
+    for (uint32_t i = 0; i < DMA_TEST_QUEUE_JOBS; i++)
+    {
+        handle_tbl[i] = dma_svc_memcpy_async(&p_dst[i * chunk], &p_src[i * chunk], chunk, dma_test_callback, NULL);
+    }
+    is_ok = true;
+    for (uint32_t i = 0; i < DMA_TEST_QUEUE_JOBS; i++)
+    {
+        is_ok = is_ok && (handle_tbl[i] != DMA_SVC_HANDLE_INVALID);
+        dma_svc_wait(handle_tbl[i]);
+    }
+    end_time = time_us_32();
+    while (is_ok && s_dma_test_cb_cnt < DMA_TEST_QUEUE_JOBS)
+    {
+        NOP();
+    }
+    is_ok = is_ok && (memcmp(p_dst, p_src, chunk * DMA_TEST_QUEUE_JOBS) == 0);
+    dma_test_print("queued memcpy (8 jobs)", is_ok, end_time - start_time);
+}
+
+/**
+ * @brief DMAサービスの統計情報を表示
+ */
+static void dma_stat(void)
+{
+    dma_svc_stats_t stats;
+
+    dma_svc_get_stats(&stats);
+    printf("\nDMA service stats:\n");
+    printf("  jobs done      : %u\n", stats.jobs_done);
+    printf("  jobs aborted   : %u\n", stats.jobs_aborted);
+    printf("  submit rejects : %u\n", stats.submit_rejects);
+    printf("  bytes          : %llu\n", stats.bytes);
+    printf("  queue depth    : %u (max %u)\n", stats.queue_depth, stats.queue_depth_max);
+    printf("  wait time      : avg %.1f us, max %u us\n",
+            (stats.jobs_done + stats.jobs_aborted > 0)
+                ? (double)stats.wait_us_total / (double)(stats.jobs_done + stats.jobs_aborted) : 0.0,
+            stats.wait_us_max);
+    printf("  busy time      : %llu us\n", stats.busy_us_total);
+    printf("  channels       : %u busy, %u reserved (pool %u)\n",
+            stats.ch_busy, stats.ch_reserved, DMA_SVC_CH_NUM);
+}
+
+/**
+ * @brief DMAサービスコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_dma(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "stat") == 0) {
+        dma_stat();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        dma_svc_clr_stats();
+        printf("DMA service stats cleared.\n");
+    } else if (strcmp(p_sub, "test") == 0) {
+        dma_test();
+    } else {
+        printf("Usage: dma [stat|clr|test]\n");
+    }
+}
+
+// xip: XIP_CTRLのカウンタ読み出し
+static uint32_t xip_hw_read_hit(void)
+{
+    return xip_ctrl_hw->ctr_hit;
+}
+
+static uint32_t xip_hw_read_acc(void)
+{
+    return xip_ctrl_hw->ctr_acc;
+}
+
+// 書き込みでカウンタがクリアされる
+static void xip_hw_clear(void)
+{
+    xip_ctrl_hw->ctr_hit = 0;
+    xip_ctrl_hw->ctr_acc = 0;
+}
+
+static uint32_t xip_hw_now_us(void)
+{
+    return time_us_32();
+}
+
+static const xip_stat_ops_t s_xip_stat_ops = {
+    .read_hit = xip_hw_read_hit,
+    .read_acc = xip_hw_read_acc,
+    .clear = xip_hw_clear,
+    .now_us = xip_hw_now_us,
+};
+
+/**
+ * @brief ストリーミング読み出し(XIPのストリームFIFOをCPUで読む)
+ * @note キャッシュを通さずにフラッシュから連続読み出しする
+ */
+static uint32_t xip_read_stream(uintptr_t base, uint32_t span, uint32_t reads)
+{
+    uint32_t sum = 0;
+
+    while (reads > 0)
+    {
+        uint32_t words = (reads < span / 4) ? reads : span / 4;
+        while (xip_ctrl_hw->stream_ctr != 0)
+        {
+            NOP();
+        }
+        xip_ctrl_hw->stream_addr = (uint32_t)base;
+        xip_ctrl_hw->stream_ctr = words;
+        for (uint32_t i = 0; i < words; i++)
+        {
+            while ((xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY_BITS) != 0)
+            {
+                NOP();
+            }
+            sum += xip_ctrl_hw->stream_fifo;
+        }
+        reads -= words;
+    }
+
+    return sum;
+}
+
+// xip: フラッシュ/SRAMで実行速度を比較するカーネル(分岐ありのCRC32ビット演算)
+static inline __attribute__((always_inline)) uint32_t xip_kernel_body(uint32_t n)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint32_t x = 0x2545F491UL;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        crc ^= x;
+        for (uint32_t b = 0; b < 8; b++)
+        {
+            if ((crc & 1) != 0) {
+                crc = (crc >> 1) ^ 0xEDB88320UL;
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+
+    return ~crc;
+}
+
+// 同じカーネルをフラッシュ(XIP)とSRAM(.time_critical)に配置
+static __attribute__((noinline)) uint32_t xip_kernel_flash(uint32_t n)
+{
+    return xip_kernel_body(n);
+}
+
+static __attribute__((noinline)) uint32_t __not_in_flash_func(xip_kernel_sram)(uint32_t n)
+{
+    return xip_kernel_body(n);
+}
+
+/**
+ * @brief カーネルの実行時間を計測
+ *
+ * @param func カーネル
+ * @param is_cold trueなら呼び出し毎にXIPキャッシュを無効化
+ * @param p_ctr 計測中のカウンタ差分
+ * @param p_result カーネルの結果
+ * @return uint32_t 合計時間(us)
+ */
+static uint32_t xip_exec_measure(uint32_t (*func)(uint32_t), bool is_cold, xip_ctr_t *p_ctr, uint32_t *p_result)
+{
+    xip_ctr_t before, after;
+    uint32_t proc_us = 0;
+
+    xip_stat_snapshot(&before);
+    for (uint32_t i = 0; i < XIP_EXEC_CALLS; i++)
+    {
+        if (is_cold) {
+            xip_cache_invalidate_all();
+        }
+        volatile uint32_t start_time = time_us_32();
+        *p_result = func(XIP_EXEC_ITERATIONS);
+        volatile uint32_t end_time = time_us_32();
+        proc_us += end_time - start_time;
+    }
+    xip_stat_snapshot(&after);
+    xip_stat_delta(&before, &after, p_ctr);
+    WDT_RST();
+
+    return proc_us;
+}
+
+// xip bench: 1行表示
+static void xip_bench_print(const char *p_alias, const char *p_pattern, uint32_t span,
+                            xip_read_func_t func, uintptr_t base)
+{
+    uint32_t reads = (span / 4) * XIP_BENCH_PASSES;
+    xip_bench_result_t result;
+
+    // 1回目はウォームアップ(キャッシュのフィル)
+    xip_bench_run(func, base, span, span / 4, &result);
+    xip_bench_run(func, base, span, reads, &result);
+    WDT_RST();
+
+    printf("%-9s %-7s %6u KB  %8.2f  %8.1f  %7.2f %%\n", p_alias, p_pattern, span / 1024,
+            (double)xip_bench_mbps(&result), (double)xip_bench_ns_per_read(&result, reads),
+            (double)xip_stat_hit_rate(&result.ctr));
+}
+
+/**
+ * @brief XIPフラッシュ読み出しとコード実行のベンチマーク
+ */
+static void xip_bench(void)
+{
+    static const uint32_t s_span_tbl[] = {XIP_BENCH_SPAN_SMALL, XIP_BENCH_SPAN_LARGE};
+    const char *p_loc_tbl[3] = {"flash (warm)", "flash (cold)", "SRAM"};
+    uint32_t (*func_tbl[3])(uint32_t) = {xip_kernel_flash, xip_kernel_flash, xip_kernel_sram};
+    uint32_t proc_us[3], result[3];
+    xip_ctr_t ctr[3];
+
+    printf("\nXIP flash read (32bit reads, %u passes over span):\n", XIP_BENCH_PASSES);
+    printf("alias     pattern    span      MB/s   ns/read  hit rate\n");
+    for (uint32_t i = 0; i < sizeof(s_span_tbl) / sizeof(s_span_tbl[0]); i++)
+    {
+        uint32_t span = s_span_tbl[i];
+        xip_bench_print("cached", "seq", span, xip_read_seq, XIP_BASE);
+        xip_bench_print("cached", "random", span, xip_read_random, XIP_BASE);
+        xip_bench_print("uncached", "seq", span, xip_read_seq, XIP_NOCACHE_NOALLOC_BASE);
+        xip_bench_print("uncached", "random", span, xip_read_random, XIP_NOCACHE_NOALLOC_BASE);
+        xip_bench_print("stream", "seq", span, xip_read_stream, XIP_BASE);
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        proc_us[i] = xip_exec_measure(func_tbl[i], (i == 1), &ctr[i], &result[i]);
+    }
+    printf("\nCode execution (%u calls x %u iterations):\n", XIP_EXEC_CALLS, XIP_EXEC_ITERATIONS);
+    printf("location       total us   vs SRAM  hit rate   miss\n");
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        printf("%-12s  %9u    x%.2f  %6.2f %%  %6u\n", p_loc_tbl[i], proc_us[i],
+                (double)proc_us[i] / (double)((proc_us[2] > 0) ? proc_us[2] : 1),
+                (double)xip_stat_hit_rate(&ctr[i]), xip_stat_miss(&ctr[i]));
+    }
+    if (result[0] != result[2] || result[1] != result[2]) {
+        printf("verify: NG (flash/SRAM results differ)\n");
+    }
+}
+
+/**
+ * @brief コマンドを実行してXIPキャッシュのヒット率を表示
+ *
+ * @param p_args コマンド引数("xip run <cmd> ..."のまま)
+ */
+static void xip_run(const dbg_cmd_args_t* p_args)
+{
+    dbg_cmd_args_t sub_args;
+    xip_ctr_t before, after, delta;
+    char buf[128];
+
+    // "xip run"の2つを除いた引数で実行
+    dbg_cmd_t cmd = dbg_com_sub_args(p_args, 2, &sub_args);
+    if (cmd == CMD_UNKNOWN) {
+        return;
+    }
+
+    xip_stat_snapshot(&before);
+    volatile uint32_t start_time = time_us_32();
+    dbg_com_execute_cmd(cmd, &sub_args);
+    volatile uint32_t end_time = time_us_32();
+    xip_stat_snapshot(&after);
+
+    xip_stat_delta(&before, &after, &delta);
+    xip_stat_format(buf, sizeof(buf), &delta, end_time - start_time);
+    printf("\n[XIP] %s: %s\n", sub_args.p_argv[0], buf);
+}
+
+/**
+ * @brief XIPキャッシュ統計コマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_xip(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    xip_stat_init(&s_xip_stat_ops);
+
+    if (strcmp(p_sub, "stat") == 0) {
+        xip_ctr_t ctr;
+        xip_stat_snapshot(&ctr);
+        printf("[XIP] since last clear: acc %u, hit %u, miss %u, hit rate %.2f %%\n",
+                ctr.acc, ctr.hit, xip_stat_miss(&ctr), (double)xip_stat_hit_rate(&ctr));
+    } else if (strcmp(p_sub, "clr") == 0) {
+        xip_stat_clear();
+        printf("[XIP] counters cleared.\n");
+    } else if (strcmp(p_sub, "run") == 0 && p_args->argc > 2) {
+        xip_run(p_args);
+    } else if (strcmp(p_sub, "bench") == 0) {
+        xip_bench();
+    } else {
+        printf("Usage: xip [stat|clr|bench|run <cmd> [args...]]\n");
+    }
+}
+
+// ram: リンカスクリプトのシンボル(ビルド種別で無いものは弱参照で0)
+extern char __data_start__[] __attribute__((weak));
+extern char __data_end__[] __attribute__((weak));
+extern char __bss_start__[] __attribute__((weak));
+extern char __bss_end__[] __attribute__((weak));
+extern char __scratch_x_start__[] __attribute__((weak));
+extern char __scratch_x_end__[] __attribute__((weak));
+extern char __scratch_y_start__[] __attribute__((weak));
+extern char __scratch_y_end__[] __attribute__((weak));
+extern char __end__[] __attribute__((weak));
+extern char __HeapLimit[] __attribute__((weak));
+extern char __ram_text_start__[] __attribute__((weak));
+extern char __ram_text_end__[] __attribute__((weak));
+
+// ram: アドレスがどこにあるか
+static const char *ram_addr_location(uintptr_t addr)
+{
+    if (addr >= SRAM_SCRATCH_X_BASE && addr < SRAM_END) {
+        return (addr < SRAM_SCRATCH_Y_BASE) ? "SCRATCH_X" : "SCRATCH_Y";
+    } else if (addr >= SRAM_BASE && addr < SRAM_END) {
+        return "SRAM";
+    } else if (addr >= XIP_BASE && addr < XIP_BASE + 0x10000000UL) {
+        return "XIP flash";
+    }
+
+    return "?";
+}
+
+// ram: セクションを1行表示
+static void ram_print_section(const char *p_name, const char *p_start, const char *p_end)
+{
+    if (p_start == NULL || p_end == NULL) {
+        return;
+    }
+    printf("%-22s 0x%08X  0x%08X  %7u\n", p_name, (uint32_t)p_start, (uint32_t)p_end,
+            (uint32_t)(p_end - p_start));
+}
+
+/**
+ * @brief SRAMに常駐しているコード/データの一覧コマンド関数
+ */
+static void cmd_ram(void)
+{
+#if PICO_COPY_TO_RAM
+    printf("\nBinary type : copy_to_ram (all code runs from SRAM)\n");
+#else
+    printf("\nBinary type : flash (code runs from XIP)\n");
+#endif
+    printf("HOT_FUNC    : %s\n", HOT_PATH_RAM ? "placed in SRAM" : "left in flash");
+
+    printf("\nsection                start       end            size\n");
+    ram_print_section(".text (copy_to_ram)", __ram_text_start__, __ram_text_end__);
+    ram_print_section(".data (+time_critical)", __data_start__, __data_end__);
+    ram_print_section(".bss", __bss_start__, __bss_end__);
+    ram_print_section(".scratch_x", __scratch_x_start__, __scratch_x_end__);
+    ram_print_section(".scratch_y", __scratch_y_start__, __scratch_y_end__);
+    ram_print_section("heap", __end__, __HeapLimit);
+
+    printf("\nHOT_FUNC functions (%u):\n", hot_path_count());
+    printf("name                       address     location\n");
+    for (uint32_t i = 0; i < hot_path_count(); i++)
+    {
+        const hot_path_entry_t *p_entry = hot_path_get(i);
+        // Thumbの関数ポインタはbit0が1
+        uintptr_t addr = (uintptr_t)p_entry->p_addr & ~(uintptr_t)1;
+        printf("%-26s 0x%08X  %s\n", p_entry->p_name, (uint32_t)addr, ram_addr_location(addr));
+    }
+}
+
+// prof: 対象コアのNVICで割り込みを有効/無効にする(Core0はジョブで実行)
+static void prof_core0_job(void *p_arg)
+{
+    prof_hw_irq_enable(*(const bool *)p_arg);
+}
+
+static bool prof_irq_enable_on(uint32_t core, bool is_enable)
+{
+    static bool s_is_enable;
+
+    if (core == get_core_num()) {
+        prof_hw_irq_enable(is_enable);
+        return true;
+    }
+
+    s_is_enable = is_enable;
+    if (!app_core_0_job_start(prof_core0_job, &s_is_enable)) {
+        return false;
+    }
+    app_core_0_job_wait();
+
+    return true;
+}
+
+// prof: サンプリング開始
+static bool prof_start(const prof_hw_config_t *p_config)
+{
+    if (!prof_hw_init()) {
+        printf("[PROF] Error: no free TIMER1 alarm\n");
+        return false;
+    }
+
+    prof_hw_start(p_config);
+    if (!prof_irq_enable_on(p_config->core, true)) {
+        prof_hw_stop();
+        printf("[PROF] Error: core%u is busy\n", p_config->core);
+        return false;
+    }
+
+    return true;
+}
+
+// prof: サンプリング停止
+static void prof_stop(void)
+{
+    prof_hw_config_t config;
+
+    if (!prof_hw_is_running()) {
+        return;
+    }
+    prof_hw_get_config(&config);
+    prof_hw_stop();
+    // Core0がビジーでNVICを落とせなくても、次に割り込みが入った時点でハンドラが自分で無効にする
+    (void)prof_irq_enable_on(config.core, false);
+}
+
+// prof: 統計と上位のPCを表示
+static void prof_stat(void)
+{
+    prof_hw_config_t config;
+    prof_stats_t stats;
+    prof_entry_t top[PROF_TOP_NUM];
+    char buf[48];
+
+    prof_hw_get_config(&config);
+    prof_get_stats(&stats);
+    printf("[PROF] %s, core%u, period %u us, lr %s\n",
+            prof_hw_is_running() ? "running" : "stopped",
+            config.core, config.period_us, config.is_lr ? "on" : "off");
+    printf("[PROF] samples %u, dropped %u, entries %u/%u\n",
+            stats.samples, stats.dropped, stats.used, PROF_HIST_SIZE);
+
+    uint32_t num = prof_top(top, PROF_TOP_NUM);
+    if (num == 0) {
+        return;
+    }
+    printf("\n  pc          lr          samples      %%\n");
+    for (uint32_t i = 0; i < num; i++)
+    {
+        prof_format_entry(buf, sizeof(buf), &top[i]);
+        printf("  %-34s %6.2f\n", buf, (double)top[i].count * 100.0 / (double)stats.samples);
+    }
+    printf("(use 'prof dump' and tools/prof_symbolize.py for function names)\n");
+}
+
+// prof: ホスト側ツール(tools/prof_symbolize.py)向けに全エントリを出力
+static void prof_dump(void)
+{
+    prof_hw_config_t config;
+    prof_stats_t stats;
+    prof_entry_t entry;
+    uint32_t pos = 0;
+    char buf[48];
+
+    if (prof_hw_is_running()) {
+        prof_stop();
+        printf("[PROF] stopped for dump\n");
+    }
+
+    prof_hw_get_config(&config);
+    prof_get_stats(&stats);
+    printf("%s core=%u period_us=%u lr=%u samples=%u dropped=%u\n", PROF_DUMP_BEGIN,
+            config.core, config.period_us, config.is_lr ? 1 : 0, stats.samples, stats.dropped);
+    while (prof_next_entry(&pos, &entry))
+    {
+        prof_format_entry(buf, sizeof(buf), &entry);
+        printf("%s\n", buf);
+    }
+    printf("%s\n", PROF_DUMP_END);
+}
+
+// prof: コマンドを実行している間だけこのコアをプロファイル
+static void prof_run(const dbg_cmd_args_t* p_args)
+{
+    dbg_cmd_args_t sub_args;
+    prof_hw_config_t config = {get_core_num(), PROF_HW_PERIOD_US_DEF, true};
+
+    // "prof run"の2つを除いた引数で実行
+    dbg_cmd_t cmd = dbg_com_sub_args(p_args, 2, &sub_args);
+    if (cmd == CMD_UNKNOWN) {
+        return;
+    }
+
+    prof_stop();
+    prof_clear();
+    if (!prof_start(&config)) {
+        return;
+    }
+    dbg_com_execute_cmd(cmd, &sub_args);
+    prof_stop();
+
+    printf("\n");
+    prof_stat();
+}
+
+/**
+ * @brief サンプリングプロファイラコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_prof(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "start") == 0) {
+        prof_hw_config_t config = {1, PROF_HW_PERIOD_US_DEF, false};
+
+        if (p_args->argc > 2) {
+            config.core = (uint32_t)strtoul(p_args->p_argv[2], NULL, 0);
+        }
+        if (p_args->argc > 3) {
+            config.period_us = (uint32_t)strtoul(p_args->p_argv[3], NULL, 0);
+        }
+        if (p_args->argc > 4) {
+            config.is_lr = (strcmp(p_args->p_argv[4], "lr") == 0);
+        }
+        if (config.core > 1) {
+            printf("Error: core must be 0 or 1\n");
+            return;
+        }
+
+        prof_stop();
+        prof_clear();
+        if (prof_start(&config)) {
+            prof_hw_get_config(&config);
+            printf("[PROF] sampling core%u every %u us%s\n", config.core, config.period_us,
+                    config.is_lr ? " (with LR)" : "");
+        }
+    } else if (strcmp(p_sub, "stop") == 0) {
+        prof_stop();
+        prof_stat();
+    } else if (strcmp(p_sub, "stat") == 0) {
+        prof_stat();
+    } else if (strcmp(p_sub, "dump") == 0) {
+        prof_dump();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        prof_clear();
+        printf("[PROF] samples cleared.\n");
+    } else if (strcmp(p_sub, "run") == 0 && p_args->argc > 2) {
+        prof_run(p_args);
+    } else {
+        printf("Usage: prof [start [core] [period_us] [lr]|stop|stat|dump|clr|run <cmd> [args...]]\n");
+    }
+}
+
+// trace: バッファの状態を表示
+static void trace_stat(void)
+{
+    printf("[TRACE] %s, %u events/core\n", g_is_trace_enabled ? "enabled" : "disabled", TRACE_RING_SIZE);
+    for (uint32_t core = 0; core < TRACE_CORE_NUM; core++)
+    {
+        uint32_t lost;
+        uint32_t num = trace_count(core, &lost);
+        printf("[TRACE] core%u: %u events, %u overwritten\n", core, num, lost);
+    }
+}
+
+// trace: 全コアのバッファを出力(tools/trace2json.py用、イベントはバイナリのまま16進で)
+static void trace_dump(void)
+{
+    bool is_enabled = g_is_trace_enabled;
+    trace_event_t ev[TRACE_DUMP_EVENTS_PER_LINE];
+    char buf[sizeof(ev) * 2 + 1];
+
+    // 出力中のイベントが混ざらないよう止める
+    trace_set_enabled(false);
+
+    printf("%s magic=0x%08X rec=%u ts_hz=1000000 cores=%u\n", TRACE_DUMP_BEGIN,
+            (uint32_t)TRACE_MAGIC, (uint32_t)sizeof(trace_event_t), TRACE_CORE_NUM);
+    for (uint32_t id = 0; id < TRACE_ID_NUM; id++)
+    {
+        printf("# trace id %u %s\n", id, trace_id_name(id));
+    }
+    for (int32_t i = 0; s_cmd_table[i].p_cmd_str != NULL; i++)
+    {
+        printf("# trace cmd %u %s\n", (uint32_t)s_cmd_table[i].cmd_type, s_cmd_table[i].p_cmd_str);
+    }
+
+    for (uint32_t core = 0; core < TRACE_CORE_NUM; core++)
+    {
+        uint32_t lost;
+        uint32_t num = trace_count(core, &lost);
+
+        printf("# trace core %u events=%u lost=%u\n", core, num, lost);
+        for (uint32_t idx = 0; idx < num; idx += TRACE_DUMP_EVENTS_PER_LINE)
+        {
+            uint32_t n = 0;
+            while (n < TRACE_DUMP_EVENTS_PER_LINE && trace_read(core, idx + n, &ev[n]))
+            {
+                n++;
+            }
+            trace_format_hex(buf, sizeof(buf), ev, n * sizeof(trace_event_t));
+            printf("%s\n", buf);
+        }
+    }
+    printf("%s\n", TRACE_DUMP_END);
+
+    trace_set_enabled(is_enabled);
+}
+
+/**
+ * @brief イベントトレースコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_trace(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "start") == 0) {
+        trace_set_enabled(true);
+        printf("[TRACE] enabled.\n");
+    } else if (strcmp(p_sub, "stop") == 0) {
+        trace_set_enabled(false);
+        printf("[TRACE] disabled.\n");
+    } else if (strcmp(p_sub, "clr") == 0) {
+        bool is_enabled = g_is_trace_enabled;
+        trace_set_enabled(false);
+        trace_clear();
+        trace_set_enabled(is_enabled);
+        printf("[TRACE] buffers cleared.\n");
+    } else if (strcmp(p_sub, "stat") == 0) {
+        trace_stat();
+    } else if (strcmp(p_sub, "dump") == 0) {
+        trace_dump();
+    } else {
+        printf("Usage: trace [start|stop|clr|stat|dump]\n");
+    }
+}
+
+// perf: DWT(このコア)とXIP_CTRLのカウンタ読み出し
+static void perf_hw_read(perf_snap_t *p_snap)
+{
+    dwt_ctr_t dwt;
+
+    dwt_read(&dwt);
+    p_snap->us = time_us_32();
+    p_snap->cyc = dwt.cyc;
+    p_snap->cpi = dwt.cpi;
+    p_snap->exc = dwt.exc;
+    p_snap->sleep = dwt.sleep;
+    p_snap->lsu = dwt.lsu;
+    p_snap->fold = dwt.fold;
+    p_snap->is_evt = dwt.is_evt;
+    p_snap->xip_acc = xip_ctrl_hw->ctr_acc;
+    p_snap->xip_hit = xip_ctrl_hw->ctr_hit;
+}
+
+static uint32_t perf_hw_cpu_hz(void)
+{
+    return clock_get_hz(clk_sys);
+}
+
+static const perf_ops_t s_perf_ops = {
+    .read = perf_hw_read,
+    .cpu_hz = perf_hw_cpu_hz,
+};
+
+static bool s_is_perf_enabled = true;   // 全コマンドの前後でカウンタを読むか
+
+// perf: コマンド種類からコマンド名
+static const char *perf_cmd_name(dbg_cmd_t cmd)
+{
+    for (int32_t i = 0; s_cmd_table[i].p_cmd_str != NULL; i++)
+    {
+        if (s_cmd_table[i].cmd_type == cmd) {
+            return s_cmd_table[i].p_cmd_str;
+        }
+    }
+
+    return "?";
+}
+
+// perf: コマンド実行前後の差分を累計に加算(dbg_com_execute_cmd()から呼ばれる)
+static void perf_cmd_account(dbg_cmd_t cmd, const perf_snap_t *p_before)
+{
+    perf_snap_t after;
+    perf_delta_t delta;
+
+    // perf自体は中で実行したコマンドが数えるので除く
+    if (!s_is_perf_enabled || !perf_is_ready() || cmd == CMD_PERF || cmd == CMD_UNKNOWN) {
+        return;
+    }
+    perf_snapshot(&after);
+    perf_delta(p_before, &after, &delta);
+    perf_total_add((uint32_t)cmd, perf_cmd_name(cmd), &delta);
+}
+
+// perf: コマンドごとの累計を表示
+static void perf_top(void)
+{
+    const perf_total_t *p_total_tbl[PERF_TOTAL_MAX];
+    uint32_t num = perf_total_sorted(p_total_tbl, PERF_TOTAL_MAX);
+    uint32_t cpu_hz = clock_get_hz(clk_sys);
+
+    printf("\n[PERF] per-command totals (%s, sorted by cycles)\n", s_is_perf_enabled ? "on" : "off");
+    printf("command     calls    total ms     avg us     max us     Mcycles  active%%  XIP miss/kcyc\n");
+    for (uint32_t i = 0; i < num; i++)
+    {
+        const perf_total_t *p_total = p_total_tbl[i];
+        perf_delta_t sum = {.cyc = p_total->cyc, .us = (uint32_t)p_total->us, .cpu_hz = cpu_hz};
+
+        printf("%-10s %6u %11.3f %10u %10u %11.3f %7.1f %14.3f\n",
+                p_total->p_name, p_total->calls, (double)p_total->us / 1000.0,
+                (uint32_t)(p_total->us / p_total->calls), p_total->max_us,
+                (double)p_total->cyc / 1000000.0, (double)perf_active_rate(&sum) * 100.0,
+                (double)perf_xip_miss_per_kcycle(p_total->xip_miss, p_total->cyc));
+    }
+}
+
+// perf: コマンドを実行してカウンタの差分を表示
+static void perf_run(const dbg_cmd_args_t* p_args)
+{
+    dbg_cmd_args_t sub_args;
+    perf_snap_t before, after;
+    perf_delta_t delta;
+    char buf[320];
+
+    // "perf"を除いた引数で実行
+    dbg_cmd_t cmd = dbg_com_sub_args(p_args, 1, &sub_args);
+    if (cmd == CMD_UNKNOWN) {
+        return;
+    }
+
+    perf_snapshot(&before);
+    dbg_com_execute_cmd(cmd, &sub_args);
+    perf_snapshot(&after);
+
+    perf_delta(&before, &after, &delta);
+    perf_format_delta(buf, sizeof(buf), &delta);
+    printf("\n[PERF] %s (core%u)\n%s", sub_args.p_argv[0], get_core_num(), buf);
+}
+
+/**
+ * @brief H/Wカウンタ(DWT、XIPキャッシュ)コマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_perf(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "";
+
+    if (!perf_is_ready()) {
+        printf("[PERF] Error: DWT cycle counter is not available\n");
+        return;
+    }
+
+    if (strcmp(p_sub, "top") == 0) {
+        perf_top();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        perf_total_clear();
+        printf("[PERF] totals cleared.\n");
+    } else if (strcmp(p_sub, "on") == 0 || strcmp(p_sub, "off") == 0) {
+        s_is_perf_enabled = (strcmp(p_sub, "on") == 0);
+        printf("[PERF] per-command accounting %s.\n", s_is_perf_enabled ? "on" : "off");
+    } else if (p_args->argc > 1) {
+        perf_run(p_args);
+    } else {
+        printf("Usage: perf <cmd> [args...] | perf [top|clr|on|off]\n");
+    }
+}
+
+// mem: スタック、コマンド用アリーナ、プールの使用状況
+static void mem_stat(void)
+{
+    static const char *const s_class_name[MEM_POOL_CLASS_NUM] = {"S", "M", "L"};
+
+    printf("\n[MEM] stack (high-water mark since boot)\n");
+    for (uint32_t core = 0; core < MEM_POOL_CORE_NUM; core++)
+    {
+        mem_hw_stack_t stack;
+        mem_hw_get_stack(core, &stack);
+        if (!stack.is_painted) {
+            printf("  core%u: %u bytes, not painted\n", core, (uint32_t)stack.size);
+            continue;
+        }
+        printf("  core%u: used %5u / %5u bytes (%5.1f %%)\n", core, (uint32_t)stack.used,
+                (uint32_t)stack.size, (double)stack.used * 100.0 / (double)stack.size);
+    }
+
+    printf("\n[MEM] command arena (released after each command)\n");
+    printf("  size %u, in use %u, peak %u, fails %u\n", (uint32_t)s_cmd_arena.size,
+            (uint32_t)s_cmd_arena.used, (uint32_t)s_cmd_arena.peak, s_cmd_arena.fails);
+
+    printf("\n[MEM] block pools (per core)\n");
+    printf("  core class  size  blocks  used  peak  fails  remote frees\n");
+    for (uint32_t core = 0; core < MEM_POOL_CORE_NUM; core++)
+    {
+        for (uint32_t i = 0; i < MEM_POOL_CLASS_NUM; i++)
+        {
+            const mem_pool_t *p_pool = mem_pool_sys_get(core, i);
+            printf("  %4u %5s %5u %7u %5u %5u %6u %13u\n", core, s_class_name[i],
+                    p_pool->block_size, p_pool->block_num, p_pool->used, p_pool->peak,
+                    p_pool->fails, p_pool->remote_frees);
+        }
+    }
+}
+
+// mem bench: 確保したポインタの書き込み先(malloc/freeを最適化で消させない)
+static volatile uintptr_t s_mem_bench_sink;
+
+// mem bench: 確保/解放の関数
+typedef void *(*mem_bench_alloc_t)(size_t size);
+typedef void (*mem_bench_free_t)(void *p);
+
+static void *mem_bench_pool_alloc(size_t size)
+{
+    return mem_pool_alloc(size);
+}
+
+static void mem_bench_pool_free(void *p)
+{
+    mem_pool_free(p);
+}
+
+static void *mem_bench_arena_alloc(size_t size)
+{
+    return mem_arena_alloc(&s_cmd_arena, size);
+}
+
+// アリーナは1回分をまとめて解放するので個別には何もしない
+static void mem_bench_arena_free(void *p)
+{
+    (void)p;
+}
+
+static void *mem_bench_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void mem_bench_free(void *p)
+{
+    free(p);
+}
+
+// mem bench: 1呼び出しあたりのサイクル数(平均と最大)
+typedef struct {
+    uint64_t sum;
+    uint32_t max;
+    uint32_t num;
+} mem_bench_stat_t;
+
+static void mem_bench_stat_add(mem_bench_stat_t *p_stat, uint32_t cyc)
+{
+    p_stat->sum += cyc;
+    p_stat->num++;
+    if (cyc > p_stat->max) {
+        p_stat->max = cyc;
+    }
+}
+
+static double mem_bench_stat_avg(const mem_bench_stat_t *p_stat)
+{
+    return (p_stat->num > 0) ? (double)p_stat->sum / (double)p_stat->num : 0.0;
+}
+
+// mem bench: MEM_BENCH_BURST個確保してから全部解放、をMEM_BENCH_ROUNDS回
+static void mem_bench_run(const char *p_name, uint32_t size, mem_bench_alloc_t alloc_func,
+                          mem_bench_free_t free_func)
+{
+    void *p_block[MEM_BENCH_BURST];
+    mem_bench_stat_t alloc_stat = {0};
+    mem_bench_stat_t free_stat = {0};
+    uint32_t fails = 0;
+
+    for (uint32_t round = 0; round < MEM_BENCH_ROUNDS; round++)
+    {
+        size_t mark = mem_arena_mark(&s_cmd_arena);
+        // 割り込みで最大値がぶれないよう止める
+        uint32_t save = save_and_disable_interrupts();
+
+        for (uint32_t i = 0; i < MEM_BENCH_BURST; i++)
+        {
+            uint32_t start = dwt_get_cycles();
+            p_block[i] = alloc_func(size);
+            mem_bench_stat_add(&alloc_stat, dwt_get_cycles() - start);
+            s_mem_bench_sink = (uintptr_t)p_block[i];
+        }
+        for (uint32_t i = 0; i < MEM_BENCH_BURST; i++)
+        {
+            if (p_block[i] == NULL) {
+                fails++;
+                continue;
+            }
+            uint32_t start = dwt_get_cycles();
+            free_func(p_block[i]);
+            mem_bench_stat_add(&free_stat, dwt_get_cycles() - start);
+        }
+
+        restore_interrupts(save);
+        mem_arena_release(&s_cmd_arena, mark);
+    }
+
+    printf("%5u  %-8s %10.1f %10u %10.1f %10u %6u\n", size, p_name,
+            mem_bench_stat_avg(&alloc_stat), alloc_stat.max,
+            mem_bench_stat_avg(&free_stat), free_stat.max, fails);
+}
+
+// mem bench: プール/アリーナとmalloc/freeの比較
+static void mem_bench(void)
+{
+    static const uint32_t s_size_tbl[] = {MEM_POOL_S_SIZE, MEM_POOL_M_SIZE, MEM_POOL_L_SIZE};
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t start = dwt_get_cycles();
+    uint32_t overhead = dwt_get_cycles() - start;
+    restore_interrupts(save);
+
+    if (!perf_is_ready()) {
+        printf("[MEM] Error: DWT cycle counter is not available\n");
+        return;
+    }
+
+    printf("\n[MEM] alloc/free on core%u: cycles per call, burst of %u x %u rounds, IRQs off\n",
+            get_core_num(), MEM_BENCH_BURST, MEM_BENCH_ROUNDS);
+    printf("      (includes about %u cycles of counter read overhead)\n", overhead);
+    printf(" size  allocator alloc avg  alloc max   free avg   free max  fails\n");
+    for (uint32_t i = 0; i < sizeof(s_size_tbl) / sizeof(s_size_tbl[0]); i++)
+    {
+        mem_bench_run("pool", s_size_tbl[i], mem_bench_pool_alloc, mem_bench_pool_free);
+        mem_bench_run("arena", s_size_tbl[i], mem_bench_arena_alloc, mem_bench_arena_free);
+        mem_bench_run("malloc", s_size_tbl[i], mem_bench_malloc, mem_bench_free);
+    }
+}
+
+/**
+ * @brief メモリ(スタック、アリーナ、プール)コマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "stat") == 0) {
+        mem_stat();
+    } else if (strcmp(p_sub, "bench") == 0) {
+        mem_bench();
+    } else {
+        printf("Usage: mem [stat|bench]\n");
+    }
+}
+
+// timer list: 登録中のタイマー(多いときは先頭のTIMER_LIST_MAX個)
+static void timer_list(void)
+{
+    timer_svc_info_t info;
+    uint32_t pos = 0;
+    uint32_t num = 0;
+
+    while (timer_svc_next(&pos, &info))
+    {
+        if (num == 0) {
+            printf("  id   remain ms   period ms     fired\n");
+        }
+        if (num < TIMER_LIST_MAX) {
+            printf("%4d %11u %11u %9u\n", info.id, (info.remain_us + 500) / 1000,
+                    info.period_us / 1000, info.fired);
+        }
+        num++;
+    }
+
+    if (num == 0) {
+        printf("No timers are running.\n");
+    } else if (num > TIMER_LIST_MAX) {
+        printf("  ... %u more (%u timers)\n", num - TIMER_LIST_MAX, num);
+    }
+}
+
+// timer load <num> <ms>: 回数を数えるだけの周期タイマーをnum個(位相をずらして)登録
+static void timer_load(const dbg_cmd_args_t* p_args)
+{
+    int32_t num = (p_args->argc > 2) ? atoi(p_args->p_argv[2]) : 0;
+    int32_t ms = (p_args->argc > 3) ? atoi(p_args->p_argv[3]) : 0;
+    int32_t added = 0;
+
+    if (num <= 0 || num > TIMER_SVC_MAX || ms <= 0 || (uint32_t)ms > TIMER_SVC_MAX_MS) {
+        printf("Usage: timer load <num> (1-%d) <period ms>\n", TIMER_SVC_MAX);
+        return;
+    }
+
+    for (int32_t i = 0; i < num; i++)
+    {
+        uint32_t delay = 1 + (uint32_t)(((uint64_t)i * (uint32_t)ms) / (uint32_t)num);
+        if (timer_svc_add(delay, (uint32_t)ms, timer_load_callback, NULL) < 0) {
+            break;
+        }
+        added++;
+    }
+    printf("Added %d periodic timers every %d ms (use 'timer stat', 'timer cancel all').\n",
+            added, ms);
+}
+
+// timer stat: タイマーサービスの統計
+static void timer_stat(void)
+{
+    timer_svc_stats_t stats;
+
+    timer_svc_get_stats(&stats);
+    printf("\n[TIMER] wheel: %d levels x %lu slots, tick %d us, max %u ms\n",
+            TW_LEVEL_NUM, (unsigned long)TW_SLOT_NUM, TIMER_SVC_TICK_US, TIMER_SVC_MAX_MS);
+    printf("  active    : %u (peak %u / %d)\n", stats.active, stats.peak, TIMER_SVC_MAX);
+    printf("  fired     : %u (load timers %u)\n", stats.fired, s_timer_load_fired);
+    printf("  late      : avg %.1f us, max %u us (due tick -> callback)\n",
+            (stats.fired > 0) ? (double)stats.late_sum_us / (double)stats.fired : 0.0,
+            stats.late_max_us);
+    printf("  hw alarm  : %u irqs, %u polls\n", stats.irqs, stats.polls);
+    printf("  cascades  : %u, overruns %u\n", stats.cascades, stats.overruns);
+}
+
+// レイテンシの分布(2のべき乗ごと)を棒グラフで表示(jitter、irqlat)
+static void print_latency_hist(const latency_hist_t *p_hist, const char *p_unit)
+{
+    uint32_t max_num = 1;
+
+    for (uint32_t low = 0; low <= p_hist->max; low = (low == 0) ? 2 : low * 2)
+    {
+        uint32_t high = (low == 0) ? 1 : low * 2 - 1;
+        uint32_t num = lh_count_range(p_hist, low, high);
+        if (num > max_num) {
+            max_num = num;
+        }
+        if (low >= 0x80000000UL) {
+            break;
+        }
+    }
+
+    printf("  histogram (%s)\n", p_unit);
+    for (uint32_t low = 0; low <= p_hist->max; low = (low == 0) ? 2 : low * 2)
+    {
+        uint32_t high = (low == 0) ? 1 : low * 2 - 1;
+        uint32_t num = lh_count_range(p_hist, low, high);
+        // 少なくても1つは出してテールを見落とさない
+        uint32_t bar = (num == 0) ? 0 : 1 + (uint32_t)(((uint64_t)num * (JITTER_BAR_WIDTH - 1)) / max_num);
+
+        printf("  %10u - %10u : %8u ", low, high, num);
+        for (uint32_t i = 0; i < bar; i++)
+        {
+            putchar('#');
+        }
+        printf("\n");
+        if (low >= 0x80000000UL) {
+            break;
+        }
+    }
+}
+
+// jitter: 1回計測して表示(is_detailなら分布も)
+static bool jitter_measure(uint32_t rate_hz, uint32_t seconds, jitter_load_t load, bool is_detail)
+{
+    jitter_config_t config = {.rate_hz = rate_hz, .seconds = seconds, .load = load};
+    jitter_result_t *p_result = mem_arena_alloc(&s_cmd_arena, sizeof(jitter_result_t));
+
+    if (p_result == NULL) {
+        printf("Error: command arena is full\n");
+        return false;
+    }
+    if (!jitter_hw_run(&config, p_result)) {
+        printf("Error: Failed to start alarm.\n");
+        return false;
+    }
+
+    const latency_hist_t *p_hist = &p_result->hist;
+    if (is_detail) {
+        printf("\n[JITTER] SDK alarm pool (IRQ on core%u), %u Hz (period %u us) x %u s, core%u load: %s\n",
+                p_result->irq_core, rate_hz, p_result->period_us, seconds, get_core_num(),
+                jitter_load_name(load));
+        printf("  samples   : %u (overruns %u, skipped periods %u)%s\n", p_hist->total,
+                p_result->overruns, p_result->skipped, p_result->is_timeout ? " TIMEOUT" : "");
+        printf("  lateness  : min %u us, mean %.2f us\n", p_hist->min, lh_mean(p_hist));
+        printf("              p50 %u us, p90 %u us, p99 %u us, p99.9 %u us, max %u us\n",
+                lh_percentile(p_hist, 50.0), lh_percentile(p_hist, 90.0), lh_percentile(p_hist, 99.0),
+                lh_percentile(p_hist, 99.9), p_hist->max);
+        print_latency_hist(p_hist, "us");
+    } else {
+        printf("%-6s %9u %7u %7u %7u %7u %8u %9u\n", jitter_load_name(load), p_hist->total,
+                p_hist->min, lh_percentile(p_hist, 50.0), lh_percentile(p_hist, 99.0),
+                p_hist->max, p_result->overruns, p_result->load_loops);
+    }
+
+    return true;
+}
+
+/**
+ * @brief アラームのジッタ計測コマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_jitter(const dbg_cmd_args_t* p_args)
+{
+    int32_t rate_hz = (p_args->argc > 1) ? atoi(p_args->p_argv[1]) : JITTER_RATE_DEF;
+    int32_t seconds = (p_args->argc > 2) ? atoi(p_args->p_argv[2]) : JITTER_SEC_DEF;
+    jitter_load_t load = JITTER_LOAD_IDLE;
+
+    if (rate_hz < JITTER_RATE_MIN || rate_hz > JITTER_RATE_MAX ||
+        seconds < 1 || seconds > JITTER_SEC_MAX) {
+        printf("Usage: jitter [hz (%d-%d)] [sec (1-%d)] [idle|mem|flash]\n",
+                JITTER_RATE_MIN, JITTER_RATE_MAX, JITTER_SEC_MAX);
+        return;
+    }
+
+    if (p_args->argc > 3) {
+        if (!jitter_parse_load(p_args->p_argv[3], &load)) {
+            printf("Error: Unknown load '%s' (idle|mem|flash)\n", p_args->p_argv[3]);
+            return;
+        }
+        jitter_measure((uint32_t)rate_hz, (uint32_t)seconds, load, true);
+        return;
+    }
+
+    // 負荷を指定しなければ同じ条件で全部の負荷を順に計測
+    printf("\n[JITTER] SDK alarm pool, %d Hz x %d s per load, lateness in us\n", rate_hz, seconds);
+    printf("load     samples     min     p50     p99     max overruns     loops\n");
+    for (uint32_t i = 0; i < JITTER_LOAD_NUM; i++)
+    {
+        size_t mark = mem_arena_mark(&s_cmd_arena);
+        bool is_ok = jitter_measure((uint32_t)rate_hz, (uint32_t)seconds, (jitter_load_t)i, false);
+        mem_arena_release(&s_cmd_arena, mark);
+        if (!is_ok) {
+            break;
+        }
+    }
+}
+
+// irqlat: Core0で計測するジョブ
+typedef struct {
+    const irq_lat_hw_config_t *p_config;
+    irq_lat_stats_t *p_stats;
+    volatile bool is_done;
+} irqlat_job_t;
+
+static volatile bool s_is_irqlat_load_stop = false;
+
+static void irqlat_core0_job(void *p_arg)
+{
+    irqlat_job_t *p_job = (irqlat_job_t *)p_arg;
+
+    irq_lat_hw_run(p_job->p_config, p_job->p_stats);
+    p_job->is_done = true;
+}
+
+// irqlat: 計測していないコアの負荷(SRAMのmemcpy)
+static void irqlat_load_core0_job(void *p_arg)
+{
+    uint32_t pos = 0;
+    (void)p_arg;
+
+    while (!s_is_irqlat_load_stop)
+    {
+        jitter_hw_load_step(JITTER_LOAD_MEM, &pos);
+    }
+}
+
+// irqlat: coreで1構成分を計測(もう一方のコアはis_busyなら負荷、でなければ待つだけ)
+static bool irqlat_measure(uint32_t core, bool is_busy, const irq_lat_hw_config_t *p_config,
+                           irq_lat_stats_t *p_stats)
+{
+    if (core == get_core_num()) {
+        s_is_irqlat_load_stop = false;
+        if (is_busy && !app_core_0_job_start(irqlat_load_core0_job, NULL)) {
+            return false;
+        }
+        irq_lat_hw_run(p_config, p_stats);
+        if (is_busy) {
+            s_is_irqlat_load_stop = true;
+            app_core_0_job_wait();
+        }
+        return true;
+    }
+
+    irqlat_job_t job = {.p_config = p_config, .p_stats = p_stats, .is_done = false};
+    uint32_t pos = 0;
+    if (!app_core_0_job_start(irqlat_core0_job, &job)) {
+        return false;
+    }
+    while (!job.is_done)
+    {
+        if (is_busy) {
+            jitter_hw_load_step(JITTER_LOAD_MEM, &pos);
+        } else {
+            tight_loop_contents();
+        }
+        WDT_RST();
+    }
+    app_core_0_job_wait();
+
+    return true;
+}
+
+/**
+ * @brief 割り込み応答時間の計測コマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_irqlat(const dbg_cmd_args_t* p_args)
+{
+    // ハンドラの置き場所(フラッシュはキャッシュに載っている/毎回無効化)
+    static const struct {
+        const char *p_name;
+        bool is_sram;
+        bool is_cold;
+    } s_handler_tbl[] = {
+        {"sram",        true,   false},
+        {"flash",       false,  false},
+        {"flash-cold",  false,  true},
+    };
+    irq_lat_hw_config_t config = {.src = IRQ_LAT_SRC_PIO, .samples = IRQLAT_SAMPLES_DEF};
+    int32_t arg = 1;
+
+    if (p_args->argc > arg && strcmp(p_args->p_argv[arg], "gpio") == 0) {
+        if (p_args->argc < arg + 3) {
+            printf("Usage: irqlat gpio <out_pin> <in_pin> [samples] (jumper out_pin to in_pin)\n");
+            return;
+        }
+        config.src = IRQ_LAT_SRC_GPIO;
+        config.out_pin = (uint32_t)atoi(p_args->p_argv[arg + 1]);
+        config.in_pin = (uint32_t)atoi(p_args->p_argv[arg + 2]);
+        if (config.out_pin > GPIO_PIN_NUM_MAX || config.in_pin > GPIO_PIN_NUM_MAX ||
+            config.out_pin == config.in_pin) {
+            printf("Error: Invalid GPIO pin number.\n");
+            return;
+        }
+        arg += 3;
+    } else if (p_args->argc > arg && strcmp(p_args->p_argv[arg], "pio") == 0) {
+        arg++;
+    }
+    if (p_args->argc > arg) {
+        int32_t samples = atoi(p_args->p_argv[arg]);
+        if (samples <= 0 || samples > IRQLAT_SAMPLES_MAX) {
+            printf("Usage: irqlat [pio|gpio <out_pin> <in_pin>] [samples (1-%d)]\n", IRQLAT_SAMPLES_MAX);
+            return;
+        }
+        config.samples = (uint32_t)samples;
+    }
+
+    irq_lat_stats_t *p_stats = mem_arena_alloc(&s_cmd_arena, sizeof(irq_lat_stats_t));
+    if (p_stats == NULL) {
+        printf("Error: command arena is full\n");
+        return;
+    }
+    if (app_core_0_job_is_busy() || !irq_lat_hw_init(&config)) {
+        printf("Error: PIO state machine or core0 is busy.\n");
+        return;
+    }
+
+    printf("\n[IRQLAT] %s IRQ -> handler entry, %u MHz, %u samples per config, cycles\n",
+            irq_lat_src_name(config.src), clock_get_hz(clk_sys) / 1000000, config.samples);
+    printf("core handler     other  samples     min     p50     p99     max    mean  offset  early  timeout\n");
+    for (uint32_t core = 0; core < 2; core++)
+    {
+        // このコア(Core1)から、次にもう一方のコア
+        uint32_t target = (core == 0) ? get_core_num() : 1 - get_core_num();
+
+        for (uint32_t h = 0; h < sizeof(s_handler_tbl) / sizeof(s_handler_tbl[0]); h++)
+        {
+            for (uint32_t busy = 0; busy < 2; busy++)
+            {
+                config.is_sram = s_handler_tbl[h].is_sram;
+                config.is_cold = s_handler_tbl[h].is_cold;
+                if (!irqlat_measure(target, busy != 0, &config, p_stats)) {
+                    printf("Error: Failed to run on core%u.\n", target);
+                    irq_lat_hw_deinit();
+                    return;
+                }
+
+                const latency_hist_t *p_hist = &p_stats->hist;
+                printf("%4u %-10s %-5s %8u %7u %7u %7u %7u %7.1f %7u %6u %8u\n", target,
+                        s_handler_tbl[h].p_name, busy ? "busy" : "idle", p_hist->total,
+                        (p_hist->total > 0) ? p_hist->min : 0, lh_percentile(p_hist, 50.0),
+                        lh_percentile(p_hist, 99.0), p_hist->max, lh_mean(p_hist),
+                        p_stats->offset, p_stats->early, p_stats->timeouts);
+                print_latency_hist(p_hist, "cycles");
+                WDT_RST();
+            }
+        }
+    }
+    irq_lat_hw_deinit();
+}
+
+// la: 最後のキャプチャ(la dumpで出し直す)
+static la_capture_t s_la_capture;
+
+// la/freq: 計測を待つ間に呼ぶ(WDTをリセット、何かキーを押すと中断)
+static bool poll_key_abort(void)
+{
+    WDT_RST();
+    return (getchar_timeout_us(0) != PICO_ERROR_TIMEOUT);
+}
+
+// la: キャプチャをRLEにして出力(tools/la2vcd.py用、RLEのバイト列を16進で)
+static void la_dump(const la_capture_t *p_cap)
+{
+    uint8_t bin[LA_DUMP_BYTES_PER_LINE];
+    char hex[sizeof(bin) * 2 + 1];
+    la_rle_t rle;
+    uint32_t pos = 0;
+    uint32_t total = 0;
+    uint32_t len;
+
+    printf("%s ver=1 base=%u pins=%u rate=%u samples=%u trigger=%d\n", LA_DUMP_BEGIN,
+            p_cap->pin_base, p_cap->pin_num, p_cap->rate_hz, p_cap->samples, p_cap->trigger);
+    la_rle_init(&rle, p_cap->pin_num);
+    while ((len = la_rle_encode(p_cap, &pos, &rle, bin, sizeof(bin))) > 0)
+    {
+        trace_format_hex(hex, sizeof(hex), bin, len);
+        printf("%s\n", hex);
+        total += len;
+        WDT_RST();
+    }
+    printf("%s bytes=%u runs=%u\n", LA_DUMP_END, total, rle.runs);
+}
+
+/**
+ * @brief ロジックアナライザのコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_la(const dbg_cmd_args_t* p_args)
+{
+    la_hw_config_t config = {.samples = LA_SAMPLES_DEF, .p_poll = poll_key_abort};
+    const char *p_trig_str = "none";
+    bool is_samples_set = false;
+    bool is_pre_set = false;
+
+    if (strcmp(p_args->p_argv[1], "dump") == 0) {
+        if (s_la_capture.samples == 0) {
+            printf("Error: No capture yet.\n");
+            return;
+        }
+        la_dump(&s_la_capture);
+        return;
+    }
+    if (p_args->argc < 4) {
+        printf("Usage: la <base> <num> <hz> [samples] [pre] [none|rise:<pin>|fall:<pin>|edge:<pin>|pat:<mask>:<val>]\n");
+        return;
+    }
+
+    config.pin_base = (uint32_t)atoi(p_args->p_argv[1]);
+    config.pin_num = (uint32_t)atoi(p_args->p_argv[2]);
+    config.rate_hz = (uint32_t)strtoul(p_args->p_argv[3], NULL, 0);
+    if (config.pin_num == 0 || config.pin_num > LA_PIN_MAX || config.pin_base + config.pin_num > LA_PIN_MAX) {
+        printf("Error: Pins must be within GPIO0-%d.\n", LA_PIN_MAX - 1);
+        return;
+    }
+
+    // 数値はサンプル数、プリトリガの順、それ以外はトリガ条件
+    for (int32_t i = 4; i < p_args->argc; i++)
+    {
+        const char *p_arg = p_args->p_argv[i];
+
+        if (strchr(p_arg, ':') != NULL || strcmp(p_arg, "none") == 0) {
+            if (!la_trig_parse(p_arg, config.pin_base, config.pin_num, &config.trig)) {
+                printf("Error: Invalid trigger '%s' (pins GPIO%u-%u, pattern bit0 = GPIO%u).\n", p_arg,
+                        config.pin_base, config.pin_base + config.pin_num - 1, config.pin_base);
+                return;
+            }
+            p_trig_str = p_arg;
+        } else if (!is_samples_set) {
+            config.samples = (uint32_t)strtoul(p_arg, NULL, 0);
+            is_samples_set = true;
+        } else if (!is_pre_set) {
+            config.pre = (uint32_t)strtoul(p_arg, NULL, 0);
+            is_pre_set = true;
+        } else {
+            printf("Error: Too many arguments.\n");
+            return;
+        }
+    }
+    if (!is_pre_set) {
+        config.pre = config.samples / 8;
+    }
+    if (config.samples == 0 || config.samples > la_hw_samples_max(config.pin_num)) {
+        printf("Error: samples must be 1-%u for %u pins.\n", la_hw_samples_max(config.pin_num), config.pin_num);
+        return;
+    }
+
+    printf("\n[LA] GPIO%u-%u, %u Hz, %u samples, trigger %s (pre %u), press any key to abort\n",
+            config.pin_base, config.pin_base + config.pin_num - 1, config.rate_hz, config.samples,
+            p_trig_str, (config.trig.type != LA_TRIG_NONE) ? config.pre : 0);
+    la_hw_result_t result = la_hw_capture(&config, &s_la_capture);
+    switch (result)
+    {
+        case LA_HW_OK:
+            printf("[LA] captured at %u Hz\n", s_la_capture.rate_hz);
+            la_dump(&s_la_capture);
+            break;
+        case LA_HW_ABORTED:
+            printf("[LA] aborted (no trigger)\n");
+            break;
+        case LA_HW_OVERRUN:
+            printf("Error: Capture overrun (lower the rate or the number of pins).\n");
+            break;
+        case LA_HW_BUSY:
+            printf("Error: PIO state machine or DMA channel is busy.\n");
+            break;
+        case LA_HW_BAD_RATE:
+            printf("Error: Rate must be %u-%u Hz.\n",
+                    (clock_get_hz(clk_sys) >> 16) + 1, clock_get_hz(clk_sys));
+            break;
+        default:
+            printf("Error: pre must be less than samples.\n");
+            break;
+    }
+}
+
+// freq: 値をSI接頭辞付きで表示(例: 1.234567 MHz, 13.333 ns)
+static void freq_print_si(double value, const char *p_unit)
+{
+    static const struct {
+        double scale;
+        const char *p_prefix;
+    } s_si_tbl[] = {
+        {1e9, "G"}, {1e6, "M"}, {1e3, "k"}, {1.0, ""}, {1e-3, "m"}, {1e-6, "u"}, {1e-9, "n"},
+    };
+    uint32_t i = 0;
+
+    while (i + 1 < sizeof(s_si_tbl) / sizeof(s_si_tbl[0]) && fabs(value) < s_si_tbl[i].scale)
+    {
+        i++;
+    }
+    if (value == 0.0) {
+        i = 3;
+    }
+    printf("%.6g %s%s", value / s_si_tbl[i].scale, s_si_tbl[i].p_prefix, p_unit);
+}
+
+// freq: 統計を1行で表示
+static void freq_print_stat(const char *p_name, const freq_stat_t *p_stat, const char *p_unit)
+{
+    printf("  %-9s: mean ", p_name);
+    freq_print_si(p_stat->mean, p_unit);
+    printf(", min ");
+    freq_print_si(p_stat->min, p_unit);
+    printf(", max ");
+    freq_print_si(p_stat->max, p_unit);
+    printf(", std ");
+    freq_print_si(freq_stat_std(p_stat), p_unit);
+    printf("\n");
+}
+
+// freq: エッジ数からゲートごとの周波数
+static bool freq_count(uint32_t pin, uint32_t gate_ms, double *p_freq_hz)
+{
+    freq_hw_capture_t cap;
+    freq_count_result_t result;
+    uint32_t gates = FREQ_GATES_DEF;
+    uint32_t ticks_per_gate;
+    double tick_s;
+
+    if (!freq_hw_count(pin, gate_ms * 1000, &gates, &ticks_per_gate, &tick_s, &cap, poll_key_abort)) {
+        printf("Error: PIO state machine, DMA channel or DMA timer is busy.\n");
+        return false;
+    }
+    freq_count_analyze(cap.p_buf, cap.num, ticks_per_gate, tick_s, &result);
+
+    printf("\n[FREQ] GPIO%u edge count, gate %.3f ms x %u (window %.3f s)%s\n", pin,
+            result.gate_s * 1000.0, result.gates, result.window_s, cap.is_complete ? "" : ", aborted");
+    if (result.window_s <= 0.0) {
+        return false;
+    }
+    printf("  frequency: ");
+    freq_print_si(result.freq_hz, "Hz");
+    printf(" (%llu edges, 1 edge per gate = ", (unsigned long long)result.edges);
+    freq_print_si(1.0 / result.gate_s, "Hz");
+    printf(")\n");
+    if (result.gates > 0) {
+        freq_print_stat("per gate", &result.gate_hz, "Hz");
+    }
+    *p_freq_hz = result.freq_hz;
+
+    return cap.is_complete;
+}
+
+// freq: H/Lの幅から周波数、デューティ比、周期のジッタ
+static void freq_pulse(uint32_t pin, uint32_t periods)
+{
+    freq_hw_capture_t cap;
+    freq_pulse_result_t result;
+    double cycle_s = 1.0 / (double)clock_get_hz(clk_sys);
+
+    if (!freq_hw_pulse(pin, periods, FREQ_PULSE_TIMEOUT_MS, &cap, poll_key_abort)) {
+        printf("Error: PIO state machine or DMA channel is busy.\n");
+        return;
+    }
+    freq_pulse_analyze(cap.p_buf, cap.num, cycle_s, &result);
+
+    printf("\n[FREQ] GPIO%u pulse widths, %u periods%s, resolution ", pin, result.periods,
+            cap.is_complete ? "" : " (timed out or aborted)");
+    freq_print_si(result.resolution_s, "s");
+    printf("\n");
+    if (result.periods == 0) {
+        printf("  no complete period within %u ms\n", FREQ_PULSE_TIMEOUT_MS);
+        return;
+    }
+    printf("  frequency: ");
+    freq_print_si(result.freq_hz, "Hz");
+    printf("\n  duty     : %.2f %%\n", result.duty * 100.0);
+    freq_print_stat("period", &result.period, "s");
+    printf("  jitter   : rms ");
+    freq_print_si(freq_stat_std(&result.period), "s");
+    printf(", p-p ");
+    freq_print_si(result.period.max - result.period.min, "s");
+    printf("\n");
+    freq_print_stat("high", &result.high, "s");
+    freq_print_stat("low", &result.low, "s");
+}
+
+/**
+ * @brief 周波数カウンタのコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_freq(const dbg_cmd_args_t* p_args)
+{
+    int32_t pin = atoi(p_args->p_argv[1]);
+    bool is_pulse_only = (p_args->argc > 2 && strcmp(p_args->p_argv[2], "pulse") == 0);
+    uint32_t gate_ms = FREQ_GATE_MS_DEF;
+    uint32_t periods = FREQ_PERIODS_DEF;
+    double freq_hz = 0.0;
+
+    if (pin < 0 || pin > GPIO_PIN_NUM_MAX) {
+        printf("Error: Invalid GPIO pin number.\n");
+        return;
+    }
+    if (is_pulse_only && p_args->argc > 3) {
+        int32_t val = atoi(p_args->p_argv[3]);
+        if (val <= 0 || val > FREQ_PERIODS_MAX) {
+            printf("Usage: freq <pin> pulse [periods (1-%d)]\n", FREQ_PERIODS_MAX);
+            return;
+        }
+        periods = (uint32_t)val;
+    } else if (!is_pulse_only && p_args->argc > 2) {
+        int32_t val = atoi(p_args->p_argv[2]);
+        if (val <= 0 || val > FREQ_GATE_MS_MAX) {
+            printf("Usage: freq <pin> [gate_ms (1-%d)]\n", FREQ_GATE_MS_MAX);
+            return;
+        }
+        gate_ms = (uint32_t)val;
+    }
+
+    if (!is_pulse_only) {
+        if (!freq_count((uint32_t)pin, gate_ms, &freq_hz)) {
+            return;
+        }
+        if (freq_hz <= 0.0) {
+            printf("  no edges, pulse widths skipped\n");
+            return;
+        }
+        // 速すぎるとH/Lの幅が分解能(2サイクル)に埋もれる
+        if (freq_hz * FREQ_PULSE_CYCLES_MIN > (double)clock_get_hz(clk_sys)) {
+            printf("  above %u kHz, pulse widths skipped (resolution too coarse)\n",
+                    clock_get_hz(clk_sys) / FREQ_PULSE_CYCLES_MIN / 1000);
+            return;
+        }
+    }
+    freq_pulse((uint32_t)pin, periods);
+}
+
+// clk: クロック、コア電圧、フラッシュのSCK、全クロックの実測値、利用者ごとの分周比
+static void clk_list(void)
+{
+    clk_hw_status_t status;
+    clk_hw_domain_t domain_tbl[CLK_HW_DOMAIN_MAX];
+    uint32_t num;
+    char buf[32];
+
+    clk_hw_get_status(&status);
+    printf("\n[CLK] clk_sys %u MHz, clk_peri %u MHz, vreg %u mV, flash SCK %u MHz (clkdiv %u, rxdelay %u)\n",
+            status.sys_hz / 1000000, status.peri_hz / 1000000, status.vreg_mv,
+            status.flash_sck_hz / 1000000, status.qmi.clkdiv, status.qmi.rxdelay);
+
+    // 周波数カウンタ(FC0)の実測とSDKが把握している値
+    num = clk_hw_measure(domain_tbl, CLK_HW_DOMAIN_MAX);
+    printf("domain     measured kHz  expected kHz\n");
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (domain_tbl[i].expected_hz != 0) {
+            printf("%-10s %12u  %12u\n", domain_tbl[i].p_name, domain_tbl[i].measured_khz,
+                    domain_tbl[i].expected_hz / 1000);
+        } else {
+            printf("%-10s %12u  %12s\n", domain_tbl[i].p_name, domain_tbl[i].measured_khz, "-");
+        }
+    }
+
+    printf("\nuser     type  src     target Hz    actual Hz   err ppm  divider\n");
+    for (uint32_t i = 0; i < clk_reg_num(); i++)
+    {
+        const clk_user_t *p_user = clk_reg_get(i);
+
+        clk_div_format(buf, sizeof(buf), p_user->type, &p_user->div);
+        printf("%-8s %-5s %-5s %11u  %11u  %8d  %s\n",
+                p_user->p_name, clk_user_type_name(p_user->type), clk_src_name(clk_user_src(p_user->type)),
+                p_user->target_hz, p_user->is_valid ? p_user->div.actual_hz : 0,
+                p_user->is_valid ? clk_div_err_ppm(p_user->target_hz, p_user->div.actual_hz) : 0,
+                p_user->is_valid ? buf : "out of range (left as is)");
+    }
+}
+
+// clk: clk_sysを変えて分周比を追従させる
+static bool clk_set(uint32_t mhz)
+{
+    uint32_t applied = 0;
+    uint32_t invalid = 0;
+
+    switch (clk_hw_set_sys_mhz(mhz, &applied, &invalid))
+    {
+        case CLK_HW_OK:
+            break;
+
+        case CLK_HW_BUSY:
+            printf("[CLK] Error: core0 is busy with a job\n");
+            return false;
+
+        default:
+            printf("[CLK] Error: %u MHz is not available (%d-%d MHz, PLL must hit it exactly)\n",
+                    mhz, CLK_SYS_MHZ_MIN, CLK_SYS_MHZ_MAX);
+            return false;
+    }
+
+    printf("[CLK] clk_sys %u MHz, %u users retuned", clock_get_hz(clk_sys) / 1000000, applied);
+    if (invalid > 0) {
+        printf(", %u out of range", invalid);
+    }
+    printf("\n");
+
+    return true;
+}
+
+/**
+ * @brief クロックを順に変えてコマンドを実行し、1MHzあたりのスループットを表示
+ * @note 時間はclk_refのタイマーで測るのでclk_sysを変えても同じ物差し
+ *       最後に元のクロックに戻す
+ *
+ * @param p_args コマンド引数("clk bench <mhz,...> <cmd> ..."のまま)
+ */
+static void clk_bench(const dbg_cmd_args_t* p_args)
+{
+    uint32_t mhz_tbl[CLK_BENCH_POINTS_MAX];
+    uint64_t us_tbl[CLK_BENCH_POINTS_MAX];
+    uint32_t num = 0;
+    uint32_t orig_mhz = clock_get_hz(clk_sys) / 1000000;
+    const char *p_str = p_args->p_argv[2];
+    dbg_cmd_args_t sub_args;
+
+    // カンマ区切りのMHzのリスト
+    while (*p_str != '\0')
+    {
+        char *p_end;
+        uint32_t mhz = (uint32_t)strtoul(p_str, &p_end, 10);
+
+        if (p_end == p_str || (*p_end != ',' && *p_end != '\0') || num >= CLK_BENCH_POINTS_MAX) {
+            printf("Usage: clk bench <mhz[,mhz...]> (up to %d points) <cmd> [args...]\n", CLK_BENCH_POINTS_MAX);
+            return;
+        }
+        mhz_tbl[num++] = mhz;
+        p_str = (*p_end == ',') ? p_end + 1 : p_end;
+    }
+
+    // "clk bench <mhz,...>"の3つを除いた引数で実行
+    dbg_cmd_t cmd = dbg_com_sub_args(p_args, 3, &sub_args);
+    if (cmd == CMD_UNKNOWN) {
+        return;
+    }
+    if (cmd == CMD_CLK) {
+        printf("[CLK] Error: clk cannot be benchmarked\n");
+        return;
+    }
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        us_tbl[i] = 0;
+        if (!clk_set(mhz_tbl[i])) {
+            continue;
+        }
+        uint64_t start_us = time_us_64();
+        dbg_com_execute_cmd(cmd, &sub_args);
+        us_tbl[i] = time_us_64() - start_us;
+    }
+    clk_set(orig_mhz);
+
+    // 1MHzあたりのスループットが同じなら性能はクロックに比例(メモリ待ちが多いと下がる)
+    double base = 0.0;
+    printf("\n[CLK] %s: throughput per MHz\n", sub_args.p_argv[0]);
+    printf("   MHz      time ms      runs/s  runs/s/MHz     Mcycles  per-MHz vs first\n");
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (us_tbl[i] == 0) {
+            printf("%6u  %11s\n", mhz_tbl[i], "skipped");
+            continue;
+        }
+        double runs_per_s = 1000000.0 / (double)us_tbl[i];
+        double per_mhz = runs_per_s / (double)mhz_tbl[i];
+        if (base == 0.0) {
+            base = per_mhz;
+        }
+        printf("%6u  %11.3f  %10.3f  %10.5f  %10.3f  %15.1f%%\n",
+                mhz_tbl[i], (double)us_tbl[i] / 1000.0, runs_per_s, per_mhz,
+                (double)us_tbl[i] * (double)mhz_tbl[i] / 1000000.0, per_mhz / base * 100.0);
+    }
+}
+
+/**
+ * @brief クロック変更のコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_clk(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "list";
+
+    if (strcmp(p_sub, "list") == 0) {
+        clk_list();
+    } else if (strcmp(p_sub, "bench") == 0) {
+        if (p_args->argc < 4) {
+            printf("Usage: clk bench <mhz[,mhz...]> <cmd> [args...]\n");
+            return;
+        }
+        clk_bench(p_args);
+    } else {
+        int32_t mhz = atoi(p_sub);
+        if (mhz <= 0) {
+            printf("Usage: clk [list|<mhz>|bench <mhz[,mhz...]> <cmd> [args...]]\n");
+            return;
+        }
+        clk_set((uint32_t)mhz);
+    }
+}
+
+// idle: コアごとの滞在率、起きた理由、起床レイテンシ
+static void idle_stat(void)
+{
+    uint64_t now = idle_hw_now();
+    double ticks_per_us = (double)clock_get_hz(clk_sys) / 1000000.0;
+
+    printf("\n[IDLE] mode %s, time base MTIME @ clk_sys %u MHz\n",
+            (idle_hw_get_mode() == IDLE_MODE_WFE) ? "wfe" : "spin", clock_get_hz(clk_sys) / 1000000);
+    printf("core   residency    active ms     sleep ms    sleeps  avg sleep us  max sleep ms  immediate");
+    for (uint32_t reason = 0; reason < IDLE_WAKE_NUM; reason++)
+    {
+        printf("  %6s", idle_wake_name((idle_wake_t)reason));
+    }
+    printf("\n");
+    for (uint32_t core = 0; core < IDLE_HW_CORE_NUM; core++)
+    {
+        const idle_core_t *p_core = idle_hw_core(core);
+        idle_report_t report;
+
+        idle_report(p_core, now, &report);
+        printf("core%u  %8.2f%%  %11.3f  %11.3f  %8u  %12.1f  %12.3f  %9u", core, report.residency * 100.0,
+                (double)report.active / ticks_per_us / 1000.0, (double)report.sleep / ticks_per_us / 1000.0,
+                p_core->sleeps, report.avg_sleep / ticks_per_us,
+                (double)p_core->max_sleep / ticks_per_us / 1000.0, p_core->immediate);
+        for (uint32_t reason = 0; reason < IDLE_WAKE_NUM; reason++)
+        {
+            printf("  %6u", p_core->wakes[reason]);
+        }
+        printf("\n");
+    }
+
+    // 通知(SEV)からWFEの次の命令までの時間
+    printf("\nwake latency (notify -> resume, ns)\n");
+    printf("core      count       min      mean       p50       p99       max\n");
+    for (uint32_t core = 0; core < IDLE_HW_CORE_NUM; core++)
+    {
+        const latency_hist_t *p_lat = &idle_hw_core(core)->wake_lat;
+        double ns_per_tick = 1000.0 / ticks_per_us;
+
+        if (p_lat->total == 0) {
+            printf("core%u  %9u  %8s\n", core, 0, "-");
+            continue;
+        }
+        printf("core%u  %9u  %8.0f  %8.0f  %8.0f  %8.0f  %8.0f\n", core, p_lat->total,
+                (double)p_lat->min * ns_per_tick, lh_mean(p_lat) * ns_per_tick,
+                (double)lh_percentile(p_lat, 50.0) * ns_per_tick, (double)lh_percentile(p_lat, 99.0) * ns_per_tick,
+                (double)p_lat->max * ns_per_tick);
+    }
+}
+
+/**
+ * @brief アイドルのコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_idle(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "stat") == 0) {
+        idle_stat();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        idle_hw_clear();
+        printf("[IDLE] counters cleared.\n");
+    } else if (strcmp(p_sub, "wfe") == 0) {
+        idle_hw_set_mode(IDLE_MODE_WFE);
+        printf("[IDLE] idle cores sleep in WFE.\n");
+    } else if (strcmp(p_sub, "spin") == 0) {
+        idle_hw_set_mode(IDLE_MODE_SPIN);
+        printf("[IDLE] idle cores spin (no sleep).\n");
+    } else {
+        printf("Usage: idle [stat|clr|wfe|spin]\n");
+    }
+}
+
+// pipe: ベンチマークの送信元(dp_patternで埋める、submitは同じバッファを何度も指す)
+static uint8_t s_pipe_bench_buf[PIPE_BENCH_CHUNK];
+static volatile uint64_t s_pipe_done_bytes;
+// pipe: 受信側のベンチマークの集計
+static uint64_t s_pipe_rx_bytes;
+static uint32_t s_pipe_rx_bad;
+static uint32_t s_pipe_rx_first_us;
+static uint32_t s_pipe_rx_last_us;
+
+static void pipe_done(void *p_ctx, const uint8_t *p_data, uint32_t len)
+{
+    (void)p_ctx;
+    (void)p_data;
+    s_pipe_done_bytes += len;
+}
+
+static void pipe_bench_rx_handler(void *p_ctx, const dp_hdr_t *p_hdr, uint32_t offset,
+                                  const uint8_t *p_data, uint32_t len)
+{
+    (void)p_ctx;
+
+    if (p_hdr->type != DP_TYPE_BENCH || len == 0) {
+        return;
+    }
+    if (s_pipe_rx_bytes == 0) {
+        s_pipe_rx_first_us = time_us_32();
+    }
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (p_data[i] != dp_pattern(offset + i)) {
+            s_pipe_rx_bad++;
+        }
+    }
+    s_pipe_rx_bytes += len;
+    s_pipe_rx_last_us = time_us_32();
+}
+
+// pipe: パイプの状態と統計
+static void pipe_stat(void)
+{
+    const dp_t *p_dp = data_pipe_hw_get();
+    const dp_stat_t *p_st = &p_dp->stat;
+
+    printf("[PIPE] data pipe on USB CDC%u: %s\n", DATA_PIPE_HW_ITF,
+            data_pipe_hw_is_connected() ? "open" : "closed (open the 2nd serial port)");
+    printf("queue    : %u/%u\n", dp_tx_queued(p_dp), DP_QUEUE_DEPTH);
+    printf("tx       : %llu bytes, %u frames, %u msgs, queue full %u, link stall %u\n",
+            p_st->tx_bytes, p_st->tx_frames, p_st->tx_msgs, p_st->tx_full, p_st->tx_stall);
+    printf("rx       : %llu bytes (payload %llu), %u frames, resync %u, seq err %u\n",
+            p_st->rx_bytes, p_st->rx_payload, p_st->rx_frames, p_st->rx_resync, p_st->rx_seq_err);
+}
+
+// pipe: 送信キューが空になるまで回す(戻り値: 空になった)
+static bool pipe_wait_sent(uint64_t total)
+{
+    uint32_t last_us = time_us_32();
+    uint32_t check_us = last_us;
+    uint64_t last_done = s_pipe_done_bytes;
+
+    while (s_pipe_done_bytes < total)
+    {
+        data_pipe_hw_poll();
+
+        uint32_t now = time_us_32();
+        if (s_pipe_done_bytes != last_done) {
+            last_done = s_pipe_done_bytes;
+            last_us = now;
+        } else if ((now - last_us) > PIPE_TIMEOUT_MS * 1000) {
+            printf("Error: Data pipe stalled (is the 2nd serial port open and read?)\n");
+            return false;
+        }
+        // キーの確認はstdioを通るので間引く
+        if ((now - check_us) > PIPE_KEY_CHECK_US) {
+            check_us = now;
+            if (poll_key_abort()) {
+                printf("Aborted.\n");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// pipe: メモリをそのまま(コピーせずに)送る
+static void pipe_send(const dbg_cmd_args_t* p_args)
+{
+    uint32_t addr;
+    uint32_t length;
+
+    if (p_args->argc != 4 || sscanf(p_args->p_argv[2], "#%x", &addr) != 1 ||
+        sscanf(p_args->p_argv[3], "#%x", &length) != 1) {
+        printf("Usage: pipe send #<address> #<length>\n");
+        return;
+    }
+
+    s_pipe_done_bytes = 0;
+    uint32_t start = time_us_32();
+    if (!data_pipe_hw_submit(DP_TYPE_RAW, (const void *)addr, length, pipe_done, NULL)) {
+        printf("Error: Data pipe queue is full.\n");
+        return;
+    }
+    if (pipe_wait_sent(length)) {
+        printf("[PIPE] sent %u bytes from 0x%08X (%u us)\n", length, addr, time_us_32() - start);
+    }
+}
+
+// pipe: 送信(デバイス→ホスト)のスループット
+static void pipe_bench_tx(uint32_t mb)
+{
+    uint64_t total = (uint64_t)mb << 20;
+    uint64_t submitted = 0;
+    uint32_t last_us, check_us;
+
+    if (!data_pipe_hw_is_connected()) {
+        printf("Error: Open the 2nd serial port first (tools/pipe_bench.py).\n");
+        return;
+    }
+
+    for (uint32_t i = 0; i < PIPE_BENCH_CHUNK; i++)
+    {
+        s_pipe_bench_buf[i] = dp_pattern(i);
+    }
+    data_pipe_hw_clear_stat();
+    s_pipe_done_bytes = 0;
+
+    uint32_t start = time_us_32();
+    last_us = start;
+    check_us = start;
+    uint64_t last_done = 0;
+    while (s_pipe_done_bytes < total)
+    {
+        // 背圧: キューが満杯になるまで積む
+        while (submitted < total)
+        {
+            uint32_t n = ((total - submitted) < PIPE_BENCH_CHUNK) ? (uint32_t)(total - submitted) : PIPE_BENCH_CHUNK;
+            if (!data_pipe_hw_submit(DP_TYPE_BENCH, s_pipe_bench_buf, n, pipe_done, NULL)) {
+                break;
+            }
+            submitted += n;
+        }
+        data_pipe_hw_poll();
+
+        uint32_t now = time_us_32();
+        if (s_pipe_done_bytes != last_done) {
+            last_done = s_pipe_done_bytes;
+            last_us = now;
+        } else if ((now - last_us) > PIPE_TIMEOUT_MS * 1000) {
+            printf("Error: Data pipe stalled after %llu bytes.\n", last_done);
+            return;
+        }
+        if ((now - check_us) > PIPE_KEY_CHECK_US) {
+            check_us = now;
+            if (poll_key_abort()) {
+                printf("Aborted.\n");
+                return;
+            }
+        }
+    }
+    uint32_t elapsed = last_us - start;
+
+    const dp_stat_t *p_st = &data_pipe_hw_get()->stat;
+    printf("[PIPE] tx %llu bytes in %u us = %.3f MB/s\n", total, elapsed,
+            (elapsed > 0) ? (double)total / (double)elapsed : 0.0);
+    printf("frames %u, queue full %u, link stall %u\n", p_st->tx_frames, p_st->tx_full, p_st->tx_stall);
+}
+
+// pipe: 受信(ホスト→デバイス)のスループット
+static void pipe_bench_rx(uint32_t mb)
+{
+    uint64_t total = (uint64_t)mb << 20;
+    uint32_t wait_ms = PIPE_RX_WAIT_MS;
+
+    data_pipe_hw_clear_stat();
+    s_pipe_rx_bytes = 0;
+    s_pipe_rx_bad = 0;
+    data_pipe_hw_set_rx_handler(pipe_bench_rx_handler, NULL);
+    printf("[PIPE] waiting for %llu bytes on the 2nd serial port...\n", total);
+
+    uint32_t last_us = time_us_32();
+    uint32_t check_us = last_us;
+    uint64_t last_bytes = 0;
+    while (s_pipe_rx_bytes < total)
+    {
+        data_pipe_hw_poll();
+
+        uint32_t now = time_us_32();
+        if (s_pipe_rx_bytes != last_bytes) {
+            last_bytes = s_pipe_rx_bytes;
+            last_us = now;
+            wait_ms = PIPE_TIMEOUT_MS;
+        } else if ((now - last_us) > wait_ms * 1000) {
+            printf("Error: Timed out after %llu bytes.\n", last_bytes);
+            break;
+        }
+        if ((now - check_us) > PIPE_KEY_CHECK_US) {
+            check_us = now;
+            if (poll_key_abort()) {
+                printf("Aborted.\n");
+                break;
+            }
+        }
+    }
+    data_pipe_hw_set_rx_handler(NULL, NULL);
+
+    if (s_pipe_rx_bytes == 0) {
+        return;
+    }
+    const dp_stat_t *p_st = &data_pipe_hw_get()->stat;
+    uint32_t elapsed = s_pipe_rx_last_us - s_pipe_rx_first_us;
+    printf("[PIPE] rx %llu bytes in %u us = %.3f MB/s\n", s_pipe_rx_bytes, elapsed,
+            (elapsed > 0) ? (double)s_pipe_rx_bytes / (double)elapsed : 0.0);
+    printf("frames %u, bad bytes %u, resync %u, seq err %u\n", p_st->rx_frames, s_pipe_rx_bad,
+            p_st->rx_resync, p_st->rx_seq_err);
+}
+
+/**
+ * @brief データパイプのコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_pipe(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "stat") == 0) {
+        pipe_stat();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        data_pipe_hw_clear_stat();
+        printf("[PIPE] counters cleared.\n");
+    } else if (strcmp(p_sub, "send") == 0) {
+        pipe_send(p_args);
+    } else if (strcmp(p_sub, "bench") == 0 && p_args->argc > 2) {
+        int32_t mb = (p_args->argc > 3) ? atoi(p_args->p_argv[3]) : PIPE_BENCH_MB_DEF;
+        if (mb <= 0 || mb > PIPE_BENCH_MB_MAX) {
+            printf("Error: Size must be 1-%u MB.\n", PIPE_BENCH_MB_MAX);
+        } else if (strcmp(p_args->p_argv[2], "tx") == 0) {
+            pipe_bench_tx((uint32_t)mb);
+        } else if (strcmp(p_args->p_argv[2], "rx") == 0) {
+            pipe_bench_rx((uint32_t)mb);
+        } else {
+            printf("Usage: pipe bench <tx|rx> [MB]\n");
+        }
+    } else {
+        printf("Usage: pipe [stat|clr|send #<addr> #<len>|bench <tx|rx> [MB]]\n");
+    }
+}
+
+// uart: ベンチマークで試すボーレート(mcu_util.hの全レート)
+static const uint32_t s_uart_bench_baud[] = {
+    UART_BAUD_RATE_9600, UART_BAUD_RATE_14400, UART_BAUD_RATE_19200, UART_BAUD_RATE_38400,
+    UART_BAUD_RATE_57600, UART_BAUD_RATE_115200, UART_BAUD_RATE_230400, UART_BAUD_RATE_460800,
+    UART_BAUD_RATE_921600,
+};
+static latency_hist_t s_uart_lat;
+
+// uart: 各UARTのリングと統計
+static void uart_stat(void)
+{
+    printf("\n[UART] rx ring %u bytes, tx ring %u bytes, shell on %s\n", UART_HW_RX_BUF_SIZE, UART_HW_TX_BUF_SIZE,
+            (uart_hw_get_shell() == UART_HW_SHELL_OFF) ? "USB only" : ((uart_hw_get_shell() == 0) ? "uart0" : "uart1"));
+    printf("port     baud  shell    rx bytes    tx bytes  rx used/peak  tx used/peak  overrun  hw ovr  rx err  tx dma  tx wait  tx drop\n");
+    for (uint32_t i = 0; i < UART_HW_NUM; i++)
+    {
+        uart_hw_stat_t st;
+
+        if (!uart_hw_get_stat(i, &st)) {
+            printf("uart%u  (not initialized)\n", i);
+            continue;
+        }
+        printf("uart%u %7u  %5s  %10u  %10u  %5u/%-6u  %5u/%-6u  %7u  %6u  %6u  %6u  %7u  %7u\n", i, st.baud,
+                st.is_shell ? "yes" : "-", st.rx_bytes, st.tx_bytes, st.rx_used, st.rx_peak, st.tx_used, st.tx_peak,
+                st.rx_overrun, st.hw_overrun, st.rx_err, st.tx_dma, st.tx_wait, st.tx_drop);
+    }
+}
+
+// uart: 1レート分(ループバックでbytesを送って受ける、続けて1バイトの往復を測る)
+static void uart_bench_rate(uint32_t index, uint32_t baud)
+{
+    uint32_t actual = uart_hw_set_baud(index, baud);
+    uint32_t bytes = (uint32_t)((uint64_t)actual / 10 * UART_BENCH_MS / 1000);
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint32_t bad = 0;
+    bool is_timeout = false;
+
+    if (bytes < UART_BENCH_BYTES_MIN) {
+        bytes = UART_BENCH_BYTES_MIN;
+    }
+    uart_hw_rx_discard(index);
+    uart_hw_clear_stat(index);
+
+    // スループット: 送信リングに直接書いて(reserve/commit)、受信リングをそのまま見て(peek/consume)確かめる
+    uint32_t start = time_us_32();
+    uint32_t last_us = start;
+    while (received < bytes)
+    {
+        // 送り終わったDMAを片付けて次を出す(送信の完了はポーリングで見る)
+        uart_hw_poll();
+
+        uint8_t *p_tx;
+        uint32_t n = (sent < bytes) ? uart_hw_tx_reserve(index, &p_tx) : 0;
+        if (n > 0) {
+            if (n > bytes - sent) {
+                n = bytes - sent;
+            }
+            for (uint32_t k = 0; k < n; k++)
+            {
+                p_tx[k] = (uint8_t)(sent + k);
+            }
+            uart_hw_tx_commit(index, n);
+            sent += n;
+        }
+
+        const uint8_t *p_rx;
+        n = uart_hw_rx_peek(index, &p_rx);
+        if (n > 0) {
+            for (uint32_t k = 0; k < n; k++)
+            {
+                if (p_rx[k] != (uint8_t)(received + k)) {
+                    bad++;
+                }
+            }
+            uart_hw_rx_consume(index, n);
+            received += n;
+            last_us = time_us_32();
+        } else if ((time_us_32() - last_us) > UART_BENCH_TIMEOUT_MS * 1000) {
+            is_timeout = true;
+            break;
+        }
+    }
+    uint32_t elapsed = last_us - start;
+
+    // レイテンシ: 1バイト書いてから受信リングに入るまで(RXの割り込みはFIFOのレベルか受信タイムアウトで上がる)
+    lh_clear(&s_uart_lat);
+    for (uint32_t i = 0; i < UART_BENCH_LAT_NUM && !is_timeout; i++)
+    {
+        uint8_t data = (uint8_t)i;
+        const uint8_t *p_rx;
+
+        uint32_t t0 = time_us_32();
+        uart_hw_write(index, &data, 1);
+        while (uart_hw_rx_peek(index, &p_rx) == 0)
+        {
+            if ((time_us_32() - t0) > UART_BENCH_TIMEOUT_MS * 1000) {
+                is_timeout = true;
+                break;
+            }
+        }
+        if (is_timeout) {
+            break;
+        }
+        lh_record(&s_uart_lat, time_us_32() - t0);
+        uart_hw_rx_consume(index, 1);
+    }
+
+    uart_hw_stat_t st;
+    uart_hw_get_stat(index, &st);
+    double rate = (elapsed > 0) ? (double)received * 1000000.0 / (double)elapsed : 0.0;
+    printf("%7u  %7u  %6u  %8.2f  %8.2f  %5.1f%%", baud, actual, received, (double)elapsed / 1000.0,
+            rate / 1000.0, rate * 100.0 / ((double)actual / 10.0));
+    if (s_uart_lat.total > 0) {
+        printf("  %6u  %6u  %6u  %6u", s_uart_lat.min, lh_percentile(&s_uart_lat, 50.0),
+                lh_percentile(&s_uart_lat, 99.0), s_uart_lat.max);
+    } else {
+        printf("  %6s  %6s  %6s  %6s", "-", "-", "-", "-");
+    }
+    printf("  %7u  %4u%s\n", st.rx_overrun + st.hw_overrun, bad, is_timeout ? "  timeout" : "");
+}
+
+// uart: 全レートのスループットとレイテンシ(内部ループバック)
+static void uart_bench(const dbg_cmd_args_t* p_args)
+{
+    int32_t shell = uart_hw_get_shell();
+    int32_t index = (p_args->argc > 2) ? atoi(p_args->p_argv[2]) : ((shell == 1) ? 0 : 1);
+    uart_hw_stat_t st;
+
+    if (index < 0 || index >= UART_HW_NUM || !uart_hw_get_stat((uint32_t)index, &st)) {
+        printf("Usage: uart bench [0|1]\n");
+        return;
+    }
+    if (index == shell) {
+        printf("Error: uart%d is the shell (use the other one or 'uart shell off').\n", index);
+        return;
+    }
+
+    printf("\n[UART] uart%d bench: internal loopback, 8N1, TX by DMA from ring, RX by IRQ into ring\n", index);
+    printf("   baud   actual   bytes   time ms      KB/s   eff%%  lat us: min     p50     p99     max  overrun   bad\n");
+    uart_hw_set_loopback((uint32_t)index, true);
+    for (uint32_t i = 0; i < sizeof(s_uart_bench_baud) / sizeof(s_uart_bench_baud[0]); i++)
+    {
+        uart_bench_rate((uint32_t)index, s_uart_bench_baud[i]);
+        if (poll_key_abort()) {
+            printf("Aborted.\n");
+            break;
+        }
+    }
+    uart_hw_set_loopback((uint32_t)index, false);
+    uart_hw_set_baud((uint32_t)index, st.baud);
+    uart_hw_rx_discard((uint32_t)index);
+    printf("(eff%% = measured / (baud / 10 bits), latency = write 1 byte -> in the rx ring)\n");
+}
+
+/**
+ * @brief UARTのコマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_uart(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "stat";
+
+    if (strcmp(p_sub, "stat") == 0) {
+        uart_stat();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        for (uint32_t i = 0; i < UART_HW_NUM; i++)
+        {
+            uart_hw_clear_stat(i);
+        }
+        printf("[UART] counters cleared.\n");
+    } else if (strcmp(p_sub, "shell") == 0 && p_args->argc > 2) {
+        int32_t index = (strcmp(p_args->p_argv[2], "off") == 0) ? UART_HW_SHELL_OFF : atoi(p_args->p_argv[2]);
+        if (!uart_hw_set_shell(index)) {
+            printf("Usage: uart shell <0|1|off>\n");
+        } else if (index == UART_HW_SHELL_OFF) {
+            printf("[UART] shell on USB only.\n");
+        } else {
+            printf("[UART] shell on USB and uart%d.\n", index);
+        }
+    } else if (strcmp(p_sub, "bench") == 0) {
+        uart_bench(p_args);
+    } else {
+        printf("Usage: uart [stat|clr|shell <0|1|off>|bench [0|1]]\n");
+    }
+}
+
+/**
+ * @brief 起動の時刻と初期化タスクのコマンド関数
+ * @note boot            ... 段階の時刻と、初期化タスクごとのコア/開始/所要時間
+ *       boot run <task> ... 遅延タスクを今初期化する
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_boot(const dbg_cmd_args_t* p_args)
+{
+    uint32_t main_us, core;
+    init_task_stat_t st;
+
+    if (p_args->argc == 3 && strcmp(p_args->p_argv[1], "run") == 0) {
+        int32_t id = init_graph_find(p_args->p_argv[2]);
+        if (id < 0) {
+            printf("Error: Unknown init task '%s'.\n", p_args->p_argv[2]);
+            return;
+        }
+        bool is_was_done = init_graph_is_done((uint32_t)id);
+        if (!boot_hw_require((boot_task_t)id)) {
+            printf("Error: Init task '%s' cannot run on this core.\n", p_args->p_argv[2]);
+            return;
+        }
+        printf("[BOOT] %s: %s\n", p_args->p_argv[2], is_was_done ? "already initialized" : "initialized");
+        return;
+    }
+    if (p_args->argc != 1) {
+        printf("Usage: boot [run <task>]\n");
+        return;
+    }
+
+    boot_hw_get_stage(BOOT_STAGE_MAIN, &main_us, &core);
+    printf("\n[BOOT] stages (us since timer start, +us since main):\n");
+    for (uint32_t i = 0; i < BOOT_STAGE_NUM; i++)
+    {
+        uint32_t us;
+        if (boot_hw_get_stage((boot_stage_t)i, &us, &core)) {
+            printf("  %-13s %9u %+9d  core%u\n", boot_hw_stage_name((boot_stage_t)i), us, (int32_t)(us - main_us), core);
+        } else {
+            printf("  %-13s %9s\n", boot_hw_stage_name((boot_stage_t)i), "-");
+        }
+    }
+
+    printf("\n[BOOT] init tasks (start = +us since main):\n");
+    printf("  name        core     start  time(us)  deps\n");
+    for (uint32_t id = 0; id < init_graph_num(); id++)
+    {
+        const init_task_t *p_task = init_graph_task(id);
+        init_graph_get_stat(id, &st);
+        printf("  %-11s ", p_task->p_name);
+        if (st.state == INIT_TASK_DONE) {
+            printf("%4u %9d %9u  ", st.core, (int32_t)(st.start_us - main_us), st.end_us - st.start_us);
+        } else {
+            const char *p_state = (st.state == INIT_TASK_RUNNING) ? "running" : (p_task->is_deferred ? "deferred" : "pending");
+            printf("%4s %9s %9s  ", "-", p_state, "-");
+        }
+        uint32_t deps = p_task->deps;
+        const char *p_sep = "";
+        for (uint32_t dep = 0; deps != 0; dep++, deps >>= 1)
+        {
+            if ((deps & 1) != 0) {
+                printf("%s%s", p_sep, init_graph_task(dep)->p_name);
+                p_sep = ",";
+            }
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief タイマーコマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_timer(const dbg_cmd_args_t* p_args)
+{
+    const char *p_sub = (p_args->argc > 1) ? p_args->p_argv[1] : "list";
+
+    if (strcmp(p_sub, "list") == 0) {
+        timer_list();
+    } else if (strcmp(p_sub, "every") == 0) {
+        int32_t ms = (p_args->argc > 2) ? atoi(p_args->p_argv[2]) : 0;
+        if (ms <= 0 || (uint32_t)ms > TIMER_SVC_MAX_MS) {
+            printf("Usage: timer every <ms> (1-%u)\n", TIMER_SVC_MAX_MS);
+            return;
+        }
+        int32_t id = timer_svc_add((uint32_t)ms, (uint32_t)ms, timer_callback, NULL);
+        if (id < 0) {
+            printf("Error: All %d software timers are in use.\n", TIMER_SVC_MAX);
+            return;
+        }
+        printf("Timer #%d set every %d ms.\n", id, ms);
+    } else if (strcmp(p_sub, "cancel") == 0) {
+        if (p_args->argc < 3) {
+            printf("Usage: timer cancel <id|all>\n");
+        } else if (strcmp(p_args->p_argv[2], "all") == 0) {
+            printf("Cancelled %u timers.\n", timer_svc_cancel_all());
+        } else if (timer_svc_cancel(atoi(p_args->p_argv[2]))) {
+            printf("Timer #%d cancelled.\n", atoi(p_args->p_argv[2]));
+        } else {
+            printf("Error: Timer #%s is not running.\n", p_args->p_argv[2]);
+        }
+    } else if (strcmp(p_sub, "load") == 0) {
+        timer_load(p_args);
+    } else if (strcmp(p_sub, "stat") == 0) {
+        timer_stat();
+    } else if (strcmp(p_sub, "clr") == 0) {
+        timer_svc_clear_stats();
+        s_timer_load_fired = 0;
+        printf("Timer stats cleared.\n");
+    } else {
+        int32_t seconds = atoi(p_sub);
+        if (seconds <= 0) {
+            printf("Error: Invalid timer duration. Must be positive.\n");
+            return;
+        }
+        if (seconds > TIMER_MAX_SECONDS) {
+            printf("Error: Timer duration exceeds maximum of %d seconds.\n", TIMER_MAX_SECONDS);
+            return;
+        }
+
+        // ワンショットのソフトウェアタイマー(H/Wアラーム1本をタイマーホイールで共有)
+        int32_t id = timer_svc_add((uint32_t)seconds * 1000, 0, timer_callback, NULL);
+        if (id < 0) {
+            printf("Error: All %d software timers are in use.\n", TIMER_SVC_MAX);
+            return;
+        }
+        printf("Timer #%d set for %d seconds.\n", id, seconds);
+    }
+}
+
+/**
+ * @brief gpio benchのサブコマンド
+ * @note gpio bench <pin|lo-hi|#mask> [writes] [method]
+ */
+static void gpio_bench_cmd(const dbg_cmd_args_t* p_args)
+{
+    uint32_t mask;
+    uint32_t writes = GPIO_BENCH_WRITES_DEF;
+    int32_t method = -1;
+    uint32_t busy_pin = 0;
+    uint32_t new_mask;
+
+    if (p_args->argc < 3 || !gpio_bench_parse_pins(p_args->p_argv[2], &mask)
+        || (mask >> GPIO_PIN_NUM_MAX) > 1) {
+        printf("Error: Usage: gpio bench <pin|lo-hi|#mask> [writes] [method] (GPIO 0-%d)\n\n", GPIO_PIN_NUM_MAX);
+        return;
+    }
+    for (int32_t i = 3; i < p_args->argc; i++)
+    {
+        const char *p_arg = p_args->p_argv[i];
+        if (p_arg[0] >= '0' && p_arg[0] <= '9') {
+            writes = (uint32_t)atoi(p_arg);
+        } else {
+            method = gpio_bench_find_method(p_arg);
+            if (method < 0) {
+                printf("Error: Unknown method '%s' (put|sio_sc|sio_xor|gpioc_sc|gpioc_xor|pio_side)\n\n", p_arg);
+                return;
+            }
+        }
+    }
+    if (!gpio_bench_hw_setup_out(mask, &busy_pin, &new_mask)) {
+        printf("Error: GPIO %u is used by another function (UART/SPI/I2C/PIO)\n\n", (unsigned)busy_pin);
+        return;
+    }
+
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    writes = gpio_bench_round_writes(writes);
+    gpio_bench_report_header(mask, writes, sys_hz);
+    for (int32_t m = 0; m < GPIO_BENCH_METHOD_NUM; m++)
+    {
+        gpio_bench_result_t result;
+        if (method >= 0 && m != method) {
+            continue;
+        }
+        WDT_RST();
+        gpio_bench_hw_run((gpio_bench_method_t)m, mask, writes, &result);
+        gpio_bench_report_row((gpio_bench_method_t)m, &result, sys_hz);
+    }
+    if (new_mask != 0) {
+        printf("[GPIO] Pins #%08X set up as SIO outputs and left configured (gpio free <pins> to release)\n",
+               (unsigned)new_mask);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief GPIO制御コマンド関数
+ * @note ピンは最初の1回だけSIOの出力に設定し、以降は設定したままにする(gpio freeで戻す)
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_gpio(const dbg_cmd_args_t* p_args)
+{
+    uint32_t busy_pin = 0;
+    uint32_t new_mask;
+
+    if (strcmp(p_args->p_argv[1], "bench") == 0) {
+        gpio_bench_cmd(p_args);
+        return;
+    }
+    if (strcmp(p_args->p_argv[1], "free") == 0) {
+        uint32_t mask;
+        if (p_args->argc != 3 || !gpio_bench_parse_pins(p_args->p_argv[2], &mask)) {
+            printf("Error: Usage: gpio free <pin|lo-hi|#mask>\n\n");
+            return;
+        }
+        gpio_bench_hw_release(mask);
+        printf("[GPIO] Pins #%08X released (SIO pins only)\n\n", (unsigned)mask);
+        return;
+    }
+
+    if (p_args->argc != 3) {
+        printf("Error: Invalid number of arguments. Usage: gpio <pin> <value>\n\n");
+        return;
+    }
+
+    // コマンドからGPIOのピン番号とピンの値を取得
+    uint8_t pin = atoi(p_args->p_argv[1]);
+    uint8_t value = atoi(p_args->p_argv[2]);
+
+    // GPIOのピン番号チェック
+    if (pin < 0 || pin > GPIO_PIN_NUM_MAX) {
+        printf("Error: Invalid GPIO pin number. Must be between 0 and %d.\n\n", GPIO_PIN_NUM_MAX);
+        return;
+    }
+
+    // Low/High以外は受け付けない
+    if (value != 0 && value != 1) {
+        printf("Error: Invalid GPIO value. Must be 0 or 1.\n\n");
+        return;
+    }
+
+    // まだSIOの出力でなければ設定する(他の機能のピンは触らない)
+    if (!gpio_bench_hw_setup_out(1UL << pin, &busy_pin, &new_mask)) {
+        printf("Error: GPIO %d is used by another function (UART/SPI/I2C/PIO)\n\n", pin);
+        return;
+    }
+
+    // GPIO操作の処理時間を計測(DWTのサイクル数)
+    uint32_t start = dwt_get_cycles();
+    gpio_put(pin, value);
+    uint32_t cycles = dwt_get_cycles() - start;
+
+    printf("GPIO %d set to %d (proc time: %u cycles%s)\n\n", pin, value, (unsigned)cycles,
+           (new_mask != 0) ? ", configured as output" : "");
+}
+
+/**
+ * @brief コマンドを履歴に追加する関数
+ * 
+ * @param p_cmd 追加するコマンド
+ */
+static void add_to_cmd_history(const char* p_cmd)
+{
+    // 履歴を1つずつ下にずらす
+    for (int32_t i = CMD_HISTORY_MAX - 1; i > 0; i--) {
+        strcpy(s_cmd_history[i], s_cmd_history[i - 1]);
+    }
+
+    // 新しいコマンドを追加
+    strncpy(s_cmd_history[0], p_cmd, DBG_CMD_MAX_LEN - 1);
+    s_cmd_history[0][DBG_CMD_MAX_LEN - 1] = '\0';
+
+    // 履歴数を更新（最大値で制限）
+    if (s_history_count < CMD_HISTORY_MAX) {
+        s_history_count++;
+    }
+
+    // 履歴位置をリセット
+    s_history_pos = -1;
+}
+
+/**
+ * @brief デバッグコマンドモニターの初期化
+ */
+void dbg_com_init(void)
+{
+    mem_arena_init(&s_cmd_arena, s_cmd_arena_buf, sizeof(s_cmd_arena_buf));
+
+    // DWTはコアごとなので、コマンドを実行するこのコアで有効にする
+    if (dwt_init()) {
+        perf_init(&s_perf_ops);
+    }
+
+    cmd_help();
+}
+
+/**
+ * @brief コマンド文字列を解析してコマンド種類を返す
+ * 
+ * @param p_cmd_str コマンド文字列
+ * @param p_args 引数構造体
+ * @return dbg_cmd_t コマンド種類
+ */
+static dbg_cmd_t dbg_com_parse_cmd(const char* p_cmd_str, dbg_cmd_args_t* p_args)
+{
+    for (int32_t i = 0; s_cmd_table[i].p_cmd_str != NULL; i++) {
+        if (strcmp(p_cmd_str, s_cmd_table[i].p_cmd_str) == 0) {
+            // 引数の数をチェック
+            if (p_args->argc - 1 < s_cmd_table[i].min_args || p_args->argc - 1 > s_cmd_table[i].max_args) {
+                printf("Error: Invalid number of arguments. Expected %d-%d, got %d\n",
+                    s_cmd_table[i].min_args, s_cmd_table[i].max_args, p_args->argc - 1);
+                return CMD_UNKNOWN;
+            }
+            return s_cmd_table[i].cmd_type;
+        }
+    }
+    return CMD_UNKNOWN;
+}
+
+/**
+ * @brief 先頭のskip個を除いた引数を別のコマンドとして解析する(xip run、prof run、perf、clk bench用)
+ * @note 知らないコマンドならcmd_unknown()を表示してCMD_UNKNOWNを返す
+ *
+ * @param p_args 元の引数構造体
+ * @param skip 除く引数の数("xip run"なら2)
+ * @param p_sub 除いた残りの引数構造体(p_argvは元の文字列を指す)
+ * @return dbg_cmd_t コマンド種類
+ */
+static dbg_cmd_t dbg_com_sub_args(const dbg_cmd_args_t* p_args, int32_t skip, dbg_cmd_args_t* p_sub)
+{
+    p_sub->argc = p_args->argc - skip;
+    if (p_sub->argc <= 0) {
+        p_sub->argc = 0;
+        cmd_unknown();
+        return CMD_UNKNOWN;
+    }
+    for (int32_t i = 0; i < p_sub->argc; i++)
+    {
+        p_sub->p_argv[i] = p_args->p_argv[i + skip];
+    }
+
+    dbg_cmd_t cmd = dbg_com_parse_cmd(p_sub->p_argv[0], p_sub);
+    if (cmd == CMD_UNKNOWN) {
+        cmd_unknown();
+    }
+
+    return cmd;
+}
+
+/**
+ * @brief コマンドを実行する
+ * 
+ * @param cmd コマンド種類
+ * @param p_args 引数構造体
+ */
+static void dbg_com_execute_cmd(dbg_cmd_t cmd, const dbg_cmd_args_t* p_args)
+{
+    perf_snap_t perf_before;
+    // ネストして呼ばれる(xip run等)ので、リセットではなく呼ばれた時点まで戻す
+    size_t arena_mark = mem_arena_mark(&s_cmd_arena);
+
+    TRACE_BEGIN(TRACE_ID_CMD, cmd);
+    perf_snapshot(&perf_before);
+
+    switch (cmd) {
+        case CMD_HELP:
+            cmd_help();
+            break;
+
+        case CMD_VER:
+            cmd_ver();
+            break;
+
+        case CMD_SYSTEM:
+            cmd_system();
+            break;
+
+        case CMD_AT_TEST:
+            cmd_at_test();
+            break;
+
+        case CMD_PI_CALC:
+            cmd_pi_calc(p_args);
+            break;
+
+        case CMD_TRIG:
             cmd_trig();
             break;
 
-        case CMD_ATAN2:
-            cmd_atan2();
-            break;
+        case CMD_ATAN2:
+            cmd_atan2();
+            break;
+
+        case CMD_TAN355:
+            cmd_tan355();
+            break;
+
+        case CMD_ISQRT:
+            cmd_isqrt();
+            break;
+
+        case CMD_FFT:
+            cmd_fft(p_args);
+            break;
+
+        case CMD_MEMBENCH:
+            cmd_membench(p_args);
+            break;
+
+        case CMD_DMA:
+            cmd_dma(p_args);
+            break;
+
+        case CMD_XIP:
+            cmd_xip(p_args);
+            break;
+
+        case CMD_RAM:
+            cmd_ram();
+            break;
+
+        case CMD_PROF:
+            cmd_prof(p_args);
+            break;
+
+        case CMD_TRACE:
+            cmd_trace(p_args);
+            break;
+
+        case CMD_PERF:
+            cmd_perf(p_args);
+            break;
+
+        case CMD_MEM:
+            cmd_mem(p_args);
+            break;
+
+        case CMD_JITTER:
+            cmd_jitter(p_args);
+            break;
+
+        case CMD_IRQLAT:
+            cmd_irqlat(p_args);
+            break;
+
+        case CMD_LA:
+            cmd_la(p_args);
+            break;
+
+        case CMD_FREQ:
+            cmd_freq(p_args);
+            break;
+
+        case CMD_CLK:
+            cmd_clk(p_args);
+            break;
+
+        case CMD_IDLE:
+            cmd_idle(p_args);
+            break;
+
+        case CMD_PIPE:
+            cmd_pipe(p_args);
+            break;
+
+        case CMD_UART:
+            cmd_uart(p_args);
+            break;
+
+        case CMD_BOOT:
+            cmd_boot(p_args);
+            break;
+
+        case CMD_TIMER:
+            cmd_timer(p_args);
+            break;
+
+        case CMD_GPIO:
+            cmd_gpio(p_args);
+            break;
+
+        case CMD_MEM_DUMP:
+            cmd_mem_dump(p_args);
+            break;
+
+        case CMD_MEM_FIND:
+            cmd_mem_find(p_args);
+            break;
+
+        case CMD_MEM_FILL:
+            cmd_mem_fill(p_args);
+            break;
+
+        case CMD_MEM_CMP:
+            cmd_mem_cmp(p_args);
+            break;
+
+        case CMD_MEM_CPY:
+            cmd_mem_cpy(p_args);
+            break;
+
+        case CMD_CRC:
+            cmd_crc(p_args);
+            break;
+
+        case CMD_I2C:
+            cmd_i2c(p_args);
+            break;
+
+        case CMD_RST:
+            cmd_rst();
+            break;
+
+        case CMD_REG:
+            cmd_reg(p_args);
+            break;
+
+        case CMD_RND:
+            cmd_rnd(p_args);
+            break;
+
+        case CMD_SHA:
+            cmd_sha(p_args);
+            break;
+
+            case CMD_UNKNOWN:
+            cmd_unknown();
+            break;
+    }
+
+    perf_cmd_account(cmd, &perf_before);
+    TRACE_END(TRACE_ID_CMD, cmd);
+
+    mem_arena_release(&s_cmd_arena, arena_mark);
+}
+
+/**
+ * @brief メモリダンプコマンド関数
+ * 
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_dump(const dbg_cmd_args_t* p_args)
+{
+    uint32_t addr;
+    uint32_t length;
+
+    if (p_args->argc != 3) {
+        printf("Error: Invalid number of arguments. Usage: mem_dump <address> <length>\n");
+        return;
+    }
+
+    // アドレスを16進数文字列から数値に変換
+    if (sscanf(p_args->p_argv[1], "#%x", &addr) != 1) {
+        printf("Error: Invalid address format. Use hexadecimal with # prefix (e.g., #F0000000)\n");
+        return;
+    }
+
+    // 長さを16進数文字列から数値に変換
+    if (sscanf(p_args->p_argv[2], "#%x", &length) != 1) {
+        printf("Error: Invalid length format. Use hexadecimal with # prefix (e.g., #10)\n");
+        return;
+    }
+
+    volatile uint32_t start_time = time_us_32();
+    show_mem_dump(addr, length);
+    volatile uint32_t end_time = time_us_32();
+    printf("\nMemory dump completed (proc time: %u us)\n", end_time - start_time);
+}
+
+// #HEXの引数を数値に変換
+static bool mem_arg_hex(const char *p_str, uint32_t *p_val)
+{
+    char *p_end;
+
+    if (p_str[0] != '#' || p_str[1] == '\0') {
+        return false;
+    }
+    *p_val = (uint32_t)strtoul(&p_str[1], &p_end, 16);
+
+    return (*p_end == '\0');
+}
+
+/**
+ * @brief mem_findのパターンを解釈する
+ * @note #HEX...はメモリの並び順のバイト列、w#HEXは32bitワード(LEで4バイト、アラインしたアドレスだけ探す)、それ以外は文字列
+ *
+ * @return uint32_t パターンのバイト数(0なら不正)
+ */
+static uint32_t mem_find_parse_pat(const char *p_str, uint8_t *p_pat, bool *p_is_aligned)
+{
+    uint32_t len = (uint32_t)strlen(p_str);
+    uint32_t word;
+
+    *p_is_aligned = false;
+    if (p_str[0] == 'w' && mem_arg_hex(&p_str[1], &word)) {
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            p_pat[i] = (uint8_t)(word >> (8 * i));
+        }
+        *p_is_aligned = true;
+        return 4;
+    }
+
+    if (p_str[0] == '#') {
+        uint32_t digits = len - 1;
+        if (digits == 0 || (digits & 1) != 0 || digits / 2 > MEM_FIND_PAT_MAX) {
+            return 0;
+        }
+        for (uint32_t i = 0; i < digits / 2; i++)
+        {
+            char byte_str[3] = {p_str[1 + i * 2], p_str[2 + i * 2], '\0'};
+            char *p_end;
+            p_pat[i] = (uint8_t)strtoul(byte_str, &p_end, 16);
+            if (*p_end != '\0') {
+                return 0;
+            }
+        }
+        return digits / 2;
+    }
+
+    if (len > MEM_FIND_PAT_MAX) {
+        return 0;
+    }
+    memcpy(p_pat, p_str, len);
+
+    return len;
+}
+
+// 範囲[p_base, p_base + size)にaddrが入るか
+static inline bool mem_is_in(uint32_t addr, const void *p_base, uint32_t size)
+{
+    uint32_t base = (uint32_t)(uintptr_t)p_base;
+
+    return (addr >= base && addr - base < size);
+}
+
+/**
+ * @brief メモリ検索コマンド関数
+ * @note コマンドバッファ、履歴、検索の作業領域(どれもSRAM)に入っているパターン自身はヒットに数えない
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_find(const dbg_cmd_args_t* p_args)
+{
+    static const char *const s_mode_name[] = {"byte", "bmh", "word"};
+    uint32_t addr_tbl[MEM_FIND_SHOW_MAX];
+    uint8_t pat[MEM_FIND_PAT_MAX];
+    mem_find_t find;
+    uint32_t addr, len, pat_len;
+    uint32_t hits = 0;
+    uint32_t self_hits = 0;
+    bool is_aligned;
+
+    if (!mem_arg_hex(p_args->p_argv[1], &addr) || !mem_arg_hex(p_args->p_argv[2], &len) || len == 0) {
+        printf("Error: Usage: mem_find #ADDR #LEN <#HEXBYTES|w#WORD|TEXT>\n");
+        return;
+    }
+    pat_len = mem_find_parse_pat(p_args->p_argv[3], pat, &is_aligned);
+    if (pat_len == 0 || !mem_find_init(&find, pat, pat_len, is_aligned)) {
+        printf("Error: Pattern must be 1-%d bytes (#HEX with an even number of digits, w#WORD, or text)\n",
+                MEM_FIND_PAT_MAX);
+        return;
+    }
+
+    const uint8_t *p_buf = (const uint8_t *)(uintptr_t)addr;
+    uint32_t off = 0;
+    volatile uint32_t start_time = time_us_32();
+    while ((off = mem_find_next(&find, p_buf, len, off)) != MEM_OPS_NONE)
+    {
+        uint32_t hit = addr + off;
+        off++;
+        if (mem_is_in(hit, s_cmd_buffer, sizeof(s_cmd_buffer)) || mem_is_in(hit, s_cmd_history, sizeof(s_cmd_history))
+            || mem_is_in(hit, &find, sizeof(find)) || mem_is_in(hit, pat, sizeof(pat))) {
+            self_hits++;
+            continue;
+        }
+        if (hits < MEM_FIND_SHOW_MAX) {
+            addr_tbl[hits] = hit;
+        }
+        hits++;
+    }
+    volatile uint32_t end_time = time_us_32();
+    WDT_RST();
+
+    printf("[MEM] find %u bytes (%s) in 0x%08X-0x%08X\n", pat_len, s_mode_name[find.mode], addr, addr + len - 1);
+    for (uint32_t i = 0; i < hits && i < MEM_FIND_SHOW_MAX; i++)
+    {
+        printf("  0x%08X\n", addr_tbl[i]);
+    }
+    if (hits > MEM_FIND_SHOW_MAX) {
+        printf("  ... (%u more)\n", hits - MEM_FIND_SHOW_MAX);
+    }
+    printf("[MEM] %u hits (%u in the shell's own buffers skipped), %u bytes in %u us = %.1f MB/s\n",
+            hits, self_hits, len, end_time - start_time, (double)membench_mbps(len, end_time - start_time));
+}
+
+// DMAの完了待ちをしながらのフィル(端数はCPU)
+static bool mem_fill_dma(uint8_t *p_dst, uint32_t len, uint32_t val)
+{
+    uint32_t head = (uint32_t)(-(uintptr_t)p_dst) & 3;
+    uint32_t body;
+
+    if (head > len) {
+        head = len;
+    }
+    body = (len - head) & ~3UL;
+    mem_fill32(p_dst, head, val);
+    if (body > 0) {
+        dma_svc_handle_t handle = dma_svc_fill32_async(&p_dst[head], val, body, NULL, NULL);
+        if (handle == DMA_SVC_HANDLE_INVALID) {
+            return false;
+        }
+        dma_svc_wait(handle);
+    }
+    mem_fill32(&p_dst[head + body], len - head - body, val);
+
+    return true;
+}
+
+/**
+ * @brief メモリフィルコマンド関数
+ * @note #VALはアラインしたワードで読んだときの値(端数のバイトもアドレスに合った位置のバイトになる)
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_fill(const dbg_cmd_args_t* p_args)
+{
+    uint32_t addr, len, val;
+    bool is_dma = (p_args->argc == 5);
+    bool is_ok = true;
+
+    if (!mem_arg_hex(p_args->p_argv[1], &addr) || !mem_arg_hex(p_args->p_argv[2], &len)
+        || !mem_arg_hex(p_args->p_argv[3], &val) || (is_dma && strcmp(p_args->p_argv[4], "dma") != 0)) {
+        printf("Error: Usage: mem_fill #ADDR #LEN #VAL [dma]\n");
+        return;
+    }
+
+    uint8_t *p_dst = (uint8_t *)(uintptr_t)addr;
+    volatile uint32_t start_time = time_us_32();
+    if (is_dma) {
+        is_ok = mem_fill_dma(p_dst, len, val);
+    } else {
+        mem_fill32(p_dst, len, val);
+    }
+    volatile uint32_t end_time = time_us_32();
+    WDT_RST();
 
-        case CMD_TAN355:
-            cmd_tan355();
-            break;
+    if (!is_ok) {
+        printf("Error: DMA service is busy.\n");
+        return;
+    }
+    printf("[MEM] fill 0x%08X-0x%08X with 0x%08X (%s): %u bytes in %u us = %.1f MB/s\n",
+            addr, addr + len - 1, val, is_dma ? "dma" : "cpu", len, end_time - start_time,
+            (double)membench_mbps(len, end_time - start_time));
+}
 
-        case CMD_ISQRT:
-            cmd_isqrt();
-            break;
+/**
+ * @brief メモリ比較コマンド関数
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_cmp(const dbg_cmd_args_t* p_args)
+{
+    uint32_t addr_a, addr_b, len;
+    mem_cmp_result_t res;
 
-        case CMD_TIMER:
-            cmd_timer(p_args);
-            break;
+    if (!mem_arg_hex(p_args->p_argv[1], &addr_a) || !mem_arg_hex(p_args->p_argv[2], &addr_b)
+        || !mem_arg_hex(p_args->p_argv[3], &len)) {
+        printf("Error: Usage: mem_cmp #ADDR_A #ADDR_B #LEN\n");
+        return;
+    }
 
-        case CMD_GPIO:
-            cmd_gpio(p_args);
-            break;
+    const uint8_t *p_a = (const uint8_t *)(uintptr_t)addr_a;
+    const uint8_t *p_b = (const uint8_t *)(uintptr_t)addr_b;
+    volatile uint32_t start_time = time_us_32();
+    mem_cmp(p_a, p_b, len, &res);
+    volatile uint32_t end_time = time_us_32();
+    WDT_RST();
 
-        case CMD_MEM_DUMP:
-            cmd_mem_dump(p_args);
-            break;
+    if (res.first == MEM_OPS_NONE) {
+        printf("[MEM] cmp 0x%08X vs 0x%08X: %u bytes identical\n", addr_a, addr_b, len);
+    } else {
+        printf("[MEM] cmp 0x%08X vs 0x%08X: first mismatch at +0x%X (0x%08X: %02X, 0x%08X: %02X)\n",
+                addr_a, addr_b, res.first, addr_a + res.first, p_a[res.first], addr_b + res.first, p_b[res.first]);
+        printf("[MEM] %u of %u bytes differ in %u runs\n", res.count, len, res.runs);
+    }
+    printf("[MEM] compared in %u us = %.1f MB/s\n", end_time - start_time,
+            (double)membench_mbps(len, end_time - start_time));
+}
 
-        case CMD_I2C:
-            cmd_i2c(p_args);
-            break;
+/**
+ * @brief メモリコピーコマンド関数
+ * @note 重なっていればmemmove(DMAは使えない)、重なっていなければコピー後に比べて確かめる
+ *
+ * @param p_args コマンド引数の構造体ポインタ
+ */
+static void cmd_mem_cpy(const dbg_cmd_args_t* p_args)
+{
+    uint32_t dst, src, len;
+    bool is_dma = (p_args->argc == 5);
+    bool is_overlap;
+    const char *p_how;
 
-        case CMD_RST:
-            cmd_rst();
-            break;
+    if (!mem_arg_hex(p_args->p_argv[1], &dst) || !mem_arg_hex(p_args->p_argv[2], &src)
+        || !mem_arg_hex(p_args->p_argv[3], &len) || (is_dma && strcmp(p_args->p_argv[4], "dma") != 0)) {
+        printf("Error: Usage: mem_cpy #DST #SRC #LEN [dma]\n");
+        return;
+    }
+    is_overlap = (dst < src + len && src < dst + len);
+    if (is_overlap && is_dma) {
+        printf("Error: Regions overlap, DMA cannot copy them (drop 'dma' to use memmove).\n");
+        return;
+    }
 
-        case CMD_REG:
-            cmd_reg(p_args);
-            break;
+    void *p_dst = (void *)(uintptr_t)dst;
+    const void *p_src = (const void *)(uintptr_t)src;
+    volatile uint32_t start_time = time_us_32();
+    if (is_dma) {
+        dma_svc_handle_t handle = dma_svc_memcpy_async(p_dst, p_src, len, NULL, NULL);
+        if (handle == DMA_SVC_HANDLE_INVALID) {
+            printf("Error: DMA service is busy.\n");
+            return;
+        }
+        dma_svc_wait(handle);
+        p_how = "dma";
+    } else if (is_overlap) {
+        memmove(p_dst, p_src, len);
+        p_how = "memmove";
+    } else {
+        fast_memcpy(p_dst, p_src, len);
+        p_how = "cpu";
+    }
+    volatile uint32_t end_time = time_us_32();
+    WDT_RST();
 
-        case CMD_RND:
-            cmd_rnd(p_args);
-            break;
+    printf("[MEM] cpy 0x%08X -> 0x%08X (%s): %u bytes in %u us = %.1f MB/s", src, dst, p_how, len,
+            end_time - start_time, (double)membench_mbps(len, end_time - start_time));
+    if (!is_overlap) {
+        mem_cmp_result_t res;
+        mem_cmp((const uint8_t *)p_dst, (const uint8_t *)p_src, len, &res);
+        printf(", verify %s", (res.first == MEM_OPS_NONE) ? "OK" : "NG");
+    }
+    printf("\n");
+}
 
-        case CMD_SHA:
-            cmd_sha(p_args);
-            break;
+// crc: 種類の名前
+static const char *crc_type_name(crc_type_t type)
+{
+    return (type == CRC_TYPE_32) ? "CRC32" : "CRC16";
+}
 
-            case CMD_UNKNOWN:
-            cmd_unknown();
-            break;
+// crc: CPUで計算する(CRC_CHUNK_BYTESごとにキー入力を見る)
+static bool crc_calc_sw(crc_type_t type, uint32_t *p_crc, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t crc = crc_start(type);
+
+    for (uint32_t off = 0; off < len; off += CRC_CHUNK_BYTES)
+    {
+        uint32_t n = (len - off < CRC_CHUNK_BYTES) ? (len - off) : CRC_CHUNK_BYTES;
+        crc = crc_sw_update(type, crc, &p_data[off], n);
+        if (poll_key_abort()) {
+            printf("Aborted.\n");
+            return false;
+        }
+    }
+    *p_crc = crc;
+
+    return true;
+}
+
+// crc: DMAスニッファで計算する(転送中はキー入力だけ見る)
+static bool crc_calc_dma(crc_type_t type, uint32_t *p_crc, const uint8_t *p_data, uint32_t len)
+{
+    if (!crc_hw_start(type, crc_start(type), p_data, len)) {
+        printf("Error: DMA channel is busy.\n");
+        return false;
+    }
+    while (crc_hw_is_busy())
+    {
+        if (poll_key_abort()) {
+            crc_hw_abort();
+            printf("Aborted.\n");
+            return false;
+        }
+    }
+    *p_crc = crc_hw_finish();
+
+    return true;
+}
+
+// crc test: 既知の値と、DMAとCPUの結果が全てのアライン/端数で一致するか
+static void crc_test(void)
+{
+    static const uint8_t check_str[] = "123456789";
+    static const uint32_t check_tbl[CRC_TYPE_NUM] = {0xCBF43926UL, 0x29B1UL};
+    uint8_t *p_buf = mem_arena_alloc(&s_cmd_arena, CRC_TEST_BYTES + 4);
+    uint32_t ng = 0;
+    uint32_t num = 0;
+
+    if (p_buf == NULL) {
+        printf("Error: Out of memory.\n");
+        return;
+    }
+    for (uint32_t i = 0; i < CRC_TEST_BYTES + 4; i++)
+    {
+        p_buf[i] = (uint8_t)get_rand_32();
+    }
+
+    for (uint32_t t = 0; t < CRC_TYPE_NUM; t++)
+    {
+        crc_type_t type = (crc_type_t)t;
+        uint32_t sw = crc_sw_update(type, crc_start(type), check_str, 9);
+        uint32_t hw = crc_start(type);
+        uint32_t type_ng = 0;
+        if (!crc_hw_calc(type, &hw, check_str, 9)) {
+            printf("Error: DMA channel is busy.\n");
+            return;
+        }
+        printf("[CRC] %s(\"123456789\") = 0x%08X (expect 0x%08X), dma 0x%08X\n",
+                crc_type_name(type), sw, check_tbl[t], hw);
+        if (sw != check_tbl[t] || hw != check_tbl[t]) {
+            type_ng++;
+        }
+
+        // 先頭のアライン0～3 × 長さ(端数が全通り出るように)
+        for (uint32_t off = 0; off < 4; off++)
+        {
+            for (uint32_t len = 0; len <= CRC_TEST_BYTES; len += (len < 64) ? 1 : 61)
+            {
+                uint32_t ref = crc_bitwise_update(type, crc_start(type), &p_buf[off], len);
+                sw = crc_sw_update(type, crc_start(type), &p_buf[off], len);
+                hw = crc_start(type);
+                if (!crc_hw_calc(type, &hw, &p_buf[off], len) || sw != ref || hw != ref) {
+                    if (type_ng < 4) {
+                        printf("[CRC] %s NG: off %u len %u bitwise 0x%08X sw 0x%08X dma 0x%08X\n",
+                                crc_type_name(type), off, len, ref, sw, hw);
+                    }
+                    type_ng++;
+                }
+                num++;
+            }
+            WDT_RST();
+        }
+        ng += type_ng;
+    }
+    printf("[CRC] test: %u cases, %s (%u NG)\n", num, (ng == 0) ? "OK" : "NG", ng);
+}
+
+// crc bench: 1行分(ビット演算/スライス8/DMAの速度とDMAのCPU時間)
+static void crc_bench_row(crc_type_t type, const char *p_name, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t crc_bit, crc_sw, crc_hw;
+    uint32_t t0, t1, t2, t3, t4;
+
+    t0 = time_us_32();
+    crc_bit = crc_bitwise_update(type, crc_start(type), p_data, len);
+    t1 = time_us_32();
+    crc_sw = crc_sw_update(type, crc_start(type), p_data, len);
+    t2 = time_us_32();
+    if (!crc_hw_start(type, crc_start(type), p_data, len)) {
+        printf("Error: DMA channel is busy.\n");
+        return;
+    }
+    t3 = time_us_32();
+    while (crc_hw_is_busy())
+    {
+        tight_loop_contents();
+    }
+    t4 = time_us_32();
+    crc_hw = crc_hw_finish();
+    uint32_t t5 = time_us_32();
+    WDT_RST();
+
+    // DMAのCPU時間は設定(t2～t3)と結果の読み出し(t4～t5)だけ
+    uint32_t cpu_us = (t3 - t2) + (t5 - t4);
+    printf("%-6s %-6s %8.1f %8.1f %8.1f %7u %6.1f%%  %s\n", crc_type_name(type), p_name,
+            (double)membench_mbps(len, t1 - t0), (double)membench_mbps(len, t2 - t1),
+            (double)membench_mbps(len, t5 - t2), cpu_us,
+            (t5 > t2) ? 100.0 * (double)cpu_us / (double)(t5 - t2) : 0.0,
+            (crc_bit == crc_sw && crc_sw == crc_hw) ? "OK" : "NG");
+}
+
+// crc bench: SRAMとフラッシュ(XIPキャッシュ経由)でCPUとDMAスニッファを比べる
+static void crc_bench(uint32_t kb)
+{
+    uint32_t len = kb * 1024;
+    // 64～256KBはコマンド用アリーナに入らないのでヒープから
+    uint8_t *p_buf = malloc(len);
+
+    if (p_buf == NULL) {
+        printf("Error: Out of memory.\n");
+        return;
+    }
+    for (uint32_t i = 0; i < len; i += 4)
+    {
+        *(uint32_t *)&p_buf[i] = get_rand_32();
+    }
+
+    printf("\nCRC benchmark (%u KB, MB/s, dma cpu = setup + result read):\n", kb);
+    printf("type   src     bitwise   slice8      dma cpu(us)   cpu%%  verify\n");
+    for (uint32_t t = 0; t < CRC_TYPE_NUM; t++)
+    {
+        crc_bench_row((crc_type_t)t, "sram", p_buf, len);
+        crc_bench_row((crc_type_t)t, "flash", (const uint8_t *)XIP_BASE, len);
     }
+
+    free(p_buf);
 }
 
 /**
- * @brief メモリダンプコマンド関数
- * 
+ * @brief CRCコマンド関数
+ * @note crc #ADDR #LEN [32|16] [sw|dma]  ... 領域のCRC(既定はCRC32、DMAスニッファ)
+ *       crc test                          ... 既知の値とDMA/CPUの一致を確認
+ *       crc bench [KB]                    ... ビット演算/スライス8/DMAの速度比較
+ *
  * @param p_args コマンド引数の構造体ポインタ
  */
-static void cmd_mem_dump(const dbg_cmd_args_t* p_args)
+static void cmd_crc(const dbg_cmd_args_t* p_args)
 {
-    uint32_t addr;
-    uint32_t length;
+    const char *p_sub = p_args->p_argv[1];
+    crc_type_t type = CRC_TYPE_32;
+    bool is_dma = true;
+    uint32_t addr, len, crc;
 
-    if (p_args->argc != 3) {
-        printf("Error: Invalid number of arguments. Usage: mem_dump <address> <length>\n");
+    crc_init();
+    if (strcmp(p_sub, "test") == 0) {
+        crc_test();
+        return;
+    }
+    if (strcmp(p_sub, "bench") == 0) {
+        int32_t kb = (p_args->argc > 2) ? atoi(p_args->p_argv[2]) : CRC_BENCH_KB_DEF;
+        if (kb < 1 || kb > CRC_BENCH_KB_MAX) {
+            printf("Error: Invalid size. Must be 1-%d KB.\n", CRC_BENCH_KB_MAX);
+            return;
+        }
+        crc_bench((uint32_t)kb);
         return;
     }
 
-    // アドレスを16進数文字列から数値に変換
-    if (sscanf(p_args->p_argv[1], "#%x", &addr) != 1) {
-        printf("Error: Invalid address format. Use hexadecimal with # prefix (e.g., #F0000000)\n");
+    bool is_ok = (p_args->argc >= 3 && mem_arg_hex(p_args->p_argv[1], &addr) && mem_arg_hex(p_args->p_argv[2], &len));
+    for (int32_t i = 3; is_ok && i < p_args->argc; i++)
+    {
+        const char *p_opt = p_args->p_argv[i];
+        if (strcmp(p_opt, "32") == 0) {
+            type = CRC_TYPE_32;
+        } else if (strcmp(p_opt, "16") == 0) {
+            type = CRC_TYPE_16;
+        } else if (strcmp(p_opt, "sw") == 0) {
+            is_dma = false;
+        } else if (strcmp(p_opt, "dma") == 0) {
+            is_dma = true;
+        } else {
+            is_ok = false;
+        }
+    }
+    if (!is_ok) {
+        printf("Error: Usage: crc #ADDR #LEN [32|16] [sw|dma] | crc test | crc bench [KB]\n");
         return;
     }
 
-    // 長さを16進数文字列から数値に変換
-    if (sscanf(p_args->p_argv[2], "#%x", &length) != 1) {
-        printf("Error: Invalid length format. Use hexadecimal with # prefix (e.g., #10)\n");
+    const uint8_t *p_data = (const uint8_t *)(uintptr_t)addr;
+    uint32_t start_time = time_us_32();
+    is_ok = is_dma ? crc_calc_dma(type, &crc, p_data, len) : crc_calc_sw(type, &crc, p_data, len);
+    uint32_t end_time = time_us_32();
+    if (!is_ok) {
         return;
     }
 
-    volatile uint32_t start_time = time_us_32();
-    show_mem_dump(addr, length);
-    volatile uint32_t end_time = time_us_32();
-    printf("\nMemory dump completed (proc time: %u us)\n", end_time - start_time);
+    printf("[CRC] %s 0x%08X-0x%08X (%s): 0x%0*X, %u bytes in %u us = %.1f MB/s\n", crc_type_name(type),
+            addr, addr + len - 1, is_dma ? "dma" : "sw", (type == CRC_TYPE_32) ? 8 : 4, crc, len,
+            end_time - start_time, (double)membench_mbps(len, end_time - start_time));
 }
 
 /**
@@ -702,6 +4503,11 @@ static void cmd_i2c(const dbg_cmd_args_t* p_args)
         printf("Error: Only I2C ports 0 and 1 are supported.\n");
         return;
     }
+    // I2Cは遅延初期化(最初に使うときに初期化)
+    if (!boot_hw_require((port == 0) ? BOOT_TASK_I2C0 : BOOT_TASK_I2C1)) {
+        printf("Error: I2C%d cannot be initialized on this core.\n", port);
+        return;
+    }
 
     const char* cmd = p_args->p_argv[2];
 
@@ -713,64 +4519,289 @@ static void cmd_i2c(const dbg_cmd_args_t* p_args)
     }
 }
 
+// reg: レジスタの読み書き(reg_ops_tの実機側)
+static uint32_t reg_hw_read(uint32_t addr)
+{
+    return REG_READ_DWORD(0, addr);
+}
+
+static void reg_hw_write(uint32_t addr, uint32_t val)
+{
+    REG_WRITE_DWORD(0, addr, val);
+}
+
+static uint32_t reg_hw_lock(void)
+{
+    return save_and_disable_interrupts();
+}
+
+static void reg_hw_unlock(uint32_t save)
+{
+    restore_interrupts(save);
+}
+
+static uint32_t reg_hw_now_us(void)
+{
+    return time_us_32();
+}
+
+static const reg_ops_t s_reg_ops = {
+    .read = reg_hw_read,
+    .write = reg_hw_write,
+    .lock = reg_hw_lock,
+    .unlock = reg_hw_unlock,
+    .now_us = reg_hw_now_us,
+    .cycles = dwt_get_cycles,
+    .kick = WDT_RST,
+};
+
+// reg diffの基準(reg snapで取る)
+static reg_snap_t s_reg_snap_base;
+static bool s_is_reg_snap_base = false;
+
+// reg: アドレスのブロックがリセット中でないか(リセット中の周辺を触るとバスフォルトになる)
+static bool reg_check_reset(uint32_t addr)
+{
+    const reg_block_t *p_block = reg_map_block_of(addr);
+
+    if (p_block == NULL || p_block->reset_bit == REG_MAP_NO_RESET) {
+        return true;
+    }
+    if ((resets_hw->reset_done & (1UL << p_block->reset_bit)) == 0) {
+        printf("Error: %s is held in reset\n", p_block->p_name);
+        return false;
+    }
+
+    return true;
+}
+
+// reg: スナップショットの全アドレスを確認(範囲はブロックをまたぐことがある)
+static bool reg_check_reset_snap(const reg_snap_t *p_snap)
+{
+    const reg_block_t *p_last = NULL;
+
+    for (uint32_t i = 0; i < p_snap->num; i++)
+    {
+        const reg_block_t *p_block = reg_map_block_of(p_snap->addr[i]);
+        if (p_block != p_last && !reg_check_reset(p_snap->addr[i])) {
+            return false;
+        }
+        p_last = p_block;
+    }
+
+    return true;
+}
+
+// reg: アドレスの名前(表に無ければ空)
+static const char *reg_name(uint32_t addr, char *p_buf, uint32_t size)
+{
+    if (!reg_map_name_of(addr, p_buf, size)) {
+        p_buf[0] = '\0';
+    }
+    return p_buf;
+}
+
+// reg snap/dump: 対象の計画を立てる
+static bool reg_plan(const reg_cmd_t *p_cmd, reg_snap_t *p_snap)
+{
+    bool is_ok = (p_cmd->p_block != NULL) ? reg_snap_plan_block(p_snap, p_cmd->p_block)
+                                          : reg_snap_plan_range(p_snap, p_cmd->addr, p_cmd->len);
+
+    if (!is_ok) {
+        printf("Error: Too many registers (max %d)\n", REG_SNAP_MAX);
+        return false;
+    }
+    if (p_snap->num == 0) {
+        printf("Error: Nothing to read (all registers have read side effects)\n");
+        return false;
+    }
+
+    return reg_check_reset_snap(p_snap);
+}
+
+// reg list: ブロックの一覧かブロックのレジスタの一覧
+static void reg_list(const reg_block_t *p_block)
+{
+    if (p_block == NULL) {
+        printf("[REG] Blocks (reg list <block> for registers)\n");
+        printf("  %-12s %-10s %5s  %s\n", "Block", "Base", "Regs", "Reset");
+        for (uint32_t i = 0; i < reg_map_block_num(); i++)
+        {
+            const reg_block_t *p_blk = reg_map_block(i);
+            const char *p_state = "-";
+            if (p_blk->reset_bit != REG_MAP_NO_RESET) {
+                p_state = ((resets_hw->reset_done & (1UL << p_blk->reset_bit)) != 0) ? "out" : "held";
+            }
+            printf("  %-12s 0x%08X %5u  %s\n", p_blk->p_name, (unsigned)p_blk->base, p_blk->reg_num, p_state);
+        }
+        return;
+    }
+
+    printf("[REG] %s @ 0x%08X (~: changes by itself, !: read has side effects)\n",
+           p_block->p_name, (unsigned)p_block->base);
+    for (uint32_t i = 0; i < p_block->reg_num; i++)
+    {
+        const reg_def_t *p_reg = &p_block->p_regs[i];
+        char mark = ((p_reg->flags & REG_F_NO_SNAP) != 0) ? '!' : (((p_reg->flags & REG_F_VOLATILE) != 0) ? '~' : ' ');
+        if (p_reg->num > 1) {
+            printf("  +0x%03X %c %s[%u] (stride 0x%X)\n", p_reg->offset, mark, p_reg->p_name, p_reg->num, p_reg->stride);
+        } else {
+            printf("  +0x%03X %c %s\n", p_reg->offset, mark, p_reg->p_name);
+        }
+    }
+}
+
+// reg diff: 基準を取ったときと同じアドレスを読み直して比べる
+static void reg_diff(void)
+{
+    char name[REG_MAP_NAME_MAX];
+
+    if (!s_is_reg_snap_base) {
+        printf("Error: No snapshot. Run 'reg snap <block>' first\n");
+        return;
+    }
+    reg_snap_t *p_cur = mem_arena_alloc(&s_cmd_arena, sizeof(reg_snap_t));
+    reg_diff_t *p_diff = mem_arena_alloc(&s_cmd_arena, sizeof(reg_diff_t) * REG_SNAP_MAX);
+    if (p_cur == NULL || p_diff == NULL) {
+        printf("Error: Out of command arena\n");
+        return;
+    }
+    *p_cur = s_reg_snap_base;
+    if (!reg_check_reset_snap(p_cur)) {
+        return;
+    }
+    reg_snap_take(p_cur, &s_reg_ops);
+
+    uint32_t num = reg_snap_diff(&s_reg_snap_base, p_cur, p_diff, REG_SNAP_MAX);
+    for (uint32_t i = 0; i < num; i++)
+    {
+        const reg_diff_t *p_d = &p_diff[i];
+        printf("  0x%08X %-*s 0x%08X -> 0x%08X  set 0x%08X clr 0x%08X\n",
+               (unsigned)p_d->addr, REG_NAME_COL, reg_name(p_d->addr, name, sizeof(name)),
+               (unsigned)p_d->old_val, (unsigned)p_d->new_val,
+               (unsigned)(p_d->new_val & ~p_d->old_val), (unsigned)(p_d->old_val & ~p_d->new_val));
+    }
+    printf("[REG] Diff: %u of %u registers changed (baseline kept, 'reg snap' to update)\n",
+           (unsigned)num, (unsigned)p_cur->num);
+}
+
 /**
- * @brief レジスタR/Wコマンド関数
- * 
+ * @brief レジスタ操作コマンド関数
+ * @note アドレスは#HEXか名前(reg listで一覧)、rmwとpollは32bitで、rmwは割り込みを止めて行う
+ *
  * @param p_args コマンド引数の構造体ポインタ
  */
 static void cmd_reg(const dbg_cmd_args_t* p_args)
 {
-    uint32_t wval = 0;
-    uint32_t val = 0;
-    uint32_t addr = 0;
-    uint32_t rval = 0;
+    reg_cmd_t cmd;
+    char name[REG_MAP_NAME_MAX + 1];
 
-    if (p_args->argc != 4 && p_args->argc != 5) {
-        printf("Error: Usage: reg #ADDR r|w BITS [#VAL]\n");
+    const char *p_err = reg_cmd_parse(p_args->argc, p_args->p_argv, &cmd);
+    if (p_err != NULL) {
+        printf("Error: %s\n", p_err);
         printf("  e.g. reg #F000FF00 r 8\n");
-        printf("  e.g. reg #F000FF00 w 32 #FFDC008F\n");
+        printf("  e.g. reg UART0.UARTLCR_H rmw #3 #3 5\n");
+        printf("  e.g. reg DMA.CH_CTRL_TRIG[0] poll #04000000 #0 100\n");
+        printf("  e.g. reg snap I2C0 / reg diff\n");
         return;
     }
 
-    if (sscanf(p_args->p_argv[1], "#%x", &addr) != 1) {
-        printf("Error: Invalid address format. Use #HEX (e.g. #F000FF00)\n");
-        return;
+    switch (cmd.op)
+    {
+        case REG_OP_LIST:
+            reg_list(cmd.p_block);
+            return;
+
+        case REG_OP_DIFF:
+            reg_diff();
+            return;
+
+        case REG_OP_SNAP:
+            if (reg_plan(&cmd, &s_reg_snap_base)) {
+                reg_snap_take(&s_reg_snap_base, &s_reg_ops);
+                s_is_reg_snap_base = true;
+                printf("[REG] Snapshot: %u registers saved. Run 'reg diff' to compare\n",
+                       (unsigned)s_reg_snap_base.num);
+            } else {
+                s_is_reg_snap_base = false;
+            }
+            return;
+
+        case REG_OP_DUMP:
+        {
+            reg_snap_t *p_snap = mem_arena_alloc(&s_cmd_arena, sizeof(reg_snap_t));
+            if (p_snap == NULL) {
+                printf("Error: Out of command arena\n");
+                return;
+            }
+            if (!reg_plan(&cmd, p_snap)) {
+                return;
+            }
+            reg_snap_take(p_snap, &s_reg_ops);
+            for (uint32_t i = 0; i < p_snap->num; i++)
+            {
+                printf("  0x%08X %-*s 0x%08X%s\n", (unsigned)p_snap->addr[i], REG_NAME_COL,
+                       reg_name(p_snap->addr[i], name, sizeof(name)), (unsigned)p_snap->val[i],
+                       ((p_snap->flags[i] & REG_F_VOLATILE) != 0) ? " ~" : "");
+            }
+            return;
+        }
+
+        default:
+            break;
     }
-    char rw = p_args->p_argv[2][0];
-    int bits = atoi(p_args->p_argv[3]);
-    if (!(bits == 8 || bits == 16 || bits == 32)) {
-        printf("Error: Bit width must be 8, 16, or 32\n");
+
+    if (!reg_check_reset(cmd.addr)) {
         return;
     }
-    if (rw == 'r') { // 読み取り
-        if (p_args->argc != 4) {
-            printf("Error: Read usage: reg #ADDR r BITS\n");
-            return;
-        }
+    // 名前があれば「 名前」、無ければ空(従来の表示のまま)
+    name[0] = ' ';
+    if (reg_name(cmd.addr, &name[1], sizeof(name) - 1)[0] == '\0') {
+        name[0] = '\0';
+    }
+
+    if (cmd.op == REG_OP_READ) {
+        uint32_t val = 0;
         // app_main.hのマクロを使用
-        if (bits == 8) val = REG_READ_BYTE(0, addr);
-        else if (bits == 16) val = REG_READ_WORD(0, addr);
-        else if (bits == 32) val = REG_READ_DWORD(0, addr);
-        printf("[REG] Read %dbit @ 0x%08X = 0x%0*X\n", bits, addr, bits / 4, val);
-    } else if (rw == 'w') { // 書き込み
-        sscanf(p_args->p_argv[4], "#%x", &wval);
-        if (bits == 8) {
-            REG_WRITE_BYTE(0, addr, (uint8_t)wval);
-        } else if (bits == 16) {
-            REG_WRITE_WORD(0, addr, (uint16_t)wval);
-        } else if (bits == 32) {
-            REG_WRITE_DWORD(0, addr, (uint32_t)wval);
-        }
-        printf("[REG] Write %dbit @ 0x%08X = 0x%0*X\n", bits, addr, bits / 4, wval);
+        if (cmd.bits == 8) val = REG_READ_BYTE(0, cmd.addr);
+        else if (cmd.bits == 16) val = REG_READ_WORD(0, cmd.addr);
+        else val = REG_READ_DWORD(0, cmd.addr);
+        printf("[REG] Read %ubit @ 0x%08X%s = 0x%0*X\n", (unsigned)cmd.bits, (unsigned)cmd.addr, name,
+               (int)(cmd.bits / 4), (unsigned)val);
+    } else if (cmd.op == REG_OP_WRITE) {
+        if (cmd.bits == 8) {
+            REG_WRITE_BYTE(0, cmd.addr, (uint8_t)cmd.val);
+        } else if (cmd.bits == 16) {
+            REG_WRITE_WORD(0, cmd.addr, (uint16_t)cmd.val);
         } else {
-        printf("Error: 2nd arg must be 'r' or 'w'\n");
+            REG_WRITE_DWORD(0, cmd.addr, cmd.val);
+        }
+        printf("[REG] Write %ubit @ 0x%08X%s = 0x%0*X\n", (unsigned)cmd.bits, (unsigned)cmd.addr, name,
+               (int)(cmd.bits / 4), (unsigned)cmd.val);
+    } else if (cmd.op == REG_OP_RMW) {
+        uint32_t old_val;
+        uint32_t new_val = reg_rmw(&s_reg_ops, cmd.addr, cmd.mask, cmd.val, cmd.shift, &old_val);
+        printf("[REG] RMW @ 0x%08X%s: 0x%08X -> 0x%08X (mask 0x%08X)\n", (unsigned)cmd.addr, name,
+               (unsigned)old_val, (unsigned)new_val, (unsigned)(cmd.mask << cmd.shift));
+    } else {
+        reg_poll_result_t result;
+        reg_poll(&s_reg_ops, &cmd, &result);
+        printf("[REG] Poll @ 0x%08X%s: (val & 0x%08X) %s 0x%08X -> %s\n", (unsigned)cmd.addr, name,
+               (unsigned)cmd.mask, cmd.is_ne ? "!=" : "==", (unsigned)cmd.val,
+               result.is_match ? "match" : "TIMEOUT");
+        printf("  reads=%u, cycles=%u, time=%u us, last=0x%08X\n", (unsigned)result.reads,
+               (unsigned)result.cycles, (unsigned)result.us, (unsigned)result.val);
     }
 }
 
 /**
  * @brief デバッグコマンドモニターのメイン処理
+ * @note 入力が無ければすぐ戻る(ループでタイマーサービス等と一緒に回す)
+ *
+ * @return true 1文字処理した
+ * @return false 入力が無かった
  */
-void dbg_com_process(void)
+bool HOT_FUNC(dbg_com_process)(void)
 {
     dbg_cmd_args_t args;
 
@@ -778,7 +4809,12 @@ void dbg_com_process(void)
         s_cmd_index = 0;
     }
 
-    int32_t c = getchar();
+    int32_t c = getchar_timeout_us(0);
+    if (c == PICO_ERROR_TIMEOUT) {
+        return false;
+    }
+
+    TRACE_BEGIN(TRACE_ID_CORE1_LOOP, c);
     // デリミタでCRかLFが来たらコマンドの受付を終わる
     if (c == '\r' || c == '\n') {
         if (s_cmd_index > 0) {
@@ -788,7 +4824,7 @@ void dbg_com_process(void)
             // コマンド履歴に入力されたコマンドを追加
             add_to_cmd_history(s_cmd_buffer);
 
-            split_str(s_cmd_buffer, &args);
+            dbg_args_split(s_cmd_buffer, &args);
             if (args.argc > 0) {
                 dbg_cmd_t cmd = dbg_com_parse_cmd(args.p_argv[0], &args);
                 dbg_com_execute_cmd(cmd, &args);
@@ -845,4 +4881,8 @@ void dbg_com_process(void)
         s_cmd_buffer[s_cmd_index++] = c;
         putchar(c);
     }
-}
\ No newline at end of file
+    TRACE_END(TRACE_ID_CORE1_LOOP, c);
+
+    return true;
+}
+HOT_PATH_REGISTER(dbg_com_process);
\ No newline at end of file
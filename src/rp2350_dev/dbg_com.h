@@ -24,12 +24,14 @@
 #include "pico/time.h"
 #include "hardware/gpio.h"
 #include "hardware/i2c.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/xip_cache.h"
+#include "dbg_args.h"
 
 // #define DEBUG_DBG_COM      // デバッグ用
 
 // コマンド関連のマクロ
-#define DBG_CMD_MAX_LEN 32 // コマンドの最大長
-#define DBG_CMD_MAX_ARGS 5 // コマンドの最大引数数
+#define DBG_CMD_MAX_LEN 64 // コマンドの最大長
 #define CMD_HISTORY_MAX 16 // コマンド履歴の最大数
 
 // GPIOの最大ピン番号（RP2350）
@@ -40,7 +42,92 @@
 
 // タイマー関連の定数
 #define TIMER_MAX_SECONDS 3600  // 最大1時間
-#define TIMER_MAX_ALARMS 4      // RP2350のH/Wタイマー数
+#define TIMER_LIST_MAX 16       // timer listで表示する最大数
+
+// メモリ帯域ベンチマーク関連の定数
+#define MEMBENCH_STREAM_N_DEF   2048            // STREAM配列の要素数(1コアあたり)
+#define MEMBENCH_STREAM_N_MAX   8192            // STREAM配列の最大要素数
+#define MEMBENCH_STREAM_REPS    10              // STREAMカーネルの繰り返し回数
+#define MEMBENCH_COPY_MAX       16384           // memcpy/memsetの最大サイズ
+#define MEMBENCH_ALIGN_SIZE     4096            // アライメント比較のサイズ
+#define MEMBENCH_REGION_SIZE    512             // 領域比較のサイズ(SCRATCH X/Yに置ける大きさ)
+#define MEMBENCH_XFER_BYTES     (256 * 1024)    // 1計測あたりの総転送量の目安
+
+// DMAサービスのテスト関連の定数
+#define DMA_TEST_SIZE           4096            // テストの転送サイズ
+#define DMA_TEST_QUEUE_JOBS     8               // キューイングテストのジョブ数
+
+// XIPキャッシュ統計関連の定数
+#define XIP_BENCH_SPAN_SMALL    (8 * 1024)      // キャッシュ(16KB)に収まる範囲
+#define XIP_BENCH_SPAN_LARGE    (64 * 1024)     // キャッシュに収まらない範囲
+#define XIP_BENCH_PASSES        4               // 範囲を読み出す回数
+#define XIP_EXEC_CALLS          100             // カーネルの呼び出し回数
+#define XIP_EXEC_ITERATIONS     64              // カーネル1回あたりの反復回数
+
+// サンプリングプロファイラ関連の定数
+#define PROF_TOP_NUM            10              // prof statで表示する上位の数
+
+// イベントトレース関連の定数
+#define TRACE_DUMP_EVENTS_PER_LINE  4           // trace dumpの1行あたりのイベント数
+
+// メモリ(アリーナ、プール)関連の定数
+#define DBG_CMD_ARENA_SIZE      8192            // コマンド用アリーナのバイト数
+#define MEM_BENCH_BURST         8               // mem benchで続けて確保する数
+#define MEM_BENCH_ROUNDS        1000            // mem benchの繰り返し回数
+
+// ジッタ計測関連の定数
+#define JITTER_RATE_DEF         1000            // アラームの周波数のデフォルト(Hz)
+#define JITTER_RATE_MIN         1
+#define JITTER_RATE_MAX         50000
+#define JITTER_SEC_DEF          2               // 計測時間のデフォルト(秒)
+#define JITTER_SEC_MAX          60
+#define JITTER_BAR_WIDTH        40              // 分布の棒グラフの最大幅
+
+// 割り込み応答時間計測関連の定数
+#define IRQLAT_SAMPLES_DEF      1000            // 1構成あたりのサンプル数のデフォルト
+#define IRQLAT_SAMPLES_MAX      100000
+
+// ロジックアナライザ関連の定数
+#define LA_SAMPLES_DEF          8192            // サンプル数のデフォルト
+#define LA_DUMP_BYTES_PER_LINE  32              // ダンプ1行のバイト数(RLE)
+
+// 周波数カウンタ関連の定数
+#define FREQ_GATE_MS_DEF        100             // ゲート時間のデフォルト(ms)
+#define FREQ_GATE_MS_MAX        1000
+#define FREQ_GATES_DEF          10              // ゲート数(バッファに入らなければ減らす)
+#define FREQ_PERIODS_DEF        1000            // パルス幅を測る周期数のデフォルト
+#define FREQ_PERIODS_MAX        2000
+#define FREQ_PULSE_TIMEOUT_MS   2000            // パルス幅計測のタイムアウト
+#define FREQ_PULSE_CYCLES_MIN   10              // パルス幅を測る1周期の最小サイクル数(これより速ければ省略)
+
+// クロック変更関連の定数
+#define CLK_BENCH_POINTS_MAX    8               // clk benchで試すクロックの数
+
+// データパイプ関連の定数
+#define PIPE_BENCH_CHUNK        4096            // ベンチマークの1回のsubmit(1フレーム)
+#define PIPE_BENCH_MB_DEF       4               // ベンチマークのデフォルトのサイズ(MB)
+#define PIPE_BENCH_MB_MAX       64
+#define PIPE_TIMEOUT_MS         3000            // 進まなくなってからのタイムアウト
+#define PIPE_RX_WAIT_MS         10000           // 受信ベンチマークで最初のバイトを待つ時間
+#define PIPE_KEY_CHECK_US       10000           // 中断キーを見る間隔
+
+// UART関連の定数
+#define UART_BENCH_MS           200             // 1レートでスループットを測る時間(この時間で送れるバイト数を送る)
+#define UART_BENCH_BYTES_MIN    256
+#define UART_BENCH_LAT_NUM      32              // 1バイトの往復を測る回数
+#define UART_BENCH_TIMEOUT_MS   100             // 受信が進まなくなってからのタイムアウト
+
+// メモリの検索/フィル/比較/コピー関連の定数
+#define MEM_FIND_SHOW_MAX       16              // mem_findで表示するアドレスの数(数えるのは全部)
+
+// レジスタ操作関連の定数
+#define REG_NAME_COL            28              // reg dump/diffの名前の表示幅
+
+// CRC関連の定数
+#define CRC_CHUNK_BYTES         0x10000         // CPUで計算するときにキー入力を見る間隔
+#define CRC_TEST_BYTES          1024            // crc testで確認する最大の長さ
+#define CRC_BENCH_KB_DEF        64
+#define CRC_BENCH_KB_MAX        256
 
 // キーボードのコード定義
 #define KEY_ESC         27    // ESCキー
@@ -65,10 +152,33 @@ typedef enum {
     CMD_ATAN2,      // atan2テスト
     CMD_TAN355,     // tan(355/226)テスト
     CMD_ISQRT,      // 逆平方根テスト
+    CMD_FFT,        // FFTベンチマーク
+    CMD_MEMBENCH,   // メモリ帯域ベンチマーク
+    CMD_DMA,        // DMAサービス
+    CMD_XIP,        // XIPキャッシュ統計
+    CMD_RAM,        // SRAM常駐コード一覧
+    CMD_PROF,       // サンプリングプロファイラ
+    CMD_TRACE,      // イベントトレース
+    CMD_PERF,       // H/Wカウンタ(DWT、XIPキャッシュ)
+    CMD_MEM,        // スタック/アリーナ/プールの使用状況
+    CMD_JITTER,     // アラームのジッタ計測
+    CMD_IRQLAT,     // 割り込みの応答時間計測
+    CMD_LA,         // ロジックアナライザ
+    CMD_FREQ,       // 周波数カウンタ、パルス幅計測
+    CMD_CLK,        // クロック変更
+    CMD_IDLE,       // アイドルの滞在率、起床レイテンシ
+    CMD_PIPE,       // USBのデータパイプ(CDC1)
+    CMD_UART,       // UARTのリングバッファ、シェル、ベンチマーク
+    CMD_BOOT,       // 起動の時刻、初期化タスク
     CMD_TIMER,      // タイマーコマンド
     CMD_GPIO,       // GPIO制御
     CMD_I2C,        // I2C制御
     CMD_MEM_DUMP,   // メモリダンプ
+    CMD_MEM_FIND,   // メモリ検索
+    CMD_MEM_FILL,   // メモリフィル
+    CMD_MEM_CMP,    // メモリ比較
+    CMD_MEM_CPY,    // メモリコピー
+    CMD_CRC,        // メモリ領域のCRC(DMAスニッファ)
     CMD_REG,        // レジスタ操作8/16/32bit
     CMD_RST,        // リセット
     CMD_UNKNOWN     // 不明なコマンド
@@ -83,23 +193,8 @@ typedef struct {
     int32_t max_args;          // 最大引数数
 } dbg_cmd_info_t;
 
-// コマンド引数構造体
-typedef struct {
-    int32_t argc;                    // 引数の数
-    char* p_argv[DBG_CMD_MAX_ARGS]; // 引数の配列
-} dbg_cmd_args_t;
-
-// タイマー状態
-typedef struct {
-    bool is_running;      // タイマー実行中フラグ
-    uint32_t start_time;  // 開始時間
-    uint32_t duration;    // 設定時間（us）
-    alarm_id_t alarm_id;  // アラームID
-    uint8_t reg_order;    // 登録順序（1から開始）
-} timer_state_t;
-
 // 関数プロトタイプ
 void dbg_com_init(void);
-void dbg_com_process(void);
+bool dbg_com_process(void);
 
 #endif // DBG_COM_H
\ No newline at end of file
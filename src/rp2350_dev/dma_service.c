@@ -0,0 +1,561 @@
+/**
+ * @file dma_service.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 非同期DMAサービス(チャネルプール、ジョブキュー)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "dma_service.h"
+
+// ジョブの状態
+typedef enum {
+    DMA_SVC_JOB_FREE,
+    DMA_SVC_JOB_QUEUED,
+    DMA_SVC_JOB_RUNNING,
+} dma_svc_job_state_t;
+
+// ジョブ
+typedef struct dma_svc_job {
+    dma_svc_xfer_t xfer;
+    dma_svc_sg_t sg[DMA_SVC_SG_MAX];    // スキャッタギャザーの写し(xfer.p_sgはここを指す)
+    uint32_t bytes;                     // 総バイト数(投入時に計算)
+    dma_svc_callback_t callback;
+    void *p_arg;
+    volatile uint8_t state;     // dma_svc_job_state_t
+    volatile uint16_t gen;      // 世代(スロット再利用で古いハンドルを区別)
+    uint8_t pool_idx;           // 実行中のチャネル(s_pool[]の番号)
+    uint32_t submit_us;
+    uint32_t start_us;
+    struct dma_svc_job *p_next; // キューの次のジョブ
+} dma_svc_job_t;
+
+// プールのチャネル
+typedef struct {
+    uint32_t ch;
+    dma_svc_job_t *p_job;       // 実行中のジョブ(NULLなら空き)
+    bool is_reserved;           // dma_svc_ch_acquire()で貸し出し中
+} dma_svc_pool_t;
+
+static const dma_svc_hw_ops_t *s_p_ops = NULL;
+static dma_svc_pool_t s_pool[DMA_SVC_CH_NUM];
+static uint32_t s_pool_num = 0;
+static dma_svc_job_t s_job[DMA_SVC_JOB_NUM];
+static dma_svc_job_t *s_p_queue_head = NULL;
+static dma_svc_job_t *s_p_queue_tail = NULL;
+static dma_svc_stats_t s_stats;
+
+static inline dma_svc_handle_t job_to_handle(const dma_svc_job_t *p_job)
+{
+    return ((uint32_t)p_job->gen << 8) | (uint32_t)(p_job - s_job + 1);
+}
+
+static inline dma_svc_job_t *handle_to_job(dma_svc_handle_t handle)
+{
+    uint32_t idx = (handle & 0xFF);
+
+    if (idx == 0 || idx > DMA_SVC_JOB_NUM) {
+        return NULL;
+    }
+
+    return &s_job[idx - 1];
+}
+
+static inline bool is_handle_live(const dma_svc_job_t *p_job, dma_svc_handle_t handle)
+{
+    return (p_job->state != DMA_SVC_JOB_FREE) && (p_job->gen == (uint16_t)(handle >> 8));
+}
+
+// 空きチャネルでジョブを開始(ロック中に呼ぶ)
+static void job_start(dma_svc_job_t *p_job, uint32_t pool_idx)
+{
+    uint32_t now = s_p_ops->now_us();
+    uint32_t wait_us = now - p_job->submit_us;
+
+    p_job->state = DMA_SVC_JOB_RUNNING;
+    p_job->pool_idx = (uint8_t)pool_idx;
+    p_job->start_us = now;
+    s_pool[pool_idx].p_job = p_job;
+    s_stats.ch_busy++;
+    s_stats.wait_us_total += wait_us;
+    if (wait_us > s_stats.wait_us_max) {
+        s_stats.wait_us_max = wait_us;
+    }
+
+    s_p_ops->start(s_pool[pool_idx].ch, &p_job->xfer);
+}
+
+// キューの先頭を取り出す(ロック中に呼ぶ)
+static dma_svc_job_t *queue_pop(void)
+{
+    dma_svc_job_t *p_job = s_p_queue_head;
+
+    if (p_job != NULL) {
+        s_p_queue_head = p_job->p_next;
+        if (s_p_queue_head == NULL) {
+            s_p_queue_tail = NULL;
+        }
+        p_job->p_next = NULL;
+        s_stats.queue_depth--;
+    }
+
+    return p_job;
+}
+
+// 空いているプールのチャネルを探す(ロック中に呼ぶ)
+static int32_t pool_find_idle(void)
+{
+    for (uint32_t i = 0; i < s_pool_num; i++)
+    {
+        if (s_pool[i].p_job == NULL && !s_pool[i].is_reserved) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief ジョブを終了させてチャネルを次のジョブに回す(ロック中に呼ぶ)
+ * @note コールバックはロック解放後に呼ぶので、呼び出し元に返す
+ */
+static void job_finish(dma_svc_job_t *p_job, dma_svc_status_t status,
+                       dma_svc_callback_t *p_callback, void **pp_arg)
+{
+    uint32_t now = s_p_ops->now_us();
+
+    if (p_job->state == DMA_SVC_JOB_RUNNING) {
+        uint32_t pool_idx = p_job->pool_idx;
+        s_pool[pool_idx].p_job = NULL;
+        s_stats.ch_busy--;
+        s_stats.busy_us_total += now - p_job->start_us;
+
+        // 同じチャネルで次のジョブを開始
+        if (!s_pool[pool_idx].is_reserved) {
+            dma_svc_job_t *p_next = queue_pop();
+            if (p_next != NULL) {
+                job_start(p_next, pool_idx);
+            }
+        }
+    }
+
+    if (status == DMA_SVC_OK) {
+        s_stats.jobs_done++;
+        s_stats.bytes += p_job->bytes;
+    } else {
+        s_stats.jobs_aborted++;
+    }
+
+    *p_callback = p_job->callback;
+    *pp_arg = p_job->p_arg;
+    p_job->state = DMA_SVC_JOB_FREE;
+}
+
+/**
+ * @brief DMAサービスの初期化
+ *
+ * @param p_ops H/W層の操作
+ * @return true 成功(1チャネル以上確保)
+ * @return false チャネルを確保できない
+ */
+bool dma_svc_init(const dma_svc_hw_ops_t *p_ops)
+{
+    s_p_ops = p_ops;
+    s_pool_num = 0;
+    s_p_queue_head = NULL;
+    s_p_queue_tail = NULL;
+
+    for (uint32_t i = 0; i < DMA_SVC_JOB_NUM; i++)
+    {
+        s_job[i].state = DMA_SVC_JOB_FREE;
+        s_job[i].gen = 0;
+        s_job[i].p_next = NULL;
+    }
+
+    for (uint32_t i = 0; i < DMA_SVC_CH_NUM; i++)
+    {
+        uint32_t ch;
+        if (!p_ops->ch_claim(&ch)) {
+            break;
+        }
+        s_pool[s_pool_num].ch = ch;
+        s_pool[s_pool_num].p_job = NULL;
+        s_pool[s_pool_num].is_reserved = false;
+        s_pool_num++;
+    }
+    s_stats = (dma_svc_stats_t){0};
+
+    return (s_pool_num > 0);
+}
+
+/**
+ * @brief 転送を投入(空きチャネルがあれば即開始、なければキューで待つ)
+ *
+ * @param p_xfer 転送内容(スキャッタギャザーの配列ごとコピーされるので呼び出し後に破棄してよい)
+ * @param callback 完了コールバック(NULL可)
+ * @param p_arg コールバックの引数
+ * @return dma_svc_handle_t ハンドル(ジョブ枠不足ならDMA_SVC_HANDLE_INVALID)
+ */
+dma_svc_handle_t dma_svc_submit(const dma_svc_xfer_t *p_xfer, dma_svc_callback_t callback, void *p_arg)
+{
+    dma_svc_job_t *p_job = NULL;
+    dma_svc_handle_t handle = DMA_SVC_HANDLE_INVALID;
+
+    if (s_p_ops == NULL || (p_xfer->p_sg != NULL && (p_xfer->sg_num == 0 || p_xfer->sg_num > DMA_SVC_SG_MAX))) {
+        return DMA_SVC_HANDLE_INVALID;
+    }
+    uint32_t bytes = dma_svc_xfer_bytes(p_xfer);
+
+    uint32_t save = s_p_ops->lock();
+    for (uint32_t i = 0; i < DMA_SVC_JOB_NUM; i++)
+    {
+        if (s_job[i].state == DMA_SVC_JOB_FREE) {
+            p_job = &s_job[i];
+            break;
+        }
+    }
+
+    if (p_job == NULL) {
+        s_stats.submit_rejects++;
+    } else {
+        p_job->xfer = *p_xfer;
+        p_job->bytes = bytes;
+        // 開始はキューを抜けた後(割り込みの中)なので、呼び出し元の配列は指さない
+        if (p_xfer->p_sg != NULL) {
+            for (uint32_t i = 0; i < p_xfer->sg_num; i++)
+            {
+                p_job->sg[i] = p_xfer->p_sg[i];
+            }
+            p_job->xfer.p_sg = p_job->sg;
+        }
+        if (p_job->xfer.is_fill) {
+            p_job->xfer.p_src = &p_job->xfer.fill_word;
+            p_job->xfer.is_read_incr = false;
+        }
+        p_job->callback = callback;
+        p_job->p_arg = p_arg;
+        p_job->gen++;
+        p_job->submit_us = s_p_ops->now_us();
+        p_job->p_next = NULL;
+        handle = job_to_handle(p_job);
+
+        int32_t pool_idx = pool_find_idle();
+        if (pool_idx >= 0) {
+            job_start(p_job, (uint32_t)pool_idx);
+        } else {
+            p_job->state = DMA_SVC_JOB_QUEUED;
+            if (s_p_queue_tail == NULL) {
+                s_p_queue_head = p_job;
+            } else {
+                s_p_queue_tail->p_next = p_job;
+            }
+            s_p_queue_tail = p_job;
+            s_stats.queue_depth++;
+            if (s_stats.queue_depth > s_stats.queue_depth_max) {
+                s_stats.queue_depth_max = s_stats.queue_depth;
+            }
+        }
+    }
+    s_p_ops->unlock(save);
+
+    return handle;
+}
+
+/**
+ * @brief 非同期memcpy(アライメントに応じて8/16/32bit転送)
+ */
+dma_svc_handle_t dma_svc_memcpy_async(void *p_dst, const void *p_src, uint32_t len,
+                                      dma_svc_callback_t callback, void *p_arg)
+{
+    dma_svc_xfer_t xfer = {0};
+
+    xfer.p_dst = p_dst;
+    xfer.p_src = p_src;
+    xfer.size = dma_svc_size_for(p_dst, p_src, len);
+    xfer.count = len >> xfer.size;
+    xfer.is_read_incr = true;
+    xfer.is_write_incr = true;
+    xfer.dreq = DMA_SVC_DREQ_NONE;
+
+    return dma_svc_submit(&xfer, callback, p_arg);
+}
+
+/**
+ * @brief 非同期memset(転送元はジョブ内の固定ワード)
+ */
+dma_svc_handle_t dma_svc_memset_async(void *p_dst, uint8_t val, uint32_t len,
+                                      dma_svc_callback_t callback, void *p_arg)
+{
+    dma_svc_xfer_t xfer = {0};
+
+    xfer.p_dst = p_dst;
+    xfer.size = dma_svc_size_for(p_dst, NULL, len);
+    xfer.count = len >> xfer.size;
+    xfer.is_write_incr = true;
+    xfer.is_fill = true;
+    xfer.fill_word = val * 0x01010101UL;
+    xfer.dreq = DMA_SVC_DREQ_NONE;
+
+    return dma_svc_submit(&xfer, callback, p_arg);
+}
+
+/**
+ * @brief 非同期の32bitパターンのフィル(p_dstとlenは4バイトアライン)
+ */
+dma_svc_handle_t dma_svc_fill32_async(void *p_dst, uint32_t word, uint32_t len,
+                                      dma_svc_callback_t callback, void *p_arg)
+{
+    dma_svc_xfer_t xfer = {0};
+
+    if ((((uintptr_t)p_dst | len) & 3) != 0) {
+        return DMA_SVC_HANDLE_INVALID;
+    }
+
+    xfer.p_dst = p_dst;
+    xfer.size = DMA_SVC_SIZE_32;
+    xfer.count = len >> 2;
+    xfer.is_write_incr = true;
+    xfer.is_fill = true;
+    xfer.fill_word = word;
+    xfer.dreq = DMA_SVC_DREQ_NONE;
+
+    return dma_svc_submit(&xfer, callback, p_arg);
+}
+
+/**
+ * @brief 非同期スキャッタギャザー(要素ごとにmemcpy)
+ * @note p_sgの配列(最大DMA_SVC_SG_MAX要素)はジョブにコピーする、転送元/転送先のバッファは完了まで保持すること
+ */
+dma_svc_handle_t dma_svc_sg_async(const dma_svc_sg_t *p_sg, uint32_t sg_num,
+                                  dma_svc_callback_t callback, void *p_arg)
+{
+    dma_svc_xfer_t xfer = {0};
+
+    xfer.p_sg = p_sg;
+    xfer.sg_num = sg_num;
+    xfer.is_read_incr = true;
+    xfer.is_write_incr = true;
+    xfer.dreq = DMA_SVC_DREQ_NONE;
+
+    return dma_svc_submit(&xfer, callback, p_arg);
+}
+
+/**
+ * @brief ジョブが完了したか(スロットが再利用されていても完了扱い)
+ */
+bool dma_svc_is_done(dma_svc_handle_t handle)
+{
+    dma_svc_job_t *p_job = handle_to_job(handle);
+
+    if (p_job == NULL) {
+        return true;
+    }
+
+    return !is_handle_live(p_job, handle);
+}
+
+/**
+ * @brief ジョブの完了を待つ
+ * @note DMA割り込みを処理するコアで割り込み禁止中に呼ばないこと
+ */
+void dma_svc_wait(dma_svc_handle_t handle)
+{
+    while (!dma_svc_is_done(handle))
+    {
+        ;
+    }
+}
+
+/**
+ * @brief ジョブをキャンセル(キュー待ちは取り除き、転送中は中断)
+ *
+ * @return true キャンセルした
+ * @return false 既に完了済み
+ */
+bool dma_svc_cancel(dma_svc_handle_t handle)
+{
+    dma_svc_job_t *p_job = handle_to_job(handle);
+    dma_svc_callback_t callback = NULL;
+    void *p_arg = NULL;
+    bool is_canceled = false;
+
+    if (p_job == NULL) {
+        return false;
+    }
+
+    uint32_t save = s_p_ops->lock();
+    if (is_handle_live(p_job, handle)) {
+        if (p_job->state == DMA_SVC_JOB_QUEUED) {
+            // キューから取り除く
+            dma_svc_job_t **pp = &s_p_queue_head;
+            dma_svc_job_t *p_prev = NULL;
+            while (*pp != p_job)
+            {
+                p_prev = *pp;
+                pp = &(*pp)->p_next;
+            }
+            *pp = p_job->p_next;
+            if (s_p_queue_tail == p_job) {
+                s_p_queue_tail = p_prev;
+            }
+            p_job->p_next = NULL;
+            s_stats.queue_depth--;
+        } else {
+            s_p_ops->abort(s_pool[p_job->pool_idx].ch);
+        }
+        job_finish(p_job, DMA_SVC_ABORTED, &callback, &p_arg);
+        is_canceled = true;
+    }
+    s_p_ops->unlock(save);
+
+    if (callback != NULL) {
+        callback(DMA_SVC_ABORTED, p_arg);
+    }
+
+    return is_canceled;
+}
+
+/**
+ * @brief チャネルの転送完了通知(H/W層のDMA割り込みから呼ぶ)
+ *
+ * @param ch 完了したチャネル
+ */
+void dma_svc_on_complete(uint32_t ch)
+{
+    dma_svc_callback_t callback = NULL;
+    void *p_arg = NULL;
+
+    uint32_t save = s_p_ops->lock();
+    for (uint32_t i = 0; i < s_pool_num; i++)
+    {
+        if (s_pool[i].ch == ch && s_pool[i].p_job != NULL) {
+            job_finish(s_pool[i].p_job, DMA_SVC_OK, &callback, &p_arg);
+            break;
+        }
+    }
+    s_p_ops->unlock(save);
+
+    if (callback != NULL) {
+        callback(DMA_SVC_OK, p_arg);
+    }
+}
+
+/**
+ * @brief プールの空きチャネルを専用に借りる(周辺機能が自前で設定する場合)
+ * @note 借りている間、そのチャネルにはジョブを割り当てない
+ *
+ * @param p_ch 借りたチャネル番号
+ * @return true 成功
+ * @return false 空きチャネルなし
+ */
+bool dma_svc_ch_acquire(uint32_t *p_ch)
+{
+    bool is_ok = false;
+
+    if (s_p_ops == NULL) {
+        return false;
+    }
+
+    uint32_t save = s_p_ops->lock();
+    int32_t pool_idx = pool_find_idle();
+    // 最後の1チャネルはジョブ用に残す
+    if (pool_idx >= 0 && s_stats.ch_reserved + 1 < s_pool_num) {
+        s_pool[pool_idx].is_reserved = true;
+        s_stats.ch_reserved++;
+        *p_ch = s_pool[pool_idx].ch;
+        is_ok = true;
+    }
+    s_p_ops->unlock(save);
+
+    return is_ok;
+}
+
+/**
+ * @brief 借りたチャネルを返す(キュー待ちがあれば即開始)
+ */
+void dma_svc_ch_release(uint32_t ch)
+{
+    uint32_t save = s_p_ops->lock();
+    for (uint32_t i = 0; i < s_pool_num; i++)
+    {
+        if (s_pool[i].ch == ch && s_pool[i].is_reserved) {
+            s_pool[i].is_reserved = false;
+            s_stats.ch_reserved--;
+            dma_svc_job_t *p_next = queue_pop();
+            if (p_next != NULL) {
+                job_start(p_next, i);
+            }
+            break;
+        }
+    }
+    s_p_ops->unlock(save);
+}
+
+void dma_svc_get_stats(dma_svc_stats_t *p_stats)
+{
+    if (s_p_ops == NULL) {
+        *p_stats = (dma_svc_stats_t){0};
+        return;
+    }
+
+    uint32_t save = s_p_ops->lock();
+    *p_stats = s_stats;
+    s_p_ops->unlock(save);
+}
+
+/**
+ * @brief 統計情報をクリア(現在の状態を表す値は残す)
+ */
+void dma_svc_clr_stats(void)
+{
+    uint32_t save = (s_p_ops != NULL) ? s_p_ops->lock() : 0;
+    uint32_t queue_depth = s_stats.queue_depth;
+    uint32_t ch_busy = s_stats.ch_busy;
+    uint32_t ch_reserved = s_stats.ch_reserved;
+
+    s_stats = (dma_svc_stats_t){0};
+    s_stats.queue_depth = queue_depth;
+    s_stats.queue_depth_max = queue_depth;
+    s_stats.ch_busy = ch_busy;
+    s_stats.ch_reserved = ch_reserved;
+    if (s_p_ops != NULL) {
+        s_p_ops->unlock(save);
+    }
+}
+
+/**
+ * @brief アドレスと長さのアライメントから転送サイズを決める
+ */
+dma_svc_size_t dma_svc_size_for(const void *p_dst, const void *p_src, uint32_t len)
+{
+    uint32_t bits = (uint32_t)(uintptr_t)p_dst | (uint32_t)(uintptr_t)p_src | len;
+
+    if ((bits & 3) == 0) {
+        return DMA_SVC_SIZE_32;
+    } else if ((bits & 1) == 0) {
+        return DMA_SVC_SIZE_16;
+    }
+
+    return DMA_SVC_SIZE_8;
+}
+
+/**
+ * @brief 転送内容の総バイト数
+ */
+uint32_t dma_svc_xfer_bytes(const dma_svc_xfer_t *p_xfer)
+{
+    uint32_t bytes = 0;
+
+    if (p_xfer->p_sg == NULL) {
+        return p_xfer->count << p_xfer->size;
+    }
+
+    for (uint32_t i = 0; i < p_xfer->sg_num; i++)
+    {
+        bytes += p_xfer->p_sg[i].len;
+    }
+
+    return bytes;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file dma_service.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 非同期DMAサービス(チャネルプール、ジョブキュー)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DMA_SERVICE_H
+#define DMA_SERVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(H/W操作はdma_svc_hw_ops_tで注入)
+
+#define DMA_SVC_CH_NUM          6       // サービスが管理するチャネル数(UART0/1の送信が2本借りっぱなし)
+#define DMA_SVC_JOB_NUM         16      // 同時に受け付けるジョブ数(実行中+キュー)
+#define DMA_SVC_SG_MAX          16      // スキャッタギャザーの最大要素数
+#define DMA_SVC_DREQ_NONE       0x3F    // 転送要求なし(メモリ間、全速)
+#define DMA_SVC_HANDLE_INVALID  0       // 無効なハンドル
+
+// 1回の転送サイズ(Pico SDKのenum dma_channel_transfer_sizeと同じ値)
+typedef enum {
+    DMA_SVC_SIZE_8 = 0,
+    DMA_SVC_SIZE_16 = 1,
+    DMA_SVC_SIZE_32 = 2,
+} dma_svc_size_t;
+
+// ジョブの結果
+typedef enum {
+    DMA_SVC_OK,             // 完了
+    DMA_SVC_ABORTED,        // 中断
+} dma_svc_status_t;
+
+// 完了コールバック(DMA割り込みから呼ばれる)
+typedef void (*dma_svc_callback_t)(dma_svc_status_t status, void *p_arg);
+
+// ジョブのハンドル(世代+スロット番号、完了待ち/キャンセルに使う)
+typedef uint32_t dma_svc_handle_t;
+
+// スキャッタギャザーの要素
+typedef struct {
+    void *p_dst;
+    const void *p_src;
+    uint32_t len;               // バイト数
+} dma_svc_sg_t;
+
+// 転送内容(H/W層に渡す)
+typedef struct {
+    void *p_dst;
+    const void *p_src;
+    uint32_t count;             // 転送回数(sizeの単位)
+    dma_svc_size_t size;
+    bool is_read_incr;
+    bool is_write_incr;
+    bool is_fill;               // trueならfill_wordを転送元にする
+    uint8_t dreq;               // 転送要求(DREQ番号 or DMA_SVC_DREQ_NONE)
+    uint8_t ring_bits;          // 0:無効, 1～15: アドレスを2^ring_bitsバイトで折り返し
+    bool is_ring_write;         // true:書き込み側をリング, false:読み出し側をリング
+    const dma_svc_sg_t *p_sg;   // スキャッタギャザー(NULLなら単発転送)
+    uint32_t sg_num;
+    uint32_t fill_word;
+} dma_svc_xfer_t;
+
+// H/W層の操作(実機はdma_service_hw.c、ホストではシミュレータを渡す)
+typedef struct {
+    bool (*ch_claim)(uint32_t *p_ch);
+    void (*ch_unclaim)(uint32_t ch);
+    void (*start)(uint32_t ch, const dma_svc_xfer_t *p_xfer);
+    void (*abort)(uint32_t ch);
+    uint32_t (*now_us)(void);
+    uint32_t (*lock)(void);
+    void (*unlock)(uint32_t save);
+} dma_svc_hw_ops_t;
+
+// 統計情報
+typedef struct {
+    uint64_t bytes;             // 転送済みバイト数
+    uint32_t jobs_done;         // 完了ジョブ数
+    uint32_t jobs_aborted;      // 中断ジョブ数
+    uint32_t submit_rejects;    // ジョブ枠不足で受け付けなかった数
+    uint32_t queue_depth;       // 現在のキュー待ち数
+    uint32_t queue_depth_max;   // キュー待ち数の最大
+    uint64_t wait_us_total;     // キュー待ち時間の合計(投入→開始)
+    uint32_t wait_us_max;       // キュー待ち時間の最大
+    uint64_t busy_us_total;     // 転送時間の合計(開始→完了)
+    uint32_t ch_busy;           // 現在転送中のチャネル数
+    uint32_t ch_reserved;       // 専用に貸し出し中のチャネル数
+} dma_svc_stats_t;
+
+bool dma_svc_init(const dma_svc_hw_ops_t *p_ops);
+dma_svc_handle_t dma_svc_submit(const dma_svc_xfer_t *p_xfer, dma_svc_callback_t callback, void *p_arg);
+dma_svc_handle_t dma_svc_memcpy_async(void *p_dst, const void *p_src, uint32_t len,
+                                      dma_svc_callback_t callback, void *p_arg);
+dma_svc_handle_t dma_svc_memset_async(void *p_dst, uint8_t val, uint32_t len,
+                                      dma_svc_callback_t callback, void *p_arg);
+dma_svc_handle_t dma_svc_fill32_async(void *p_dst, uint32_t word, uint32_t len,
+                                      dma_svc_callback_t callback, void *p_arg);
+dma_svc_handle_t dma_svc_sg_async(const dma_svc_sg_t *p_sg, uint32_t sg_num,
+                                  dma_svc_callback_t callback, void *p_arg);
+bool dma_svc_is_done(dma_svc_handle_t handle);
+void dma_svc_wait(dma_svc_handle_t handle);
+bool dma_svc_cancel(dma_svc_handle_t handle);
+void dma_svc_on_complete(uint32_t ch);
+bool dma_svc_ch_acquire(uint32_t *p_ch);
+void dma_svc_ch_release(uint32_t ch);
+void dma_svc_get_stats(dma_svc_stats_t *p_stats);
+void dma_svc_clr_stats(void);
+dma_svc_size_t dma_svc_size_for(const void *p_dst, const void *p_src, uint32_t len);
+uint32_t dma_svc_xfer_bytes(const dma_svc_xfer_t *p_xfer);
+
+#endif // DMA_SERVICE_H
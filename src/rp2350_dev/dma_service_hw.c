@@ -0,0 +1,243 @@
+/**
+ * @file dma_service_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 非同期DMAサービスのH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "dma_service_hw.h"
+#include "mcu_util.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hot_path.h"
+
+// スキャッタギャザーの制御ブロック(チャネルのalias1と同じ並び)
+// CTRL, READ_ADDR, WRITE_ADDR, TRANS_COUNT_TRIG
+typedef struct {
+    uint32_t ctrl;
+    const void *p_read;
+    void *p_write;
+    uint32_t count;
+} dma_svc_hw_cb_t;
+
+// データチャネルと制御チャネルの組
+typedef struct {
+    uint32_t data_ch;
+    uint32_t ctrl_ch;
+    dma_svc_hw_cb_t cb[DMA_SVC_SG_MAX + 1];     // 終端(NULLトリガ)を含む
+} dma_svc_hw_ch_t;
+
+static dma_svc_hw_ch_t s_hw_ch[DMA_SVC_CH_NUM];
+static uint32_t s_hw_ch_num = 0;
+static uint32_t s_hw_ch_mask = 0;
+static spin_lock_t *s_p_hw_lock;
+
+static dma_svc_hw_ch_t *hw_ch_find(uint32_t ch)
+{
+    for (uint32_t i = 0; i < s_hw_ch_num; i++)
+    {
+        if (s_hw_ch[i].data_ch == ch) {
+            return &s_hw_ch[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief データチャネルと制御チャネル(スキャッタギャザー用)を確保
+ */
+static bool hw_ch_claim(uint32_t *p_ch)
+{
+    if (s_hw_ch_num >= DMA_SVC_CH_NUM) {
+        return false;
+    }
+
+    int data_ch = dma_claim_unused_channel(false);
+    if (data_ch < 0) {
+        return false;
+    }
+    int ctrl_ch = dma_claim_unused_channel(false);
+    if (ctrl_ch < 0) {
+        dma_channel_unclaim(data_ch);
+        return false;
+    }
+
+    s_hw_ch[s_hw_ch_num].data_ch = (uint32_t)data_ch;
+    s_hw_ch[s_hw_ch_num].ctrl_ch = (uint32_t)ctrl_ch;
+    s_hw_ch_num++;
+    s_hw_ch_mask |= (1UL << data_ch);
+    dma_channel_set_irq0_enabled(data_ch, true);
+    *p_ch = (uint32_t)data_ch;
+
+    return true;
+}
+
+static void hw_ch_unclaim(uint32_t ch)
+{
+    dma_svc_hw_ch_t *p_hw = hw_ch_find(ch);
+
+    if (p_hw != NULL) {
+        dma_channel_set_irq0_enabled(ch, false);
+        s_hw_ch_mask &= ~(1UL << ch);
+        dma_channel_unclaim(p_hw->ctrl_ch);
+        dma_channel_unclaim(ch);
+    }
+}
+
+/**
+ * @brief スキャッタギャザー開始
+ * @note 制御チャネルが制御ブロックをデータチャネルのalias1に4ワードずつ書き込み、
+ *       TRANS_COUNT_TRIGへの書き込みでデータチャネルを起動する。
+ *       データチャネルは完了ごとに制御チャネルへチェインし、
+ *       終端ブロックのNULLトリガでIRQ_QUIETの割り込みが1回だけ上がる
+ */
+static void hw_sg_start(dma_svc_hw_ch_t *p_hw, const dma_svc_xfer_t *p_xfer)
+{
+    uint32_t num = 0;
+    uint32_t ctrl = 0;
+
+    for (uint32_t i = 0; i < p_xfer->sg_num; i++)
+    {
+        const dma_svc_sg_t *p_sg = &p_xfer->p_sg[i];
+        if (p_sg->len == 0) {
+            continue;   // 転送数0はNULLトリガになるので飛ばす
+        }
+        dma_svc_size_t size = dma_svc_size_for(p_sg->p_dst, p_sg->p_src, p_sg->len);
+        dma_channel_config c = dma_channel_get_default_config(p_hw->data_ch);
+        channel_config_set_transfer_data_size(&c, (enum dma_channel_transfer_size)size);
+        channel_config_set_read_increment(&c, p_xfer->is_read_incr);
+        channel_config_set_write_increment(&c, p_xfer->is_write_incr);
+        channel_config_set_dreq(&c, p_xfer->dreq);
+        channel_config_set_chain_to(&c, p_hw->ctrl_ch);
+        channel_config_set_irq_quiet(&c, true);
+        ctrl = channel_config_get_ctrl_value(&c);
+
+        p_hw->cb[num].ctrl = ctrl;
+        p_hw->cb[num].p_read = p_sg->p_src;
+        p_hw->cb[num].p_write = p_sg->p_dst;
+        p_hw->cb[num].count = p_sg->len >> size;
+        num++;
+    }
+
+    // 終端(転送数0 = NULLトリガ)
+    if (num == 0) {
+        dma_channel_config c = dma_channel_get_default_config(p_hw->data_ch);
+        channel_config_set_irq_quiet(&c, true);
+        ctrl = channel_config_get_ctrl_value(&c);
+    }
+    p_hw->cb[num].ctrl = ctrl;
+    p_hw->cb[num].p_read = NULL;
+    p_hw->cb[num].p_write = NULL;
+    p_hw->cb[num].count = 0;
+
+    // 制御チャネル: 4ワード転送、書き込み側は16byteでリング
+    dma_channel_config c = dma_channel_get_default_config(p_hw->ctrl_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 4);
+    dma_channel_configure(p_hw->ctrl_ch, &c, &dma_hw->ch[p_hw->data_ch].al1_ctrl, p_hw->cb, 4, true);
+}
+
+static void hw_start(uint32_t ch, const dma_svc_xfer_t *p_xfer)
+{
+    dma_svc_hw_ch_t *p_hw = hw_ch_find(ch);
+
+    if (p_xfer->p_sg != NULL) {
+        hw_sg_start(p_hw, p_xfer);
+        return;
+    }
+
+    dma_channel_config c = dma_channel_get_default_config(ch);
+    channel_config_set_transfer_data_size(&c, (enum dma_channel_transfer_size)p_xfer->size);
+    channel_config_set_read_increment(&c, p_xfer->is_read_incr);
+    channel_config_set_write_increment(&c, p_xfer->is_write_incr);
+    channel_config_set_dreq(&c, p_xfer->dreq);
+    if (p_xfer->ring_bits != 0) {
+        channel_config_set_ring(&c, p_xfer->is_ring_write, p_xfer->ring_bits);
+    }
+    dma_channel_configure(ch, &c, p_xfer->p_dst, p_xfer->p_src, p_xfer->count, true);
+}
+
+/**
+ * @brief 転送中断(中断時の割り込みは捨てる)
+ */
+static void hw_abort(uint32_t ch)
+{
+    dma_svc_hw_ch_t *p_hw = hw_ch_find(ch);
+
+    dma_channel_set_irq0_enabled(ch, false);
+    if (p_hw != NULL) {
+        dma_channel_abort(p_hw->ctrl_ch);
+    }
+    dma_channel_abort(ch);
+    dma_channel_acknowledge_irq0(ch);
+    dma_channel_set_irq0_enabled(ch, true);
+}
+
+static uint32_t hw_now_us(void)
+{
+    return time_us_32();
+}
+
+// 両コアから投入されるのでスピンロック(割り込み禁止付き)で排他
+static uint32_t hw_lock(void)
+{
+    return spin_lock_blocking(s_p_hw_lock);
+}
+
+static void hw_unlock(uint32_t save)
+{
+    spin_unlock(s_p_hw_lock, save);
+}
+
+static const dma_svc_hw_ops_t s_hw_ops = {
+    .ch_claim = hw_ch_claim,
+    .ch_unclaim = hw_ch_unclaim,
+    .start = hw_start,
+    .abort = hw_abort,
+    .now_us = hw_now_us,
+    .lock = hw_lock,
+    .unlock = hw_unlock,
+};
+
+/**
+ * @brief DMA割り込みハンドラ(サービスのチャネルのみ処理)
+ */
+static void HOT_FUNC(dma_svc_hw_irq_handler)(void)
+{
+    uint32_t mask = s_hw_ch_mask;
+
+    for (uint32_t ch = 0; mask != 0; ch++, mask >>= 1)
+    {
+        if ((mask & 1) != 0 && dma_channel_get_irq0_status(ch)) {
+            dma_channel_acknowledge_irq0(ch);
+            dma_svc_on_complete(ch);
+        }
+    }
+}
+HOT_PATH_REGISTER(dma_svc_hw_irq_handler);
+
+/**
+ * @brief DMAサービスの初期化(割り込みは呼び出したコアで処理)
+ *
+ * @return true 成功
+ * @return false チャネルを確保できない
+ */
+bool dma_svc_hw_init(void)
+{
+    s_p_hw_lock = spin_lock_init(spin_lock_claim_unused(true));
+
+    if (!dma_svc_init(&s_hw_ops)) {
+        return false;
+    }
+
+    irq_add_shared_handler(DMA_SVC_HW_IRQ, dma_svc_hw_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_SVC_HW_IRQ, true);
+
+    return true;
+}
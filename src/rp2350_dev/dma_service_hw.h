@@ -0,0 +1,20 @@
+/**
+ * @file dma_service_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 非同期DMAサービスのH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef DMA_SERVICE_HW_H
+#define DMA_SERVICE_HW_H
+
+#include "dma_service.h"
+
+#define DMA_SVC_HW_IRQ      DMA_IRQ_0   // 完了通知に使うDMA割り込み
+
+bool dma_svc_hw_init(void);
+
+#endif // DMA_SERVICE_HW_H
@@ -0,0 +1,200 @@
+/**
+ * @file fast_mem.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 高速メモリコピー/フィル(LDM/STM展開)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "fast_mem.h"
+
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define FAST_MEM_USE_LDM_STM
+#endif
+
+// ループがmemcpy/memset呼び出しに置き換えられると--wrap時に再帰するので禁止
+#if defined(__GNUC__) && !defined(__clang__)
+#define FAST_MEM_NO_LIBCALL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define FAST_MEM_NO_LIBCALL
+#endif
+
+/**
+ * @brief 32byteブロック単位のワードコピー(ワードアライン前提)
+ */
+FAST_MEM_NO_LIBCALL static inline void copy_blocks(uint32_t *p_dst, const uint32_t *p_src, size_t blocks)
+{
+#ifdef FAST_MEM_USE_LDM_STM
+    // r7はフレームポインタの場合があるので使わない
+    __asm__ __volatile__ (
+        ".syntax unified\n"
+        "1:\n"
+        "ldmia %[src]!, {r3-r6, r8-r10, r12}\n"
+        "stmia %[dst]!, {r3-r6, r8-r10, r12}\n"
+        "subs %[cnt], %[cnt], #1\n"
+        "bne 1b\n"
+        : [dst] "+r" (p_dst), [src] "+r" (p_src), [cnt] "+r" (blocks)
+        :
+        : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory"
+    );
+#else
+    while (blocks-- > 0)
+    {
+        uint32_t w0 = p_src[0], w1 = p_src[1], w2 = p_src[2], w3 = p_src[3];
+        uint32_t w4 = p_src[4], w5 = p_src[5], w6 = p_src[6], w7 = p_src[7];
+        p_dst[0] = w0; p_dst[1] = w1; p_dst[2] = w2; p_dst[3] = w3;
+        p_dst[4] = w4; p_dst[5] = w5; p_dst[6] = w6; p_dst[7] = w7;
+        p_src += 8;
+        p_dst += 8;
+    }
+#endif
+}
+
+/**
+ * @brief 32byteブロック単位のワードフィル(ワードアライン前提)
+ */
+FAST_MEM_NO_LIBCALL static inline void fill_blocks(uint32_t *p_dst, uint32_t val, size_t blocks)
+{
+#ifdef FAST_MEM_USE_LDM_STM
+    __asm__ __volatile__ (
+        ".syntax unified\n"
+        "mov r3, %[val]\n"
+        "mov r4, %[val]\n"
+        "mov r5, %[val]\n"
+        "mov r6, %[val]\n"
+        "mov r8, %[val]\n"
+        "mov r9, %[val]\n"
+        "mov r10, %[val]\n"
+        "mov r12, %[val]\n"
+        "1:\n"
+        "stmia %[dst]!, {r3-r6, r8-r10, r12}\n"
+        "subs %[cnt], %[cnt], #1\n"
+        "bne 1b\n"
+        : [dst] "+r" (p_dst), [cnt] "+r" (blocks)
+        : [val] "r" (val)
+        : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory"
+    );
+#else
+    while (blocks-- > 0)
+    {
+        p_dst[0] = val; p_dst[1] = val; p_dst[2] = val; p_dst[3] = val;
+        p_dst[4] = val; p_dst[5] = val; p_dst[6] = val; p_dst[7] = val;
+        p_dst += 8;
+    }
+#endif
+}
+
+/**
+ * @brief 高速メモリコピー(memcpy互換)
+ * @note 転送先をワード境界に揃えてからブロック転送する。
+ *       転送元のアライメントが合わない場合は非アラインのワードロードで転送
+ *       (Cortex-M33は非アラインLDRに対応)
+ *
+ * @param p_dst 転送先
+ * @param p_src 転送元
+ * @param len 転送バイト数
+ * @return void* p_dst
+ */
+FAST_MEM_NO_LIBCALL void *fast_memcpy(void *p_dst, const void *p_src, size_t len)
+{
+    uint8_t *p_d = (uint8_t *)p_dst;
+    const uint8_t *p_s = (const uint8_t *)p_src;
+
+    // 転送先をワード境界に揃える
+    while (len > 0 && ((uintptr_t)p_d & 3) != 0)
+    {
+        *p_d++ = *p_s++;
+        len--;
+    }
+
+    if (((uintptr_t)p_s & 3) == 0) {
+        size_t blocks = len / FAST_MEM_BLOCK_SIZE;
+        if (blocks > 0) {
+            copy_blocks((uint32_t *)p_d, (const uint32_t *)p_s, blocks);
+            p_d += blocks * FAST_MEM_BLOCK_SIZE;
+            p_s += blocks * FAST_MEM_BLOCK_SIZE;
+            len -= blocks * FAST_MEM_BLOCK_SIZE;
+        }
+        while (len >= 4)
+        {
+            *(uint32_t *)p_d = *(const uint32_t *)p_s;
+            p_d += 4;
+            p_s += 4;
+            len -= 4;
+        }
+    } else {
+        // 非アラインの転送元からワード単位で読む
+        while (len >= 4)
+        {
+            uint32_t w;
+            __builtin_memcpy(&w, p_s, 4);
+            *(uint32_t *)p_d = w;
+            p_d += 4;
+            p_s += 4;
+            len -= 4;
+        }
+    }
+
+    while (len > 0)
+    {
+        *p_d++ = *p_s++;
+        len--;
+    }
+
+    return p_dst;
+}
+
+/**
+ * @brief 高速メモリフィル(memset互換)
+ *
+ * @param p_dst 書き込み先
+ * @param val 書き込む値(下位8bit)
+ * @param len 書き込みバイト数
+ * @return void* p_dst
+ */
+FAST_MEM_NO_LIBCALL void *fast_memset(void *p_dst, int val, size_t len)
+{
+    uint8_t *p_d = (uint8_t *)p_dst;
+    uint32_t word = (uint8_t)val * 0x01010101UL;
+
+    while (len > 0 && ((uintptr_t)p_d & 3) != 0)
+    {
+        *p_d++ = (uint8_t)val;
+        len--;
+    }
+
+    size_t blocks = len / FAST_MEM_BLOCK_SIZE;
+    if (blocks > 0) {
+        fill_blocks((uint32_t *)p_d, word, blocks);
+        p_d += blocks * FAST_MEM_BLOCK_SIZE;
+        len -= blocks * FAST_MEM_BLOCK_SIZE;
+    }
+    while (len >= 4)
+    {
+        *(uint32_t *)p_d = word;
+        p_d += 4;
+        len -= 4;
+    }
+    while (len > 0)
+    {
+        *p_d++ = (uint8_t)val;
+        len--;
+    }
+
+    return p_dst;
+}
+
+#ifdef FAST_MEM_WRAP_LIBC
+// リンカの --wrap=memcpy/--wrap=memset でlibcの実装を置き換える
+void *__wrap_memcpy(void *p_dst, const void *p_src, size_t len)
+{
+    return fast_memcpy(p_dst, p_src, len);
+}
+
+void *__wrap_memset(void *p_dst, int val, size_t len)
+{
+    return fast_memset(p_dst, val, len);
+}
+#endif // FAST_MEM_WRAP_LIBC
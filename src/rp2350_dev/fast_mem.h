@@ -0,0 +1,25 @@
+/**
+ * @file fast_mem.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 高速メモリコピー/フィル(LDM/STM展開)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FAST_MEM_H
+#define FAST_MEM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+// ※Cortex-M(Thumb-2)ではLDM/STMで32byteずつ転送、それ以外はCで8ワード展開
+
+#define FAST_MEM_BLOCK_SIZE     32      // LDM/STM 1回あたりの転送バイト数(8レジスタ)
+
+void *fast_memcpy(void *p_dst, const void *p_src, size_t len);
+void *fast_memset(void *p_dst, int val, size_t len);
+
+#endif // FAST_MEM_H
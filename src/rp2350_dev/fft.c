@@ -0,0 +1,447 @@
+/**
+ * @file fft.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief FFT(Q15/float32)のインプレース実装
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "fft.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// 回転因子テーブル W_MAX^k = exp(-2πik/MAX) (k = 0 ～ MAX/2-1)
+// ※constを付けずにfft_init()で生成するので.bss(SRAM)に置かれる
+static fft_cpx_f32_t s_twiddle_f32[FFT_MAX_N / 2];
+static fft_cpx_q15_t s_twiddle_q15[FFT_MAX_N / 2];
+
+// ビットリバーステーブル(MAX点用、N点はMAX点の値を右シフトして使う)
+static uint16_t s_bitrev_tbl[FFT_MAX_N];
+
+static bool s_is_init = false;
+
+static inline int16_t q15_sat(int32_t val)
+{
+    if (val > INT16_MAX) {
+        return INT16_MAX;
+    } else if (val < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)val;
+}
+
+static inline int16_t q15_round(double val)
+{
+    return q15_sat((int32_t)lround(val * 32767.0));
+}
+
+// 複素数の乗算(float32)
+static inline fft_cpx_f32_t cpx_mul_f32(fft_cpx_f32_t a, fft_cpx_f32_t w)
+{
+    fft_cpx_f32_t r;
+
+    r.re = a.re * w.re - a.im * w.im;
+    r.im = a.re * w.im + a.im * w.re;
+
+    return r;
+}
+
+// 複素数の乗算(Q15、結果はQ15にまるめ)
+static inline void cpx_mul_q15(int32_t ar, int32_t ai, fft_cpx_q15_t w, int32_t *p_re, int32_t *p_im)
+{
+    *p_re = (ar * w.re - ai * w.im + (1 << 14)) >> 15;
+    *p_im = (ar * w.im + ai * w.re + (1 << 14)) >> 15;
+}
+
+/**
+ * @brief N点のビットリバース並べ替え
+ *
+ * @param p_buf バッファ(要素サイズelem_size)
+ * @param log2n log2(N)
+ * @param elem_size 1要素のバイト数
+ */
+static void bitrev_permute(void *p_buf, uint32_t log2n, uint32_t elem_size)
+{
+    uint32_t n = 1UL << log2n;
+    uint32_t shift = FFT_MAX_LOG2N - log2n;
+
+    if (elem_size == sizeof(fft_cpx_f32_t)) {
+        fft_cpx_f32_t *p = (fft_cpx_f32_t *)p_buf;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t j = s_bitrev_tbl[i] >> shift;
+            if (i < j) {
+                fft_cpx_f32_t tmp = p[i];
+                p[i] = p[j];
+                p[j] = tmp;
+            }
+        }
+    } else {
+        fft_cpx_q15_t *p = (fft_cpx_q15_t *)p_buf;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t j = s_bitrev_tbl[i] >> shift;
+            if (i < j) {
+                fft_cpx_q15_t tmp = p[i];
+                p[i] = p[j];
+                p[j] = tmp;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 回転因子テーブルとビットリバーステーブルを生成
+ */
+void fft_init(void)
+{
+    if (s_is_init) {
+        return;
+    }
+
+    for (uint32_t k = 0; k < FFT_MAX_N / 2; k++)
+    {
+        double ang = -2.0 * M_PI * (double)k / (double)FFT_MAX_N;
+        s_twiddle_f32[k].re = (float)cos(ang);
+        s_twiddle_f32[k].im = (float)sin(ang);
+        s_twiddle_q15[k].re = q15_round(cos(ang));
+        s_twiddle_q15[k].im = q15_round(sin(ang));
+    }
+
+    for (uint32_t i = 0; i < FFT_MAX_N; i++)
+    {
+        uint32_t rev = 0;
+        for (uint32_t b = 0; b < FFT_MAX_LOG2N; b++)
+        {
+            rev |= ((i >> b) & 1UL) << (FFT_MAX_LOG2N - 1 - b);
+        }
+        s_bitrev_tbl[i] = (uint16_t)rev;
+    }
+
+    s_is_init = true;
+}
+
+/**
+ * @brief 複素FFT(float32、インプレース、順方向)
+ *
+ * @param p_buf 入出力バッファ(N点)
+ * @param log2n log2(N) (FFT_MIN_LOG2N-1 ～ FFT_MAX_LOG2N)
+ * @param radix FFT_RADIX_2 or FFT_RADIX_4
+ */
+void fft_f32(fft_cpx_f32_t *p_buf, uint32_t log2n, fft_radix_t radix)
+{
+    uint32_t n = 1UL << log2n;
+    uint32_t half = 1;
+
+    bitrev_permute(p_buf, log2n, sizeof(fft_cpx_f32_t));
+
+    if (radix == FFT_RADIX_4) {
+        // 段数が奇数なら最初の1段だけ基数2(回転因子は1)
+        if ((log2n & 1UL) != 0) {
+            for (uint32_t i = 0; i < n; i += 2)
+            {
+                fft_cpx_f32_t a = p_buf[i];
+                fft_cpx_f32_t b = p_buf[i + 1];
+                p_buf[i].re = a.re + b.re;
+                p_buf[i].im = a.im + b.im;
+                p_buf[i + 1].re = a.re - b.re;
+                p_buf[i + 1].im = a.im - b.im;
+            }
+            half = 2;
+        }
+
+        // 2段分(長さ2m→4m)を1パスで処理してメモリアクセスを半減
+        for (uint32_t m = half; m < n; m <<= 2)
+        {
+            uint32_t step2 = FFT_MAX_N / (2 * m);
+            uint32_t step4 = FFT_MAX_N / (4 * m);
+            for (uint32_t j = 0; j < m; j++)
+            {
+                fft_cpx_f32_t w2 = s_twiddle_f32[j * step2];
+                fft_cpx_f32_t w4 = s_twiddle_f32[j * step4];
+                for (uint32_t i = j; i < n; i += 4 * m)
+                {
+                    fft_cpx_f32_t b = cpx_mul_f32(p_buf[i + m], w2);
+                    fft_cpx_f32_t d = cpx_mul_f32(p_buf[i + 3 * m], w2);
+                    fft_cpx_f32_t a = p_buf[i];
+                    fft_cpx_f32_t c = p_buf[i + 2 * m];
+                    fft_cpx_f32_t a1 = {a.re + b.re, a.im + b.im};
+                    fft_cpx_f32_t b1 = {a.re - b.re, a.im - b.im};
+                    fft_cpx_f32_t c1 = {c.re + d.re, c.im + d.im};
+                    fft_cpx_f32_t d1 = {c.re - d.re, c.im - d.im};
+                    fft_cpx_f32_t t = cpx_mul_f32(c1, w4);
+                    fft_cpx_f32_t u = cpx_mul_f32(d1, w4);
+                    // W_4m^(j+m) = -i * W_4m^j
+                    fft_cpx_f32_t v = {u.im, -u.re};
+                    p_buf[i].re         = a1.re + t.re;
+                    p_buf[i].im         = a1.im + t.im;
+                    p_buf[i + 2 * m].re = a1.re - t.re;
+                    p_buf[i + 2 * m].im = a1.im - t.im;
+                    p_buf[i + m].re     = b1.re + v.re;
+                    p_buf[i + m].im     = b1.im + v.im;
+                    p_buf[i + 3 * m].re = b1.re - v.re;
+                    p_buf[i + 3 * m].im = b1.im - v.im;
+                }
+            }
+        }
+    } else {
+        for (half = 1; half < n; half <<= 1)
+        {
+            uint32_t step = FFT_MAX_N / (2 * half);
+            for (uint32_t j = 0; j < half; j++)
+            {
+                fft_cpx_f32_t w = s_twiddle_f32[j * step];
+                for (uint32_t i = j; i < n; i += 2 * half)
+                {
+                    fft_cpx_f32_t t = cpx_mul_f32(p_buf[i + half], w);
+                    fft_cpx_f32_t a = p_buf[i];
+                    p_buf[i].re        = a.re + t.re;
+                    p_buf[i].im        = a.im + t.im;
+                    p_buf[i + half].re = a.re - t.re;
+                    p_buf[i + half].im = a.im - t.im;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 複素FFT(Q15、インプレース、順方向)
+ * @note オーバーフロー防止のため各段で1/2にスケーリングするので出力はX[k]/N
+ *
+ * @param p_buf 入出力バッファ(N点)
+ * @param log2n log2(N) (FFT_MIN_LOG2N ～ FFT_MAX_LOG2N)
+ * @param radix FFT_RADIX_2 or FFT_RADIX_4
+ */
+void fft_q15(fft_cpx_q15_t *p_buf, uint32_t log2n, fft_radix_t radix)
+{
+    uint32_t n = 1UL << log2n;
+    uint32_t half = 1;
+    int32_t tr, ti;
+
+    bitrev_permute(p_buf, log2n, sizeof(fft_cpx_q15_t));
+
+    if (radix == FFT_RADIX_4) {
+        if ((log2n & 1UL) != 0) {
+            for (uint32_t i = 0; i < n; i += 2)
+            {
+                int32_t ar = p_buf[i].re, ai = p_buf[i].im;
+                int32_t br = p_buf[i + 1].re, bi = p_buf[i + 1].im;
+                p_buf[i].re     = (int16_t)((ar + br) >> 1);
+                p_buf[i].im     = (int16_t)((ai + bi) >> 1);
+                p_buf[i + 1].re = (int16_t)((ar - br) >> 1);
+                p_buf[i + 1].im = (int16_t)((ai - bi) >> 1);
+            }
+            half = 2;
+        }
+
+        for (uint32_t m = half; m < n; m <<= 2)
+        {
+            uint32_t step2 = FFT_MAX_N / (2 * m);
+            uint32_t step4 = FFT_MAX_N / (4 * m);
+            for (uint32_t j = 0; j < m; j++)
+            {
+                fft_cpx_q15_t w2 = s_twiddle_q15[j * step2];
+                fft_cpx_q15_t w4 = s_twiddle_q15[j * step4];
+                for (uint32_t i = j; i < n; i += 4 * m)
+                {
+                    int32_t br, bi, dr, di;
+                    cpx_mul_q15(p_buf[i + m].re, p_buf[i + m].im, w2, &br, &bi);
+                    cpx_mul_q15(p_buf[i + 3 * m].re, p_buf[i + 3 * m].im, w2, &dr, &di);
+                    int32_t ar = p_buf[i].re, ai = p_buf[i].im;
+                    int32_t cr = p_buf[i + 2 * m].re, ci = p_buf[i + 2 * m].im;
+                    // 1段目(1/2スケーリング)
+                    int32_t a1r = (ar + br) >> 1, a1i = (ai + bi) >> 1;
+                    int32_t b1r = (ar - br) >> 1, b1i = (ai - bi) >> 1;
+                    int32_t c1r = (cr + dr) >> 1, c1i = (ci + di) >> 1;
+                    int32_t d1r = (cr - dr) >> 1, d1i = (ci - di) >> 1;
+                    // 2段目(1/2スケーリング)
+                    int32_t ur, ui;
+                    cpx_mul_q15(c1r, c1i, w4, &tr, &ti);
+                    cpx_mul_q15(d1r, d1i, w4, &ur, &ui);
+                    // W_4m^(j+m) = -i * W_4m^j
+                    int32_t vr = ui, vi = -ur;
+                    p_buf[i].re         = q15_sat((a1r + tr) >> 1);
+                    p_buf[i].im         = q15_sat((a1i + ti) >> 1);
+                    p_buf[i + 2 * m].re = q15_sat((a1r - tr) >> 1);
+                    p_buf[i + 2 * m].im = q15_sat((a1i - ti) >> 1);
+                    p_buf[i + m].re     = q15_sat((b1r + vr) >> 1);
+                    p_buf[i + m].im     = q15_sat((b1i + vi) >> 1);
+                    p_buf[i + 3 * m].re = q15_sat((b1r - vr) >> 1);
+                    p_buf[i + 3 * m].im = q15_sat((b1i - vi) >> 1);
+                }
+            }
+        }
+    } else {
+        for (half = 1; half < n; half <<= 1)
+        {
+            uint32_t step = FFT_MAX_N / (2 * half);
+            for (uint32_t j = 0; j < half; j++)
+            {
+                fft_cpx_q15_t w = s_twiddle_q15[j * step];
+                for (uint32_t i = j; i < n; i += 2 * half)
+                {
+                    int32_t ar = p_buf[i].re, ai = p_buf[i].im;
+                    cpx_mul_q15(p_buf[i + half].re, p_buf[i + half].im, w, &tr, &ti);
+                    p_buf[i].re        = q15_sat((ar + tr) >> 1);
+                    p_buf[i].im        = q15_sat((ai + ti) >> 1);
+                    p_buf[i + half].re = q15_sat((ar - tr) >> 1);
+                    p_buf[i + half].im = q15_sat((ai - ti) >> 1);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 実数入力FFT(float32)
+ * @note N点の実数列をN/2点の複素FFTに詰めて計算し、分離処理でX[0]～X[N/2]を求める
+ *
+ * @param p_in 入力(実数N点)
+ * @param p_out 出力(N/2+1点、作業領域も兼ねる)
+ * @param log2n log2(N) (FFT_MIN_LOG2N ～ FFT_MAX_LOG2N)
+ */
+void fft_f32_real(const float *p_in, fft_cpx_f32_t *p_out, uint32_t log2n)
+{
+    uint32_t n = 1UL << log2n;
+    uint32_t half_n = n / 2;
+    uint32_t step = FFT_MAX_N / n;
+
+    // z[k] = x[2k] + i*x[2k+1]
+    memmove(p_out, p_in, n * sizeof(float));
+    fft_f32(p_out, log2n - 1, FFT_RADIX_4);
+
+    // k = 0 と k = N/2 は実数
+    fft_cpx_f32_t z0 = p_out[0];
+    p_out[0].re = z0.re + z0.im;
+    p_out[0].im = 0.0f;
+    p_out[half_n].re = z0.re - z0.im;
+    p_out[half_n].im = 0.0f;
+
+    // X[k] = Fe + W^k*Fo, X[N/2-k] = conj(Fe - W^k*Fo)
+    for (uint32_t k = 1; k <= half_n / 2; k++)
+    {
+        fft_cpx_f32_t zk = p_out[k];
+        fft_cpx_f32_t zn = p_out[half_n - k];
+        fft_cpx_f32_t fe = {0.5f * (zk.re + zn.re), 0.5f * (zk.im - zn.im)};
+        // Fo = -i/2 * (Z[k] - conj(Z[N/2-k]))
+        fft_cpx_f32_t fo = {0.5f * (zk.im + zn.im), -0.5f * (zk.re - zn.re)};
+        fft_cpx_f32_t t = cpx_mul_f32(fo, s_twiddle_f32[k * step]);
+        p_out[k].re = fe.re + t.re;
+        p_out[k].im = fe.im + t.im;
+        p_out[half_n - k].re = fe.re - t.re;
+        p_out[half_n - k].im = -(fe.im - t.im);
+    }
+}
+
+/**
+ * @brief 倍精度の参照FFT(SNR評価用、回転因子はテーブルを使わず毎回計算)
+ *
+ * @param p_re 実部(N点)
+ * @param p_im 虚部(N点)
+ * @param log2n log2(N)
+ */
+void fft_f64_ref(double *p_re, double *p_im, uint32_t log2n)
+{
+    uint32_t n = 1UL << log2n;
+
+    for (uint32_t i = 1, j = 0; i < n; i++)
+    {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            double tr = p_re[i], ti = p_im[i];
+            p_re[i] = p_re[j];
+            p_im[i] = p_im[j];
+            p_re[j] = tr;
+            p_im[j] = ti;
+        }
+    }
+
+    for (uint32_t half = 1; half < n; half <<= 1)
+    {
+        for (uint32_t j = 0; j < half; j++)
+        {
+            double ang = -M_PI * (double)j / (double)half;
+            double wr = cos(ang), wi = sin(ang);
+            for (uint32_t i = j; i < n; i += 2 * half)
+            {
+                double tr = p_re[i + half] * wr - p_im[i + half] * wi;
+                double ti = p_re[i + half] * wi + p_im[i + half] * wr;
+                p_re[i + half] = p_re[i] - tr;
+                p_im[i + half] = p_im[i] - ti;
+                p_re[i] += tr;
+                p_im[i] += ti;
+            }
+        }
+    }
+}
+
+/**
+ * @brief float32のFFT結果のSNR(dB)を参照FFTに対して計算
+ *
+ * @param p_ref_re 参照FFTの実部
+ * @param p_ref_im 参照FFTの虚部
+ * @param p_out 評価するFFT結果
+ * @param n 比較する点数
+ * @return double SNR(dB)
+ */
+double fft_snr_db_f32(const double *p_ref_re, const double *p_ref_im,
+                      const fft_cpx_f32_t *p_out, uint32_t n)
+{
+    double sig = 0.0, noise = 0.0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double er = p_ref_re[i] - (double)p_out[i].re;
+        double ei = p_ref_im[i] - (double)p_out[i].im;
+        sig += p_ref_re[i] * p_ref_re[i] + p_ref_im[i] * p_ref_im[i];
+        noise += er * er + ei * ei;
+    }
+
+    if (noise <= 0.0) {
+        return INFINITY;
+    }
+
+    return 10.0 * log10(sig / noise);
+}
+
+/**
+ * @brief Q15のFFT結果のSNR(dB)を参照FFTに対して計算
+ *
+ * @param p_ref_re 参照FFTの実部
+ * @param p_ref_im 参照FFTの虚部
+ * @param p_out 評価するFFT結果
+ * @param n 比較する点数
+ * @param scale Q15の1LSBを参照FFTの単位に換算する係数
+ * @return double SNR(dB)
+ */
+double fft_snr_db_q15(const double *p_ref_re, const double *p_ref_im,
+                      const fft_cpx_q15_t *p_out, uint32_t n, double scale)
+{
+    double sig = 0.0, noise = 0.0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double er = p_ref_re[i] - (double)p_out[i].re * scale;
+        double ei = p_ref_im[i] - (double)p_out[i].im * scale;
+        sig += p_ref_re[i] * p_ref_re[i] + p_ref_im[i] * p_ref_im[i];
+        noise += er * er + ei * ei;
+    }
+
+    if (noise <= 0.0) {
+        return INFINITY;
+    }
+
+    return 10.0 * log10(sig / noise);
+}
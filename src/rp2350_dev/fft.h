@@ -0,0 +1,52 @@
+/**
+ * @file fft.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief FFT(Q15/float32)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+#define FFT_MIN_LOG2N   6                       // 最小FFTサイズ(64点)
+#define FFT_MAX_LOG2N   12                      // 最大FFTサイズ(4096点)
+#define FFT_MIN_N       (1UL << FFT_MIN_LOG2N)
+#define FFT_MAX_N       (1UL << FFT_MAX_LOG2N)
+
+// バタフライの基数
+typedef enum {
+    FFT_RADIX_2,    // 基数2
+    FFT_RADIX_4,    // 基数4(基数2の2段を1パスに融合)
+} fft_radix_t;
+
+// 複素数(float32)
+typedef struct {
+    float re;
+    float im;
+} fft_cpx_f32_t;
+
+// 複素数(Q15)
+typedef struct {
+    int16_t re;
+    int16_t im;
+} fft_cpx_q15_t;
+
+void fft_init(void);
+void fft_f32(fft_cpx_f32_t *p_buf, uint32_t log2n, fft_radix_t radix);
+void fft_q15(fft_cpx_q15_t *p_buf, uint32_t log2n, fft_radix_t radix);
+void fft_f32_real(const float *p_in, fft_cpx_f32_t *p_out, uint32_t log2n);
+void fft_f64_ref(double *p_re, double *p_im, uint32_t log2n);
+double fft_snr_db_f32(const double *p_ref_re, const double *p_ref_im,
+                      const fft_cpx_f32_t *p_out, uint32_t n);
+double fft_snr_db_q15(const double *p_ref_re, const double *p_ref_im,
+                      const fft_cpx_q15_t *p_out, uint32_t n, double scale);
+
+#endif // FFT_H
@@ -0,0 +1,123 @@
+/**
+ * @file freq.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 周波数カウンタとパルス幅計測の集計
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "freq.h"
+#include <math.h>
+#include <string.h>
+
+void freq_stat_clear(freq_stat_t *p_stat)
+{
+    memset(p_stat, 0, sizeof(freq_stat_t));
+}
+
+/**
+ * @brief 値を1つ追加(桁落ちしにくいWelford法)
+ */
+void freq_stat_add(freq_stat_t *p_stat, double value)
+{
+    double delta = value - p_stat->mean;
+
+    if (p_stat->num == 0 || value < p_stat->min) {
+        p_stat->min = value;
+    }
+    if (p_stat->num == 0 || value > p_stat->max) {
+        p_stat->max = value;
+    }
+    p_stat->num++;
+    p_stat->mean += delta / (double)p_stat->num;
+    p_stat->m2 += delta * (value - p_stat->mean);
+}
+
+/**
+ * @brief 標準偏差(母集団、2個未満は0)
+ */
+double freq_stat_std(const freq_stat_t *p_stat)
+{
+    return (p_stat->num >= 2) ? sqrt(p_stat->m2 / (double)p_stat->num) : 0.0;
+}
+
+/**
+ * @brief freq_edgeのスナップショットを集計
+ * @note ゲートticks_per_gate周期ごとの周波数と、全体(先頭～最後)の周波数
+ *
+ * @param p_snap スナップショット(xの値)
+ * @param num スナップショット数
+ * @param ticks_per_gate 1ゲートのスナップショット周期数
+ * @param tick_s スナップショットの周期(秒)
+ * @param p_result 結果
+ */
+void freq_count_analyze(const uint32_t *p_snap, uint32_t num, uint32_t ticks_per_gate,
+                        double tick_s, freq_count_result_t *p_result)
+{
+    memset(p_result, 0, sizeof(freq_count_result_t));
+    if (num < 2 || ticks_per_gate == 0) {
+        return;
+    }
+
+    p_result->gate_s = tick_s * (double)ticks_per_gate;
+    p_result->window_s = tick_s * (double)(num - 1);
+    for (uint32_t i = 1; i < num; i++)
+    {
+        // xは減っていくので前 - 今(32bitの折り返しも引き算で吸収)
+        p_result->edges += (uint32_t)(p_snap[i - 1] - p_snap[i]);
+    }
+    p_result->freq_hz = (double)p_result->edges / p_result->window_s;
+
+    for (uint32_t i = 0; i + ticks_per_gate < num; i += ticks_per_gate)
+    {
+        uint32_t edges = p_snap[i] - p_snap[i + ticks_per_gate];
+        freq_stat_add(&p_result->gate_hz, (double)edges / p_result->gate_s);
+        p_result->gates++;
+    }
+}
+
+/**
+ * @brief freq_pulseの1ワードをSMのサイクル数にする(1周期ごとの誤差は±1ループ)
+ */
+uint32_t freq_pulse_cycles(uint32_t raw, bool is_high)
+{
+    return (~raw) * FREQ_PULSE_CYCLES_PER_LOOP + (is_high ? FREQ_PULSE_HIGH_OFFSET : FREQ_PULSE_LOW_OFFSET);
+}
+
+/**
+ * @brief freq_pulseの生データを集計
+ * @note 先頭のHは捨てて、(H, L)の組を1周期とする
+ *
+ * @param p_raw 生データ(H,L,H,L...)
+ * @param num ワード数
+ * @param cycle_s SMの1サイクルの時間(秒)
+ * @param p_result 結果
+ */
+void freq_pulse_analyze(const uint32_t *p_raw, uint32_t num, double cycle_s, freq_pulse_result_t *p_result)
+{
+    double high_sum = 0.0;
+    double period_sum = 0.0;
+
+    memset(p_result, 0, sizeof(freq_pulse_result_t));
+    p_result->resolution_s = cycle_s * FREQ_PULSE_CYCLES_PER_LOOP;
+
+    for (uint32_t i = 2; i + 1 < num; i += 2)
+    {
+        double high = (double)freq_pulse_cycles(p_raw[i], true) * cycle_s;
+        double low = (double)freq_pulse_cycles(p_raw[i + 1], false) * cycle_s;
+
+        freq_stat_add(&p_result->high, high);
+        freq_stat_add(&p_result->low, low);
+        freq_stat_add(&p_result->period, high + low);
+        high_sum += high;
+        period_sum += high + low;
+        p_result->periods++;
+    }
+
+    if (p_result->periods > 0) {
+        p_result->freq_hz = 1.0 / p_result->period.mean;
+        p_result->duty = high_sum / period_sum;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file freq.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 周波数カウンタとパルス幅計測の集計のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FREQ_H
+#define FREQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(DMAが集めた生データの集計だけ、ホストで確認できる)
+
+// 【生データ】(freq.pio)
+// freq_edge : 一定周期のxのスナップショット。xは立ち上がりごとに1減るので、i<jの間のエッジ数は snap[i] - snap[j]
+// freq_pulse: H,L,H,L...の順にループ回数の~x。最初のHは途中から(またはLから)始まるので捨てる
+
+#define FREQ_PULSE_CYCLES_PER_LOOP  2   // freq_pulseの1ループのサイクル数
+#define FREQ_PULSE_HIGH_OFFSET      2   // Hの固定分(ループ外の命令とエッジを見る位置の差)
+#define FREQ_PULSE_LOW_OFFSET       3   // Lの固定分(1周期の命令数 = 2*(H回数+L回数)+5)
+#define FREQ_EDGE_CYCLES_MIN        3   // freq_edgeが1周期に使う最小サイクル数
+
+// 平均、標準偏差、最小、最大(Welford法)
+typedef struct {
+    uint32_t num;
+    double mean;
+    double m2;              // 偏差の2乗和
+    double min;
+    double max;
+} freq_stat_t;
+
+// エッジ数の集計
+typedef struct {
+    uint32_t gates;         // ゲート数
+    double gate_s;          // 1ゲートの時間(秒)
+    double window_s;        // 全体の時間(秒)
+    uint64_t edges;         // 全体のエッジ数
+    double freq_hz;         // 全体の周波数
+    freq_stat_t gate_hz;    // ゲートごとの周波数
+} freq_count_result_t;
+
+// パルス幅の集計(時間は秒)
+typedef struct {
+    uint32_t periods;       // 集計した周期数
+    double freq_hz;         // 1 / 平均周期
+    double duty;            // Hの合計 / 周期の合計(0～1)
+    double resolution_s;    // 分解能(1ループの時間)
+    freq_stat_t period;
+    freq_stat_t high;
+    freq_stat_t low;
+} freq_pulse_result_t;
+
+void freq_stat_clear(freq_stat_t *p_stat);
+void freq_stat_add(freq_stat_t *p_stat, double value);
+double freq_stat_std(const freq_stat_t *p_stat);
+
+void freq_count_analyze(const uint32_t *p_snap, uint32_t num, uint32_t ticks_per_gate,
+                        double tick_s, freq_count_result_t *p_result);
+uint32_t freq_pulse_cycles(uint32_t raw, bool is_high);
+void freq_pulse_analyze(const uint32_t *p_raw, uint32_t num, double cycle_s, freq_pulse_result_t *p_result);
+
+#endif // FREQ_H
@@ -0,0 +1,233 @@
+/**
+ * @file freq_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 周波数カウンタとパルス幅計測のH/W層(RP2350、PIO+DMA)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "freq_hw.h"
+#include "dma_service.h"
+#include "freq.pio.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include "pico/time.h"
+
+#define FREQ_HW_CH_NONE     0xFFFFFFFFUL
+
+// 計測中に借りている資源
+typedef struct {
+    PIO pio;
+    const pio_program_t *p_program;
+    int32_t sm;
+    uint32_t offset;
+    uint32_t ch_rx;         // RX FIFO → バッファ
+    uint32_t ch_exec;       // 命令 → SMx_INSTR(freq_edgeのみ)
+    int32_t timer;          // ch_execのペース(freq_edgeのみ)
+} freq_hw_res_t;
+
+static uint32_t s_freq_buf[FREQ_HW_BUF_WORDS];
+static uint32_t s_freq_exec_insn;   // DMAが強制実行させる`in x, 32`
+
+// 借りた資源を返す(途中まで借りた状態でもよい)
+static void freq_hw_close(freq_hw_res_t *p_res)
+{
+    if (p_res->sm >= 0) {
+        pio_sm_set_enabled(p_res->pio, (uint)p_res->sm, false);
+    }
+    if (p_res->ch_exec != FREQ_HW_CH_NONE) {
+        dma_channel_abort(p_res->ch_exec);
+        dma_svc_ch_release(p_res->ch_exec);
+    }
+    if (p_res->ch_rx != FREQ_HW_CH_NONE) {
+        dma_channel_abort(p_res->ch_rx);
+        dma_svc_ch_release(p_res->ch_rx);
+    }
+    if (p_res->timer >= 0) {
+        dma_timer_unclaim((uint)p_res->timer);
+    }
+    if (p_res->sm >= 0) {
+        pio_sm_clear_fifos(p_res->pio, (uint)p_res->sm);
+        pio_remove_program(p_res->pio, p_res->p_program, p_res->offset);
+        pio_sm_unclaim(p_res->pio, (uint)p_res->sm);
+    }
+}
+
+// PIOのSM、DMAチャネル(とタイマー)を借りてプログラムをロード
+static bool freq_hw_open(freq_hw_res_t *p_res, const pio_program_t *p_program, uint32_t pin, bool is_exec)
+{
+    p_res->pio = FREQ_HW_PIO;
+    p_res->p_program = p_program;
+    p_res->sm = -1;
+    p_res->ch_rx = FREQ_HW_CH_NONE;
+    p_res->ch_exec = FREQ_HW_CH_NONE;
+    p_res->timer = -1;
+
+    if (!pio_can_add_program(p_res->pio, p_program)) {
+        return false;
+    }
+    int32_t sm = pio_claim_unused_sm(p_res->pio, false);
+    if (sm < 0) {
+        return false;
+    }
+    p_res->offset = (uint32_t)pio_add_program(p_res->pio, p_program);
+    p_res->sm = sm;
+
+    if (!dma_svc_ch_acquire(&p_res->ch_rx)) {
+        p_res->ch_rx = FREQ_HW_CH_NONE;
+        freq_hw_close(p_res);
+        return false;
+    }
+    if (is_exec) {
+        if (!dma_svc_ch_acquire(&p_res->ch_exec)) {
+            p_res->ch_exec = FREQ_HW_CH_NONE;
+            freq_hw_close(p_res);
+            return false;
+        }
+        p_res->timer = dma_claim_unused_timer(false);
+        if (p_res->timer < 0) {
+            freq_hw_close(p_res);
+            return false;
+        }
+    }
+
+    // 他の機能に割り当て済みのピンはそのまま測る
+    if (gpio_get_function(pin) == GPIO_FUNC_NULL) {
+        gpio_init(pin);
+    }
+
+    return true;
+}
+
+// RX FIFOをnum語だけバッファへ吸い出すDMAを開始
+static void freq_hw_start_rx(const freq_hw_res_t *p_res, uint32_t num)
+{
+    dma_channel_config c = dma_channel_get_default_config(p_res->ch_rx);
+
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, pio_get_dreq(p_res->pio, (uint)p_res->sm, false));
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(p_res->ch_rx, &c, s_freq_buf, &p_res->pio->rxf[p_res->sm], num, true);
+}
+
+// 吸い出しが終わるまで待つ(中断かタイムアウトなら取れたところまで)
+static void freq_hw_wait(const freq_hw_res_t *p_res, uint32_t num, uint64_t deadline_us,
+                         bool (*p_poll)(void), freq_hw_capture_t *p_cap)
+{
+    while (dma_channel_is_busy(p_res->ch_rx))
+    {
+        if ((deadline_us != 0 && time_us_64() >= deadline_us) || (p_poll != NULL && p_poll())) {
+            break;
+        }
+    }
+    pio_sm_set_enabled(p_res->pio, (uint)p_res->sm, false);
+
+    p_cap->p_buf = s_freq_buf;
+    p_cap->num = num - dma_hw->ch[p_res->ch_rx].transfer_count;
+    p_cap->is_complete = (p_cap->num == num);
+}
+
+/**
+ * @brief エッジ数を数える(ゲートごとの周波数の元データ)
+ * @note DMAタイマーの周期でもう1つのDMAが`in x, 32`をSMに強制実行させ、xのスナップショットを取る
+ *       タイマーの周期は65535サイクルまでなので、1ゲートを複数のスナップショット周期に分ける
+ *       計測中はCPUを使わない(待つだけ)
+ *
+ * @param pin 計測するGPIO
+ * @param gate_us 1ゲートの時間(μs)
+ * @param p_gates ゲート数(バッファに入る数まで減らす)
+ * @param p_ticks_per_gate 1ゲートのスナップショット周期数
+ * @param p_tick_s スナップショットの周期(秒)
+ * @param p_cap 結果(スナップショット ゲート数*ticks_per_gate+1 個)
+ * @param p_poll 待ちの間に呼ぶ(trueを返すと中断)
+ * @return true 計測した
+ * @return false 引数の範囲外か、PIO/DMAの空きが無い
+ */
+bool freq_hw_count(uint32_t pin, uint32_t gate_us, uint32_t *p_gates, uint32_t *p_ticks_per_gate,
+                   double *p_tick_s, freq_hw_capture_t *p_cap, bool (*p_poll)(void))
+{
+    freq_hw_res_t res;
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    uint64_t gate_cycles = (uint64_t)sys_hz * gate_us / 1000000;
+    uint32_t ticks = (uint32_t)((gate_cycles + FREQ_HW_TICK_CYCLES_MAX - 1) / FREQ_HW_TICK_CYCLES_MAX);
+    uint32_t tick_cycles = (ticks > 0) ? (uint32_t)((gate_cycles + ticks / 2) / ticks) : 0;
+    uint32_t gates = *p_gates;
+
+    if (tick_cycles == 0 || ticks >= FREQ_HW_BUF_WORDS) {
+        return false;
+    }
+    if (gates * ticks + 1 > FREQ_HW_BUF_WORDS) {
+        gates = (FREQ_HW_BUF_WORDS - 1) / ticks;
+    }
+    uint32_t num = gates * ticks + 1;
+    if (gates == 0) {
+        return false;
+    }
+    if (!freq_hw_open(&res, &freq_edge_program, pin, true)) {
+        return false;
+    }
+
+    freq_edge_program_init(res.pio, (uint)res.sm, res.offset, pin);
+    s_freq_exec_insn = pio_encode_in(pio_x, 32);
+    dma_timer_set_fraction((uint)res.timer, 1, (uint16_t)tick_cycles);
+    freq_hw_start_rx(&res, num);
+
+    dma_channel_config c = dma_channel_get_default_config(res.ch_exec);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, dma_get_timer_dreq((uint)res.timer));
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(res.ch_exec, &c, &res.pio->sm[res.sm].instr, &s_freq_exec_insn, num, false);
+
+    pio_sm_set_enabled(res.pio, (uint)res.sm, true);
+    dma_channel_start(res.ch_exec);
+    freq_hw_wait(&res, num, 0, p_poll, p_cap);
+    freq_hw_close(&res);
+
+    *p_gates = gates;
+    *p_ticks_per_gate = ticks;
+    *p_tick_s = (double)tick_cycles / (double)sys_hz;
+
+    return true;
+}
+
+/**
+ * @brief H/Lの幅をperiods周期分(+捨てる先頭1周期)取る
+ * @note SMのクロックはシステムクロックのまま(分解能2サイクル)
+ *
+ * @param pin 計測するGPIO
+ * @param periods 周期数
+ * @param timeout_ms タイムアウト(遅い信号は取れたところまで)
+ * @param p_cap 結果(H,L,H,L...)
+ * @param p_poll 待ちの間に呼ぶ(trueを返すと中断)
+ * @return true 計測した
+ * @return false 引数の範囲外か、PIO/DMAの空きが無い
+ */
+bool freq_hw_pulse(uint32_t pin, uint32_t periods, uint32_t timeout_ms,
+                   freq_hw_capture_t *p_cap, bool (*p_poll)(void))
+{
+    freq_hw_res_t res;
+    uint32_t num = (periods + 1) * 2;
+
+    if (periods == 0 || num > FREQ_HW_BUF_WORDS) {
+        return false;
+    }
+    if (!freq_hw_open(&res, &freq_pulse_program, pin, false)) {
+        return false;
+    }
+
+    freq_pulse_program_init(res.pio, (uint)res.sm, res.offset, pin);
+    freq_hw_start_rx(&res, num);
+    pio_sm_set_enabled(res.pio, (uint)res.sm, true);
+    freq_hw_wait(&res, num, time_us_64() + (uint64_t)timeout_ms * 1000, p_poll, p_cap);
+    freq_hw_close(&res);
+
+    return true;
+}
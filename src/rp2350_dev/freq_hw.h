@@ -0,0 +1,32 @@
+/**
+ * @file freq_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 周波数カウンタとパルス幅計測のH/W層(RP2350、PIO+DMA)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FREQ_HW_H
+#define FREQ_HW_H
+
+#include "freq.h"
+
+#define FREQ_HW_PIO             pio1        // 使うPIO(PIO0はblink)
+#define FREQ_HW_BUF_WORDS       4096        // 生データのバッファ(語)
+#define FREQ_HW_TICK_CYCLES_MAX 65535       // DMAタイマーの周期の上限(システムクロック、分母16bit)
+
+// キャプチャの結果
+typedef struct {
+    const uint32_t *p_buf;  // 生データ(次の計測まで有効)
+    uint32_t num;           // 取れた語数(中断・タイムアウトなら途中まで)
+    bool is_complete;       // 全部取れた
+} freq_hw_capture_t;
+
+bool freq_hw_count(uint32_t pin, uint32_t gate_us, uint32_t *p_gates, uint32_t *p_ticks_per_gate,
+                   double *p_tick_s, freq_hw_capture_t *p_cap, bool (*p_poll)(void));
+bool freq_hw_pulse(uint32_t pin, uint32_t periods, uint32_t timeout_ms,
+                   freq_hw_capture_t *p_cap, bool (*p_poll)(void));
+
+#endif // FREQ_HW_H
@@ -0,0 +1,246 @@
+/**
+ * @file gpio_bench.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief GPIOのトグル速度の計測(方式の表、PIOプログラムの生成、結果の表示)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "gpio_bench.h"
+#include "pio_insn.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 方式の表
+typedef struct {
+    const char *p_name;
+    const char *p_desc;
+} gpio_bench_method_info_t;
+
+static const gpio_bench_method_info_t s_method_tbl[GPIO_BENCH_METHOD_NUM] = {
+    {"put",         "gpio_put()/gpio_put_masked()"},
+    {"sio_sc",      "SIO GPIO_OUT_SET/CLR"},
+    {"sio_xor",     "SIO GPIO_OUT_XOR"},
+    {"gpioc_sc",    "GPIO coprocessor set/clr"},
+    {"gpioc_xor",   "GPIO coprocessor xor"},
+    {"pio_side",    "PIO side-set loop"},
+};
+
+const char *gpio_bench_method_name(gpio_bench_method_t method)
+{
+    return (method < GPIO_BENCH_METHOD_NUM) ? s_method_tbl[method].p_name : "?";
+}
+
+const char *gpio_bench_method_desc(gpio_bench_method_t method)
+{
+    return (method < GPIO_BENCH_METHOD_NUM) ? s_method_tbl[method].p_desc : "?";
+}
+
+/**
+ * @brief 方式を名前で探す
+ *
+ * @param p_name 名前
+ * @return int32_t 方式(無ければ-1)
+ */
+int32_t gpio_bench_find_method(const char *p_name)
+{
+    for (int32_t i = 0; i < GPIO_BENCH_METHOD_NUM; i++)
+    {
+        if (strcmp(p_name, s_method_tbl[i].p_name) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static bool parse_pin(const char *p_str, char **pp_end, uint32_t *p_pin)
+{
+    if (p_str[0] < '0' || p_str[0] > '9') {
+        return false;
+    }
+    *p_pin = (uint32_t)strtoul(p_str, pp_end, 10);
+
+    return (*p_pin <= GPIO_BENCH_PIN_MAX);
+}
+
+/**
+ * @brief ピンの指定を解釈する
+ * @note 「n」(1ピン)、「lo-hi」(範囲)、「#HEX」(マスク、bit nがGPIO n)
+ *
+ * @param p_str 指定
+ * @param p_mask ピンのマスク
+ * @return true OK
+ * @return false 不正(ピンが無い/GPIO_BENCH_PIN_MAXを超える)
+ */
+bool gpio_bench_parse_pins(const char *p_str, uint32_t *p_mask)
+{
+    char *p_end;
+    uint32_t lo;
+    uint32_t hi;
+
+    if (p_str[0] == '#') {
+        if (p_str[1] == '\0') {
+            return false;
+        }
+        *p_mask = (uint32_t)strtoul(&p_str[1], &p_end, 16);
+        return (*p_end == '\0' && *p_mask != 0);
+    }
+
+    if (!parse_pin(p_str, &p_end, &lo)) {
+        return false;
+    }
+    hi = lo;
+    if (*p_end == '-') {
+        if (!parse_pin(p_end + 1, &p_end, &hi) || hi < lo) {
+            return false;
+        }
+    }
+    if (*p_end != '\0') {
+        return false;
+    }
+    *p_mask = (hi == 31 ? 0xFFFFFFFFUL : ((1UL << (hi + 1)) - 1)) & ~((1UL << lo) - 1);
+
+    return true;
+}
+
+/**
+ * @brief 書き込み回数をGPIO_BENCH_UNROLLの倍数(1～GPIO_BENCH_WRITES_MAX)に丸める
+ */
+uint32_t gpio_bench_round_writes(uint32_t writes)
+{
+    if (writes > GPIO_BENCH_WRITES_MAX) {
+        writes = GPIO_BENCH_WRITES_MAX;
+    }
+    writes -= writes % GPIO_BENCH_UNROLL;
+
+    return (writes == 0) ? GPIO_BENCH_UNROLL : writes;
+}
+
+/**
+ * @brief side-setで出すピンの範囲
+ *
+ * @param mask ピンのマスク
+ * @param p_base 先頭のピン
+ * @param p_bits ピン数(先頭から最後のピンまで)
+ * @return true side-setで出せる
+ * @return false 範囲がGPIO_BENCH_PIO_SPAN_MAXを超える
+ */
+bool gpio_bench_pio_span(uint32_t mask, uint32_t *p_base, uint32_t *p_bits)
+{
+    uint32_t base = 0;
+    uint32_t top = 0;
+
+    if (mask == 0) {
+        return false;
+    }
+    while (((mask >> base) & 1) == 0)
+    {
+        base++;
+    }
+    for (uint32_t i = base; i <= GPIO_BENCH_PIN_MAX; i++)
+    {
+        if (((mask >> i) & 1) != 0) {
+            top = i;
+        }
+    }
+    *p_base = base;
+    *p_bits = top - base + 1;
+
+    return (*p_bits <= GPIO_BENCH_PIO_SPAN_MAX);
+}
+
+/**
+ * @brief PIOプログラムを生成
+ * @note
+ *   pull block        side 0
+ *   mov x, osr        side 0
+ *   loop: nop         side mask   ... High
+ *   jmp x-- loop      side 0      ... Low
+ *   push noblock      side 0      ... 終わりをRX FIFOで知らせる
+ *   範囲内でマスクに無いピンはPIOの機能にしないので、side-setの値が0でも動かない
+ *
+ * @param mask ピンのマスク
+ * @param p_prog 生成したプログラム
+ * @return true 生成した
+ * @return false ピンの範囲がside-setで出せない
+ */
+bool gpio_bench_build_pio(uint32_t mask, gpio_bench_prog_t *p_prog)
+{
+    uint32_t n = 0;
+    uint32_t base;
+    uint32_t bits;
+
+    memset(p_prog, 0, sizeof(*p_prog));
+    if (!gpio_bench_pio_span(mask, &base, &bits)) {
+        return false;
+    }
+
+    uint32_t high = mask >> base;
+    p_prog->insn[n++] = pio_insn_side(pio_insn_pull(false, true), bits, 0);
+    p_prog->insn[n++] = pio_insn_side(pio_insn_mov(PIO_INSN_X, PIO_INSN_OSR), bits, 0);
+    uint32_t loop = n;
+    p_prog->insn[n++] = pio_insn_side(pio_insn_nop(), bits, high);
+    p_prog->insn[n++] = pio_insn_side(pio_insn_jmp(PIO_INSN_JMP_X_DEC, loop), bits, 0);
+    p_prog->insn[n++] = pio_insn_side(pio_insn_push(false, false), bits, 0);
+
+    p_prog->length = n;
+    p_prog->wrap_target = 0;
+    p_prog->wrap = n - 1;
+    p_prog->side_base = base;
+    p_prog->side_bits = bits;
+
+    return true;
+}
+
+/**
+ * @brief PIOに渡すループ回数(1周でHigh/Lowの2回書く、Xが0になった周まで回る)
+ */
+uint32_t gpio_bench_pio_loops(uint32_t writes)
+{
+    return (writes / 2) - 1;
+}
+
+/**
+ * @brief 結果の表の見出し
+ *
+ * @param mask ピンのマスク
+ * @param writes 書き込み回数
+ * @param sys_hz システムクロック
+ */
+void gpio_bench_report_header(uint32_t mask, uint32_t writes, uint32_t sys_hz)
+{
+    printf("[GPIO] bench pins #%08lX, %lu writes, clk_sys %lu MHz (toggle = High+Low)\n",
+           (unsigned long)mask, (unsigned long)writes, (unsigned long)(sys_hz / 1000000UL));
+    printf("  %-10s %-30s %10s %10s %9s %12s\n", "Method", "Path", "Cycles", "cyc/write", "ns/write", "Toggle MHz");
+}
+
+/**
+ * @brief 結果の表の1行
+ * @note 小数は整数で計算する(ホストと実機で同じ表示になる)
+ *
+ * @param method 方式
+ * @param p_result 結果
+ * @param sys_hz システムクロック
+ */
+void gpio_bench_report_row(gpio_bench_method_t method, const gpio_bench_result_t *p_result, uint32_t sys_hz)
+{
+    printf("  %-10s %-30s ", gpio_bench_method_name(method), gpio_bench_method_desc(method));
+    if (!p_result->is_valid || p_result->writes == 0 || p_result->cycles == 0 || sys_hz == 0) {
+        printf("n/a (%s)\n", (p_result->p_note != NULL) ? p_result->p_note : "not measured");
+        return;
+    }
+
+    // 1回あたりのサイクル数x100000(writesは8以上なので5.4e13以下、x100000してもuint64に収まる)
+    uint64_t cyc_x100k = (uint64_t)p_result->cycles * 100000ULL / p_result->writes;
+    uint64_t cyc_x100 = (cyc_x100k + 500) / 1000;
+    uint64_t ns_x10 = (cyc_x100k * 100000ULL + sys_hz / 2) / sys_hz;
+    uint64_t toggle_khz = (uint64_t)sys_hz * p_result->writes / (2000ULL * p_result->cycles);
+    printf("%10lu %7lu.%02lu %7lu.%01lu %8lu.%03lu\n", (unsigned long)p_result->cycles,
+           (unsigned long)(cyc_x100 / 100), (unsigned long)(cyc_x100 % 100),
+           (unsigned long)(ns_x10 / 10), (unsigned long)(ns_x10 % 10),
+           (unsigned long)(toggle_khz / 1000), (unsigned long)(toggle_khz % 1000));
+}
@@ -0,0 +1,71 @@
+/**
+ * @file gpio_bench.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief GPIOのトグル速度の計測(方式の表、PIOプログラムの生成、結果の表示)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef GPIO_BENCH_H
+#define GPIO_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(計測はgpio_bench_hw.c、ホストで確認できる)
+
+// 【計測の仕組み】
+// CPUの方式はピンをHigh/Lowに交互にN回書くループ(GPIO_BENCH_UNROLL回ずつ展開)を割り込みを止めてDWTで測る
+// PIOはside-setでHigh/Lowを1命令ずつ出すループで、TX FIFOに回数を書いてからRX FIFOにpushが来るまでを測る
+// 1回の書き込み = ピンのレベルを1回変える、トグル周波数 = 1周期(High+Low = 2回の書き込み)の周波数
+
+#define GPIO_BENCH_PIN_MAX          31              // 対象は下位バンク(GPIO0～31)
+#define GPIO_BENCH_UNROLL           8               // CPUのループの展開数(回数はこの倍数に丸める)
+#define GPIO_BENCH_WRITES_DEF       8192
+#define GPIO_BENCH_WRITES_MAX       (1UL << 20)
+#define GPIO_BENCH_PIO_SPAN_MAX     5               // side-setで出せるピン数(連続したピンの範囲)
+#define GPIO_BENCH_PROG_MAX         8               // PIOプログラムの最大命令数
+
+// 書き込みの方式
+typedef enum {
+    GPIO_BENCH_PUT = 0,     // SDKのgpio_put()(複数ピンはgpio_put_masked())
+    GPIO_BENCH_SIO_SC,      // SIOのGPIO_OUT_SET/GPIO_OUT_CLR
+    GPIO_BENCH_SIO_XOR,     // SIOのGPIO_OUT_XOR
+    GPIO_BENCH_GPIOC_SC,    // GPIOコプロセッサ(MCRR)のset/clr
+    GPIO_BENCH_GPIOC_XOR,   // GPIOコプロセッサ(MCRR)のxor
+    GPIO_BENCH_PIO_SIDE,    // PIOのside-setループ
+    GPIO_BENCH_METHOD_NUM
+} gpio_bench_method_t;
+
+// 1方式の結果
+typedef struct {
+    bool is_valid;
+    const char *p_note;     // 計測できなかった理由(is_validがfalseのとき)
+    uint32_t writes;
+    uint32_t cycles;
+} gpio_bench_result_t;
+
+// PIOプログラム
+typedef struct {
+    uint16_t insn[GPIO_BENCH_PROG_MAX];
+    uint32_t length;
+    uint32_t wrap_target;
+    uint32_t wrap;
+    uint32_t side_base;     // side-setの先頭のピン
+    uint32_t side_bits;     // side-setのビット数(ピン数)
+} gpio_bench_prog_t;
+
+const char *gpio_bench_method_name(gpio_bench_method_t method);
+const char *gpio_bench_method_desc(gpio_bench_method_t method);
+int32_t gpio_bench_find_method(const char *p_name);
+bool gpio_bench_parse_pins(const char *p_str, uint32_t *p_mask);
+uint32_t gpio_bench_round_writes(uint32_t writes);
+bool gpio_bench_pio_span(uint32_t mask, uint32_t *p_base, uint32_t *p_bits);
+bool gpio_bench_build_pio(uint32_t mask, gpio_bench_prog_t *p_prog);
+uint32_t gpio_bench_pio_loops(uint32_t writes);
+void gpio_bench_report_header(uint32_t mask, uint32_t writes, uint32_t sys_hz);
+void gpio_bench_report_row(gpio_bench_method_t method, const gpio_bench_result_t *p_result, uint32_t sys_hz);
+
+#endif // GPIO_BENCH_H
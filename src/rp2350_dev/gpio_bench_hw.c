@@ -0,0 +1,297 @@
+/**
+ * @file gpio_bench_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief GPIOのトグル速度の計測のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "gpio_bench_hw.h"
+#include "mcu_util.h"
+#include "hardware/gpio.h"
+#include "hardware/pio.h"
+#include "hardware/sync.h"
+#include "hardware/structs/sio.h"
+#include <string.h>
+
+// High/Lowを4回ずつ(GPIO_BENCH_UNROLL回の書き込み)
+#define GPIO_BENCH_HW_X4(hi, lo)    hi; lo; hi; lo; hi; lo; hi; lo
+
+// ※ループはSRAMに置く(XIPキャッシュのミスを含めない)、呼び出し側で割り込みを止める
+
+static uint32_t __no_inline_not_in_flash_func(gpio_bench_hw_put)(uint32_t pin, uint32_t loops)
+{
+    uint32_t start = dwt_get_cycles();
+
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        GPIO_BENCH_HW_X4(gpio_put(pin, true), gpio_put(pin, false));
+    }
+
+    return dwt_get_cycles() - start;
+}
+
+static uint32_t __no_inline_not_in_flash_func(gpio_bench_hw_put_masked)(uint32_t mask, uint32_t loops)
+{
+    uint32_t start = dwt_get_cycles();
+
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        GPIO_BENCH_HW_X4(gpio_put_masked(mask, mask), gpio_put_masked(mask, 0));
+    }
+
+    return dwt_get_cycles() - start;
+}
+
+static uint32_t __no_inline_not_in_flash_func(gpio_bench_hw_sio_sc)(uint32_t mask, uint32_t loops)
+{
+    uint32_t start = dwt_get_cycles();
+
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        GPIO_BENCH_HW_X4(sio_hw->gpio_set = mask, sio_hw->gpio_clr = mask);
+    }
+
+    return dwt_get_cycles() - start;
+}
+
+static uint32_t __no_inline_not_in_flash_func(gpio_bench_hw_sio_xor)(uint32_t mask, uint32_t loops)
+{
+    uint32_t start = dwt_get_cycles();
+
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        GPIO_BENCH_HW_X4(sio_hw->gpio_togl = mask, sio_hw->gpio_togl = mask);
+    }
+
+    return dwt_get_cycles() - start;
+}
+
+#if HAS_GPIO_COPROCESSOR
+static uint32_t __no_inline_not_in_flash_func(gpio_bench_hw_gpioc_sc)(uint32_t mask, uint32_t loops)
+{
+    uint32_t start = dwt_get_cycles();
+
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        GPIO_BENCH_HW_X4(gpioc_lo_out_set(mask), gpioc_lo_out_clr(mask));
+    }
+
+    return dwt_get_cycles() - start;
+}
+
+static uint32_t __no_inline_not_in_flash_func(gpio_bench_hw_gpioc_xor)(uint32_t mask, uint32_t loops)
+{
+    uint32_t start = dwt_get_cycles();
+
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        GPIO_BENCH_HW_X4(gpioc_lo_out_xor(mask), gpioc_lo_out_xor(mask));
+    }
+
+    return dwt_get_cycles() - start;
+}
+#endif
+
+/**
+ * @brief PIOのside-setループを1回動かして、回数を書いてからpushが来るまでを測る
+ * @note 終わったらピンをSIOに戻す(Lowのまま)、PIOとステートマシンは毎回返す
+ */
+static void gpio_bench_hw_pio(uint32_t mask, uint32_t writes, gpio_bench_result_t *p_result)
+{
+    PIO pio = GPIO_BENCH_HW_PIO;
+    gpio_bench_prog_t prog;
+    pio_program_t program;
+
+    if (!gpio_bench_build_pio(mask, &prog)) {
+        p_result->p_note = "pins span more than 5";
+        return;
+    }
+    program.instructions = prog.insn;
+    program.length = (uint8_t)prog.length;
+    program.origin = -1;
+    if (!pio_can_add_program(pio, &program)) {
+        p_result->p_note = "no PIO program space";
+        return;
+    }
+    int32_t sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        p_result->p_note = "no free PIO state machine";
+        return;
+    }
+    uint32_t offset = (uint32_t)pio_add_program(pio, &program);
+
+    pio_sm_config cfg = pio_get_default_sm_config();
+    sm_config_set_wrap(&cfg, offset + prog.wrap_target, offset + prog.wrap);
+    sm_config_set_sideset(&cfg, prog.side_bits, false, false);
+    sm_config_set_sideset_pins(&cfg, prog.side_base);
+    pio_sm_init(pio, (uint)sm, offset, &cfg);
+    pio_sm_set_pindirs_with_mask(pio, (uint)sm, mask, mask);
+    for (uint32_t pin = 0; pin <= GPIO_BENCH_PIN_MAX; pin++)
+    {
+        if (((mask >> pin) & 1) != 0) {
+            pio_gpio_init(pio, pin);
+        }
+    }
+    pio_sm_set_enabled(pio, (uint)sm, true);
+
+    uint32_t timeout = writes + GPIO_BENCH_HW_PIO_MARGIN;
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t start = dwt_get_cycles();
+    pio->txf[sm] = gpio_bench_pio_loops(writes);
+    while (pio_sm_is_rx_fifo_empty(pio, (uint)sm) && (dwt_get_cycles() - start) < timeout)
+    {
+        tight_loop_contents();
+    }
+    uint32_t cycles = dwt_get_cycles() - start;
+    restore_interrupts(save);
+
+    bool is_done = !pio_sm_is_rx_fifo_empty(pio, (uint)sm);
+    pio_sm_set_enabled(pio, (uint)sm, false);
+    sio_hw->gpio_clr = mask;
+    for (uint32_t pin = 0; pin <= GPIO_BENCH_PIN_MAX; pin++)
+    {
+        if (((mask >> pin) & 1) != 0) {
+            gpio_set_function(pin, GPIO_FUNC_SIO);
+        }
+    }
+    pio_sm_clear_fifos(pio, (uint)sm);
+    pio_remove_program(pio, &program, offset);
+    pio_sm_unclaim(pio, (uint)sm);
+
+    if (!is_done) {
+        p_result->p_note = "PIO timeout";
+        return;
+    }
+    p_result->cycles = cycles;
+    p_result->is_valid = true;
+}
+
+/**
+ * @brief ピンをSIOの出力にする(もう出力なら何もしない、レベルも変えない)
+ * @note 他の周辺(UART/SPI/I2C/PIO等)が使っているピンがあれば1本も設定しない
+ *
+ * @param mask ピンのマスク
+ * @param p_busy_pin 使われていたピン(falseのとき)
+ * @param p_new_mask 今回設定したピン
+ * @return true 全部SIOの出力になった
+ * @return false 使われているピンがある
+ */
+bool gpio_bench_hw_setup_out(uint32_t mask, uint32_t *p_busy_pin, uint32_t *p_new_mask)
+{
+    *p_new_mask = 0;
+    for (uint32_t pin = 0; pin <= GPIO_BENCH_PIN_MAX; pin++)
+    {
+        if (((mask >> pin) & 1) == 0) {
+            continue;
+        }
+        if (gpio_get_function(pin) != GPIO_FUNC_NULL && gpio_get_function(pin) != GPIO_FUNC_SIO) {
+            *p_busy_pin = pin;
+            return false;
+        }
+    }
+
+    for (uint32_t pin = 0; pin <= GPIO_BENCH_PIN_MAX; pin++)
+    {
+        if (((mask >> pin) & 1) == 0) {
+            continue;
+        }
+        if (gpio_get_function(pin) != GPIO_FUNC_SIO || !gpio_is_dir_out(pin)) {
+            gpio_init(pin);
+            gpio_set_dir(pin, GPIO_OUT);
+            *p_new_mask |= 1UL << pin;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief ピンを未使用(GPIO_FUNC_NULL)に戻す
+ *
+ * @param mask ピンのマスク(SIOのピンだけ戻す)
+ */
+void gpio_bench_hw_release(uint32_t mask)
+{
+    for (uint32_t pin = 0; pin <= GPIO_BENCH_PIN_MAX; pin++)
+    {
+        if (((mask >> pin) & 1) != 0 && gpio_get_function(pin) == GPIO_FUNC_SIO) {
+            gpio_deinit(pin);
+        }
+    }
+}
+
+/**
+ * @brief 1方式を計測(先にgpio_bench_hw_setup_out()でピンを出力にしておく)
+ * @note 割り込みを止めて測る、計測の前後でピンはLow
+ *
+ * @param method 方式
+ * @param mask ピンのマスク(1ピンならgpio_put()、複数ならgpio_put_masked())
+ * @param writes 書き込み回数(gpio_bench_round_writes()で丸めた値)
+ * @param p_result 結果
+ * @return true 計測した
+ * @return false この方式は使えない(p_result->p_noteに理由)
+ */
+bool gpio_bench_hw_run(gpio_bench_method_t method, uint32_t mask, uint32_t writes, gpio_bench_result_t *p_result)
+{
+    uint32_t loops = writes / GPIO_BENCH_UNROLL;
+    uint32_t cycles = 0;
+    uint32_t save;
+
+    memset(p_result, 0, sizeof(*p_result));
+    p_result->writes = writes;
+
+    // DWTはコアごとなので、呼んだコアで有効にする
+    dwt_init();
+    sio_hw->gpio_clr = mask;
+    if (method == GPIO_BENCH_PIO_SIDE) {
+        gpio_bench_hw_pio(mask, writes, p_result);
+        return p_result->is_valid;
+    }
+#if !HAS_GPIO_COPROCESSOR
+    if (method == GPIO_BENCH_GPIOC_SC || method == GPIO_BENCH_GPIOC_XOR) {
+        p_result->p_note = "no GPIO coprocessor on this core";
+        return false;
+    }
+#endif
+
+    save = save_and_disable_interrupts();
+    switch (method)
+    {
+        case GPIO_BENCH_PUT:
+            if ((mask & (mask - 1)) == 0) {
+                cycles = gpio_bench_hw_put((uint32_t)__builtin_ctz(mask), loops);
+            } else {
+                cycles = gpio_bench_hw_put_masked(mask, loops);
+            }
+            break;
+        case GPIO_BENCH_SIO_SC:
+            cycles = gpio_bench_hw_sio_sc(mask, loops);
+            break;
+        case GPIO_BENCH_SIO_XOR:
+            cycles = gpio_bench_hw_sio_xor(mask, loops);
+            break;
+#if HAS_GPIO_COPROCESSOR
+        case GPIO_BENCH_GPIOC_SC:
+            cycles = gpio_bench_hw_gpioc_sc(mask, loops);
+            break;
+        case GPIO_BENCH_GPIOC_XOR:
+            cycles = gpio_bench_hw_gpioc_xor(mask, loops);
+            break;
+#endif
+        default:
+            break;
+    }
+    restore_interrupts(save);
+
+    if (cycles == 0) {
+        p_result->p_note = "unknown method";
+        return false;
+    }
+    p_result->cycles = cycles;
+    p_result->is_valid = true;
+
+    return true;
+}
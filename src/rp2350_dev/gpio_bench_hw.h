@@ -0,0 +1,23 @@
+/**
+ * @file gpio_bench_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief GPIOのトグル速度の計測のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef GPIO_BENCH_HW_H
+#define GPIO_BENCH_HW_H
+
+#include "gpio_bench.h"
+
+#define GPIO_BENCH_HW_PIO           pio1        // 使うPIO(PIO0はblink)
+#define GPIO_BENCH_HW_PIO_MARGIN    100000      // PIOの完了待ちの余裕(サイクル、書き込み回数に足す)
+
+bool gpio_bench_hw_setup_out(uint32_t mask, uint32_t *p_busy_pin, uint32_t *p_new_mask);
+void gpio_bench_hw_release(uint32_t mask);
+bool gpio_bench_hw_run(gpio_bench_method_t method, uint32_t mask, uint32_t writes, gpio_bench_result_t *p_result);
+
+#endif // GPIO_BENCH_HW_H
@@ -0,0 +1,39 @@
+/**
+ * @file hot_path.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホットパス(SRAM配置)の登録情報の列挙
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "hot_path.h"
+#include <stddef.h>
+
+#if HOT_PATH_ON_DEVICE
+// リンカが定義するセクションの先頭/終端
+extern const hot_path_entry_t __start_hot_path_tbl[];
+extern const hot_path_entry_t __stop_hot_path_tbl[];
+
+uint32_t hot_path_count(void)
+{
+    return (uint32_t)(__stop_hot_path_tbl - __start_hot_path_tbl);
+}
+
+const hot_path_entry_t *hot_path_get(uint32_t idx)
+{
+    return (idx < hot_path_count()) ? &__start_hot_path_tbl[idx] : NULL;
+}
+#else
+uint32_t hot_path_count(void)
+{
+    return 0;
+}
+
+const hot_path_entry_t *hot_path_get(uint32_t idx)
+{
+    (void)idx;
+    return NULL;
+}
+#endif // HOT_PATH_ON_DEVICE
@@ -0,0 +1,59 @@
+/**
+ * @file hot_path.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ホットパス(SRAM配置)のアノテーションマクロのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef HOT_PATH_H
+#define HOT_PATH_H
+
+#include <stdint.h>
+
+// 【使い方】
+// void HOT_FUNC(func_name)(void) { ... }   ... 関数をSRAMに配置
+// HOT_PATH_REGISTER(func_name);            ... ramコマンドの一覧に登録
+// ※ホストPCのビルド(PICO_ON_DEVICEが無い/0)では何もしない
+
+// HOT_FUNCをSRAMに置くか(CMakeオプション RP2350_DEV_HOT_PATH_RAM で切り替え)
+#ifndef HOT_PATH_RAM
+#define HOT_PATH_RAM 0
+#endif
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#define HOT_PATH_ON_DEVICE 1
+#else
+#define HOT_PATH_ON_DEVICE 0
+#endif
+
+#if HOT_PATH_ON_DEVICE && HOT_PATH_RAM
+#include "pico.h"
+#define HOT_FUNC(func)      __not_in_flash_func(func)           // 関数をSRAMに配置
+#define HOT_DATA(group)     __not_in_flash(group)               // 定数テーブル等をSRAMに配置
+#else
+#define HOT_FUNC(func)      func
+#define HOT_DATA(group)
+#endif
+
+// ramコマンドで表示する登録情報
+typedef struct {
+    const char *p_name;
+    const void *p_addr;
+} hot_path_entry_t;
+
+#if HOT_PATH_ON_DEVICE
+// 登録情報はセクション"hot_path_tbl"に集め、リンカの__start_/__stop_シンボルで列挙する
+#define HOT_PATH_REGISTER(func) \
+    static const hot_path_entry_t __attribute__((used, section("hot_path_tbl"))) \
+    s_hot_path_entry_##func = {#func, (const void *)(func)}
+#else
+#define HOT_PATH_REGISTER(func) _Static_assert(1, #func)
+#endif
+
+uint32_t hot_path_count(void);
+const hot_path_entry_t *hot_path_get(uint32_t idx);
+
+#endif // HOT_PATH_H
@@ -0,0 +1,92 @@
+/**
+ * @file idle.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief アイドル(WFE)の滞在時間と起床レイテンシの集計
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "idle.h"
+#include <string.h>
+
+/**
+ * @brief 記録を消して集計をnowから始める
+ */
+void idle_core_clear(idle_core_t *p_core, uint64_t now)
+{
+    memset(p_core, 0, sizeof(idle_core_t));
+    lh_clear(&p_core->wake_lat);
+    p_core->since = now;
+}
+
+/**
+ * @brief 寝る直前に呼ぶ
+ */
+void idle_enter(idle_core_t *p_core, uint64_t now)
+{
+    p_core->enter_at = now;
+    p_core->is_sleeping = true;
+}
+
+/**
+ * @brief 起きた直後に呼ぶ
+ * @note 通知が寝る前に来ていたら(WFEがすぐ戻る)レイテンシには入れずimmediateに数える
+ *
+ * @param p_core 記録
+ * @param now 今の時刻
+ * @param reason 起きた理由
+ * @param notify_at 通知した時刻(通知が無ければ0)
+ */
+void idle_exit(idle_core_t *p_core, uint64_t now, idle_wake_t reason, uint64_t notify_at)
+{
+    if (!p_core->is_sleeping) {
+        return;
+    }
+
+    uint64_t slept = now - p_core->enter_at;
+
+    p_core->is_sleeping = false;
+    p_core->sleep_ticks += slept;
+    if (slept > p_core->max_sleep) {
+        p_core->max_sleep = slept;
+    }
+    p_core->sleeps++;
+    p_core->wakes[(reason < IDLE_WAKE_NUM) ? reason : IDLE_WAKE_OTHER]++;
+
+    if (notify_at == 0 || notify_at > now) {
+        return;
+    }
+    if (notify_at < p_core->enter_at) {
+        p_core->immediate++;
+        return;
+    }
+    uint64_t lat = now - notify_at;
+    lh_record(&p_core->wake_lat, (lat > UINT32_MAX) ? UINT32_MAX : (uint32_t)lat);
+}
+
+/**
+ * @brief 滞在率等を計算(他のコアから読んでもよい、寝ている最中ならnowまでを足す)
+ */
+void idle_report(const idle_core_t *p_core, uint64_t now, idle_report_t *p_report)
+{
+    uint64_t sleep = p_core->sleep_ticks;
+
+    if (p_core->is_sleeping && now > p_core->enter_at) {
+        sleep += now - p_core->enter_at;
+    }
+
+    p_report->elapsed = (now > p_core->since) ? now - p_core->since : 0;
+    p_report->sleep = (sleep < p_report->elapsed) ? sleep : p_report->elapsed;
+    p_report->active = p_report->elapsed - p_report->sleep;
+    p_report->residency = (p_report->elapsed > 0) ? (double)p_report->sleep / (double)p_report->elapsed : 0.0;
+    p_report->avg_sleep = (p_core->sleeps > 0) ? (double)p_core->sleep_ticks / (double)p_core->sleeps : 0.0;
+}
+
+const char *idle_wake_name(idle_wake_t reason)
+{
+    static const char *const s_name[IDLE_WAKE_NUM] = {"fifo", "usb", "uart", "timer", "other"};
+
+    return (reason < IDLE_WAKE_NUM) ? s_name[reason] : "?";
+}
@@ -0,0 +1,59 @@
+/**
+ * @file idle.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief アイドル(WFE)の滞在時間と起床レイテンシの集計のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "latency_hist.h"
+
+// ※このモジュールはPico SDKに依存しない(時刻はtick単位で受け取るだけ、ホストで確認できる)
+// ※1コア分の記録はそのコアだけが書く(他のコアは読むだけ、クリアも要求を出して本人がやる)
+
+// 起きた理由
+typedef enum {
+    IDLE_WAKE_FIFO = 0,     // マルチコアFIFO(ジョブ依頼)
+    IDLE_WAKE_USB,          // USB(stdio)の受信
+    IDLE_WAKE_UART,         // UART(シェル)の受信
+    IDLE_WAKE_TIMER,        // タイマーサービスのアラーム
+    IDLE_WAKE_OTHER,        // 通知の無いイベント(他の割り込み、他コアのSEV)
+    IDLE_WAKE_NUM
+} idle_wake_t;
+
+// 1コア分の記録
+typedef struct {
+    uint64_t since;             // 集計開始の時刻
+    uint64_t enter_at;          // 今回寝た時刻
+    uint64_t sleep_ticks;       // 寝ていた合計
+    uint64_t max_sleep;         // 1回の最長
+    uint32_t sleeps;            // 寝た回数
+    uint32_t immediate;         // 寝る前に通知が来ていた(WFEがすぐ戻った)回数
+    uint32_t wakes[IDLE_WAKE_NUM];
+    bool is_sleeping;
+    latency_hist_t wake_lat;    // 通知から再開までのtick数
+} idle_core_t;
+
+// 表示用の集計
+typedef struct {
+    uint64_t elapsed;           // 集計開始からの時間
+    uint64_t sleep;             // 寝ていた時間(寝ている最中の分も含む)
+    uint64_t active;            // elapsed - sleep
+    double residency;           // sleep / elapsed(0～1)
+    double avg_sleep;           // 1回の平均
+} idle_report_t;
+
+void idle_core_clear(idle_core_t *p_core, uint64_t now);
+void idle_enter(idle_core_t *p_core, uint64_t now);
+void idle_exit(idle_core_t *p_core, uint64_t now, idle_wake_t reason, uint64_t notify_at);
+void idle_report(const idle_core_t *p_core, uint64_t now, idle_report_t *p_report);
+const char *idle_wake_name(idle_wake_t reason);
+
+#endif // IDLE_H
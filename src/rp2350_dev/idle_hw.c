@@ -0,0 +1,156 @@
+/**
+ * @file idle_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 低消費電力アイドル(WFE)と起床通知のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "idle_hw.h"
+#include "mcu_util.h"
+#include "hot_path.h"
+#include "hardware/sync.h"
+#include "hardware/structs/sio.h"
+#include "pico/stdio.h"
+#include "pico/time.h"
+
+static idle_core_t s_idle_core[IDLE_HW_CORE_NUM];
+// 起こす側が書く通知(MTIMEの下位32bit、0は通知なし)と理由
+static volatile uint32_t s_notify_at[IDLE_HW_CORE_NUM];
+static volatile idle_wake_t s_notify_reason[IDLE_HW_CORE_NUM];
+// クリアの要求(記録は本人しか書かないので、寝る前に本人が消す)
+static volatile bool s_is_clear_req[IDLE_HW_CORE_NUM];
+static volatile idle_mode_t s_idle_mode = IDLE_MODE_WFE;
+
+/**
+ * @brief 両コア共通の時刻(SIOのMTIME、clk_sysのサイクル数)
+ */
+uint64_t HOT_FUNC(idle_hw_now)(void)
+{
+    uint32_t hi, lo;
+
+    do
+    {
+        hi = sio_hw->mtimeh;
+        lo = sio_hw->mtime;
+    } while (hi != sio_hw->mtimeh);
+
+    return ((uint64_t)hi << 32) | lo;
+}
+HOT_PATH_REGISTER(idle_hw_now);
+
+/**
+ * @brief coreを起こす(割り込みからも呼べる)
+ * @note 最初の通知だけ残す(起きた側が消す)、SEVは寝る直前に来ても取りこぼさない
+ */
+void HOT_FUNC(idle_hw_notify)(uint32_t core, idle_wake_t reason)
+{
+    if (s_notify_at[core] == 0) {
+        uint32_t now = (uint32_t)idle_hw_now();
+        s_notify_reason[core] = reason;
+        s_notify_at[core] = (now != 0) ? now : 1;
+    }
+    __sev();
+}
+HOT_PATH_REGISTER(idle_hw_notify);
+
+// stdioの受信(USBの割り込みはCore0に入るので、シェルのコアはSEVで起こす)
+static void idle_hw_stdio_rx(void *p_param)
+{
+    (void)p_param;
+    idle_hw_notify(IDLE_HW_SHELL_CORE, IDLE_WAKE_USB);
+}
+
+/**
+ * @brief 仕事が無い時に呼ぶ(通知か割り込みまで寝る)
+ * @note 呼ぶ側は「仕事が無いことを確かめる→呼ぶ」でよい
+ *       確かめた後に来た通知はSEVでイベントレジスタに残るので、WFEはすぐ戻る
+ */
+void HOT_FUNC(idle_hw_sleep)(void)
+{
+    uint32_t core = get_core_num();
+    idle_core_t *p_core = &s_idle_core[core];
+
+    if (s_is_clear_req[core]) {
+        idle_core_clear(p_core, idle_hw_now());
+        s_is_clear_req[core] = false;
+    }
+    if (s_idle_mode == IDLE_MODE_SPIN) {
+        NOP();NOP();NOP();
+        return;
+    }
+
+    idle_enter(p_core, idle_hw_now());
+#ifdef _WDT_ENABLE_
+    // WDTをなでられるよう、通知が無くてもWDTの半分で起きる
+    best_effort_wfe_or_timeout(make_timeout_time_ms(_WDT_OVF_TIME_MS_ / 2));
+#else
+    __wfe();
+#endif // _WDT_ENABLE_
+
+    uint64_t now = idle_hw_now();
+    uint32_t notify_lo = s_notify_at[core];
+    idle_wake_t reason = IDLE_WAKE_OTHER;
+    uint64_t notify_at = 0;
+
+    if (notify_lo != 0) {
+        reason = s_notify_reason[core];
+        s_notify_at[core] = 0;
+        // 下位32bitから64bitに戻す(通知は直前なので折り返しは1回まで)
+        notify_at = now - (uint32_t)((uint32_t)now - notify_lo);
+    }
+    idle_exit(p_core, now, reason, notify_at);
+}
+HOT_PATH_REGISTER(idle_hw_sleep);
+
+/**
+ * @brief 初期化(Core1を起動する前に、stdio_init_all()の後で呼ぶ)
+ */
+void idle_hw_init(void)
+{
+    // MTIMEはRISC-V用のタイマーだが、Armからも両コア共通のサイクルカウンタとして使える
+    sio_hw->mtime_ctrl = SIO_MTIME_CTRL_EN_BITS | SIO_MTIME_CTRL_FULLSPEED_BITS;
+
+    uint64_t now = idle_hw_now();
+    for (uint32_t core = 0; core < IDLE_HW_CORE_NUM; core++)
+    {
+        idle_core_clear(&s_idle_core[core], now);
+        s_notify_at[core] = 0;
+        s_is_clear_req[core] = false;
+    }
+
+    stdio_set_chars_available_callback(idle_hw_stdio_rx, NULL);
+}
+
+/**
+ * @brief 両コアの記録を消す(各コアが次に寝る前に消す)
+ */
+void idle_hw_clear(void)
+{
+    for (uint32_t core = 0; core < IDLE_HW_CORE_NUM; core++)
+    {
+        s_is_clear_req[core] = true;
+    }
+    __sev();
+}
+
+void idle_hw_set_mode(idle_mode_t mode)
+{
+    s_idle_mode = mode;
+    __sev();
+}
+
+idle_mode_t idle_hw_get_mode(void)
+{
+    return s_idle_mode;
+}
+
+/**
+ * @brief coreの記録(読むだけ、書いている最中の値が混ざることはある)
+ */
+const idle_core_t *idle_hw_core(uint32_t core)
+{
+    return (core < IDLE_HW_CORE_NUM) ? &s_idle_core[core] : NULL;
+}
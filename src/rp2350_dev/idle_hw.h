@@ -0,0 +1,34 @@
+/**
+ * @file idle_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 低消費電力アイドル(WFE)と起床通知のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef IDLE_HW_H
+#define IDLE_HW_H
+
+#include "idle.h"
+
+#define IDLE_HW_CORE_NUM        2
+#define IDLE_HW_SHELL_CORE      1           // USB(stdio)の受信で起こすコア(dbg_comを回すコア)
+
+// アイドルの仕方
+typedef enum {
+    IDLE_MODE_WFE = 0,      // 通知(SEV)か割り込みまでWFEで寝る
+    IDLE_MODE_SPIN,         // 寝ないで回る(以前の動作、比較用)
+} idle_mode_t;
+
+void idle_hw_init(void);
+void idle_hw_sleep(void);
+void idle_hw_notify(uint32_t core, idle_wake_t reason);
+void idle_hw_clear(void);
+void idle_hw_set_mode(idle_mode_t mode);
+idle_mode_t idle_hw_get_mode(void);
+uint64_t idle_hw_now(void);
+const idle_core_t *idle_hw_core(uint32_t core);
+
+#endif // IDLE_HW_H
@@ -0,0 +1,277 @@
+/**
+ * @file init_graph.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 依存関係つき初期化タスクのスケジューラ(2コアで分担、遅延初期化)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "init_graph.h"
+#include <string.h>
+
+static const init_graph_ops_t *s_p_ops = NULL;
+static const init_task_t *s_p_tbl = NULL;
+static uint32_t s_task_num = 0;
+static init_task_stat_t s_stat[INIT_GRAPH_TASK_MAX];
+static uint32_t s_done_mask = 0;            // 終わったタスク(ロックの中で読み書きする)
+static uint32_t s_boot_mask = 0;            // 起動時に実行するタスク(遅延でないもの)
+
+// 依存関係の表が正しいか(範囲外、自分自身、循環、起動時のタスクが遅延タスクに依存)
+static bool graph_is_valid(const init_task_t *p_tbl, uint32_t num)
+{
+    uint32_t all = (num == INIT_GRAPH_TASK_MAX) ? 0xFFFFFFFFUL : (INIT_GRAPH_DEP(num) - 1);
+    uint32_t deferred = 0;
+    uint32_t sorted = 0;
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (p_tbl[i].p_func == NULL || (p_tbl[i].core_mask & INIT_GRAPH_CORE_ANY) == 0
+            || (p_tbl[i].deps & ~all) != 0 || (p_tbl[i].deps & INIT_GRAPH_DEP(i)) != 0) {
+            return false;
+        }
+        if (p_tbl[i].is_deferred) {
+            deferred |= INIT_GRAPH_DEP(i);
+        }
+    }
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (!p_tbl[i].is_deferred && (p_tbl[i].deps & deferred) != 0) {
+            return false;
+        }
+    }
+
+    // 依存が全部並んだタスクを足していき、足せなくなったら循環
+    for (uint32_t pass = 0; pass < num && sorted != all; pass++)
+    {
+        uint32_t prev = sorted;
+        for (uint32_t i = 0; i < num; i++)
+        {
+            if ((p_tbl[i].deps & ~prev) == 0) {
+                sorted |= INIT_GRAPH_DEP(i);
+            }
+        }
+        if (sorted == prev) {
+            break;
+        }
+    }
+
+    return (sorted == all);
+}
+
+/**
+ * @brief 初期化(タスクの表を登録する)
+ * @note どちらかのコアがinit_graph_run()を呼ぶ前に1回だけ呼ぶ
+ *
+ * @param p_tbl タスクの表(呼び出し側が持ち続ける)
+ * @param num タスク数(INIT_GRAPH_TASK_MAX以下)
+ * @param p_ops 環境の操作
+ * @return true 成功
+ * @return false 表が不正(範囲外の依存、循環、起動時のタスクが遅延タスクに依存)
+ */
+bool init_graph_init(const init_task_t *p_tbl, uint32_t num, const init_graph_ops_t *p_ops)
+{
+    if (num > INIT_GRAPH_TASK_MAX || !graph_is_valid(p_tbl, num)) {
+        return false;
+    }
+
+    s_p_ops = p_ops;
+    s_p_tbl = p_tbl;
+    s_task_num = num;
+    s_done_mask = 0;
+    s_boot_mask = 0;
+    memset(s_stat, 0, sizeof(s_stat));
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (!p_tbl[i].is_deferred) {
+            s_boot_mask |= INIT_GRAPH_DEP(i);
+        }
+    }
+
+    return true;
+}
+
+// 取ったタスクを実行して終わりにする
+static void task_exec(uint32_t id)
+{
+    s_p_tbl[id].p_func();
+
+    uint32_t save = s_p_ops->lock();
+    s_stat[id].end_us = s_p_ops->now_us();
+    s_stat[id].state = INIT_TASK_DONE;
+    s_done_mask |= INIT_GRAPH_DEP(id);
+    s_p_ops->unlock(save);
+}
+
+// 終わったタスク(他のコアが書いた初期化の結果も見えるようにロックを通して読む)
+static uint32_t done_mask_get(void)
+{
+    uint32_t save = s_p_ops->lock();
+    uint32_t mask = s_done_mask;
+    s_p_ops->unlock(save);
+
+    return mask;
+}
+
+static void graph_wait(void)
+{
+    if (s_p_ops->wait != NULL) {
+        s_p_ops->wait();
+    }
+}
+
+/**
+ * @brief このコアで実行できる起動時のタスクを、依存の順に全部実行する
+ * @note 依存先が他のコアで実行中なら待つ。このコアの分が無くなったら戻る(他のコアの分は待たない)
+ *
+ * @param core 呼び出したコアの番号
+ */
+void init_graph_run(uint32_t core)
+{
+    uint32_t core_bit = 1UL << core;
+
+    while (1)
+    {
+        int32_t pick = -1;
+        bool is_left = false;
+
+        uint32_t save = s_p_ops->lock();
+        for (uint32_t i = 0; i < s_task_num; i++)
+        {
+            const init_task_t *p_task = &s_p_tbl[i];
+            if (p_task->is_deferred || s_stat[i].state != INIT_TASK_PENDING || (p_task->core_mask & core_bit) == 0) {
+                continue;
+            }
+            is_left = true;
+            if ((p_task->deps & ~s_done_mask) == 0) {
+                pick = (int32_t)i;
+                break;
+            }
+        }
+        if (pick >= 0) {
+            s_stat[pick].state = INIT_TASK_RUNNING;
+            s_stat[pick].core = (uint8_t)core;
+            s_stat[pick].start_us = s_p_ops->now_us();
+        }
+        s_p_ops->unlock(save);
+
+        if (pick >= 0) {
+            task_exec((uint32_t)pick);
+        } else if (is_left) {
+            graph_wait();
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief タスクが終わっていなければ、依存先も含めてこのコアで実行する(遅延初期化)
+ * @note 他のコアで実行中なら終わるまで待つ
+ *
+ * @param id タスクの番号
+ * @param core 呼び出したコアの番号
+ * @return true 終わっている
+ * @return false 番号が範囲外か、このコアで実行できないタスク
+ */
+bool init_graph_require(uint32_t id, uint32_t core)
+{
+    if (id >= s_task_num) {
+        return false;
+    }
+    if ((done_mask_get() & INIT_GRAPH_DEP(id)) != 0) {
+        return true;
+    }
+
+    uint32_t deps = s_p_tbl[id].deps;
+    for (uint32_t dep = 0; deps != 0; dep++, deps >>= 1)
+    {
+        if ((deps & 1) != 0 && !init_graph_require(dep, core)) {
+            return false;
+        }
+    }
+
+    bool is_mine = false;
+    uint32_t save = s_p_ops->lock();
+    if (s_stat[id].state == INIT_TASK_PENDING) {
+        if ((s_p_tbl[id].core_mask & (1UL << core)) == 0) {
+            s_p_ops->unlock(save);
+            return false;
+        }
+        s_stat[id].state = INIT_TASK_RUNNING;
+        s_stat[id].core = (uint8_t)core;
+        s_stat[id].start_us = s_p_ops->now_us();
+        is_mine = true;
+    }
+    s_p_ops->unlock(save);
+
+    if (is_mine) {
+        task_exec(id);
+    }
+    while ((done_mask_get() & INIT_GRAPH_DEP(id)) == 0)
+    {
+        graph_wait();
+    }
+
+    return true;
+}
+
+/**
+ * @brief タスクが終わったか
+ */
+bool init_graph_is_done(uint32_t id)
+{
+    return (id < s_task_num) && (done_mask_get() & INIT_GRAPH_DEP(id)) != 0;
+}
+
+/**
+ * @brief 起動時のタスク(遅延でないもの)が全部終わったか
+ */
+bool init_graph_is_boot_done(void)
+{
+    return (done_mask_get() & s_boot_mask) == s_boot_mask;
+}
+
+/**
+ * @brief 登録したタスク数
+ */
+uint32_t init_graph_num(void)
+{
+    return s_task_num;
+}
+
+/**
+ * @brief タスクの定義(番号が範囲外ならNULL)
+ */
+const init_task_t *init_graph_task(uint32_t id)
+{
+    return (id < s_task_num) ? &s_p_tbl[id] : NULL;
+}
+
+/**
+ * @brief タスクの実行記録
+ */
+void init_graph_get_stat(uint32_t id, init_task_stat_t *p_stat)
+{
+    uint32_t save = s_p_ops->lock();
+    *p_stat = s_stat[id];
+    s_p_ops->unlock(save);
+}
+
+/**
+ * @brief 名前からタスクの番号を探す
+ *
+ * @return int32_t タスクの番号(無ければ-1)
+ */
+int32_t init_graph_find(const char *p_name)
+{
+    for (uint32_t i = 0; i < s_task_num; i++)
+    {
+        if (strcmp(s_p_tbl[i].p_name, p_name) == 0) {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
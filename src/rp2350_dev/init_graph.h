@@ -0,0 +1,68 @@
+/**
+ * @file init_graph.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 依存関係つき初期化タスクのスケジューラ(2コアで分担、遅延初期化)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef INIT_GRAPH_H
+#define INIT_GRAPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ロックと時刻はinit_graph_ops_tで注入、ホストではスレッドで確認できる)
+// ※タスクの表は呼び出し側が持ち、番号(表の添字)で依存関係を書く
+
+#define INIT_GRAPH_TASK_MAX     32              // タスクの最大数(依存関係はビットマスク)
+#define INIT_GRAPH_CORE_NUM     2
+#define INIT_GRAPH_CORE(n)      (1U << (n))     // 実行してよいコア
+#define INIT_GRAPH_CORE_ANY     0x03            // どちらのコアで実行してもよい
+#define INIT_GRAPH_DEP(id)      (1UL << (id))   // 依存するタスク
+
+// 初期化タスク
+typedef struct {
+    const char *p_name;
+    void (*p_func)(void);
+    uint32_t deps;          // 先に終わっている必要があるタスク(INIT_GRAPH_DEP()のOR)
+    uint8_t core_mask;      // 実行してよいコア(bit0: Core0、bit1: Core1)
+    bool is_deferred;       // 起動時には実行せず、最初に使うときにinit_graph_require()で実行
+} init_task_t;
+
+// タスクの状態
+typedef enum {
+    INIT_TASK_PENDING = 0,
+    INIT_TASK_RUNNING,
+    INIT_TASK_DONE,
+} init_task_state_t;
+
+// タスクの実行記録
+typedef struct {
+    init_task_state_t state;
+    uint8_t core;           // 実行したコア
+    uint32_t start_us;
+    uint32_t end_us;
+} init_task_stat_t;
+
+// 環境の操作(実機はboot_hw.c)
+typedef struct {
+    uint32_t (*lock)(void);
+    void (*unlock)(uint32_t save);
+    uint32_t (*now_us)(void);
+    void (*wait)(void);     // 他のコアのタスクを待つ間に呼ぶ(NULLなら空回り)
+} init_graph_ops_t;
+
+bool init_graph_init(const init_task_t *p_tbl, uint32_t num, const init_graph_ops_t *p_ops);
+void init_graph_run(uint32_t core);
+bool init_graph_require(uint32_t id, uint32_t core);
+bool init_graph_is_done(uint32_t id);
+bool init_graph_is_boot_done(void);
+uint32_t init_graph_num(void);
+const init_task_t *init_graph_task(uint32_t id);
+void init_graph_get_stat(uint32_t id, init_task_stat_t *p_stat);
+int32_t init_graph_find(const char *p_name);
+
+#endif // INIT_GRAPH_H
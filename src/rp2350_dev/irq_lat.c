@@ -0,0 +1,124 @@
+/**
+ * @file irq_lat.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 割り込みの応答時間(PIOで発生させた割り込み)計測
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "irq_lat.h"
+#include "pio_insn.h"
+#include "hot_path.h"
+#include <string.h>
+
+static const char *const s_irq_lat_src_name[IRQ_LAT_SRC_NUM] = {
+    "pio",
+    "gpio",
+};
+
+const char *irq_lat_src_name(irq_lat_src_t src)
+{
+    return (src < IRQ_LAT_SRC_NUM) ? s_irq_lat_src_name[src] : "?";
+}
+
+/**
+ * @brief PIOプログラムを生成
+ * @note
+ *   PIO版:  pull block / mov x, osr / jmp x-- (自分) / irq set 0
+ *   GPIO版: pull block / mov x, osr / jmp x-- (自分) / set pins, 1 [31] / set pins, 0
+ *   どちらもpullからフラグ(ピン)まではN+3サイクル
+ *
+ * @param src 割り込み源
+ * @param p_prog 生成したプログラム
+ * @return true 生成した
+ * @return false 割り込み源が不正
+ */
+bool irq_lat_build_program(irq_lat_src_t src, irq_lat_prog_t *p_prog)
+{
+    uint32_t n = 0;
+
+    memset(p_prog, 0, sizeof(*p_prog));
+    if (src >= IRQ_LAT_SRC_NUM) {
+        return false;
+    }
+
+    p_prog->insn[n++] = pio_insn_pull(false, true);
+    p_prog->insn[n++] = pio_insn_mov(PIO_INSN_X, PIO_INSN_OSR);
+    p_prog->insn[n] = pio_insn_jmp(PIO_INSN_JMP_X_DEC, n);
+    n++;
+    if (src == IRQ_LAT_SRC_PIO) {
+        p_prog->insn[n++] = pio_insn_irq_set(IRQ_LAT_PIO_FLAG);
+    } else {
+        // エッジ検出とポーリングで取りこぼさない幅のパルス
+        p_prog->insn[n++] = pio_insn_delay(pio_insn_set(PIO_INSN_PINS, 1), IRQ_LAT_PULSE_CYCLES - 1);
+        p_prog->insn[n++] = pio_insn_set(PIO_INSN_PINS, 0);
+    }
+
+    p_prog->length = n;
+    p_prog->wrap_target = 0;
+    p_prog->wrap = n - 1;
+
+    return true;
+}
+
+/**
+ * @brief seq番目のサンプルのディレイ(IRQ_LAT_DELAY_MIN～+SPAN-1で散らす)
+ */
+uint32_t irq_lat_delay(uint32_t seq)
+{
+    // 線形合同で散らす(毎回同じ並びなので計測は再現できる)
+    uint32_t x = seq * 1103515245UL + 12345UL;
+
+    return IRQ_LAT_DELAY_MIN + ((x >> 16) % IRQ_LAT_DELAY_SPAN);
+}
+
+void irq_lat_reset(irq_lat_stats_t *p_stats)
+{
+    memset(p_stats, 0, sizeof(*p_stats));
+    lh_clear(&p_stats->hist);
+    p_stats->offset = UINT32_MAX;
+}
+
+/**
+ * @brief 校正のサンプルを追加(割り込みを止めてポーリングでフラグを見たとき)
+ *
+ * @param p_stats 集計
+ * @param t_start FIFOに書いた直後のCYCCNT
+ * @param t_seen フラグが見えた直後のCYCCNT
+ * @param delay 書いたディレイ
+ */
+void irq_lat_calib_add(irq_lat_stats_t *p_stats, uint32_t t_start, uint32_t t_seen, uint32_t delay)
+{
+    // CYCCNTの折り返しは差を取れば吸収できる
+    uint32_t offset = (t_seen - t_start) - delay;
+
+    if (offset < p_stats->offset) {
+        p_stats->offset = offset;
+    }
+    p_stats->calib_num++;
+}
+
+/**
+ * @brief 1サンプルを記録
+ *
+ * @param p_stats 集計(先に校正しておく)
+ * @param t_start FIFOに書いた直後のCYCCNT
+ * @param t_entry ハンドラの先頭で読んだCYCCNT
+ * @param delay 書いたディレイ
+ * @return uint32_t 応答時間(サイクル)
+ */
+uint32_t HOT_FUNC(irq_lat_record)(irq_lat_stats_t *p_stats, uint32_t t_start, uint32_t t_entry, uint32_t delay)
+{
+    int32_t latency = (int32_t)((t_entry - t_start) - delay - p_stats->offset);
+
+    if (latency < 0) {
+        p_stats->early++;
+        latency = 0;
+    }
+    lh_record(&p_stats->hist, (uint32_t)latency);
+
+    return (uint32_t)latency;
+}
+HOT_PATH_REGISTER(irq_lat_record);
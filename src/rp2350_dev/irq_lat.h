@@ -0,0 +1,63 @@
+/**
+ * @file irq_lat.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 割り込みの応答時間(PIOで発生させた割り込み)計測のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef IRQ_LAT_H
+#define IRQ_LAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "latency_hist.h"
+
+// ※このモジュールはPico SDKに依存しない(PIOプログラムの生成と集計だけ、ホストで確認できる)
+
+// 【計測の仕組み】
+// CPUがTX FIFOにディレイNを書いた直後のCYCCNTをt0とする
+// PIOはN+定数サイクル後にIRQフラグを立てる(GPIO版はピンを立ててジャンパ経由でGPIO割り込み)
+// ハンドラの先頭でCYCCNTを読んでt1とし、応答時間 = (t1 - t0) - N - オフセット
+// オフセットは割り込みを止めてフラグをポーリングしたときの最小値(= 見えた瞬間)で校正する
+
+#define IRQ_LAT_PROG_MAX        8       // PIOプログラムの最大命令数
+#define IRQ_LAT_PIO_FLAG        0       // PIOのIRQフラグ番号(irq_lat_hw.cはpis_interrupt0を使う)
+#define IRQ_LAT_DELAY_MIN       64      // PIOのディレイ(サイクル)の最小
+#define IRQ_LAT_DELAY_SPAN      64      // ディレイをこの範囲でずらす(待ちループのどこで割り込むかを散らす)
+#define IRQ_LAT_PULSE_CYCLES    32      // GPIO版のパルス幅
+
+// 割り込み源
+typedef enum {
+    IRQ_LAT_SRC_PIO = 0,    // PIOのIRQフラグ(配線不要)
+    IRQ_LAT_SRC_GPIO,       // PIOでピンを立ててジャンパ経由でGPIOのエッジ割り込み
+    IRQ_LAT_SRC_NUM
+} irq_lat_src_t;
+
+// PIOプログラム
+typedef struct {
+    uint16_t insn[IRQ_LAT_PROG_MAX];
+    uint32_t length;
+    uint32_t wrap_target;
+    uint32_t wrap;
+} irq_lat_prog_t;
+
+// 1構成分の集計(単位はCPUサイクル)
+typedef struct {
+    latency_hist_t hist;
+    uint32_t offset;        // 校正したオフセット
+    uint32_t calib_num;     // 校正のサンプル数
+    uint32_t early;         // 予測より早かった(0として記録)
+    uint32_t timeouts;      // 割り込みが来なかった
+} irq_lat_stats_t;
+
+bool irq_lat_build_program(irq_lat_src_t src, irq_lat_prog_t *p_prog);
+uint32_t irq_lat_delay(uint32_t seq);
+void irq_lat_reset(irq_lat_stats_t *p_stats);
+void irq_lat_calib_add(irq_lat_stats_t *p_stats, uint32_t t_start, uint32_t t_seen, uint32_t delay);
+uint32_t irq_lat_record(irq_lat_stats_t *p_stats, uint32_t t_start, uint32_t t_entry, uint32_t delay);
+const char *irq_lat_src_name(irq_lat_src_t src);
+
+#endif // IRQ_LAT_H
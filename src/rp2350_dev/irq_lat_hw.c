@@ -0,0 +1,221 @@
+/**
+ * @file irq_lat_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 割り込みの応答時間計測のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "irq_lat_hw.h"
+#include "mcu_util.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "hardware/xip_cache.h"
+
+static PIO s_pio = NULL;
+static int32_t s_sm = -1;
+static uint32_t s_offset;
+static irq_lat_prog_t s_prog;
+static pio_program_t s_program;
+static irq_lat_src_t s_src;
+static uint32_t s_in_pin;
+
+// ハンドラからの通知
+static volatile uint32_t s_t_entry;
+static volatile bool s_is_fired;
+
+// 割り込みの要因を消す(PIOのフラグ or GPIOのエッジ)
+static inline void irq_lat_hw_ack(void)
+{
+    if (s_src == IRQ_LAT_SRC_PIO) {
+        s_pio->irq = 1UL << IRQ_LAT_PIO_FLAG;
+    } else {
+        gpio_acknowledge_irq(s_in_pin, GPIO_IRQ_EDGE_RISE);
+    }
+}
+
+// 割り込みの要因が立っているか(校正でポーリングする)
+static inline bool irq_lat_hw_is_raised(void)
+{
+    if (s_src == IRQ_LAT_SRC_PIO) {
+        return (s_pio->irq & (1UL << IRQ_LAT_PIO_FLAG)) != 0;
+    }
+
+    return (sio_hw->gpio_in & (1UL << s_in_pin)) != 0;
+}
+
+// ディレイをFIFOに書いて、直後のCYCCNTを返す
+static inline uint32_t irq_lat_hw_kick(uint32_t delay)
+{
+    s_pio->txf[s_sm] = delay;
+    return dwt_get_cycles();
+}
+
+// ハンドラ(SRAM): 先頭でCYCCNTを読む
+static void __no_inline_not_in_flash_func(irq_lat_hw_isr_sram)(void)
+{
+    s_t_entry = dwt_get_cycles();
+    irq_lat_hw_ack();
+    s_is_fired = true;
+}
+
+// ハンドラ(フラッシュ): 中身はSRAM版と同じ
+static void __attribute__((noinline)) irq_lat_hw_isr_flash(void)
+{
+    s_t_entry = dwt_get_cycles();
+    irq_lat_hw_ack();
+    s_is_fired = true;
+}
+
+static uint32_t irq_lat_hw_irq_num(void)
+{
+    return (s_src == IRQ_LAT_SRC_PIO) ? pio_get_irq_num(s_pio, 0) : IO_IRQ_BANK0;
+}
+
+/**
+ * @brief PIOプログラムをロードしてステートマシンを動かす
+ *
+ * @param p_config 設定(srcとピンだけ使う)
+ * @return true 成功
+ * @return false プログラムかステートマシンの空きが無い
+ */
+bool irq_lat_hw_init(const irq_lat_hw_config_t *p_config)
+{
+    s_pio = IRQ_LAT_HW_PIO;
+    s_src = p_config->src;
+    s_in_pin = p_config->in_pin;
+
+    if (!irq_lat_build_program(s_src, &s_prog)) {
+        return false;
+    }
+    s_program.instructions = s_prog.insn;
+    s_program.length = (uint8_t)s_prog.length;
+    s_program.origin = -1;
+    if (!pio_can_add_program(s_pio, &s_program)) {
+        return false;
+    }
+    s_sm = pio_claim_unused_sm(s_pio, false);
+    if (s_sm < 0) {
+        return false;
+    }
+    s_offset = (uint32_t)pio_add_program(s_pio, &s_program);
+
+    pio_sm_config cfg = pio_get_default_sm_config();
+    sm_config_set_wrap(&cfg, s_offset + s_prog.wrap_target, s_offset + s_prog.wrap);
+    if (s_src == IRQ_LAT_SRC_GPIO) {
+        pio_gpio_init(s_pio, p_config->out_pin);
+        pio_sm_set_consecutive_pindirs(s_pio, (uint)s_sm, p_config->out_pin, 1, true);
+        sm_config_set_set_pins(&cfg, p_config->out_pin, 1);
+        gpio_init(s_in_pin);
+        gpio_set_dir(s_in_pin, GPIO_IN);
+        gpio_pull_down(s_in_pin);
+    }
+    pio_sm_init(s_pio, (uint)s_sm, s_offset, &cfg);
+    pio_sm_set_enabled(s_pio, (uint)s_sm, true);
+
+    return true;
+}
+
+void irq_lat_hw_deinit(void)
+{
+    if (s_sm < 0) {
+        return;
+    }
+
+    pio_sm_set_enabled(s_pio, (uint)s_sm, false);
+    pio_remove_program(s_pio, &s_program, s_offset);
+    pio_sm_unclaim(s_pio, (uint)s_sm);
+    s_pio->irq = 1UL << IRQ_LAT_PIO_FLAG;
+    s_sm = -1;
+}
+
+/**
+ * @brief 呼んだコアで1構成分を計測(校正してからsamples回)
+ * @note 割り込みは最高優先度にして、他の割り込みの処理時間は含めない
+ *
+ * @param p_config 設定
+ * @param p_stats 集計
+ * @return true 計測した
+ * @return false 初期化されていない
+ */
+bool irq_lat_hw_run(const irq_lat_hw_config_t *p_config, irq_lat_stats_t *p_stats)
+{
+    uint32_t irq_num = irq_lat_hw_irq_num();
+
+    if (s_sm < 0) {
+        return false;
+    }
+
+    // DWTはコアごとなので、呼んだコアで有効にする
+    dwt_init();
+    irq_lat_reset(p_stats);
+    irq_set_exclusive_handler(irq_num, p_config->is_sram ? irq_lat_hw_isr_sram : irq_lat_hw_isr_flash);
+    irq_set_priority(irq_num, PICO_HIGHEST_IRQ_PRIORITY);
+    if (s_src == IRQ_LAT_SRC_PIO) {
+        pio_set_irq0_source_enabled(s_pio, pis_interrupt0, true);
+    } else {
+        gpio_set_irq_enabled(s_in_pin, GPIO_IRQ_EDGE_RISE, true);
+    }
+    irq_lat_hw_ack();
+
+    // 校正: NVICは止めたままフラグをポーリング
+    for (uint32_t i = 0; i < IRQ_LAT_HW_CALIB_NUM; i++)
+    {
+        uint32_t delay = irq_lat_delay(i);
+        uint32_t save = save_and_disable_interrupts();
+        uint32_t t_start = irq_lat_hw_kick(delay);
+        uint32_t t_seen;
+
+        do
+        {
+            t_seen = dwt_get_cycles();
+        } while (!irq_lat_hw_is_raised() && (t_seen - t_start) < IRQ_LAT_HW_TIMEOUT);
+        restore_interrupts(save);
+
+        if ((t_seen - t_start) < IRQ_LAT_HW_TIMEOUT) {
+            irq_lat_calib_add(p_stats, t_start, t_seen, delay);
+        }
+        irq_lat_hw_ack();
+    }
+
+    if (p_stats->calib_num > 0) {
+        irq_set_enabled(irq_num, true);
+        for (uint32_t i = 0; i < p_config->samples; i++)
+        {
+            uint32_t delay = irq_lat_delay(i);
+
+            if (p_config->is_cold) {
+                xip_cache_invalidate_all();
+            }
+            s_is_fired = false;
+            uint32_t t_start = irq_lat_hw_kick(delay);
+            while (!s_is_fired && (dwt_get_cycles() - t_start) < IRQ_LAT_HW_TIMEOUT)
+            {
+                tight_loop_contents();
+            }
+
+            if (s_is_fired) {
+                irq_lat_record(p_stats, t_start, s_t_entry, delay);
+            } else {
+                p_stats->timeouts++;
+            }
+        }
+        irq_set_enabled(irq_num, false);
+    } else {
+        p_stats->timeouts = p_config->samples;
+    }
+
+    if (s_src == IRQ_LAT_SRC_PIO) {
+        pio_set_irq0_source_enabled(s_pio, pis_interrupt0, false);
+    } else {
+        gpio_set_irq_enabled(s_in_pin, GPIO_IRQ_EDGE_RISE, false);
+    }
+    irq_lat_hw_ack();
+    irq_remove_handler(irq_num, p_config->is_sram ? irq_lat_hw_isr_sram : irq_lat_hw_isr_flash);
+
+    return true;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file irq_lat_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 割り込みの応答時間計測のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef IRQ_LAT_HW_H
+#define IRQ_LAT_HW_H
+
+#include "irq_lat.h"
+
+#define IRQ_LAT_HW_PIO          pio1        // 使うPIO(PIO0はblink)
+#define IRQ_LAT_HW_CALIB_NUM    256         // 校正のサンプル数
+#define IRQ_LAT_HW_TIMEOUT      100000      // 1サンプルの待ち時間の上限(サイクル)
+
+// 計測の設定
+typedef struct {
+    irq_lat_src_t src;
+    uint32_t out_pin;       // GPIO版: PIOが立てるピン
+    uint32_t in_pin;        // GPIO版: 割り込みを受けるピン(out_pinとジャンパでつなぐ)
+    bool is_sram;           // ハンドラをSRAMに置く(falseならフラッシュ)
+    bool is_cold;           // 毎回XIPキャッシュを無効化する(フラッシュのハンドラ向け)
+    uint32_t samples;
+} irq_lat_hw_config_t;
+
+bool irq_lat_hw_init(const irq_lat_hw_config_t *p_config);
+void irq_lat_hw_deinit(void);
+bool irq_lat_hw_run(const irq_lat_hw_config_t *p_config, irq_lat_stats_t *p_stats);
+
+#endif // IRQ_LAT_HW_H
@@ -0,0 +1,77 @@
+/**
+ * @file jitter.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief アラームの遅れ(ジッタ)計測の集計
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "jitter.h"
+#include "hot_path.h"
+#include <string.h>
+
+static const char *const s_jitter_load_name[JITTER_LOAD_NUM] = {
+    "idle",
+    "mem",
+    "flash",
+};
+
+const char *jitter_load_name(jitter_load_t load)
+{
+    return (load < JITTER_LOAD_NUM) ? s_jitter_load_name[load] : "?";
+}
+
+bool jitter_parse_load(const char *p_str, jitter_load_t *p_load)
+{
+    for (uint32_t i = 0; i < JITTER_LOAD_NUM; i++)
+    {
+        if (strcmp(p_str, s_jitter_load_name[i]) == 0) {
+            *p_load = (jitter_load_t)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 結果を空にして周期を決める
+ *
+ * @param p_result 結果
+ * @param rate_hz アラームの周波数(1～1MHz)
+ */
+void jitter_reset(jitter_result_t *p_result, uint32_t rate_hz)
+{
+    memset(p_result, 0, sizeof(*p_result));
+    lh_clear(&p_result->hist);
+    p_result->period_us = 1000000 / rate_hz;
+}
+
+/**
+ * @brief 予定時刻との差を1回分記録して、次の予定時刻を返す
+ * @note 1周期以上遅れたら追いつくまで連続で発火させず、過ぎた周期は飛ばす
+ *
+ * @param p_result 結果
+ * @param due_us 今回の予定時刻
+ * @param now_us 実際に発火した時刻
+ * @return uint64_t 次の予定時刻(now_usより後)
+ */
+uint64_t HOT_FUNC(jitter_record)(jitter_result_t *p_result, uint64_t due_us, uint64_t now_us)
+{
+    uint32_t period_us = p_result->period_us;
+    uint64_t next_us = due_us + period_us;
+
+    lh_record(&p_result->hist, (now_us > due_us) ? (uint32_t)(now_us - due_us) : 0);
+
+    if (now_us >= next_us) {
+        uint32_t skip = (uint32_t)((now_us - next_us) / period_us) + 1;
+        p_result->overruns++;
+        p_result->skipped += skip;
+        next_us += (uint64_t)skip * period_us;
+    }
+
+    return next_us;
+}
+HOT_PATH_REGISTER(jitter_record);
@@ -0,0 +1,51 @@
+/**
+ * @file jitter.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief アラームの遅れ(ジッタ)計測のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef JITTER_H
+#define JITTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "latency_hist.h"
+
+// ※このモジュールはPico SDKに依存しない(アラームと負荷はjitter_hw.c、ホストで集計を確認できる)
+
+// 計測中に呼んだコア(Core1)でかける負荷
+typedef enum {
+    JITTER_LOAD_IDLE = 0,   // タイマーを読んで待つだけ
+    JITTER_LOAD_MEM,        // SRAMのmemcpy(バス競合)
+    JITTER_LOAD_FLASH,      // キャッシュを通さないフラッシュ読み出し(XIP/QSPIの競合)
+    JITTER_LOAD_NUM
+} jitter_load_t;
+
+// 設定
+typedef struct {
+    uint32_t rate_hz;       // アラームの周波数
+    uint32_t seconds;       // 計測時間
+    jitter_load_t load;
+} jitter_config_t;
+
+// 結果(histの単位はμs)
+typedef struct {
+    latency_hist_t hist;    // 予定時刻からコールバックまでの遅れ
+    uint32_t period_us;
+    uint32_t overruns;      // 1周期以上遅れた回数
+    uint32_t skipped;       // そのために飛ばした周期の数
+    uint32_t irq_core;      // コールバックが動いたコア
+    uint32_t load_loops;    // 負荷ループの回数
+    bool is_timeout;        // 予定の時間内に終わらなかった
+} jitter_result_t;
+
+const char *jitter_load_name(jitter_load_t load);
+bool jitter_parse_load(const char *p_str, jitter_load_t *p_load);
+void jitter_reset(jitter_result_t *p_result, uint32_t rate_hz);
+uint64_t jitter_record(jitter_result_t *p_result, uint64_t due_us, uint64_t now_us);
+
+#endif // JITTER_H
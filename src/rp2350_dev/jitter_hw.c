@@ -0,0 +1,144 @@
+/**
+ * @file jitter_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief アラームの遅れ(ジッタ)計測のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "jitter_hw.h"
+#include "mcu_util.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+#include "hot_path.h"
+
+// コールバックとjitter_hw_run()で共有(計測中はコールバックだけが書く)
+static jitter_result_t *s_p_result = NULL;
+static uint64_t s_target_us;        // 次に発火する予定時刻
+static uint32_t s_remain;           // 残りサンプル数
+static volatile bool s_is_done;
+
+static uint32_t s_load_buf[JITTER_HW_LOAD_BUF_SIZE / sizeof(uint32_t)];
+
+/**
+ * @brief アラームのコールバック(SDKのalarm poolの割り込み)
+ * @note 予定時刻との差を記録して、次の予定時刻で再登録する
+ */
+static int64_t HOT_FUNC(jitter_alarm_callback)(alarm_id_t id, void *p_user_data)
+{
+    uint64_t now_us = time_us_64();
+    uint64_t due_us = s_target_us;
+    (void)id;
+    (void)p_user_data;
+
+    s_target_us = jitter_record(s_p_result, due_us, now_us);
+    s_p_result->irq_core = get_core_num();
+
+    if (--s_remain == 0) {
+        s_is_done = true;
+        return 0;
+    }
+
+    // 負の値: 前回の予定時刻から数えて再登録
+    return -(int64_t)(s_target_us - due_us);
+}
+HOT_PATH_REGISTER(jitter_alarm_callback);
+
+// load: SRAMの前半と後半をmemcpyし合う
+static void jitter_load_mem(void)
+{
+    const uint32_t half = sizeof(s_load_buf) / 2;
+    uint8_t *p_buf = (uint8_t *)s_load_buf;
+
+    memcpy(p_buf, p_buf + half, half);
+    memcpy(p_buf + half, p_buf, half);
+}
+
+// flash: キャッシュを通さずに読む(毎回QSPIのアクセスになる)
+static uint32_t jitter_load_flash(uint32_t offset)
+{
+    const volatile uint32_t *p_src = (const volatile uint32_t *)(XIP_NOCACHE_NOALLOC_BASE + offset);
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        sum += p_src[i];
+    }
+
+    return sum;
+}
+
+/**
+ * @brief 負荷を1回分かける(他の計測からも使う)
+ *
+ * @param load 負荷の種類
+ * @param p_pos フラッシュの読み出し位置(最初は0)
+ */
+void jitter_hw_load_step(jitter_load_t load, uint32_t *p_pos)
+{
+    switch (load)
+    {
+        case JITTER_LOAD_MEM:
+            jitter_load_mem();
+            break;
+
+        case JITTER_LOAD_FLASH:
+            // 読んだ値を捨てると最適化で消えるのでバッファに足しておく
+            s_load_buf[0] += jitter_load_flash(*p_pos);
+            *p_pos = (*p_pos + 1024) % JITTER_HW_FLASH_SPAN;
+            break;
+
+        default:
+            tight_loop_contents();
+            break;
+    }
+}
+
+/**
+ * @brief アラームを周期的に発火させて遅れを計測
+ * @note アラームはSDKのdefault alarm pool(割り込みはCore0)、負荷は呼んだコアでかける
+ *
+ * @param p_config 設定
+ * @param p_result 結果
+ * @return true 計測した
+ * @return false 設定が不正、またはアラームを登録できない
+ */
+bool jitter_hw_run(const jitter_config_t *p_config, jitter_result_t *p_result)
+{
+    if (p_config->rate_hz == 0 || p_config->rate_hz > 1000000 || p_config->seconds == 0 ||
+        p_config->load >= JITTER_LOAD_NUM) {
+        return false;
+    }
+
+    jitter_reset(p_result, p_config->rate_hz);
+    s_p_result = p_result;
+    s_remain = p_config->rate_hz * p_config->seconds;
+    s_is_done = false;
+
+    // 最初の1回は登録の処理が落ち着いてから
+    s_target_us = time_us_64() + p_result->period_us + 100;
+    alarm_id_t id = add_alarm_at(from_us_since_boot(s_target_us), jitter_alarm_callback, NULL, true);
+    if (id <= 0) {
+        return false;
+    }
+
+    // 飛ばした周期の分も待てるよう余裕を持たせる
+    uint64_t deadline_us = s_target_us + (uint64_t)p_config->seconds * 1000000 * 2 + 1000000;
+    uint32_t pos = 0;
+
+    while (!s_is_done && time_us_64() < deadline_us)
+    {
+        jitter_hw_load_step(p_config->load, &pos);
+        p_result->load_loops++;
+        WDT_RST();
+    }
+
+    if (!s_is_done) {
+        cancel_alarm(id);
+        p_result->is_timeout = true;
+    }
+
+    return true;
+}
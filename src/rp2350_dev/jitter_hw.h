@@ -0,0 +1,22 @@
+/**
+ * @file jitter_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief アラームの遅れ(ジッタ)計測のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef JITTER_HW_H
+#define JITTER_HW_H
+
+#include "jitter.h"
+
+#define JITTER_HW_LOAD_BUF_SIZE     8192            // loadで読み書きするSRAMのバイト数
+#define JITTER_HW_FLASH_SPAN        (256 * 1024)    // flashでキャッシュを通さず読む範囲
+
+void jitter_hw_load_step(jitter_load_t load, uint32_t *p_pos);
+bool jitter_hw_run(const jitter_config_t *p_config, jitter_result_t *p_result);
+
+#endif // JITTER_HW_H
@@ -0,0 +1,304 @@
+/**
+ * @file la.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ロジックアナライザ(トリガ判定、キャプチャの読み出し、RLE圧縮)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "la.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *s_la_trig_name_tbl[LA_TRIG_TYPE_NUM] = {
+    "none",
+    "rise",
+    "fall",
+    "edge",
+    "pat",
+};
+
+// 下位widthビットの値を1語の全サンプルに並べる
+static inline uint32_t la_replicate(uint32_t sample, uint32_t width)
+{
+    for (uint32_t w = width; w < 32; w *= 2)
+    {
+        sample |= sample << w;
+    }
+
+    return sample;
+}
+
+/**
+ * @brief ピン数から1サンプルのビット数(2のべき乗)を求める
+ */
+uint32_t la_sample_width(uint32_t pin_num)
+{
+    uint32_t width = 1;
+
+    while (width < pin_num && width < 32)
+    {
+        width *= 2;
+    }
+
+    return width;
+}
+
+uint32_t la_pin_mask(uint32_t pin_num)
+{
+    return (pin_num >= 32) ? 0xFFFFFFFFUL : ((1UL << pin_num) - 1);
+}
+
+/**
+ * @brief キャプチャの先頭からidx番目のサンプル(ピン数でマスク)
+ */
+uint32_t la_capture_sample(const la_capture_t *p_cap, uint32_t idx)
+{
+    uint32_t per_word = 32 / p_cap->width;
+    uint32_t pos = p_cap->first + idx;
+    uint32_t word = p_cap->p_buf[(pos / per_word) & (p_cap->buf_words - 1)];
+
+    return (word >> ((pos % per_word) * p_cap->width)) & la_pin_mask(p_cap->pin_num);
+}
+
+// "<GPIO番号>"を先頭ピンからの相対ビットにする
+static bool la_parse_pin(const char *p_str, uint32_t pin_base, uint32_t pin_num, uint32_t *p_mask)
+{
+    char *p_end;
+    unsigned long pin = strtoul(p_str, &p_end, 0);
+
+    if (p_end == p_str || *p_end != '\0' || pin < pin_base || pin >= pin_base + pin_num) {
+        return false;
+    }
+    *p_mask = 1UL << (pin - pin_base);
+
+    return true;
+}
+
+/**
+ * @brief トリガ条件の文字列を読む
+ * @note none | rise:<gpio> | fall:<gpio> | edge:<gpio> | pat:<mask>:<value>
+ *       パターンのmask/valueは先頭ピンをbit0とした相対(0x付きで16進)
+ *
+ * @return true 読めた
+ * @return false 書式の誤り、またはキャプチャするピンの範囲外
+ */
+bool la_trig_parse(const char *p_str, uint32_t pin_base, uint32_t pin_num, la_trig_t *p_trig)
+{
+    const char *p_arg = strchr(p_str, ':');
+    size_t name_len = (p_arg != NULL) ? (size_t)(p_arg - p_str) : strlen(p_str);
+
+    memset(p_trig, 0, sizeof(la_trig_t));
+    if (p_arg == NULL) {
+        return (strcmp(p_str, s_la_trig_name_tbl[LA_TRIG_NONE]) == 0);
+    }
+    p_arg++;
+
+    for (uint32_t type = LA_TRIG_RISE; type < LA_TRIG_TYPE_NUM; type++)
+    {
+        if (strlen(s_la_trig_name_tbl[type]) != name_len ||
+            strncmp(p_str, s_la_trig_name_tbl[type], name_len) != 0) {
+            continue;
+        }
+
+        p_trig->type = (la_trig_type_t)type;
+        if (type != LA_TRIG_PATTERN) {
+            return la_parse_pin(p_arg, pin_base, pin_num, &p_trig->mask);
+        }
+
+        char *p_end;
+        unsigned long mask = strtoul(p_arg, &p_end, 0);
+        if (p_end == p_arg || *p_end != ':') {
+            return false;
+        }
+        p_arg = p_end + 1;
+        unsigned long value = strtoul(p_arg, &p_end, 0);
+        if (p_end == p_arg || *p_end != '\0') {
+            return false;
+        }
+        if (mask == 0 || (mask & ~la_pin_mask(pin_num)) != 0 || (value & ~mask) != 0) {
+            return false;
+        }
+        p_trig->mask = (uint32_t)mask;
+        p_trig->value = (uint32_t)value;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief 判定の状態を戻す(条件はそのまま)
+ */
+void la_trig_reset(la_trig_t *p_trig)
+{
+    p_trig->prev = 0;
+    p_trig->is_primed = false;
+}
+
+// 1サンプル分の判定
+static inline bool la_trig_check(la_trig_t *p_trig, uint32_t sample)
+{
+    uint32_t cur = sample & p_trig->mask;
+    uint32_t prev = p_trig->prev & p_trig->mask;
+    bool is_hit;
+
+    switch (p_trig->type)
+    {
+        case LA_TRIG_RISE:
+            is_hit = p_trig->is_primed && (prev == 0) && (cur != 0);
+            break;
+        case LA_TRIG_FALL:
+            is_hit = p_trig->is_primed && (prev != 0) && (cur == 0);
+            break;
+        case LA_TRIG_EDGE:
+            is_hit = p_trig->is_primed && (prev != cur);
+            break;
+        case LA_TRIG_PATTERN:
+            is_hit = (cur == p_trig->value);
+            break;
+        default:
+            is_hit = true;
+            break;
+    }
+    p_trig->prev = sample;
+    p_trig->is_primed = true;
+
+    return is_hit;
+}
+
+/**
+ * @brief DMAで届いた1語をトリガ判定する
+ * @note 1語の全サンプルが直前と同じなら(信号が止まっている間の大半)サンプルごとの判定を省く
+ *
+ * @param p_trig トリガ
+ * @param word PIOからの1語
+ * @param width 1サンプルのビット数
+ * @return int32_t 成立した語内の位置(0～32/width-1)、不成立は-1
+ */
+int32_t la_trig_feed_word(la_trig_t *p_trig, uint32_t word, uint32_t width)
+{
+    uint32_t per_word = 32 / width;
+    uint32_t sample_mask = la_pin_mask(width);
+
+    if (p_trig->is_primed && word == la_replicate(p_trig->prev & sample_mask, width)) {
+        if (p_trig->type == LA_TRIG_PATTERN && (p_trig->prev & p_trig->mask) == p_trig->value) {
+            return 0;
+        }
+        return (p_trig->type == LA_TRIG_NONE) ? 0 : -1;
+    }
+
+    for (uint32_t k = 0; k < per_word; k++)
+    {
+        if (la_trig_check(p_trig, (word >> (k * width)) & sample_mask)) {
+            return (int32_t)k;
+        }
+    }
+
+    return -1;
+}
+
+const char *la_trig_name(la_trig_type_t type)
+{
+    return (type < LA_TRIG_TYPE_NUM) ? s_la_trig_name_tbl[type] : "?";
+}
+
+/**
+ * @brief RLEエンコーダを初期化
+ */
+void la_rle_init(la_rle_t *p_rle, uint32_t pin_num)
+{
+    p_rle->value = 0;
+    p_rle->run = 0;
+    p_rle->value_bytes = (pin_num + 7) / 8;
+    p_rle->runs = 0;
+}
+
+// 今のランを書き出す
+static uint32_t la_rle_emit(la_rle_t *p_rle, uint8_t *p_out)
+{
+    uint32_t len = 0;
+    uint32_t rest = p_rle->run - 1;
+
+    for (uint32_t i = 0; i < p_rle->value_bytes; i++)
+    {
+        p_out[len++] = (uint8_t)(p_rle->value >> (i * 8));
+    }
+    do
+    {
+        uint8_t byte = (uint8_t)(rest & 0x7F);
+        rest >>= 7;
+        p_out[len++] = (rest != 0) ? (uint8_t)(byte | 0x80) : byte;
+    } while (rest != 0);
+    p_rle->runs++;
+
+    return len;
+}
+
+/**
+ * @brief サンプルを1つ追加(値が変わったら前のランを書き出す)
+ *
+ * @param p_rle エンコーダ
+ * @param sample サンプル(ピン数でマスク済み)
+ * @param p_out 出力先(LA_RLE_RUN_BYTES_MAXバイト以上)
+ * @return uint32_t 書き出したバイト数
+ */
+uint32_t la_rle_put(la_rle_t *p_rle, uint32_t sample, uint8_t *p_out)
+{
+    uint32_t len = 0;
+
+    if (p_rle->run != 0 && (sample != p_rle->value || p_rle->run == UINT32_MAX)) {
+        len = la_rle_emit(p_rle, p_out);
+        p_rle->run = 0;
+    }
+    p_rle->value = sample;
+    p_rle->run++;
+
+    return len;
+}
+
+/**
+ * @brief 最後のランを書き出す(2回目以降は0)
+ */
+uint32_t la_rle_flush(la_rle_t *p_rle, uint8_t *p_out)
+{
+    uint32_t len = 0;
+
+    if (p_rle->run != 0) {
+        len = la_rle_emit(p_rle, p_out);
+        p_rle->run = 0;
+    }
+
+    return len;
+}
+
+/**
+ * @brief キャプチャを少しずつRLEにする(ダンプを1行ずつ出す用)
+ * @note 0を返すまで繰り返し呼ぶ。最後のランもこの中で書き出す
+ *
+ * @param p_cap キャプチャ
+ * @param p_pos 次のサンプル位置(最初は0、la_rle_init()も済ませておく)
+ * @param p_rle エンコーダ
+ * @param p_out 出力先
+ * @param size 出力先のバイト数(LA_RLE_RUN_BYTES_MAX以上)
+ * @return uint32_t 書き出したバイト数
+ */
+uint32_t la_rle_encode(const la_capture_t *p_cap, uint32_t *p_pos, la_rle_t *p_rle,
+                       uint8_t *p_out, uint32_t size)
+{
+    uint32_t len = 0;
+
+    while (*p_pos < p_cap->samples && len + LA_RLE_RUN_BYTES_MAX <= size)
+    {
+        len += la_rle_put(p_rle, la_capture_sample(p_cap, *p_pos), &p_out[len]);
+        (*p_pos)++;
+    }
+    if (*p_pos >= p_cap->samples && len + LA_RLE_RUN_BYTES_MAX <= size) {
+        len += la_rle_flush(p_rle, &p_out[len]);
+    }
+
+    return len;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file la.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ロジックアナライザ(トリガ判定、キャプチャの読み出し、RLE圧縮)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LA_H
+#define LA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(PIO+DMAの制御はla_hw.c、ホストで確認できる)
+
+// 【キャプチャの形式】
+// PIOが`in pins, width`でサンプルし、32bitごとに自動PUSHしてDMAでリングバッファへ
+// width = ピン数以上の2のべき乗(1,2,4,8,16,32)、1語に32/width個で古いサンプルが下位ビット
+// サンプルの通し番号は32bitで折り返す(リングのサンプル数は2のべき乗なので位置はずれない)
+
+// 【ダンプのRLE形式】(tools/la2vcd.pyで展開)
+// ランごとに 値(ピン数を8bit単位に切り上げたバイト数、リトルエンディアン) + (長さ-1)のLEB128
+
+#define LA_PIN_MAX              32      // 同時にサンプルできるピン数
+#define LA_RLE_RUN_BYTES_MAX    9       // 1ランの最大バイト数(値4 + LEB128 5)
+#define LA_TRIG_POS_NONE        (-1)    // トリガ無しのキャプチャ
+#define LA_DUMP_BEGIN           "# la begin"
+#define LA_DUMP_END             "# la end"
+
+// トリガの種類
+typedef enum {
+    LA_TRIG_NONE = 0,       // すぐに開始
+    LA_TRIG_RISE,           // 1ピンの立ち上がり
+    LA_TRIG_FALL,           // 1ピンの立ち下がり
+    LA_TRIG_EDGE,           // 1ピンの両エッジ
+    LA_TRIG_PATTERN,        // (サンプル & mask) == value
+    LA_TRIG_TYPE_NUM
+} la_trig_type_t;
+
+// トリガの条件と判定の状態(マスクと値は先頭ピンをbit0とした相対)
+typedef struct {
+    la_trig_type_t type;
+    uint32_t mask;
+    uint32_t value;
+    uint32_t prev;          // 1つ前のサンプル
+    bool is_primed;         // prevが有効
+} la_trig_t;
+
+// キャプチャ結果(リングバッファ上の位置)
+typedef struct {
+    const uint32_t *p_buf;  // リングバッファ
+    uint32_t buf_words;     // リングの語数(2のべき乗)
+    uint32_t pin_base;      // 先頭のGPIO番号
+    uint32_t pin_num;       // ピン数
+    uint32_t width;         // 1サンプルのビット数
+    uint32_t rate_hz;       // 実際のサンプリング周波数
+    uint32_t first;         // 先頭サンプルの通し番号
+    uint32_t samples;       // サンプル数
+    int32_t trigger;        // トリガ位置(先頭からのサンプル数、無しはLA_TRIG_POS_NONE)
+} la_capture_t;
+
+// RLEエンコーダの状態
+typedef struct {
+    uint32_t value;         // 今のランの値
+    uint32_t run;           // 今のランの長さ(0: ランなし)
+    uint32_t value_bytes;   // 値のバイト数
+    uint32_t runs;          // 出力したラン数
+} la_rle_t;
+
+uint32_t la_sample_width(uint32_t pin_num);
+uint32_t la_pin_mask(uint32_t pin_num);
+uint32_t la_capture_sample(const la_capture_t *p_cap, uint32_t idx);
+
+bool la_trig_parse(const char *p_str, uint32_t pin_base, uint32_t pin_num, la_trig_t *p_trig);
+void la_trig_reset(la_trig_t *p_trig);
+int32_t la_trig_feed_word(la_trig_t *p_trig, uint32_t word, uint32_t width);
+const char *la_trig_name(la_trig_type_t type);
+
+void la_rle_init(la_rle_t *p_rle, uint32_t pin_num);
+uint32_t la_rle_put(la_rle_t *p_rle, uint32_t sample, uint8_t *p_out);
+uint32_t la_rle_flush(la_rle_t *p_rle, uint8_t *p_out);
+uint32_t la_rle_encode(const la_capture_t *p_cap, uint32_t *p_pos, la_rle_t *p_rle,
+                       uint8_t *p_out, uint32_t size);
+
+#endif // LA_H
@@ -0,0 +1,191 @@
+/**
+ * @file la_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ロジックアナライザのH/W層(RP2350、PIO+DMA)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "la_hw.h"
+#include "pio_insn.h"
+#include "dma_service.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+
+// リングバッファ(DMAのリングはサイズ境界にそろえる)
+static uint32_t s_la_buf[LA_HW_BUF_WORDS] __attribute__((aligned(1UL << LA_HW_RING_BITS)));
+
+/**
+ * @brief ピン数ごとのサンプル数の上限(リング - 停止の余裕)
+ */
+uint32_t la_hw_samples_max(uint32_t pin_num)
+{
+    return (LA_HW_BUF_WORDS - LA_HW_GUARD_WORDS) * (32 / la_sample_width(pin_num));
+}
+
+// DMAが書き終えた語数
+static inline uint32_t la_hw_words_written(uint32_t ch)
+{
+    return LA_HW_XFER_COUNT - (dma_hw->ch[ch].transfer_count & LA_HW_XFER_COUNT);
+}
+
+// DMAがword_endより先の語を書くまで待つ
+static bool la_hw_wait_words(uint32_t ch, uint32_t word_end, bool (*p_poll)(void))
+{
+    while (la_hw_words_written(ch) <= word_end)
+    {
+        if (p_poll != NULL && p_poll()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 1回キャプチャする(トリガ成立から後ろのサンプルが揃うまで戻らない)
+ * @note PIOが毎サンプル`in pins, width`、DMAがRX FIFOからリングへ書き続ける
+ *       トリガはこのコアがDMAの書き込み位置を追いかけて判定する
+ *       使っていないピンだけ入力にする(I2C/SPI等に割り当て済みのピンはそのまま覗く)
+ *
+ * @param p_config 設定
+ * @param p_cap 結果(リングバッファは次のキャプチャまで有効)
+ * @return la_hw_result_t 結果
+ */
+la_hw_result_t la_hw_capture(const la_hw_config_t *p_config, la_capture_t *p_cap)
+{
+    PIO pio = LA_HW_PIO;
+    uint32_t width = la_sample_width(p_config->pin_num);
+    uint32_t per_word = 32 / width;
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    bool is_trig = (p_config->trig.type != LA_TRIG_NONE);
+    uint32_t pre = is_trig ? p_config->pre : 0;
+    la_hw_result_t result = LA_HW_OK;
+
+    // PIOの入力はGPIO0～31を先頭ピンから数える
+    if (p_config->pin_num == 0 || p_config->pin_num > LA_PIN_MAX ||
+        p_config->pin_base + p_config->pin_num > LA_PIN_MAX ||
+        p_config->samples == 0 || p_config->samples > la_hw_samples_max(p_config->pin_num) ||
+        pre >= p_config->samples) {
+        return LA_HW_BAD_CONFIG;
+    }
+
+    // 分周比(整数16bit + 小数8bit)
+    if (p_config->rate_hz == 0 || p_config->rate_hz > sys_hz) {
+        return LA_HW_BAD_RATE;
+    }
+    uint64_t div_x256 = (((uint64_t)sys_hz << 8) + p_config->rate_hz / 2) / p_config->rate_hz;
+    if (div_x256 < 0x100 || div_x256 > 0xFFFFFF) {
+        return LA_HW_BAD_RATE;
+    }
+
+    uint16_t insn = pio_insn_in(PIO_INSN_PINS, width);
+    pio_program_t program = {.instructions = &insn, .length = 1, .origin = -1};
+    uint32_t ch;
+    if (!pio_can_add_program(pio, &program)) {
+        return LA_HW_BUSY;
+    }
+    int32_t sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        return LA_HW_BUSY;
+    }
+    if (!dma_svc_ch_acquire(&ch)) {
+        pio_sm_unclaim(pio, (uint)sm);
+        return LA_HW_BUSY;
+    }
+    uint32_t offset = (uint32_t)pio_add_program(pio, &program);
+
+    for (uint32_t pin = p_config->pin_base; pin < p_config->pin_base + p_config->pin_num; pin++)
+    {
+        if (pin < NUM_BANK0_GPIOS && gpio_get_function(pin) == GPIO_FUNC_NULL) {
+            gpio_init(pin);
+        }
+    }
+
+    pio_sm_config cfg = pio_get_default_sm_config();
+    sm_config_set_wrap(&cfg, offset, offset);
+    sm_config_set_in_pins(&cfg, p_config->pin_base);
+    sm_config_set_in_shift(&cfg, true, true, 32);
+    sm_config_set_fifo_join(&cfg, PIO_FIFO_JOIN_RX);
+    sm_config_set_clkdiv_int_frac8(&cfg, (uint32_t)(div_x256 >> 8), (uint8_t)div_x256);
+    pio_sm_init(pio, (uint)sm, offset, &cfg);
+
+    dma_channel_config dc = dma_channel_get_default_config(ch);
+    channel_config_set_transfer_data_size(&dc, DMA_SIZE_32);
+    channel_config_set_read_increment(&dc, false);
+    channel_config_set_write_increment(&dc, true);
+    channel_config_set_ring(&dc, true, LA_HW_RING_BITS);
+    channel_config_set_dreq(&dc, pio_get_dreq(pio, (uint)sm, false));
+    channel_config_set_irq_quiet(&dc, true);
+    dma_channel_configure(ch, &dc, s_la_buf, &pio->rxf[sm], LA_HW_XFER_COUNT, true);
+    pio_sm_set_enabled(pio, (uint)sm, true);
+
+    // トリガ: プリトリガ分が溜まってから判定を始める
+    la_trig_t trig = p_config->trig;
+    uint32_t trig_word = 0;
+    uint32_t trig_pos = 0;
+    la_trig_reset(&trig);
+    if (is_trig) {
+        uint32_t checked = (pre + per_word - 1) / per_word;
+        int32_t k = -1;
+
+        while (k < 0 && result == LA_HW_OK)
+        {
+            uint32_t written = la_hw_words_written(ch);
+
+            if (written > checked && written - checked > LA_HW_BUF_WORDS - LA_HW_GUARD_WORDS) {
+                result = LA_HW_OVERRUN;
+                break;
+            }
+            while (checked < written)
+            {
+                k = la_trig_feed_word(&trig, s_la_buf[checked & (LA_HW_BUF_WORDS - 1)], width);
+                if (k >= 0) {
+                    break;
+                }
+                checked++;
+            }
+            if (k < 0 && p_config->p_poll != NULL && p_config->p_poll()) {
+                result = LA_HW_ABORTED;
+            }
+        }
+        trig_word = checked;
+        trig_pos = (uint32_t)k;
+    }
+
+    // トリガ位置から後ろのサンプルが揃うまで待つ
+    uint32_t last = trig_pos + (p_config->samples - pre) - 1;
+    if (result == LA_HW_OK && !la_hw_wait_words(ch, trig_word + last / per_word, p_config->p_poll)) {
+        result = LA_HW_ABORTED;
+    }
+
+    pio_sm_set_enabled(pio, (uint)sm, false);
+    dma_channel_abort(ch);
+    uint32_t written = la_hw_words_written(ch);
+    pio_sm_clear_fifos(pio, (uint)sm);
+    pio_remove_program(pio, &program, offset);
+    pio_sm_unclaim(pio, (uint)sm);
+    dma_svc_ch_release(ch);
+
+    // 先頭(トリガのpreサンプル前)が上書きされていないか
+    uint32_t first_word = trig_word - ((pre > trig_pos) ? (pre - trig_pos + per_word - 1) / per_word : 0);
+    if (result == LA_HW_OK && written - first_word > LA_HW_BUF_WORDS) {
+        result = LA_HW_OVERRUN;
+    }
+
+    p_cap->p_buf = s_la_buf;
+    p_cap->buf_words = LA_HW_BUF_WORDS;
+    p_cap->pin_base = p_config->pin_base;
+    p_cap->pin_num = p_config->pin_num;
+    p_cap->width = width;
+    p_cap->rate_hz = (uint32_t)(((uint64_t)sys_hz << 8) / div_x256);
+    p_cap->first = trig_word * per_word + trig_pos - pre;
+    p_cap->samples = (result == LA_HW_OK) ? p_config->samples : 0;
+    p_cap->trigger = is_trig ? (int32_t)pre : LA_TRIG_POS_NONE;
+
+    return result;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file la_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ロジックアナライザのH/W層(RP2350、PIO+DMA)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LA_HW_H
+#define LA_HW_H
+
+#include "la.h"
+
+#define LA_HW_PIO               pio1        // 使うPIO(PIO0はblink)
+#define LA_HW_RING_BITS         15          // リングバッファのサイズ(2^15バイト、DMAのリングの上限)
+#define LA_HW_BUF_WORDS         ((1UL << LA_HW_RING_BITS) / sizeof(uint32_t))
+#define LA_HW_GUARD_WORDS       256         // 停止が遅れても先頭を上書きしないための余裕(語)
+#define LA_HW_XFER_COUNT        0x0FFFFFFFUL    // DMAの転送回数(実質無限、上位4bitはモード)
+
+// キャプチャの設定
+typedef struct {
+    uint32_t pin_base;      // 先頭のGPIO番号
+    uint32_t pin_num;       // ピン数(1～32)
+    uint32_t rate_hz;       // サンプリング周波数
+    uint32_t samples;       // サンプル数(la_hw_samples_max()以下)
+    uint32_t pre;           // トリガより前のサンプル数
+    la_trig_t trig;
+    bool (*p_poll)(void);   // トリガ待ちの間に呼ぶ(trueを返すと中断)
+} la_hw_config_t;
+
+// キャプチャの結果
+typedef enum {
+    LA_HW_OK = 0,
+    LA_HW_ABORTED,          // トリガ待ちを中断した
+    LA_HW_OVERRUN,          // トリガ判定か停止が間に合わず上書きされた
+    LA_HW_BUSY,             // PIOのステートマシンかDMAチャネルの空きが無い
+    LA_HW_BAD_RATE,         // クロック分周の範囲外
+    LA_HW_BAD_CONFIG,       // ピンかサンプル数の範囲外
+} la_hw_result_t;
+
+uint32_t la_hw_samples_max(uint32_t pin_num);
+la_hw_result_t la_hw_capture(const la_hw_config_t *p_config, la_capture_t *p_cap);
+
+#endif // LA_HW_H
@@ -0,0 +1,152 @@
+/**
+ * @file latency_hist.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief レイテンシのヒストグラム(HDR方式の対数線形バケット)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "latency_hist.h"
+#include "hot_path.h"
+#include <string.h>
+
+// 値の桁(2^LH_SUB_BITS未満は0、以降1ずつ増える)
+static inline uint32_t lh_magnitude(uint32_t value)
+{
+    if (value < LH_SUB_NUM) {
+        return 0;
+    }
+
+    return (31 - (uint32_t)__builtin_clz(value)) - (LH_SUB_BITS - 1);
+}
+
+void lh_clear(latency_hist_t *p_hist)
+{
+    memset(p_hist, 0, sizeof(*p_hist));
+    p_hist->min = UINT32_MAX;
+}
+
+/**
+ * @brief 値の入るバケット
+ * @note 桁mのバケットは幅2^m、(value >> m)が[LH_HALF_NUM, LH_SUB_NUM)に入る
+ */
+uint32_t HOT_FUNC(lh_bucket_index)(uint32_t value)
+{
+    uint32_t m = lh_magnitude(value);
+
+    return m * LH_HALF_NUM + (value >> m);
+}
+HOT_PATH_REGISTER(lh_bucket_index);
+
+// バケットに入る最小値
+uint32_t lh_bucket_low(uint32_t idx)
+{
+    if (idx < LH_SUB_NUM) {
+        return idx;
+    }
+
+    uint32_t m = (idx - LH_HALF_NUM) / LH_HALF_NUM;
+    return (idx - m * LH_HALF_NUM) << m;
+}
+
+// バケットに入る最大値
+uint32_t lh_bucket_high(uint32_t idx)
+{
+    if (idx < LH_SUB_NUM) {
+        return idx;
+    }
+
+    uint32_t m = (idx - LH_HALF_NUM) / LH_HALF_NUM;
+    return lh_bucket_low(idx) + ((1UL << m) - 1);
+}
+
+/**
+ * @brief 値を1つ記録(割り込みから呼ぶのでO(1))
+ */
+void HOT_FUNC(lh_record)(latency_hist_t *p_hist, uint32_t value)
+{
+    p_hist->count[lh_bucket_index(value)]++;
+    p_hist->total++;
+    p_hist->sum += value;
+    if (value < p_hist->min) {
+        p_hist->min = value;
+    }
+    if (value > p_hist->max) {
+        p_hist->max = value;
+    }
+}
+HOT_PATH_REGISTER(lh_record);
+
+/**
+ * @brief パーセンタイル値
+ * @note バケット内の最大値を返す(実際の値より小さくは出ない)。ただしmin/maxの範囲に収める
+ *
+ * @param p_hist ヒストグラム
+ * @param percent 0～100
+ * @return uint32_t パーセンタイル値(記録が無ければ0)
+ */
+uint32_t lh_percentile(const latency_hist_t *p_hist, double percent)
+{
+    if (p_hist->total == 0) {
+        return 0;
+    }
+    if (percent <= 0.0) {
+        return p_hist->min;
+    }
+    if (percent >= 100.0) {
+        return p_hist->max;
+    }
+
+    // percent%以上を含む最初のバケット(順位は切り上げ、最低1)
+    uint64_t rank = (uint64_t)((percent * (double)p_hist->total) / 100.0);
+    if ((double)rank * 100.0 < percent * (double)p_hist->total) {
+        rank++;
+    }
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t acc = 0;
+    for (uint32_t i = 0; i < LH_BUCKET_NUM; i++)
+    {
+        acc += p_hist->count[i];
+        if (acc >= rank) {
+            uint32_t value = lh_bucket_high(i);
+            if (value > p_hist->max) {
+                value = p_hist->max;
+            }
+            if (value < p_hist->min) {
+                value = p_hist->min;
+            }
+            return value;
+        }
+    }
+
+    return p_hist->max;
+}
+
+double lh_mean(const latency_hist_t *p_hist)
+{
+    return (p_hist->total > 0) ? (double)p_hist->sum / (double)p_hist->total : 0.0;
+}
+
+/**
+ * @brief [low, high]に入る記録数(バケット単位なので境界はバケットに丸める)
+ */
+uint32_t lh_count_range(const latency_hist_t *p_hist, uint32_t low, uint32_t high)
+{
+    uint32_t num = 0;
+
+    if (low > high) {
+        return 0;
+    }
+
+    for (uint32_t i = lh_bucket_index(low); i <= lh_bucket_index(high); i++)
+    {
+        num += p_hist->count[i];
+    }
+
+    return num;
+}
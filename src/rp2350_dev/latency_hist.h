@@ -0,0 +1,44 @@
+/**
+ * @file latency_hist.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief レイテンシのヒストグラム(HDR方式の対数線形バケット)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+// 2^LH_SUB_BITS未満はそのまま、それ以上は2のべき乗ごとに2^(LH_SUB_BITS-1)個に分ける
+// LH_SUB_BITS=5なら相対誤差は最大1/16(6.25%)、0～2^32-1を464バケットで表す
+#define LH_SUB_BITS         5
+#define LH_SUB_NUM          (1UL << LH_SUB_BITS)
+#define LH_HALF_NUM         (LH_SUB_NUM / 2)
+#define LH_BUCKET_NUM       ((32 - LH_SUB_BITS + 1) * LH_HALF_NUM + LH_HALF_NUM)
+
+// ヒストグラム(記録は割り込みから1か所だけ、読むのは記録を止めてから)
+typedef struct {
+    uint32_t count[LH_BUCKET_NUM];
+    uint32_t total;         // 記録数
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} latency_hist_t;
+
+void lh_clear(latency_hist_t *p_hist);
+void lh_record(latency_hist_t *p_hist, uint32_t value);
+uint32_t lh_bucket_index(uint32_t value);
+uint32_t lh_bucket_low(uint32_t idx);
+uint32_t lh_bucket_high(uint32_t idx);
+uint32_t lh_percentile(const latency_hist_t *p_hist, double percent);
+double lh_mean(const latency_hist_t *p_hist);
+uint32_t lh_count_range(const latency_hist_t *p_hist, uint32_t low, uint32_t high);
+
+#endif // LATENCY_HIST_H
@@ -37,7 +37,6 @@ void trang_gen_rand_num_u32(uint32_t *p_rand_buf, uint32_t gen_num_cnt)
  */
 void sha256_padding(const uint8_t *p_src_buf, size_t len, uint8_t *p_dst_buf, size_t *p_out_len)
 {
-    size_t total_len = len + 1 + 8;
     size_t rem = (len + 1 + 8) % 64;
     size_t pad_len = (rem > 0) ? (64 - rem) : 0;
     size_t padded_len = len + 1 + pad_len + 8;
@@ -98,4 +97,51 @@ void hardware_calc_sha256(const uint8_t *p_data_buf, size_t len, uint8_t *p_hash
     sha256_result_t result;
     sha256_get_result(&result, SHA256_BIG_ENDIAN);
     memcpy(p_hash_buf, result.bytes, 32);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 呼び出したコアのDWTカウンタを有効にする
+ * @note DWTはコアごとなので、計測するコアで呼ぶこと
+ *
+ * @return true CYCCNTが使える
+ * @return false CYCCNTが実装されていない
+ */
+bool dwt_init(void)
+{
+    uint32_t ctrl;
+
+    REG_WRITE_DWORD(DEMCR_ADDR, 0, REG_READ_DWORD(DEMCR_ADDR, 0) | (1UL << DEMCR_TRCENA_BIT));
+
+    ctrl = REG_READ_DWORD(DWT_BASE_ADDR, DWT_CTRL_OFFSET);
+    if (REG_BIT_CHK(ctrl, DWT_CTRL_NOCYCCNT_BIT) != 0) {
+        return false;
+    }
+
+    REG_BIT_SET(ctrl, DWT_CTRL_CYCCNTENA_BIT);
+    if (REG_BIT_CHK(ctrl, DWT_CTRL_NOPRFCNT_BIT) == 0) {
+        REG_BIT_SET(ctrl, DWT_CTRL_CPIEVTENA_BIT);
+        REG_BIT_SET(ctrl, DWT_CTRL_EXCEVTENA_BIT);
+        REG_BIT_SET(ctrl, DWT_CTRL_SLEEPEVTENA_BIT);
+        REG_BIT_SET(ctrl, DWT_CTRL_LSUEVTENA_BIT);
+        REG_BIT_SET(ctrl, DWT_CTRL_FOLDEVTENA_BIT);
+    }
+    REG_WRITE_DWORD(DWT_BASE_ADDR, DWT_CTRL_OFFSET, ctrl);
+
+    return true;
+}
+
+/**
+ * @brief 呼び出したコアのDWTカウンタを読む
+ *
+ * @param p_ctr 読み出し値
+ */
+void dwt_read(dwt_ctr_t *p_ctr)
+{
+    p_ctr->cyc = REG_READ_DWORD(DWT_BASE_ADDR, DWT_CYCCNT_OFFSET);
+    p_ctr->cpi = REG_READ_BYTE(DWT_BASE_ADDR, DWT_CPICNT_OFFSET);
+    p_ctr->exc = REG_READ_BYTE(DWT_BASE_ADDR, DWT_EXCCNT_OFFSET);
+    p_ctr->sleep = REG_READ_BYTE(DWT_BASE_ADDR, DWT_SLEEPCNT_OFFSET);
+    p_ctr->lsu = REG_READ_BYTE(DWT_BASE_ADDR, DWT_LSUCNT_OFFSET);
+    p_ctr->fold = REG_READ_BYTE(DWT_BASE_ADDR, DWT_FOLDCNT_OFFSET);
+    p_ctr->is_evt = (REG_BIT_CHK(REG_READ_DWORD(DWT_BASE_ADDR, DWT_CTRL_OFFSET), DWT_CTRL_NOPRFCNT_BIT) == 0);
+}
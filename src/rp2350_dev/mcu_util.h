@@ -114,13 +114,53 @@ static inline void WDT_RST(void)
 #define UART_BAUD_RATE_460800   460800
 #define UART_BAUD_RATE_921600   921600
 #define UART_BAUD_RATE          UART_BAUD_RATE_921600
+#define UART_SHELL_INDEX        0                   // シェル(stdio)も出すUARTの番号(-1で出さない)
 #define UART_0_TX               0                   // UART0 TX (GPIO 0)
 #define UART_0_RX               1                   // UART0 TX (GPIO 1)
 #define UART_1_TX               4                   // UART1 TX (GPIO 4)
 #define UART_1_RX               5                   // UART1 TX (GPIO 5)
 
+// [DWT関連] Cortex-M33のDWTカウンタ(コアごとに独立)
+#define DEMCR_ADDR              0xE000EDFCUL        // Debug Exception and Monitor Control
+#define DEMCR_TRCENA_BIT        24                  // DWT/ITMの有効化
+#define DWT_BASE_ADDR           0xE0001000UL
+#define DWT_CTRL_OFFSET         0x000
+#define DWT_CYCCNT_OFFSET       0x004               // サイクル数(32bit)
+#define DWT_CPICNT_OFFSET       0x008               // 命令の追加サイクル数(8bit)
+#define DWT_EXCCNT_OFFSET       0x00C               // 例外の出入りのサイクル数(8bit)
+#define DWT_SLEEPCNT_OFFSET     0x010               // スリープのサイクル数(8bit)
+#define DWT_LSUCNT_OFFSET       0x014               // ロード/ストアの追加サイクル数(8bit)
+#define DWT_FOLDCNT_OFFSET      0x018               // 畳み込まれた命令数(8bit)
+#define DWT_CTRL_CYCCNTENA_BIT  0
+#define DWT_CTRL_CPIEVTENA_BIT  17
+#define DWT_CTRL_EXCEVTENA_BIT  18
+#define DWT_CTRL_SLEEPEVTENA_BIT 19
+#define DWT_CTRL_LSUEVTENA_BIT  20
+#define DWT_CTRL_FOLDEVTENA_BIT 21
+#define DWT_CTRL_NOPRFCNT_BIT   24                  // 1ならCPICNT等(8bit)が無い
+#define DWT_CTRL_NOCYCCNT_BIT   25                  // 1ならCYCCNTが無い
+
+// DWTカウンタの読み出し値
+typedef struct {
+    uint32_t cyc;
+    uint8_t cpi;
+    uint8_t exc;
+    uint8_t sleep;
+    uint8_t lsu;
+    uint8_t fold;
+    bool is_evt;            // 8bitカウンタがあるか
+} dwt_ctr_t;
+
+// 呼び出したコアのサイクル数
+static inline uint32_t dwt_get_cycles(void)
+{
+    return REG_READ_DWORD(DWT_BASE_ADDR, DWT_CYCCNT_OFFSET);
+}
+
 void trang_gen_rand_num_u32(uint32_t *p_rand_buf, uint32_t gen_num_cnt);
 void sha256_padding(const uint8_t *p_src_buf, size_t len, uint8_t *p_dst_buf, size_t *p_out_len);
 void hardware_calc_sha256(const uint8_t *p_data_buf, size_t len, uint8_t *p_hash_buf);
+bool dwt_init(void);
+void dwt_read(dwt_ctr_t *p_ctr);
 
 #endif // MCU_UTIL_H
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file mem_arena.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief バンプアロケータ(アリーナ)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "mem_arena.h"
+#include <string.h>
+
+/**
+ * @brief アリーナの初期化
+ *
+ * @param p_arena アリーナ
+ * @param p_buf 割り当てに使うバッファ(先頭がMEM_ARENA_ALIGNに揃っていなくてもよい)
+ * @param size バッファのバイト数
+ */
+void mem_arena_init(mem_arena_t *p_arena, void *p_buf, size_t size)
+{
+    uintptr_t addr = (uintptr_t)p_buf;
+    uintptr_t aligned = (addr + MEM_ARENA_ALIGN - 1) & ~(uintptr_t)(MEM_ARENA_ALIGN - 1);
+
+    p_arena->p_base = (uint8_t *)aligned;
+    p_arena->size = (size > aligned - addr) ? size - (aligned - addr) : 0;
+    p_arena->used = 0;
+    p_arena->peak = 0;
+    p_arena->fails = 0;
+}
+
+/**
+ * @brief メモリを確保(先頭からずらしていくだけなのでO(1)で決定的)
+ *
+ * @param p_arena アリーナ
+ * @param size バイト数
+ * @return void* 確保したメモリ(足りなければNULL)
+ */
+void *mem_arena_alloc(mem_arena_t *p_arena, size_t size)
+{
+    size_t aligned = (size + MEM_ARENA_ALIGN - 1) & ~(size_t)(MEM_ARENA_ALIGN - 1);
+
+    if (size == 0 || aligned < size || aligned > p_arena->size - p_arena->used) {
+        p_arena->fails++;
+        return NULL;
+    }
+
+    void *p = &p_arena->p_base[p_arena->used];
+    p_arena->used += aligned;
+    if (p_arena->used > p_arena->peak) {
+        p_arena->peak = p_arena->used;
+    }
+
+    return p;
+}
+
+/**
+ * @brief 0クリアしたメモリを確保
+ */
+void *mem_arena_calloc(mem_arena_t *p_arena, size_t num, size_t size)
+{
+    if (size != 0 && num > SIZE_MAX / size) {
+        p_arena->fails++;
+        return NULL;
+    }
+
+    void *p = mem_arena_alloc(p_arena, num * size);
+    if (p != NULL) {
+        memset(p, 0, num * size);
+    }
+
+    return p;
+}
+
+/**
+ * @brief 現在の使用位置(mem_arena_release()で戻す位置)
+ */
+size_t mem_arena_mark(const mem_arena_t *p_arena)
+{
+    return p_arena->used;
+}
+
+/**
+ * @brief markの時点より後に確保したメモリをまとめて解放
+ */
+void mem_arena_release(mem_arena_t *p_arena, size_t mark)
+{
+    if (mark < p_arena->used) {
+        p_arena->used = mark;
+    }
+}
+
+void mem_arena_reset(mem_arena_t *p_arena)
+{
+    p_arena->used = 0;
+}
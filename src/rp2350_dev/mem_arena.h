@@ -0,0 +1,43 @@
+/**
+ * @file mem_arena.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief バンプアロケータ(アリーナ)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MEM_ARENA_H
+#define MEM_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+// 【使い方】
+// size_t mark = mem_arena_mark(&arena);
+// p = mem_arena_alloc(&arena, size);   ... 個別の解放は無い
+// mem_arena_release(&arena, mark);     ... markの時点までまとめて解放
+
+#define MEM_ARENA_ALIGN     8       // 確保するメモリのアライメント
+
+// アリーナ(1つのコアからだけ使う、排他しない)
+typedef struct {
+    uint8_t *p_base;
+    size_t size;
+    size_t used;            // 使用中のバイト数
+    size_t peak;            // 使用中のバイト数の最大
+    uint32_t fails;         // 容量不足で確保できなかった回数
+} mem_arena_t;
+
+void mem_arena_init(mem_arena_t *p_arena, void *p_buf, size_t size);
+void *mem_arena_alloc(mem_arena_t *p_arena, size_t size);
+void *mem_arena_calloc(mem_arena_t *p_arena, size_t num, size_t size);
+size_t mem_arena_mark(const mem_arena_t *p_arena);
+void mem_arena_release(mem_arena_t *p_arena, size_t mark);
+void mem_arena_reset(mem_arena_t *p_arena);
+
+#endif // MEM_ARENA_H
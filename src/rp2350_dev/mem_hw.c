@@ -0,0 +1,75 @@
+/**
+ * @file mem_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief プール/スタック計測のH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "mem_hw.h"
+#include "mcu_util.h"
+#include "hardware/sync.h"
+
+// リンカスクリプトのシンボル(Core0: SCRATCH_Y、Core1: SCRATCH_X)
+extern uint32_t __StackBottom[];
+extern uint32_t __StackTop[];
+extern uint32_t __StackOneBottom[];
+extern uint32_t __StackOneTop[];
+
+static bool s_is_stack_painted = false;
+
+static uint32_t mem_hw_core_num(void)
+{
+    return get_core_num();
+}
+
+static uint32_t mem_hw_irq_save(void)
+{
+    return save_and_disable_interrupts();
+}
+
+static void mem_hw_irq_restore(uint32_t save)
+{
+    restore_interrupts(save);
+}
+
+static const mem_pool_ops_t s_mem_pool_ops = {
+    .core_num = mem_hw_core_num,
+    .irq_save = mem_hw_irq_save,
+    .irq_restore = mem_hw_irq_restore,
+};
+
+/**
+ * @brief スタックの塗りつぶしとプールの初期化
+ * @note Core0のmain()からCore1を起動する前に呼ぶこと
+ */
+void mem_hw_init(void)
+{
+    uint32_t sp;
+
+    // Core0は使用中の部分を避けて現在のSPより下だけ、Core1はまだ動いていないので全体
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+    mem_stack_paint(__StackBottom, (uint32_t *)((sp - MEM_STACK_MARGIN) & ~3UL));
+    mem_stack_paint(__StackOneBottom, __StackOneTop);
+    s_is_stack_painted = true;
+
+    mem_pool_sys_init(&s_mem_pool_ops);
+}
+
+/**
+ * @brief スタックのサイズと使用量の最大値
+ *
+ * @param core コア番号
+ * @param p_stack 使用状況
+ */
+void mem_hw_get_stack(uint32_t core, mem_hw_stack_t *p_stack)
+{
+    const uint32_t *p_lo = (core == 0) ? __StackBottom : __StackOneBottom;
+    const uint32_t *p_hi = (core == 0) ? __StackTop : __StackOneTop;
+
+    p_stack->size = (size_t)((const uint8_t *)p_hi - (const uint8_t *)p_lo);
+    p_stack->used = s_is_stack_painted ? mem_stack_used(p_lo, p_hi) : 0;
+    p_stack->is_painted = s_is_stack_painted;
+}
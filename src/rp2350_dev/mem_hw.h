@@ -0,0 +1,28 @@
+/**
+ * @file mem_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief プール/スタック計測のH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MEM_HW_H
+#define MEM_HW_H
+
+#include "mem_pool.h"
+#include "mem_stack.h"
+#include <stdbool.h>
+
+// スタックの使用状況
+typedef struct {
+    size_t size;            // スタックのバイト数
+    size_t used;            // 使用量の最大値
+    bool is_painted;        // 塗りつぶし済みか
+} mem_hw_stack_t;
+
+void mem_hw_init(void);
+void mem_hw_get_stack(uint32_t core, mem_hw_stack_t *p_stack);
+
+#endif // MEM_HW_H
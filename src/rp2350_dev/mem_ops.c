@@ -0,0 +1,277 @@
+/**
+ * @file mem_ops.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief メモリの検索/比較/フィル(32bitアラインのワード単位)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "mem_ops.h"
+#include "hot_path.h"
+#include <string.h>
+
+#define MEM_OPS_BYTES_01    0x01010101UL
+#define MEM_OPS_BYTES_80    0x80808080UL
+
+// アラインしていないかもしれない32bitの読み出し(Cortex-M33はLDR1回)
+static inline uint32_t load32(const uint8_t *p)
+{
+    uint32_t word;
+
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+// 4バイトアラインまでのバイト数
+static inline uint32_t align_head(const uint8_t *p, uint32_t len)
+{
+    uint32_t head = (uint32_t)(-(uintptr_t)p) & 3;
+
+    return (head < len) ? head : len;
+}
+
+// ワードのどこかのバイトが0か(SWAR)
+static inline bool word_has_zero(uint32_t word)
+{
+    return ((word - MEM_OPS_BYTES_01) & ~word & MEM_OPS_BYTES_80) != 0;
+}
+
+/**
+ * @brief 検索を準備する
+ *
+ * @param p_find 準備した内容
+ * @param p_pat パターン
+ * @param pat_len パターンのバイト数(1～MEM_FIND_PAT_MAX)
+ * @param is_aligned trueなら4バイトアラインのアドレスだけ探す
+ * @return true 準備した
+ * @return false パターンの長さが範囲外
+ */
+bool mem_find_init(mem_find_t *p_find, const uint8_t *p_pat, uint32_t pat_len, bool is_aligned)
+{
+    if (pat_len == 0 || pat_len > MEM_FIND_PAT_MAX) {
+        return false;
+    }
+
+    memset(p_find, 0, sizeof(mem_find_t));
+    memcpy(p_find->pat, p_pat, pat_len);
+    p_find->pat_len = pat_len;
+
+    if (is_aligned) {
+        uint32_t n = (pat_len < 4) ? pat_len : 4;
+        p_find->mode = MEM_FIND_WORD;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            p_find->first_word |= (uint32_t)p_pat[i] << (8 * i);
+            p_find->first_mask |= 0xFFUL << (8 * i);
+        }
+    } else if (pat_len == 1) {
+        p_find->mode = MEM_FIND_BYTE;
+    } else {
+        // 窓の最後のバイトで次にずらす量を決める(パターンに無いバイトなら丸ごと)
+        p_find->mode = MEM_FIND_BMH;
+        memset(p_find->skip, (int)pat_len, sizeof(p_find->skip));
+        for (uint32_t i = 0; i + 1 < pat_len; i++)
+        {
+            p_find->skip[p_pat[i]] = (uint8_t)(pat_len - 1 - i);
+        }
+    }
+
+    return true;
+}
+
+// 1バイトのパターン(アラインまでバイト、間はワードごとに0のバイトを探す)
+static uint32_t find_byte(uint8_t c, const uint8_t *p_buf, uint32_t len, uint32_t start)
+{
+    uint32_t i = start;
+    uint32_t end = i + align_head(&p_buf[i], len - i);
+    uint32_t bcast = c * MEM_OPS_BYTES_01;
+
+    for (; i < end; i++)
+    {
+        if (p_buf[i] == c) {
+            return i;
+        }
+    }
+    for (; i + 4 <= len; i += 4)
+    {
+        if (word_has_zero(*(const uint32_t *)&p_buf[i] ^ bcast)) {
+            break;
+        }
+    }
+    for (; i < len; i++)
+    {
+        if (p_buf[i] == c) {
+            return i;
+        }
+    }
+
+    return MEM_OPS_NONE;
+}
+
+// Boyer-Moore-Horspool
+static uint32_t find_bmh(const mem_find_t *p_find, const uint8_t *p_buf, uint32_t len, uint32_t start)
+{
+    uint32_t m = p_find->pat_len;
+    uint8_t last = p_find->pat[m - 1];
+
+    for (uint32_t i = start; i + m <= len; )
+    {
+        uint8_t c = p_buf[i + m - 1];
+        if (c == last && memcmp(&p_buf[i], p_find->pat, m - 1) == 0) {
+            return i;
+        }
+        i += p_find->skip[c];
+    }
+
+    return MEM_OPS_NONE;
+}
+
+// アラインしたアドレスだけ(先頭ワードを比べて4バイトずつ進む)
+static uint32_t find_word(const mem_find_t *p_find, const uint8_t *p_buf, uint32_t len, uint32_t start)
+{
+    uint32_t m = p_find->pat_len;
+    uint32_t i = start + align_head(&p_buf[start], len - start);
+
+    for (; i + 4 <= len && i + m <= len; i += 4)
+    {
+        if ((*(const uint32_t *)&p_buf[i] & p_find->first_mask) != p_find->first_word) {
+            continue;
+        }
+        if (m <= 4 || memcmp(&p_buf[i + 4], &p_find->pat[4], m - 4) == 0) {
+            return i;
+        }
+    }
+    // 末尾の4バイトに満たない所(パターンが4バイト未満のときだけ残る)
+    for (; i + m <= len; i += 4)
+    {
+        if (memcmp(&p_buf[i], p_find->pat, m) == 0) {
+            return i;
+        }
+    }
+
+    return MEM_OPS_NONE;
+}
+
+/**
+ * @brief p_bufのstartから次に一致する所を探す
+ *
+ * @param p_find mem_find_init()で準備した内容
+ * @param p_buf 探すメモリ
+ * @param len p_bufのバイト数
+ * @param start 探し始めるオフセット(前に見つけたオフセット+1で続きを探す)
+ * @return uint32_t 見つけたオフセット(無ければMEM_OPS_NONE)
+ */
+uint32_t HOT_FUNC(mem_find_next)(const mem_find_t *p_find, const uint8_t *p_buf, uint32_t len, uint32_t start)
+{
+    if (start >= len) {
+        return MEM_OPS_NONE;
+    }
+
+    switch (p_find->mode)
+    {
+        case MEM_FIND_BYTE:
+            return find_byte(p_find->pat[0], p_buf, len, start);
+        case MEM_FIND_WORD:
+            return find_word(p_find, p_buf, len, start);
+        default:
+            return find_bmh(p_find, p_buf, len, start);
+    }
+}
+HOT_PATH_REGISTER(mem_find_next);
+
+// バイトごとに比べて結果に足す(p_is_diffは直前のバイトが違ったか)
+static void cmp_bytes(const uint8_t *p_a, const uint8_t *p_b, uint32_t off, uint32_t n,
+                      mem_cmp_result_t *p_res, bool *p_is_diff)
+{
+    for (uint32_t i = off; i < off + n; i++)
+    {
+        if (p_a[i] == p_b[i]) {
+            *p_is_diff = false;
+            continue;
+        }
+        if (p_res->first == MEM_OPS_NONE) {
+            p_res->first = i;
+        }
+        p_res->count++;
+        if (!*p_is_diff) {
+            p_res->runs++;
+        }
+        *p_is_diff = true;
+    }
+}
+
+/**
+ * @brief 2つの領域を比べる
+ * @note p_aのアラインに合わせて16バイトずつワードで比べ、違ったブロックだけバイトで数える
+ *
+ * @param p_a 領域A(ワード読みはこちらに揃える)
+ * @param p_b 領域B(アラインは問わない)
+ * @param len バイト数
+ * @param p_res 結果
+ */
+void HOT_FUNC(mem_cmp)(const uint8_t *p_a, const uint8_t *p_b, uint32_t len, mem_cmp_result_t *p_res)
+{
+    uint32_t i = align_head(p_a, len);
+    bool is_diff = false;
+
+    p_res->first = MEM_OPS_NONE;
+    p_res->count = 0;
+    p_res->runs = 0;
+
+    cmp_bytes(p_a, p_b, 0, i, p_res, &is_diff);
+    for (; i + 16 <= len; i += 16)
+    {
+        const uint32_t *p_wa = (const uint32_t *)&p_a[i];
+        uint32_t diff = (p_wa[0] ^ load32(&p_b[i])) | (p_wa[1] ^ load32(&p_b[i + 4]))
+                      | (p_wa[2] ^ load32(&p_b[i + 8])) | (p_wa[3] ^ load32(&p_b[i + 12]));
+        if (diff == 0) {
+            is_diff = false;
+        } else {
+            cmp_bytes(p_a, p_b, i, 16, p_res, &is_diff);
+        }
+    }
+    cmp_bytes(p_a, p_b, i, len - i, p_res, &is_diff);
+}
+HOT_PATH_REGISTER(mem_cmp);
+
+/**
+ * @brief 32bitのパターンで埋める
+ * @note アラインしたワードがvalになるように、端数のバイトもアドレスに合わせた位置のバイトを書く
+ *
+ * @param p_dst 書き込み先
+ * @param len バイト数
+ * @param val パターン(ワードで読んだときの値)
+ */
+void HOT_FUNC(mem_fill32)(uint8_t *p_dst, uint32_t len, uint32_t val)
+{
+    uint32_t head = align_head(p_dst, len);
+    uint32_t i;
+
+    for (i = 0; i < head; i++)
+    {
+        p_dst[i] = (uint8_t)(val >> (8 * ((uintptr_t)&p_dst[i] & 3)));
+    }
+    for (; i + 32 <= len; i += 32)
+    {
+        uint32_t *p_w = (uint32_t *)&p_dst[i];
+        p_w[0] = val;
+        p_w[1] = val;
+        p_w[2] = val;
+        p_w[3] = val;
+        p_w[4] = val;
+        p_w[5] = val;
+        p_w[6] = val;
+        p_w[7] = val;
+    }
+    for (; i + 4 <= len; i += 4)
+    {
+        *(uint32_t *)&p_dst[i] = val;
+    }
+    for (; i < len; i++)
+    {
+        p_dst[i] = (uint8_t)(val >> (8 * ((uintptr_t)&p_dst[i] & 3)));
+    }
+}
+HOT_PATH_REGISTER(mem_fill32);
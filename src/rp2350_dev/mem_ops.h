@@ -0,0 +1,52 @@
+/**
+ * @file mem_ops.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief メモリの検索/比較/フィル(32bitアラインのワード単位)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MEM_OPS_H
+#define MEM_OPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストで確認できる)
+// ※先頭/末尾の端数はバイト、間は32bitアラインのワードで読み書きする(リトルエンディアン前提)
+
+#define MEM_FIND_PAT_MAX    32              // パターンの最大バイト数
+#define MEM_OPS_NONE        0xFFFFFFFFUL    // 見つからない/不一致なし
+
+// 検索の方法
+typedef enum {
+    MEM_FIND_BYTE = 0,      // 1バイトのパターン(ワードごとにSWARで探す)
+    MEM_FIND_BMH,           // Boyer-Moore-Horspool(任意のアドレス)
+    MEM_FIND_WORD,          // 4バイトアラインのアドレスだけ(先頭ワードを比べて進む)
+} mem_find_mode_t;
+
+// 検索の準備(パターンとスキップ表)
+typedef struct {
+    uint8_t pat[MEM_FIND_PAT_MAX];
+    uint32_t pat_len;
+    mem_find_mode_t mode;
+    uint32_t first_word;    // MEM_FIND_WORDの先頭ワード(pat_len < 4なら下位だけ)
+    uint32_t first_mask;
+    uint8_t skip[256];      // MEM_FIND_BMHのずらし量
+} mem_find_t;
+
+// 比較の結果
+typedef struct {
+    uint32_t first;         // 最初に違ったオフセット(MEM_OPS_NONEなら一致)
+    uint32_t count;         // 違ったバイト数
+    uint32_t runs;          // 違った区間の数(連続した不一致は1つ)
+} mem_cmp_result_t;
+
+bool mem_find_init(mem_find_t *p_find, const uint8_t *p_pat, uint32_t pat_len, bool is_aligned);
+uint32_t mem_find_next(const mem_find_t *p_find, const uint8_t *p_buf, uint32_t len, uint32_t start);
+void mem_cmp(const uint8_t *p_a, const uint8_t *p_b, uint32_t len, mem_cmp_result_t *p_res);
+void mem_fill32(uint8_t *p_dst, uint32_t len, uint32_t val);
+
+#endif // MEM_OPS_H
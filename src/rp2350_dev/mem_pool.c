@@ -0,0 +1,229 @@
+/**
+ * @file mem_pool.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コアごとの固定長ブロックプール
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "mem_pool.h"
+#include "hot_path.h"
+
+// コアごと・サイズごとのプール領域
+static uint64_t s_pool_mem_s[MEM_POOL_CORE_NUM][MEM_POOL_S_SIZE * MEM_POOL_S_NUM / 8];
+static uint64_t s_pool_mem_m[MEM_POOL_CORE_NUM][MEM_POOL_M_SIZE * MEM_POOL_M_NUM / 8];
+static uint64_t s_pool_mem_l[MEM_POOL_CORE_NUM][MEM_POOL_L_SIZE * MEM_POOL_L_NUM / 8];
+
+static mem_pool_t s_pool_sys[MEM_POOL_CORE_NUM][MEM_POOL_CLASS_NUM];
+static const mem_pool_ops_t *s_p_pool_ops = NULL;
+
+static uint32_t pool_irq_save(void)
+{
+    return (s_p_pool_ops != NULL) ? s_p_pool_ops->irq_save() : 0;
+}
+
+static void pool_irq_restore(uint32_t save)
+{
+    if (s_p_pool_ops != NULL) {
+        s_p_pool_ops->irq_restore(save);
+    }
+}
+
+static uint32_t pool_core_num(void)
+{
+    return (s_p_pool_ops != NULL) ? s_p_pool_ops->core_num() : 0;
+}
+
+/**
+ * @brief プールの初期化
+ *
+ * @param p_pool プール
+ * @param p_mem ブロックの領域(block_size * block_num バイト)
+ * @param block_size ブロックのバイト数(ポインタのサイズ以上、ポインタの倍数)
+ * @param block_num ブロック数
+ * @param owner_core 確保するコア
+ * @return true 成功
+ * @return false ブロックサイズが不正
+ */
+bool mem_pool_init(mem_pool_t *p_pool, void *p_mem, uint32_t block_size, uint32_t block_num,
+                   uint32_t owner_core)
+{
+    if (block_size < sizeof(mem_pool_block_t) || (block_size % sizeof(mem_pool_block_t)) != 0) {
+        return false;
+    }
+
+    p_pool->p_mem = (uint8_t *)p_mem;
+    p_pool->p_end = p_pool->p_mem + (size_t)block_size * block_num;
+    p_pool->block_size = block_size;
+    p_pool->block_num = block_num;
+    p_pool->owner_core = owner_core;
+    p_pool->p_remote = NULL;
+    p_pool->used = 0;
+    p_pool->peak = 0;
+    p_pool->fails = 0;
+    p_pool->remote_frees = 0;
+
+    // 先頭のブロックから順に確保されるよう後ろから積む
+    p_pool->p_free = NULL;
+    for (uint32_t i = block_num; i > 0; i--)
+    {
+        mem_pool_block_t *p_block = (mem_pool_block_t *)&p_pool->p_mem[(size_t)block_size * (i - 1)];
+        p_block->p_next = p_pool->p_free;
+        p_pool->p_free = p_block;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ブロックを1つ確保(所有コアから呼ぶ)
+ * @note 所有コアの割り込みだけ禁止する。コア間のロックは取らない。
+ *       空きリストが空なら他コアから解放されたブロックをまとめて引き取る
+ *
+ * @return void* ブロック(空きが無ければNULL)
+ */
+void *HOT_FUNC(mem_pool_get)(mem_pool_t *p_pool)
+{
+    uint32_t save = pool_irq_save();
+
+    if (p_pool->p_free == NULL && __atomic_load_n(&p_pool->p_remote, __ATOMIC_RELAXED) != NULL) {
+        mem_pool_block_t *p_list = __atomic_exchange_n(&p_pool->p_remote, NULL, __ATOMIC_ACQUIRE);
+        p_pool->p_free = p_list;
+        while (p_list != NULL)
+        {
+            p_pool->used--;
+            p_list = p_list->p_next;
+        }
+    }
+
+    mem_pool_block_t *p_block = p_pool->p_free;
+    if (p_block != NULL) {
+        p_pool->p_free = p_block->p_next;
+        p_pool->used++;
+        if (p_pool->used > p_pool->peak) {
+            p_pool->peak = p_pool->used;
+        }
+    } else {
+        p_pool->fails++;
+    }
+
+    pool_irq_restore(save);
+
+    return p_block;
+}
+HOT_PATH_REGISTER(mem_pool_get);
+
+/**
+ * @brief ブロックを解放(どのコアからでも可)
+ * @note 他コアからの解放はp_remoteにCASで積むだけ(積むだけなのでABA問題は起きない)
+ */
+void HOT_FUNC(mem_pool_put)(mem_pool_t *p_pool, void *p_block)
+{
+    mem_pool_block_t *p_free = (mem_pool_block_t *)p_block;
+
+    if (pool_core_num() == p_pool->owner_core) {
+        uint32_t save = pool_irq_save();
+        p_free->p_next = p_pool->p_free;
+        p_pool->p_free = p_free;
+        p_pool->used--;
+        pool_irq_restore(save);
+        return;
+    }
+
+    mem_pool_block_t *p_head = __atomic_load_n(&p_pool->p_remote, __ATOMIC_RELAXED);
+    do
+    {
+        p_free->p_next = p_head;
+    } while (!__atomic_compare_exchange_n(&p_pool->p_remote, &p_head, p_free, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    __atomic_fetch_add(&p_pool->remote_frees, 1, __ATOMIC_RELAXED);
+}
+HOT_PATH_REGISTER(mem_pool_put);
+
+/**
+ * @brief ブロックがこのプールのものか
+ */
+bool mem_pool_owns(const mem_pool_t *p_pool, const void *p_block)
+{
+    const uint8_t *p = (const uint8_t *)p_block;
+
+    return (p >= p_pool->p_mem && p < p_pool->p_end
+            && ((size_t)(p - p_pool->p_mem) % p_pool->block_size) == 0);
+}
+
+/**
+ * @brief コアごと・サイズごとのプールを初期化
+ */
+void mem_pool_sys_init(const mem_pool_ops_t *p_ops)
+{
+    s_p_pool_ops = p_ops;
+    for (uint32_t core = 0; core < MEM_POOL_CORE_NUM; core++)
+    {
+        mem_pool_init(&s_pool_sys[core][0], s_pool_mem_s[core], MEM_POOL_S_SIZE, MEM_POOL_S_NUM, core);
+        mem_pool_init(&s_pool_sys[core][1], s_pool_mem_m[core], MEM_POOL_M_SIZE, MEM_POOL_M_NUM, core);
+        mem_pool_init(&s_pool_sys[core][2], s_pool_mem_l[core], MEM_POOL_L_SIZE, MEM_POOL_L_NUM, core);
+    }
+}
+
+/**
+ * @brief 呼び出したコアのプールからsize以上のブロックを確保
+ * @note 合うサイズが空なら1つ大きいサイズから取る
+ *
+ * @return void* ブロック(確保できなければNULL)
+ */
+void *HOT_FUNC(mem_pool_alloc)(size_t size)
+{
+    uint32_t core = pool_core_num();
+
+    if (core >= MEM_POOL_CORE_NUM) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < MEM_POOL_CLASS_NUM; i++)
+    {
+        mem_pool_t *p_pool = &s_pool_sys[core][i];
+        if (size > p_pool->block_size) {
+            continue;
+        }
+        void *p = mem_pool_get(p_pool);
+        if (p != NULL) {
+            return p;
+        }
+    }
+
+    return NULL;
+}
+HOT_PATH_REGISTER(mem_pool_alloc);
+
+/**
+ * @brief mem_pool_alloc()で確保したブロックを解放(どのコアからでも可)
+ */
+void HOT_FUNC(mem_pool_free)(void *p_block)
+{
+    if (p_block == NULL) {
+        return;
+    }
+
+    for (uint32_t core = 0; core < MEM_POOL_CORE_NUM; core++)
+    {
+        for (uint32_t i = 0; i < MEM_POOL_CLASS_NUM; i++)
+        {
+            if (mem_pool_owns(&s_pool_sys[core][i], p_block)) {
+                mem_pool_put(&s_pool_sys[core][i], p_block);
+                return;
+            }
+        }
+    }
+}
+HOT_PATH_REGISTER(mem_pool_free);
+
+const mem_pool_t *mem_pool_sys_get(uint32_t core, uint32_t class_idx)
+{
+    if (core >= MEM_POOL_CORE_NUM || class_idx >= MEM_POOL_CLASS_NUM) {
+        return NULL;
+    }
+
+    return &s_pool_sys[core][class_idx];
+}
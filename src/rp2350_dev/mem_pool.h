@@ -0,0 +1,69 @@
+/**
+ * @file mem_pool.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コアごとの固定長ブロックプールのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(コア番号と割り込み禁止はmem_pool_ops_tで注入)
+
+#define MEM_POOL_CORE_NUM   2       // コア数(コアごとにプールを持つ)
+#define MEM_POOL_CLASS_NUM  3       // ブロックサイズの種類
+
+// ブロックサイズと数(1コアあたり)
+#define MEM_POOL_S_SIZE     32
+#define MEM_POOL_S_NUM      32
+#define MEM_POOL_M_SIZE     128
+#define MEM_POOL_M_NUM      16
+#define MEM_POOL_L_SIZE     512
+#define MEM_POOL_L_NUM      8
+
+// 空きブロックのリスト
+typedef struct mem_pool_block {
+    struct mem_pool_block *p_next;
+} mem_pool_block_t;
+
+// 1つのプール(確保は所有コアだけ、解放はどのコアからでも可)
+typedef struct {
+    uint8_t *p_mem;
+    uint8_t *p_end;
+    uint32_t block_size;
+    uint32_t block_num;
+    uint32_t owner_core;
+    mem_pool_block_t *p_free;       // 空きリスト(所有コアだけが触る)
+    mem_pool_block_t *p_remote;     // 他コアから解放されたブロック(ロックフリーで積む)
+    uint32_t used;                  // 確保中のブロック数(他コアからの解放待ちを含む)
+    uint32_t peak;                  // 確保中のブロック数の最大
+    uint32_t fails;                 // 空きが無くて確保できなかった回数
+    uint32_t remote_frees;          // 他コアから解放された回数
+} mem_pool_t;
+
+// コア番号と割り込み禁止(実機はget_core_num()とsave_and_disable_interrupts())
+typedef struct {
+    uint32_t (*core_num)(void);
+    uint32_t (*irq_save)(void);
+    void (*irq_restore)(uint32_t save);
+} mem_pool_ops_t;
+
+bool mem_pool_init(mem_pool_t *p_pool, void *p_mem, uint32_t block_size, uint32_t block_num,
+                   uint32_t owner_core);
+void *mem_pool_get(mem_pool_t *p_pool);
+void mem_pool_put(mem_pool_t *p_pool, void *p_block);
+bool mem_pool_owns(const mem_pool_t *p_pool, const void *p_block);
+
+void mem_pool_sys_init(const mem_pool_ops_t *p_ops);
+void *mem_pool_alloc(size_t size);
+void mem_pool_free(void *p_block);
+const mem_pool_t *mem_pool_sys_get(uint32_t core, uint32_t class_idx);
+
+#endif // MEM_POOL_H
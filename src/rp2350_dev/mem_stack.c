@@ -0,0 +1,45 @@
+/**
+ * @file mem_stack.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief スタックの塗りつぶしと使用量(最大値)の計測
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "mem_stack.h"
+
+/**
+ * @brief スタックの未使用部分をMEM_STACK_PAINTで埋める
+ * @note 使用中のスタックを含めないこと(現在のSPよりMEM_STACK_MARGIN以上下まで)
+ *
+ * @param p_lo 領域の下端(スタックの底、伸びていく先)
+ * @param p_hi 領域の上端(含まない)
+ */
+void mem_stack_paint(uint32_t *p_lo, uint32_t *p_hi)
+{
+    for (volatile uint32_t *p = p_lo; p < p_hi; p++)
+    {
+        *p = MEM_STACK_PAINT;
+    }
+}
+
+/**
+ * @brief スタックの使用量の最大値(下端から塗った値が残っている所までを未使用とみなす)
+ *
+ * @param p_lo スタックの下端
+ * @param p_hi スタックの上端(初期SP)
+ * @return size_t 使用したバイト数
+ */
+size_t mem_stack_used(const uint32_t *p_lo, const uint32_t *p_hi)
+{
+    const uint32_t *p = p_lo;
+
+    while (p < p_hi && *p == MEM_STACK_PAINT)
+    {
+        p++;
+    }
+
+    return (size_t)((const uint8_t *)p_hi - (const uint8_t *)p);
+}
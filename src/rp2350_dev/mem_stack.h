@@ -0,0 +1,25 @@
+/**
+ * @file mem_stack.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief スタックの塗りつぶしと使用量(最大値)の計測のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MEM_STACK_H
+#define MEM_STACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+#define MEM_STACK_PAINT     0xC5C5C5C5UL    // 未使用のスタックを埋める値
+#define MEM_STACK_MARGIN    64              // 塗りつぶし時に現在のSPから空けるバイト数
+
+void mem_stack_paint(uint32_t *p_lo, uint32_t *p_hi);
+size_t mem_stack_used(const uint32_t *p_lo, const uint32_t *p_hi);
+
+#endif // MEM_STACK_H
@@ -0,0 +1,143 @@
+/**
+ * @file membench.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief STREAM風メモリ帯域ベンチマーク
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "membench.h"
+#include "fast_mem.h"
+
+static const char *const s_kernel_name_tbl[MEMBENCH_KERNEL_NUM] = {
+    "copy", "scale", "add", "triad", "memcpy", "memset",
+};
+
+// 1要素あたりのR/W配列数(copy/scale/memcpy: 2, add/triad: 3, memset: 1)
+static const uint8_t s_kernel_arrays_tbl[MEMBENCH_KERNEL_NUM] = {
+    2, 2, 3, 3, 2, 1,
+};
+
+const char *membench_kernel_name(membench_kernel_t kernel)
+{
+    return s_kernel_name_tbl[kernel];
+}
+
+/**
+ * @brief カーネル1回の転送バイト数
+ */
+uint32_t membench_kernel_bytes(membench_kernel_t kernel, uint32_t n)
+{
+    return s_kernel_arrays_tbl[kernel] * n * (uint32_t)sizeof(float);
+}
+
+/**
+ * @brief 配列を初期値(a=1, b=2, c=0)で埋める
+ */
+void membench_stream_init(membench_stream_t *p_stream)
+{
+    for (uint32_t i = 0; i < p_stream->n; i++)
+    {
+        p_stream->p_a[i] = 1.0f;
+        p_stream->p_b[i] = 2.0f;
+        p_stream->p_c[i] = 0.0f;
+    }
+}
+
+/**
+ * @brief STREAMカーネルを1回実行
+ * @note copy/scale/add/triadは同じカーネルを繰り返しても結果は変わらない
+ */
+void membench_stream_run(membench_stream_t *p_stream, membench_kernel_t kernel)
+{
+    float *restrict p_a = p_stream->p_a;
+    float *restrict p_b = p_stream->p_b;
+    float *restrict p_c = p_stream->p_c;
+    uint32_t n = p_stream->n;
+
+    switch (kernel)
+    {
+        case MEMBENCH_COPY:
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_c[i] = p_a[i];
+            }
+            break;
+
+        case MEMBENCH_SCALE:
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_b[i] = MEMBENCH_SCALAR * p_c[i];
+            }
+            break;
+
+        case MEMBENCH_ADD:
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_c[i] = p_a[i] + p_b[i];
+            }
+            break;
+
+        case MEMBENCH_TRIAD:
+            for (uint32_t i = 0; i < n; i++)
+            {
+                p_a[i] = p_b[i] + MEMBENCH_SCALAR * p_c[i];
+            }
+            break;
+
+        case MEMBENCH_MEMCPY:
+            fast_memcpy(p_c, p_a, n * sizeof(float));
+            break;
+
+        case MEMBENCH_MEMSET:
+            fast_memset(p_c, 0, n * sizeof(float));
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 検証(STREAM本家と同様に期待値を漸化式で求めて比較)
+ *
+ * @param p_stream 配列
+ * @param rounds copy→scale→add→triad を実行した回数(memcpy/memsetは対象外)
+ * @return true 一致
+ * @return false 不一致
+ */
+bool membench_stream_check(const membench_stream_t *p_stream, uint32_t rounds)
+{
+    float a = 1.0f, b = 2.0f, c = 0.0f;
+
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        c = a;
+        b = MEMBENCH_SCALAR * c;
+        c = a + b;
+        a = b + MEMBENCH_SCALAR * c;
+    }
+
+    for (uint32_t i = 0; i < p_stream->n; i++)
+    {
+        if (p_stream->p_a[i] != a || p_stream->p_b[i] != b || p_stream->p_c[i] != c) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 転送バイト数と時間からMB/s(10^6 byte/s)を求める
+ */
+float membench_mbps(uint64_t bytes, uint32_t us)
+{
+    if (us == 0) {
+        return 0.0f;
+    }
+
+    return (float)bytes / (float)us;
+}
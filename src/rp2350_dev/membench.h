@@ -0,0 +1,48 @@
+/**
+ * @file membench.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief STREAM風メモリ帯域ベンチマークのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MEMBENCH_H
+#define MEMBENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+#define MEMBENCH_SCALAR     3.0f    // scale/triadの係数
+
+// STREAMカーネル
+typedef enum {
+    MEMBENCH_COPY,      // c[i] = a[i]
+    MEMBENCH_SCALE,     // b[i] = s * c[i]
+    MEMBENCH_ADD,       // c[i] = a[i] + b[i]
+    MEMBENCH_TRIAD,     // a[i] = b[i] + s * c[i]
+    MEMBENCH_MEMCPY,    // fast_memcpy(c, a)
+    MEMBENCH_MEMSET,    // fast_memset(c, 0)
+    MEMBENCH_KERNEL_NUM,
+} membench_kernel_t;
+
+// STREAMの配列
+typedef struct {
+    float *p_a;
+    float *p_b;
+    float *p_c;
+    uint32_t n;         // 要素数
+} membench_stream_t;
+
+const char *membench_kernel_name(membench_kernel_t kernel);
+uint32_t membench_kernel_bytes(membench_kernel_t kernel, uint32_t n);
+void membench_stream_init(membench_stream_t *p_stream);
+void membench_stream_run(membench_stream_t *p_stream, membench_kernel_t kernel);
+bool membench_stream_check(const membench_stream_t *p_stream, uint32_t rounds);
+float membench_mbps(uint64_t bytes, uint32_t us);
+
+#endif // MEMBENCH_H
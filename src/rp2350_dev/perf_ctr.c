@@ -0,0 +1,220 @@
+/**
+ * @file perf_ctr.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コマンドごとのH/Wカウンタ(DWT、XIPキャッシュ)集計
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "perf_ctr.h"
+#include <stdio.h>
+#include <string.h>
+
+static const perf_ops_t *s_p_perf_ops = NULL;
+static perf_total_t s_perf_total[PERF_TOTAL_MAX];
+static uint32_t s_perf_total_num = 0;
+
+void perf_init(const perf_ops_t *p_ops)
+{
+    s_p_perf_ops = p_ops;
+}
+
+bool perf_is_ready(void)
+{
+    return (s_p_perf_ops != NULL);
+}
+
+void perf_snapshot(perf_snap_t *p_snap)
+{
+    if (s_p_perf_ops == NULL) {
+        memset(p_snap, 0, sizeof(perf_snap_t));
+        return;
+    }
+    s_p_perf_ops->read(p_snap);
+}
+
+/**
+ * @brief 2回の読み出しの差分を計算
+ * @note CYCCNTは32bit(150MHzで約28.6秒)で折り返すので、経過時間から
+ *       見込んだサイクル数を超えない範囲で2^32の倍数を足す。
+ *       スリープ中はCYCCNTが止まるので、折り返し時間(約28.6秒)以上
+ *       スリープした区間では補正が過大になる(シェルのコマンドでは実用上問題ない)
+ *       読み出しのずれ分として見込みに10ms分の余裕を持たせる
+ *
+ * @param p_before 開始時の読み出し値
+ * @param p_after 終了時の読み出し値
+ * @param p_delta 差分
+ */
+void perf_delta(const perf_snap_t *p_before, const perf_snap_t *p_after, perf_delta_t *p_delta)
+{
+    uint32_t cyc32 = p_after->cyc - p_before->cyc;
+
+    p_delta->cpu_hz = (s_p_perf_ops != NULL) ? s_p_perf_ops->cpu_hz() : 0;
+    p_delta->us = p_after->us - p_before->us;
+
+    uint64_t expected = ((uint64_t)p_delta->us * p_delta->cpu_hz) / 1000000ULL + p_delta->cpu_hz / 100;
+    uint64_t wraps = (expected > cyc32) ? ((expected - cyc32) >> 32) : 0;
+    p_delta->cyc = cyc32 + (wraps << 32);
+
+    // 8bitカウンタはPERF_EVT_WRAPサイクル以上の区間では折り返すので使えない
+    p_delta->is_evt_valid = p_after->is_evt && (p_delta->cyc < PERF_EVT_WRAP);
+    p_delta->cpi = (uint8_t)(p_after->cpi - p_before->cpi);
+    p_delta->exc = (uint8_t)(p_after->exc - p_before->exc);
+    p_delta->sleep = (uint8_t)(p_after->sleep - p_before->sleep);
+    p_delta->lsu = (uint8_t)(p_after->lsu - p_before->lsu);
+    p_delta->fold = (uint8_t)(p_after->fold - p_before->fold);
+
+    p_delta->xip_acc = p_after->xip_acc - p_before->xip_acc;
+    uint32_t hit = p_after->xip_hit - p_before->xip_hit;
+    p_delta->xip_miss = (p_delta->xip_acc > hit) ? (p_delta->xip_acc - hit) : 0;
+}
+
+/**
+ * @brief CPUが動いていた割合(サイクル数 / (経過時間×クロック))
+ * @note 1より小さければスリープ(WFI/WFE)していた
+ *
+ * @return float 0.0～1.0
+ */
+float perf_active_rate(const perf_delta_t *p_delta)
+{
+    double full = (double)p_delta->us * (double)p_delta->cpu_hz / 1000000.0;
+
+    if (full <= 0.0) {
+        return 0.0f;
+    }
+    double rate = (double)p_delta->cyc / full;
+
+    return (float)((rate > 1.0) ? 1.0 : rate);
+}
+
+/**
+ * @brief 1000サイクルあたりのXIPキャッシュミス数(フラッシュ待ちの多さの目安)
+ */
+float perf_xip_miss_per_kcycle(uint64_t miss, uint64_t cyc)
+{
+    if (cyc == 0) {
+        return 0.0f;
+    }
+
+    return (float)((double)miss * 1000.0 / (double)cyc);
+}
+
+/**
+ * @brief 差分を複数行のテキストにする
+ *
+ * @return int32_t 書き込んだ文字数(snprintfと同じ)
+ */
+int32_t perf_format_delta(char *p_buf, size_t size, const perf_delta_t *p_delta)
+{
+    int32_t len;
+    size_t pos = 0;
+
+    len = snprintf(p_buf, size,
+                   "  wall time  : %lu us\n"
+                   "  cycles     : %llu (%.1f MHz, %.1f %% active)\n"
+                   "  XIP cache  : acc %lu, miss %lu (%.3f miss/kcycle)\n",
+                   (unsigned long)p_delta->us, (unsigned long long)p_delta->cyc,
+                   (double)p_delta->cpu_hz / 1000000.0, (double)perf_active_rate(p_delta) * 100.0,
+                   (unsigned long)p_delta->xip_acc, (unsigned long)p_delta->xip_miss,
+                   (double)perf_xip_miss_per_kcycle(p_delta->xip_miss, p_delta->cyc));
+    if (len < 0 || (size_t)len >= size) {
+        return len;
+    }
+    pos = (size_t)len;
+
+    if (p_delta->is_evt_valid) {
+        len = snprintf(&p_buf[pos], size - pos,
+                       "  DWT events : cpi %lu, exc %lu, sleep %lu, lsu %lu, fold %lu\n",
+                       (unsigned long)p_delta->cpi, (unsigned long)p_delta->exc,
+                       (unsigned long)p_delta->sleep, (unsigned long)p_delta->lsu,
+                       (unsigned long)p_delta->fold);
+    } else {
+        len = snprintf(&p_buf[pos], size - pos,
+                       "  DWT events : n/a (8-bit counters wrap after %u cycles)\n", PERF_EVT_WRAP);
+    }
+    if (len < 0) {
+        return len;
+    }
+
+    return (int32_t)(pos + (size_t)len);
+}
+
+/**
+ * @brief コマンドの累計に加算
+ * @note 表が埋まったら新しいコマンドは数えない
+ *
+ * @param key コマンド種類
+ * @param p_name コマンド名(表示用、文字列は呼び出し側で保持)
+ * @param p_delta 今回の差分
+ */
+void perf_total_add(uint32_t key, const char *p_name, const perf_delta_t *p_delta)
+{
+    perf_total_t *p_total = NULL;
+
+    for (uint32_t i = 0; i < s_perf_total_num; i++)
+    {
+        if (s_perf_total[i].key == key) {
+            p_total = &s_perf_total[i];
+            break;
+        }
+    }
+    if (p_total == NULL) {
+        if (s_perf_total_num >= PERF_TOTAL_MAX) {
+            return;
+        }
+        p_total = &s_perf_total[s_perf_total_num++];
+        memset(p_total, 0, sizeof(perf_total_t));
+        p_total->key = key;
+        p_total->p_name = p_name;
+    }
+
+    p_total->calls++;
+    p_total->cyc += p_delta->cyc;
+    p_total->us += p_delta->us;
+    p_total->xip_acc += p_delta->xip_acc;
+    p_total->xip_miss += p_delta->xip_miss;
+    if (p_delta->us > p_total->max_us) {
+        p_total->max_us = p_delta->us;
+    }
+}
+
+void perf_total_clear(void)
+{
+    s_perf_total_num = 0;
+}
+
+/**
+ * @brief 累計をサイクル数の多い順に取り出す
+ *
+ * @param pp_out 出力先(累計へのポインタ、max個)
+ * @param max 取り出す最大数
+ * @return uint32_t 取り出した数
+ */
+uint32_t perf_total_sorted(const perf_total_t **pp_out, uint32_t max)
+{
+    uint32_t num = 0;
+
+    for (uint32_t i = 0; i < s_perf_total_num; i++)
+    {
+        const perf_total_t *p_total = &s_perf_total[i];
+        uint32_t j;
+
+        if (num < max) {
+            j = num++;
+        } else if (max > 0 && p_total->cyc > pp_out[max - 1]->cyc) {
+            j = max - 1;
+        } else {
+            continue;
+        }
+        while (j > 0 && pp_out[j - 1]->cyc < p_total->cyc)
+        {
+            pp_out[j] = pp_out[j - 1];
+            j--;
+        }
+        pp_out[j] = p_total;
+    }
+
+    return num;
+}
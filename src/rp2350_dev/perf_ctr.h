@@ -0,0 +1,86 @@
+/**
+ * @file perf_ctr.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コマンドごとのH/Wカウンタ(DWT、XIPキャッシュ)集計のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PERF_CTR_H
+#define PERF_CTR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(カウンタ読み出しはperf_ops_tで注入、ホストはperf_ctr_stub.c)
+
+#define PERF_TOTAL_MAX      48      // 累計を持つコマンドの数
+#define PERF_EVT_WRAP       256     // DWTの8bitカウンタが折り返すサイクル数
+
+// カウンタの読み出し値
+typedef struct {
+    uint32_t cyc;           // DWT CYCCNT
+    uint8_t cpi;            // DWT CPICNT (8bit)
+    uint8_t exc;            // DWT EXCCNT (8bit)
+    uint8_t sleep;          // DWT SLEEPCNT (8bit)
+    uint8_t lsu;            // DWT LSUCNT (8bit)
+    uint8_t fold;           // DWT FOLDCNT (8bit)
+    bool is_evt;            // 8bitカウンタがあるか
+    uint32_t us;            // 時刻(μs)
+    uint32_t xip_acc;       // XIPキャッシュのアクセス数
+    uint32_t xip_hit;       // XIPキャッシュのヒット数
+} perf_snap_t;
+
+// 2回の読み出しの差分
+typedef struct {
+    uint64_t cyc;           // 折り返しを経過時間で補正したサイクル数
+    uint32_t us;
+    uint32_t cpi;
+    uint32_t exc;
+    uint32_t sleep;
+    uint32_t lsu;
+    uint32_t fold;
+    bool is_evt_valid;      // 8bitカウンタの差分が正しい(PERF_EVT_WRAPサイクル未満)
+    uint32_t xip_acc;
+    uint32_t xip_miss;
+    uint32_t cpu_hz;
+} perf_delta_t;
+
+// コマンドごとの累計
+typedef struct {
+    uint32_t key;           // コマンド種類
+    const char *p_name;
+    uint32_t calls;
+    uint64_t cyc;
+    uint64_t us;
+    uint32_t max_us;
+    uint64_t xip_acc;
+    uint64_t xip_miss;
+} perf_total_t;
+
+// カウンタの読み出し(実機はDWTとXIP_CTRL、ホストはperf_ctr_stub.c)
+typedef struct {
+    void (*read)(perf_snap_t *p_snap);
+    uint32_t (*cpu_hz)(void);
+} perf_ops_t;
+
+void perf_init(const perf_ops_t *p_ops);
+bool perf_is_ready(void);
+void perf_snapshot(perf_snap_t *p_snap);
+void perf_delta(const perf_snap_t *p_before, const perf_snap_t *p_after, perf_delta_t *p_delta);
+float perf_active_rate(const perf_delta_t *p_delta);
+float perf_xip_miss_per_kcycle(uint64_t miss, uint64_t cyc);
+int32_t perf_format_delta(char *p_buf, size_t size, const perf_delta_t *p_delta);
+void perf_total_add(uint32_t key, const char *p_name, const perf_delta_t *p_delta);
+void perf_total_clear(void);
+uint32_t perf_total_sorted(const perf_total_t **pp_out, uint32_t max);
+
+// ホスト用スタブ(perf_ctr_stub.c)
+extern const perf_ops_t g_perf_stub_ops;
+void perf_stub_reset(uint32_t cpu_hz);
+void perf_stub_advance(uint32_t us, uint32_t active_pct, uint32_t xip_acc, uint32_t xip_miss);
+
+#endif // PERF_CTR_H
@@ -0,0 +1,65 @@
+/**
+ * @file perf_ctr_stub.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コマンドごとのH/Wカウンタ集計のホスト用スタブ(カウンタを模擬)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "perf_ctr.h"
+
+// ※ホストPCでperf_ctr.cを試すためのもの(ファームウェアには組み込まない)
+
+static perf_snap_t s_stub_snap;
+static uint32_t s_stub_hz = 150000000;
+
+static void perf_stub_read(perf_snap_t *p_snap)
+{
+    *p_snap = s_stub_snap;
+}
+
+static uint32_t perf_stub_cpu_hz(void)
+{
+    return s_stub_hz;
+}
+
+const perf_ops_t g_perf_stub_ops = {
+    .read = perf_stub_read,
+    .cpu_hz = perf_stub_cpu_hz,
+};
+
+/**
+ * @brief カウンタを0に戻す
+ *
+ * @param cpu_hz 模擬するCPUクロック
+ */
+void perf_stub_reset(uint32_t cpu_hz)
+{
+    s_stub_snap = (perf_snap_t){0};
+    s_stub_snap.is_evt = true;
+    s_stub_hz = cpu_hz;
+}
+
+/**
+ * @brief 時間を進めてカウンタを更新(32bit/8bitの折り返しも実機と同じ)
+ *
+ * @param us 進める時間
+ * @param active_pct その間CPUが動いていた割合(残りはスリープ)
+ * @param xip_acc XIPキャッシュのアクセス数
+ * @param xip_miss XIPキャッシュのミス数
+ */
+void perf_stub_advance(uint32_t us, uint32_t active_pct, uint32_t xip_acc, uint32_t xip_miss)
+{
+    uint64_t cyc = ((uint64_t)us * s_stub_hz / 1000000ULL) * active_pct / 100;
+    uint64_t sleep = ((uint64_t)us * s_stub_hz / 1000000ULL) - cyc;
+
+    s_stub_snap.us += us;
+    s_stub_snap.cyc += (uint32_t)cyc;
+    s_stub_snap.sleep += (uint8_t)sleep;
+    s_stub_snap.cpi += (uint8_t)(cyc / 8);
+    s_stub_snap.lsu += (uint8_t)(cyc / 4);
+    s_stub_snap.xip_acc += xip_acc;
+    s_stub_snap.xip_hit += xip_acc - xip_miss;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file pi_chud.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief Chudnovsky法(Binary Splitting)による円周率計算
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pi_chud.h"
+#include <stdlib.h>
+#include <string.h>
+
+// pi = 426880 * sqrt(10005) * Q(0,N) / T(0,N)
+#define CHUD_A          13591409ULL
+#define CHUD_B          545140134ULL
+#define CHUD_C3_OVER_24 10939058860032000ULL    // 640320^3 / 24
+#define CHUD_DIGITS_PER_TERM_X100 1418          // 1項あたり約14.18桁
+
+// 既知の円周率(小数点以下100桁)
+static const char s_pi_head[] =
+    "1415926535897932384626433832795028841971693993751058209749445923"
+    "078164062862089986280348253421170679";
+
+// 小数点以下1000桁ごとの直前10桁(例: [0]は991～1000桁目)
+static const char *const s_pi_checkpoint_tbl[] = {
+    "2164201989", "7802759009", "6494231961", "2111660396", "4132604721",
+    "5068772460", "8764962867", "8425039127", "2380929345", "5256375678",
+    "3642785271", "7421637140", "5342698699", "7629472823", "9842799275",
+    "5154334260", "0124767945", "9112099164", "0690287232", "0490755178",
+};
+
+/**
+ * @brief 指定桁数に必要な級数の項数
+ */
+uint32_t pi_chud_terms(uint32_t digits)
+{
+    return (digits * 100) / CHUD_DIGITS_PER_TERM_X100 + 2;
+}
+
+/**
+ * @brief 2コアで分割する項の境界
+ * @note 後半の項ほど数値が大きく重いので中央より少し後ろで分ける
+ */
+uint32_t pi_chud_split_point(uint32_t terms)
+{
+    return (terms * 53) / 100;
+}
+
+void pi_chud_pqt_init(pi_chud_pqt_t *p_pqt)
+{
+    bn_init(&p_pqt->p);
+    bn_init(&p_pqt->q);
+    bn_init(&p_pqt->t);
+}
+
+void pi_chud_pqt_free(pi_chud_pqt_t *p_pqt)
+{
+    bn_free(&p_pqt->p);
+    bn_free(&p_pqt->q);
+    bn_free(&p_pqt->t);
+}
+
+/**
+ * @brief 隣接する区間の結果を結合 left = [a,m) + right = [m,b)
+ * @note P = P1*P2, Q = Q1*Q2, T = T1*Q2 + P1*T2 (rightは解放される)
+ *
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool pi_chud_merge(pi_chud_pqt_t *p_left, pi_chud_pqt_t *p_right)
+{
+    bool is_ok = bn_mul(&p_left->t, &p_left->t, &p_right->q)
+              && bn_mul(&p_right->t, &p_left->p, &p_right->t)
+              && bn_add(&p_left->t, &p_left->t, &p_right->t)
+              && bn_mul(&p_left->p, &p_left->p, &p_right->p)
+              && bn_mul(&p_left->q, &p_left->q, &p_right->q);
+
+    pi_chud_pqt_free(p_right);
+
+    return is_ok;
+}
+
+/**
+ * @brief Binary Splittingで区間[a,b)の P, Q, T を計算
+ *
+ * @param a 区間の開始項
+ * @param b 区間の終了項(含まない)
+ * @param p_pqt 結果(pi_chud_pqt_init()済みであること)
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool pi_chud_bs(uint32_t a, uint32_t b, pi_chud_pqt_t *p_pqt)
+{
+    if (b - a == 1) {
+        bignum_t tmp;
+        bool is_ok;
+
+        if (a == 0) {
+            is_ok = bn_set_u64(&p_pqt->p, 1) && bn_set_u64(&p_pqt->q, 1);
+        } else {
+            // P = (6a-5)(2a-1)(6a-1), Q = a^3 * C^3/24
+            uint64_t a64 = a;
+            is_ok = bn_set_u64(&p_pqt->p, (6 * a64 - 5) * (2 * a64 - 1))
+                 && bn_mul_u32(&p_pqt->p, &p_pqt->p, (uint32_t)(6 * a64 - 1))
+                 && bn_set_u64(&p_pqt->q, CHUD_C3_OVER_24)
+                 && bn_mul_u32(&p_pqt->q, &p_pqt->q, a)
+                 && bn_mul_u32(&p_pqt->q, &p_pqt->q, a)
+                 && bn_mul_u32(&p_pqt->q, &p_pqt->q, a);
+        }
+
+        // T = (-1)^a * P * (A + B*a)
+        bn_init(&tmp);
+        is_ok = is_ok && bn_set_u64(&tmp, CHUD_A + CHUD_B * a)
+                      && bn_mul(&p_pqt->t, &p_pqt->p, &tmp);
+        bn_free(&tmp);
+        if ((a & 1) != 0 && p_pqt->t.len > 0) {
+            p_pqt->t.sign = -1;
+        }
+
+        return is_ok;
+    }
+
+    pi_chud_pqt_t right;
+    uint32_t m = (a + b) / 2;
+
+    pi_chud_pqt_init(&right);
+    if (!pi_chud_bs(a, m, p_pqt) || !pi_chud_bs(m, b, &right)) {
+        pi_chud_pqt_free(&right);
+        return false;
+    }
+
+    return pi_chud_merge(p_pqt, &right);
+}
+
+/**
+ * @brief P,Q,T(0,N)から円周率を10進文字列で求める
+ *
+ * @param p_pqt 区間[0,N)の結果
+ * @param digits 小数点以下の桁数
+ * @param p_out 出力先("3."+digits桁+終端で digits+3 バイト以上)
+ * @return true 成功
+ * @return false メモリ不足
+ */
+bool pi_chud_finish(const pi_chud_pqt_t *p_pqt, uint32_t digits, char *p_out)
+{
+    // 小数部は 2^(32*frac_limbs) 倍の固定小数点で扱う(ガード2リム)
+    uint32_t frac_limbs = (uint32_t)(((uint64_t)digits * 3322) / (1000 * 32)) + 2;
+    bignum_t s, x;
+    bool is_ok;
+
+    bn_init(&s);
+    bn_init(&x);
+
+    // s = sqrt(10005) * 2^(32*frac_limbs), x = 426880 * s * Q / T
+    is_ok = bn_set_u64(&s, 10005)
+         && bn_shl(&s, &s, 64 * frac_limbs)
+         && bn_isqrt(&s, &s)
+         && bn_mul_u32(&x, &s, 426880)
+         && bn_mul(&x, &x, &p_pqt->q)
+         && bn_div(&x, &x, &p_pqt->t);
+
+    if (is_ok) {
+        // 整数部は3、小数部は10^9倍ずつ取り出す
+        uint32_t int_part = (x.len > frac_limbs) ? x.p_limb[frac_limbs] : 0;
+        uint32_t pos = 0;
+
+        p_out[pos++] = (char)('0' + int_part);
+        p_out[pos++] = '.';
+        x.len = (x.len < frac_limbs) ? x.len : frac_limbs;
+        while (pos < digits + 2)
+        {
+            uint64_t c = 0;
+            for (uint32_t i = 0; i < x.len; i++)
+            {
+                c += (uint64_t)x.p_limb[i] * 1000000000UL;
+                x.p_limb[i] = (uint32_t)c;
+                c >>= 32;
+            }
+            // cが次の9桁
+            char chunk[9];
+            for (int32_t i = 8; i >= 0; i--)
+            {
+                chunk[i] = (char)('0' + (c % 10));
+                c /= 10;
+            }
+            for (uint32_t i = 0; i < 9 && pos < digits + 2; i++)
+            {
+                p_out[pos++] = chunk[i];
+            }
+        }
+        p_out[pos] = '\0';
+    }
+
+    bn_free(&s);
+    bn_free(&x);
+
+    return is_ok;
+}
+
+/**
+ * @brief 計算結果を既知の値で検証
+ *
+ * @param p_digits pi_chud_finish()の出力
+ * @param digits 小数点以下の桁数
+ * @return uint32_t 検証できた桁位置(不一致なら0)
+ */
+uint32_t pi_chud_verify(const char *p_digits, uint32_t digits)
+{
+    uint32_t head_len = (uint32_t)strlen(s_pi_head);
+    uint32_t verified;
+
+    if (strncmp(p_digits, "3.", 2) != 0) {
+        return 0;
+    }
+
+    verified = (digits < head_len) ? digits : head_len;
+    if (strncmp(&p_digits[2], s_pi_head, verified) != 0) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < sizeof(s_pi_checkpoint_tbl) / sizeof(s_pi_checkpoint_tbl[0]); i++)
+    {
+        uint32_t end = (i + 1) * 1000;
+        if (end > digits) {
+            break;
+        }
+        // 小数点以下end桁目はp_digits[end + 1]
+        if (strncmp(&p_digits[end + 1 - 9], s_pi_checkpoint_tbl[i], 10) != 0) {
+            return 0;
+        }
+        verified = end;
+    }
+
+    return verified;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file pi_chud.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief Chudnovsky法(Binary Splitting)による円周率計算のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PI_CHUD_H
+#define PI_CHUD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bignum.h"
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+#define PI_CHUD_MAX_DIGITS      20000   // 計算可能な最大桁数(小数点以下)
+#define PI_CHUD_VERIFY_DIGITS   20000   // 既知の値で検証できる桁数
+
+// Binary Splittingの部分結果 P(a,b), Q(a,b), T(a,b)
+typedef struct {
+    bignum_t p;
+    bignum_t q;
+    bignum_t t;
+} pi_chud_pqt_t;
+
+uint32_t pi_chud_terms(uint32_t digits);
+uint32_t pi_chud_split_point(uint32_t terms);
+void pi_chud_pqt_init(pi_chud_pqt_t *p_pqt);
+void pi_chud_pqt_free(pi_chud_pqt_t *p_pqt);
+bool pi_chud_bs(uint32_t a, uint32_t b, pi_chud_pqt_t *p_pqt);
+bool pi_chud_merge(pi_chud_pqt_t *p_left, pi_chud_pqt_t *p_right);
+bool pi_chud_finish(const pi_chud_pqt_t *p_pqt, uint32_t digits, char *p_out);
+uint32_t pi_chud_verify(const char *p_digits, uint32_t digits);
+
+#endif // PI_CHUD_H
@@ -0,0 +1,131 @@
+/**
+ * @file pio_insn.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief PIO命令のエンコード(プログラムをCで組み立てる)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PIO_INSN_H
+#define PIO_INSN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このヘッダはPico SDKに依存しない(ホストでpioasmの出力と比べて確認できる)
+// ※ディレイは5bit、side-setを使うときはpio_insn_side()で上位ビットに入れる(その分ディレイが減る)
+// ※JMPのアドレスはプログラム先頭からの相対(pio_add_program()がロード先に合わせて書き換える)
+
+// JMPの条件
+typedef enum {
+    PIO_INSN_JMP_ALWAYS = 0,
+    PIO_INSN_JMP_NOT_X,     // !x
+    PIO_INSN_JMP_X_DEC,     // x--
+    PIO_INSN_JMP_NOT_Y,     // !y
+    PIO_INSN_JMP_Y_DEC,     // y--
+    PIO_INSN_JMP_X_NE_Y,    // x!=y
+    PIO_INSN_JMP_PIN,       // pin
+    PIO_INSN_JMP_NOT_OSRE,  // !osre
+} pio_insn_jmp_cond_t;
+
+// MOV/SET/IN/OUTのソースと宛先(命令によって使えるものが違う)
+typedef enum {
+    PIO_INSN_PINS = 0,
+    PIO_INSN_X = 1,
+    PIO_INSN_Y = 2,
+    PIO_INSN_NULL = 3,
+    PIO_INSN_PINDIRS = 4,
+    PIO_INSN_STATUS = 5,    // MOVのソース
+    PIO_INSN_PC = 5,        // MOV/OUTの宛先
+    PIO_INSN_ISR = 6,
+    PIO_INSN_OSR = 7,
+} pio_insn_reg_t;
+
+#define PIO_INSN_DELAY_MAX  31
+
+static inline uint16_t pio_insn_delay(uint16_t insn, uint32_t delay)
+{
+    return (uint16_t)(insn | ((delay & PIO_INSN_DELAY_MAX) << 8));
+}
+
+// side-setの値(bitsはsm_config_set_sideset()のビット数、optなら有効ビットを含む)
+static inline uint16_t pio_insn_side(uint16_t insn, uint32_t bits, uint32_t value)
+{
+    return (uint16_t)(insn | ((value & ((1U << bits) - 1)) << (13 - bits)));
+}
+
+static inline uint16_t pio_insn_jmp(pio_insn_jmp_cond_t cond, uint32_t addr)
+{
+    return (uint16_t)(0x0000 | ((uint32_t)cond << 5) | (addr & 0x1F));
+}
+
+static inline uint16_t pio_insn_wait_gpio(bool polarity, uint32_t gpio)
+{
+    return (uint16_t)(0x2000 | ((polarity ? 1U : 0U) << 7) | (0U << 5) | (gpio & 0x1F));
+}
+
+static inline uint16_t pio_insn_wait_pin(bool polarity, uint32_t pin)
+{
+    return (uint16_t)(0x2000 | ((polarity ? 1U : 0U) << 7) | (1U << 5) | (pin & 0x1F));
+}
+
+static inline uint16_t pio_insn_in(pio_insn_reg_t src, uint32_t bits)
+{
+    return (uint16_t)(0x4000 | ((uint32_t)src << 5) | (bits & 0x1F));
+}
+
+static inline uint16_t pio_insn_out(pio_insn_reg_t dst, uint32_t bits)
+{
+    return (uint16_t)(0x6000 | ((uint32_t)dst << 5) | (bits & 0x1F));
+}
+
+static inline uint16_t pio_insn_push(bool is_if_full, bool is_block)
+{
+    return (uint16_t)(0x8000 | ((is_if_full ? 1U : 0U) << 6) | ((is_block ? 1U : 0U) << 5));
+}
+
+static inline uint16_t pio_insn_pull(bool is_if_empty, bool is_block)
+{
+    return (uint16_t)(0x8080 | ((is_if_empty ? 1U : 0U) << 6) | ((is_block ? 1U : 0U) << 5));
+}
+
+static inline uint16_t pio_insn_mov(pio_insn_reg_t dst, pio_insn_reg_t src)
+{
+    return (uint16_t)(0xA000 | ((uint32_t)dst << 5) | (uint32_t)src);
+}
+
+// nop(mov y, y)
+static inline uint16_t pio_insn_nop(void)
+{
+    return pio_insn_mov(PIO_INSN_Y, PIO_INSN_Y);
+}
+
+// mov dst, ~src
+static inline uint16_t pio_insn_mov_not(pio_insn_reg_t dst, pio_insn_reg_t src)
+{
+    return (uint16_t)(pio_insn_mov(dst, src) | (1U << 3));
+}
+
+static inline uint16_t pio_insn_irq_set(uint32_t idx)
+{
+    return (uint16_t)(0xC000 | (idx & 0x07));
+}
+
+static inline uint16_t pio_insn_irq_wait(uint32_t idx)
+{
+    return (uint16_t)(0xC020 | (idx & 0x07));
+}
+
+static inline uint16_t pio_insn_irq_clear(uint32_t idx)
+{
+    return (uint16_t)(0xC040 | (idx & 0x07));
+}
+
+static inline uint16_t pio_insn_set(pio_insn_reg_t dst, uint32_t value)
+{
+    return (uint16_t)(0xE000 | ((uint32_t)dst << 5) | (value & 0x1F));
+}
+
+#endif // PIO_INSN_H
@@ -0,0 +1,190 @@
+/**
+ * @file prof.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief サンプリングプロファイラ(PCヒストグラム)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "prof.h"
+#include "hot_path.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// PC,LRをキーにしたオープンアドレス法のハッシュ表(count==0が空き)
+static prof_entry_t s_prof_hist[PROF_HIST_SIZE];
+static prof_stats_t s_prof_stats;
+
+static inline uint32_t prof_hash(uint32_t pc, uint32_t lr)
+{
+    // Thumb命令は2バイト境界なのでbit0は使わない
+    uint32_t h = (pc >> 1) ^ ((lr >> 1) * 0x9E3779B1UL);
+    return (h ^ (h >> 13)) & (PROF_HIST_SIZE - 1);
+}
+
+/**
+ * @brief ヒストグラムと統計をクリア
+ */
+void prof_clear(void)
+{
+    memset(s_prof_hist, 0, sizeof(s_prof_hist));
+    memset(&s_prof_stats, 0, sizeof(s_prof_stats));
+}
+
+/**
+ * @brief PC,LRの組にサンプル数を加算
+ * @note 空きが見つからなければdroppedに数える
+ *
+ * @param pc プログラムカウンタ
+ * @param lr リンクレジスタ(記録しないときは0)
+ * @param count 加算するサンプル数
+ */
+void HOT_FUNC(prof_add)(uint32_t pc, uint32_t lr, uint32_t count)
+{
+    uint32_t idx = prof_hash(pc, lr);
+
+    s_prof_stats.samples += count;
+    for (uint32_t i = 0; i < PROF_PROBE_MAX; i++)
+    {
+        prof_entry_t *p_entry = &s_prof_hist[idx];
+
+        if (p_entry->count == 0) {
+            p_entry->pc = pc;
+            p_entry->lr = lr;
+            p_entry->count = count;
+            s_prof_stats.used++;
+            return;
+        }
+        if (p_entry->pc == pc && p_entry->lr == lr) {
+            p_entry->count += count;
+            return;
+        }
+        idx = (idx + 1) & (PROF_HIST_SIZE - 1);
+    }
+
+    s_prof_stats.dropped += count;
+}
+HOT_PATH_REGISTER(prof_add);
+
+/**
+ * @brief サンプルを1つ記録(タイマー割り込みから呼ばれる)
+ */
+void HOT_FUNC(prof_record)(uint32_t pc, uint32_t lr)
+{
+    prof_add(pc, lr, 1);
+}
+HOT_PATH_REGISTER(prof_record);
+
+void prof_get_stats(prof_stats_t *p_stats)
+{
+    *p_stats = s_prof_stats;
+}
+
+/**
+ * @brief 使用中のエントリを順に取り出す
+ *
+ * @param p_pos 探索位置(最初は0を入れて呼ぶ)
+ * @param p_entry 取り出したエントリ
+ * @return true 取り出した
+ * @return false もう無い
+ */
+bool prof_next_entry(uint32_t *p_pos, prof_entry_t *p_entry)
+{
+    while (*p_pos < PROF_HIST_SIZE)
+    {
+        const prof_entry_t *p_hist = &s_prof_hist[(*p_pos)++];
+        if (p_hist->count != 0) {
+            *p_entry = *p_hist;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief サンプル数の多い順に上位num個を取り出す
+ *
+ * @param p_out 出力先(num個)
+ * @param num 取り出す数
+ * @return uint32_t 取り出した数
+ */
+uint32_t prof_top(prof_entry_t *p_out, uint32_t num)
+{
+    uint32_t out_num = 0;
+    uint32_t pos = 0;
+    prof_entry_t entry;
+
+    // 挿入ソートで上位だけ保持
+    while (prof_next_entry(&pos, &entry))
+    {
+        uint32_t i;
+
+        if (out_num < num) {
+            i = out_num++;
+        } else if (num > 0 && entry.count > p_out[num - 1].count) {
+            i = num - 1;
+        } else {
+            continue;
+        }
+        while (i > 0 && p_out[i - 1].count < entry.count)
+        {
+            p_out[i] = p_out[i - 1];
+            i--;
+        }
+        p_out[i] = entry;
+    }
+
+    return out_num;
+}
+
+/**
+ * @brief エントリをダンプ形式の1行にする("0x<pc> 0x<lr> <count>")
+ *
+ * @return int32_t 書き込んだ文字数(snprintfと同じ)
+ */
+int32_t prof_format_entry(char *p_buf, size_t size, const prof_entry_t *p_entry)
+{
+    return snprintf(p_buf, size, "0x%08lX 0x%08lX %lu",
+                    (unsigned long)p_entry->pc, (unsigned long)p_entry->lr,
+                    (unsigned long)p_entry->count);
+}
+
+/**
+ * @brief ダンプ形式の1行を読む(prof_format_entry()の逆)
+ * @note 記録したログを集計し直すときに使う。コメント行(#)や空行はfalse
+ *
+ * @return true 読めた
+ * @return false エントリの行ではない
+ */
+bool prof_parse_entry(const char *p_line, prof_entry_t *p_entry)
+{
+    char *p_end;
+    unsigned long val[3];
+
+    while (*p_line == ' ' || *p_line == '\t')
+    {
+        p_line++;
+    }
+    if (*p_line == '#' || *p_line == '\0') {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        val[i] = strtoul(p_line, &p_end, 0);
+        if (p_end == p_line) {
+            return false;
+        }
+        p_line = p_end;
+    }
+
+    p_entry->pc = (uint32_t)val[0];
+    p_entry->lr = (uint32_t)val[1];
+    p_entry->count = (uint32_t)val[2];
+
+    return (p_entry->count != 0);
+}
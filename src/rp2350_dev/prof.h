@@ -0,0 +1,48 @@
+/**
+ * @file prof.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief サンプリングプロファイラ(PCヒストグラム)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストPCでもビルド可能)
+
+#define PROF_HIST_SIZE      1024    // ヒストグラムのエントリ数(2のべき乗)
+#define PROF_PROBE_MAX      16      // 衝突時に探すエントリ数
+#define PROF_DUMP_BEGIN     "# prof begin"
+#define PROF_DUMP_END       "# prof end"
+
+// ヒストグラムの1エントリ(PC,LRの組ごとのサンプル数)
+typedef struct {
+    uint32_t pc;
+    uint32_t lr;        // LRを記録しないときは0
+    uint32_t count;
+} prof_entry_t;
+
+// 統計情報
+typedef struct {
+    uint32_t samples;   // 記録したサンプル数
+    uint32_t dropped;   // ヒストグラムが埋まって捨てたサンプル数
+    uint32_t used;      // 使用中のエントリ数
+} prof_stats_t;
+
+void prof_clear(void);
+void prof_record(uint32_t pc, uint32_t lr);
+void prof_add(uint32_t pc, uint32_t lr, uint32_t count);
+void prof_get_stats(prof_stats_t *p_stats);
+bool prof_next_entry(uint32_t *p_pos, prof_entry_t *p_entry);
+uint32_t prof_top(prof_entry_t *p_out, uint32_t num);
+int32_t prof_format_entry(char *p_buf, size_t size, const prof_entry_t *p_entry);
+bool prof_parse_entry(const char *p_line, prof_entry_t *p_entry);
+
+#endif // PROF_H
@@ -0,0 +1,152 @@
+/**
+ * @file prof_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief サンプリングプロファイラのH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "prof_hw.h"
+#include "mcu_util.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/ticks.h"
+#include "hardware/clocks.h"
+#include "hot_path.h"
+
+static int32_t s_prof_alarm = -1;
+static uint32_t s_prof_irq;
+static prof_hw_config_t s_prof_config = {1, PROF_HW_PERIOD_US_DEF, false};
+static volatile bool s_is_prof_running = false;
+static uint32_t s_prof_next;
+
+/**
+ * @brief タイマー割り込み(Cの部分)
+ *
+ * @param p_frame 割り込まれた側のスタックフレーム(r0,r1,r2,r3,r12,lr,pc,xpsr)
+ */
+static void __attribute__((used)) HOT_FUNC(prof_hw_irq_handler)(const uint32_t *p_frame)
+{
+    // 対象外のコアでNVICが有効のまま残っていたら自分で止める
+    if (get_core_num() != s_prof_config.core) {
+        irq_set_enabled(s_prof_irq, false);
+        return;
+    }
+
+    PROF_HW_TIMER->intr = 1UL << s_prof_alarm;
+
+    // 周期がずれないよう前回の予定時刻から次を決める(遅れていたら今から)
+    s_prof_next += s_prof_config.period_us;
+    if ((int32_t)(s_prof_next - PROF_HW_TIMER->timerawl) <= 0) {
+        s_prof_next = PROF_HW_TIMER->timerawl + s_prof_config.period_us;
+    }
+    PROF_HW_TIMER->alarm[s_prof_alarm] = s_prof_next;
+
+    prof_record(p_frame[6], s_prof_config.is_lr ? p_frame[5] : 0);
+}
+HOT_PATH_REGISTER(prof_hw_irq_handler);
+
+/**
+ * @brief タイマー割り込みの入口
+ * @note EXC_RETURN(LR)のbit2で割り込まれた側のスタック(MSP/PSP)を選んで
+ *       フレームの先頭をr0に入れて渡す(Cの関数だとプロローグでSPがずれるためnaked)
+ */
+static void __attribute__((naked)) HOT_FUNC(prof_hw_irq_entry)(void)
+{
+    __asm volatile (
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "b prof_hw_irq_handler\n"
+    );
+}
+
+/**
+ * @brief TIMER1のアラームを1つ確保して割り込みハンドラを登録
+ *
+ * @return true 成功(確保済みも含む)
+ * @return false 空きアラームが無い
+ */
+bool prof_hw_init(void)
+{
+    if (s_prof_alarm >= 0) {
+        return true;
+    }
+
+    s_prof_alarm = timer_hardware_alarm_claim_unused(PROF_HW_TIMER, false);
+    if (s_prof_alarm < 0) {
+        return false;
+    }
+
+    // TIMER1のtickが止まっていたら1μs(clk_refから)で動かす
+    if (!tick_is_running(TICK_TIMER1)) {
+        tick_start(TICK_TIMER1, clock_get_hz(clk_ref) / 1000000);
+    }
+
+    s_prof_irq = timer_hardware_alarm_get_irq_num(PROF_HW_TIMER, s_prof_alarm);
+    irq_set_exclusive_handler(s_prof_irq, prof_hw_irq_entry);
+    // 他の割り込みハンドラの中もサンプルできるよう最高優先度
+    irq_set_priority(s_prof_irq, PICO_HIGHEST_IRQ_PRIORITY);
+
+    return true;
+}
+
+/**
+ * @brief サンプリング開始(タイマーを動かす)
+ * @note 割り込みは対象コアでprof_hw_irq_enable(true)を呼んだ時点から入る
+ *
+ * @param p_config 設定
+ */
+void prof_hw_start(const prof_hw_config_t *p_config)
+{
+    prof_hw_stop();
+
+    s_prof_config = *p_config;
+    if (s_prof_config.period_us < PROF_HW_PERIOD_US_MIN) {
+        s_prof_config.period_us = PROF_HW_PERIOD_US_MIN;
+    }
+
+    s_prof_next = PROF_HW_TIMER->timerawl + s_prof_config.period_us;
+    PROF_HW_TIMER->alarm[s_prof_alarm] = s_prof_next;
+    hw_set_bits(&PROF_HW_TIMER->inte, 1UL << s_prof_alarm);
+    s_is_prof_running = true;
+}
+
+/**
+ * @brief サンプリング停止(どのコアからでも可)
+ * @note 対象コアのNVICはprof_hw_irq_enable(false)で別途無効にする
+ */
+void prof_hw_stop(void)
+{
+    if (s_prof_alarm < 0) {
+        return;
+    }
+
+    hw_clear_bits(&PROF_HW_TIMER->inte, 1UL << s_prof_alarm);
+    PROF_HW_TIMER->armed = 1UL << s_prof_alarm;
+    PROF_HW_TIMER->intr = 1UL << s_prof_alarm;
+    s_is_prof_running = false;
+}
+
+/**
+ * @brief 呼び出したコアのNVICで割り込みを有効/無効にする
+ */
+void prof_hw_irq_enable(bool is_enable)
+{
+    if (s_prof_alarm >= 0) {
+        irq_set_enabled(s_prof_irq, is_enable);
+    }
+}
+
+bool prof_hw_is_running(void)
+{
+    return s_is_prof_running;
+}
+
+void prof_hw_get_config(prof_hw_config_t *p_config)
+{
+    *p_config = s_prof_config;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file prof_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief サンプリングプロファイラのH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef PROF_HW_H
+#define PROF_HW_H
+
+#include "prof.h"
+
+#define PROF_HW_TIMER           timer1_hw   // サンプリングに使うタイマー(TIMER0はSDKのalarm pool)
+#define PROF_HW_PERIOD_US_DEF   100         // サンプリング周期のデフォルト(10kHz)
+#define PROF_HW_PERIOD_US_MIN   10          // サンプリング周期の下限
+
+// 設定
+typedef struct {
+    uint32_t core;          // プロファイル対象のコア
+    uint32_t period_us;     // サンプリング周期
+    bool is_lr;             // LRも記録するか
+} prof_hw_config_t;
+
+bool prof_hw_init(void);
+void prof_hw_start(const prof_hw_config_t *p_config);
+void prof_hw_stop(void);
+void prof_hw_irq_enable(bool is_enable);
+bool prof_hw_is_running(void);
+void prof_hw_get_config(prof_hw_config_t *p_config);
+
+#endif // PROF_HW_H
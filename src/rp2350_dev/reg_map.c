@@ -0,0 +1,536 @@
+/**
+ * @file reg_map.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief RP2350の周辺レジスタの名前表(名前⇔アドレスの変換)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "reg_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 表を書くためのマクロ
+#define R(name, off)                        {name, off, 1, 0, 0}
+#define RF(name, off, flags)                {name, off, 1, 0, flags}
+#define RA(name, off, num, stride)          {name, off, num, stride, 0}
+#define RAF(name, off, num, stride, flags)  {name, off, num, stride, flags}
+#define REG_NUM(tbl)                        ((uint8_t)(sizeof(tbl) / sizeof((tbl)[0])))
+
+#define NS      REG_F_NO_SNAP
+#define VOL     REG_F_VOLATILE
+
+// ※各表はレジスタ名の昇順(大文字で比較、'_'は英字より後ろ)
+
+static const reg_def_t s_clocks_regs[] = {
+    R("CLK_ADC_CTRL", 0x6C),            R("CLK_ADC_DIV", 0x70),             R("CLK_ADC_SELECTED", 0x74),
+    RA("CLK_GPOUT_CTRL", 0x00, 4, 12),  RA("CLK_GPOUT_DIV", 0x04, 4, 12),   RA("CLK_GPOUT_SELECTED", 0x08, 4, 12),
+    R("CLK_HSTX_CTRL", 0x54),           R("CLK_HSTX_DIV", 0x58),            R("CLK_HSTX_SELECTED", 0x5C),
+    R("CLK_PERI_CTRL", 0x48),           R("CLK_PERI_DIV", 0x4C),            R("CLK_PERI_SELECTED", 0x50),
+    R("CLK_REF_CTRL", 0x30),            R("CLK_REF_DIV", 0x34),             R("CLK_REF_SELECTED", 0x38),
+    R("CLK_SYS_CTRL", 0x3C),            R("CLK_SYS_DIV", 0x40),             R("CLK_SYS_SELECTED", 0x44),
+    R("CLK_USB_CTRL", 0x60),            R("CLK_USB_DIV", 0x64),             R("CLK_USB_SELECTED", 0x68),
+};
+
+static const reg_def_t s_dma_regs[] = {
+    RF("CHAN_ABORT", 0x464, NS),
+    RA("CH_CTRL_TRIG", 0x00C, 16, 0x40),
+    RA("CH_READ_ADDR", 0x000, 16, 0x40),
+    RA("CH_TRANS_COUNT", 0x008, 16, 0x40),
+    RA("CH_WRITE_ADDR", 0x004, 16, 0x40),
+    R("FIFO_LEVELS", 0x460),
+    R("INTE0", 0x404),  R("INTE1", 0x414),
+    R("INTF0", 0x408),  R("INTF1", 0x418),
+    R("INTR", 0x400),
+    R("INTS0", 0x40C),  R("INTS1", 0x41C),
+    RF("MULTI_CHAN_TRIGGER", 0x450, NS),
+    R("N_CHANNELS", 0x468),
+    R("SNIFF_CTRL", 0x454),
+    RF("SNIFF_DATA", 0x458, VOL),
+    RA("TIMER", 0x440, 4, 4),
+};
+
+static const reg_def_t s_i2c_regs[] = {
+    RF("IC_CLR_INTR", 0x40, NS),
+    R("IC_COMP_PARAM_1", 0xF4),
+    R("IC_COMP_TYPE", 0xFC),
+    R("IC_COMP_VERSION", 0xF8),
+    R("IC_CON", 0x00),
+    RF("IC_DATA_CMD", 0x10, NS),
+    R("IC_DMA_CR", 0x88),
+    R("IC_ENABLE", 0x6C),
+    R("IC_ENABLE_STATUS", 0x9C),
+    R("IC_FS_SCL_HCNT", 0x1C),
+    R("IC_FS_SCL_LCNT", 0x20),
+    R("IC_FS_SPKLEN", 0xA0),
+    R("IC_INTR_MASK", 0x30),
+    R("IC_INTR_STAT", 0x2C),
+    R("IC_RAW_INTR_STAT", 0x34),
+    R("IC_RXFLR", 0x78),
+    R("IC_RX_TL", 0x38),
+    R("IC_SAR", 0x08),
+    R("IC_SDA_HOLD", 0x7C),
+    R("IC_SS_SCL_HCNT", 0x14),
+    R("IC_SS_SCL_LCNT", 0x18),
+    R("IC_STATUS", 0x70),
+    R("IC_TAR", 0x04),
+    R("IC_TXFLR", 0x74),
+    R("IC_TX_ABRT_SOURCE", 0x80),
+    R("IC_TX_TL", 0x3C),
+};
+
+static const reg_def_t s_io_bank0_regs[] = {
+    RA("GPIO_CTRL", 0x004, 48, 8),
+    RA("GPIO_STATUS", 0x000, 48, 8),
+};
+
+static const reg_def_t s_pads_bank0_regs[] = {
+    RA("GPIO", 0x04, 48, 4),
+    R("SWCLK", 0xC4),
+    R("SWD", 0xC8),
+    R("VOLTAGE_SELECT", 0x00),
+};
+
+// SM_xxx[n]はステートマシンnのSMn_xxx
+static const reg_def_t s_pio_regs[] = {
+    R("CTRL", 0x00),
+    R("DBG_CFGINFO", 0x44),
+    R("DBG_PADOE", 0x40),
+    R("DBG_PADOUT", 0x3C),
+    R("FDEBUG", 0x08),
+    R("FLEVEL", 0x0C),
+    R("FSTAT", 0x04),
+    R("INPUT_SYNC_BYPASS", 0x38),
+    RAF("INSTR_MEM", 0x48, 32, 4, NS),
+    R("IRQ", 0x30),
+    RF("IRQ_FORCE", 0x34, NS),
+    RAF("RXF", 0x20, 4, 4, NS),
+    RAF("SM_ADDR", 0xD4, 4, 0x18, VOL),
+    RA("SM_CLKDIV", 0xC8, 4, 0x18),
+    RA("SM_EXECCTRL", 0xCC, 4, 0x18),
+    RAF("SM_INSTR", 0xD8, 4, 0x18, VOL),
+    RA("SM_PINCTRL", 0xDC, 4, 0x18),
+    RA("SM_SHIFTCTRL", 0xD0, 4, 0x18),
+    RAF("TXF", 0x10, 4, 4, NS),
+};
+
+static const reg_def_t s_pll_regs[] = {
+    R("CS", 0x00),
+    R("FBDIV_INT", 0x08),
+    R("INTE", 0x14),
+    R("INTF", 0x18),
+    R("INTR", 0x10),
+    R("INTS", 0x1C),
+    R("PRIM", 0x0C),
+    R("PWR", 0x04),
+};
+
+static const reg_def_t s_resets_regs[] = {
+    R("RESET", 0x0),
+    R("RESET_DONE", 0x8),
+    R("WDSEL", 0x4),
+};
+
+// ※SPINLOCKnは読むとロックを取ってしまうので載せない
+static const reg_def_t s_sio_regs[] = {
+    R("CPUID", 0x00),
+    RF("FIFO_RD", 0x58, NS),
+    R("FIFO_ST", 0x50),
+    RF("FIFO_WR", 0x54, NS),
+    RF("GPIO_HI_IN", 0x08, VOL),
+    R("GPIO_HI_OE", 0x34),
+    RF("GPIO_HI_OE_CLR", 0x44, NS),
+    RF("GPIO_HI_OE_SET", 0x3C, NS),
+    RF("GPIO_HI_OE_XOR", 0x4C, NS),
+    R("GPIO_HI_OUT", 0x14),
+    RF("GPIO_HI_OUT_CLR", 0x24, NS),
+    RF("GPIO_HI_OUT_SET", 0x1C, NS),
+    RF("GPIO_HI_OUT_XOR", 0x2C, NS),
+    RF("GPIO_IN", 0x04, VOL),
+    R("GPIO_OE", 0x30),
+    RF("GPIO_OE_CLR", 0x40, NS),
+    RF("GPIO_OE_SET", 0x38, NS),
+    RF("GPIO_OE_XOR", 0x48, NS),
+    R("GPIO_OUT", 0x10),
+    RF("GPIO_OUT_CLR", 0x20, NS),
+    RF("GPIO_OUT_SET", 0x18, NS),
+    RF("GPIO_OUT_XOR", 0x28, NS),
+    RF("SPINLOCK_ST", 0x5C, VOL),
+};
+
+static const reg_def_t s_spi_regs[] = {
+    R("SSPCPSR", 0x10),
+    R("SSPCR0", 0x00),
+    R("SSPCR1", 0x04),
+    R("SSPDMACR", 0x24),
+    RF("SSPDR", 0x08, NS),
+    RF("SSPICR", 0x20, NS),
+    R("SSPIMSC", 0x14),
+    R("SSPMIS", 0x1C),
+    R("SSPRIS", 0x18),
+    R("SSPSR", 0x0C),
+};
+
+static const reg_def_t s_sysinfo_regs[] = {
+    R("CHIP_ID", 0x00),
+    R("GITREF_RP2350", 0x14),
+    R("PACKAGE_SEL", 0x04),
+    R("PLATFORM", 0x08),
+};
+
+// ※TIMELRを読むとTIMEHRがラッチされる(他の読み手と干渉する)のでスナップショットでは読まない
+static const reg_def_t s_timer_regs[] = {
+    RA("ALARM", 0x10, 4, 4),
+    R("ARMED", 0x20),
+    R("DBGPAUSE", 0x2C),
+    R("INTE", 0x40),
+    R("INTF", 0x44),
+    R("INTR", 0x3C),
+    R("INTS", 0x48),
+    R("LOCKED", 0x34),
+    R("PAUSE", 0x30),
+    R("SOURCE", 0x38),
+    RF("TIMEHR", 0x08, NS),
+    RF("TIMEHW", 0x00, NS),
+    RF("TIMELR", 0x0C, NS),
+    RF("TIMELW", 0x04, NS),
+    RF("TIMERAWH", 0x24, VOL),
+    RF("TIMERAWL", 0x28, VOL),
+};
+
+static const reg_def_t s_uart_regs[] = {
+    R("UARTCR", 0x30),
+    R("UARTDMACR", 0x48),
+    RF("UARTDR", 0x00, NS),
+    R("UARTFBRD", 0x28),
+    RF("UARTFR", 0x18, VOL),
+    R("UARTIBRD", 0x24),
+    RF("UARTICR", 0x44, NS),
+    R("UARTIFLS", 0x34),
+    R("UARTILPR", 0x20),
+    R("UARTIMSC", 0x38),
+    R("UARTLCR_H", 0x2C),
+    R("UARTMIS", 0x40),
+    R("UARTRIS", 0x3C),
+    R("UARTRSR", 0x04),
+};
+
+static const reg_def_t s_watchdog_regs[] = {
+    R("CTRL", 0x00),
+    RF("LOAD", 0x04, NS),
+    R("REASON", 0x08),
+    RA("SCRATCH", 0x0C, 8, 4),
+};
+
+static const reg_def_t s_xosc_regs[] = {
+    RF("COUNT", 0x10, VOL),
+    R("CTRL", 0x00),
+    R("DORMANT", 0x08),
+    R("STARTUP", 0x0C),
+    R("STATUS", 0x04),
+};
+
+// ブロックの表(ブロック名の昇順、reset_bitはRESETSのビット)
+static const reg_block_t s_block_tbl[] = {
+    {"CLOCKS",      0x40010000, s_clocks_regs,      REG_NUM(s_clocks_regs),     REG_MAP_NO_RESET},
+    {"DMA",         0x50000000, s_dma_regs,         REG_NUM(s_dma_regs),        2},
+    {"I2C0",        0x40090000, s_i2c_regs,         REG_NUM(s_i2c_regs),        4},
+    {"I2C1",        0x40098000, s_i2c_regs,         REG_NUM(s_i2c_regs),        5},
+    {"IO_BANK0",    0x40028000, s_io_bank0_regs,    REG_NUM(s_io_bank0_regs),   6},
+    {"PADS_BANK0",  0x40038000, s_pads_bank0_regs,  REG_NUM(s_pads_bank0_regs), 9},
+    {"PIO0",        0x50200000, s_pio_regs,         REG_NUM(s_pio_regs),        11},
+    {"PIO1",        0x50300000, s_pio_regs,         REG_NUM(s_pio_regs),        12},
+    {"PIO2",        0x50400000, s_pio_regs,         REG_NUM(s_pio_regs),        13},
+    {"PLL_SYS",     0x40050000, s_pll_regs,         REG_NUM(s_pll_regs),        14},
+    {"PLL_USB",     0x40058000, s_pll_regs,         REG_NUM(s_pll_regs),        15},
+    {"RESETS",      0x40020000, s_resets_regs,      REG_NUM(s_resets_regs),     REG_MAP_NO_RESET},
+    {"SIO",         0xD0000000, s_sio_regs,         REG_NUM(s_sio_regs),        REG_MAP_NO_RESET},
+    {"SPI0",        0x40080000, s_spi_regs,         REG_NUM(s_spi_regs),        18},
+    {"SPI1",        0x40088000, s_spi_regs,         REG_NUM(s_spi_regs),        19},
+    {"SYSINFO",     0x40000000, s_sysinfo_regs,     REG_NUM(s_sysinfo_regs),    21},
+    {"TIMER0",      0x400B0000, s_timer_regs,       REG_NUM(s_timer_regs),      23},
+    {"TIMER1",      0x400B8000, s_timer_regs,       REG_NUM(s_timer_regs),      24},
+    {"UART0",       0x40070000, s_uart_regs,        REG_NUM(s_uart_regs),       26},
+    {"UART1",       0x40078000, s_uart_regs,        REG_NUM(s_uart_regs),       27},
+    {"WATCHDOG",    0x400D8000, s_watchdog_regs,    REG_NUM(s_watchdog_regs),   REG_MAP_NO_RESET},
+    {"XOSC",        0x40048000, s_xosc_regs,        REG_NUM(s_xosc_regs),       REG_MAP_NO_RESET},
+};
+
+#define BLOCK_NUM   (sizeof(s_block_tbl) / sizeof(s_block_tbl[0]))
+
+static inline char to_upper(char c)
+{
+    return ((c >= 'a') && (c <= 'z')) ? (char)(c - 'a' + 'A') : c;
+}
+
+// 長さlenのキーと表の名前を大文字で比較する(strcmpと同じ符号)
+static int32_t name_cmp(const char *p_key, uint32_t len, const char *p_name)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        char a = to_upper(p_key[i]);
+        char b = p_name[i];
+        if (b == '\0') {
+            return 1;
+        }
+        if (a != b) {
+            return ((uint8_t)a < (uint8_t)b) ? -1 : 1;
+        }
+    }
+
+    return (p_name[len] == '\0') ? 0 : -1;
+}
+
+static const reg_def_t *find_reg(const reg_block_t *p_block, const char *p_name, uint32_t len)
+{
+    uint32_t lo = 0;
+    uint32_t hi = p_block->reg_num;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        int32_t cmp = name_cmp(p_name, len, p_block->p_regs[mid].p_name);
+        if (cmp == 0) {
+            return &p_block->p_regs[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 表のブロック数
+ *
+ * @return uint32_t ブロック数
+ */
+uint32_t reg_map_block_num(void)
+{
+    return BLOCK_NUM;
+}
+
+/**
+ * @brief 表のブロック
+ *
+ * @param idx 0からreg_map_block_num()-1
+ * @return const reg_block_t* ブロック(範囲外はNULL)
+ */
+const reg_block_t *reg_map_block(uint32_t idx)
+{
+    return (idx < BLOCK_NUM) ? &s_block_tbl[idx] : NULL;
+}
+
+/**
+ * @brief ブロックの名前のあるレジスタが並ぶ範囲のバイト数
+ *
+ * @param p_block ブロック
+ * @return uint32_t ベースアドレスから最後のレジスタの終わりまでのバイト数
+ */
+uint32_t reg_map_block_span(const reg_block_t *p_block)
+{
+    uint32_t span = 0;
+
+    for (uint32_t i = 0; i < p_block->reg_num; i++)
+    {
+        const reg_def_t *p_reg = &p_block->p_regs[i];
+        uint32_t end = p_reg->offset + (uint32_t)(p_reg->num - 1) * p_reg->stride + 4;
+        if (end > span) {
+            span = end;
+        }
+    }
+
+    return span;
+}
+
+/**
+ * @brief レジスタのアドレス
+ *
+ * @param p_block ブロック
+ * @param p_reg レジスタ
+ * @param index 配列の添字(配列でなければ0)
+ * @return uint32_t アドレス
+ */
+uint32_t reg_def_addr(const reg_block_t *p_block, const reg_def_t *p_reg, uint32_t index)
+{
+    return p_block->base + p_reg->offset + index * p_reg->stride;
+}
+
+/**
+ * @brief ブロックを名前で探す(二分探索)
+ *
+ * @param p_name 名前(終端でなくてよい)
+ * @param len 名前の文字数
+ * @return const reg_block_t* ブロック(無ければNULL)
+ */
+const reg_block_t *reg_map_find_block(const char *p_name, uint32_t len)
+{
+    uint32_t lo = 0;
+    uint32_t hi = BLOCK_NUM;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        int32_t cmp = name_cmp(p_name, len, s_block_tbl[mid].p_name);
+        if (cmp == 0) {
+            return &s_block_tbl[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 「ブロック」「ブロック.レジスタ」「ブロック.レジスタ[n]」を引く
+ * @note 配列で添字を省いたら[0]、ブロック名だけならベースアドレス
+ *
+ * @param p_name 名前
+ * @param p_ref 結果
+ * @return true 見つかった
+ * @return false 名前が無い/添字が範囲外
+ */
+bool reg_map_lookup(const char *p_name, reg_ref_t *p_ref)
+{
+    const char *p_dot = strchr(p_name, '.');
+    uint32_t block_len = (p_dot != NULL) ? (uint32_t)(p_dot - p_name) : (uint32_t)strlen(p_name);
+    const reg_block_t *p_block = reg_map_find_block(p_name, block_len);
+
+    if (p_block == NULL) {
+        return false;
+    }
+    p_ref->p_block = p_block;
+    p_ref->p_reg = NULL;
+    p_ref->index = 0;
+    p_ref->addr = p_block->base;
+    if (p_dot == NULL) {
+        return true;
+    }
+
+    const char *p_reg_name = p_dot + 1;
+    const char *p_bracket = strchr(p_reg_name, '[');
+    uint32_t reg_len = (p_bracket != NULL) ? (uint32_t)(p_bracket - p_reg_name) : (uint32_t)strlen(p_reg_name);
+    const reg_def_t *p_reg = find_reg(p_block, p_reg_name, reg_len);
+    if (p_reg == NULL) {
+        return false;
+    }
+
+    uint32_t index = 0;
+    if (p_bracket != NULL) {
+        char *p_end;
+        if (p_bracket[1] < '0' || p_bracket[1] > '9') {
+            return false;
+        }
+        index = (uint32_t)strtoul(&p_bracket[1], &p_end, 10);
+        if (p_end[0] != ']' || p_end[1] != '\0' || index >= p_reg->num) {
+            return false;
+        }
+    }
+
+    p_ref->p_reg = p_reg;
+    p_ref->index = index;
+    p_ref->addr = reg_def_addr(p_block, p_reg, index);
+
+    return true;
+}
+
+/**
+ * @brief アドレスを含むブロックを探す
+ *
+ * @param addr アドレス
+ * @return const reg_block_t* ブロック(どのブロックの範囲でもなければNULL)
+ */
+const reg_block_t *reg_map_block_of(uint32_t addr)
+{
+    for (uint32_t i = 0; i < BLOCK_NUM; i++)
+    {
+        const reg_block_t *p_block = &s_block_tbl[i];
+        if (addr >= p_block->base && (addr - p_block->base) < reg_map_block_span(p_block)) {
+            return p_block;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief アドレスのレジスタを探す
+ *
+ * @param addr アドレス
+ * @param pp_block ブロック(範囲外ならNULL、不要ならNULLを渡してよい)
+ * @param p_index 配列の添字(不要ならNULL)
+ * @return const reg_def_t* レジスタ(表に無ければNULL)
+ */
+const reg_def_t *reg_map_def_of(uint32_t addr, const reg_block_t **pp_block, uint32_t *p_index)
+{
+    const reg_block_t *p_block = reg_map_block_of(addr);
+
+    if (pp_block != NULL) {
+        *pp_block = p_block;
+    }
+    if (p_block == NULL) {
+        return NULL;
+    }
+
+    uint32_t off = addr - p_block->base;
+    for (uint32_t i = 0; i < p_block->reg_num; i++)
+    {
+        const reg_def_t *p_reg = &p_block->p_regs[i];
+        if (off < p_reg->offset) {
+            continue;
+        }
+        uint32_t delta = off - p_reg->offset;
+        uint32_t index = (p_reg->num <= 1) ? delta : (delta / p_reg->stride);
+        bool is_hit = (p_reg->num <= 1) ? (delta == 0)
+                    : (((delta % p_reg->stride) == 0) && (index < p_reg->num));
+        if (is_hit) {
+            if (p_index != NULL) {
+                *p_index = index;
+            }
+            return p_reg;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief アドレスを名前にする
+ * @note 表に無いオフセットは「ブロック+0xOFF」にする
+ *
+ * @param addr アドレス
+ * @param p_buf 名前を書くバッファ(REG_MAP_NAME_MAXあれば足りる)
+ * @param size バッファのバイト数
+ * @return true 名前にできた
+ * @return false どのブロックの範囲でもない
+ */
+bool reg_map_name_of(uint32_t addr, char *p_buf, uint32_t size)
+{
+    const reg_block_t *p_block;
+    uint32_t index = 0;
+    const reg_def_t *p_reg = reg_map_def_of(addr, &p_block, &index);
+
+    if (p_block == NULL) {
+        return false;
+    }
+
+    if (p_reg == NULL) {
+        snprintf(p_buf, size, "%s+0x%03X", p_block->p_name, (unsigned)(addr - p_block->base));
+    } else if (p_reg->num <= 1) {
+        snprintf(p_buf, size, "%s.%s", p_block->p_name, p_reg->p_name);
+    } else {
+        snprintf(p_buf, size, "%s.%s[%u]", p_block->p_name, p_reg->p_name, (unsigned)index);
+    }
+
+    return true;
+}
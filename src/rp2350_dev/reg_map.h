@@ -0,0 +1,65 @@
+/**
+ * @file reg_map.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief RP2350の周辺レジスタの名前表(名前⇔アドレスの変換)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef REG_MAP_H
+#define REG_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストで確認できる)
+// ※名前は「ブロック.レジスタ」、配列は「ブロック.レジスタ[n]」(例: I2C0.IC_CON、DMA.CH_CTRL_TRIG[3])、大文字小文字は区別しない
+// ※表はブロック名、レジスタ名それぞれ昇順に並べる(二分探索するため)
+// ※全部ではなく主なレジスタだけ
+
+#define REG_MAP_NAME_MAX    40              // reg_map_name_of()の名前の最大長
+#define REG_MAP_NO_RESET    0xFF            // RESETSで止められないブロック
+
+// レジスタの属性
+#define REG_F_NO_SNAP       0x01            // 読むと副作用がある/書き込み専用(スナップショットで読まない)
+#define REG_F_VOLATILE      0x02            // 勝手に変わるカウンタ等(読むが差分には出さない)
+
+// レジスタ(配列ならnum個をstrideバイトおきに並べる)
+typedef struct {
+    const char *p_name;
+    uint16_t offset;
+    uint8_t num;
+    uint8_t stride;
+    uint8_t flags;
+} reg_def_t;
+
+// 周辺のブロック
+typedef struct {
+    const char *p_name;
+    uint32_t base;
+    const reg_def_t *p_regs;
+    uint8_t reg_num;
+    uint8_t reset_bit;          // RESETSのビット(REG_MAP_NO_RESETなら無し)
+} reg_block_t;
+
+// 名前を引いた結果
+typedef struct {
+    const reg_block_t *p_block;
+    const reg_def_t *p_reg;     // ブロック名だけならNULL
+    uint32_t index;             // 配列の添字
+    uint32_t addr;
+} reg_ref_t;
+
+uint32_t reg_map_block_num(void);
+uint32_t reg_map_block_span(const reg_block_t *p_block);
+const reg_block_t *reg_map_block(uint32_t idx);
+const reg_block_t *reg_map_find_block(const char *p_name, uint32_t len);
+bool reg_map_lookup(const char *p_name, reg_ref_t *p_ref);
+const reg_block_t *reg_map_block_of(uint32_t addr);
+const reg_def_t *reg_map_def_of(uint32_t addr, const reg_block_t **pp_block, uint32_t *p_index);
+bool reg_map_name_of(uint32_t addr, char *p_buf, uint32_t size);
+uint32_t reg_def_addr(const reg_block_t *p_block, const reg_def_t *p_reg, uint32_t index);
+
+#endif // REG_MAP_H
@@ -0,0 +1,458 @@
+/**
+ * @file reg_ops.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief レジスタのまとめ操作(マスク付きRMW、タイムアウト付きポーリング、スナップショットと差分)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "reg_ops.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool parse_hex(const char *p_str, uint32_t *p_val)
+{
+    char *p_end;
+
+    if (p_str[0] != '#' || p_str[1] == '\0') {
+        return false;
+    }
+    *p_val = (uint32_t)strtoul(&p_str[1], &p_end, 16);
+
+    return (*p_end == '\0');
+}
+
+static bool parse_dec(const char *p_str, uint32_t *p_val)
+{
+    char *p_end;
+
+    if (p_str[0] < '0' || p_str[0] > '9') {
+        return false;
+    }
+    *p_val = (uint32_t)strtoul(p_str, &p_end, 10);
+
+    return (*p_end == '\0');
+}
+
+static bool parse_bits(const char *p_str, uint32_t *p_bits)
+{
+    return parse_dec(p_str, p_bits) && (*p_bits == 8 || *p_bits == 16 || *p_bits == 32);
+}
+
+/**
+ * @brief アドレスを解釈する
+ *
+ * @param p_str #HEXまたは名前(ブロック.レジスタ[n]、ブロック名ならベースアドレス)
+ * @param p_addr アドレス
+ * @return true OK
+ * @return false 不正
+ */
+bool reg_parse_addr(const char *p_str, uint32_t *p_addr)
+{
+    reg_ref_t ref;
+
+    if (p_str[0] == '#') {
+        return parse_hex(p_str, p_addr);
+    }
+    if (!reg_map_lookup(p_str, &ref)) {
+        return false;
+    }
+    *p_addr = ref.addr;
+
+    return true;
+}
+
+// snap/dumpの対象(<block>か#addr #len)
+static const char *parse_target(int32_t argc, char *const p_argv[], reg_cmd_t *p_cmd)
+{
+    if (argc == 3) {
+        p_cmd->p_block = reg_map_find_block(p_argv[2], (uint32_t)strlen(p_argv[2]));
+        return (p_cmd->p_block != NULL) ? NULL : "Unknown block (see 'reg list')";
+    }
+    if (argc != 4) {
+        return "Usage: reg snap|dump <block> | reg snap|dump #addr #len";
+    }
+    if (!parse_hex(p_argv[2], &p_cmd->addr) || !parse_hex(p_argv[3], &p_cmd->len)) {
+        return "Address and length must be #HEX";
+    }
+    if ((p_cmd->addr & 3) != 0 || (p_cmd->len & 3) != 0 || p_cmd->len == 0) {
+        return "Address and length must be multiples of 4";
+    }
+    if ((p_cmd->len / 4) > REG_SNAP_MAX) {
+        return "Too many registers (max 256 words)";
+    }
+    if (p_cmd->addr + p_cmd->len - 1 < p_cmd->addr) {
+        return "Range wraps around";
+    }
+
+    return NULL;
+}
+
+static const char *parse_mask_val(char *const p_argv[], reg_cmd_t *p_cmd)
+{
+    if ((p_cmd->addr & 3) != 0) {
+        return "Address must be 32bit aligned";
+    }
+    if (!parse_hex(p_argv[3], &p_cmd->mask) || !parse_hex(p_argv[4], &p_cmd->val)) {
+        return "Mask and value must be #HEX";
+    }
+    if (p_cmd->mask == 0) {
+        return "Mask must not be 0";
+    }
+    if ((p_cmd->val & ~p_cmd->mask) != 0) {
+        return "Value has bits outside the mask";
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief regコマンドの引数を解釈する
+ *
+ * @param argc 引数の数(コマンド名を含む)
+ * @param p_argv 引数(p_argv[0]はコマンド名)
+ * @param p_cmd 結果
+ * @return const char* NULLならOK、それ以外はエラーの説明
+ */
+const char *reg_cmd_parse(int32_t argc, char *const p_argv[], reg_cmd_t *p_cmd)
+{
+    memset(p_cmd, 0, sizeof(*p_cmd));
+    p_cmd->bits = 32;
+    p_cmd->timeout_ms = REG_POLL_TIMEOUT_DEF_MS;
+
+    if (argc < 2) {
+        return "Missing arguments";
+    }
+
+    const char *p_sub = p_argv[1];
+    if (strcmp(p_sub, "list") == 0) {
+        p_cmd->op = REG_OP_LIST;
+        if (argc == 3) {
+            p_cmd->p_block = reg_map_find_block(p_argv[2], (uint32_t)strlen(p_argv[2]));
+            return (p_cmd->p_block != NULL) ? NULL : "Unknown block (see 'reg list')";
+        }
+        return (argc == 2) ? NULL : "Usage: reg list [block]";
+    }
+    if (strcmp(p_sub, "diff") == 0) {
+        p_cmd->op = REG_OP_DIFF;
+        return (argc == 2) ? NULL : "Usage: reg diff";
+    }
+    if (strcmp(p_sub, "snap") == 0 || strcmp(p_sub, "dump") == 0) {
+        p_cmd->op = (p_sub[0] == 's') ? REG_OP_SNAP : REG_OP_DUMP;
+        return parse_target(argc, p_argv, p_cmd);
+    }
+
+    if (argc < 3) {
+        return "Missing operation (r|w|rmw|poll)";
+    }
+    if (!reg_parse_addr(p_sub, &p_cmd->addr)) {
+        return "Invalid address. Use #HEX or BLOCK.REG[n] (see 'reg list')";
+    }
+
+    const char *p_op = p_argv[2];
+    if (strcmp(p_op, "r") == 0) {
+        p_cmd->op = REG_OP_READ;
+        if (argc > 4) {
+            return "Usage: reg <addr> r [bits]";
+        }
+        if (argc == 4 && !parse_bits(p_argv[3], &p_cmd->bits)) {
+            return "Bit width must be 8, 16, or 32";
+        }
+    } else if (strcmp(p_op, "w") == 0) {
+        p_cmd->op = REG_OP_WRITE;
+        if (argc != 4 && argc != 5) {
+            return "Usage: reg <addr> w [bits] #val";
+        }
+        if (argc == 5 && !parse_bits(p_argv[3], &p_cmd->bits)) {
+            return "Bit width must be 8, 16, or 32";
+        }
+        if (!parse_hex(p_argv[argc - 1], &p_cmd->val)) {
+            return "Value must be #HEX";
+        }
+        if (p_cmd->bits < 32 && (p_cmd->val >> p_cmd->bits) != 0) {
+            return "Value does not fit in the bit width";
+        }
+    } else if (strcmp(p_op, "rmw") == 0) {
+        p_cmd->op = REG_OP_RMW;
+        if (argc != 5 && argc != 6) {
+            return "Usage: reg <addr> rmw #mask #val [shift]";
+        }
+        const char *p_err = parse_mask_val(p_argv, p_cmd);
+        if (p_err != NULL) {
+            return p_err;
+        }
+        if (argc == 6 && (!parse_dec(p_argv[5], &p_cmd->shift) || p_cmd->shift > 31)) {
+            return "Shift must be 0-31";
+        }
+        if (((p_cmd->mask << p_cmd->shift) >> p_cmd->shift) != p_cmd->mask) {
+            return "Mask shifted out of 32 bits";
+        }
+        return NULL;
+    } else if (strcmp(p_op, "poll") == 0) {
+        p_cmd->op = REG_OP_POLL;
+        if (argc < 5 || argc > 7) {
+            return "Usage: reg <addr> poll #mask #val [timeout_ms] [ne]";
+        }
+        const char *p_err = parse_mask_val(p_argv, p_cmd);
+        if (p_err != NULL) {
+            return p_err;
+        }
+        for (int32_t i = 5; i < argc; i++)
+        {
+            if (strcmp(p_argv[i], "ne") == 0) {
+                p_cmd->is_ne = true;
+            } else if (!parse_dec(p_argv[i], &p_cmd->timeout_ms) || p_cmd->timeout_ms == 0
+                       || p_cmd->timeout_ms > REG_POLL_TIMEOUT_MAX_MS) {
+                return "Timeout must be 1-10000 ms";
+            }
+        }
+        return NULL;
+    } else {
+        return "Operation must be r, w, rmw, or poll";
+    }
+
+    if ((p_cmd->addr & ((p_cmd->bits / 8) - 1)) != 0) {
+        return "Address is not aligned to the bit width";
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief RMWで書く値
+ *
+ * @param old_val 元の値
+ * @param mask フィールドのマスク(シフト前)
+ * @param val フィールドの値(シフト前)
+ * @param shift フィールドの位置
+ * @return uint32_t 書く値
+ */
+uint32_t reg_rmw_value(uint32_t old_val, uint32_t mask, uint32_t val, uint32_t shift)
+{
+    return (old_val & ~(mask << shift)) | ((val & mask) << shift);
+}
+
+/**
+ * @brief マスク付きRMW(読んでから書くまでロックする)
+ *
+ * @param p_ops 環境の操作
+ * @param addr アドレス(32bitアライン)
+ * @param mask フィールドのマスク(シフト前)
+ * @param val フィールドの値(シフト前)
+ * @param shift フィールドの位置
+ * @param p_old 元の値(不要ならNULL)
+ * @return uint32_t 書いた値
+ */
+uint32_t reg_rmw(const reg_ops_t *p_ops, uint32_t addr, uint32_t mask, uint32_t val, uint32_t shift,
+                 uint32_t *p_old)
+{
+    uint32_t save = p_ops->lock();
+    uint32_t old_val = p_ops->read(addr);
+    uint32_t new_val = reg_rmw_value(old_val, mask, val, shift);
+    p_ops->write(addr, new_val);
+    p_ops->unlock(save);
+
+    if (p_old != NULL) {
+        *p_old = old_val;
+    }
+
+    return new_val;
+}
+
+/**
+ * @brief pollの条件を満たすか
+ *
+ * @param read_val 読んだ値
+ * @param mask マスク
+ * @param val 期待値
+ * @param is_ne trueなら一致しないことが条件
+ * @return true 条件を満たす
+ * @return false 満たさない
+ */
+bool reg_poll_is_match(uint32_t read_val, uint32_t mask, uint32_t val, bool is_ne)
+{
+    return (((read_val & mask) == val) != is_ne);
+}
+
+/**
+ * @brief レジスタを条件を満たすまで読み続ける
+ * @note 一致したときのサイクル数は一致した読み出しの直後で測る
+ *
+ * @param p_ops 環境の操作
+ * @param p_cmd REG_OP_POLLのコマンド
+ * @param p_result 結果
+ */
+void reg_poll(const reg_ops_t *p_ops, const reg_cmd_t *p_cmd, reg_poll_result_t *p_result)
+{
+    uint32_t timeout_us = p_cmd->timeout_ms * 1000;
+    uint32_t start_us = p_ops->now_us();
+    uint32_t start_cyc = p_ops->cycles();
+    uint32_t reads = 0;
+    uint32_t val;
+    bool is_match;
+
+    do
+    {
+        val = p_ops->read(p_cmd->addr);
+        reads++;
+        is_match = reg_poll_is_match(val, p_cmd->mask, p_cmd->val, p_cmd->is_ne);
+        if (is_match) {
+            break;
+        }
+        if (p_ops->kick != NULL && (reads % REG_POLL_KICK_READS) == 0) {
+            p_ops->kick();
+        }
+    } while ((p_ops->now_us() - start_us) < timeout_us);
+
+    p_result->cycles = p_ops->cycles() - start_cyc;
+    p_result->us = p_ops->now_us() - start_us;
+    p_result->is_match = is_match;
+    p_result->val = val;
+    p_result->reads = reads;
+}
+
+static bool snap_add(reg_snap_t *p_snap, uint32_t addr, uint8_t flags)
+{
+    if (p_snap->num >= REG_SNAP_MAX) {
+        return false;
+    }
+    p_snap->addr[p_snap->num] = addr;
+    p_snap->val[p_snap->num] = 0;
+    p_snap->flags[p_snap->num] = flags;
+    p_snap->num++;
+
+    return true;
+}
+
+// アドレスの昇順に並べる(数百個なので挿入ソート)
+static void snap_sort(reg_snap_t *p_snap)
+{
+    for (uint32_t i = 1; i < p_snap->num; i++)
+    {
+        uint32_t addr = p_snap->addr[i];
+        uint8_t flags = p_snap->flags[i];
+        uint32_t j = i;
+        while (j > 0 && p_snap->addr[j - 1] > addr)
+        {
+            p_snap->addr[j] = p_snap->addr[j - 1];
+            p_snap->flags[j] = p_snap->flags[j - 1];
+            j--;
+        }
+        p_snap->addr[j] = addr;
+        p_snap->flags[j] = flags;
+    }
+}
+
+/**
+ * @brief ブロックの表のレジスタを読む計画を立てる(REG_F_NO_SNAPは除く)
+ *
+ * @param p_snap スナップショット
+ * @param p_block ブロック
+ * @return true OK
+ * @return false REG_SNAP_MAXを超えた
+ */
+bool reg_snap_plan_block(reg_snap_t *p_snap, const reg_block_t *p_block)
+{
+    p_snap->num = 0;
+    for (uint32_t i = 0; i < p_block->reg_num; i++)
+    {
+        const reg_def_t *p_reg = &p_block->p_regs[i];
+        if ((p_reg->flags & REG_F_NO_SNAP) != 0) {
+            continue;
+        }
+        for (uint32_t n = 0; n < p_reg->num; n++)
+        {
+            if (!snap_add(p_snap, reg_def_addr(p_block, p_reg, n), p_reg->flags)) {
+                return false;
+            }
+        }
+    }
+    snap_sort(p_snap);
+
+    return true;
+}
+
+/**
+ * @brief アドレスの範囲を32bitずつ読む計画を立てる
+ * @note 名前の表でREG_F_NO_SNAPのアドレスは読まない
+ *
+ * @param p_snap スナップショット
+ * @param addr 先頭アドレス(32bitアライン)
+ * @param len バイト数(4の倍数)
+ * @return true OK
+ * @return false 範囲が不正/REG_SNAP_MAXを超えた
+ */
+bool reg_snap_plan_range(reg_snap_t *p_snap, uint32_t addr, uint32_t len)
+{
+    p_snap->num = 0;
+    if ((addr & 3) != 0 || (len & 3) != 0 || (len / 4) > REG_SNAP_MAX) {
+        return false;
+    }
+    for (uint32_t off = 0; off < len; off += 4)
+    {
+        const reg_def_t *p_reg = reg_map_def_of(addr + off, NULL, NULL);
+        uint8_t flags = (p_reg != NULL) ? p_reg->flags : 0;
+        if ((flags & REG_F_NO_SNAP) == 0) {
+            snap_add(p_snap, addr + off, flags);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 計画したレジスタを読む
+ *
+ * @param p_snap スナップショット
+ * @param p_ops 環境の操作(readだけ使う)
+ */
+void reg_snap_take(reg_snap_t *p_snap, const reg_ops_t *p_ops)
+{
+    for (uint32_t i = 0; i < p_snap->num; i++)
+    {
+        p_snap->val[i] = p_ops->read(p_snap->addr[i]);
+    }
+}
+
+/**
+ * @brief 2つのスナップショットの差分(両方にあるアドレスだけ、REG_F_VOLATILEは除く)
+ *
+ * @param p_old 前のスナップショット
+ * @param p_new 後のスナップショット
+ * @param p_out 差分(先頭からmax個まで書く)
+ * @param max p_outの要素数
+ * @return uint32_t 差分の数(maxを超えることがある)
+ */
+uint32_t reg_snap_diff(const reg_snap_t *p_old, const reg_snap_t *p_new, reg_diff_t *p_out, uint32_t max)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t cnt = 0;
+
+    while (i < p_old->num && j < p_new->num)
+    {
+        if (p_old->addr[i] < p_new->addr[j]) {
+            i++;
+            continue;
+        }
+        if (p_old->addr[i] > p_new->addr[j]) {
+            j++;
+            continue;
+        }
+        bool is_volatile = ((p_old->flags[i] | p_new->flags[j]) & REG_F_VOLATILE) != 0;
+        if (!is_volatile && p_old->val[i] != p_new->val[j]) {
+            if (cnt < max) {
+                p_out[cnt].addr = p_old->addr[i];
+                p_out[cnt].old_val = p_old->val[i];
+                p_out[cnt].new_val = p_new->val[j];
+            }
+            cnt++;
+        }
+        i++;
+        j++;
+    }
+
+    return cnt;
+}
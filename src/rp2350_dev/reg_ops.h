@@ -0,0 +1,101 @@
+/**
+ * @file reg_ops.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief レジスタのまとめ操作(マスク付きRMW、タイムアウト付きポーリング、スナップショットと差分)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef REG_OPS_H
+#define REG_OPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "reg_map.h"
+
+// ※このモジュールはPico SDKに依存しない(レジスタの読み書き、ロック、時刻はreg_ops_tで注入、ホストで確認できる)
+// ※RMWとポーリングは32bitアクセスだけ
+
+#define REG_SNAP_MAX                256     // スナップショットのレジスタ数の上限
+#define REG_POLL_TIMEOUT_DEF_MS     100     // pollのタイムアウト(省略時)
+#define REG_POLL_TIMEOUT_MAX_MS     10000   // pollのタイムアウトの上限(DWTのサイクル数が一周しない範囲)
+#define REG_POLL_KICK_READS         4096    // pollでこの回数読むごとにkickを呼ぶ
+
+// regコマンドの操作
+typedef enum {
+    REG_OP_READ = 0,    // reg <addr> r [bits]
+    REG_OP_WRITE,       // reg <addr> w [bits] #val
+    REG_OP_RMW,         // reg <addr> rmw #mask #val [shift]
+    REG_OP_POLL,        // reg <addr> poll #mask #val [timeout_ms] [ne]
+    REG_OP_SNAP,        // reg snap <block>|#addr #len
+    REG_OP_DIFF,        // reg diff
+    REG_OP_DUMP,        // reg dump <block>|#addr #len
+    REG_OP_LIST,        // reg list [block]
+} reg_op_t;
+
+// regコマンドを解釈した結果
+typedef struct {
+    reg_op_t op;
+    uint32_t addr;
+    uint32_t bits;                  // 8/16/32
+    uint32_t val;
+    uint32_t mask;                  // RMW/pollのマスク(シフト前)
+    uint32_t shift;                 // RMWのシフト
+    uint32_t timeout_ms;
+    uint32_t len;                   // snap/dumpのバイト数(ブロック指定なら0)
+    bool is_ne;                     // pollで一致しなくなるまで待つ
+    const reg_block_t *p_block;     // snap/dump/listのブロック(無ければNULL)
+} reg_cmd_t;
+
+// レジスタの読み書きと環境の操作(実機はdbg_com.c)
+typedef struct {
+    uint32_t (*read)(uint32_t addr);
+    void (*write)(uint32_t addr, uint32_t val);
+    uint32_t (*lock)(void);
+    void (*unlock)(uint32_t save);
+    uint32_t (*now_us)(void);
+    uint32_t (*cycles)(void);
+    void (*kick)(void);             // pollの途中で呼ぶ(WDT等、NULLなら呼ばない)
+} reg_ops_t;
+
+// pollの結果
+typedef struct {
+    bool is_match;
+    uint32_t val;           // 最後に読んだ値
+    uint32_t reads;         // 読んだ回数
+    uint32_t cycles;        // 一致するまで(タイムアウトならタイムアウトまで)のサイクル数
+    uint32_t us;
+} reg_poll_result_t;
+
+// スナップショット(アドレスの昇順)
+typedef struct {
+    uint32_t num;
+    uint32_t addr[REG_SNAP_MAX];
+    uint32_t val[REG_SNAP_MAX];
+    uint8_t flags[REG_SNAP_MAX];
+} reg_snap_t;
+
+// 差分
+typedef struct {
+    uint32_t addr;
+    uint32_t old_val;
+    uint32_t new_val;
+} reg_diff_t;
+
+const char *reg_cmd_parse(int32_t argc, char *const p_argv[], reg_cmd_t *p_cmd);
+bool reg_parse_addr(const char *p_str, uint32_t *p_addr);
+
+uint32_t reg_rmw_value(uint32_t old_val, uint32_t mask, uint32_t val, uint32_t shift);
+uint32_t reg_rmw(const reg_ops_t *p_ops, uint32_t addr, uint32_t mask, uint32_t val, uint32_t shift,
+                 uint32_t *p_old);
+bool reg_poll_is_match(uint32_t read_val, uint32_t mask, uint32_t val, bool is_ne);
+void reg_poll(const reg_ops_t *p_ops, const reg_cmd_t *p_cmd, reg_poll_result_t *p_result);
+
+bool reg_snap_plan_block(reg_snap_t *p_snap, const reg_block_t *p_block);
+bool reg_snap_plan_range(reg_snap_t *p_snap, uint32_t addr, uint32_t len);
+void reg_snap_take(reg_snap_t *p_snap, const reg_ops_t *p_ops);
+uint32_t reg_snap_diff(const reg_snap_t *p_old, const reg_snap_t *p_new, reg_diff_t *p_out, uint32_t max);
+
+#endif // REG_OPS_H
@@ -0,0 +1,198 @@
+/**
+ * @file ring_buf.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 1対1(書き手1つ、読み手1つ)のロックフリーなバイトのリングバッファ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "ring_buf.h"
+#include "hot_path.h"
+#include <string.h>
+
+/**
+ * @brief 初期化
+ *
+ * @param p_rb リングバッファ
+ * @param p_buf 領域
+ * @param size バイト数(2のべき乗)
+ * @return true 成功
+ * @return false sizeが2のべき乗でない
+ */
+bool rb_init(ring_buf_t *p_rb, uint8_t *p_buf, uint32_t size)
+{
+    if (size == 0 || (size & (size - 1)) != 0) {
+        return false;
+    }
+
+    memset(p_rb, 0, sizeof(ring_buf_t));
+    p_rb->p_buf = p_buf;
+    p_rb->size = size;
+
+    return true;
+}
+
+/**
+ * @brief 空にして統計を消す(書き手も読み手も止まっている時に呼ぶ)
+ */
+void rb_reset(ring_buf_t *p_rb)
+{
+    p_rb->head = 0;
+    p_rb->tail = 0;
+    p_rb->overrun = 0;
+    p_rb->peak = 0;
+}
+
+uint32_t HOT_FUNC(rb_used)(const ring_buf_t *p_rb)
+{
+    return __atomic_load_n(&p_rb->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&p_rb->tail, __ATOMIC_ACQUIRE);
+}
+HOT_PATH_REGISTER(rb_used);
+
+uint32_t HOT_FUNC(rb_free)(const ring_buf_t *p_rb)
+{
+    return p_rb->size - rb_used(p_rb);
+}
+HOT_PATH_REGISTER(rb_free);
+
+/**
+ * @brief 1バイト書く(割り込みの受信用)
+ *
+ * @return true 書いた
+ * @return false 満杯(捨ててoverrunに数える)
+ */
+bool HOT_FUNC(rb_put)(ring_buf_t *p_rb, uint8_t data)
+{
+    uint32_t head = p_rb->head;
+    uint32_t used = head - __atomic_load_n(&p_rb->tail, __ATOMIC_ACQUIRE);
+
+    if (used >= p_rb->size) {
+        p_rb->overrun++;
+        return false;
+    }
+
+    p_rb->p_buf[head & (p_rb->size - 1)] = data;
+    __atomic_store_n(&p_rb->head, head + 1, __ATOMIC_RELEASE);
+    if (used + 1 > p_rb->peak) {
+        p_rb->peak = used + 1;
+    }
+
+    return true;
+}
+HOT_PATH_REGISTER(rb_put);
+
+/**
+ * @brief 書けるだけ書く(入らない分は書かない、overrunには数えない)
+ *
+ * @return uint32_t 書いたバイト数
+ */
+uint32_t rb_write(ring_buf_t *p_rb, const void *p_data, uint32_t len)
+{
+    const uint8_t *p_src = (const uint8_t *)p_data;
+    uint32_t total = 0;
+
+    while (total < len)
+    {
+        uint8_t *p_dst;
+        uint32_t n = rb_reserve(p_rb, &p_dst);
+        if (n == 0) {
+            break;
+        }
+        if (n > len - total) {
+            n = len - total;
+        }
+        memcpy(p_dst, &p_src[total], n);
+        rb_commit(p_rb, n);
+        total += n;
+    }
+
+    return total;
+}
+
+/**
+ * @brief 読めるだけ読む
+ *
+ * @return uint32_t 読んだバイト数
+ */
+uint32_t rb_read(ring_buf_t *p_rb, void *p_data, uint32_t len)
+{
+    uint8_t *p_dst = (uint8_t *)p_data;
+    uint32_t total = 0;
+
+    while (total < len)
+    {
+        const uint8_t *p_src;
+        uint32_t n = rb_peek(p_rb, &p_src);
+        if (n == 0) {
+            break;
+        }
+        if (n > len - total) {
+            n = len - total;
+        }
+        memcpy(&p_dst[total], p_src, n);
+        rb_consume(p_rb, n);
+        total += n;
+    }
+
+    return total;
+}
+
+/**
+ * @brief 読める連続した範囲をコピーせずに返す(読み手用)
+ *
+ * @param p_rb リングバッファ
+ * @param pp_data 先頭
+ * @return uint32_t 連続して読めるバイト数(使い終わったらrb_consume)
+ */
+uint32_t HOT_FUNC(rb_peek)(const ring_buf_t *p_rb, const uint8_t **pp_data)
+{
+    uint32_t tail = p_rb->tail;
+    uint32_t used = __atomic_load_n(&p_rb->head, __ATOMIC_ACQUIRE) - tail;
+    uint32_t pos = tail & (p_rb->size - 1);
+    uint32_t n = p_rb->size - pos;
+
+    *pp_data = &p_rb->p_buf[pos];
+
+    return (used < n) ? used : n;
+}
+HOT_PATH_REGISTER(rb_peek);
+
+void HOT_FUNC(rb_consume)(ring_buf_t *p_rb, uint32_t len)
+{
+    __atomic_store_n(&p_rb->tail, p_rb->tail + len, __ATOMIC_RELEASE);
+}
+HOT_PATH_REGISTER(rb_consume);
+
+/**
+ * @brief 書ける連続した範囲をコピーせずに返す(書き手用)
+ *
+ * @param p_rb リングバッファ
+ * @param pp_data 先頭
+ * @return uint32_t 連続して書けるバイト数(書いたらrb_commit)
+ */
+uint32_t HOT_FUNC(rb_reserve)(const ring_buf_t *p_rb, uint8_t **pp_data)
+{
+    uint32_t head = p_rb->head;
+    uint32_t free = p_rb->size - (head - __atomic_load_n(&p_rb->tail, __ATOMIC_ACQUIRE));
+    uint32_t pos = head & (p_rb->size - 1);
+    uint32_t n = p_rb->size - pos;
+
+    *pp_data = &p_rb->p_buf[pos];
+
+    return (free < n) ? free : n;
+}
+HOT_PATH_REGISTER(rb_reserve);
+
+void HOT_FUNC(rb_commit)(ring_buf_t *p_rb, uint32_t len)
+{
+    uint32_t head = p_rb->head + len;
+    uint32_t used = head - __atomic_load_n(&p_rb->tail, __ATOMIC_ACQUIRE);
+
+    __atomic_store_n(&p_rb->head, head, __ATOMIC_RELEASE);
+    if (used > p_rb->peak) {
+        p_rb->peak = used;
+    }
+}
+HOT_PATH_REGISTER(rb_commit);
@@ -0,0 +1,42 @@
+/**
+ * @file ring_buf.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 1対1(書き手1つ、読み手1つ)のロックフリーなバイトのリングバッファのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef RING_BUF_H
+#define RING_BUF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ※このモジュールはPico SDKに依存しない(ホストで確認できる)
+// ※書き手と読み手は別のコア/割り込みでもよい(head/tailは単調増加、書き手だけがhead、読み手だけがtailを書く)
+// ※peek/reserveは連続した範囲だけ返す(折り返しをまたぐ分は2回に分ける)
+
+typedef struct {
+    uint8_t *p_buf;
+    uint32_t size;          // 2のべき乗
+    uint32_t head;          // 書いた合計(書き手だけが更新)
+    uint32_t tail;          // 読んだ合計(読み手だけが更新)
+    uint32_t overrun;       // 満杯で捨てたバイト数(書き手が数える)
+    uint32_t peak;          // 使用量の最大
+} ring_buf_t;
+
+bool rb_init(ring_buf_t *p_rb, uint8_t *p_buf, uint32_t size);
+void rb_reset(ring_buf_t *p_rb);
+uint32_t rb_used(const ring_buf_t *p_rb);
+uint32_t rb_free(const ring_buf_t *p_rb);
+bool rb_put(ring_buf_t *p_rb, uint8_t data);
+uint32_t rb_write(ring_buf_t *p_rb, const void *p_data, uint32_t len);
+uint32_t rb_read(ring_buf_t *p_rb, void *p_data, uint32_t len);
+uint32_t rb_peek(const ring_buf_t *p_rb, const uint8_t **pp_data);
+void rb_consume(ring_buf_t *p_rb, uint32_t len);
+uint32_t rb_reserve(const ring_buf_t *p_rb, uint8_t **pp_data);
+void rb_commit(ring_buf_t *p_rb, uint32_t len);
+
+#endif // RING_BUF_H
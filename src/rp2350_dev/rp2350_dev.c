@@ -11,22 +11,36 @@
 #include "mcu_util.h"
 #include "app_main.h"
 #include "pico/multicore.h"
+#include "dma_service_hw.h"
+#include "trace_hw.h"
+#include "mem_hw.h"
+#include "clk_hw.h"
+#include "idle_hw.h"
+#include "data_pipe_hw.h"
+#include "uart_hw.h"
+#include "boot_hw.h"
+#include "timer_svc_hw.h"
+#include "dbg_com.h"
 
 const char src[] = "Hello, world! (from DMA)";
 char dst[count_of(src)];
 
 #include "blink.pio.h"
 
+// blinkのSMのクロック(clk_sysを変えてもclk_hwが分周比を追従させる)
+#define BLINK_SM_CLK_HZ     1000000
+
 void blink_pin_forever(PIO pio, uint sm, uint offset, uint pin, uint freq)
 {
     blink_program_init(pio, sm, offset, pin);
+    clk_hw_add_pio("blink", pio, sm, BLINK_SM_CLK_HZ);
     pio_sm_set_enabled(pio, sm, true);
 
     printf("Blinking pin %d at %d Hz\n", pin, freq);
 
     // PIO counter program takes 3 more cycles in total than we pass as
     // input (wait for n + 1; mov; jmp)
-    pio->txf[sm] = (125000000 / (2 * freq)) - 3;
+    pio->txf[sm] = (BLINK_SM_CLK_HZ / (2 * freq)) - 3;
 }
 
 /**
@@ -38,109 +52,209 @@ void blink_pin_forever(PIO pio, uint sm, uint offset, uint pin, uint freq)
  */
 int64_t alarm_callback(alarm_id_t id, void *p_user_data)
 {
+    TRACE_INSTANT(TRACE_ID_ALARM_CB, id);
     NOP();
 
     return 0;
 }
 
-int main()
+// DMAサービス初期化(完了割り込みはCore0で処理)
+static void init_dma_svc(void)
 {
-    stdio_init_all();
+    dma_svc_hw_init();
+}
 
-    // CPU Core1を起動
-    multicore_launch_core1(core_1_main);
+// DMAで転送
+static void init_dma_demo(void)
+{
+    dma_svc_handle_t dma_handle = dma_svc_memcpy_async(dst, src, count_of(src), NULL, NULL);
+    dma_svc_wait(dma_handle);
+    puts(dst);
+}
+
+// PIO初期化
+static void init_pio_blink(void)
+{
+    PIO pio = pio0;
+    uint offset = pio_add_program(pio, &blink_program);
+    printf("Loaded program at %d\n", offset);
+
+#ifdef PICO_DEFAULT_LED_PIN
+    blink_pin_forever(pio, 0, offset, PICO_DEFAULT_LED_PIN, 3);
+#else
+    blink_pin_forever(pio, 0, offset, 6, 3);
+#endif
+}
+
+// 補間器初期化
+static void init_interp(void)
+{
+    interp_config cfg = interp_default_config();
+    interp_set_config(interp0, 0, &cfg);
+}
+
+// タイマー割り込み @2000ms
+static void init_alarm(void)
+{
+    add_alarm_in_ms(2000, alarm_callback, NULL, false);
+}
+
+static void init_wdt(void)
+{
+#ifdef _WDT_ENABLE_
+    if (watchdog_caused_reboot()) {
+        printf("Rebooted by Watchdog!\n");
+    }
+
+    watchdog_enable(_WDT_OVF_TIME_MS_, 1);
+    WDT_RST();
+#endif // _WDT_ENABLE_
+}
+
+// UART0初期化(8N1)
+static void init_uart0(void)
+{
+    uart_init(UART_0_PORT, UART_BAUD_RATE);
+    clk_hw_add_uart("uart0", UART_0_PORT, UART_BAUD_RATE);
+    gpio_set_function(UART_0_TX, GPIO_FUNC_UART);
+    gpio_set_function(UART_0_RX, GPIO_FUNC_UART);
+    uart_hw_init(UART_0_PORT, UART_BAUD_RATE);
+}
+
+// UART1初期化(8N1)
+static void init_uart1(void)
+{
+    uart_init(UART_1_PORT, UART_BAUD_RATE);
+    clk_hw_add_uart("uart1", UART_1_PORT, UART_BAUD_RATE);
+    gpio_set_function(UART_1_TX, GPIO_FUNC_UART);
+    gpio_set_function(UART_1_RX, GPIO_FUNC_UART);
+    uart_hw_init(UART_1_PORT, UART_BAUD_RATE);
+}
 
-    // SPI0初期化
+// 送信はリング経由のDMA(待たない)、シェルもUARTに出す
+static void init_uart_shell(void)
+{
+    uart_hw_write(uart_get_index(UART_0_PORT), " Hello, UART!\n", 14);
+    uart_hw_set_shell(UART_SHELL_INDEX);
+}
+
+// ソフトウェアタイマー(H/Wアラームの割り込みはこのコアに入る)
+static void init_timer_svc(void)
+{
+    timer_svc_hw_init();
+}
+
+static void init_dbg_com(void)
+{
+    dbg_com_init();
+    boot_hw_mark(BOOT_STAGE_SHELL);
+}
+
+// SPI0初期化
+static void init_spi0(void)
+{
     spi_init(SPI_0_PORT, SPI_BIT_RATE);
+    clk_hw_add_spi("spi0", SPI_0_PORT, SPI_BIT_RATE);
     gpio_set_function(SPI_0_CS,   GPIO_FUNC_SIO);
     gpio_set_function(SPI_0_SCK,  GPIO_FUNC_SPI);
     gpio_set_function(SPI_0_MISO, GPIO_FUNC_SPI);
     gpio_set_function(SPI_0_MOSI, GPIO_FUNC_SPI);
     gpio_set_dir(SPI_0_CS, GPIO_OUT);
     gpio_put(SPI_0_CS, 1);
+}
 
-    // SPI1初期化
+// SPI1初期化
+static void init_spi1(void)
+{
     spi_init(SPI_1_PORT, SPI_BIT_RATE);
+    clk_hw_add_spi("spi1", SPI_1_PORT, SPI_BIT_RATE);
     gpio_set_function(SPI_1_CS,   GPIO_FUNC_SIO);
     gpio_set_function(SPI_1_SCK,  GPIO_FUNC_SPI);
     gpio_set_function(SPI_1_MISO, GPIO_FUNC_SPI);
     gpio_set_function(SPI_1_MOSI, GPIO_FUNC_SPI);
     gpio_set_dir(SPI_1_CS, GPIO_OUT);
     gpio_put(SPI_1_CS, 1);
+}
 
-    // I2C0初期化
+// I2C0初期化
+static void init_i2c0(void)
+{
     i2c_init(I2C_0_PORT, I2C_BIT_RATE);
+    clk_hw_add_i2c("i2c0", I2C_0_PORT, I2C_BIT_RATE);
     gpio_set_function(I2C_0_SDA, GPIO_FUNC_I2C);
     gpio_set_function(I2C_0_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_0_SDA);
     gpio_pull_up(I2C_0_SCL);
+}
 
-    // I2C1初期化
+// I2C1初期化
+static void init_i2c1(void)
+{
     i2c_init(I2C_1_PORT, I2C_BIT_RATE);
+    clk_hw_add_i2c("i2c1", I2C_1_PORT, I2C_BIT_RATE);
     gpio_set_function(I2C_1_SDA, GPIO_FUNC_I2C);
     gpio_set_function(I2C_1_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_1_SDA);
     gpio_pull_up(I2C_1_SCL);
+}
 
-    // DMA初期化(@8bit ブロッキング)
-    int chan = dma_claim_unused_channel(true);
-    dma_channel_config c = dma_channel_get_default_config(chan);
-    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
-    channel_config_set_read_increment(&c, true);
-    channel_config_set_write_increment(&c, true);
-    dma_channel_configure(
-        chan,          // Channel to be configured
-        &c,            // The configuration we just created
-        dst,           // The initial write address
-        src,           // The initial read address
-        count_of(src), // Number of transfers; in this case each is 1 byte.
-        true           // Start immediately.
-    );
-    dma_channel_wait_for_finish_blocking(chan);
-    // DMAで転送
-    puts(dst);
-
-    // PIO初期化
-    PIO pio = pio0;
-    uint offset = pio_add_program(pio, &blink_program);
-    printf("Loaded program at %d\n", offset);
+#define CORE0   INIT_GRAPH_CORE(0)
+#define CORE1   INIT_GRAPH_CORE(1)
+#define DEP(t)  INIT_GRAPH_DEP(t)
 
-#ifdef PICO_DEFAULT_LED_PIN
-    blink_pin_forever(pio, 0, offset, PICO_DEFAULT_LED_PIN, 3);
-#else
-    blink_pin_forever(pio, 0, offset, 6, 3);
-#endif
+// 初期化タスク(割り込みを使うものはそのコアで、コマンドから使う周辺は最初に使うときに初期化)
+// ※SPIを使うコマンドは無い(boot_hw_require()を呼ぶ所が無い)ので起動時に初期化する
+// ※clk_hwの登録は排他していないので、登録するタスクはCore0か遅延(Core1のコマンドから)にする
+static const init_task_t s_boot_task_tbl[BOOT_TASK_NUM] = {
+    [BOOT_TASK_DMA_SVC]     = {"dma_svc",   init_dma_svc,       0,                                  CORE0,                  false},
+    [BOOT_TASK_DMA_DEMO]    = {"dma_demo",  init_dma_demo,      DEP(BOOT_TASK_DMA_SVC),             INIT_GRAPH_CORE_ANY,    false},
+    [BOOT_TASK_PIO_BLINK]   = {"pio_blink", init_pio_blink,     0,                                  CORE0,                  false},
+    [BOOT_TASK_INTERP]      = {"interp",    init_interp,        0,                                  CORE0,                  false},
+    [BOOT_TASK_ALARM]       = {"alarm",     init_alarm,         0,                                  CORE0,                  false},
+    [BOOT_TASK_WDT]         = {"wdt",       init_wdt,           0,                                  CORE0,                  false},
+    [BOOT_TASK_UART0]       = {"uart0",     init_uart0,         DEP(BOOT_TASK_DMA_SVC),             CORE0,                  false},
+    [BOOT_TASK_UART1]       = {"uart1",     init_uart1,         DEP(BOOT_TASK_DMA_SVC),             CORE0,                  false},
+    [BOOT_TASK_UART_SHELL]  = {"uart_shell", init_uart_shell,   DEP(BOOT_TASK_UART0) | DEP(BOOT_TASK_UART1), CORE0,         false},
+    [BOOT_TASK_TIMER_SVC]   = {"timer_svc", init_timer_svc,     0,                                  CORE1,                  false},
+    [BOOT_TASK_DBG_COM]     = {"dbg_com",   init_dbg_com,       DEP(BOOT_TASK_TIMER_SVC),           CORE1,                  false},
+    [BOOT_TASK_SPI0]        = {"spi0",      init_spi0,          0,                                  CORE0,                  false},
+    [BOOT_TASK_SPI1]        = {"spi1",      init_spi1,          0,                                  CORE0,                  false},
+    [BOOT_TASK_I2C0]        = {"i2c0",      init_i2c0,          0,                                  INIT_GRAPH_CORE_ANY,    true},
+    [BOOT_TASK_I2C1]        = {"i2c1",      init_i2c1,          0,                                  INIT_GRAPH_CORE_ANY,    true},
+};
 
-    // 割り込み初期化
-    interp_config cfg = interp_default_config();
-    interp_set_config(interp0, 0, &cfg);
+int main()
+{
+    boot_hw_mark(BOOT_STAGE_MAIN);
 
-    // タイマー割り込み @2000ms
-    add_alarm_in_ms(2000, alarm_callback, NULL, false);
+    // USB(CDC×2)の初期化、stdio_usbは自前でtusb_init()しないので先に
+    data_pipe_hw_init();
+    stdio_init_all();
+    boot_hw_mark(BOOT_STAGE_STDIO);
 
-#ifdef _WDT_ENABLE_
-    if (watchdog_caused_reboot()) {
-        printf("Rebooted by Watchdog!\n");
-    }
+    // イベントトレース初期化(Core1を起動する前に)
+    trace_hw_init();
+    // スタックの塗りつぶしとメモリプール初期化(Core1を起動する前に)
+    mem_hw_init();
 
-    watchdog_enable(_WDT_OVF_TIME_MS_, 1);
-    WDT_RST();
-#endif // _WDT_ENABLE_
+    // クロックの利用者レジストリ初期化(周辺の初期化より前に)
+    clk_hw_init();
 
-    printf("System Clock Frequency is %d Hz\n", clock_get_hz(clk_sys));
-    printf("USB Clock Frequency is %d Hz\n", clock_get_hz(clk_usb));
+    // アイドル(WFE)の初期化(Core1を起動する前に)
+    idle_hw_init();
 
-    // UART0初期化(8N1)
-    uart_init(UART_0_PORT, UART_BAUD_RATE);
-    gpio_set_function(UART_0_TX, GPIO_FUNC_UART);
-    gpio_set_function(UART_0_RX, GPIO_FUNC_UART);
+    // 初期化タスクの登録(Core1を起動する前に)
+    if (!boot_hw_init(s_boot_task_tbl, BOOT_TASK_NUM)) {
+        printf("Error: Invalid init task table.\n");
+    }
 
-    // UART1初期化(8N1)
-    uart_init(UART_1_PORT, UART_BAUD_RATE);
-    gpio_set_function(UART_1_TX, GPIO_FUNC_UART);
-    gpio_set_function(UART_1_RX, GPIO_FUNC_UART);
+    // CPU Core1を起動(Core1も自分の分の初期化タスクを実行してシェルを始める)
+    multicore_launch_core1(core_1_main);
+    boot_hw_mark(BOOT_STAGE_CORE1_LAUNCH);
 
-    uart_puts(UART_0_PORT, " Hello, UART!\n");
+    // Core0の分の初期化タスク
+    boot_hw_run();
+    boot_hw_mark(BOOT_STAGE_CORE0_MAIN);
 
     core_0_main();
 }
\ No newline at end of file
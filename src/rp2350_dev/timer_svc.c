@@ -0,0 +1,315 @@
+/**
+ * @file timer_svc.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ソフトウェアタイマーサービス(H/Wアラーム1本をタイマーホイールで多重化)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "timer_svc.h"
+#include "hot_path.h"
+#include "trace.h"
+#include <string.h>
+
+// タイマー1つ(idは配列の添字+1)
+typedef struct {
+    tw_timer_t tw;
+    timer_svc_cb_t cb;
+    void *p_arg;
+    uint32_t fired;
+    bool is_used;
+} timer_svc_node_t;
+
+static const timer_svc_ops_t *s_p_ops = NULL;
+static tw_wheel_t s_wheel;
+static timer_svc_node_t s_node[TIMER_SVC_MAX];
+static timer_svc_stats_t s_stats;
+static uint64_t s_now_us;           // timer_svc_poll()で読んだ時刻
+static uint64_t s_alarm_us;         // 設定中のH/Wアラーム(UINT64_MAXなら無し)
+static volatile bool s_is_pending;  // 割り込みから: ホイールを進める
+
+static inline uint32_t svc_tick(uint64_t us)
+{
+    return (uint32_t)(us / TIMER_SVC_TICK_US);
+}
+
+static inline int32_t svc_id(const timer_svc_node_t *p_node)
+{
+    return (int32_t)(p_node - s_node) + 1;
+}
+
+static inline timer_svc_node_t *svc_node_of(tw_timer_t *p_tw)
+{
+    return (timer_svc_node_t *)((uint8_t *)p_tw - offsetof(timer_svc_node_t, tw));
+}
+
+static timer_svc_node_t *svc_find(int32_t id)
+{
+    if (id < 1 || id > TIMER_SVC_MAX || !s_node[id - 1].is_used) {
+        return NULL;
+    }
+
+    return &s_node[id - 1];
+}
+
+// tickの開始時刻(μs)、32bitのtickの折り返しは最後に読んだ時刻のtickからの差で吸収
+static uint64_t svc_tick_to_us(uint32_t tick)
+{
+    uint64_t base_us = s_now_us - (s_now_us % TIMER_SVC_TICK_US);
+    int32_t diff = (int32_t)(tick - svc_tick(s_now_us));
+
+    return base_us + (int64_t)diff * TIMER_SVC_TICK_US;
+}
+
+// 次に処理が必要なtickにH/Wアラームを合わせる
+static void svc_rearm(void)
+{
+    uint32_t next = tw_next_expiry(&s_wheel);
+
+    if (next == TW_NO_EXPIRY) {
+        if (s_alarm_us != UINT64_MAX) {
+            s_p_ops->cancel_alarm();
+            s_alarm_us = UINT64_MAX;
+        }
+        return;
+    }
+
+    uint64_t at_us = svc_tick_to_us(s_wheel.now + next);
+    if (at_us != s_alarm_us) {
+        s_alarm_us = at_us;
+        s_p_ops->set_alarm(at_us);
+    }
+}
+
+// ホイールから呼ばれる(timer_svc_poll()の中なのでスレッド側)
+static void svc_expire(tw_timer_t *p_tw, void *p_ctx)
+{
+    timer_svc_node_t *p_node = svc_node_of(p_tw);
+    int32_t id = svc_id(p_node);
+    // 満了させているtickがそのままホイールのnow
+    uint64_t due_us = svc_tick_to_us(s_wheel.now);
+    uint64_t now_us = *(const uint64_t *)p_ctx;
+    uint32_t late_us = (now_us > due_us) ? (uint32_t)(now_us - due_us) : 0;
+    timer_svc_cb_t cb = p_node->cb;
+    void *p_arg = p_node->p_arg;
+
+    p_node->fired++;
+    s_stats.fired++;
+    s_stats.late_sum_us += late_us;
+    if (late_us > s_stats.late_max_us) {
+        s_stats.late_max_us = late_us;
+    }
+
+    // ワンショットは先に返すので、コールバックの中で登録し直せる
+    if (!p_tw->is_active) {
+        p_node->is_used = false;
+        s_stats.active--;
+    }
+
+    TRACE_BEGIN(TRACE_ID_TIMER_CB, id);
+    cb(id, p_arg);
+    TRACE_END(TRACE_ID_TIMER_CB, id);
+}
+
+/**
+ * @brief タイマーサービスの初期化
+ *
+ * @param p_ops 時刻とH/Wアラーム
+ */
+void timer_svc_init(const timer_svc_ops_t *p_ops)
+{
+    s_p_ops = p_ops;
+    s_now_us = p_ops->now_us();
+    s_alarm_us = UINT64_MAX;
+    s_is_pending = false;
+    memset(s_node, 0, sizeof(s_node));
+    memset(&s_stats, 0, sizeof(s_stats));
+    tw_init(&s_wheel, svc_tick(s_now_us));
+    for (uint32_t i = 0; i < TIMER_SVC_MAX; i++)
+    {
+        tw_timer_init(&s_node[i].tw);
+    }
+}
+
+/**
+ * @brief タイマーを登録
+ *
+ * @param delay_ms 最初の満了までのms(1tick未満は1tickにする)
+ * @param period_ms 周期のms(0ならワンショット)
+ * @param cb コールバック
+ * @param p_arg コールバックに渡す
+ * @return int32_t タイマーID(1～TIMER_SVC_MAX)、失敗なら-1
+ */
+int32_t timer_svc_add(uint32_t delay_ms, uint32_t period_ms, timer_svc_cb_t cb, void *p_arg)
+{
+    uint64_t delay = ((uint64_t)delay_ms * 1000) / TIMER_SVC_TICK_US;
+    uint64_t period = ((uint64_t)period_ms * 1000) / TIMER_SVC_TICK_US;
+
+    if (s_p_ops == NULL || cb == NULL || delay >= TW_MAX_TICKS || period > TW_MAX_TICKS) {
+        return -1;
+    }
+    if (period_ms != 0 && period == 0) {
+        period = 1;
+    }
+
+    for (uint32_t i = 0; i < TIMER_SVC_MAX; i++)
+    {
+        timer_svc_node_t *p_node = &s_node[i];
+
+        if (p_node->is_used) {
+            continue;
+        }
+        // 早く満了しないよう切り上げたtickにする
+        // (ホイールは前回のtimer_svc_poll()の時点なので、その分も足す)
+        uint64_t due_us = s_p_ops->now_us() + (uint64_t)delay_ms * 1000;
+        uint64_t ticks = svc_tick(due_us + TIMER_SVC_TICK_US - 1) - s_wheel.now;
+        if (ticks > TW_MAX_TICKS) {
+            ticks = TW_MAX_TICKS;
+        }
+
+        p_node->is_used = true;
+        p_node->cb = cb;
+        p_node->p_arg = p_arg;
+        p_node->fired = 0;
+        tw_add(&s_wheel, &p_node->tw, (uint32_t)ticks, (uint32_t)period);
+        if (++s_stats.active > s_stats.peak) {
+            s_stats.peak = s_stats.active;
+        }
+        svc_rearm();
+
+        return svc_id(p_node);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief タイマーを取り消す(コールバックの中から自分や他のタイマーを取り消してもよい)
+ *
+ * @return true 取り消した
+ * @return false そのIDのタイマーは無い
+ */
+bool timer_svc_cancel(int32_t id)
+{
+    timer_svc_node_t *p_node = svc_find(id);
+
+    if (p_node == NULL) {
+        return false;
+    }
+
+    tw_cancel(&s_wheel, &p_node->tw);
+    p_node->is_used = false;
+    s_stats.active--;
+    svc_rearm();
+
+    return true;
+}
+
+/**
+ * @brief 全タイマーを取り消す
+ *
+ * @return uint32_t 取り消した数
+ */
+uint32_t timer_svc_cancel_all(void)
+{
+    uint32_t num = 0;
+
+    for (int32_t id = 1; id <= TIMER_SVC_MAX; id++)
+    {
+        if (timer_svc_cancel(id)) {
+            num++;
+        }
+    }
+
+    return num;
+}
+
+/**
+ * @brief H/Wアラームの割り込みから呼ぶ(次のtimer_svc_poll()でホイールを進める)
+ */
+void HOT_FUNC(timer_svc_notify)(void)
+{
+    s_is_pending = true;
+    s_stats.irqs++;
+}
+HOT_PATH_REGISTER(timer_svc_notify);
+
+/**
+ * @brief 満了したタイマーのコールバックを呼ぶ(メインループから呼ぶ)
+ * @note 割り込みが無くても時刻で判定するので、取りこぼしても次の呼び出しで追いつく
+ *
+ * @return uint32_t 呼んだコールバック数
+ */
+uint32_t HOT_FUNC(timer_svc_poll)(void)
+{
+    if (s_p_ops == NULL) {
+        return 0;
+    }
+
+    uint64_t now_us = s_p_ops->now_us();
+    if (!s_is_pending && now_us < s_alarm_us) {
+        return 0;
+    }
+
+    s_is_pending = false;
+    s_now_us = now_us;
+    s_stats.polls++;
+    uint32_t num = tw_advance(&s_wheel, svc_tick(now_us), svc_expire, &now_us);
+    svc_rearm();
+
+    return num;
+}
+HOT_PATH_REGISTER(timer_svc_poll);
+
+/**
+ * @brief 登録中のタイマーを順に取り出す
+ *
+ * @param p_pos 探索位置(最初は0を入れて呼ぶ)
+ * @param p_info 取り出した情報
+ * @return true 取り出した
+ * @return false もう無い
+ */
+bool timer_svc_next(uint32_t *p_pos, timer_svc_info_t *p_info)
+{
+    uint64_t now_us = (s_p_ops != NULL) ? s_p_ops->now_us() : 0;
+
+    while (*p_pos < TIMER_SVC_MAX)
+    {
+        const timer_svc_node_t *p_node = &s_node[(*p_pos)++];
+
+        if (!p_node->is_used) {
+            continue;
+        }
+        uint64_t due_us = svc_tick_to_us(p_node->tw.expires);
+        p_info->id = svc_id(p_node);
+        p_info->remain_us = (due_us > now_us) ? (uint32_t)(due_us - now_us) : 0;
+        p_info->period_us = p_node->tw.period * TIMER_SVC_TICK_US;
+        p_info->fired = p_node->fired;
+        return true;
+    }
+
+    return false;
+}
+
+void timer_svc_get_stats(timer_svc_stats_t *p_stats)
+{
+    *p_stats = s_stats;
+    p_stats->cascades = s_wheel.cascades;
+    p_stats->overruns = s_wheel.overruns;
+}
+
+/**
+ * @brief 統計をクリア(active、peakは今の数にする)
+ */
+void timer_svc_clear_stats(void)
+{
+    uint32_t active = s_stats.active;
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.active = active;
+    s_stats.peak = active;
+    s_wheel.cascades = 0;
+    s_wheel.overruns = 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file timer_svc.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ソフトウェアタイマーサービス(H/Wアラーム1本をタイマーホイールで多重化)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TIMER_SVC_H
+#define TIMER_SVC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timer_wheel.h"
+
+// ※このモジュールはPico SDKに依存しない(時刻とH/Wアラームはtimer_svc_ops_tで注入)
+
+// 【使い方】
+// timer_svc_add()でタイマーを登録し、ループでtimer_svc_poll()を呼ぶ
+// コールバックは割り込みではなくtimer_svc_poll()の中(スレッド側)で呼ぶのでprintf()等をしてよい
+// ※timer_svc_poll()を呼ぶコア(Core1)からだけ使う。割り込みから呼べるのはtimer_svc_notify()だけ
+
+#define TIMER_SVC_MAX           256     // 登録できるタイマー数
+#define TIMER_SVC_TICK_US       1000    // 1tickのμs
+#define TIMER_SVC_MAX_MS        ((uint32_t)(((uint64_t)TW_MAX_TICKS * TIMER_SVC_TICK_US) / 1000))
+
+// コールバック(id: timer_svc_add()の戻り値)
+typedef void (*timer_svc_cb_t)(int32_t id, void *p_arg);
+
+// 時刻とH/Wアラーム(実機はtimer_svc_hw.c、ホストでは仮想時計を渡す)
+typedef struct {
+    uint64_t (*now_us)(void);
+    void (*set_alarm)(uint64_t at_us);  // at_usに割り込みでtimer_svc_notify()を呼ぶ
+    void (*cancel_alarm)(void);
+} timer_svc_ops_t;
+
+// タイマー1つの情報(timer_svc_next()で取り出す)
+typedef struct {
+    int32_t id;
+    uint32_t remain_us;     // 満了までの残り
+    uint32_t period_us;     // 周期(0ならワンショット)
+    uint32_t fired;         // 満了した回数
+} timer_svc_info_t;
+
+// 統計
+typedef struct {
+    uint32_t active;        // 動いているタイマー数
+    uint32_t peak;          // activeの最大
+    uint32_t fired;         // コールバックを呼んだ回数
+    uint32_t late_max_us;   // 満了からコールバックまでの遅れの最大
+    uint64_t late_sum_us;   // 遅れの合計(平均 = late_sum_us / fired)
+    uint32_t irqs;          // H/Wアラームの割り込み回数
+    uint32_t polls;         // ホイールを進めた回数
+    uint32_t cascades;      // カスケードで並べ直したタイマー数
+    uint32_t overruns;      // 周期に間に合わなかった回数
+} timer_svc_stats_t;
+
+void timer_svc_init(const timer_svc_ops_t *p_ops);
+int32_t timer_svc_add(uint32_t delay_ms, uint32_t period_ms, timer_svc_cb_t cb, void *p_arg);
+bool timer_svc_cancel(int32_t id);
+uint32_t timer_svc_cancel_all(void);
+void timer_svc_notify(void);
+uint32_t timer_svc_poll(void);
+bool timer_svc_next(uint32_t *p_pos, timer_svc_info_t *p_info);
+void timer_svc_get_stats(timer_svc_stats_t *p_stats);
+void timer_svc_clear_stats(void);
+
+#endif // TIMER_SVC_H
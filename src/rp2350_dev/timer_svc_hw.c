@@ -0,0 +1,71 @@
+/**
+ * @file timer_svc_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ソフトウェアタイマーサービスのH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "timer_svc_hw.h"
+#include "mcu_util.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "hot_path.h"
+#include "idle_hw.h"
+
+static int32_t s_alarm_num = -1;
+
+// TIMER0のアラーム割り込み(フラグを立てるだけ、WFEで寝ているコアも起こす)
+static void HOT_FUNC(timer_svc_hw_irq)(uint alarm_num)
+{
+    (void)alarm_num;
+    timer_svc_notify();
+    idle_hw_notify(get_core_num(), IDLE_WAKE_TIMER);
+}
+HOT_PATH_REGISTER(timer_svc_hw_irq);
+
+static uint64_t timer_svc_hw_now_us(void)
+{
+    return time_us_64();
+}
+
+static void timer_svc_hw_set_alarm(uint64_t at_us)
+{
+    // 既に過ぎていたら割り込みは来ないので自分で知らせる
+    if (hardware_alarm_set_target((uint)s_alarm_num, from_us_since_boot(at_us))) {
+        timer_svc_notify();
+    }
+}
+
+static void timer_svc_hw_cancel_alarm(void)
+{
+    hardware_alarm_cancel((uint)s_alarm_num);
+}
+
+static const timer_svc_ops_t s_timer_svc_hw_ops = {
+    .now_us = timer_svc_hw_now_us,
+    .set_alarm = timer_svc_hw_set_alarm,
+    .cancel_alarm = timer_svc_hw_cancel_alarm,
+};
+
+/**
+ * @brief タイマーサービスの初期化
+ * @note 割り込みは呼んだコアに入るので、timer_svc_poll()を呼ぶコアで呼ぶ
+ *
+ * @return true 成功
+ * @return false 空いているH/Wアラームが無い
+ */
+bool timer_svc_hw_init(void)
+{
+    s_alarm_num = hardware_alarm_claim_unused(false);
+    if (s_alarm_num < 0) {
+        return false;
+    }
+
+    hardware_alarm_set_callback((uint)s_alarm_num, timer_svc_hw_irq);
+    timer_svc_init(&s_timer_svc_hw_ops);
+
+    return true;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file timer_svc_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief ソフトウェアタイマーサービスのH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TIMER_SVC_HW_H
+#define TIMER_SVC_HW_H
+
+#include "timer_svc.h"
+
+bool timer_svc_hw_init(void);
+
+#endif // TIMER_SVC_HW_H
@@ -0,0 +1,304 @@
+/**
+ * @file timer_wheel.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 階層タイマーホイール
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "timer_wheel.h"
+#include "hot_path.h"
+
+static inline void tw_list_init(tw_list_t *p_head)
+{
+    p_head->p_next = p_head;
+    p_head->p_prev = p_head;
+}
+
+static inline bool tw_list_is_empty(const tw_list_t *p_head)
+{
+    return (p_head->p_next == p_head);
+}
+
+static inline void tw_list_add_tail(tw_list_t *p_head, tw_list_t *p_node)
+{
+    p_node->p_next = p_head;
+    p_node->p_prev = p_head->p_prev;
+    p_head->p_prev->p_next = p_node;
+    p_head->p_prev = p_node;
+}
+
+static inline void tw_list_del(tw_list_t *p_node)
+{
+    p_node->p_prev->p_next = p_node->p_next;
+    p_node->p_next->p_prev = p_node->p_prev;
+    tw_list_init(p_node);
+}
+
+// p_srcのノードを全部p_dstに移してp_srcを空にする
+static inline void tw_list_splice(tw_list_t *p_src, tw_list_t *p_dst)
+{
+    tw_list_init(p_dst);
+    if (!tw_list_is_empty(p_src)) {
+        p_dst->p_next = p_src->p_next;
+        p_dst->p_prev = p_src->p_prev;
+        p_dst->p_next->p_prev = p_dst;
+        p_dst->p_prev->p_next = p_dst;
+        tw_list_init(p_src);
+    }
+}
+
+static inline tw_timer_t *tw_timer_of(tw_list_t *p_node)
+{
+    return (tw_timer_t *)((uint8_t *)p_node - offsetof(tw_timer_t, node));
+}
+
+static inline uint32_t tw_index(uint32_t tick, uint32_t level)
+{
+    return (tick >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK;
+}
+
+// bitmapでidxの次(idx+1)から数えて最初に立っているビットまでの距離(1～64)
+static inline uint32_t tw_next_bit(uint64_t bitmap, uint32_t idx)
+{
+    uint32_t shift = (idx + 1) & TW_SLOT_MASK;
+    uint64_t rot = (shift == 0) ? bitmap : ((bitmap >> shift) | (bitmap << (TW_SLOT_NUM - shift)));
+
+    return (uint32_t)__builtin_ctzll(rot) + 1;
+}
+
+// 満了までの残りtickで段を、満了tickでスロットを決める(残り0は今のスロット)
+static void HOT_FUNC(tw_place)(tw_wheel_t *p_wheel, tw_timer_t *p_timer)
+{
+    uint32_t delta = p_timer->expires - p_wheel->now;
+    uint32_t level = 0;
+
+    while (level < TW_LEVEL_NUM - 1 && delta >= (1UL << (TW_SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+
+    uint32_t slot = tw_index(p_timer->expires, level);
+    p_timer->level = (uint8_t)level;
+    p_timer->slot = (uint8_t)slot;
+    tw_list_add_tail(&p_wheel->slot[level][slot], &p_timer->node);
+    p_wheel->bitmap[level] |= (1ULL << slot);
+}
+HOT_PATH_REGISTER(tw_place);
+
+static void HOT_FUNC(tw_unlink)(tw_wheel_t *p_wheel, tw_timer_t *p_timer)
+{
+    tw_list_t *p_head = &p_wheel->slot[p_timer->level][p_timer->slot];
+
+    tw_list_del(&p_timer->node);
+    if (tw_list_is_empty(p_head)) {
+        p_wheel->bitmap[p_timer->level] &= ~(1ULL << p_timer->slot);
+    }
+}
+HOT_PATH_REGISTER(tw_unlink);
+
+/**
+ * @brief ホイールの初期化
+ *
+ * @param p_wheel ホイール
+ * @param now 現在のtick
+ */
+void tw_init(tw_wheel_t *p_wheel, uint32_t now)
+{
+    p_wheel->now = now;
+    p_wheel->active = 0;
+    p_wheel->cascades = 0;
+    p_wheel->overruns = 0;
+    for (uint32_t level = 0; level < TW_LEVEL_NUM; level++)
+    {
+        p_wheel->bitmap[level] = 0;
+        for (uint32_t slot = 0; slot < TW_SLOT_NUM; slot++)
+        {
+            tw_list_init(&p_wheel->slot[level][slot]);
+        }
+    }
+}
+
+void tw_timer_init(tw_timer_t *p_timer)
+{
+    tw_list_init(&p_timer->node);
+    p_timer->expires = 0;
+    p_timer->period = 0;
+    p_timer->level = 0;
+    p_timer->slot = 0;
+    p_timer->is_active = false;
+}
+
+/**
+ * @brief タイマーを追加(動いていれば設定し直す)
+ *
+ * @param p_wheel ホイール
+ * @param p_timer タイマー
+ * @param delay 満了までのtick数(1～TW_MAX_TICKS、0は1にする)
+ * @param period 周期のtick数(0ならワンショット)
+ * @return true 追加した
+ * @return false tick数が範囲外
+ */
+bool HOT_FUNC(tw_add)(tw_wheel_t *p_wheel, tw_timer_t *p_timer, uint32_t delay, uint32_t period)
+{
+    if (delay > TW_MAX_TICKS || period > TW_MAX_TICKS) {
+        return false;
+    }
+    if (p_timer->is_active) {
+        tw_unlink(p_wheel, p_timer);
+        p_wheel->active--;
+    }
+
+    // 処理済みのtickのスロットに入れると1周遅れるので最低1tick
+    p_timer->expires = p_wheel->now + ((delay == 0) ? 1 : delay);
+    p_timer->period = period;
+    p_timer->is_active = true;
+    tw_place(p_wheel, p_timer);
+    p_wheel->active++;
+
+    return true;
+}
+HOT_PATH_REGISTER(tw_add);
+
+/**
+ * @brief タイマーを取り消す
+ *
+ * @return true 取り消した
+ * @return false 動いていなかった
+ */
+bool HOT_FUNC(tw_cancel)(tw_wheel_t *p_wheel, tw_timer_t *p_timer)
+{
+    if (!p_timer->is_active) {
+        return false;
+    }
+
+    tw_unlink(p_wheel, p_timer);
+    p_timer->is_active = false;
+    p_wheel->active--;
+
+    return true;
+}
+HOT_PATH_REGISTER(tw_cancel);
+
+/**
+ * @brief 次に処理が必要になるまでのtick数
+ * @note 満了またはカスケードのどちらか早い方。H/Wアラームをここに合わせれば毎tick起きなくてよい
+ *
+ * @return uint32_t now からのtick数(1以上)、タイマーが無ければTW_NO_EXPIRY
+ */
+uint32_t tw_next_expiry(const tw_wheel_t *p_wheel)
+{
+    uint32_t next = TW_NO_EXPIRY;
+
+    for (uint32_t level = 0; level < TW_LEVEL_NUM; level++)
+    {
+        if (p_wheel->bitmap[level] == 0) {
+            continue;
+        }
+
+        uint32_t shift = TW_SLOT_BITS * level;
+        uint32_t m = tw_next_bit(p_wheel->bitmap[level], tw_index(p_wheel->now, level));
+        // 1段目は満了tick、2段目以上はそのスロットがカスケードされるtick
+        uint32_t tick = ((p_wheel->now >> shift) + m) << shift;
+        uint32_t delta = tick - p_wheel->now;
+
+        if (delta < next) {
+            next = delta;
+        }
+    }
+
+    return next;
+}
+
+// 上の段のスロットを下の段に並べ直す
+static void tw_cascade(tw_wheel_t *p_wheel, uint32_t level)
+{
+    uint32_t slot = tw_index(p_wheel->now, level);
+    tw_list_t list;
+
+    tw_list_splice(&p_wheel->slot[level][slot], &list);
+    p_wheel->bitmap[level] &= ~(1ULL << slot);
+    while (!tw_list_is_empty(&list))
+    {
+        tw_timer_t *p_timer = tw_timer_of(list.p_next);
+        tw_list_del(&p_timer->node);
+        tw_place(p_wheel, p_timer);
+        p_wheel->cascades++;
+    }
+}
+
+// 1tick分の処理(カスケードしてから1段目のスロットを満了させる)
+static uint32_t tw_tick(tw_wheel_t *p_wheel, tw_expire_t expire_func, void *p_ctx)
+{
+    uint32_t num = 0;
+    tw_list_t list;
+
+    for (uint32_t level = 1; level < TW_LEVEL_NUM; level++)
+    {
+        if (tw_index(p_wheel->now, level - 1) != 0) {
+            break;
+        }
+        tw_cascade(p_wheel, level);
+    }
+
+    uint32_t slot = tw_index(p_wheel->now, 0);
+    tw_list_splice(&p_wheel->slot[0][slot], &list);
+    p_wheel->bitmap[0] &= ~(1ULL << slot);
+
+    // 1つずつ取り出すので、コールバックの中で他のタイマーを取り消してもよい
+    while (!tw_list_is_empty(&list))
+    {
+        tw_timer_t *p_timer = tw_timer_of(list.p_next);
+        tw_list_del(&p_timer->node);
+
+        if (p_timer->period != 0) {
+            // 周期はずれないように満了tickから足す
+            p_timer->expires += p_timer->period;
+            if ((int32_t)(p_timer->expires - p_wheel->now) <= 0) {
+                p_timer->expires = p_wheel->now + 1;
+                p_wheel->overruns++;
+            }
+            tw_place(p_wheel, p_timer);
+        } else {
+            p_timer->is_active = false;
+            p_wheel->active--;
+        }
+
+        num++;
+        expire_func(p_timer, p_ctx);
+    }
+
+    return num;
+}
+
+/**
+ * @brief nowのtickまで進めて、満了したタイマーのexpire_func()を呼ぶ
+ * @note 何も無いtickは飛ばすので、長く呼ばなくても処理量は満了数+カスケード数だけ
+ *
+ * @param p_wheel ホイール
+ * @param now 現在のtick
+ * @param expire_func 満了したタイマーの処理
+ * @param p_ctx expire_func()に渡す
+ * @return uint32_t 満了したタイマー数
+ */
+uint32_t tw_advance(tw_wheel_t *p_wheel, uint32_t now, tw_expire_t expire_func, void *p_ctx)
+{
+    uint32_t num = 0;
+
+    while (p_wheel->now != now)
+    {
+        uint32_t next = tw_next_expiry(p_wheel);
+        uint32_t remain = now - p_wheel->now;
+
+        if (next > remain) {
+            p_wheel->now = now;
+            break;
+        }
+        p_wheel->now += next;
+        num += tw_tick(p_wheel, expire_func, p_ctx);
+    }
+
+    return num;
+}
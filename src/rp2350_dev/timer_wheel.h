@@ -0,0 +1,65 @@
+/**
+ * @file timer_wheel.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief 階層タイマーホイールのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(時刻はtick数で渡すのでホストでは仮想時計で試験できる)
+
+// 64スロット×4段: 1段目は1tickごと、2段目は64tickごと…に進む
+// 追加と取り消しはO(1)、上の段のタイマーは下の段に降りてきたときに並べ直す(カスケード)
+#define TW_SLOT_BITS        6
+#define TW_SLOT_NUM         (1UL << TW_SLOT_BITS)
+#define TW_SLOT_MASK        (TW_SLOT_NUM - 1)
+#define TW_LEVEL_NUM        4
+#define TW_MAX_TICKS        ((1UL << (TW_SLOT_BITS * TW_LEVEL_NUM)) - 1)    // 設定できる最大tick数
+#define TW_NO_EXPIRY        UINT32_MAX  // tw_next_expiry(): タイマーが無い
+
+// 双方向リスト(循環、ヘッドは番兵)
+typedef struct tw_list {
+    struct tw_list *p_next;
+    struct tw_list *p_prev;
+} tw_list_t;
+
+// タイマー(呼び出し側の構造体に埋め込んで使う)
+typedef struct {
+    tw_list_t node;
+    uint32_t expires;       // 満了するtick(32bitで折り返す)
+    uint32_t period;        // 周期(tick)、0ならワンショット
+    uint8_t level;          // 入っている段
+    uint8_t slot;           // 入っているスロット
+    bool is_active;         // ホイールに入っているか
+} tw_timer_t;
+
+// ホイール
+typedef struct {
+    uint32_t now;                                   // 処理済みのtick
+    uint64_t bitmap[TW_LEVEL_NUM];                  // 空でないスロット
+    tw_list_t slot[TW_LEVEL_NUM][TW_SLOT_NUM];
+    uint32_t active;                                // 入っているタイマー数
+    uint32_t cascades;                              // カスケードで並べ直したタイマー数
+    uint32_t overruns;                              // 周期に間に合わず次のtickに回した回数
+} tw_wheel_t;
+
+// 満了したタイマーの処理(tw_advance()から呼ばれる、中でtw_add()/tw_cancel()してよい)
+typedef void (*tw_expire_t)(tw_timer_t *p_timer, void *p_ctx);
+
+void tw_init(tw_wheel_t *p_wheel, uint32_t now);
+void tw_timer_init(tw_timer_t *p_timer);
+bool tw_add(tw_wheel_t *p_wheel, tw_timer_t *p_timer, uint32_t delay, uint32_t period);
+bool tw_cancel(tw_wheel_t *p_wheel, tw_timer_t *p_timer);
+uint32_t tw_next_expiry(const tw_wheel_t *p_wheel);
+uint32_t tw_advance(tw_wheel_t *p_wheel, uint32_t now, tw_expire_t expire_func, void *p_ctx);
+
+#endif // TIMER_WHEEL_H
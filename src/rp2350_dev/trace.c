@@ -0,0 +1,151 @@
+/**
+ * @file trace.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コアごとのイベントトレース(リングバッファ)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "trace.h"
+#include "hot_path.h"
+#include <stdio.h>
+#include <string.h>
+
+// trace_id_tと同じ順
+static const char *const s_trace_name_tbl[TRACE_ID_NUM] = {
+    "cmd",
+    "timer_callback",
+    "alarm_callback",
+    "core0_job",
+    "core1_loop",
+    "user",
+};
+
+static trace_ring_t s_trace_ring[TRACE_CORE_NUM];
+static const trace_ops_t *s_p_trace_ops = NULL;
+
+// マクロから直接見るので外部公開(関数呼び出しを省くため)
+volatile bool g_is_trace_enabled = false;
+
+/**
+ * @brief 初期化(トレースは無効の状態で始まる)
+ */
+void trace_init(const trace_ops_t *p_ops)
+{
+    g_is_trace_enabled = false;
+    s_p_trace_ops = p_ops;
+    trace_clear();
+}
+
+void trace_set_enabled(bool is_enable)
+{
+    g_is_trace_enabled = (is_enable && s_p_trace_ops != NULL);
+}
+
+/**
+ * @brief 全コアのバッファをクリア
+ * @note 書き込み中のコアがいないよう、トレースを無効にしてから呼ぶ
+ */
+void trace_clear(void)
+{
+    memset(s_trace_ring, 0, sizeof(s_trace_ring));
+}
+
+/**
+ * @brief イベントを1つ書き込む(TRACE_xxxマクロから呼ばれる)
+ * @note 書き込み位置は排他アクセス命令(LDREX/STREX)の加算で確保するので、
+ *       同じコアの割り込みに割り込まれても壊れない。リングはコアごとなので
+ *       コア間のロックは要らない。埋まったら古いものから上書き
+ *
+ * @param type イベントの種類
+ * @param id イベントのID
+ * @param arg 引数 or カウンタ値
+ */
+void HOT_FUNC(trace_emit)(trace_type_t type, trace_id_t id, int32_t arg)
+{
+    uint32_t core = s_p_trace_ops->core_num();
+
+    if (core >= TRACE_CORE_NUM) {
+        return;
+    }
+
+    trace_ring_t *p_ring = &s_trace_ring[core];
+    uint32_t pos = __atomic_fetch_add(&p_ring->head, 1, __ATOMIC_RELAXED);
+    trace_event_t *p_ev = &p_ring->ev[pos & (TRACE_RING_SIZE - 1)];
+
+    // 確保と時刻読み出しの間に割り込まれると前後が入れ替わるので、ホスト側で時刻順に並べ直す
+    p_ev->ts = s_p_trace_ops->now_us();
+    p_ev->id = (uint16_t)id;
+    p_ev->type = (uint8_t)type;
+    p_ev->rsv = 0;
+    p_ev->arg = arg;
+}
+HOT_PATH_REGISTER(trace_emit);
+
+/**
+ * @brief バッファに残っているイベント数
+ *
+ * @param core コア番号
+ * @param p_lost 上書きで失ったイベント数(不要ならNULL)
+ * @return uint32_t イベント数
+ */
+uint32_t trace_count(uint32_t core, uint32_t *p_lost)
+{
+    uint32_t head = (core < TRACE_CORE_NUM) ? s_trace_ring[core].head : 0;
+    uint32_t num = (head > TRACE_RING_SIZE) ? TRACE_RING_SIZE : head;
+
+    if (p_lost != NULL) {
+        *p_lost = head - num;
+    }
+
+    return num;
+}
+
+/**
+ * @brief 古い方からidx番目のイベントを読む
+ *
+ * @return true 読めた
+ * @return false idxが範囲外
+ */
+bool trace_read(uint32_t core, uint32_t idx, trace_event_t *p_ev)
+{
+    uint32_t lost;
+    uint32_t num = trace_count(core, &lost);
+
+    if (idx >= num) {
+        return false;
+    }
+    *p_ev = s_trace_ring[core].ev[(lost + idx) & (TRACE_RING_SIZE - 1)];
+
+    return true;
+}
+
+const char *trace_id_name(uint32_t id)
+{
+    return (id < TRACE_ID_NUM) ? s_trace_name_tbl[id] : "?";
+}
+
+/**
+ * @brief バイト列を16進文字列にする(ダンプ用)
+ *
+ * @return int32_t 書き込んだ文字数(入りきらなければ-1)
+ */
+int32_t trace_format_hex(char *p_buf, size_t size, const void *p_data, size_t len)
+{
+    static const char s_hex[] = "0123456789abcdef";
+    const uint8_t *p_byte = (const uint8_t *)p_data;
+
+    if (size < len * 2 + 1) {
+        return -1;
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        p_buf[i * 2] = s_hex[p_byte[i] >> 4];
+        p_buf[i * 2 + 1] = s_hex[p_byte[i] & 0x0F];
+    }
+    p_buf[len * 2] = '\0';
+
+    return (int32_t)(len * 2);
+}
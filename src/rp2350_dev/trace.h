@@ -0,0 +1,100 @@
+/**
+ * @file trace.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief コアごとのイベントトレース(リングバッファ)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(時刻とコア番号はtrace_ops_tで注入)
+
+// 【使い方】
+// TRACE_BEGIN(TRACE_ID_xxx, arg); ... TRACE_END(TRACE_ID_xxx, arg);  ... 区間
+// TRACE_INSTANT(TRACE_ID_xxx, arg);                                   ... 瞬間
+// TRACE_COUNTER(TRACE_ID_xxx, val);                                   ... カウンタ値
+// ※TRACE_ENABLEが0(CMakeオプション RP2350_DEV_TRACE=OFF)ならマクロは何もしない
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+#define TRACE_CORE_NUM      2       // コア数(リングバッファの数)
+#define TRACE_RING_SIZE     1024    // 1コアあたりのイベント数(2のべき乗)
+#define TRACE_MAGIC         0x31435254UL    // "TRC1"
+#define TRACE_DUMP_BEGIN    "# trace begin"
+#define TRACE_DUMP_END      "# trace end"
+
+// イベントの種類
+typedef enum {
+    TRACE_TYPE_BEGIN = 0,   // 区間の開始
+    TRACE_TYPE_END,         // 区間の終了
+    TRACE_TYPE_INSTANT,     // 瞬間
+    TRACE_TYPE_COUNTER,     // カウンタ値
+} trace_type_t;
+
+// イベントのID(名前はtrace.cのs_trace_name_tblと同じ順)
+typedef enum {
+    TRACE_ID_CMD = 0,       // dbg_com_execute_cmd() (arg: コマンド種類)
+    TRACE_ID_TIMER_CB,      // タイマーサービスのコールバック (arg: タイマーID)
+    TRACE_ID_ALARM_CB,      // alarm_callback() (arg: アラームID)
+    TRACE_ID_CORE0_JOB,     // Core0のジョブ実行
+    TRACE_ID_CORE1_LOOP,    // Core1のdbg_com_process()で1文字処理 (arg: 文字)
+    TRACE_ID_USER,          // 試験用
+    TRACE_ID_NUM
+} trace_id_t;
+
+// 1イベント(12バイト、ダンプもこの並びのリトルエンディアン)
+typedef struct {
+    uint32_t ts;            // タイムスタンプ(μs、32bitで折り返す)
+    uint16_t id;            // trace_id_t
+    uint8_t type;           // trace_type_t
+    uint8_t rsv;
+    int32_t arg;            // 引数 or カウンタ値
+} trace_event_t;
+_Static_assert(sizeof(trace_event_t) == 12, "trace_event_t must be 12 bytes");
+
+// 1コア分のリングバッファ(書き込みはそのコアだけ)
+typedef struct {
+    uint32_t head;          // 書き込んだ総イベント数(単調増加)
+    trace_event_t ev[TRACE_RING_SIZE];
+} trace_ring_t;
+
+// 時刻とコア番号の取得(実機はtrace_hw.c、ホストではシミュレータを渡す)
+typedef struct {
+    uint32_t (*now_us)(void);
+    uint32_t (*core_num)(void);
+} trace_ops_t;
+
+extern volatile bool g_is_trace_enabled;
+
+void trace_init(const trace_ops_t *p_ops);
+void trace_set_enabled(bool is_enable);
+void trace_clear(void);
+void trace_emit(trace_type_t type, trace_id_t id, int32_t arg);
+bool trace_read(uint32_t core, uint32_t idx, trace_event_t *p_ev);
+uint32_t trace_count(uint32_t core, uint32_t *p_lost);
+const char *trace_id_name(uint32_t id);
+int32_t trace_format_hex(char *p_buf, size_t size, const void *p_data, size_t len);
+
+#if TRACE_ENABLE
+#define TRACE_EMIT(type, id, arg) \
+    do { if (g_is_trace_enabled) { trace_emit((type), (id), (int32_t)(arg)); } } while (0)
+#else
+#define TRACE_EMIT(type, id, arg)   do { } while (0)
+#endif
+
+#define TRACE_BEGIN(id, arg)    TRACE_EMIT(TRACE_TYPE_BEGIN, (id), (arg))
+#define TRACE_END(id, arg)      TRACE_EMIT(TRACE_TYPE_END, (id), (arg))
+#define TRACE_INSTANT(id, arg)  TRACE_EMIT(TRACE_TYPE_INSTANT, (id), (arg))
+#define TRACE_COUNTER(id, val)  TRACE_EMIT(TRACE_TYPE_COUNTER, (id), (val))
+
+#endif // TRACE_H
@@ -0,0 +1,40 @@
+/**
+ * @file trace_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief イベントトレースのH/W層(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "trace_hw.h"
+#include "mcu_util.h"
+#include "hardware/timer.h"
+#include "hot_path.h"
+
+// TIMER0のTIMERAWL(1μs、両コア共通なのでコア間で時刻がそろう)
+static uint32_t HOT_FUNC(trace_hw_now_us)(void)
+{
+    return timer_hw->timerawl;
+}
+
+static uint32_t HOT_FUNC(trace_hw_core_num)(void)
+{
+    return get_core_num();
+}
+
+static const trace_ops_t s_trace_hw_ops = {
+    .now_us = trace_hw_now_us,
+    .core_num = trace_hw_core_num,
+};
+
+/**
+ * @brief トレースの初期化
+ * @note 起動直後から有効(フライトレコーダーとして古いものから上書き)
+ */
+void trace_hw_init(void)
+{
+    trace_init(&s_trace_hw_ops);
+    trace_set_enabled(true);
+}
@@ -0,0 +1,18 @@
+/**
+ * @file trace_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief イベントトレースのH/W層(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TRACE_HW_H
+#define TRACE_HW_H
+
+#include "trace.h"
+
+void trace_hw_init(void);
+
+#endif // TRACE_HW_H
@@ -0,0 +1,35 @@
+/**
+ * @file tusb_config.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief TinyUSBの設定(CDC×2のコンポジット、CDC0=stdio/シェル、CDC1=データパイプ)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef TUSB_CONFIG_H
+#define TUSB_CONFIG_H
+
+// ※tinyusb_deviceをリンクするとSDKのstdio_usbは自前の設定とディスクリプタを使わない
+//   (stdioはCDC0を使う、tusb_init()はstdio_init_all()より前に呼ぶ)
+
+#ifndef CFG_TUSB_OS
+#define CFG_TUSB_OS                 OPT_OS_PICO
+#endif
+
+#define CFG_TUSB_RHPORT0_MODE       (OPT_MODE_DEVICE)
+#define CFG_TUD_ENDPOINT0_SIZE      64
+
+#define CFG_TUD_CDC                 2
+#define CFG_TUD_MSC                 0
+#define CFG_TUD_HID                 0
+#define CFG_TUD_MIDI                0
+#define CFG_TUD_VENDOR              0
+
+// CDCのFIFO(FSのバルクは64バイト/パケット、FIFOを大きくして1msフレーム内に詰める)
+#define CFG_TUD_CDC_RX_BUFSIZE      1024
+#define CFG_TUD_CDC_TX_BUFSIZE      2048
+#define CFG_TUD_CDC_EP_BUFSIZE      64
+
+#endif // TUSB_CONFIG_H
@@ -0,0 +1,453 @@
+/**
+ * @file uart_hw.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief UARTの割り込み受信/DMA送信のリングバッファとシェル用stdioドライバ(RP2350)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "uart_hw.h"
+#include "idle_hw.h"
+#include "hot_path.h"
+#include "dma_service.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/stdio/driver.h"
+#include "pico/time.h"
+
+// UART 1本分
+typedef struct {
+    uart_inst_t *p_uart;
+    ring_buf_t rx;
+    ring_buf_t tx;
+    uint8_t rx_buf[UART_HW_RX_BUF_SIZE];
+    uint8_t tx_buf[UART_HW_TX_BUF_SIZE];
+    uint32_t dma_ch;
+    volatile uint32_t tx_len;   // DMAで送っている最中のバイト数(0なら止まっている)
+    uint32_t baud;
+    bool is_loopback;
+    bool is_init;
+    uart_hw_stat_t stat;        // 数えるのはrx/tx_bytes、hw_overrun、rx_err、tx_dma、tx_wait、tx_drop
+} uart_hw_port_t;
+
+static uart_hw_port_t s_port[UART_HW_NUM];
+static spin_lock_t *s_p_tx_lock;
+static volatile int32_t s_shell_index = UART_HW_SHELL_OFF;
+
+/**
+ * @brief 送り終わったDMAのぶんを送信リングから消して、先頭の連続した範囲を次のDMAで出す
+ * @note DMAは完了割り込みを出さない(IRQ_QUIET)ので、書き手とuart_hw_poll()がここで完了を見る
+ *       ブート時のCore0とシェルのCore1から呼ぶのでスピンロックで囲む
+ */
+static void HOT_FUNC(uart_hw_tx_kick)(uart_hw_port_t *p_port)
+{
+    uint32_t save = spin_lock_blocking(s_p_tx_lock);
+
+    if (p_port->tx_len != 0 && !dma_channel_is_busy(p_port->dma_ch)) {
+        rb_consume(&p_port->tx, p_port->tx_len);
+        p_port->stat.tx_bytes += p_port->tx_len;
+        p_port->tx_len = 0;
+    }
+    if (p_port->tx_len == 0) {
+        const uint8_t *p_data;
+        uint32_t len = rb_peek(&p_port->tx, &p_data);
+        if (len > 0) {
+            p_port->tx_len = len;
+            p_port->stat.tx_dma++;
+            dma_channel_transfer_from_buffer_now(p_port->dma_ch, p_data, len);
+        }
+    }
+    spin_unlock(s_p_tx_lock, save);
+}
+HOT_PATH_REGISTER(uart_hw_tx_kick);
+
+/**
+ * @brief 受信割り込み(RX FIFOのレベル or 受信タイムアウト)、FIFOを空にする
+ */
+static void HOT_FUNC(uart_hw_rx_irq)(uart_hw_port_t *p_port)
+{
+    uart_hw_t *p_hw = uart_get_hw(p_port->p_uart);
+    bool is_rx = false;
+
+    while ((p_hw->fr & UART_UARTFR_RXFE_BITS) == 0)
+    {
+        uint32_t dr = p_hw->dr;
+
+        if ((dr & UART_UARTDR_OE_BITS) != 0) {
+            p_port->stat.hw_overrun++;
+        }
+        if ((dr & (UART_UARTDR_BE_BITS | UART_UARTDR_PE_BITS | UART_UARTDR_FE_BITS)) != 0) {
+            p_port->stat.rx_err++;
+        }
+        rb_put(&p_port->rx, (uint8_t)dr);
+        p_port->stat.rx_bytes++;
+        is_rx = true;
+    }
+
+    if (is_rx && s_shell_index == (int32_t)uart_get_index(p_port->p_uart)) {
+        idle_hw_notify(IDLE_HW_SHELL_CORE, IDLE_WAKE_UART);
+    }
+}
+HOT_PATH_REGISTER(uart_hw_rx_irq);
+
+static void uart_hw_uart0_irq(void)
+{
+    uart_hw_rx_irq(&s_port[0]);
+}
+
+static void uart_hw_uart1_irq(void)
+{
+    uart_hw_rx_irq(&s_port[1]);
+}
+
+/**
+ * @brief 初期化済み(uart_init、ピン設定済み)のUARTにリングバッファを付ける(割り込みは呼んだコアで処理)
+ *
+ * @param p_uart uart0 or uart1
+ * @param baud uart_initで設定したボーレート
+ * @return true 成功
+ * @return false DMAサービスに空きチャネルが無い
+ */
+bool uart_hw_init(uart_inst_t *p_uart, uint32_t baud)
+{
+    uint32_t index = uart_get_index(p_uart);
+    uart_hw_port_t *p_port = &s_port[index];
+
+    if (p_port->is_init) {
+        return true;
+    }
+
+    // 送信のDMAチャネルはDMAサービスのプールから借りる(借りっぱなし)
+    if (!dma_svc_ch_acquire(&p_port->dma_ch)) {
+        return false;
+    }
+    if (s_p_tx_lock == NULL) {
+        s_p_tx_lock = spin_lock_init(spin_lock_claim_unused(true));
+    }
+
+    p_port->p_uart = p_uart;
+    p_port->tx_len = 0;
+    p_port->baud = baud;
+    rb_init(&p_port->rx, p_port->rx_buf, UART_HW_RX_BUF_SIZE);
+    rb_init(&p_port->tx, p_port->tx_buf, UART_HW_TX_BUF_SIZE);
+
+    // 送信: 8bitずつ、読み出し側だけ進める、UARTのTX DREQで(完了はポーリングで見るので割り込みは出さない)
+    dma_channel_config c = dma_channel_get_default_config(p_port->dma_ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(p_uart, true));
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(p_port->dma_ch, &c, &uart_get_hw(p_uart)->dr, NULL, 0, false);
+    p_port->is_init = true;
+
+    // 受信: RX FIFOのレベルと受信タイムアウトで割り込み
+    uint32_t irq = (index == 0) ? UART0_IRQ : UART1_IRQ;
+    irq_set_exclusive_handler(irq, (index == 0) ? uart_hw_uart0_irq : uart_hw_uart1_irq);
+    irq_set_enabled(irq, true);
+    uart_set_irqs_enabled(p_uart, true, false);
+
+    return true;
+}
+
+/**
+ * @brief 入るだけ書いて送信を起動する(待たない)
+ *
+ * @return uint32_t 書いたバイト数
+ */
+uint32_t uart_hw_write(uint32_t index, const void *p_data, uint32_t len)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+
+    if (!p_port->is_init) {
+        return 0;
+    }
+
+    uint32_t n = rb_write(&p_port->tx, p_data, len);
+    uart_hw_tx_kick(p_port);
+
+    return n;
+}
+
+/**
+ * @brief 全部書く(空きが無ければDMAが送るのを待つ、UART_HW_TX_TIMEOUT_US進まなければ残りは捨てる)
+ *
+ * @return uint32_t 書いたバイト数
+ */
+uint32_t uart_hw_write_all(uint32_t index, const void *p_data, uint32_t len)
+{
+    const uint8_t *p_src = (const uint8_t *)p_data;
+    uart_hw_port_t *p_port = &s_port[index];
+    uint32_t total = uart_hw_write(index, p_src, len);
+
+    if (total < len && p_port->is_init) {
+        p_port->stat.tx_wait++;
+    }
+
+    uint32_t last_us = time_us_32();
+    while (total < len && p_port->is_init)
+    {
+        uint32_t n = uart_hw_write(index, &p_src[total], len - total);
+        if (n > 0) {
+            total += n;
+            last_us = time_us_32();
+        } else if ((time_us_32() - last_us) > UART_HW_TX_TIMEOUT_US) {
+            p_port->stat.tx_drop += len - total;
+            break;
+        }
+    }
+
+    return total;
+}
+
+uint32_t uart_hw_read(uint32_t index, void *p_data, uint32_t len)
+{
+    return rb_read(&s_port[index].rx, p_data, len);
+}
+
+/**
+ * @brief 受信リングの連続した範囲をコピーせずに見る(使い終わったらuart_hw_rx_consume)
+ */
+uint32_t uart_hw_rx_peek(uint32_t index, const uint8_t **pp_data)
+{
+    return rb_peek(&s_port[index].rx, pp_data);
+}
+
+void uart_hw_rx_consume(uint32_t index, uint32_t len)
+{
+    rb_consume(&s_port[index].rx, len);
+}
+
+/**
+ * @brief 送信リングの空きに直接書く(書いたらuart_hw_tx_commit)
+ */
+uint32_t uart_hw_tx_reserve(uint32_t index, uint8_t **pp_data)
+{
+    return rb_reserve(&s_port[index].tx, pp_data);
+}
+
+void uart_hw_tx_commit(uint32_t index, uint32_t len)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+
+    rb_commit(&p_port->tx, len);
+    uart_hw_tx_kick(p_port);
+}
+
+/**
+ * @brief 送り終わったDMAを片付けて送信リングの残りを出す
+ * @note シェルのループから呼ぶ
+ *
+ * @return true 送信がまだ残っている(寝ないで回す)
+ * @return false 送信の残りなし
+ */
+bool uart_hw_poll(void)
+{
+    bool is_busy = false;
+
+    for (uint32_t i = 0; i < UART_HW_NUM; i++)
+    {
+        uart_hw_port_t *p_port = &s_port[i];
+
+        if (!p_port->is_init) {
+            continue;
+        }
+        uart_hw_tx_kick(p_port);
+        if (rb_used(&p_port->tx) > 0) {
+            is_busy = true;
+        }
+    }
+
+    return is_busy;
+}
+
+/**
+ * @brief 送信リングとUARTのFIFOが空になるまで待つ
+ */
+void uart_hw_flush(uint32_t index)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+
+    if (!p_port->is_init) {
+        return;
+    }
+
+    uint32_t last_us = time_us_32();
+    uint32_t last_used = rb_used(&p_port->tx);
+    while (rb_used(&p_port->tx) > 0)
+    {
+        uart_hw_tx_kick(p_port);
+        uint32_t used = rb_used(&p_port->tx);
+        if (used != last_used) {
+            last_used = used;
+            last_us = time_us_32();
+        } else if ((time_us_32() - last_us) > UART_HW_TX_TIMEOUT_US) {
+            return;
+        }
+    }
+    uart_tx_wait_blocking(p_port->p_uart);
+}
+
+/**
+ * @brief 受信リングを空にする
+ */
+void uart_hw_rx_discard(uint32_t index)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+    const uint8_t *p_data;
+    uint32_t n;
+
+    while ((n = rb_peek(&p_port->rx, &p_data)) > 0)
+    {
+        rb_consume(&p_port->rx, n);
+    }
+}
+
+/**
+ * @brief ボーレートを変える(送信し終わってから)
+ *
+ * @return uint32_t 実際のボーレート
+ */
+uint32_t uart_hw_set_baud(uint32_t index, uint32_t baud)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+
+    uart_hw_flush(index);
+    p_port->baud = uart_set_baudrate(p_port->p_uart, baud);
+
+    return p_port->baud;
+}
+
+/**
+ * @brief 内部ループバック(TX→RX、ピンは使わない)
+ */
+void uart_hw_set_loopback(uint32_t index, bool is_loopback)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+    uart_hw_t *p_hw = uart_get_hw(p_port->p_uart);
+
+    uart_hw_flush(index);
+    if (is_loopback) {
+        hw_set_bits(&p_hw->cr, UART_UARTCR_LBE_BITS);
+    } else {
+        hw_clear_bits(&p_hw->cr, UART_UARTCR_LBE_BITS);
+    }
+    p_port->is_loopback = is_loopback;
+}
+
+// シェル用のstdioドライバ(SDKのstdio_uartの代わり、送信は待たずにリングへ)
+static void uart_hw_stdio_out_chars(const char *p_buf, int len)
+{
+    int32_t index = s_shell_index;
+
+    if (index != UART_HW_SHELL_OFF) {
+        uart_hw_write_all((uint32_t)index, p_buf, (uint32_t)len);
+    }
+}
+
+static void uart_hw_stdio_out_flush(void)
+{
+    int32_t index = s_shell_index;
+
+    if (index != UART_HW_SHELL_OFF) {
+        uart_hw_flush((uint32_t)index);
+    }
+}
+
+static int uart_hw_stdio_in_chars(char *p_buf, int len)
+{
+    int32_t index = s_shell_index;
+
+    if (index == UART_HW_SHELL_OFF) {
+        return PICO_ERROR_NO_DATA;
+    }
+
+    uint32_t n = uart_hw_read((uint32_t)index, p_buf, (uint32_t)len);
+
+    return (n > 0) ? (int)n : PICO_ERROR_NO_DATA;
+}
+
+static stdio_driver_t s_uart_stdio = {
+    .out_chars = uart_hw_stdio_out_chars,
+    .out_flush = uart_hw_stdio_out_flush,
+    .in_chars = uart_hw_stdio_in_chars,
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+    .crlf_enabled = PICO_STDIO_DEFAULT_CRLF
+#endif
+};
+
+/**
+ * @brief シェル(stdio)をUARTにも出す(USBと両方で使える)
+ *
+ * @param index UARTの番号 or UART_HW_SHELL_OFF
+ * @return true 成功
+ * @return false 初期化していないUART
+ */
+bool uart_hw_set_shell(int32_t index)
+{
+    if (index != UART_HW_SHELL_OFF && (index < 0 || index >= UART_HW_NUM || !s_port[index].is_init)) {
+        return false;
+    }
+
+    if (index == UART_HW_SHELL_OFF) {
+        stdio_set_driver_enabled(&s_uart_stdio, false);
+        s_shell_index = UART_HW_SHELL_OFF;
+    } else {
+        uart_hw_rx_discard((uint32_t)index);
+        s_shell_index = index;
+        stdio_set_driver_enabled(&s_uart_stdio, true);
+    }
+
+    return true;
+}
+
+int32_t uart_hw_get_shell(void)
+{
+    return s_shell_index;
+}
+
+bool uart_hw_get_stat(uint32_t index, uart_hw_stat_t *p_stat)
+{
+    if (index >= UART_HW_NUM || !s_port[index].is_init) {
+        return false;
+    }
+
+    const uart_hw_port_t *p_port = &s_port[index];
+
+    *p_stat = p_port->stat;
+    p_stat->baud = p_port->baud;
+    p_stat->is_shell = (s_shell_index == (int32_t)index);
+    p_stat->is_loopback = p_port->is_loopback;
+    p_stat->rx_overrun = p_port->rx.overrun;
+    p_stat->rx_used = rb_used(&p_port->rx);
+    p_stat->rx_peak = p_port->rx.peak;
+    p_stat->tx_used = rb_used(&p_port->tx);
+    p_stat->tx_peak = p_port->tx.peak;
+
+    return true;
+}
+
+void uart_hw_clear_stat(uint32_t index)
+{
+    uart_hw_port_t *p_port = &s_port[index];
+
+    if (!p_port->is_init) {
+        return;
+    }
+
+    uint32_t save = spin_lock_blocking(s_p_tx_lock);
+    p_port->stat.rx_bytes = 0;
+    p_port->stat.tx_bytes = 0;
+    p_port->stat.hw_overrun = 0;
+    p_port->stat.rx_err = 0;
+    p_port->stat.tx_dma = 0;
+    p_port->stat.tx_wait = 0;
+    p_port->stat.tx_drop = 0;
+    p_port->rx.overrun = 0;
+    p_port->rx.peak = rb_used(&p_port->rx);
+    p_port->tx.peak = rb_used(&p_port->tx);
+    spin_unlock(s_p_tx_lock, save);
+}
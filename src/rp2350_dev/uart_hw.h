@@ -0,0 +1,64 @@
+/**
+ * @file uart_hw.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief UARTの割り込み受信/DMA送信のリングバッファとシェル用stdioドライバ(RP2350)のヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef UART_HW_H
+#define UART_HW_H
+
+#include "ring_buf.h"
+#include "hardware/uart.h"
+
+#define UART_HW_NUM             2
+#define UART_HW_RX_BUF_SIZE     1024        // 受信リング(2のべき乗)
+#define UART_HW_TX_BUF_SIZE     2048        // 送信リング(2のべき乗)
+#define UART_HW_TX_TIMEOUT_US   100000      // 書き込みが空きを待つ上限(進まなければ捨てる)
+#define UART_HW_SHELL_OFF       (-1)
+
+// ※受信: RX/RTの割り込みでFIFOを受信リングへ(リングが満杯なら捨ててoverrunに数える)
+// ※送信: 送信リングの連続した範囲をそのままDMAでDRへ(チャネルはDMAサービスから借りる、完了はuart_hw_poll()と書き手が見て次を出す)
+// ※書き手(uart_hw_write等)は1つ、stdio経由の書き込みはstdioのmutexで1つになる
+
+// 統計(uart_hw_get_statで取る写し)
+typedef struct {
+    uint32_t baud;
+    bool is_shell;
+    bool is_loopback;
+    uint32_t rx_bytes;
+    uint32_t tx_bytes;
+    uint32_t rx_overrun;    // 受信リングが満杯で捨てた
+    uint32_t hw_overrun;    // UARTのFIFOが溢れた(OE)
+    uint32_t rx_err;        // フレーミング/パリティ/ブレーク
+    uint32_t tx_dma;        // 送信のDMAを起動した回数
+    uint32_t tx_wait;       // 書き込みが空きを待った回数
+    uint32_t tx_drop;       // 空きを待ちきれずに捨てたバイト数
+    uint32_t rx_used;
+    uint32_t rx_peak;
+    uint32_t tx_used;
+    uint32_t tx_peak;
+} uart_hw_stat_t;
+
+bool uart_hw_init(uart_inst_t *p_uart, uint32_t baud);
+uint32_t uart_hw_write(uint32_t index, const void *p_data, uint32_t len);
+uint32_t uart_hw_write_all(uint32_t index, const void *p_data, uint32_t len);
+uint32_t uart_hw_read(uint32_t index, void *p_data, uint32_t len);
+uint32_t uart_hw_rx_peek(uint32_t index, const uint8_t **pp_data);
+void uart_hw_rx_consume(uint32_t index, uint32_t len);
+uint32_t uart_hw_tx_reserve(uint32_t index, uint8_t **pp_data);
+void uart_hw_tx_commit(uint32_t index, uint32_t len);
+bool uart_hw_poll(void);
+void uart_hw_flush(uint32_t index);
+void uart_hw_rx_discard(uint32_t index);
+uint32_t uart_hw_set_baud(uint32_t index, uint32_t baud);
+void uart_hw_set_loopback(uint32_t index, bool is_loopback);
+bool uart_hw_set_shell(int32_t index);
+int32_t uart_hw_get_shell(void);
+bool uart_hw_get_stat(uint32_t index, uart_hw_stat_t *p_stat);
+void uart_hw_clear_stat(uint32_t index);
+
+#endif // UART_HW_H
@@ -0,0 +1,131 @@
+/**
+ * @file usb_descriptors.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief USBディスクリプタ(CDC×2のコンポジット)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "tusb.h"
+#include "pico/unique_id.h"
+#include <string.h>
+
+#define USBD_VID                0x2E8A      // Raspberry Pi
+#define USBD_PID                0x4002      // 開発用(SDKのstdio_usbの0x0009とは別にしてOSのキャッシュと混ぜない)
+#define USBD_MAX_POWER_MA       250
+
+// インターフェース
+enum {
+    ITF_NUM_CDC_0 = 0,      // シェル(stdio)
+    ITF_NUM_CDC_0_DATA,
+    ITF_NUM_CDC_1,          // データパイプ
+    ITF_NUM_CDC_1_DATA,
+    ITF_NUM_TOTAL
+};
+
+// エンドポイント
+#define EPNUM_CDC_0_NOTIF       0x81
+#define EPNUM_CDC_0_OUT         0x02
+#define EPNUM_CDC_0_IN          0x82
+#define EPNUM_CDC_1_NOTIF       0x83
+#define EPNUM_CDC_1_OUT         0x04
+#define EPNUM_CDC_1_IN          0x84
+
+#define CONFIG_TOTAL_LEN        (TUD_CONFIG_DESC_LEN + CFG_TUD_CDC * TUD_CDC_DESC_LEN)
+
+// 文字列
+enum {
+    STRID_LANGID = 0,
+    STRID_MANUFACTURER,
+    STRID_PRODUCT,
+    STRID_SERIAL,
+    STRID_CDC_0,
+    STRID_CDC_1,
+    STRID_NUM
+};
+
+static const tusb_desc_device_t s_desc_device = {
+    .bLength            = sizeof(tusb_desc_device_t),
+    .bDescriptorType    = TUSB_DESC_DEVICE,
+    .bcdUSB             = 0x0200,
+    // IAD(CDCが2つ)
+    .bDeviceClass       = TUSB_CLASS_MISC,
+    .bDeviceSubClass    = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol    = MISC_PROTOCOL_IAD,
+    .bMaxPacketSize0    = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor           = USBD_VID,
+    .idProduct          = USBD_PID,
+    .bcdDevice          = 0x0100,
+    .iManufacturer      = STRID_MANUFACTURER,
+    .iProduct           = STRID_PRODUCT,
+    .iSerialNumber      = STRID_SERIAL,
+    .bNumConfigurations = 1
+};
+
+static const uint8_t s_desc_config[] = {
+    TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, 0x00, USBD_MAX_POWER_MA),
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CDC_0, STRID_CDC_0, EPNUM_CDC_0_NOTIF, 8, EPNUM_CDC_0_OUT, EPNUM_CDC_0_IN, 64),
+    TUD_CDC_DESCRIPTOR(ITF_NUM_CDC_1, STRID_CDC_1, EPNUM_CDC_1_NOTIF, 8, EPNUM_CDC_1_OUT, EPNUM_CDC_1_IN, 64),
+};
+
+static const char *const s_desc_str[STRID_NUM] = {
+    NULL,                   // LANGID(下で別に返す)
+    "Chimipupu",
+    "rp2350_dev",
+    NULL,                   // シリアル(チップのユニークID)
+    "rp2350_dev shell",
+    "rp2350_dev data pipe",
+};
+
+static uint16_t s_desc_str_buf[33];
+
+const uint8_t *tud_descriptor_device_cb(void)
+{
+    return (const uint8_t *)&s_desc_device;
+}
+
+const uint8_t *tud_descriptor_configuration_cb(uint8_t index)
+{
+    (void)index;
+    return s_desc_config;
+}
+
+const uint16_t *tud_descriptor_string_cb(uint8_t index, uint16_t langid)
+{
+    char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+    const char *p_str;
+    uint32_t len;
+
+    (void)langid;
+
+    if (index == STRID_LANGID) {
+        s_desc_str_buf[1] = 0x0409;     // 英語
+        len = 1;
+    } else {
+        if (index >= STRID_NUM) {
+            return NULL;
+        }
+        if (index == STRID_SERIAL) {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            p_str = serial;
+        } else {
+            p_str = s_desc_str[index];
+        }
+
+        len = strlen(p_str);
+        if (len > 32) {
+            len = 32;
+        }
+        for (uint32_t i = 0; i < len; i++)
+        {
+            s_desc_str_buf[1 + i] = (uint16_t)p_str[i];
+        }
+    }
+
+    // 先頭: 長さ(バイト)と種類
+    s_desc_str_buf[0] = (uint16_t)((TUSB_DESC_STRING << 8) | (2 * len + 2));
+
+    return s_desc_str_buf;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file xip_stat.c
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief XIPキャッシュ統計とフラッシュ読み出しベンチマーク
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "xip_stat.h"
+#include <stdio.h>
+
+static const xip_stat_ops_t *s_p_ops = NULL;
+
+void xip_stat_init(const xip_stat_ops_t *p_ops)
+{
+    s_p_ops = p_ops;
+}
+
+/**
+ * @brief カウンタの現在値を取得
+ */
+void xip_stat_snapshot(xip_ctr_t *p_ctr)
+{
+    p_ctr->hit = s_p_ops->read_hit();
+    p_ctr->acc = s_p_ops->read_acc();
+}
+
+void xip_stat_clear(void)
+{
+    s_p_ops->clear();
+}
+
+/**
+ * @brief 2つのスナップショットの差分(32bitの周回を考慮)
+ */
+void xip_stat_delta(const xip_ctr_t *p_before, const xip_ctr_t *p_after, xip_ctr_t *p_delta)
+{
+    p_delta->hit = p_after->hit - p_before->hit;
+    p_delta->acc = p_after->acc - p_before->acc;
+}
+
+uint32_t xip_stat_miss(const xip_ctr_t *p_ctr)
+{
+    return (p_ctr->acc > p_ctr->hit) ? (p_ctr->acc - p_ctr->hit) : 0;
+}
+
+/**
+ * @brief ヒット率(%)、アクセス0なら100%
+ */
+float xip_stat_hit_rate(const xip_ctr_t *p_ctr)
+{
+    if (p_ctr->acc == 0) {
+        return 100.0f;
+    }
+
+    return (float)p_ctr->hit * 100.0f / (float)p_ctr->acc;
+}
+
+/**
+ * @brief カウンタを1行の文字列にする
+ *
+ * @return int32_t snprintfの戻り値
+ */
+int32_t xip_stat_format(char *p_buf, size_t size, const xip_ctr_t *p_ctr, uint32_t us)
+{
+    return snprintf(p_buf, size, "acc %lu, hit %lu, miss %lu, hit rate %.2f %%, %lu us",
+                    (unsigned long)p_ctr->acc, (unsigned long)p_ctr->hit,
+                    (unsigned long)xip_stat_miss(p_ctr), (double)xip_stat_hit_rate(p_ctr),
+                    (unsigned long)us);
+}
+
+/**
+ * @brief 連続読み出し(32bit、spanで折り返し)
+ */
+uint32_t xip_read_seq(uintptr_t base, uint32_t span, uint32_t reads)
+{
+    const volatile uint32_t *p_word = (const volatile uint32_t *)base;
+    uint32_t mask = (span / 4) - 1;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < reads; i++)
+    {
+        sum += p_word[i & mask];
+    }
+
+    return sum;
+}
+
+/**
+ * @brief ランダム読み出し(32bit、LCGでspan内のアドレスを選ぶ)
+ * @note spanは2のべき乗であること
+ */
+uint32_t xip_read_random(uintptr_t base, uint32_t span, uint32_t reads)
+{
+    const volatile uint32_t *p_word = (const volatile uint32_t *)base;
+    uint32_t mask = (span / 4) - 1;
+    uint32_t lcg = 0x12345678UL;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < reads; i++)
+    {
+        lcg = lcg * 1664525UL + 1013904223UL;
+        sum += p_word[(lcg >> 8) & mask];
+    }
+
+    return sum;
+}
+
+/**
+ * @brief 読み出し関数を計測(時間とカウンタ差分)
+ *
+ * @param func 読み出し関数
+ * @param base 読み出し先の先頭アドレス(エイリアス)
+ * @param span 読み出し範囲(バイト、2のべき乗)
+ * @param reads 読み出し回数(32bit単位)
+ * @param p_result 結果
+ */
+void xip_bench_run(xip_read_func_t func, uintptr_t base, uint32_t span, uint32_t reads,
+                   xip_bench_result_t *p_result)
+{
+    xip_ctr_t before, after;
+
+    xip_stat_snapshot(&before);
+    uint32_t start_us = s_p_ops->now_us();
+    p_result->sum = func(base, span, reads);
+    uint32_t end_us = s_p_ops->now_us();
+    xip_stat_snapshot(&after);
+
+    p_result->us = end_us - start_us;
+    p_result->bytes = reads * 4;
+    xip_stat_delta(&before, &after, &p_result->ctr);
+}
+
+float xip_bench_mbps(const xip_bench_result_t *p_result)
+{
+    if (p_result->us == 0) {
+        return 0.0f;
+    }
+
+    return (float)p_result->bytes / (float)p_result->us;
+}
+
+float xip_bench_ns_per_read(const xip_bench_result_t *p_result, uint32_t reads)
+{
+    if (reads == 0) {
+        return 0.0f;
+    }
+
+    return (float)p_result->us * 1000.0f / (float)reads;
+}
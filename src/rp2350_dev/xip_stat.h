@@ -0,0 +1,59 @@
+/**
+ * @file xip_stat.h
+ * @author Chimipupu(https://github.com/Chimipupu)
+ * @brief XIPキャッシュ統計とフラッシュ読み出しベンチマークのヘッダ
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef XIP_STAT_H
+#define XIP_STAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ※このモジュールはPico SDKに依存しない(カウンタ読み出しはxip_stat_ops_tで注入)
+
+// XIPキャッシュのカウンタ(ヒット数/アクセス数)
+typedef struct {
+    uint32_t hit;
+    uint32_t acc;
+} xip_ctr_t;
+
+// カウンタと時刻の読み出し(実機はXIP_CTRLのCTR_HIT/CTR_ACC、ホストではシミュレータ)
+typedef struct {
+    uint32_t (*read_hit)(void);
+    uint32_t (*read_acc)(void);
+    void (*clear)(void);
+    uint32_t (*now_us)(void);
+} xip_stat_ops_t;
+
+// 読み出し関数(チェックサムを返す、最適化で読み出しが消えないように)
+typedef uint32_t (*xip_read_func_t)(uintptr_t base, uint32_t span, uint32_t reads);
+
+// ベンチマーク結果
+typedef struct {
+    uint32_t us;        // 処理時間
+    uint32_t bytes;     // 読み出しバイト数
+    uint32_t sum;       // チェックサム
+    xip_ctr_t ctr;      // 計測中のカウンタ差分
+} xip_bench_result_t;
+
+void xip_stat_init(const xip_stat_ops_t *p_ops);
+void xip_stat_snapshot(xip_ctr_t *p_ctr);
+void xip_stat_clear(void);
+void xip_stat_delta(const xip_ctr_t *p_before, const xip_ctr_t *p_after, xip_ctr_t *p_delta);
+uint32_t xip_stat_miss(const xip_ctr_t *p_ctr);
+float xip_stat_hit_rate(const xip_ctr_t *p_ctr);
+int32_t xip_stat_format(char *p_buf, size_t size, const xip_ctr_t *p_ctr, uint32_t us);
+uint32_t xip_read_seq(uintptr_t base, uint32_t span, uint32_t reads);
+uint32_t xip_read_random(uintptr_t base, uint32_t span, uint32_t reads);
+void xip_bench_run(xip_read_func_t func, uintptr_t base, uint32_t span, uint32_t reads,
+                   xip_bench_result_t *p_result);
+float xip_bench_mbps(const xip_bench_result_t *p_result);
+float xip_bench_ns_per_read(const xip_bench_result_t *p_result, uint32_t reads);
+
+#endif // XIP_STAT_H
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file la2vcd.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief laコマンドのダンプ(RLE)をVCD(GTKWave等)に変換
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+【使い方】
+  1. シリアルで la ... (または la dump) を実行してログを保存
+  2. python3 tools/la2vcd.py la.log -o la.vcd --names 2=SCL,3=SDA
+  3. gtkwave la.vcd
+
+※Python標準ライブラリのみ
+"""
+import argparse
+import sys
+
+DUMP_BEGIN = "# la begin"
+DUMP_END = "# la end"
+DUMP_VER = 1
+
+TIMESCALE_PER_SEC = 10 ** 12    # VCDの時間単位(1ps)
+
+
+class LaDump:
+    """la dump 1回分"""
+
+    def __init__(self):
+        self.info = {}
+        self.data = bytearray()
+        self.end_info = {}
+
+
+def parse_kv(text):
+    info = {}
+    for kv in text.split():
+        if "=" in kv:
+            key, val = kv.split("=", 1)
+            info[key] = val
+    return info
+
+
+def read_dumps(lines):
+    """ログから la begin～end を読む(複数あれば全部)"""
+    dumps = []
+    dump = None
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith(DUMP_BEGIN):
+            dump = LaDump()
+            dump.info = parse_kv(line[len(DUMP_BEGIN):])
+            continue
+        if dump is None:
+            continue
+        if line.startswith(DUMP_END):
+            dump.end_info = parse_kv(line[len(DUMP_END):])
+            dumps.append(dump)
+            dump = None
+            continue
+        if line and not line.startswith("#"):
+            try:
+                dump.data += bytes.fromhex(line)
+            except ValueError:
+                pass
+
+    return dumps
+
+
+def decode_rle(data, pins):
+    """RLE→(値, 長さ)のリスト
+
+    1ラン = 値((pins+7)//8バイト、リトルエンディアン) + (長さ-1)のLEB128
+    """
+    value_bytes = (pins + 7) // 8
+    runs = []
+    pos = 0
+
+    while pos < len(data):
+        if pos + value_bytes > len(data):
+            raise ValueError("truncated run value at byte %d" % pos)
+        value = int.from_bytes(data[pos:pos + value_bytes], "little")
+        pos += value_bytes
+
+        rest = 0
+        shift = 0
+        while True:
+            if pos >= len(data):
+                raise ValueError("truncated run length at byte %d" % pos)
+            byte = data[pos]
+            pos += 1
+            rest |= (byte & 0x7F) << shift
+            shift += 7
+            if (byte & 0x80) == 0:
+                break
+        runs.append((value, rest + 1))
+
+    return runs
+
+
+def check_dump(dump, runs):
+    ver = int(dump.info.get("ver", "0"))
+    if ver != DUMP_VER:
+        raise ValueError("unsupported la dump (ver=%d)" % ver)
+
+    samples = int(dump.info.get("samples", "0"))
+    total = sum(length for _, length in runs)
+    if total != samples:
+        raise ValueError("decoded %d samples, header says %d (incomplete log?)" % (total, samples))
+    if "bytes" in dump.end_info and int(dump.end_info["bytes"]) != len(dump.data):
+        raise ValueError("read %d bytes, dump says %s" % (len(dump.data), dump.end_info["bytes"]))
+
+
+def parse_names(text):
+    """"2=SCL,3=SDA" → {2: "SCL", 3: "SDA"}"""
+    names = {}
+    if not text:
+        return names
+    for item in text.split(","):
+        pin, name = item.split("=", 1)
+        names[int(pin, 0)] = name.strip()
+    return names
+
+
+def vcd_id(idx):
+    """VCDの識別子(印字可能なASCII、足りなければ2文字以上)"""
+    chars = ""
+    idx += 1
+    while idx > 0:
+        idx -= 1
+        chars = chr(33 + idx % 94) + chars
+        idx //= 94
+    return chars
+
+
+def to_vcd(dump, runs, names, out):
+    base = int(dump.info["base"])
+    pins = int(dump.info["pins"])
+    rate = int(dump.info["rate"])
+    trigger = int(dump.info.get("trigger", "-1"))
+
+    def ts(idx):
+        return idx * TIMESCALE_PER_SEC // rate
+
+    ids = [vcd_id(i) for i in range(pins)]
+    trig_id = vcd_id(pins)
+
+    out.write("$date la2vcd $end\n")
+    out.write("$version la2vcd.py (RP2350 la, %d Hz) $end\n" % rate)
+    out.write("$timescale 1ps $end\n")
+    out.write("$scope module la $end\n")
+    for i in range(pins):
+        gpio = base + i
+        name = names.get(gpio, "gpio%d" % gpio)
+        out.write("$var wire 1 %s %s $end\n" % (ids[i], name))
+    if trigger >= 0:
+        out.write("$var wire 1 %s trigger $end\n" % trig_id)
+    out.write("$upscope $end\n")
+    out.write("$enddefinitions $end\n")
+
+    # ランの先頭で変わったビットだけ書く(トリガは1サンプル幅のパルス)
+    changes = {}
+    idx = 0
+    prev = None
+    for value, length in runs:
+        bits = []
+        for i in range(pins):
+            bit = (value >> i) & 1
+            if prev is None or ((prev >> i) & 1) != bit:
+                bits.append("%d%s" % (bit, ids[i]))
+        changes.setdefault(idx, []).extend(bits)
+        prev = value
+        idx += length
+    end = idx
+
+    if trigger >= 0:
+        changes.setdefault(0, []).append("0%s" % trig_id)
+        changes.setdefault(trigger, []).append("1%s" % trig_id)
+        if trigger + 1 < end:
+            changes.setdefault(trigger + 1, []).append("0%s" % trig_id)
+
+    first = True
+    for idx in sorted(changes):
+        out.write("#%d\n" % ts(idx))
+        if first:
+            out.write("$dumpvars\n")
+        for change in changes[idx]:
+            out.write(change + "\n")
+        if first:
+            out.write("$end\n")
+            first = False
+    out.write("#%d\n" % ts(end))
+
+    return end
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Convert 'la' dump output to VCD")
+    parser.add_argument("log", nargs="*", help="serial log(s) containing 'la' dump (default: stdin)")
+    parser.add_argument("-o", "--output", help="output VCD file (default: stdout)")
+    parser.add_argument("--names", help="signal names, e.g. 2=SCL,3=SDA (default: gpioN)")
+    parser.add_argument("--index", type=int, default=-1, help="dump to convert if the log has several (default: last)")
+    args = parser.parse_args(argv)
+
+    lines = []
+    if args.log:
+        for path in args.log:
+            with open(path, "r", errors="replace") as f:
+                lines.extend(f.readlines())
+    else:
+        lines = sys.stdin.readlines()
+
+    dumps = read_dumps(lines)
+    if not dumps:
+        print("no la dump found (did the log contain '%s'?)" % DUMP_BEGIN, file=sys.stderr)
+        return 1
+    dump = dumps[args.index]
+
+    runs = decode_rle(dump.data, int(dump.info["pins"]))
+    check_dump(dump, runs)
+    names = parse_names(args.names)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            samples = to_vcd(dump, runs, names, f)
+        print("%s: %d samples, %d runs" % (args.output, samples, len(runs)), file=sys.stderr)
+    else:
+        to_vcd(dump, runs, names, sys.stdout)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file pipe_bench.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief USBのデータパイプ(CDC1)のベンチマーク、シェル(CDC0)のキー入力→エコーのレイテンシ
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+【使い方】(Linux、ポートは ls /dev/ttyACM* で確認、シェル=CDC0、データ=CDC1)
+  python3 tools/pipe_bench.py tx --mb 4        デバイス→ホストのMB/s
+  python3 tools/pipe_bench.py rx --mb 4        ホスト→デバイスのMB/s
+  python3 tools/pipe_bench.py echo -n 200      キー入力→エコーの往復時間
+  python3 tools/pipe_bench.py dump --addr 10000000 --len 1000 -o flash.bin
+  (--shell /dev/ttyACM0 --data /dev/ttyACM1 がデフォルト、シリアルターミナルは閉じておく)
+
+※Python標準ライブラリのみ
+"""
+import argparse
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+DP_MAGIC = 0x5044
+DP_HDR = struct.Struct("<HBBHH")    # magic type flags seq len
+DP_FLAG_END = 0x01
+DP_TYPE_RAW = 0
+DP_TYPE_BENCH = 1
+DP_FRAME_PAYLOAD = 4096
+
+PROMPT = b"> "
+
+
+def dp_pattern(n):
+    """data_pipe.cのdp_pattern()と同じ"""
+    return bytes(((i * 31) + (i >> 8)) & 0xFF for i in range(n))
+
+
+class Port:
+    """rawモードのシリアルポート(os.openとtermiosだけ)"""
+
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        attr = termios.tcgetattr(self.fd)
+        attr[0] = 0                                     # iflag
+        attr[1] = 0                                     # oflag
+        attr[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attr[3] = 0                                     # lflag
+        attr[6][termios.VMIN] = 0
+        attr[6][termios.VTIME] = 0
+        termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+        termios.tcflush(self.fd, termios.TCIOFLUSH)
+
+    def close(self):
+        os.close(self.fd)
+
+    def write(self, data):
+        view = memoryview(data)
+        while len(view) > 0:
+            select.select([], [self.fd], [])
+            n = os.write(self.fd, view)
+            view = view[n:]
+
+    def read(self, timeout):
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        if not ready:
+            return b""
+        return os.read(self.fd, 65536)
+
+    def read_until(self, token, timeout):
+        buf = b""
+        end = time.monotonic() + timeout
+        while token not in buf:
+            left = end - time.monotonic()
+            if left <= 0:
+                break
+            buf += self.read(left)
+        return buf
+
+
+class FrameParser:
+    """data_pipe.cのdp_rx_feed()と同じ状態遷移"""
+
+    def __init__(self):
+        self.buf = b""
+        self.frames = []        # (type, flags, seq, payload)
+        self.resync = 0
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            if len(self.buf) < DP_HDR.size:
+                return
+            magic, typ, flags, seq, length = DP_HDR.unpack_from(self.buf)
+            if magic != DP_MAGIC:
+                self.buf = self.buf[1:]
+                self.resync += 1
+                continue
+            if len(self.buf) < DP_HDR.size + length:
+                return
+            payload = self.buf[DP_HDR.size:DP_HDR.size + length]
+            self.buf = self.buf[DP_HDR.size + length:]
+            self.frames.append((typ, flags, seq, payload))
+
+
+def shell_cmd(shell, line):
+    """コマンドを打って、エコーを読み捨てる"""
+    shell.write(line.encode() + b"\r")
+    shell.read_until(b"\n", 1.0)
+
+
+def shell_result(shell, timeout):
+    """プロンプトまでの出力"""
+    out = shell.read_until(PROMPT, timeout)
+    return out.decode(errors="replace").replace("\r", "").rstrip("> \n")
+
+
+def bench_tx(shell, data, mb):
+    total = mb << 20
+    parser = FrameParser()
+    pattern = dp_pattern(DP_FRAME_PAYLOAD)
+    got = 0
+    bad = 0
+    seq_err = 0
+    last_seq = None
+
+    shell_cmd(shell, "pipe bench tx %d" % mb)
+    start = None
+    end = time.monotonic()
+    while got < total:
+        chunk = data.read(3.0)
+        if not chunk:
+            print("Error: timed out after %d bytes" % got)
+            break
+        if start is None:
+            start = time.monotonic()
+        end = time.monotonic()
+        parser.feed(chunk)
+        for typ, _flags, seq, payload in parser.frames:
+            if last_seq is not None and seq != ((last_seq + 1) & 0xFFFF):
+                seq_err += 1
+            last_seq = seq
+            if typ != DP_TYPE_BENCH or payload != pattern[:len(payload)]:
+                bad += 1
+            got += len(payload)
+        parser.frames.clear()
+
+    print(shell_result(shell, 3.0))
+    if start is not None and end > start:
+        print("host: rx %d bytes in %.3f s = %.3f MB/s (bad frames %d, seq err %d, resync %d)"
+              % (got, end - start, got / (end - start) / 1e6, bad, seq_err, parser.resync))
+
+
+def bench_rx(shell, data, mb):
+    total = mb << 20
+    pattern = dp_pattern(DP_FRAME_PAYLOAD)
+
+    shell_cmd(shell, "pipe bench rx %d" % mb)
+    shell.read_until(b"\n", 2.0)    # waiting for ...
+    start = time.monotonic()
+    sent = 0
+    seq = 0
+    while sent < total:
+        n = min(DP_FRAME_PAYLOAD, total - sent)
+        data.write(DP_HDR.pack(DP_MAGIC, DP_TYPE_BENCH, DP_FLAG_END, seq, n) + pattern[:n])
+        seq = (seq + 1) & 0xFFFF
+        sent += n
+    termios.tcdrain(data.fd)
+    end = time.monotonic()
+
+    print(shell_result(shell, 5.0))
+    print("host: tx %d bytes in %.3f s = %.3f MB/s" % (sent, end - start, sent / (end - start) / 1e6))
+
+
+def bench_echo(shell, num):
+    lat = []
+
+    shell.write(b"\r")
+    shell.read_until(PROMPT, 1.0)
+    for i in range(num):
+        key = b"x"
+        t0 = time.perf_counter()
+        shell.write(key)
+        echo = shell.read_until(key, 1.0)
+        t1 = time.perf_counter()
+        if key not in echo:
+            print("Error: no echo")
+            break
+        lat.append((t1 - t0) * 1e6)
+        # 行が溢れないように消す
+        if (i % 32) == 31:
+            shell.write(b"\b" * 32)
+            shell.read_until(b"\b \b" * 32, 1.0)
+    shell.write(b"\b" * (len(lat) % 32))
+    shell.read(0.2)
+
+    if not lat:
+        return
+    lat.sort()
+    pct = lambda p: lat[min(len(lat) - 1, int(len(lat) * p / 100.0))]
+    print("key->echo %d samples (us): min %.0f  mean %.0f  p50 %.0f  p99 %.0f  max %.0f"
+          % (len(lat), lat[0], sum(lat) / len(lat), pct(50), pct(99), lat[-1]))
+
+
+def dump(shell, data, addr, length, path):
+    parser = FrameParser()
+    out = bytearray()
+
+    shell_cmd(shell, "pipe send #%X #%X" % (addr, length))
+    done = False
+    while not done:
+        chunk = data.read(3.0)
+        if not chunk:
+            print("Error: timed out after %d bytes" % len(out))
+            break
+        parser.feed(chunk)
+        for typ, flags, _seq, payload in parser.frames:
+            if typ == DP_TYPE_RAW:
+                out += payload
+                done = done or bool(flags & DP_FLAG_END)
+        parser.frames.clear()
+
+    print(shell_result(shell, 2.0))
+    with open(path, "wb") as f:
+        f.write(out)
+    print("wrote %d bytes to %s" % (len(out), path))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="rp2350_dev USB data pipe benchmark")
+    ap.add_argument("--shell", default="/dev/ttyACM0", help="シェルのポート(CDC0)")
+    ap.add_argument("--data", default="/dev/ttyACM1", help="データパイプのポート(CDC1)")
+    sub = ap.add_subparsers(dest="mode", required=True)
+    p = sub.add_parser("tx", help="デバイス→ホスト")
+    p.add_argument("--mb", type=int, default=4)
+    p = sub.add_parser("rx", help="ホスト→デバイス")
+    p.add_argument("--mb", type=int, default=4)
+    p = sub.add_parser("echo", help="キー入力→エコーの往復時間")
+    p.add_argument("-n", type=int, default=200)
+    p = sub.add_parser("dump", help="メモリをデータパイプで吸い出す")
+    p.add_argument("--addr", type=lambda s: int(s, 16), required=True)
+    p.add_argument("--len", type=lambda s: int(s, 16), required=True)
+    p.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    shell = Port(args.shell)
+    data = None
+    try:
+        if args.mode == "echo":
+            bench_echo(shell, args.n)
+            return 0
+        # データ側を先に開く(DTRが立つとデバイスがopenと見る)
+        data = Port(args.data)
+        if args.mode == "tx":
+            bench_tx(shell, data, args.mb)
+        elif args.mode == "rx":
+            bench_rx(shell, data, args.mb)
+        else:
+            dump(shell, data, args.addr, args.len, args.output)
+    finally:
+        shell.close()
+        if data is not None:
+            data.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
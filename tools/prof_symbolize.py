@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file prof_symbolize.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief profコマンドのダンプをELFのシンボルで関数名にしてフラットプロファイルを出力
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+【使い方】
+  1. シリアルで prof start → 計測したいコマンド → prof dump を実行してログを保存
+  2. python3 tools/prof_symbolize.py build/rp2350_dev.elf prof.log
+     (--callers でLRから呼び出し元も集計、prof start 1 100 lr で記録したとき)
+
+※Python標準ライブラリのみ(pyelftoolsやarm-none-eabi-nmは不要)
+"""
+import argparse
+import bisect
+import struct
+import sys
+from collections import defaultdict
+
+DUMP_BEGIN = "# prof begin"
+DUMP_END = "# prof end"
+
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+def read_elf_funcs(path):
+    """ELFのシンボル表から関数の(開始アドレス, サイズ, 名前)を取り出す"""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:4] != b"\x7fELF":
+        raise ValueError("%s: not an ELF file" % path)
+    is_64 = (data[4] == 2)
+    endian = "<" if data[5] == 1 else ">"
+
+    if is_64:
+        shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+        shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x3A)
+    else:
+        shoff, = struct.unpack_from(endian + "I", data, 0x20)
+        shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x2E)
+
+    sections = []
+    for i in range(shnum):
+        off = shoff + i * shentsize
+        if is_64:
+            _, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize = \
+                struct.unpack_from(endian + "IIQQQQIIQQ", data, off)
+        else:
+            _, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize = \
+                struct.unpack_from(endian + "IIIIIIIIII", data, off)
+        sections.append((sh_type, sh_offset, sh_size, sh_link, sh_entsize))
+
+    funcs = {}
+    for sh_type, sh_offset, sh_size, sh_link, sh_entsize in sections:
+        if sh_type != SHT_SYMTAB or sh_entsize == 0:
+            continue
+        str_offset = sections[sh_link][1]
+        for off in range(sh_offset, sh_offset + sh_size, sh_entsize):
+            if is_64:
+                st_name, st_info, _, _, st_value, st_size = \
+                    struct.unpack_from(endian + "IBBHQQ", data, off)
+            else:
+                st_name, st_value, st_size, st_info, _, _ = \
+                    struct.unpack_from(endian + "IIIBBH", data, off)
+            if (st_info & 0xF) != STT_FUNC or st_value == 0:
+                continue
+            end = data.index(b"\0", str_offset + st_name)
+            name = data[str_offset + st_name:end].decode("utf-8", "replace")
+            addr = st_value & ~1    # Thumbの関数はbit0が1
+            # 同じアドレスの別名は先に見つけたものを使う
+            if addr not in funcs or (funcs[addr][0] == 0 and st_size != 0):
+                funcs[addr] = (st_size, name)
+
+    return sorted((addr, size, name) for addr, (size, name) in funcs.items())
+
+
+class Symbolizer:
+    """アドレス→関数名(サイズが0のシンボルは次のシンボルまでとみなす)"""
+
+    def __init__(self, funcs):
+        self.funcs = funcs
+        self.addrs = [f[0] for f in funcs]
+
+    def lookup(self, addr):
+        addr &= ~1
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return None
+        start, size, name = self.funcs[i]
+        if size != 0 and addr >= start + size:
+            return None
+        return name
+
+
+def read_dumps(lines):
+    """ログから prof begin～end の間の行を読み、(pc, lr)ごとのサンプル数を合計"""
+    hist = defaultdict(int)
+    info = {}
+    is_in_dump = False
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith(DUMP_BEGIN):
+            is_in_dump = True
+            for kv in line[len(DUMP_BEGIN):].split():
+                if "=" in kv:
+                    key, val = kv.split("=", 1)
+                    info[key] = val
+            continue
+        if line.startswith(DUMP_END):
+            is_in_dump = False
+            continue
+        if not is_in_dump or not line or line.startswith("#"):
+            continue
+        fields = line.split()
+        if len(fields) != 3:
+            continue
+        try:
+            pc, lr, count = (int(x, 0) for x in fields)
+        except ValueError:
+            continue
+        hist[(pc, lr)] += count
+
+    return hist, info
+
+
+def name_or_addr(sym, addr):
+    name = sym.lookup(addr)
+    return name if name is not None else "?? (0x%08X)" % addr
+
+
+def flat_profile(hist, sym):
+    """関数ごとのサンプル数(多い順)"""
+    funcs = defaultdict(int)
+    for (pc, _), count in hist.items():
+        funcs[name_or_addr(sym, pc)] += count
+    return sorted(funcs.items(), key=lambda kv: (-kv[1], kv[0]))
+
+
+def caller_profile(hist, sym):
+    """関数ごとの呼び出し元(LRの関数)別サンプル数"""
+    callers = defaultdict(lambda: defaultdict(int))
+    for (pc, lr), count in hist.items():
+        if lr == 0:
+            continue
+        callers[name_or_addr(sym, pc)][name_or_addr(sym, lr)] += count
+    return callers
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Symbolize 'prof dump' output into a flat profile")
+    parser.add_argument("elf", help="rp2350_dev.elf (or rp2350_dev_ram.elf)")
+    parser.add_argument("log", nargs="*", help="serial log(s) containing 'prof dump' (default: stdin)")
+    parser.add_argument("-n", "--top", type=int, default=30, help="number of functions to show (0: all)")
+    parser.add_argument("--callers", action="store_true", help="also break down by caller (needs lr samples)")
+    parser.add_argument("--addr", action="store_true", help="also list the hottest PC addresses")
+    args = parser.parse_args(argv)
+
+    sym = Symbolizer(read_elf_funcs(args.elf))
+
+    lines = []
+    if args.log:
+        for path in args.log:
+            with open(path, "r", errors="replace") as f:
+                lines.extend(f.readlines())
+    else:
+        lines = sys.stdin.readlines()
+
+    hist, info = read_dumps(lines)
+    total = sum(hist.values())
+    if total == 0:
+        print("no samples found (did the log contain '%s'?)" % DUMP_BEGIN, file=sys.stderr)
+        return 1
+
+    print("samples %d, core%s, period %s us, dropped %s" % (
+        total, info.get("core", "?"), info.get("period_us", "?"), info.get("dropped", "?")))
+    print()
+    print("  samples       %  cum %  function")
+    top = flat_profile(hist, sym)
+    if args.top > 0:
+        top = top[:args.top]
+    cum = 0
+    for name, count in top:
+        cum += count
+        print("%9d %7.2f %6.2f  %s" % (count, count * 100.0 / total, cum * 100.0 / total, name))
+
+    if args.callers:
+        callers = caller_profile(hist, sym)
+        print()
+        print("callers (from LR):")
+        for name, _ in top:
+            if name not in callers:
+                continue
+            print("  %s" % name)
+            for caller, count in sorted(callers[name].items(), key=lambda kv: -kv[1]):
+                print("    %9d  <- %s" % (count, caller))
+
+    if args.addr:
+        pcs = defaultdict(int)
+        for (pc, _), count in hist.items():
+            pcs[pc] += count
+        print()
+        print("  samples  address     function")
+        for pc, count in sorted(pcs.items(), key=lambda kv: -kv[1])[:args.top or None]:
+            print("%9d  0x%08X  %s" % (count, pc, name_or_addr(sym, pc)))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
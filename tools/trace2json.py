@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file trace2json.py
+@author Chimipupu(https://github.com/Chimipupu)
+@brief traceコマンドのダンプをChrome Trace Event形式のJSON(Perfetto/chrome://tracing用)に変換
+@version 0.1
+@date 2026-10-19
+
+@copyright Copyright (c) 2026
+
+【使い方】
+  1. シリアルで trace dump を実行してログを保存
+  2. python3 tools/trace2json.py trace.log -o trace.json
+  3. https://ui.perfetto.dev/ で trace.json を開く
+
+※Python標準ライブラリのみ
+"""
+import argparse
+import json
+import struct
+import sys
+
+DUMP_BEGIN = "# trace begin"
+DUMP_END = "# trace end"
+TRACE_MAGIC = 0x31435254
+
+# trace_event_t (ts, id, type, rsv, arg) リトルエンディアン12バイト
+EVENT_FMT = "<IHBBi"
+EVENT_SIZE = struct.calcsize(EVENT_FMT)
+
+TYPE_BEGIN = 0
+TYPE_END = 1
+TYPE_INSTANT = 2
+TYPE_COUNTER = 3
+
+
+class TraceDump:
+    """trace dump 1回分"""
+
+    def __init__(self):
+        self.info = {}
+        self.id_names = {}
+        self.cmd_names = {}
+        self.cores = {}         # core -> bytearray
+        self.lost = {}          # core -> 上書きで失ったイベント数
+
+
+def parse_kv(text):
+    info = {}
+    for kv in text.split():
+        if "=" in kv:
+            key, val = kv.split("=", 1)
+            info[key] = val
+    return info
+
+
+def read_dumps(lines):
+    """ログから trace begin～end を読む(複数あれば全部)"""
+    dumps = []
+    dump = None
+    core = None
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith(DUMP_BEGIN):
+            dump = TraceDump()
+            dump.info = parse_kv(line[len(DUMP_BEGIN):])
+            core = None
+            continue
+        if dump is None:
+            continue
+        if line.startswith(DUMP_END):
+            dumps.append(dump)
+            dump = None
+            continue
+
+        if line.startswith("# trace id "):
+            fields = line.split()
+            dump.id_names[int(fields[3])] = fields[4]
+        elif line.startswith("# trace cmd "):
+            fields = line.split()
+            dump.cmd_names[int(fields[3])] = fields[4]
+        elif line.startswith("# trace core "):
+            fields = line.split()
+            core = int(fields[3])
+            dump.cores[core] = bytearray()
+            dump.lost[core] = int(parse_kv(" ".join(fields[4:])).get("lost", "0"))
+        elif core is not None and line and not line.startswith("#"):
+            try:
+                dump.cores[core] += bytes.fromhex(line)
+            except ValueError:
+                pass
+
+    return dumps
+
+
+def check_header(dump):
+    magic = int(dump.info.get("magic", "0"), 0)
+    rec = int(dump.info.get("rec", "0"))
+    if magic != TRACE_MAGIC or rec != EVENT_SIZE:
+        raise ValueError("unsupported trace dump (magic=0x%08X rec=%d)" % (magic, rec))
+
+
+def decode_events(data):
+    """バイナリ→(ts, id, type, arg)のリスト"""
+    events = []
+    for off in range(0, len(data) - EVENT_SIZE + 1, EVENT_SIZE):
+        ts, ev_id, ev_type, _, arg = struct.unpack_from(EVENT_FMT, data, off)
+        events.append((ts, ev_id, ev_type, arg))
+    return events
+
+
+def unwrap_ts(events):
+    """32bitのμsタイマーの折り返しを戻して時刻順に並べる
+
+    書き込み位置の確保と時刻の読み出しの間に割り込みが入ると
+    リング上の順序と時刻が前後するので、並べ直す(同時刻は元の順)
+    """
+    result = []
+    prev_ts = None
+    now = 0
+    for ts, ev_id, ev_type, arg in events:
+        if prev_ts is not None:
+            # 前のイベントとの差を符号付き32bitで足す(折り返しと小さな逆行の両方に対応)
+            delta = (ts - prev_ts) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 1 << 32
+            now += delta
+        else:
+            now = ts
+        prev_ts = ts
+        result.append((now, ev_id, ev_type, arg))
+
+    return sorted(result, key=lambda ev: ev[0])
+
+
+def align_cores(dump):
+    """コアごとに折り返しを戻し、コア間で同じ時間軸にそろえる
+
+    どのコアも最後のイベントはダンプ直前なので、基準コアの最後のイベントに
+    一番近くなるよう2^32単位でずらす
+    """
+    cores = {core: unwrap_ts(decode_events(data)) for core, data in dump.cores.items()}
+    lasts = {core: evs[-1][0] for core, evs in cores.items() if evs}
+    if not lasts:
+        return cores
+
+    ref = max(lasts.values())
+    for core, last in lasts.items():
+        shift = round((ref - last) / float(1 << 32)) * (1 << 32)
+        if shift != 0:
+            cores[core] = [(ts + shift, ev_id, ev_type, arg) for ts, ev_id, ev_type, arg in cores[core]]
+
+    # 負の時刻にならないように
+    first = min(evs[0][0] for evs in cores.values() if evs)
+    if first < 0:
+        shift = ((-first >> 32) + 1) << 32
+        for core in cores:
+            cores[core] = [(ts + shift, ev_id, ev_type, arg) for ts, ev_id, ev_type, arg in cores[core]]
+
+    return cores
+
+
+def event_name(dump, ev_id, arg):
+    name = dump.id_names.get(ev_id, "id%d" % ev_id)
+    if name == "cmd":
+        return "cmd:%s" % dump.cmd_names.get(arg, str(arg))
+    return name
+
+
+def to_chrome(dump, pid=0):
+    """Chrome Trace Event形式のイベント列"""
+    out = []
+    out.append({"name": "process_name", "ph": "M", "pid": pid, "args": {"name": "RP2350"}})
+
+    cores = align_cores(dump)
+    for core in sorted(cores):
+        tid = core
+        out.append({"name": "thread_name", "ph": "M", "pid": pid, "tid": tid,
+                    "args": {"name": "core%d" % core}})
+        if dump.lost.get(core, 0) > 0 and cores[core]:
+            out.append({"name": "overwritten", "ph": "i", "s": "t", "pid": pid, "tid": tid,
+                        "ts": cores[core][0][0], "args": {"events": dump.lost[core]}})
+
+        stack = []      # 開始済みの区間(先頭が上書きで消えた終了は捨てる)
+        for ts, ev_id, ev_type, arg in cores[core]:
+            name = event_name(dump, ev_id, arg)
+            ev = {"name": name, "pid": pid, "tid": tid, "ts": ts}
+            if ev_type == TYPE_BEGIN:
+                stack.append(ev_id)
+                ev.update({"ph": "B", "args": {"arg": arg}})
+            elif ev_type == TYPE_END:
+                if ev_id not in stack:
+                    continue
+                # 内側で閉じ忘れた区間があればここで閉じる
+                while stack:
+                    top = stack.pop()
+                    if top == ev_id:
+                        break
+                    out.append({"name": dump.id_names.get(top, "id%d" % top), "ph": "E",
+                                "pid": pid, "tid": tid, "ts": ts})
+                ev["ph"] = "E"
+            elif ev_type == TYPE_INSTANT:
+                ev.update({"ph": "i", "s": "t", "args": {"arg": arg}})
+            elif ev_type == TYPE_COUNTER:
+                ev.update({"ph": "C", "args": {name: arg}})
+            else:
+                continue
+            out.append(ev)
+
+    return out
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Convert 'trace dump' output to Chrome trace JSON")
+    parser.add_argument("log", nargs="*", help="serial log(s) containing 'trace dump' (default: stdin)")
+    parser.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    parser.add_argument("--all", action="store_true", help="convert every dump in the log (default: last one)")
+    args = parser.parse_args(argv)
+
+    lines = []
+    if args.log:
+        for path in args.log:
+            with open(path, "r", errors="replace") as f:
+                lines.extend(f.readlines())
+    else:
+        lines = sys.stdin.readlines()
+
+    dumps = read_dumps(lines)
+    if not dumps:
+        print("no trace dump found (did the log contain '%s'?)" % DUMP_BEGIN, file=sys.stderr)
+        return 1
+    if not args.all:
+        dumps = dumps[-1:]
+
+    events = []
+    for pid, dump in enumerate(dumps):
+        check_header(dump)
+        events.extend(to_chrome(dump, pid))
+
+    text = json.dumps({"traceEvents": events, "displayTimeUnit": "ms"}, indent=1)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+        print("%s: %d events" % (args.output, len(events)), file=sys.stderr)
+    else:
+        print(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())